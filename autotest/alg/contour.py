@@ -34,6 +34,7 @@ import os
 
 from osgeo import gdal
 from osgeo import ogr
+import gdaltest
 import ogrtest
 import pytest
 
@@ -268,6 +269,74 @@ def test_contour_3():
     ogr_ds.ReleaseResultSet(lyr)
     ogr_ds.Destroy()
 
+###############################################################################
+# Test the stripe based mode, used when NUM_THREADS is set, against the
+# default one.
+
+
+def _contour_count_and_measure(ds, options, polygonize):
+
+    ogr_ds = ogr.GetDriverByName('Memory').CreateDataSource('')
+    ogr_lyr = ogr_ds.CreateLayer('contour', geom_type=ogr.wkbMultiPolygon
+                                 if polygonize else ogr.wkbLineString)
+    ogr_lyr.CreateField(ogr.FieldDefn('ID', ogr.OFTInteger))
+    ogr_lyr.CreateField(ogr.FieldDefn('elev', ogr.OFTReal))
+    options = ['ID_FIELD=0'] + options
+    if polygonize:
+        options += ['ELEV_FIELD_MAX=1', 'POLYGONIZE=YES']
+    else:
+        options += ['ELEV_FIELD=1']
+    assert gdal.ContourGenerateEx(ds.GetRasterBand(1), ogr_lyr,
+                                  options=options) == 0
+    res = {}
+    for f in ogr_lyr:
+        geom = f.GetGeometryRef()
+        count, measure = res.get(f['elev'], (0, 0))
+        res[f['elev']] = (count + 1, measure +
+                          (geom.GetArea() if polygonize else geom.Length()))
+    return res
+
+
+def _check_contour_num_threads(ds, options, polygonize, swath_size):
+
+    expected = _contour_count_and_measure(ds, options, polygonize)
+    assert expected
+    for num_threads in ('1', '2'):
+        with gdaltest.config_option('GDAL_SWATH_SIZE', swath_size):
+            got = _contour_count_and_measure(
+                ds, options + ['NUM_THREADS=' + num_threads], polygonize)
+        assert sorted(got.keys()) == sorted(expected.keys())
+        for elev in expected:
+            assert got[elev][0] == expected[elev][0], elev
+            assert got[elev][1] == pytest.approx(expected[elev][1]), elev
+
+
+@pytest.mark.parametrize('polygonize', [False, True])
+def test_contour_num_threads(polygonize):
+
+    ds = gdal.Open('data/contour_in.tif')
+    _check_contour_num_threads(ds, ['LEVEL_INTERVAL=10'], polygonize, '1')
+
+###############################################################################
+# Same with nodata pixels on and next to the seams between stripes.
+
+
+@pytest.mark.parametrize('polygonize', [False, True])
+def test_contour_num_threads_nodata_on_seams(polygonize):
+
+    ds = gdal.GetDriverByName('MEM').Create('', 20, 20, 1, gdal.GDT_Float64)
+    values = array.array('d', [((x - 9.5) ** 2 + (y - 9.5) ** 2) ** 0.5
+                               for y in range(20) for x in range(20)])
+    # With lines of 20 * 8 bytes and a swath of 1600 bytes, stripes are 10
+    # lines high with 1 thread, and 5 lines high with 2 threads.
+    for x, y in ((3, 4), (3, 5), (4, 5), (12, 9), (12, 10), (13, 10),
+                 (7, 14), (7, 15), (16, 15), (16, 16)):
+        values[y * 20 + x] = -9999
+    ds.GetRasterBand(1).WriteRaster(0, 0, 20, 20, values.tobytes())
+    ds.GetRasterBand(1).SetNoDataValue(-9999)
+    _check_contour_num_threads(ds, ['LEVEL_INTERVAL=2', 'NODATA=-9999'],
+                               polygonize, '1600')
+
 ###############################################################################
 # Cleanup
 
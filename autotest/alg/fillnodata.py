@@ -29,6 +29,7 @@
 ###############################################################################
 
 from osgeo import gdal
+import gdaltest
 
 import struct
 
@@ -155,3 +156,38 @@ def test_fillnodata_3x3_central_column_and_line_invalid_search_dist_1_5():
                 == (2, 3, 4,
                     4, 5, 6,
                     6, 7, 8)
+
+###############################################################################
+# Test that processing by stripes with several threads gives the same result
+
+
+def test_fillnodata_stripes_and_threads():
+
+    width = 50
+    height = 40
+    values = []
+    for y in range(height):
+        for x in range(width):
+            if 10 <= x < 30 and 5 <= y < 35:
+                values.append(0)
+            elif (x * 7 + y * 13) % 11 == 0:
+                values.append(0)
+            else:
+                values.append(1 + (x * 3 + y * 5) % 200)
+    data = struct.pack('B' * len(values), *values)
+
+    def fill(options):
+        ds = gdal.GetDriverByName('MEM').Create('', width, height)
+        ds.GetRasterBand(1).SetNoDataValue(0)
+        ds.WriteRaster(0, 0, width, height, data)
+        gdal.FillNodata(targetBand=ds.GetRasterBand(1), maskBand=None,
+                        maxSearchDist=15, smoothingIterations=2,
+                        options=options)
+        return ds.ReadRaster()
+
+    ref = fill([])
+    assert ref != data
+    # 3 lines per stripe
+    with gdaltest.config_option('GDAL_SWATH_SIZE', str(width * 26 * 3)):
+        got = fill(['NUM_THREADS=4'])
+    assert got == ref
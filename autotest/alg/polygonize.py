@@ -31,7 +31,9 @@
 
 
 
+import gdaltest
 import ogrtest
+import pytest
 
 from osgeo import gdal, ogr
 
@@ -191,5 +193,87 @@ def test_polygonize_4():
 
     assert tr
 
+###############################################################################
+# Test the stripe based mode, which must give the same polygons.
+
+
+@pytest.mark.parametrize('options', [[], ['8CONNECTED=8']])
+@pytest.mark.parametrize('use_mask', [False, True])
+def test_polygonize_num_threads(options, use_mask):
+
+    src_ds = gdal.Open('data/polygonize_in.grd')
+    src_band = src_ds.GetRasterBand(1)
+    mask_band = src_band.GetMaskBand() if use_mask else None
+
+    def polygonize(options):
+        mem_ds = ogr.GetDriverByName('Memory').CreateDataSource('out')
+        mem_layer = mem_ds.CreateLayer('poly', None, ogr.wkbPolygon)
+        mem_layer.CreateField(ogr.FieldDefn('DN', ogr.OFTInteger))
+        assert gdal.Polygonize(src_band, mask_band, mem_layer, 0,
+                               options) == 0
+        return sorted((f['DN'], f.GetGeometryRef().GetArea())
+                      for f in mem_layer)
+
+    expected = polygonize(options)
+    # Stripes of a single line, and of 3 lines, so that some polygons are
+    # entirely inside a stripe. Each line of a stripe takes 9 bytes per
+    # pixel, for each thread.
+    xsize = src_ds.RasterXSize
+    for num_threads in ('1', '2'):
+        for swath_size in ('1', str(xsize * 9 * 3 * int(num_threads))):
+            with gdaltest.config_option('GDAL_SWATH_SIZE', swath_size):
+                got = polygonize(options + ['NUM_THREADS=' + num_threads])
+            assert len(got) == len(expected), (num_threads, swath_size)
+            for (got_dn, got_area), (dn, area) in zip(got, expected):
+                assert got_dn == dn
+                assert got_area == pytest.approx(area)
 
+###############################################################################
+# Test the stripe based mode on a polygon with a hole, spanning several
+# stripes, and check the geometries themselves.
+
+
+def test_polygonize_num_threads_hole():
+
+    if not ogrtest.have_geos():
+        pytest.skip()
+
+    # A ring of 2 around a hole of 3, over a background of 1.
+    rows = ['1111111111',
+            '1222222221',
+            '1222222221',
+            '1223333221',
+            '1223333221',
+            '1223333221',
+            '1223333221',
+            '1222222221',
+            '1222222221',
+            '1111111111']
+    src_ds = gdal.GetDriverByName('MEM').Create('', 10, 10)
+    src_ds.GetRasterBand(1).WriteRaster(
+        0, 0, 10, 10, ''.join(rows).replace('1', '\x01').replace(
+            '2', '\x02').replace('3', '\x03').encode('LATIN1'))
+    src_band = src_ds.GetRasterBand(1)
 
+    def polygonize(options):
+        mem_ds = ogr.GetDriverByName('Memory').CreateDataSource('out')
+        mem_layer = mem_ds.CreateLayer('poly', None, ogr.wkbPolygon)
+        mem_layer.CreateField(ogr.FieldDefn('DN', ogr.OFTInteger))
+        assert gdal.Polygonize(src_band, None, mem_layer, 0, options) == 0
+        return {f['DN']: f.GetGeometryRef().Clone() for f in mem_layer}
+
+    expected = polygonize([])
+    assert sorted(expected.keys()) == [1, 2, 3]
+    assert expected[2].GetGeometryCount() == 2
+    assert expected[2].GetArea() == 64 - 16
+    # Stripes of a single line, and of 3 lines.
+    for num_threads in ('1', '2'):
+        for swath_size in ('1', str(10 * 9 * 3 * int(num_threads))):
+            with gdaltest.config_option('GDAL_SWATH_SIZE', swath_size):
+                got = polygonize(['NUM_THREADS=' + num_threads])
+            assert sorted(got.keys()) == [1, 2, 3], (num_threads, swath_size)
+            for dn, geom in expected.items():
+                assert got[dn].IsValid(), (dn, got[dn].ExportToWkt())
+                assert got[dn].GetGeometryCount() == \
+                    geom.GetGeometryCount(), (dn, got[dn].ExportToWkt())
+                assert got[dn].Equals(geom), (dn, got[dn].ExportToWkt())
@@ -28,10 +28,11 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
-
-
+import math
+import struct
 
 from osgeo import gdal
+import gdaltest
 import pytest
 
 ###############################################################################
@@ -130,4 +131,41 @@ def test_proximity_3():
         pytest.fail('got wrong checksum')
     
 
+###############################################################################
+# Test the exact algorithm against a brute force computation, with several
+# stripes and threads
+
+
+@pytest.mark.parametrize('maxdist', [None, 3.5])
+def test_proximity_exact(maxdist):
+
+    src_ds = gdal.Open('data/pat.tif')
+    src_band = src_ds.GetRasterBand(1)
+    xsize = src_ds.RasterXSize
+    ysize = src_ds.RasterYSize
+
+    dst_ds = gdal.GetDriverByName('MEM').Create('', xsize, ysize, 1,
+                                                gdal.GDT_Float32)
+    dst_band = dst_ds.GetRasterBand(1)
 
+    options = ['ALGORITHM=EXACT', 'VALUES=65,64', 'NODATA=-1',
+               'NUM_THREADS=4']
+    if maxdist:
+        options.append('MAXDIST=%f' % maxdist)
+    # 4 lines per stripe
+    with gdaltest.config_option('GDAL_SWATH_SIZE', str(xsize * 8 * 4)):
+        assert gdal.ComputeProximity(src_band, dst_band,
+                                     options=options) == 0
+
+    src = struct.unpack('B' * (xsize * ysize), src_band.ReadRaster())
+    got = struct.unpack('f' * (xsize * ysize), dst_band.ReadRaster())
+    targets = [(i % xsize, i // xsize) for i in range(xsize * ysize)
+               if src[i] in (64, 65)]
+    for i in range(xsize * ysize):
+        x = i % xsize
+        y = i // xsize
+        dist = min(math.sqrt((x - tx) ** 2 + (y - ty) ** 2)
+                   for tx, ty in targets)
+        if maxdist and dist > maxdist:
+            dist = -1
+        assert got[i] == pytest.approx(dist, abs=1e-5), (x, y)
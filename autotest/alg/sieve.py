@@ -33,6 +33,7 @@
 
 
 from osgeo import gdal
+import gdaltest
 import pytest
 
 ###############################################################################
@@ -324,3 +325,42 @@ cellsize     60.000000000000
     
 
 
+
+###############################################################################
+# Test the stripe based mode, used when NUM_THREADS is set, against the
+# default one.
+
+
+@pytest.mark.parametrize('connectedness', [4, 8])
+def test_sieve_num_threads(connectedness):
+
+    src_ds = gdal.Open('../gcore/data/byte.tif')
+    src_band = src_ds.GetRasterBand(1)
+
+    drv = gdal.GetDriverByName('MEM')
+    ref_ds = drv.Create('', 20, 20, 1, gdal.GDT_Byte)
+    gdal.SieveFilter(src_band, None, ref_ds.GetRasterBand(1), 4, connectedness)
+    cs_expected = ref_ds.GetRasterBand(1).Checksum()
+    assert cs_expected != src_band.Checksum()
+
+    # Stripes of a single line, and of 4 lines, so that some polygons are
+    # entirely inside a stripe. Each line of a stripe takes 13 bytes per
+    # pixel, for each thread.
+    for num_threads in ('1', '2'):
+        for swath_size in ('1', str(20 * 13 * 4 * int(num_threads))):
+            dst_ds = drv.Create('', 20, 20, 1, gdal.GDT_Byte)
+            with gdaltest.config_option('GDAL_SWATH_SIZE', swath_size):
+                gdal.SieveFilter(src_band, None, dst_ds.GetRasterBand(1), 4,
+                                 connectedness,
+                                 options=['NUM_THREADS=' + num_threads])
+            assert dst_ds.GetRasterBand(1).Checksum() == cs_expected, \
+                (num_threads, swath_size)
+
+            # In place update.
+            dst_ds = drv.CreateCopy('', src_ds)
+            dst_band = dst_ds.GetRasterBand(1)
+            with gdaltest.config_option('GDAL_SWATH_SIZE', swath_size):
+                gdal.SieveFilter(dst_band, None, dst_band, 4, connectedness,
+                                 options=['NUM_THREADS=' + num_threads])
+            assert dst_band.Checksum() == cs_expected, \
+                (num_threads, swath_size)
@@ -1691,3 +1691,33 @@ def test_warp_nearest_real_nodata_multiple_band():
                             1, 0, 1])
     out_ds = gdal.Warp('', src_ds, options = '-of MEM')
     assert struct.unpack('d' * 4, out_ds.ReadRaster()) == struct.unpack('d' * 4, src_ds.ReadRaster())
+
+###############################################################################
+# Test that the AVX2 bilinear and cubic kernels give the same result as the
+# generic code
+
+
+@pytest.mark.parametrize('datatype', [gdal.GDT_Int16, gdal.GDT_UInt16, gdal.GDT_Float32])
+@pytest.mark.parametrize('resampling', ['bilinear', 'cubic'])
+def test_warp_avx2_same_as_generic(datatype, resampling):
+
+    if datatype == gdal.GDT_Int16:
+        scale_params = [[0, 255, -32768, 32767]]
+    elif datatype == gdal.GDT_UInt16:
+        scale_params = [[0, 255, 0, 65535]]
+    else:
+        scale_params = [[0, 255, -1000.5, 1000.5]]
+    src_ds = gdal.Translate('', '../gcore/data/byte.tif', format='MEM',
+                            outputType=datatype, scaleParams=scale_params)
+
+    def warp():
+        # Upsampling and a shift by a fraction of pixel, so that both
+        # the interior (SIMD) and border (generic) pixels are exercised
+        return gdal.Warp('', src_ds, format='MEM', resampleAlg=resampling,
+                         outputBounds=[440727, 3750127, 441907, 3751307],
+                         xRes=23, yRes=23)
+
+    with gdaltest.config_option('GDAL_USE_AVX2', 'NO'):
+        ref_ds = warp()
+    out_ds = warp()
+    assert out_ds.ReadRaster() == ref_ds.ReadRaster()
@@ -43,9 +43,12 @@
 #include "cpl_http.h"
 #include "cpl_auto_close.h"
 #include "cpl_minixml.h"
+#include "cpl_worker_thread_pool.h"
 
+#include <atomic>
 #include <fstream>
 #include <string>
+#include <vector>
 
 static bool gbGotError = false;
 static void CPL_STDCALL myErrorHandler(CPLErr, CPLErrorNum, const char*)
@@ -2605,4 +2608,133 @@ namespace tut
         x.reset(CPLStrdup("foo"));
         ensure_equals( std::string(x.get()), "foo");
     }
+
+    // Test CPLJobQueue with nested jobs
+    struct TestNestedJob
+    {
+        CPLWorkerThreadPool* poPool;
+        int nDepth;
+        std::atomic<int>* pnLeaves;
+    };
+
+    static void TestNestedJobFunc(void* pData)
+    {
+        TestNestedJob* psJob = static_cast<TestNestedJob*>(pData);
+        if( psJob->nDepth == 0 )
+        {
+            (*psJob->pnLeaves)++;
+            return;
+        }
+        // Waiting on the child jobs from a job must not dead-lock, even
+        // with a single thread in the pool.
+        auto poQueue = psJob->poPool->CreateJobQueue();
+        TestNestedJob asChildren[3];
+        for( auto& sChild: asChildren )
+        {
+            sChild = *psJob;
+            sChild.nDepth--;
+            poQueue->SubmitJob(TestNestedJobFunc, &sChild);
+        }
+        poQueue->WaitCompletion();
+    }
+
+    struct TestLimitedJobs
+    {
+        std::atomic<int> nRunning{0};
+        std::atomic<int> nMaxRunning{0};
+        std::atomic<int> nDone{0};
+        CPLJobQueue* poQueue = nullptr;
+    };
+
+    static void TestLimitedJobFunc(void* pData)
+    {
+        TestLimitedJobs* psJobs = static_cast<TestLimitedJobs*>(pData);
+        const int nRunning = ++psJobs->nRunning;
+        int nMax = psJobs->nMaxRunning;
+        while( nRunning > nMax &&
+               !psJobs->nMaxRunning.compare_exchange_weak(nMax, nRunning) )
+        {
+        }
+        CPLSleep(0.001);
+        psJobs->nRunning--;
+        psJobs->nDone++;
+    }
+
+    static void TestLimitedParentJobFunc(void* pData)
+    {
+        TestLimitedJobs* psJobs = static_cast<TestLimitedJobs*>(pData);
+        for( int i = 0; i < 5; i++ )
+            psJobs->poQueue->SubmitJob(TestLimitedJobFunc, psJobs);
+        // Wait for all the jobs of the queue but this one
+        psJobs->poQueue->WaitCompletion(1);
+    }
+
+    template<>
+    template<>
+    void object::test<39>()
+    {
+        for( int nThreads = 1; nThreads <= 4; nThreads *= 2 )
+        {
+            CPLWorkerThreadPool oPool;
+            ensure( oPool.Setup(nThreads, nullptr, nullptr) );
+            std::atomic<int> nLeaves(0);
+            TestNestedJob sJob;
+            sJob.poPool = &oPool;
+            sJob.nDepth = 4;
+            sJob.pnLeaves = &nLeaves;
+            {
+                auto poQueue = oPool.CreateJobQueue();
+                poQueue->SubmitJob(TestNestedJobFunc, &sJob);
+                poQueue->WaitCompletion();
+            }
+            ensure_equals( nLeaves.load(), 81 );
+
+            // Jobs of other queues are not waited for
+            std::atomic<int> nOtherLeaves(0);
+            auto poQueue1 = oPool.CreateJobQueue();
+            auto poQueue2 = oPool.CreateJobQueue();
+            std::vector<TestNestedJob> asJobs(10, sJob);
+            for( auto& sOtherJob: asJobs )
+            {
+                sOtherJob.nDepth = 0;
+                sOtherJob.pnLeaves = &nOtherLeaves;
+                poQueue1->SubmitJob(TestNestedJobFunc, &sOtherJob);
+            }
+            poQueue2->WaitCompletion();
+            poQueue1->WaitCompletion();
+            ensure_equals( nOtherLeaves.load(), 10 );
+        }
+
+        // An explicit number of threads is not capped by GDAL_NUM_THREADS
+        CPLCleanupGlobalWorkerThreadPool();
+        CPLSetConfigOption("GDAL_NUM_THREADS", "2");
+        CPLWorkerThreadPool* poPool = CPLGetGlobalWorkerThreadPool(8);
+        ensure( poPool != nullptr );
+        ensure_equals( poPool->GetThreadCount(), 8 );
+        CPLSetConfigOption("GDAL_NUM_THREADS", nullptr);
+
+        // Limit of the number of running jobs of a queue
+        {
+            TestLimitedJobs sLimited;
+            std::vector<void*> apData(20, &sLimited);
+            {
+                auto poQueue = poPool->CreateJobQueue(2);
+                poQueue->SubmitJobs(TestLimitedJobFunc, apData);
+            }
+            ensure_equals( sLimited.nDone.load(), 20 );
+            ensure( sLimited.nMaxRunning.load() <= 2 );
+        }
+
+        // A job of a limited queue waiting for other jobs of the same queue,
+        // that cannot be handed to the pool before it finishes
+        {
+            TestLimitedJobs sLimited;
+            auto poQueue = poPool->CreateJobQueue(1);
+            sLimited.poQueue = poQueue.get();
+            poQueue->SubmitJob(TestLimitedParentJobFunc, &sLimited);
+            poQueue->WaitCompletion();
+            ensure_equals( sLimited.nDone.load(), 5 );
+        }
+        CPLCleanupGlobalWorkerThreadPool();
+    }
 } // namespace tut
@@ -625,4 +625,155 @@ namespace tut
 
     }
 
+    // Test GDALDataset::AsyncRasterIO() and GDALRasterBand::AsyncRasterIO()
+    template<> template<> void object::test<18>()
+    {
+        const int nSize = 64;
+        GDALDatasetUniquePtr poDS(
+            GDALDriver::FromHandle(
+                GDALGetDriverByName("MEM"))->Create("", nSize, nSize, 2, GDT_Byte, nullptr));
+        std::vector<GByte> abyIn(nSize * nSize * 2);
+        for( size_t i = 0; i < abyIn.size(); i++ )
+            abyIn[i] = static_cast<GByte>(i * 7);
+        ensure_equals( poDS->RasterIO(GF_Write, 0, 0, nSize, nSize,
+                                      &abyIn[0], nSize, nSize, GDT_Byte,
+                                      2, nullptr, 0, 0, 0, nullptr),
+                       CE_None );
+
+        // Several requests in flight, one per row.
+        std::vector<GByte> abyOut(abyIn.size());
+        std::vector<std::unique_ptr<GDALRasterIORequest>> apoRequests;
+        for( int iY = 0; iY < nSize; iY++ )
+        {
+            apoRequests.emplace_back(poDS->AsyncRasterIO(
+                0, iY, nSize, 1, &abyOut[iY * nSize], nSize, 1, GDT_Byte,
+                2, nullptr, 1, nSize, nSize * nSize));
+            ensure( apoRequests.back() != nullptr );
+        }
+        for( auto& poRequest: apoRequests )
+        {
+            ensure( poRequest->Wait() );
+            ensure( poRequest->IsDone() );
+            ensure_equals( poRequest->GetResult(), CE_None );
+        }
+        ensure( abyOut == abyIn );
+        apoRequests.clear();
+
+        // Band request, through the C API.
+        std::vector<GByte> abyBand(nSize * nSize);
+        GDALRasterIORequestH hRequest = GDALRasterAsyncRasterIO(
+            GDALGetRasterBand(GDALDataset::ToHandle(poDS.get()), 2),
+            0, 0, nSize, nSize, &abyBand[0], nSize, nSize, GDT_Byte,
+            0, 0, nullptr);
+        ensure( hRequest != nullptr );
+        ensure( GDALRasterIORequestWait(hRequest, -1.0) );
+        ensure_equals( GDALRasterIORequestGetResult(hRequest), CE_None );
+        GDALRasterIORequestDestroy(hRequest);
+        ensure( memcmp(&abyBand[0], &abyIn[nSize * nSize], nSize * nSize) == 0 );
+
+        // Cancelled requests either complete or fail, but never hang.
+        for( int i = 0; i < 10; i++ )
+        {
+            apoRequests.emplace_back(poDS->GetRasterBand(1)->AsyncRasterIO(
+                0, 0, nSize, nSize, &abyBand[0], nSize, nSize, GDT_Byte,
+                0, 0));
+        }
+        for( auto& poRequest: apoRequests )
+            poRequest->Cancel();
+        CPLPushErrorHandler(CPLQuietErrorHandler);
+        for( auto& poRequest: apoRequests )
+        {
+            const CPLErr eErr = poRequest->GetResult();
+            ensure( eErr == CE_None || eErr == CE_Failure );
+        }
+        CPLPopErrorHandler();
+        apoRequests.clear();
+
+        // Invalid window.
+        CPLPushErrorHandler(CPLQuietErrorHandler);
+        ensure( poDS->AsyncRasterIO(0, 0, nSize + 1, 1, &abyOut[0],
+                                    nSize + 1, 1, GDT_Byte,
+                                    1, nullptr, 0, 0, 0) == nullptr );
+        ensure( poDS->GetRasterBand(1)->AsyncRasterIO(
+                    0, 0, nSize + 1, 1, &abyOut[0], nSize + 1, 1, GDT_Byte,
+                    0, 0) == nullptr );
+        CPLPopErrorHandler();
+    }
+
+    // Test GDALRasterBand::GetMappedBlock()
+    template<> template<> void object::test<19>()
+    {
+        const char* pszFilename = "/vsimem/test_gdal_mapped_block.tif";
+        const int nSize = 40;
+        const int nBlockSize = 16;
+        {
+            CPLStringList aosOptions;
+            aosOptions.SetNameValue("TILED", "YES");
+            aosOptions.SetNameValue("BLOCKXSIZE", CPLSPrintf("%d", nBlockSize));
+            aosOptions.SetNameValue("BLOCKYSIZE", CPLSPrintf("%d", nBlockSize));
+            GDALDatasetUniquePtr poDS(
+                GDALDriver::FromHandle(GDALGetDriverByName("GTiff"))->Create(
+                    pszFilename, nSize, nSize, 2, GDT_UInt16, aosOptions.List()));
+            std::vector<GUInt16> anValues(nSize * nSize * 2);
+            for( size_t i = 0; i < anValues.size(); i++ )
+                anValues[i] = static_cast<GUInt16>(i);
+            ensure_equals( poDS->RasterIO(GF_Write, 0, 0, nSize, nSize,
+                                          &anValues[0], nSize, nSize,
+                                          GDT_UInt16, 2, nullptr,
+                                          0, 0, 0, nullptr),
+                           CE_None );
+        }
+
+        GDALDatasetUniquePtr poDS(GDALDataset::Open(pszFilename));
+        ensure( poDS != nullptr );
+        GDALRasterBand* poBand = poDS->GetRasterBand(2);
+        for( int iYBlock = 0; iYBlock < 3; iYBlock++ )
+        {
+            for( int iXBlock = 0; iXBlock < 3; iXBlock++ )
+            {
+                GSpacing nPixelSpace = 0;
+                GSpacing nLineSpace = 0;
+                const GByte* pabyBlock = static_cast<const GByte*>(
+                    poBand->GetMappedBlock(iXBlock, iYBlock,
+                                           &nPixelSpace, &nLineSpace));
+                ensure( pabyBlock != nullptr );
+                const int nX = std::min(nBlockSize - 1,
+                                        nSize - 1 - iXBlock * nBlockSize);
+                const int nY = std::min(nBlockSize - 1,
+                                        nSize - 1 - iYBlock * nBlockSize);
+                GUInt16 nVal = 0;
+                memcpy(&nVal, pabyBlock + nX * nPixelSpace + nY * nLineSpace,
+                       sizeof(nVal));
+                const int nExpected = nSize * nSize +
+                    (iYBlock * nBlockSize + nY) * nSize +
+                    iXBlock * nBlockSize + nX;
+                ensure_equals( static_cast<int>(nVal),
+                               nExpected & 0xFFFF );
+            }
+        }
+        GSpacing nPixelSpace = 0;
+        GSpacing nLineSpace = 0;
+        ensure( poBand->GetMappedBlock(3, 0, &nPixelSpace, &nLineSpace) == nullptr );
+        poDS.reset();
+        VSIUnlink(pszFilename);
+
+        // Compressed blocks cannot be mapped.
+        GDALDatasetUniquePtr poMEMDS(
+            GDALDriver::FromHandle(
+                GDALGetDriverByName("MEM"))->Create("", 1, 1, 1, GDT_Byte, nullptr));
+        ensure( poMEMDS->GetRasterBand(1)->GetMappedBlock(
+                    0, 0, &nPixelSpace, &nLineSpace) == nullptr );
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("COMPRESS", "DEFLATE");
+        poDS.reset(GDALDriver::FromHandle(GDALGetDriverByName("GTiff"))->
+            CreateCopy(pszFilename, poMEMDS.get(), false, aosOptions.List(),
+                       nullptr, nullptr));
+        poDS.reset();
+        poDS.reset(GDALDataset::Open(pszFilename));
+        ensure( poDS->GetRasterBand(1)->GetMappedBlock(
+                    0, 0, &nPixelSpace, &nLineSpace) == nullptr );
+        poDS.reset();
+        VSIUnlink(pszFilename);
+    }
+
 } // namespace tut
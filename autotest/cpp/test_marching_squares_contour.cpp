@@ -33,6 +33,7 @@
 
 #include "marching_squares/level_generator.h"
 #include "marching_squares/segment_merger.h"
+#include "marching_squares/stripe_merger.h"
 #include "marching_squares/contour_generator.h"
 
 namespace marching_squares {
@@ -391,6 +392,47 @@ namespace tut
             ensure( "Polygon #1, Ring #1", w.hasRing( 18.0, { {0.9,1.5}, {0.5,1.1}, {0,1.1}, {0,1.5}, {0,2}, {0.5,2}, {0.9,2} } ) );
         }
     }
-}
 
+    template<>
+    template<>
+    void object::test<5>()
+    {
+        // contours of stripes joined by StripeMerger
+        //
+        //  0  0  0
+        //  0 10  0
+        // - - - - -  stripe boundary
+        //  0  0  0
+        //
+        // The ring around the center pixel is computed half in each stripe
+
+        std::vector<double> data = { 0.0, 0.0, 0.0, 0.0, 10.0, 0.0, 0.0, 0.0, 0.0 };
+        TestRingAppender w;
 
+        {
+            IntervalLevelRangeIterator levels( 5.0, 10.0 );
+            StripeMerger<TestRingAppender> stripeMerger( w, /* polygonize */ false );
+            typedef SegmentMerger<StripeMerger<TestRingAppender>, IntervalLevelRangeIterator> Merger;
+            {
+                stripeMerger.beginningOfStripe( NaN, 1.5 );
+                Merger writer( stripeMerger, levels, /* polygonize */ false );
+                ContourGenerator<Merger, IntervalLevelRangeIterator> cg( 3, 3, /* hasNoData */ false, NaN, writer, levels );
+                cg.feedLine( &data[0] );
+                cg.feedLine( &data[3] );
+                writer.emitRemainingLines();
+                stripeMerger.endOfStripe();
+            }
+            {
+                stripeMerger.beginningOfStripe( 1.5, NaN );
+                Merger writer( stripeMerger, levels, /* polygonize */ false );
+                ContourGenerator<Merger, IntervalLevelRangeIterator> cg( 3, 3, /* hasNoData */ false, NaN, writer, levels );
+                cg.startAtLine( 2, &data[3] );
+                cg.feedLine( &data[6] );
+                writer.emitRemainingLines();
+                stripeMerger.endOfStripe();
+            }
+        }
+
+        ensure( "Ring", w.hasRing( 5.0, { {1.0,1.5}, {1.5,1.0}, {2.0,1.5}, {1.5,2.0} } ) );
+    }
+}
@@ -29,7 +29,9 @@
 #include "ogrsf_frmts.h"
 #include "../../gdal/ogr/ogrsf_frmts/osm/gpb.h"
 
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace tut
 {
@@ -1470,4 +1472,188 @@ namespace tut
                strcmp("2001-02-03T04:05:06.789-03:00", pszDateTime) == 0);
         CPLFree(pszDateTime);
     }
+
+    // Check that OGRLayer::GetNextFeatureBatch() returns the same features
+    // as GetNextFeature()
+    static void CheckGetNextFeatureBatch(OGRLayer* poLayer, int nMaxRows)
+    {
+        std::vector<std::unique_ptr<OGRFeature>> apoExpected;
+        poLayer->ResetReading();
+        for( auto&& poFeature: poLayer )
+            apoExpected.emplace_back(poFeature.release());
+
+        OGRFeatureBatch oBatch(poLayer->GetLayerDefn());
+        size_t nIdx = 0;
+        poLayer->ResetReading();
+        while( true )
+        {
+            const int nRows = poLayer->GetNextFeatureBatch(&oBatch, nMaxRows);
+            ensure( nRows >= 0 );
+            ensure( nRows <= nMaxRows );
+            ensure_equals( oBatch.GetLength(), nRows );
+            if( nRows == 0 )
+                break;
+            for( int iRow = 0; iRow < nRows; iRow++, nIdx++ )
+            {
+                ensure( nIdx < apoExpected.size() );
+                std::unique_ptr<OGRFeature> poFeature(oBatch.GetFeature(iRow));
+                ensure_equals( oBatch.GetFIDs()[iRow],
+                               apoExpected[nIdx]->GetFID() );
+                if( !poFeature->Equal(apoExpected[nIdx].get()) )
+                {
+                    poFeature->DumpReadable(stderr);
+                    apoExpected[nIdx]->DumpReadable(stderr);
+                    ensure( false );
+                }
+            }
+        }
+        ensure_equals( nIdx, apoExpected.size() );
+    }
+
+    // Test OGRLayer::GetNextFeatureBatch()
+    template<>
+    template<>
+    void object::test<16>()
+    {
+        // Shapefile
+        {
+            std::string file(data_ + SEP + "poly.shp");
+            GDALDatasetUniquePtr poDS(
+                GDALDataset::Open(file.c_str(), GDAL_OF_VECTOR));
+            ensure( poDS != nullptr );
+            OGRLayer* poLayer = poDS->GetLayer(0);
+            ensure( poLayer->TestCapability(OLCFastGetNextFeatureBatch) );
+            CheckGetNextFeatureBatch(poLayer, 3);
+            CheckGetNextFeatureBatch(poLayer, 10);
+            CheckGetNextFeatureBatch(poLayer, 1000);
+
+            // Attribute filter: generic implementation
+            poLayer->SetAttributeFilter("EAS_ID < 170");
+            ensure( !poLayer->TestCapability(OLCFastGetNextFeatureBatch) );
+            CheckGetNextFeatureBatch(poLayer, 2);
+            poLayer->SetAttributeFilter(nullptr);
+
+            // Batch built for another layer definition
+            OGRFeatureDefn* poOtherDefn = new OGRFeatureDefn("other");
+            poOtherDefn->Reference();
+            {
+                OGRFeatureBatch oBatch(poOtherDefn);
+                CPLPushErrorHandler(CPLQuietErrorHandler);
+                ensure_equals( poLayer->GetNextFeatureBatch(&oBatch, 10), -1 );
+                CPLPopErrorHandler();
+            }
+            poOtherDefn->Release();
+        }
+
+        // GeoPackage
+        GDALDriver* poGPKGDriver =
+            GetGDALDriverManager()->GetDriverByName("GPKG");
+        if( poGPKGDriver )
+        {
+            const char* pszFilename = "/vsimem/test_ogr_batch.gpkg";
+            {
+                GDALDatasetUniquePtr poDS(poGPKGDriver->Create(
+                    pszFilename, 0, 0, 0, GDT_Unknown, nullptr));
+                ensure( poDS != nullptr );
+                OGRLayer* poLayer = poDS->CreateLayer("test", nullptr, wkbPoint);
+                ensure( poLayer != nullptr );
+                const OGRFieldType aeTypes[] = {
+                    OFTInteger, OFTInteger64, OFTReal, OFTString, OFTDate,
+                    OFTDateTime, OFTBinary };
+                for( const OGRFieldType eType: aeTypes )
+                {
+                    OGRFieldDefn oField(OGRFieldDefn::GetFieldTypeName(eType),
+                                        eType);
+                    ensure_equals( poLayer->CreateField(&oField), OGRERR_NONE );
+                }
+                for( int i = 0; i < 25; i++ )
+                {
+                    OGRFeature oFeature(poLayer->GetLayerDefn());
+                    if( (i % 5) != 4 )
+                    {
+                        oFeature.SetField(0, i);
+                        oFeature.SetField(1, static_cast<GIntBig>(i) << 33);
+                        oFeature.SetField(2, i + 0.5);
+                        oFeature.SetField(3, CPLSPrintf("value %d", i));
+                        oFeature.SetField(4, 2019, 1 + (i % 12), 1 + i);
+                        oFeature.SetField(5, 2019, 12, 31, i % 24, 59, 30.5f,
+                                          100);
+                        const GByte abyData[] = { 0, 1, static_cast<GByte>(i) };
+                        oFeature.SetField(6, 3, abyData);
+                        OGRPoint oPoint(i, -i);
+                        oFeature.SetGeometry(&oPoint);
+                    }
+                    ensure_equals( poLayer->CreateFeature(&oFeature),
+                                   OGRERR_NONE );
+                }
+            }
+            {
+                GDALDatasetUniquePtr poDS(
+                    GDALDataset::Open(pszFilename, GDAL_OF_VECTOR));
+                ensure( poDS != nullptr );
+                OGRLayer* poLayer = poDS->GetLayer(0);
+                ensure( poLayer->TestCapability(OLCFastGetNextFeatureBatch) );
+                CheckGetNextFeatureBatch(poLayer, 1);
+                CheckGetNextFeatureBatch(poLayer, 5);
+                CheckGetNextFeatureBatch(poLayer, 25);
+                CheckGetNextFeatureBatch(poLayer, 100);
+
+                OGRFeatureBatch oBatch(poLayer->GetLayerDefn());
+                poLayer->ResetReading();
+                ensure_equals( poLayer->GetNextFeatureBatch(&oBatch, 100), 25 );
+                const int* panValues = oBatch.GetFieldAsIntegerArray(0);
+                ensure( panValues != nullptr );
+                ensure_equals( panValues[3], 3 );
+                ensure( !oBatch.IsFieldSetAndNotNull(0, 4) );
+                ensure( !oBatch.IsGeomFieldSet(0, 4) );
+                ensure( oBatch.IsGeomFieldSet(0, 5) );
+
+                OGRLinearRing oRing;
+                oRing.addPoint(-0.5, 0.5);
+                oRing.addPoint(10.5, 0.5);
+                oRing.addPoint(10.5, -10.5);
+                oRing.addPoint(-0.5, -10.5);
+                oRing.addPoint(-0.5, 0.5);
+                OGRPolygon oFilter;
+                oFilter.addRing(&oRing);
+                poLayer->SetSpatialFilter(&oFilter);
+                ensure( poLayer->TestCapability(OLCFastGetNextFeatureBatch) );
+                CheckGetNextFeatureBatch(poLayer, 4);
+
+                // Non rectangular filter: the geometries whose envelope
+                // intersects the one of the filter must be built.
+                OGRLinearRing oTriangle;
+                oTriangle.addPoint(-0.5, 0.5);
+                oTriangle.addPoint(10.5, 0.5);
+                oTriangle.addPoint(-0.5, -10.5);
+                oTriangle.addPoint(-0.5, 0.5);
+                OGRPolygon oTriangleFilter;
+                oTriangleFilter.addRing(&oTriangle);
+                poLayer->SetSpatialFilter(&oTriangleFilter);
+                ensure( poLayer->TestCapability(OLCFastGetNextFeatureBatch) );
+                CheckGetNextFeatureBatch(poLayer, 2);
+                poLayer->SetSpatialFilter(nullptr);
+            }
+            VSIUnlink(pszFilename);
+        }
+
+        // OpenFileGDB
+        if( GetGDALDriverManager()->GetDriverByName("OpenFileGDB") )
+        {
+            std::string file("/vsizip/" + data_ + SEP + ".." + SEP + ".." +
+                             SEP + "ogr" + SEP + "data" + SEP +
+                             "testopenfilegdb.gdb.zip" + SEP +
+                             "testopenfilegdb.gdb");
+            GDALDatasetUniquePtr poDS(
+                GDALDataset::Open(file.c_str(), GDAL_OF_VECTOR));
+            if( poDS != nullptr )
+            {
+                for( auto poLayer: poDS->GetLayers() )
+                {
+                    ensure( poLayer->TestCapability(OLCFastGetNextFeatureBatch) );
+                    CheckGetNextFeatureBatch(poLayer, 4);
+                }
+            }
+        }
+    }
 } // namespace tut
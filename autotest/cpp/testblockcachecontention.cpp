@@ -0,0 +1,209 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  GDAL Core
+ * Purpose:  Benchmark contention of the global block cache when several
+ *           threads read distinct datasets
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+// Each thread opens its own GTiff dataset (so no I/O is shared between
+// threads) and repeatedly reads small windows from it, so that the only
+// shared resource is the global block cache. The benchmark is run for
+// 1, 2, 4, ... up to -threads threads, and the throughput is reported for
+// each thread count. Compare runs with --config GDAL_RB_SHARDS 1 and
+// --config GDAL_RB_SHARDS AUTO.
+
+#include "cpl_multiproc.h"
+#include "cpl_string.h"
+#include "gdal_priv.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+static void Usage()
+{
+    printf("Usage: testblockcachecontention [-threads X] [-iters X] [-xsize val] [-ysize val]\n");
+    printf("                                [-blocksize val] [-cachemax_ratio val]\n");
+    printf("\n");
+    printf("Example: testblockcachecontention -threads 32 --config GDAL_RB_SHARDS AUTO\n");
+    exit(1);
+}
+
+struct ThreadDescription
+{
+    GDALDataset* poDS;
+    int nIters;
+    int nBlockSize;
+    unsigned long nSeed;
+};
+
+/* according to rand() man page, POSIX.1-2001 proposes the following implementation */
+/* RAND_MAX assumed to be 32767 */
+#define MYRAND_MAX 32767
+static int myrand_r(unsigned long* pseed) {
+    *pseed = *pseed * 1103515245 + 12345;
+    return((unsigned)((*pseed/65536UL) % (MYRAND_MAX+1)));
+}
+
+static void ThreadFunc(void* pData)
+{
+    ThreadDescription* psDesc = static_cast<ThreadDescription*>(pData);
+    GDALRasterBand* poBand = psDesc->poDS->GetRasterBand(1);
+    const int nXBlocks = DIV_ROUND_UP(poBand->GetXSize(), psDesc->nBlockSize);
+    const int nYBlocks = DIV_ROUND_UP(poBand->GetYSize(), psDesc->nBlockSize);
+    for( int i = 0; i < psDesc->nIters; i++ )
+    {
+        const int nXBlock = myrand_r(&psDesc->nSeed) % nXBlocks;
+        const int nYBlock = myrand_r(&psDesc->nSeed) % nYBlocks;
+        GDALRasterBlock* poBlock =
+            poBand->GetLockedBlockRef(nXBlock, nYBlock);
+        if( poBlock )
+            poBlock->DropLock();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int nMaxThreads = CPLGetNumCPUs();
+    int nIters = 1000 * 1000;
+    int nXSize = 4096;
+    int nYSize = 4096;
+    int nBlockSize = 64;
+    // Ratio of the total size of the datasets that fits in the cache.
+    // Below 1, blocks are continuously evicted, which stresses Internalize()
+    double dfCacheMaxRatio = 0.5;
+
+    argc = GDALGeneralCmdLineProcessor( argc, &argv, 0 );
+
+    GDALAllRegister();
+
+    for( int i = 1; i < argc; i++ )
+    {
+        if( EQUAL(argv[i], "-threads") && i + 1 < argc)
+            nMaxThreads = atoi(argv[++i]);
+        else if( EQUAL(argv[i], "-iters") && i + 1 < argc)
+            nIters = atoi(argv[++i]);
+        else if( EQUAL(argv[i], "-xsize") && i + 1 < argc)
+            nXSize = atoi(argv[++i]);
+        else if( EQUAL(argv[i], "-ysize") && i + 1 < argc)
+            nYSize = atoi(argv[++i]);
+        else if( EQUAL(argv[i], "-blocksize") && i + 1 < argc)
+            nBlockSize = atoi(argv[++i]);
+        else if( EQUAL(argv[i], "-cachemax_ratio") && i + 1 < argc)
+            dfCacheMaxRatio = CPLAtof(argv[++i]);
+        else
+            Usage();
+    }
+    if( nMaxThreads <= 0 || nIters <= 0 || nXSize <= 0 || nYSize <= 0 ||
+        nBlockSize <= 0 || dfCacheMaxRatio <= 0 )
+        Usage();
+
+    GDALDriver* poDriver = GetGDALDriverManager()->GetDriverByName("GTiff");
+    if( poDriver == nullptr )
+    {
+        fprintf(stderr, "GTiff driver not available\n");
+        exit(1);
+    }
+
+    char** papszOptions = nullptr;
+    papszOptions = CSLSetNameValue(papszOptions, "TILED", "YES");
+    papszOptions = CSLSetNameValue(papszOptions, "BLOCKXSIZE",
+                                   CPLSPrintf("%d", nBlockSize));
+    papszOptions = CSLSetNameValue(papszOptions, "BLOCKYSIZE",
+                                   CPLSPrintf("%d", nBlockSize));
+
+    // One distinct dataset per thread.
+    std::vector<CPLString> aosFilenames;
+    for( int i = 0; i < nMaxThreads; i++ )
+    {
+        CPLString osFilename(
+            CPLSPrintf("/vsimem/testblockcachecontention_%d.tif", i));
+        GDALDataset* poDS = poDriver->Create(osFilename, nXSize, nYSize, 1,
+                                             GDT_Byte, papszOptions);
+        if( poDS == nullptr )
+            exit(1);
+        GDALClose(poDS);
+        aosFilenames.push_back(osFilename);
+    }
+    CSLDestroy(papszOptions);
+
+    printf("Threads  Time (s)  MBlocks/s  Speedup\n");
+    double dfRefThroughput = 0;
+    for( int nThreads = 1; nThreads <= nMaxThreads; )
+    {
+        GDALSetCacheMax64( static_cast<GIntBig>(
+            dfCacheMaxRatio * nThreads * nXSize * nYSize) );
+
+        std::vector<ThreadDescription> asThreadDescription(nThreads);
+        for( int i = 0; i < nThreads; i++ )
+        {
+            asThreadDescription[i].poDS = static_cast<GDALDataset*>(
+                GDALOpen(aosFilenames[i], GA_ReadOnly));
+            if( asThreadDescription[i].poDS == nullptr )
+                exit(1);
+            asThreadDescription[i].nIters = nIters;
+            asThreadDescription[i].nBlockSize = nBlockSize;
+            asThreadDescription[i].nSeed = i + 1;
+        }
+
+        std::vector<CPLJoinableThread*> apsThreads;
+        const auto oStart = std::chrono::steady_clock::now();
+        for( int i = 0; i < nThreads; i++ )
+        {
+            apsThreads.push_back(
+                CPLCreateJoinableThread(ThreadFunc, &asThreadDescription[i]));
+        }
+        for( int i = 0; i < nThreads; i++ )
+        {
+            CPLJoinThread(apsThreads[i]);
+        }
+        const double dfElapsed = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - oStart).count();
+
+        const double dfThroughput =
+            static_cast<double>(nThreads) * nIters / dfElapsed / 1e6;
+        if( nThreads == 1 )
+            dfRefThroughput = dfThroughput;
+        printf("%7d  %8.3f  %9.3f  %7.2f\n", nThreads, dfElapsed,
+               dfThroughput, dfThroughput / dfRefThroughput);
+
+        for( int i = 0; i < nThreads; i++ )
+            GDALClose(asThreadDescription[i].poDS);
+
+        if( nThreads == nMaxThreads )
+            break;
+        nThreads = std::min(nThreads * 2, nMaxThreads);
+    }
+
+    for( size_t i = 0; i < aosFilenames.size(); i++ )
+        VSIUnlink(aosFilenames[i]);
+
+    GDALDestroyDriverManager();
+    CSLDestroy( argv );
+
+    return 0;
+}
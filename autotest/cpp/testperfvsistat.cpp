@@ -0,0 +1,186 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  GDAL Core
+ * Purpose:  Benchmark concurrent VSIStatL() and VSIFOpenL() on cached paths
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+// Several threads stat and open a small set of files in a loop, to measure
+// the contention in the virtual file system layer (handler lookup, and
+// file property / region caches for network file systems). By default
+// /vsimem/ files are used. With -url, the paths are remote ones (for example
+// /vsicurl/ or /vsis3/ ones) that are first stat'ed once from the main thread,
+// so that the loop only hits the caches.
+
+#include "cpl_conv.h"
+#include "cpl_string.h"
+#include "cpl_vsi.h"
+#include "gdal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+static void Usage()
+{
+    printf("Usage: testperfvsistat [-threads X] [-iters X] [-files X]\n");
+    printf("                       [-url filename]* [-stat-only]\n");
+    exit(1);
+}
+
+static double Run(const std::vector<std::string>& aosFiles, int nThreads,
+                  int nIters, bool bOpen, bool* pbError)
+{
+    std::atomic<bool> bError(false);
+    std::vector<std::thread> aoThreads;
+    const auto oStart = std::chrono::steady_clock::now();
+    for( int iThread = 0; iThread < nThreads; iThread++ )
+    {
+        aoThreads.emplace_back([&aosFiles, &bError, nIters, bOpen, iThread]()
+        {
+            const size_t nFiles = aosFiles.size();
+            for( int i = 0; i < nIters; i++ )
+            {
+                // Each thread starts at a different file.
+                const std::string& osFile =
+                    aosFiles[(static_cast<size_t>(i) + iThread) % nFiles];
+                if( bOpen )
+                {
+                    VSILFILE* fp = VSIFOpenL(osFile.c_str(), "rb");
+                    if( fp == nullptr )
+                        bError = true;
+                    else
+                        VSIFCloseL(fp);
+                }
+                else
+                {
+                    VSIStatBufL sStat;
+                    if( VSIStatL(osFile.c_str(), &sStat) != 0 )
+                        bError = true;
+                }
+            }
+        });
+    }
+    for( auto& oThread: aoThreads )
+        oThread.join();
+    const double dfElapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - oStart).count();
+    if( bError )
+        *pbError = true;
+    return static_cast<double>(nThreads) * nIters / dfElapsed;
+}
+
+int main(int argc, char* argv[])
+{
+    int nThreads = static_cast<int>(std::thread::hardware_concurrency());
+    int nIters = 100000;
+    int nFiles = 64;
+    bool bStatOnly = false;
+    std::vector<std::string> aosFiles;
+
+    argc = GDALGeneralCmdLineProcessor( argc, &argv, 0 );
+
+    for( int i = 1; i < argc; i++ )
+    {
+        if( EQUAL(argv[i], "-threads") && i + 1 < argc)
+            nThreads = atoi(argv[++i]);
+        else if( EQUAL(argv[i], "-iters") && i + 1 < argc)
+            nIters = atoi(argv[++i]);
+        else if( EQUAL(argv[i], "-files") && i + 1 < argc)
+            nFiles = atoi(argv[++i]);
+        else if( EQUAL(argv[i], "-url") && i + 1 < argc)
+            aosFiles.push_back(argv[++i]);
+        else if( EQUAL(argv[i], "-stat-only") )
+            bStatOnly = true;
+        else
+            Usage();
+    }
+    if( nThreads <= 0 )
+        nThreads = 1;
+    if( nIters <= 0 || nFiles <= 0 )
+        Usage();
+
+    const bool bMemFiles = aosFiles.empty();
+    if( bMemFiles )
+    {
+        for( int i = 0; i < nFiles; i++ )
+        {
+            aosFiles.push_back(CPLSPrintf("/vsimem/testperfvsistat/%d.bin", i));
+            VSILFILE* fp = VSIFOpenL(aosFiles.back().c_str(), "wb");
+            if( fp == nullptr )
+                exit(1);
+            VSIFWriteL("0123456789", 1, 10, fp);
+            VSIFCloseL(fp);
+        }
+    }
+    else
+    {
+        // Warm up the caches.
+        for( const auto& osFile: aosFiles )
+        {
+            VSIStatBufL sStat;
+            if( VSIStatL(osFile.c_str(), &sStat) != 0 )
+            {
+                fprintf(stderr, "Cannot stat %s\n", osFile.c_str());
+                exit(1);
+            }
+        }
+    }
+
+    bool bError = false;
+    printf("Threads  VSIStatL (op/s)  VSIFOpenL (op/s)\n");
+    for( int n = 1; n <= nThreads; )
+    {
+        const double dfStat = Run(aosFiles, n, nIters, false, &bError);
+        if( bStatOnly )
+        {
+            printf("%7d  %15.0f\n", n, dfStat);
+        }
+        else
+        {
+            const double dfOpen = Run(aosFiles, n, nIters, true, &bError);
+            printf("%7d  %15.0f  %16.0f\n", n, dfStat, dfOpen);
+        }
+        if( n == nThreads )
+            break;
+        n = std::min(n * 2, nThreads);
+    }
+
+    if( bMemFiles )
+        VSIRmdirRecursive("/vsimem/testperfvsistat");
+    VSICleanupFileManager();
+    CSLDestroy( argv );
+
+    if( bError )
+    {
+        fprintf(stderr, "Some operations failed\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,192 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  GDAL Core
+ * Purpose:  Benchmark the warping kernel throughput per data type and
+ *           resampling method
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+// A random source raster is warped (slightly upsampled and shifted, so that
+// the 4-sample formula of the bilinear and cubic kernels applies) into a
+// MEM dataset, for each data type and resampling method. The throughput is
+// reported in destination megapixels per second, with the AVX2 kernels
+// disabled (GDAL_USE_AVX2=NO) and enabled, when they exist for the
+// combination.
+
+#include "cpl_conv.h"
+#include "cpl_string.h"
+#include "gdal_priv.h"
+#include "gdalwarper.h"
+
+#include <chrono>
+#include <cstdlib>
+
+static void Usage()
+{
+    printf("Usage: testperfwarpkernel [-xsize val] [-ysize val] [-iters X]\n");
+    printf("                          [-threads X]\n");
+    exit(1);
+}
+
+static GDALDataset* CreateSource(GDALDataType eDT, int nXSize, int nYSize)
+{
+    GDALDriver* poMEMDrv = GetGDALDriverManager()->GetDriverByName("MEM");
+    GDALDataset* poDS = poMEMDrv->Create("", nXSize, nYSize, 1, eDT, nullptr);
+    double adfGT[6] = { 0, 1, 0, 0, 0, -1 };
+    poDS->SetGeoTransform(adfGT);
+
+    double* padfLine = static_cast<double*>(
+        CPLMalloc(sizeof(double) * nXSize));
+    unsigned int nSeed = 1;
+    for( int iY = 0; iY < nYSize; iY++ )
+    {
+        for( int iX = 0; iX < nXSize; iX++ )
+        {
+            nSeed = nSeed * 1103515245U + 12345U;
+            padfLine[iX] = (nSeed >> 16) % 30000;
+        }
+        CPL_IGNORE_RET_VAL(poDS->GetRasterBand(1)->RasterIO(
+            GF_Write, 0, iY, nXSize, 1, padfLine, nXSize, 1, GDT_Float64,
+            0, 0, nullptr));
+    }
+    CPLFree(padfLine);
+    return poDS;
+}
+
+static double Warp(GDALDataset* poSrcDS, GDALDataset* poDstDS,
+                   GDALResampleAlg eResampleAlg, int nIters, int nThreads)
+{
+    void* hTransformArg = GDALCreateGenImgProjTransformer2(
+        poSrcDS, poDstDS, nullptr);
+
+    GDALWarpOptions* psWO = GDALCreateWarpOptions();
+    psWO->hSrcDS = poSrcDS;
+    psWO->hDstDS = poDstDS;
+    psWO->eResampleAlg = eResampleAlg;
+    psWO->eWorkingDataType = poSrcDS->GetRasterBand(1)->GetRasterDataType();
+    psWO->nBandCount = 1;
+    psWO->panSrcBands = static_cast<int*>(CPLMalloc(sizeof(int)));
+    psWO->panSrcBands[0] = 1;
+    psWO->panDstBands = static_cast<int*>(CPLMalloc(sizeof(int)));
+    psWO->panDstBands[0] = 1;
+    psWO->pfnTransformer = GDALGenImgProjTransform;
+    psWO->pTransformerArg = hTransformArg;
+    psWO->papszWarpOptions = CSLSetNameValue(psWO->papszWarpOptions,
+                                             "NUM_THREADS",
+                                             CPLSPrintf("%d", nThreads));
+
+    GDALWarpOperation oWO;
+    if( oWO.Initialize(psWO) != CE_None )
+        exit(1);
+
+    const int nXSize = poDstDS->GetRasterXSize();
+    const int nYSize = poDstDS->GetRasterYSize();
+    const auto oStart = std::chrono::steady_clock::now();
+    for( int i = 0; i < nIters; i++ )
+    {
+        if( oWO.ChunkAndWarpImage(0, 0, nXSize, nYSize) != CE_None )
+            exit(1);
+    }
+    const double dfElapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - oStart).count();
+
+    GDALDestroyGenImgProjTransformer(hTransformArg);
+    GDALDestroyWarpOptions(psWO);
+
+    return static_cast<double>(nXSize) * nYSize * nIters / dfElapsed / 1e6;
+}
+
+int main(int argc, char* argv[])
+{
+    int nXSize = 2048;
+    int nYSize = 2048;
+    int nIters = 5;
+    int nThreads = 1;
+
+    argc = GDALGeneralCmdLineProcessor( argc, &argv, 0 );
+
+    GDALAllRegister();
+
+    for( int i = 1; i < argc; i++ )
+    {
+        if( EQUAL(argv[i], "-xsize") && i + 1 < argc)
+            nXSize = atoi(argv[++i]);
+        else if( EQUAL(argv[i], "-ysize") && i + 1 < argc)
+            nYSize = atoi(argv[++i]);
+        else if( EQUAL(argv[i], "-iters") && i + 1 < argc)
+            nIters = atoi(argv[++i]);
+        else if( EQUAL(argv[i], "-threads") && i + 1 < argc)
+            nThreads = atoi(argv[++i]);
+        else
+            Usage();
+    }
+    if( nXSize <= 0 || nYSize <= 0 || nIters <= 0 || nThreads <= 0 )
+        Usage();
+
+    const GDALDataType aeTypes[] = { GDT_Byte, GDT_Int16, GDT_UInt16,
+                                     GDT_Float32, GDT_Float64 };
+    const GDALResampleAlg aeAlgs[] = { GRA_NearestNeighbour, GRA_Bilinear,
+                                       GRA_Cubic, GRA_CubicSpline,
+                                       GRA_Lanczos };
+    const char* const apszAlgNames[] = { "near", "bilinear", "cubic",
+                                         "cubicspline", "lanczos" };
+
+    GDALDriver* poMEMDrv = GetGDALDriverManager()->GetDriverByName("MEM");
+    // Destination pixels are 0.8 times the size of source pixels, and
+    // shifted by a fraction of pixel, to have non trivial weights.
+    const int nDstXSize = static_cast<int>(nXSize / 0.8) - 2;
+    const int nDstYSize = static_cast<int>(nYSize / 0.8) - 2;
+    double adfDstGT[6] = { 0.3, 0.8, 0, -0.3, 0, -0.8 };
+
+    printf("Type     Resampling    Generic (Mpix/s)  AVX2 (Mpix/s)  Speedup\n");
+    for( const GDALDataType eDT: aeTypes )
+    {
+        GDALDataset* poSrcDS = CreateSource(eDT, nXSize, nYSize);
+        GDALDataset* poDstDS = poMEMDrv->Create("", nDstXSize, nDstYSize,
+                                                1, eDT, nullptr);
+        poDstDS->SetGeoTransform(adfDstGT);
+
+        for( size_t i = 0; i < CPL_ARRAYSIZE(aeAlgs); i++ )
+        {
+            CPLSetConfigOption("GDAL_USE_AVX2", "NO");
+            const double dfGeneric =
+                Warp(poSrcDS, poDstDS, aeAlgs[i], nIters, nThreads);
+            CPLSetConfigOption("GDAL_USE_AVX2", nullptr);
+            const double dfDefault =
+                Warp(poSrcDS, poDstDS, aeAlgs[i], nIters, nThreads);
+            printf("%-8s %-12s  %16.2f  %13.2f  %7.2f\n",
+                   GDALGetDataTypeName(eDT), apszAlgNames[i],
+                   dfGeneric, dfDefault, dfDefault / dfGeneric);
+        }
+
+        GDALClose(poDstDS);
+        GDALClose(poSrcDS);
+    }
+
+    GDALDestroyDriverManager();
+    CSLDestroy( argv );
+
+    return 0;
+}
@@ -1830,6 +1830,38 @@ def test_tiff_ovr_average_multiband_vs_singleband():
     assert cs_band == cs_pixel
 
 
+###############################################################################
+# Test that generating overviews with GDAL_NUM_THREADS gives the same result
+# as the single-threaded code path, for the single band and multi band
+# (pixel interleaved) code paths.
+
+
+@pytest.mark.parametrize("resampling", ['NEAREST', 'AVERAGE', 'CUBIC', 'MODE'])
+@pytest.mark.parametrize("interleave", ['BAND', 'PIXEL'])
+def test_tiff_ovr_num_threads(resampling, interleave):
+
+    tmpfilename = '/vsimem/tiff_ovr_num_threads.tif'
+
+    def build(num_threads):
+        gdal.Translate(tmpfilename, 'data/reproduce_average_issue.tif',
+                       width=1000, height=1000, noData=0,
+                       resampleAlg='bilinear',
+                       creationOptions=['INTERLEAVE=' + interleave,
+                                        'COMPRESS=DEFLATE',
+                                        'BLOCKYSIZE=32'])
+        ds = gdal.Open(tmpfilename, gdal.GA_Update)
+        with gdaltest.config_option('GDAL_NUM_THREADS', num_threads):
+            ret = ds.BuildOverviews(resampling, [2, 4, 8])
+        assert ret == 0
+        cs = [ds.GetRasterBand(i+1).GetOverview(j).Checksum()
+              for i in range(ds.RasterCount)
+              for j in range(ds.GetRasterBand(1).GetOverviewCount())]
+        ds = None
+        gdal.GetDriverByName('GTiff').Delete(tmpfilename)
+        return cs
+
+    assert build('4') == build(None)
+
 ###############################################################################
 # Cleanup
 
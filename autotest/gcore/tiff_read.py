@@ -3367,3 +3367,51 @@ def test_tiff_read_cog_with_mask_vsicurl():
 
         gdal.GetDriverByName('GTIFF').Delete(in_filename)
         gdal.GetDriverByName('GTIFF').Delete(cog_filename)
+
+###############################################################################
+# Test multi-threaded decoding of tiles/strips in RasterIO()
+
+
+@pytest.mark.parametrize("creation_options", [
+    ['TILED=YES', 'BLOCKXSIZE=16', 'BLOCKYSIZE=16', 'COMPRESS=DEFLATE'],
+    ['TILED=YES', 'BLOCKXSIZE=16', 'BLOCKYSIZE=16', 'COMPRESS=LZW', 'INTERLEAVE=BAND'],
+    ['BLOCKYSIZE=3', 'COMPRESS=DEFLATE', 'PREDICTOR=2'],
+])
+def test_tiff_read_multithreaded_decoding(creation_options):
+
+    filename = '/vsimem/test_tiff_read_multithreaded_decoding.tif'
+    src_ds = gdal.Open('data/rgbsmall.tif')
+    gdal.GetDriverByName('GTiff').CreateCopy(filename, src_ds,
+                                             options=creation_options)
+    expected = src_ds.ReadRaster()
+    expected_cs = [src_ds.GetRasterBand(i+1).Checksum() for i in range(3)]
+    src_ds = None
+
+    ds = gdal.OpenEx(filename, open_options=['NUM_THREADS=4'])
+    assert ds.ReadRaster() == expected
+    ds = None
+
+    # Band-level requests
+    ds = gdal.OpenEx(filename, open_options=['NUM_THREADS=ALL_CPUS'])
+    assert [ds.GetRasterBand(i+1).Checksum() for i in range(3)] == expected_cs
+    ds = None
+
+    # Sub-window and subsampled requests
+    ds = gdal.OpenEx(filename, open_options=['NUM_THREADS=4'])
+    ref_ds = gdal.Open(filename)
+    assert ds.ReadRaster(3, 5, 40, 31) == ref_ds.ReadRaster(3, 5, 40, 31)
+    assert ds.ReadRaster(0, 0, 50, 50, 25, 25) == ref_ds.ReadRaster(0, 0, 50, 50, 25, 25)
+    ds = None
+
+    # Cache so small that the request must be processed by slabs
+    oldSize = gdal.GetCacheMax()
+    gdal.SetCacheMax(60000)
+    try:
+        ds = gdal.OpenEx(filename, open_options=['NUM_THREADS=4'])
+        assert ds.ReadRaster() == expected
+        ds = None
+    finally:
+        gdal.SetCacheMax(oldSize)
+
+    gdal.Unlink(filename)
+
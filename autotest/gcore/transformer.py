@@ -736,3 +736,37 @@ def test_transformer_no_reverse_method():
     with gdaltest.error_handler():
         (success, pnt) = tr.TransformPoint(1, 2, 49)
     assert not success
+
+###############################################################################
+# Test the batched geotransform path and the GDAL_WARP_DEBUG_TIMING reporting
+
+
+def test_transformer_rotated_geotransform_timing():
+
+    ds = gdal.GetDriverByName('MEM').Create('', 10, 10)
+    gt = [100, 2, 0.5, 200, 0.25, -3]
+    ds.SetGeoTransform(gt)
+
+    debug_msgs = []
+
+    def handler(err_class, err_no, msg):
+        if err_class == gdal.CE_Debug:
+            debug_msgs.append(msg)
+
+    with gdaltest.config_options({'GDAL_WARP_DEBUG_TIMING': 'YES',
+                                  'CPL_DEBUG': 'ON'}):
+        gdal.PushErrorHandler(handler)
+        try:
+            tr = gdal.Transformer(ds, None, [])
+            pnts = [(x + 0.5, y * 1.5, 0) for x in range(10) for y in range(5)]
+            res, success = tr.TransformPoints(0, pnts)
+            tr = None
+        finally:
+            gdal.PopErrorHandler()
+
+    assert all(success)
+    for (x, y, _), (gx, gy, _) in zip(pnts, res):
+        assert gx == pytest.approx(gt[0] + x * gt[1] + y * gt[2], abs=1e-10)
+        assert gy == pytest.approx(gt[3] + x * gt[4] + y * gt[5], abs=1e-10)
+
+    assert [msg for msg in debug_msgs if 'GDALGenImgProjTransform(): 50 points' in msg]
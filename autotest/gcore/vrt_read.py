@@ -1308,3 +1308,86 @@ def test_vrt_shared_no_proxy_pool_error():
     with gdaltest.error_handler():
         ds = gdal.Open(vrt_text)
     assert not ds
+
+###############################################################################
+# Test reading non-overlapping sources in parallel
+
+
+def test_vrt_read_multithreaded_sources():
+
+    src_ds = gdal.Open('data/rgbsmall.tif')
+    tile_filenames = []
+    # 50x50 raster split in 3x3 tiles
+    for j in range(3):
+        for i in range(3):
+            filename = '/vsimem/vrt_read_mt_%d_%d.tif' % (i, j)
+            gdal.Translate(filename, src_ds,
+                           srcWin=[i * 17, j * 17,
+                                   16 if i == 2 else 17,
+                                   16 if j == 2 else 17])
+            tile_filenames.append(filename)
+
+    gdal.BuildVRT('/vsimem/vrt_read_mt.vrt', tile_filenames)
+
+    def read(open_options=None):
+        ds = gdal.OpenEx('/vsimem/vrt_read_mt.vrt', open_options=open_options)
+        return (ds.ReadRaster(),
+                ds.GetRasterBand(1).ReadRaster(),
+                ds.GetRasterBand(2).ReadRaster(5, 6, 40, 30),
+                ds.ReadRaster(3, 4, 40, 30, 20, 15,
+                              resample_alg=gdal.GRIORA_Bilinear),
+                [ds.GetRasterBand(i + 1).Checksum() for i in range(3)])
+
+    ref = read()
+    assert ref[4] == [src_ds.GetRasterBand(i + 1).Checksum() for i in range(3)]
+    assert read(['NUM_THREADS=4']) == ref
+    assert read(['NUM_THREADS=ALL_CPUS']) == ref
+    with gdaltest.config_option('VRT_NUM_THREADS', '3'):
+        assert read() == ref
+    with gdaltest.error_handler():
+        assert read(['NUM_THREADS=invalid']) == ref
+
+    # Overlapping sources: the last one must win, as in sequential reading
+    gdal.BuildVRT('/vsimem/vrt_read_mt.vrt',
+                  tile_filenames + ['data/rgbsmall.tif'])
+    ref = read()
+    assert read(['NUM_THREADS=4']) == ref
+
+    # Nested VRTs sharing the same tiles
+    gdal.BuildVRT('/vsimem/vrt_read_mt_all.vrt', tile_filenames)
+    gdal.Translate('/vsimem/vrt_read_mt_top.vrt', '/vsimem/vrt_read_mt_all.vrt',
+                   format='VRT', srcWin=[0, 0, 50, 25])
+    gdal.Translate('/vsimem/vrt_read_mt_bottom.vrt',
+                   '/vsimem/vrt_read_mt_all.vrt',
+                   format='VRT', srcWin=[0, 25, 50, 25])
+    ds = gdal.BuildVRT('/vsimem/vrt_read_mt.vrt',
+                       ['/vsimem/vrt_read_mt_top.vrt',
+                        '/vsimem/vrt_read_mt_bottom.vrt'])
+    ds = None
+    ref = read()
+    assert ref[4] == [src_ds.GetRasterBand(i + 1).Checksum() for i in range(3)]
+    assert read(['NUM_THREADS=4']) == ref
+    for filename in ('/vsimem/vrt_read_mt_all.vrt',
+                     '/vsimem/vrt_read_mt_top.vrt',
+                     '/vsimem/vrt_read_mt_bottom.vrt'):
+        gdal.Unlink(filename)
+
+    # Error in a source must be propagated
+    gdal.BuildVRT('/vsimem/vrt_read_mt.vrt', tile_filenames)
+    f = gdal.VSIFOpenL('/vsimem/vrt_read_mt.vrt', 'rb')
+    vrt_text = gdal.VSIFReadL(1, 100000, f).decode('utf-8')
+    gdal.VSIFCloseL(f)
+    vrt_text = vrt_text.replace('vrt_read_mt_1_1.tif', 'non_existing.tif')
+    f = gdal.VSIFOpenL('/vsimem/vrt_read_mt.vrt', 'wb')
+    gdal.VSIFWriteL(vrt_text, 1, len(vrt_text), f)
+    gdal.VSIFCloseL(f)
+    with gdaltest.error_handler():
+        ds = gdal.OpenEx('/vsimem/vrt_read_mt.vrt',
+                         open_options=['NUM_THREADS=4'])
+        assert ds.GetRasterBand(1).ReadRaster() is None
+        assert gdal.GetLastErrorMsg() != ''
+    ds = None
+
+    gdal.Unlink('/vsimem/vrt_read_mt.vrt')
+    for filename in tile_filenames:
+        gdal.Unlink(filename)
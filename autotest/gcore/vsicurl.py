@@ -29,6 +29,7 @@
 ###############################################################################
 
 from sys import version_info
+import threading
 import time
 from osgeo import gdal
 from osgeo import ogr
@@ -463,6 +464,197 @@ def test_vsicurl_no_size_in_HEAD():
     assert statres.size == 10
 
 ###############################################################################
+# Test that a large read is split into parallel range requests
+
+
+def test_vsicurl_parallel_range_requests():
+
+    if gdaltest.webserver_port == 0:
+        pytest.skip()
+
+    gdal.VSICurlClearCache()
+
+    chunk_size = 16384
+    data = ''.join(chr(ord('a') + i) * chunk_size for i in range(20))
+
+    handler = webserver.SequentialHandler()
+    handler.add('HEAD', '/test_vsicurl_parallel_range_requests.bin', 200,
+                {'Content-Length': '%d' % len(data)})
+    handler.add_unordered('GET', '/test_vsicurl_parallel_range_requests.bin', 206,
+                          {'Content-Range': 'bytes 0-163839/%d' % len(data)},
+                          data[0:163840],
+                          expected_headers={'Range': 'bytes=0-163839'})
+    handler.add_unordered('GET', '/test_vsicurl_parallel_range_requests.bin', 206,
+                          {'Content-Range': 'bytes 163840-327679/%d' % len(data)},
+                          data[163840:],
+                          expected_headers={'Range': 'bytes=163840-327679'})
+    with gdaltest.config_option('GDAL_HTTP_MAX_PARALLEL_REQUESTS', '2'):
+        with webserver.install_http_handler(handler):
+            f = gdal.VSIFOpenL('/vsicurl/http://localhost:%d/test_vsicurl_parallel_range_requests.bin' % gdaltest.webserver_port, 'rb')
+            assert f is not None
+            got = gdal.VSIFReadL(1, len(data), f)
+            gdal.VSIFCloseL(f)
+    assert got.decode('ascii') == data
+
+    gdal.VSICurlClearCache()
+
+###############################################################################
+# Test a read of more chunks than the region cache can hold
+
+
+def test_vsicurl_read_more_chunks_than_cache():
+
+    if gdaltest.webserver_port == 0:
+        pytest.skip()
+
+    gdal.VSICurlClearCache()
+
+    # The default region cache holds 1000 chunks of 16384 bytes.
+    chunk_size = 16384
+    chunk_count = 1001
+    data = b''.join(bytes([i % 251]) * chunk_size
+                    for i in range(chunk_count))
+
+    def method(request):
+        range_start, range_end = \
+            request.headers['Range'][len('bytes='):].split('-')
+        range_start = int(range_start)
+        range_end = min(int(range_end), len(data) - 1)
+        request.protocol_version = 'HTTP/1.1'
+        request.send_response(206)
+        request.send_header('Content-Range', 'bytes %d-%d/%d' % (
+            range_start, range_end, len(data)))
+        request.send_header('Content-Length', range_end - range_start + 1)
+        request.end_headers()
+        request.wfile.write(data[range_start:range_end + 1])
+
+    handler = webserver.SequentialHandler()
+    handler.add('HEAD', '/test_vsicurl_read_more_chunks_than_cache.bin', 200,
+                {'Content-Length': '%d' % len(data)})
+    # A first request of 1000 chunks, and a second one for the last chunk
+    handler.add('GET', '/test_vsicurl_read_more_chunks_than_cache.bin',
+                custom_method=method)
+    handler.add('GET', '/test_vsicurl_read_more_chunks_than_cache.bin',
+                custom_method=method)
+    with gdaltest.config_option('GDAL_HTTP_MAX_PARALLEL_REQUESTS', '1'):
+        with webserver.install_http_handler(handler):
+            f = gdal.VSIFOpenL('/vsicurl/http://localhost:%d/test_vsicurl_read_more_chunks_than_cache.bin' % gdaltest.webserver_port, 'rb')
+            assert f is not None
+            got = gdal.VSIFReadL(1, len(data), f)
+            gdal.VSIFCloseL(f)
+    assert got == data
+
+    gdal.VSICurlClearCache()
+
+###############################################################################
+# Test that concurrent reads of the same chunk from several handles issue a
+# single GET request
+
+
+def test_vsicurl_coalesce_concurrent_downloads():
+
+    if gdaltest.webserver_port == 0:
+        pytest.skip()
+
+    gdal.VSICurlClearCache()
+
+    url = '/vsicurl/http://localhost:%d/test_vsicurl_coalesce_concurrent_downloads.bin' % gdaltest.webserver_port
+    data = '0123456789'
+
+    def method(request):
+        # Give time to the other readers to wait for this download
+        time.sleep(0.5)
+        request.protocol_version = 'HTTP/1.1'
+        request.send_response(206)
+        request.send_header('Content-Range', 'bytes 0-9/10')
+        request.send_header('Content-Length', 10)
+        request.end_headers()
+        request.wfile.write(data.encode('ascii'))
+
+    handler = webserver.SequentialHandler()
+    handler.add('HEAD', '/test_vsicurl_coalesce_concurrent_downloads.bin', 200,
+                {'Content-Length': '10'})
+    handler.add('GET', '/test_vsicurl_coalesce_concurrent_downloads.bin',
+                custom_method=method)
+    with webserver.install_http_handler(handler):
+        handles = [gdal.VSIFOpenL(url, 'rb') for _ in range(4)]
+        assert None not in handles
+
+        results = [None] * len(handles)
+
+        def read(i):
+            results[i] = gdal.VSIFReadL(1, 10, handles[i])
+
+        threads = [threading.Thread(target=read, args=(i,))
+                   for i in range(len(handles))]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        for f in handles:
+            gdal.VSIFCloseL(f)
+
+    for res in results:
+        assert res.decode('ascii') == data
+
+    gdal.VSICurlClearCache()
+
+###############################################################################
+# Test the persistent disk cache (CPL_VSIL_CURL_DISK_CACHE_DIR)
+
+
+def test_vsicurl_disk_cache():
+
+    if gdaltest.webserver_port == 0:
+        pytest.skip()
+
+    def read(etag, expect_get):
+        gdal.VSICurlClearCache()
+        handler = webserver.SequentialHandler()
+        handler.add('HEAD', '/test_vsicurl_disk_cache.bin', 200,
+                    {'Content-Length': '10', 'ETag': '"%s"' % etag})
+        if expect_get:
+            handler.add('GET', '/test_vsicurl_disk_cache.bin', 206,
+                        {'Content-Range': 'bytes 0-9/10'}, etag * 10,
+                        expected_headers={'Range': 'bytes=0-16383'})
+        with webserver.install_http_handler(handler):
+            f = gdal.VSIFOpenL('/vsicurl/http://localhost:%d/test_vsicurl_disk_cache.bin' % gdaltest.webserver_port, 'rb')
+            assert f is not None
+            data = gdal.VSIFReadL(1, 10, f)
+            gdal.VSIFCloseL(f)
+        assert data.decode('ascii') == etag * 10
+
+    def stats():
+        return {k: int(v) for k, v in (x.split('=') for x in gdal.VSICurlGetDiskCacheStatistics())}
+
+    cache_dir = 'tmp/test_vsicurl_disk_cache'
+    gdal.RmdirRecursive(cache_dir)
+    with gdaltest.config_option('CPL_VSIL_CURL_DISK_CACHE_DIR', cache_dir):
+        before = stats()
+
+        # Not in cache: downloaded and written
+        read('a', expect_get=True)
+        after = stats()
+        assert after['MISSES'] - before['MISSES'] == 1
+        assert after['WRITES'] - before['WRITES'] == 1
+
+        # In-memory cache cleared: served from disk
+        read('a', expect_get=False)
+        after2 = stats()
+        assert after2['HITS'] - after['HITS'] == 1
+        assert after2['WRITES'] == after['WRITES']
+
+        # Remote file modified: cached content must not be used
+        read('b', expect_get=True)
+        after3 = stats()
+        assert after3['HITS'] == after2['HITS']
+        assert after3['WRITES'] - after2['WRITES'] == 1
+
+    gdal.VSICurlClearCache()
+    gdal.RmdirRecursive(cache_dir)
+    assert gdal.VSICurlGetDiskCacheStatistics() is None
+
+###############################################################################
 
 
 def test_vsicurl_stop_webserver():
@@ -714,6 +714,92 @@ def test_vsigzip_multi_thread():
         pytest.fail()
 
     
+###############################################################################
+# Test multithreaded decompression
+
+
+def test_vsigzip_multi_thread_read():
+
+    # Poorly compressible content, so that the compressed file is large
+    # enough to trigger multithreaded decompression
+    content = ''.join('%06d\n' % ((i * 7919 + (i * i) % 104729) % 1000000) for i in range(1000000))
+    content = content.encode('ascii')
+
+    for filename in ('/vsigzip//vsimem/vsigzip_multi_thread_read.gz',
+                     '/vsizip//vsimem/vsigzip_multi_thread_read.zip/test.txt'):
+        with gdaltest.config_options({'GDAL_NUM_THREADS': '4',
+                                      'CPL_VSIL_DEFLATE_CHUNK_SIZE': '128K'}):
+            f = gdal.VSIFOpenL(filename, 'wb')
+            gdal.VSIFWriteL(content, 1, len(content), f)
+            gdal.VSIFCloseL(f)
+
+            f = gdal.VSIFOpenL(filename, 'rb')
+            data = gdal.VSIFReadL(1, len(content) + 1, f)
+            assert data == content
+            gdal.VSIFSeekL(f, 12345, 0)
+            assert gdal.VSIFReadL(1, 10, f) == content[12345:12345+10]
+            gdal.VSIFCloseL(f)
+
+    # Single-threaded compressed file: fallback to single-threaded reading
+    f = gdal.VSIFOpenL('/vsigzip//vsimem/vsigzip_multi_thread_read.gz', 'wb')
+    gdal.VSIFWriteL(content, 1, len(content), f)
+    gdal.VSIFCloseL(f)
+    with gdaltest.config_option('GDAL_NUM_THREADS', '4'):
+        f = gdal.VSIFOpenL('/vsigzip//vsimem/vsigzip_multi_thread_read.gz', 'rb')
+        data = gdal.VSIFReadL(1, len(content) + 1, f)
+        gdal.VSIFCloseL(f)
+    assert data == content
+
+    gdal.Unlink('/vsimem/vsigzip_multi_thread_read.gz')
+    gdal.Unlink('/vsimem/vsigzip_multi_thread_read.gz.properties')
+    gdal.Unlink('/vsimem/vsigzip_multi_thread_read.zip')
+
+###############################################################################
+# Test the persistable random-access index of /vsigzip/
+
+
+def test_vsigzip_index():
+
+    content = ''.join('%08d\n' % ((i * 7919) % 100000) for i in range(200000))
+    content = content.encode('ascii')
+    f = gdal.VSIFOpenL('/vsigzip//vsimem/vsigzip_index.gz', 'wb')
+    gdal.VSIFWriteL(content, 1, len(content), f)
+    gdal.VSIFCloseL(f)
+    f = gdal.VSIFOpenL('/vsigzip//vsimem/vsigzip_index_other.gz', 'wb')
+    gdal.VSIFWriteL('foo', 1, 3, f)
+    gdal.VSIFCloseL(f)
+
+    def check(filename):
+        f = gdal.VSIFOpenL('/vsigzip/' + filename, 'rb')
+        assert f is not None
+        for offset in (len(content) - 10, 1000000, 65536 * 3 + 17, 5, 1234567):
+            assert gdal.VSIFSeekL(f, offset, 0) == 0
+            assert gdal.VSIFReadL(1, 10, f) == content[offset:offset+10]
+        gdal.VSIFSeekL(f, 0, 2)
+        assert gdal.VSIFTellL(f) == len(content)
+        gdal.VSIFCloseL(f)
+
+    with gdaltest.config_options({'CPL_VSIL_GZIP_INDEX': 'YES',
+                                  'CPL_VSIL_GZIP_INDEX_SPAN': '65536',
+                                  'CPL_VSIL_GZIP_WRITE_PROPERTIES': 'NO'}):
+        # First opening builds and saves the index
+        check('/vsimem/vsigzip_index.gz')
+        assert gdal.VSIStatL('/vsimem/vsigzip_index.gz.gzidx') is not None
+
+        # Open another file, so that the next opening does not reuse the
+        # cached handle, and reload the index
+        gdal.VSIFCloseL(gdal.VSIFOpenL('/vsigzip//vsimem/vsigzip_index_other.gz', 'rb'))
+        check('/vsimem/vsigzip_index.gz')
+
+        # A corrupted index is ignored
+        gdal.VSIFCloseL(gdal.VSIFOpenL('/vsigzip//vsimem/vsigzip_index_other.gz', 'rb'))
+        gdal.FileFromMemBuffer('/vsimem/vsigzip_index.gz.gzidx', 'GDALGZI1')
+        check('/vsimem/vsigzip_index.gz')
+
+    gdal.Unlink('/vsimem/vsigzip_index.gz')
+    gdal.Unlink('/vsimem/vsigzip_index_other.gz')
+    gdal.Unlink('/vsimem/vsigzip_index.gz.gzidx')
+
 ###############################################################################
 # Test vsisync()
 
@@ -705,7 +705,7 @@ def test_visoss_6():
     if gdaltest.webserver_port == 0:
         pytest.skip()
 
-    with gdaltest.config_option('VSIOSS_CHUNK_SIZE', '1'):  # 1 MB
+    with gdaltest.config_options({'VSIOSS_CHUNK_SIZE': '1', 'VSIOSS_PARALLEL_UPLOADS': '0'}):  # 1 MB, synchronous uploads
         with webserver.install_http_handler(webserver.SequentialHandler()):
             f = gdal.VSIFOpenL('/vsioss/oss_fake_bucket4/large_file.bin', 'wb')
     assert f is not None
@@ -800,7 +800,7 @@ def test_visoss_6():
                          '/vsioss/oss_fake_bucket4/large_file_initiate_empty_result.bin',
                          '/vsioss/oss_fake_bucket4/large_file_initiate_invalid_xml_result.bin',
                          '/vsioss/oss_fake_bucket4/large_file_initiate_no_uploadId.bin']:
-            with gdaltest.config_option('VSIOSS_CHUNK_SIZE', '1'):  # 1 MB
+            with gdaltest.config_options({'VSIOSS_CHUNK_SIZE': '1', 'VSIOSS_PARALLEL_UPLOADS': '0'}):  # 1 MB, synchronous uploads
                 f = gdal.VSIFOpenL(filename, 'wb')
             assert f is not None
             with gdaltest.error_handler():
@@ -824,7 +824,7 @@ def test_visoss_6():
     with webserver.install_http_handler(handler):
         for filename in ['/vsioss/oss_fake_bucket4/large_file_upload_part_403_error.bin',
                          '/vsioss/oss_fake_bucket4/large_file_upload_part_no_etag.bin']:
-            with gdaltest.config_option('VSIOSS_CHUNK_SIZE', '1'):  # 1 MB
+            with gdaltest.config_options({'VSIOSS_CHUNK_SIZE': '1', 'VSIOSS_PARALLEL_UPLOADS': '0'}):  # 1 MB, synchronous uploads
                 f = gdal.VSIFOpenL(filename, 'wb')
             assert f is not None, filename
             with gdaltest.error_handler():
@@ -843,7 +843,7 @@ def test_visoss_6():
 
     filename = '/vsioss/oss_fake_bucket4/large_file_abortmultipart_403_error.bin'
     with webserver.install_http_handler(handler):
-        with gdaltest.config_option('VSIOSS_CHUNK_SIZE', '1'):  # 1 MB
+        with gdaltest.config_options({'VSIOSS_CHUNK_SIZE': '1', 'VSIOSS_PARALLEL_UPLOADS': '0'}):  # 1 MB, synchronous uploads
             f = gdal.VSIFOpenL(filename, 'wb')
         assert f is not None, filename
         with gdaltest.error_handler():
@@ -865,7 +865,7 @@ def test_visoss_6():
 
     filename = '/vsioss/oss_fake_bucket4/large_file_completemultipart_403_error.bin'
     with webserver.install_http_handler(handler):
-        with gdaltest.config_option('VSIOSS_CHUNK_SIZE', '1'):  # 1 MB
+        with gdaltest.config_options({'VSIOSS_CHUNK_SIZE': '1', 'VSIOSS_PARALLEL_UPLOADS': '0'}):  # 1 MB, synchronous uploads
             f = gdal.VSIFOpenL(filename, 'wb')
             assert f is not None, filename
             ret = gdal.VSIFWriteL(big_buffer, 1, size, f)
@@ -876,6 +876,48 @@ def test_visoss_6():
             assert gdal.GetLastErrorMsg() != '', filename
 
     
+###############################################################################
+# Test multipart upload with a part uploaded in the background that fails.
+# With a single upload in flight, the failure is reported either by the
+# Write() that submits the next part, or by Close(), which then aborts
+# the multipart upload.
+
+
+@pytest.mark.parametrize('second_part', [False, True])
+def test_visoss_write_multipart_parallel_part_failure(second_part):
+
+    if gdaltest.webserver_port == 0:
+        pytest.skip()
+
+    filename = '/vsioss/oss_fake_bucket4/large_file_parallel_part_failure.bin'
+    with gdaltest.config_options({'VSIOSS_CHUNK_SIZE_BYTES': '10',
+                                  'VSIOSS_PARALLEL_UPLOADS': '1'}):
+        with webserver.install_http_handler(webserver.SequentialHandler()):
+            f = gdal.VSIFOpenL(filename, 'wb')
+    assert f is not None
+
+    handler = webserver.SequentialHandler()
+    handler.add('POST', '/oss_fake_bucket4/large_file_parallel_part_failure.bin?uploads', 200, {},
+                '<?xml version="1.0" encoding="UTF-8"?><InitiateMultipartUploadResult><UploadId>my_id</UploadId></InitiateMultipartUploadResult>')
+    handler.add('PUT', '/oss_fake_bucket4/large_file_parallel_part_failure.bin?partNumber=1&uploadId=my_id', 403)
+    handler.add('DELETE', '/oss_fake_bucket4/large_file_parallel_part_failure.bin?uploadId=my_id', 204)
+
+    with webserver.install_http_handler(handler):
+        if second_part:
+            with gdaltest.error_handler():
+                ret = gdal.VSIFWriteL('0123456789abcdefghij', 1, 20, f)
+            assert ret == 0
+            gdal.ErrorReset()
+            assert gdal.VSIFCloseL(f) == 0
+            assert gdal.GetLastErrorMsg() == ''
+        else:
+            assert gdal.VSIFWriteL('0123456789', 1, 10, f) == 10
+            gdal.ErrorReset()
+            with gdaltest.error_handler():
+                assert gdal.VSIFCloseL(f) != 0
+            assert gdal.GetLastErrorMsg() != ''
+
+
 ###############################################################################
 # Test Mkdir() / Rmdir()
 
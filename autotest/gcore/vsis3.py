@@ -1380,7 +1380,7 @@ def test_vsis3_6():
     if gdaltest.webserver_port == 0:
         pytest.skip()
 
-    with gdaltest.config_option('VSIS3_CHUNK_SIZE', '1'):  # 1 MB
+    with gdaltest.config_options({'VSIS3_CHUNK_SIZE': '1', 'VSIS3_PARALLEL_UPLOADS': '0'}):  # 1 MB, synchronous uploads
         with webserver.install_http_handler(webserver.SequentialHandler()):
             f = gdal.VSIFOpenL('/vsis3/s3_fake_bucket4/large_file.bin', 'wb')
     assert f is not None
@@ -1490,7 +1490,7 @@ def test_vsis3_6():
                          '/vsis3/s3_fake_bucket4/large_file_initiate_empty_result.bin',
                          '/vsis3/s3_fake_bucket4/large_file_initiate_invalid_xml_result.bin',
                          '/vsis3/s3_fake_bucket4/large_file_initiate_no_uploadId.bin']:
-            with gdaltest.config_option('VSIS3_CHUNK_SIZE', '1'):  # 1 MB
+            with gdaltest.config_options({'VSIS3_CHUNK_SIZE': '1', 'VSIS3_PARALLEL_UPLOADS': '0'}):  # 1 MB, synchronous uploads
                 f = gdal.VSIFOpenL(filename, 'wb')
             assert f is not None
             with gdaltest.error_handler():
@@ -1514,7 +1514,7 @@ def test_vsis3_6():
     with webserver.install_http_handler(handler):
         for filename in ['/vsis3/s3_fake_bucket4/large_file_upload_part_403_error.bin',
                          '/vsis3/s3_fake_bucket4/large_file_upload_part_no_etag.bin']:
-            with gdaltest.config_option('VSIS3_CHUNK_SIZE', '1'):  # 1 MB
+            with gdaltest.config_options({'VSIS3_CHUNK_SIZE': '1', 'VSIS3_PARALLEL_UPLOADS': '0'}):  # 1 MB, synchronous uploads
                 f = gdal.VSIFOpenL(filename, 'wb')
             assert f is not None, filename
             with gdaltest.error_handler():
@@ -1533,7 +1533,7 @@ def test_vsis3_6():
 
     filename = '/vsis3/s3_fake_bucket4/large_file_abortmultipart_403_error.bin'
     with webserver.install_http_handler(handler):
-        with gdaltest.config_option('VSIS3_CHUNK_SIZE', '1'):  # 1 MB
+        with gdaltest.config_options({'VSIS3_CHUNK_SIZE': '1', 'VSIS3_PARALLEL_UPLOADS': '0'}):  # 1 MB, synchronous uploads
             f = gdal.VSIFOpenL(filename, 'wb')
         assert f is not None, filename
         with gdaltest.error_handler():
@@ -1555,7 +1555,7 @@ def test_vsis3_6():
 
     filename = '/vsis3/s3_fake_bucket4/large_file_completemultipart_403_error.bin'
     with webserver.install_http_handler(handler):
-        with gdaltest.config_option('VSIS3_CHUNK_SIZE', '1'):  # 1 MB
+        with gdaltest.config_options({'VSIS3_CHUNK_SIZE': '1', 'VSIS3_PARALLEL_UPLOADS': '0'}):  # 1 MB, synchronous uploads
             f = gdal.VSIFOpenL(filename, 'wb')
             assert f is not None, filename
             ret = gdal.VSIFWriteL(big_buffer, 1, size, f)
@@ -1578,7 +1578,7 @@ def test_vsis3_write_multipart_retry():
     with gdaltest.config_options({'GDAL_HTTP_MAX_RETRY': '2',
                                   'GDAL_HTTP_RETRY_DELAY': '0.01'}):
 
-        with gdaltest.config_option('VSIS3_CHUNK_SIZE', '1'):  # 1 MB
+        with gdaltest.config_options({'VSIS3_CHUNK_SIZE': '1', 'VSIS3_PARALLEL_UPLOADS': '0'}):  # 1 MB, synchronous uploads
             with webserver.install_http_handler(webserver.SequentialHandler()):
                 f = gdal.VSIFOpenL('/vsis3/s3_fake_bucket4/large_file.bin', 'wb')
         assert f is not None
@@ -1620,6 +1620,88 @@ def test_vsis3_write_multipart_retry():
             gdal.VSIFCloseL(f)
 
 
+###############################################################################
+# Test multipart upload with parts uploaded in the background
+
+
+def test_vsis3_write_multipart_parallel():
+
+    if gdaltest.webserver_port == 0:
+        pytest.skip()
+
+    with gdaltest.config_options({'VSIS3_CHUNK_SIZE_BYTES': '10',
+                                  'VSIS3_PARALLEL_UPLOADS': '2'}):
+        with webserver.install_http_handler(webserver.SequentialHandler()):
+            f = gdal.VSIFOpenL('/vsis3/s3_fake_bucket4/large_file_parallel.bin', 'wb')
+    assert f is not None
+
+    handler = webserver.SequentialHandler()
+    handler.add('POST', '/s3_fake_bucket4/large_file_parallel.bin?uploads', 200, {},
+                '<?xml version="1.0" encoding="UTF-8"?><InitiateMultipartUploadResult><UploadId>my_id</UploadId></InitiateMultipartUploadResult>')
+    # Parts may be received in any order
+    for part, content in [(1, '0123456789'), (2, 'abcdefghij'), (3, 'ABCDE')]:
+        handler.add_unordered('PUT', '/s3_fake_bucket4/large_file_parallel.bin?partNumber=%d&uploadId=my_id' % part, 200,
+                              {'ETag': '"etag%d"' % part}, expected_body=content.encode('ascii'))
+    handler.add_unordered('POST', '/s3_fake_bucket4/large_file_parallel.bin?uploadId=my_id', 200,
+                          expected_body="""<CompleteMultipartUpload>
+<Part>
+<PartNumber>1</PartNumber><ETag>"etag1"</ETag></Part>
+<Part>
+<PartNumber>2</PartNumber><ETag>"etag2"</ETag></Part>
+<Part>
+<PartNumber>3</PartNumber><ETag>"etag3"</ETag></Part>
+</CompleteMultipartUpload>
+""".encode('ascii'))
+
+    gdal.ErrorReset()
+    with webserver.install_http_handler(handler):
+        assert gdal.VSIFWriteL('0123456789abcdefghijABCDE', 1, 25, f) == 25
+        assert gdal.VSIFCloseL(f) == 0
+    assert gdal.GetLastErrorMsg() == ''
+
+
+###############################################################################
+# Test multipart upload with a part uploaded in the background that fails.
+# With a single upload in flight, the failure is reported either by the
+# Write() that submits the next part, or by Close(), which then aborts
+# the multipart upload.
+
+
+@pytest.mark.parametrize('second_part', [False, True])
+def test_vsis3_write_multipart_parallel_part_failure(second_part):
+
+    if gdaltest.webserver_port == 0:
+        pytest.skip()
+
+    filename = '/vsis3/s3_fake_bucket4/large_file_parallel_part_failure.bin'
+    with gdaltest.config_options({'VSIS3_CHUNK_SIZE_BYTES': '10',
+                                  'VSIS3_PARALLEL_UPLOADS': '1'}):
+        with webserver.install_http_handler(webserver.SequentialHandler()):
+            f = gdal.VSIFOpenL(filename, 'wb')
+    assert f is not None
+
+    handler = webserver.SequentialHandler()
+    handler.add('POST', '/s3_fake_bucket4/large_file_parallel_part_failure.bin?uploads', 200, {},
+                '<?xml version="1.0" encoding="UTF-8"?><InitiateMultipartUploadResult><UploadId>my_id</UploadId></InitiateMultipartUploadResult>')
+    handler.add('PUT', '/s3_fake_bucket4/large_file_parallel_part_failure.bin?partNumber=1&uploadId=my_id', 403)
+    handler.add('DELETE', '/s3_fake_bucket4/large_file_parallel_part_failure.bin?uploadId=my_id', 204)
+
+    with webserver.install_http_handler(handler):
+        if second_part:
+            with gdaltest.error_handler():
+                ret = gdal.VSIFWriteL('0123456789abcdefghij', 1, 20, f)
+            assert ret == 0
+            gdal.ErrorReset()
+            assert gdal.VSIFCloseL(f) == 0
+            assert gdal.GetLastErrorMsg() == ''
+        else:
+            assert gdal.VSIFWriteL('0123456789', 1, 10, f) == 10
+            gdal.ErrorReset()
+            with gdaltest.error_handler():
+                assert gdal.VSIFCloseL(f) != 0
+            assert gdal.GetLastErrorMsg() != ''
+
+
 ###############################################################################
 # Test Mkdir() / Rmdir()
 
@@ -303,6 +303,35 @@ def test_ehdr_14():
     gdal.GetDriverByName('EHDR').Delete('/vsimem/byte.bil')
     gdal.GetDriverByName('EHDR').Delete('/vsimem/byte_reduced.bil')
 
+###############################################################################
+# Test RasterIO() from a memory mapping of the file (RAW_VIRTUAL_MEM_IO)
+
+
+def test_ehdr_virtual_mem_io():
+
+    src_ds = gdal.Open('data/byte.tif')
+    gdal.GetDriverByName('EHDR').CreateCopy('tmp/byte_vmio.bil', src_ds)
+    src_ds = None
+
+    ds = gdal.Open('tmp/byte_vmio.bil')
+    band = ds.GetRasterBand(1)
+    ref_data = band.ReadRaster()
+    ref_data_subwindow = band.ReadRaster(3, 5, 7, 9,
+                                         buf_type=gdal.GDT_Float32)
+    ref_cs = band.Checksum()
+    ds = None
+
+    with gdaltest.config_option('RAW_VIRTUAL_MEM_IO', 'YES'):
+        ds = gdal.Open('tmp/byte_vmio.bil')
+        band = ds.GetRasterBand(1)
+        assert band.ReadRaster() == ref_data
+        assert band.ReadRaster(3, 5, 7, 9,
+                               buf_type=gdal.GDT_Float32) == ref_data_subwindow
+        assert band.Checksum() == ref_cs
+        ds = None
+
+    gdal.GetDriverByName('EHDR').Delete('tmp/byte_vmio.bil')
+
 ###############################################################################
 # Test support for RAT (#3253)
 
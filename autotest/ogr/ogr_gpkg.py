@@ -3884,6 +3884,54 @@ def test_ogr_gpkg_json():
 
     gdal.Unlink(filename)
 
+###############################################################################
+# Test spatial filtering on the envelope of the geometry blob header,
+# without spatial index
+
+
+def test_ogr_gpkg_spatial_filter_from_header():
+
+    if gdaltest.gpkg_dr is None:
+        pytest.skip()
+
+    filename = '/vsimem/ogr_gpkg_spatial_filter_from_header.gpkg'
+    ds = gdaltest.gpkg_dr.CreateDataSource(filename)
+    lyr = ds.CreateLayer('test', options=['SPATIAL_INDEX=NO'])
+    for wkt in ['POINT (1 2)',
+                'POINT (10 20)',
+                'POINT Z (1.5 2.5 3)',
+                'POINT EMPTY',
+                None,
+                'LINESTRING (0 0,10 10)',
+                'LINESTRING (0 5,5 10)',
+                'POLYGON ((0 0,0 1,1 1,1 0,0 0))',
+                'POLYGON ((100 100,100 101,101 101,101 100,100 100))',
+                'GEOMETRYCOLLECTION EMPTY']:
+        f = ogr.Feature(lyr.GetLayerDefn())
+        if wkt:
+            f.SetGeometryDirectly(ogr.CreateGeometryFromWkt(wkt))
+        lyr.CreateFeature(f)
+    ds = None
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+
+    # Rectangle filter
+    lyr.SetSpatialFilterRect(0.5, 0.5, 3, 3)
+    assert [f.GetFID() for f in lyr] == [1, 3, 6, 8]
+
+    # Non rectangular filter: geometries fully inside its envelope must
+    # still be tested against the filter geometry
+    lyr.SetSpatialFilter(ogr.CreateGeometryFromWkt(
+        'POLYGON ((0 0,0 10,10 0,0 0))'))
+    assert [f.GetFID() for f in lyr] == [1, 3, 6, 7, 8]
+
+    lyr.SetSpatialFilter(None)
+    assert lyr.GetFeatureCount() == 10
+    ds = None
+
+    gdal.Unlink(filename)
+
 ###############################################################################
 # Remove the test db from the tmp directory
 
@@ -480,3 +480,56 @@ def test_gdaldem_lib_nodata():
 
 
 
+
+###############################################################################
+# Test that multi-threaded processing (-nt) gives the same result as the
+# single-threaded one
+
+
+@pytest.mark.parametrize('processing,kwargs', [
+    ('hillshade', {}),
+    ('hillshade', {'computeEdges': True}),
+    ('hillshade', {'combined': True}),
+    ('slope', {}),
+    ('slope', {'slopeFormat': 'percent', 'computeEdges': True}),
+    ('aspect', {'alg': 'ZevenbergenThorne'}),
+    ('TRI', {}),
+    ('TPI', {}),
+    ('roughness', {'computeEdges': True}),
+])
+@pytest.mark.parametrize('datatype', [gdal.GDT_Int16, gdal.GDT_Float32])
+def test_gdaldem_lib_num_threads(processing, kwargs, datatype):
+
+    src_ds = gdal.Translate('', gdal.Open('../gdrivers/data/n43.dt0'),
+                            format='MEM', outputType=datatype)
+    # Add a few nodata values
+    src_ds.GetRasterBand(1).SetNoDataValue(0)
+    src_ds.GetRasterBand(1).WriteRaster(10, 50, 3, 2, struct.pack('f' * 6, *([0] * 6)),
+                                        buf_type=gdal.GDT_Float32)
+
+    ref_ds = gdal.DEMProcessing('', src_ds, processing, format='MEM',
+                                scale=111120, **kwargs)
+    ds = gdal.DEMProcessing('', src_ds, processing, format='MEM',
+                            scale=111120, options=['-nt', '4'], **kwargs)
+    assert ds is not None
+    assert ds.GetRasterBand(1).Checksum() == ref_ds.GetRasterBand(1).Checksum()
+    assert ds.ReadRaster() == ref_ds.ReadRaster()
+
+###############################################################################
+# Test hillshade and slope on a Float32 DEM without nodata, that use the
+# vectorized code paths, against the integer code paths
+
+
+def test_gdaldem_lib_float_vectorized():
+
+    src_ds = gdal.Open('../gdrivers/data/n43.dt0')
+    src_float_ds = gdal.Translate('', src_ds, format='MEM',
+                                  outputType=gdal.GDT_Float32)
+
+    for processing in ('hillshade', 'slope'):
+        ref_ds = gdal.DEMProcessing('', src_ds, processing, format='MEM',
+                                    scale=111120, zFactor=30)
+        ds = gdal.DEMProcessing('', src_float_ds, processing, format='MEM',
+                                scale=111120, zFactor=30,
+                                options=['-nt', '2'])
+        assert ds.GetRasterBand(1).Checksum() == ref_ds.GetRasterBand(1).Checksum(), processing
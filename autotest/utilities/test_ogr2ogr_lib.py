@@ -32,7 +32,7 @@
 import sys
 
 
-from osgeo import gdal, gdalconst, ogr
+from osgeo import gdal, gdalconst, ogr, osr
 import gdaltest
 import ogrtest
 import pytest
@@ -533,3 +533,46 @@ def test_ogr2ogr_lib_ct_no_srs():
     f = lyr.GetNextFeature()
     #f.DumpReadable()
     assert ogrtest.check_feature_geometry(f, "POLYGON ((-479819.84375 4765180.5,-479690.1875 4765259.5,-479647.0 4765369.5,-479730.375 4765400.5,-480039.03125 4765539.5,-480035.34375 4765558.5,-480159.78125 4765610.5,-480202.28125 4765482.0,-480365.0 4765015.5,-480389.6875 4764950.0,-480133.96875 4764856.5,-480080.28125 4764979.5,-480082.96875 4765049.5,-480088.8125 4765139.5,-480059.90625 4765239.5,-480019.71875 4765319.5,-479980.21875 4765409.5,-479909.875 4765370.0,-479859.875 4765270.0,-479819.84375 4765180.5))") == 0
+
+###############################################################################
+# Test -nt (multi-threaded translation)
+
+@pytest.mark.parametrize('options', [
+    '-t_srs EPSG:4326',
+    '-t_srs EPSG:4326 -explodecollections -limit 700',
+    '-clipsrc 450000 4500000 450400 4500400 -nlt PROMOTE_TO_MULTI',
+])
+def test_ogr2ogr_lib_num_threads(options):
+
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(32631)
+    src_ds = ogr.GetDriverByName('Memory').CreateDataSource('')
+    src_lyr = src_ds.CreateLayer('test', srs=srs, geom_type=ogr.wkbMultiPoint)
+    src_lyr.CreateField(ogr.FieldDefn('id', ogr.OFTInteger))
+    for i in range(1000):
+        f = ogr.Feature(src_lyr.GetLayerDefn())
+        f['id'] = i
+        if i % 10 != 9:
+            x = 450000 + i
+            y = 4500000 + (i * 7) % 1000
+            f.SetGeometryDirectly(ogr.CreateGeometryFromWkt(
+                'MULTIPOINT (%d %d,%d %d)' % (x, y, x + 1, y + 1)))
+        src_lyr.CreateFeature(f)
+
+    ref_ds = gdal.VectorTranslate('', src_ds, format='Memory',
+                                  options=options)
+    ds = gdal.VectorTranslate('', src_ds, format='Memory',
+                              options=options + ' -nt 4')
+    ref_lyr = ref_ds.GetLayer(0)
+    lyr = ds.GetLayer(0)
+    assert lyr.GetFeatureCount() == ref_lyr.GetFeatureCount()
+    assert lyr.GetFeatureCount() > 0
+    for ref_f in ref_lyr:
+        f = lyr.GetNextFeature()
+        assert f['id'] == ref_f['id']
+        ref_geom = ref_f.GetGeometryRef()
+        geom = f.GetGeometryRef()
+        if ref_geom is None:
+            assert geom is None
+        else:
+            assert geom.ExportToWkt() == ref_geom.ExportToWkt()
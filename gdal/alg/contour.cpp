@@ -34,11 +34,19 @@
 #include "utility.h"
 #include "contour_generator.h"
 #include "segment_merger.h"
+#include "stripe_merger.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "gdal.h"
 #include "gdal_alg.h"
+#include "gdal_alg_priv.h"
 #include "cpl_conv.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_srs_api.h"
 #include "ogr_geometry.h"
@@ -196,6 +204,273 @@ private:
     void *data_;
 };
 
+/************************************************************************/
+/* ==================================================================== */
+/*      Stripe based contour generation.                                */
+/*                                                                      */
+/*      The raster is cut in horizontal stripes, whose contours are     */
+/*      computed, possibly by several threads, with their own           */
+/*      SegmentMerger.  The lines reaching the boundary of a stripe     */
+/*      are then joined by a StripeMerger in the calling thread, which  */
+/*      also writes the features of a batch of stripes while the next   */
+/*      batch is computed.                                              */
+/* ==================================================================== */
+/************************************************************************/
+
+namespace {
+
+struct ContourStripeLine
+{
+    double level;
+    marching_squares::LineString ls;
+    bool closed;
+};
+
+// Line writer collecting the lines of a stripe.
+struct ContourStripeLines
+{
+    void addLine( double level, marching_squares::LineString& ls, bool closed )
+    {
+        lines.push_back( ContourStripeLine{ level, marching_squares::LineString(), closed } );
+        lines.back().ls.swap( ls );
+    }
+
+    std::vector<ContourStripeLine> lines{};
+};
+
+template <typename LevelGenerator>
+struct ContourStripe
+{
+    LevelGenerator* levels = nullptr;
+    int nXSize = 0;
+    int nYSize = 0;
+    bool hasNoData = false;
+    double noDataValue = 0.0;
+    bool polygonize = false;
+
+    int nYOff = 0;
+    int nLines = 0;
+    // Lines nYOff - 1 (if nYOff > 0) to nYOff + nLines - 1.
+    std::vector<double> adfData{};
+
+    ContourStripeLines output{};
+    std::string osError{};
+};
+
+}  // namespace
+
+/************************************************************************/
+/*                          ContourStripeJob()                          */
+/************************************************************************/
+
+template <typename LevelGenerator>
+static void ContourStripeJob( void* pData )
+{
+    using namespace marching_squares;
+
+    ContourStripe<LevelGenerator>* psStripe =
+        static_cast<ContourStripe<LevelGenerator>*>(pData);
+    try
+    {
+        SegmentMerger<ContourStripeLines, LevelGenerator> writer(
+            psStripe->output, *psStripe->levels, psStripe->polygonize );
+        ContourGenerator<decltype(writer), LevelGenerator> cg(
+            psStripe->nXSize, psStripe->nYSize,
+            psStripe->hasNoData, psStripe->noDataValue,
+            writer, *psStripe->levels );
+
+        const double* padfLine = psStripe->adfData.data();
+        if ( psStripe->nYOff > 0 )
+        {
+            cg.startAtLine( psStripe->nYOff, padfLine );
+            padfLine += psStripe->nXSize;
+        }
+        for ( int iLine = 0; iLine < psStripe->nLines; iLine++ )
+        {
+            cg.feedLine( padfLine );
+            padfLine += psStripe->nXSize;
+        }
+        writer.emitRemainingLines();
+    }
+    catch( const std::exception& e )
+    {
+        psStripe->osError = e.what();
+    }
+}
+
+/************************************************************************/
+/*                       ContourGenerateStripes()                       */
+/************************************************************************/
+
+template <typename LevelGenerator, typename LineWriter>
+static CPLErr ContourGenerateStripes( GDALRasterBandH hBand,
+                                      bool hasNoData, double noDataValue,
+                                      LevelGenerator& levels,
+                                      LineWriter& lineWriter, bool polygonize,
+                                      int nThreads,
+                                      GDALProgressFunc pfnProgress,
+                                      void* pProgressArg )
+{
+    const int nXSize = GDALGetRasterBandXSize( hBand );
+    const int nYSize = GDALGetRasterBandYSize( hBand );
+
+    // Declared before the job queue, that waits for the jobs on destruction.
+    std::vector<ContourStripe<LevelGenerator>> asStripes( nThreads );
+    std::vector<ContourStripe<LevelGenerator>> asPrevStripes( nThreads );
+
+    CPLWorkerThreadPool *poPool =
+        nThreads > 1 ? CPLGetGlobalWorkerThreadPool(nThreads) : nullptr;
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if( poPool )
+    {
+        nThreads = std::min(nThreads, poPool->GetThreadCount());
+        poJobQueue = poPool->CreateJobQueue(nThreads);
+    }
+    else
+    {
+        nThreads = 1;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Determine the stripe height, so that all threads have           */
+/*      something to do.                                                */
+/* -------------------------------------------------------------------- */
+    const int nStripeLines = GDALGetStripeLines(
+        nYSize, static_cast<GIntBig>(nXSize) * sizeof(double), nThreads );
+    const int nStripes = (nYSize + nStripeLines - 1) / nStripeLines;
+    CPLDebug( "CONTOUR", "Using %d stripes of %d lines, %d thread(s)",
+              nStripes, nStripeLines, nThreads );
+
+    marching_squares::StripeMerger<LineWriter> stripeMerger( lineWriter,
+                                                             polygonize );
+    int nPrevBatch = 0;
+    CPLErr eErr = CE_None;
+
+    // Join and write the lines of the previous batch of stripes.
+    const auto WritePrevBatch = [&]()
+    {
+        for( int i = 0; i < nPrevBatch; i++ )
+        {
+            ContourStripe<LevelGenerator>& sStripe = asPrevStripes[i];
+            const int nYEnd = sStripe.nYOff + sStripe.nLines;
+            stripeMerger.beginningOfStripe(
+                sStripe.nYOff > 0 ? sStripe.nYOff - .5 : marching_squares::NaN,
+                nYEnd < nYSize ? nYEnd - .5 : marching_squares::NaN );
+            for( auto& oLine: sStripe.output.lines )
+                stripeMerger.addLine( oLine.level, oLine.ls, oLine.closed );
+            stripeMerger.endOfStripe();
+            sStripe.output.lines.clear();
+
+            if( eErr == CE_None &&
+                !pfnProgress( static_cast<double>(nYEnd) / nYSize,
+                              "", pProgressArg ) )
+            {
+                CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+                eErr = CE_Failure;
+            }
+        }
+        nPrevBatch = 0;
+    };
+
+    for( int iStripe = 0; eErr == CE_None && iStripe < nStripes;
+         iStripe += nThreads )
+    {
+        const int nBatch = std::min(nThreads, nStripes - iStripe);
+
+/* -------------------------------------------------------------------- */
+/*      Read the stripes of this batch, with the line above them.       */
+/* -------------------------------------------------------------------- */
+        for( int i = 0; eErr == CE_None && i < nBatch; i++ )
+        {
+            ContourStripe<LevelGenerator>& sStripe = asStripes[i];
+            sStripe.levels = &levels;
+            sStripe.nXSize = nXSize;
+            sStripe.nYSize = nYSize;
+            sStripe.hasNoData = hasNoData;
+            sStripe.noDataValue = noDataValue;
+            sStripe.polygonize = polygonize;
+            sStripe.nYOff = (iStripe + i) * nStripeLines;
+            sStripe.nLines = std::min(nStripeLines, nYSize - sStripe.nYOff);
+            sStripe.osError.clear();
+
+            const int nYOffRead = std::max(0, sStripe.nYOff - 1);
+            const int nLinesRead = sStripe.nYOff + sStripe.nLines - nYOffRead;
+            sStripe.adfData.resize(
+                static_cast<size_t>(nXSize) * nLinesRead );
+            eErr = GDALRasterIO( hBand, GF_Read, 0, nYOffRead,
+                                 nXSize, nLinesRead,
+                                 sStripe.adfData.data(), nXSize, nLinesRead,
+                                 GDT_Float64, 0, 0 );
+        }
+        if( eErr != CE_None )
+            break;
+
+/* -------------------------------------------------------------------- */
+/*      Compute them, while writing the previous batch.                 */
+/* -------------------------------------------------------------------- */
+        if( poJobQueue )
+        {
+            std::vector<void *> apData;
+            for( int i = 0; i < nBatch; i++ )
+                apData.push_back( &asStripes[i] );
+            poJobQueue->SubmitJobs( ContourStripeJob<LevelGenerator>,
+                                    apData );
+            WritePrevBatch();
+            poJobQueue->WaitCompletion();
+        }
+        else
+        {
+            ContourStripeJob<LevelGenerator>( &asStripes[0] );
+            WritePrevBatch();
+        }
+
+        for( int i = 0; i < nBatch; i++ )
+        {
+            if( eErr == CE_None && !asStripes[i].osError.empty() )
+            {
+                CPLError( CE_Failure, CPLE_AppDefined, "%s",
+                          asStripes[i].osError.c_str() );
+                eErr = CE_Failure;
+            }
+            asStripes[i].adfData.clear();
+        }
+        std::swap( asStripes, asPrevStripes );
+        nPrevBatch = nBatch;
+    }
+    if( eErr == CE_None )
+        WritePrevBatch();
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                         ContourGenerateT()                           */
+/************************************************************************/
+
+template <typename LevelGenerator, typename LineWriter>
+static CPLErr ContourGenerateT( GDALRasterBandH hBand,
+                                bool hasNoData, double noDataValue,
+                                LevelGenerator& levels,
+                                LineWriter& lineWriter, bool polygonize,
+                                int nThreads,
+                                GDALProgressFunc pfnProgress,
+                                void* pProgressArg )
+{
+    using namespace marching_squares;
+
+    if( nThreads > 0 )
+        return ContourGenerateStripes( hBand, hasNoData, noDataValue,
+                                       levels, lineWriter, polygonize,
+                                       nThreads, pfnProgress, pProgressArg );
+
+    SegmentMerger<LineWriter, LevelGenerator> writer( lineWriter, levels,
+                                                      polygonize );
+    ContourGeneratorFromRaster<decltype(writer), LevelGenerator> cg(
+        hBand, hasNoData, noDataValue, writer, levels );
+    cg.process( pfnProgress, pProgressArg );
+    return CE_None;
+}
+
 /************************************************************************/
 /* ==================================================================== */
 /*                   Additional C Callable Functions                    */
@@ -517,6 +792,17 @@ an averaged value from the two nearby points (in this case (12+3+5)/3).
  *
  * If YES, contour polygons will be created, rather than polygon lines.
  *
+ *   NUM_THREADS=d|ALL_CPUS
+ *
+ * (GDAL >= 3.1) Number of threads. When this option is set, even to 1, the
+ * raster is processed by horizontal stripes, whose total height is
+ * determined by the GDAL_SWATH_SIZE configuration option (defaulting to a
+ * quarter of the block cache size), contoured in parallel and joined
+ * together. The features of a batch of stripes are written to the layer by
+ * the calling thread while the next batch is computed. The contours are the
+ * same, but the order of the features, and the starting point of closed
+ * lines, differ.
+ *
  *
  * @return CE_None on success or CE_Failure if an error occurs.
  */
@@ -592,6 +878,14 @@ CPLErr GDALContourGenerateEx( GDALRasterBandH hBand, void *hLayer,
 
     bool polygonize = CPLFetchBool( options, "POLYGONIZE", false );
 
+    // GDAL_NUM_THREADS is not taken into account, as the order of the
+    // features would then depend on the environment.
+    int nThreads = 0;
+    opt = CSLFetchNameValue( options, "NUM_THREADS" );
+    if ( opt ) {
+        nThreads = CPLGetNumThreads( opt );
+    }
+
     using namespace marching_squares;
 
     OGRContourWriterInfo oCWI;
@@ -611,6 +905,7 @@ CPLErr GDALContourGenerateEx( GDALRasterBandH hBand, void *hLayer,
         GDALGetGeoTransform( hSrcDS, oCWI.adfGeoTransform );
     oCWI.nNextID = 0;
 
+    CPLErr eErr = CE_None;
     try
     {
         if ( polygonize )
@@ -621,21 +916,18 @@ CPLErr GDALContourGenerateEx( GDALRasterBandH hBand, void *hLayer,
             RingAppender appender( w );
             if ( ! fixedLevels.empty() ) {
                 FixedLevelRangeIterator levels( &fixedLevels[0], fixedLevels.size(), GDALGetRasterMaximum( hBand, &bSuccess ) );
-                SegmentMerger<RingAppender, FixedLevelRangeIterator> writer(appender, levels, /* polygonize */ true);
-                ContourGeneratorFromRaster<decltype(writer), FixedLevelRangeIterator> cg( hBand, useNoData, noDataValue, writer, levels );
-                cg.process( pfnProgress, pProgressArg );
+                eErr = ContourGenerateT( hBand, useNoData, noDataValue, levels, appender,
+                                         /* polygonize */ true, nThreads, pfnProgress, pProgressArg );
             }
             else if ( expBase > 0.0 ) {
                 ExponentialLevelRangeIterator levels( expBase );
-                SegmentMerger<RingAppender, ExponentialLevelRangeIterator> writer(appender, levels, /* polygonize */ true);
-                ContourGeneratorFromRaster<decltype(writer), ExponentialLevelRangeIterator> cg( hBand, useNoData, noDataValue, writer, levels );
-                cg.process( pfnProgress, pProgressArg );
+                eErr = ContourGenerateT( hBand, useNoData, noDataValue, levels, appender,
+                                         /* polygonize */ true, nThreads, pfnProgress, pProgressArg );
             }
             else {
                 IntervalLevelRangeIterator levels( contourBase, contourInterval );
-                SegmentMerger<RingAppender, IntervalLevelRangeIterator> writer(appender, levels, /* polygonize */ true);
-                ContourGeneratorFromRaster<decltype(writer), IntervalLevelRangeIterator> cg( hBand, useNoData, noDataValue, writer, levels );
-                cg.process( pfnProgress, pProgressArg );
+                eErr = ContourGenerateT( hBand, useNoData, noDataValue, levels, appender,
+                                         /* polygonize */ true, nThreads, pfnProgress, pProgressArg );
             }
         }
         else
@@ -643,21 +935,18 @@ CPLErr GDALContourGenerateEx( GDALRasterBandH hBand, void *hLayer,
             GDALRingAppender appender(OGRContourWriter, &oCWI);
             if ( ! fixedLevels.empty() ) {
                 FixedLevelRangeIterator levels( &fixedLevels[0], fixedLevels.size() );
-                SegmentMerger<GDALRingAppender, FixedLevelRangeIterator> writer(appender, levels, /* polygonize */ false);
-                ContourGeneratorFromRaster<decltype(writer), FixedLevelRangeIterator> cg( hBand, useNoData, noDataValue, writer, levels );
-                cg.process( pfnProgress, pProgressArg );
+                eErr = ContourGenerateT( hBand, useNoData, noDataValue, levels, appender,
+                                         /* polygonize */ false, nThreads, pfnProgress, pProgressArg );
             }
             else if ( expBase > 0.0 ) {
                 ExponentialLevelRangeIterator levels( expBase );
-                SegmentMerger<GDALRingAppender, ExponentialLevelRangeIterator> writer(appender, levels, /* polygonize */ false);
-                ContourGeneratorFromRaster<decltype(writer), ExponentialLevelRangeIterator> cg( hBand, useNoData, noDataValue, writer, levels );
-                cg.process( pfnProgress, pProgressArg );
+                eErr = ContourGenerateT( hBand, useNoData, noDataValue, levels, appender,
+                                         /* polygonize */ false, nThreads, pfnProgress, pProgressArg );
             }
             else {
                 IntervalLevelRangeIterator levels( contourBase, contourInterval );
-                SegmentMerger<GDALRingAppender, IntervalLevelRangeIterator> writer(appender, levels, /* polygonize */ false);
-                ContourGeneratorFromRaster<decltype(writer), IntervalLevelRangeIterator> cg( hBand, useNoData, noDataValue, writer, levels );
-                cg.process( pfnProgress, pProgressArg );
+                eErr = ContourGenerateT( hBand, useNoData, noDataValue, levels, appender,
+                                         /* polygonize */ false, nThreads, pfnProgress, pProgressArg );
             }
         }
     }
@@ -666,7 +955,7 @@ CPLErr GDALContourGenerateEx( GDALRasterBandH hBand, void *hLayer,
         CPLError(CE_Failure, CPLE_AppDefined, "%s", e.what());
         return CE_Failure;
     }
-    return CE_None;
+    return eErr;
 }
 
 /************************************************************************/
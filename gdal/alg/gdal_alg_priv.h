@@ -242,6 +242,21 @@ bool GDALComputeAreaOfInterest(OGRSpatialReference* poSRS,
                                double& dfNorthLatitudeDeg );
 
 
+/************************************************************************/
+/*      Processing of rasters by stripes (gdalstripes.cpp).             */
+/************************************************************************/
+
+class CPLJobQueue;
+
+int GDALGetStripeLines( int nYSize, GIntBig nBytesPerLine,
+                        int nStripesAtOnce );
+
+typedef void (*GDALRangeJobFunc)( void *pUserData, int nStart, int nEnd );
+
+void GDALRunRangeJobs( CPLJobQueue *poJobQueue, int nMaxJobs,
+                       int nCount, int nMinPerJob,
+                       GDALRangeJobFunc pfnFunc, void *pUserData );
+
 #endif /* #ifndef DOXYGEN_SKIP */
 
 #endif /* ndef GDAL_ALG_PRIV_H_INCLUDED */
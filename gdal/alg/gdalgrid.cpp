@@ -31,6 +31,7 @@
 #include "gdalgrid.h"
 #include "gdalgrid_priv.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <climits>
 #include <cmath>
@@ -1683,7 +1684,9 @@ struct GDALGridContext
     double*             padfZ;
     bool                bFreePadfXYZArrays;
 
+    // Shared pool, not owned.
     CPLWorkerThreadPool *poWorkerThreadPool;
+    int                 nThreads;
 };
 
 static void GDALGridContextCreateQuadTree( GDALGridContext* psContext );
@@ -2049,21 +2052,23 @@ GDALGridContextCreate( GDALGridAlgorithm eAlgorithm, const void *poOptions,
         nThreads = atoi(pszThreads);
     if( nThreads > 128 )
         nThreads = 128;
+    psContext->poWorkerThreadPool = nullptr;
     if( nThreads > 1 )
     {
-        psContext->poWorkerThreadPool = new CPLWorkerThreadPool();
-        if( !psContext->poWorkerThreadPool->Setup(nThreads, nullptr, nullptr) )
+        psContext->poWorkerThreadPool = CPLGetGlobalWorkerThreadPool(nThreads);
+        if( psContext->poWorkerThreadPool )
+            nThreads = std::min(nThreads,
+                            psContext->poWorkerThreadPool->GetThreadCount());
+        if( nThreads > 1 )
         {
-            delete psContext->poWorkerThreadPool;
-            psContext->poWorkerThreadPool = nullptr;
+            psContext->nThreads = nThreads;
+            CPLDebug("GDAL_GRID", "Using %d threads", nThreads);
         }
         else
         {
-            CPLDebug("GDAL_GRID", "Using %d threads", nThreads);
+            psContext->poWorkerThreadPool = nullptr;
         }
     }
-    else
-        psContext->poWorkerThreadPool = nullptr;
 
     return psContext;
 }
@@ -2145,7 +2150,6 @@ void GDALGridContextFree( GDALGridContext* psContext )
         VSIFreeAligned(psContext->sExtraParameters.pafZ);
         if( psContext->sExtraParameters.psTriangulation )
             GDALTriangulationFree(psContext->sExtraParameters.psTriangulation);
-        delete psContext->poWorkerThreadPool;
         CPLFree(psContext);
     }
 }
@@ -2305,7 +2309,9 @@ CPLErr GDALGridContextProcess(
     }
     else
     {
-        int nThreads  = psContext->poWorkerThreadPool->GetThreadCount();
+        const int nThreads = psContext->nThreads;
+        auto poJobQueue =
+            psContext->poWorkerThreadPool->CreateJobQueue(nThreads);
         GDALGridJob* pasJobs = static_cast<GDALGridJob *>(
             CPLMalloc(sizeof(GDALGridJob) * nThreads) );
 
@@ -2321,8 +2327,7 @@ CPLErr GDALGridContextProcess(
         {
             memcpy(&pasJobs[i], &sJob, sizeof(GDALGridJob));
             pasJobs[i].nYStart = i;
-            psContext->poWorkerThreadPool->SubmitJob( GDALGridJobProcess,
-                                                      &pasJobs[i] );
+            poJobQueue->SubmitJob( GDALGridJobProcess, &pasJobs[i] );
         }
 
 /* -------------------------------------------------------------------- */
@@ -2353,7 +2358,7 @@ CPLErr GDALGridContextProcess(
 /* -------------------------------------------------------------------- */
 /*      Wait for all threads to complete and finish.                    */
 /* -------------------------------------------------------------------- */
-        psContext->poWorkerThreadPool->WaitCompletion();
+        poJobQueue->WaitCompletion();
 
         CPLFree(pasJobs);
         CPLDestroyCond(sJob.hCond);
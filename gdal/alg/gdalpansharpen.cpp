@@ -176,7 +176,6 @@ GDALPansharpenOperation::~GDALPansharpenOperation()
     GDALDestroyPansharpenOptions(psOptions);
     for( size_t i = 0; i < aVDS.size(); i++ )
         delete aVDS[i];
-    delete poThreadPool;
 }
 
 /************************************************************************/
@@ -362,7 +361,7 @@ GDALPansharpenOperation::Initialize( const GDALPansharpenOptions* psOptionsIn )
     }
 
     // Setup thread pool.
-    int nThreads = psOptions->nThreads;
+    nThreads = psOptions->nThreads;
     if( nThreads == -1 )
         nThreads = CPLGetNumCPUs();
     else if( nThreads == 0 )
@@ -379,14 +378,14 @@ GDALPansharpenOperation::Initialize( const GDALPansharpenOptions* psOptionsIn )
     }
     if( nThreads > 1 )
     {
-        CPLDebug("PANSHARPEN", "Using %d threads", nThreads);
-        poThreadPool = new (std::nothrow) CPLWorkerThreadPool();
         // coverity[tainted_data]
-        if( poThreadPool == nullptr ||
-            !poThreadPool->Setup( nThreads, nullptr, nullptr ) )
+        CPLWorkerThreadPool* poThreadPool =
+            CPLGetGlobalWorkerThreadPool(nThreads);
+        if( poThreadPool )
         {
-            delete poThreadPool;
-            poThreadPool = nullptr;
+            nThreads = std::min(nThreads, poThreadPool->GetThreadCount());
+            CPLDebug("PANSHARPEN", "Using %d threads", nThreads);
+            poJobQueue = poThreadPool->CreateJobQueue(nThreads);
         }
     }
 
@@ -1083,9 +1082,9 @@ CPLErr GDALPansharpenOperation::ProcessRegion( int nXOff, int nYOff,
     }
 
     int nTasks = 0;
-    if( poThreadPool )
+    if( poJobQueue )
     {
-        nTasks = poThreadPool->GetThreadCount();
+        nTasks = nThreads;
         if( nTasks > nYSize )
             nTasks = nYSize;
     }
@@ -1335,9 +1334,9 @@ CPLErr GDALPansharpenOperation::ProcessRegion( int nXOff, int nYOff,
 #ifdef DEBUG_TIMING
                 gettimeofday(&tv, nullptr);
 #endif
-                poThreadPool->SubmitJobs(PansharpenResampleJobThreadFunc,
-                                         ahJobData);
-                poThreadPool->WaitCompletion();
+                poJobQueue->SubmitJobs(PansharpenResampleJobThreadFunc,
+                                       ahJobData);
+                poJobQueue->WaitCompletion();
             }
         }
 
@@ -1493,8 +1492,8 @@ CPLErr GDALPansharpenOperation::ProcessRegion( int nXOff, int nYOff,
 #ifdef DEBUG_TIMING
             gettimeofday(&tv, nullptr);
 #endif
-            poThreadPool->SubmitJobs(PansharpenJobThreadFunc, ahJobData);
-            poThreadPool->WaitCompletion();
+            poJobQueue->SubmitJobs(PansharpenJobThreadFunc, ahJobData);
+            poJobQueue->WaitCompletion();
         }
 
         eErr = CE_None;
@@ -194,7 +194,8 @@ class GDALPansharpenOperation
         std::vector<GDALDataset*> aVDS{}; // to destroy
         std::vector<GDALRasterBand*> aMSBands{}; // original multispectral bands potentially warped into a VRT
         int bPositiveWeights = TRUE;
-        CPLWorkerThreadPool* poThreadPool = nullptr;
+        std::unique_ptr<CPLJobQueue> poJobQueue{};
+        int nThreads = 0;
         int nKernelRadius = 0;
 
         static void PansharpenJobThreadFunc(void* pUserData);
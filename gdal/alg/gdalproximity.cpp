@@ -29,17 +29,23 @@
 
 #include "cpl_port.h"
 #include "gdal_alg.h"
+#include "gdal_alg_priv.h"
 
 #include <cmath>
 #include <cstdlib>
 
 #include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 
 CPL_CVSID("$Id$")
@@ -50,6 +56,60 @@ ProcessProximityLine( GInt32 *panSrcScanline, int *panNearX, int *panNearY,
                       float *pafProximity, double *pdfSrcNoDataValue,
                       int nTargetValues, int *panTargetValues );
 
+static CPLErr
+ComputeProximityExact( GDALRasterBandH hSrcBand,
+                       GDALRasterBandH hProximityBand,
+                       double dfMaxDist, double dfDistMult,
+                       const double *pdfSrcNoDataValue, float fNoDataValue,
+                       bool bFixedBufVal, double dfFixedBufVal,
+                       int nTargetValues, const int *panTargetValues,
+                       int nThreads,
+                       GDALProgressFunc pfnProgress, void *pProgressArg );
+
+/************************************************************************/
+/*                       CreateWorkProximityDS()                        */
+/************************************************************************/
+
+// Creates a temporary Float32 dataset, used to store intermediate values
+// when the proximity band cannot hold them.
+static GDALDatasetH CreateWorkProximityDS( int nXSize, int nYSize,
+                                           bool &bTempFileAlreadyDeleted )
+{
+    GDALDriverH hDriver = GDALGetDriverByName("GTiff");
+    if( hDriver == nullptr )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "GDALComputeProximity needs GTiff driver" );
+        return nullptr;
+    }
+    CPLString osTmpFile = CPLGenerateTempFilename( "proximity" );
+    GDALDatasetH hWorkProximityDS =
+        GDALCreate( hDriver, osTmpFile,
+                    nXSize, nYSize, 1, GDT_Float32, nullptr );
+    if( hWorkProximityDS == nullptr )
+        return nullptr;
+    // On Unix, attempt at deleting the temporary file now, so that
+    // if the process gets interrupted, it is automatically destroyed
+    // by the operating system.
+    bTempFileAlreadyDeleted = VSIUnlink( osTmpFile ) == 0;
+    return hWorkProximityDS;
+}
+
+/************************************************************************/
+/*                       DestroyWorkProximityDS()                       */
+/************************************************************************/
+
+static void DestroyWorkProximityDS( GDALDatasetH hWorkProximityDS,
+                                    bool bTempFileAlreadyDeleted )
+{
+    CPLString osProxFile = GDALGetDescription( hWorkProximityDS );
+    GDALClose( hWorkProximityDS );
+    if( !bTempFileAlreadyDeleted )
+    {
+        GDALDeleteDataset( GDALGetDriverByName( "GTiff" ), osProxFile );
+    }
+}
+
 /************************************************************************/
 /*                        GDALComputeProximity()                        */
 /************************************************************************/
@@ -106,6 +166,22 @@ the proximity output.
 
 If this option is set, all pixels within the MAXDIST threadhold are
 set to this fixed value instead of to a proximity distance.
+
+  ALGORITHM=[SWEEP]/EXACT
+
+(GDAL >= 3.1) The default SWEEP algorithm propagates the nearest target
+along two line sweeps, which is fast but may slightly overestimate some
+distances. EXACT computes the exact Euclidean distance transform, with a
+separable algorithm (A. Meijster, J.B.T.M. Roerdink and W.H. Hesselink,
+2000). The raster is processed by stripes of lines, so that memory usage
+does not depend on the raster height (GDAL_SWATH_SIZE configuration option,
+defaulting to a quarter of the block cache size), and stripes without
+any target within MAXDIST are skipped.
+
+  NUM_THREADS=n/ALL_CPUS
+
+(GDAL >= 3.1) Number of threads used by the EXACT algorithm. Defaults to
+the value of the GDAL_NUM_THREADS configuration option, or 1.
 */
 
 CPLErr CPL_STDCALL
@@ -243,6 +319,26 @@ GDALComputeProximity( GDALRasterBandH hSrcBand,
         CSLDestroy( papszValuesTokens );
     }
 
+/* -------------------------------------------------------------------- */
+/*      Which algorithm?                                                */
+/* -------------------------------------------------------------------- */
+    bool bExact = false;
+    pszOpt = CSLFetchNameValue( papszOptions, "ALGORITHM" );
+    if( pszOpt )
+    {
+        if( EQUAL(pszOpt, "EXACT") )
+            bExact = true;
+        else if( !EQUAL(pszOpt, "SWEEP") )
+        {
+            CPLError(
+                CE_Failure, CPLE_AppDefined,
+                "Unrecognized ALGORITHM value '%s', should be SWEEP or EXACT.",
+                pszOpt );
+            CPLFree(panTargetValues);
+            return CE_Failure;
+        }
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Initialize progress counter.                                    */
 /* -------------------------------------------------------------------- */
@@ -253,6 +349,20 @@ GDALComputeProximity( GDALRasterBandH hSrcBand,
         return CE_Failure;
     }
 
+    if( bExact )
+    {
+        const int nThreads = CPLGetNumThreads(
+            CSLFetchNameValue( papszOptions, "NUM_THREADS" ) );
+
+        const CPLErr eErr = ComputeProximityExact(
+            hSrcBand, hProximityBand, dfMaxDist, dfDistMult,
+            pdfSrcNoData, fNoDataValue, bFixedBufVal, dfFixedBufVal,
+            nTargetValues, panTargetValues, nThreads,
+            pfnProgress, pProgressArg );
+        CPLFree(panTargetValues);
+        return eErr;
+    }
+
 /* -------------------------------------------------------------------- */
 /*      We need a signed type for the working proximity values kept     */
 /*      on disk.  If our proximity band is not signed, then create a    */
@@ -274,27 +384,13 @@ GDALComputeProximity( GDALRasterBandH hSrcBand,
         || eProxType == GDT_UInt16
         || eProxType == GDT_UInt32 )
     {
-        GDALDriverH hDriver = GDALGetDriverByName("GTiff");
-        if( hDriver == nullptr )
-        {
-            CPLError( CE_Failure, CPLE_AppDefined,
-                      "GDALComputeProximity needs GTiff driver" );
-            eErr = CE_Failure;
-            goto end;
-        }
-        CPLString osTmpFile = CPLGenerateTempFilename( "proximity" );
         hWorkProximityDS =
-            GDALCreate( hDriver, osTmpFile,
-                        nXSize, nYSize, 1, GDT_Float32, nullptr );
+            CreateWorkProximityDS( nXSize, nYSize, bTempFileAlreadyDeleted );
         if( hWorkProximityDS == nullptr )
         {
             eErr = CE_Failure;
             goto end;
         }
-        // On Unix, attempt at deleting the temporary file now, so that
-        // if the process gets interrupted, it is automatically destroyed
-        // by the operating system.
-        bTempFileAlreadyDeleted = VSIUnlink( osTmpFile ) == 0;
         hWorkProximityBand = GDALGetRasterBand( hWorkProximityDS, 1 );
     }
 
@@ -446,14 +542,7 @@ end:
     CPLFree( panTargetValues );
 
     if( hWorkProximityDS != nullptr )
-    {
-        CPLString osProxFile = GDALGetDescription( hWorkProximityDS );
-        GDALClose( hWorkProximityDS );
-        if( !bTempFileAlreadyDeleted )
-        {
-            GDALDeleteDataset( GDALGetDriverByName( "GTiff" ), osProxFile );
-        }
-    }
+        DestroyWorkProximityDS( hWorkProximityDS, bTempFileAlreadyDeleted );
 
     return eErr;
 }
@@ -592,3 +681,416 @@ ProcessProximityLine( GInt32 *panSrcScanline, int *panNearX, int *panNearY,
 
     return CE_None;
 }
+
+/************************************************************************/
+/*                       ComputeProximityExact()                        */
+/************************************************************************/
+
+// The exact Euclidean distance transform is separable. The first phase
+// computes, for each pixel, the distance to the nearest target pixel in the
+// same column, with a top-down and a bottom-up sweep. The second phase
+// computes, for each line, the lower envelope of the parabolas
+// (x - x')^2 + g(x')^2, where g is the result of the first phase.
+//
+// The raster is processed by stripes of lines. The top-down sweep stores
+// its results in the working band. The bottom-up sweep completes them, and
+// as each line then only depends on its own column distances, the second
+// phase is done on the fly for the lines of the stripe. Columns are
+// independent in the first phase, and lines in the second one, so both are
+// split in ranges processed by worker threads.
+
+namespace {
+
+struct GDALProximityExactContext
+{
+    int nXSize = 0;
+    // Column distances greater than that cannot give a distance within
+    // MAXDIST, and are stored as -1, like when there is no target.
+    int nMaxColumnDist = 0;
+    double dfMaxDistSq = 0;
+    double dfDistMult = 1;
+    const double *pdfSrcNoDataValue = nullptr;
+    float fNoDataValue = 0;
+    bool bFixedBufVal = false;
+    double dfFixedBufVal = 0;
+    int nTargetValues = 0;
+    const int *panTargetValues = nullptr;
+
+    // Current stripe.
+    int nStripeYOff = 0;
+    int nStripeLines = 0;
+    const GInt32 *panSrc = nullptr;
+    float *pafDist = nullptr;
+
+    // For each column, line of the last target met by the current sweep,
+    // or -1.
+    std::vector<int> anNearestLine{};
+
+    // Set by the bottom-up sweep if a column distance was found.
+    std::atomic<bool> bHasColumnDist{false};
+
+    bool IsTarget( GInt32 nValue ) const
+    {
+        if( nTargetValues == 0 )
+            return nValue != 0;
+        for( int i = 0; i < nTargetValues; i++ )
+        {
+            if( nValue == panTargetValues[i] )
+                return true;
+        }
+        return false;
+    }
+};
+
+} // namespace
+
+/************************************************************************/
+/*                    ProximityExactTopDownColumns()                    */
+/************************************************************************/
+
+static void ProximityExactTopDownColumns( void *pData, int nStart, int nEnd )
+{
+    GDALProximityExactContext *psCtxt =
+        static_cast<GDALProximityExactContext *>(pData);
+    int *panNearestLine = psCtxt->anNearestLine.data();
+
+    for( int iLine = 0; iLine < psCtxt->nStripeLines; iLine++ )
+    {
+        const int nY = psCtxt->nStripeYOff + iLine;
+        const size_t nOffset = static_cast<size_t>(iLine) * psCtxt->nXSize;
+        const GInt32 *panSrc = psCtxt->panSrc + nOffset;
+        float *pafDist = psCtxt->pafDist + nOffset;
+        for( int iX = nStart; iX < nEnd; iX++ )
+        {
+            if( psCtxt->IsTarget(panSrc[iX]) )
+                panNearestLine[iX] = nY;
+            const int nNearestLine = panNearestLine[iX];
+            pafDist[iX] =
+                nNearestLine >= 0 &&
+                nY - nNearestLine <= psCtxt->nMaxColumnDist ?
+                    static_cast<float>(nY - nNearestLine) : -1.0f;
+        }
+    }
+}
+
+/************************************************************************/
+/*                    ProximityExactBottomUpColumns()                   */
+/************************************************************************/
+
+static void ProximityExactBottomUpColumns( void *pData, int nStart, int nEnd )
+{
+    GDALProximityExactContext *psCtxt =
+        static_cast<GDALProximityExactContext *>(pData);
+    int *panNearestLine = psCtxt->anNearestLine.data();
+    bool bHasColumnDist = false;
+
+    for( int iLine = psCtxt->nStripeLines - 1; iLine >= 0; iLine-- )
+    {
+        const int nY = psCtxt->nStripeYOff + iLine;
+        const size_t nOffset = static_cast<size_t>(iLine) * psCtxt->nXSize;
+        const GInt32 *panSrc = psCtxt->panSrc + nOffset;
+        float *pafDist = psCtxt->pafDist + nOffset;
+        for( int iX = nStart; iX < nEnd; iX++ )
+        {
+            if( psCtxt->IsTarget(panSrc[iX]) )
+                panNearestLine[iX] = nY;
+            const int nNearestLine = panNearestLine[iX];
+            if( nNearestLine >= 0 &&
+                nNearestLine - nY <= psCtxt->nMaxColumnDist )
+            {
+                const float fDist = static_cast<float>(nNearestLine - nY);
+                if( pafDist[iX] < 0 || fDist < pafDist[iX] )
+                    pafDist[iX] = fDist;
+            }
+            if( pafDist[iX] >= 0 )
+                bHasColumnDist = true;
+        }
+    }
+    if( bHasColumnDist )
+        psCtxt->bHasColumnDist = true;
+}
+
+/************************************************************************/
+/*                       ProximityExactLines()                          */
+/************************************************************************/
+
+static void ProximityExactLines( void *pData, int nStart, int nEnd )
+{
+    GDALProximityExactContext *psCtxt =
+        static_cast<GDALProximityExactContext *>(pData);
+    const int nXSize = psCtxt->nXSize;
+
+    // Abscissas of the parabolas of the lower envelope, and abscissas of
+    // the boundaries between them.
+    std::vector<int> anSites(nXSize);
+    std::vector<double> adfBoundaries(nXSize + 1);
+    // Squared column distances of the line, or -1.
+    std::vector<double> adfColumnDistSq(nXSize);
+
+    for( int iLine = nStart; iLine < nEnd; iLine++ )
+    {
+        const size_t nOffset = static_cast<size_t>(iLine) * nXSize;
+        const GInt32 *panSrc = psCtxt->panSrc + nOffset;
+        float *pafDist = psCtxt->pafDist + nOffset;
+
+/* -------------------------------------------------------------------- */
+/*      Compute the lower envelope.                                     */
+/* -------------------------------------------------------------------- */
+        int k = -1;
+        for( int iX = 0; iX < nXSize; iX++ )
+        {
+            if( pafDist[iX] < 0 )
+            {
+                adfColumnDistSq[iX] = -1;
+                continue;
+            }
+            const double dfG = pafDist[iX];
+            adfColumnDistSq[iX] = dfG * dfG;
+
+            double dfBoundary = -std::numeric_limits<double>::infinity();
+            while( k >= 0 )
+            {
+                const int iSite = anSites[k];
+                // Abscissa of the intersection of the parabolas of iSite
+                // and iX.
+                dfBoundary =
+                    ((adfColumnDistSq[iX] + static_cast<double>(iX) * iX) -
+                     (adfColumnDistSq[iSite] +
+                      static_cast<double>(iSite) * iSite)) /
+                    (2.0 * (iX - iSite));
+                if( dfBoundary > adfBoundaries[k] )
+                    break;
+                k--;
+                dfBoundary = -std::numeric_limits<double>::infinity();
+            }
+            k++;
+            anSites[k] = iX;
+            adfBoundaries[k] = dfBoundary;
+        }
+
+/* -------------------------------------------------------------------- */
+/*      Compute the distances, and final post processing.               */
+/* -------------------------------------------------------------------- */
+        const int nSites = k + 1;
+        k = 0;
+        for( int iX = 0; iX < nXSize; iX++ )
+        {
+            const bool bTarget = adfColumnDistSq[iX] == 0;
+            if( nSites == 0 ||
+                (!bTarget && psCtxt->pdfSrcNoDataValue != nullptr &&
+                 panSrc[iX] == *(psCtxt->pdfSrcNoDataValue)) )
+            {
+                pafDist[iX] = psCtxt->fNoDataValue;
+                continue;
+            }
+            while( k + 1 < nSites && adfBoundaries[k + 1] < iX )
+                k++;
+            const int iSite = anSites[k];
+            const double dfDX = static_cast<double>(iX - iSite);
+            const double dfDistSq = dfDX * dfDX + adfColumnDistSq[iSite];
+            if( dfDistSq > psCtxt->dfMaxDistSq )
+                pafDist[iX] = psCtxt->fNoDataValue;
+            else if( dfDistSq == 0 )
+                pafDist[iX] = 0.0f;
+            else if( psCtxt->bFixedBufVal )
+                pafDist[iX] = static_cast<float>(psCtxt->dfFixedBufVal);
+            else
+                pafDist[iX] =
+                    static_cast<float>(sqrt(dfDistSq) * psCtxt->dfDistMult);
+        }
+    }
+}
+
+/************************************************************************/
+/*                       ComputeProximityExact()                        */
+/************************************************************************/
+
+static CPLErr
+ComputeProximityExact( GDALRasterBandH hSrcBand,
+                       GDALRasterBandH hProximityBand,
+                       double dfMaxDist, double dfDistMult,
+                       const double *pdfSrcNoDataValue, float fNoDataValue,
+                       bool bFixedBufVal, double dfFixedBufVal,
+                       int nTargetValues, const int *panTargetValues,
+                       int nThreads,
+                       GDALProgressFunc pfnProgress, void *pProgressArg )
+{
+    const int nXSize = GDALGetRasterBandXSize( hSrcBand );
+    const int nYSize = GDALGetRasterBandYSize( hSrcBand );
+
+    GDALProximityExactContext sCtxt;
+    sCtxt.nXSize = nXSize;
+    sCtxt.nMaxColumnDist = static_cast<int>(
+        std::min(std::floor(dfMaxDist), static_cast<double>(nYSize)));
+    sCtxt.dfMaxDistSq = dfMaxDist * dfMaxDist;
+    sCtxt.dfDistMult = dfDistMult;
+    sCtxt.pdfSrcNoDataValue = pdfSrcNoDataValue;
+    sCtxt.fNoDataValue = fNoDataValue;
+    sCtxt.bFixedBufVal = bFixedBufVal;
+    sCtxt.dfFixedBufVal = dfFixedBufVal;
+    sCtxt.nTargetValues = nTargetValues;
+    sCtxt.panTargetValues = panTargetValues;
+
+/* -------------------------------------------------------------------- */
+/*      The column distances need a band able to hold them.             */
+/* -------------------------------------------------------------------- */
+    GDALRasterBandH hWorkProximityBand = hProximityBand;
+    GDALDatasetH hWorkProximityDS = nullptr;
+    bool bTempFileAlreadyDeleted = false;
+    const GDALDataType eProxType = GDALGetRasterDataType(hProximityBand);
+    if( eProxType != GDT_Int32 && eProxType != GDT_Float32 &&
+        eProxType != GDT_Float64 )
+    {
+        hWorkProximityDS =
+            CreateWorkProximityDS( nXSize, nYSize, bTempFileAlreadyDeleted );
+        if( hWorkProximityDS == nullptr )
+            return CE_Failure;
+        hWorkProximityBand = GDALGetRasterBand( hWorkProximityDS, 1 );
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Determine the stripe height.                                    */
+/* -------------------------------------------------------------------- */
+    const int nStripeLines = GDALGetStripeLines(
+        nYSize,
+        static_cast<GIntBig>(nXSize) * (sizeof(float) + sizeof(GInt32)), 1 );
+    const int nStripes = (nYSize + nStripeLines - 1) / nStripeLines;
+    CPLDebug("GDAL", "Exact proximity: %d stripe(s) of %d line(s)",
+             nStripes, nStripeLines);
+
+    std::vector<GInt32> anSrc;
+    std::vector<float> afDist;
+    try
+    {
+        anSrc.resize(static_cast<size_t>(nStripeLines) * nXSize);
+        afDist.resize(static_cast<size_t>(nStripeLines) * nXSize);
+        sCtxt.anNearestLine.resize(nXSize);
+    }
+    catch( const std::bad_alloc & )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate proximity buffers");
+        if( hWorkProximityDS != nullptr )
+            DestroyWorkProximityDS( hWorkProximityDS, bTempFileAlreadyDeleted );
+        return CE_Failure;
+    }
+    sCtxt.panSrc = anSrc.data();
+    sCtxt.pafDist = afDist.data();
+
+    CPLWorkerThreadPool *poPool =
+        nThreads > 1 ? CPLGetGlobalWorkerThreadPool(nThreads) : nullptr;
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if( poPool )
+    {
+        nThreads = std::min(nThreads, poPool->GetThreadCount());
+        poJobQueue = poPool->CreateJobQueue(nThreads);
+    }
+    // Columns handled by a job of the column sweeps.
+    constexpr int MIN_COLUMNS_PER_JOB = 256;
+
+    CPLErr eErr = CE_None;
+
+/* -------------------------------------------------------------------- */
+/*      Top-down sweep: store the distances to the nearest target       */
+/*      above in the working band.                                      */
+/* -------------------------------------------------------------------- */
+    std::fill(sCtxt.anNearestLine.begin(), sCtxt.anNearestLine.end(), -1);
+    for( int iStripe = 0; eErr == CE_None && iStripe < nStripes; iStripe++ )
+    {
+        sCtxt.nStripeYOff = iStripe * nStripeLines;
+        sCtxt.nStripeLines = std::min(nStripeLines,
+                                      nYSize - sCtxt.nStripeYOff);
+
+        eErr = GDALRasterIO( hSrcBand, GF_Read, 0, sCtxt.nStripeYOff,
+                             nXSize, sCtxt.nStripeLines,
+                             anSrc.data(), nXSize, sCtxt.nStripeLines,
+                             GDT_Int32, 0, 0 );
+        if( eErr != CE_None )
+            break;
+
+        GDALRunRangeJobs( poJobQueue.get(), nThreads, nXSize,
+                          MIN_COLUMNS_PER_JOB, ProximityExactTopDownColumns,
+                          &sCtxt );
+
+        eErr = GDALRasterIO( hWorkProximityBand, GF_Write,
+                             0, sCtxt.nStripeYOff,
+                             nXSize, sCtxt.nStripeLines,
+                             afDist.data(), nXSize, sCtxt.nStripeLines,
+                             GDT_Float32, 0, 0 );
+        if( eErr != CE_None )
+            break;
+
+        if( !pfnProgress( 0.5 * (iStripe + 1) / nStripes,
+                          "", pProgressArg ) )
+        {
+            CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+            eErr = CE_Failure;
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Bottom-up sweep, then distances of the lines of each stripe.    */
+/* -------------------------------------------------------------------- */
+    std::fill(sCtxt.anNearestLine.begin(), sCtxt.anNearestLine.end(), -1);
+    for( int iStripe = nStripes - 1; eErr == CE_None && iStripe >= 0;
+         iStripe-- )
+    {
+        sCtxt.nStripeYOff = iStripe * nStripeLines;
+        sCtxt.nStripeLines = std::min(nStripeLines,
+                                      nYSize - sCtxt.nStripeYOff);
+
+        eErr = GDALRasterIO( hWorkProximityBand, GF_Read,
+                             0, sCtxt.nStripeYOff,
+                             nXSize, sCtxt.nStripeLines,
+                             afDist.data(), nXSize, sCtxt.nStripeLines,
+                             GDT_Float32, 0, 0 );
+        if( eErr != CE_None )
+            break;
+
+        eErr = GDALRasterIO( hSrcBand, GF_Read, 0, sCtxt.nStripeYOff,
+                             nXSize, sCtxt.nStripeLines,
+                             anSrc.data(), nXSize, sCtxt.nStripeLines,
+                             GDT_Int32, 0, 0 );
+        if( eErr != CE_None )
+            break;
+
+        sCtxt.bHasColumnDist = false;
+        GDALRunRangeJobs( poJobQueue.get(), nThreads, nXSize,
+                          MIN_COLUMNS_PER_JOB, ProximityExactBottomUpColumns,
+                          &sCtxt );
+
+        const size_t nStripeSize =
+            static_cast<size_t>(sCtxt.nStripeLines) * nXSize;
+        if( sCtxt.bHasColumnDist )
+        {
+            GDALRunRangeJobs( poJobQueue.get(), nThreads, sCtxt.nStripeLines,
+                              1, ProximityExactLines, &sCtxt );
+        }
+        else
+        {
+            // No target within MAXDIST of any pixel of the stripe.
+            std::fill(afDist.begin(), afDist.begin() + nStripeSize,
+                      fNoDataValue);
+        }
+
+        eErr = GDALRasterIO( hProximityBand, GF_Write,
+                             0, sCtxt.nStripeYOff,
+                             nXSize, sCtxt.nStripeLines,
+                             afDist.data(), nXSize, sCtxt.nStripeLines,
+                             GDT_Float32, 0, 0 );
+        if( eErr != CE_None )
+            break;
+
+        if( !pfnProgress( 0.5 + 0.5 * (nStripes - iStripe) / nStripes,
+                          "", pProgressArg ) )
+        {
+            CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+            eErr = CE_Failure;
+        }
+    }
+
+    if( hWorkProximityDS != nullptr )
+        DestroyWorkProximityDS( hWorkProximityDS, bTempFileAlreadyDeleted );
+
+    return eErr;
+}
@@ -33,6 +33,8 @@
 #include <cstring>
 
 #include <algorithm>
+#include <map>
+#include <memory>
 #include <set>
 #include <vector>
 #include <utility>
@@ -40,7 +42,9 @@
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
+#include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_alg_priv.h"
 
@@ -146,6 +150,851 @@ static inline void CompareNeighbour( int nPolyId1, int nPolyId2,
         anBigNeighbour[nPolyId2] = nPolyId1;
 }
 
+/************************************************************************/
+/* ==================================================================== */
+/*      Stripe based sieve filter.                                      */
+/*                                                                      */
+/*      The raster is cut in stripes of lines, processed possibly by    */
+/*      several threads, and only the polygons touching the first or    */
+/*      last line of a stripe (seam polygons) are tracked for the       */
+/*      whole raster, so that memory use depends on the raster width    */
+/*      and number of stripes, not on the total number of polygons.     */
+/*                                                                      */
+/*      1) Enumerate the polygons of each stripe, and merge the seam    */
+/*         polygons across stripes with a union-find on the pixels     */
+/*         on both sides of the seams.                                  */
+/*                                                                      */
+/*      2) Find the biggest neighbour of each seam polygon.  Each       */
+/*         stripe reports the first biggest one it meets in scanline    */
+/*         order, so that ties are resolved as by GDALSieveFilter().    */
+/*         A neighbour not touching a seam is summarized by where its   */
+/*         own chain of biggest neighbours leads inside its stripe.     */
+/*                                                                      */
+/*      3) Resolve the merges of the seam polygons, then those of the   */
+/*         other polygons in each stripe, and write the result.         */
+/* ==================================================================== */
+/************************************************************************/
+
+namespace {
+
+// Where the chain of biggest neighbours of a polygon leads.
+struct GDALSieveTarget
+{
+    enum Kind { UNKNOWN, FOUND, FAILED, SEAM };
+    Kind eKind = UNKNOWN;
+    int nValue = 0;     // pixel value of the FOUND polygon.
+    int nGlobalId = -1; // id of the SEAM polygon to continue from.
+};
+
+// Biggest neighbour of a seam polygon, as seen in one stripe.
+struct GDALSieveCandidate
+{
+    int nGlobalId = -1;
+    int nSize = -1;
+    int nCandidateGlobalId = -1; // if the neighbour is a seam polygon...
+    GDALSieveTarget oTarget{};   // ... otherwise where it leads.
+};
+
+struct GDALSieveContext
+{
+    int nXSize = 0;
+    int nYSize = 0;
+    int nConnectedness = 4;
+    int nSizeThreshold = 0;
+
+    // Seam polygons of all stripes: index of the first one of each stripe,
+    // and their global id.
+    std::vector<int> anSeamBase{};
+    std::vector<int> anGlobalId{};
+    // Properties of the global polygons, and final pixel value of the
+    // sieved ones (GP_NODATA_MARKER if not changed).
+    std::vector<int> anGlobalSize{};
+    std::vector<GInt32> anGlobalValue{};
+    std::vector<GInt32> anGlobalNewValue{};
+    // Global id of the pixels of the last line of each stripe.
+    std::vector<std::vector<GInt32>> aanBottomGlobalId{};
+};
+
+struct GDALSieveStripe
+{
+    GDALSieveContext *psCtxt = nullptr;
+    int iStripe = 0;
+    int nYOff = 0;
+    int nLines = 0;
+    int nPass = 1;
+
+    // Input: pixel values, and the same with masked pixels set to
+    // GP_NODATA_MARKER.
+    std::vector<GInt32> anVal{};
+    std::vector<GInt32> anMaskedVal{};
+
+    // Output of the first pass: size and value of the seam polygons, and
+    // index of the seam polygon of the pixels of the first and last lines.
+    std::vector<int> anSeamSize{};
+    std::vector<GInt32> anSeamValue{};
+    std::vector<GInt32> anTopSeamIdx{};
+    std::vector<GInt32> anBottomSeamIdx{};
+
+    // Output of the second pass.
+    std::vector<GDALSieveCandidate> aoCandidates{};
+
+    // Output of the third pass: sieved values in anVal, and statistics.
+    bool bModified = false;
+    int nSieveTargets = 0;
+    int nIsolatedSmall = 0;
+    int nFailedMerges = 0;
+};
+
+} // namespace
+
+/************************************************************************/
+/*                      GDALSieveEnumerateStripe()                      */
+/*                                                                      */
+/*      Assign to each pixel of a stripe the index of its polygon, or   */
+/*      -1 for nodata, with polygons numbered contiguously.  The seam   */
+/*      polygons get a seam index, in the same order.                   */
+/************************************************************************/
+
+static void GDALSieveEnumerateStripe( GDALSieveStripe *psStripe,
+                                      std::vector<GInt32> &anId,
+                                      std::vector<int> &anSize,
+                                      std::vector<GInt32> &anValue,
+                                      std::vector<GInt32> &anSeamIdx )
+
+{
+    const GDALSieveContext *psCtxt = psStripe->psCtxt;
+    const int nXSize = psCtxt->nXSize;
+    const size_t nXSizeS = static_cast<size_t>(nXSize);
+    const int nLines = psStripe->nLines;
+    GInt32 *panVal = psStripe->anMaskedVal.data();
+
+    GDALRasterPolygonEnumerator oEnum( psCtxt->nConnectedness );
+    anId.resize( nXSizeS * nLines );
+    for( int iLine = 0; iLine < nLines; iLine++ )
+    {
+        if( iLine == 0 )
+            oEnum.ProcessLine( nullptr, panVal, nullptr, anId.data(),
+                               nXSize );
+        else
+            oEnum.ProcessLine( panVal + (iLine - 1) * nXSizeS,
+                               panVal + iLine * nXSizeS,
+                               anId.data() + (iLine - 1) * nXSizeS,
+                               anId.data() + iLine * nXSizeS,
+                               nXSize );
+    }
+
+    GInt32 *panPolyIdMap = oEnum.panPolyIdMap;
+    std::vector<GInt32> anFinalId( oEnum.nNextPolygonId, -1 );
+    anValue.clear();
+    for( int iPoly = 0; iPoly < oEnum.nNextPolygonId; iPoly++ )
+    {
+        int nId = panPolyIdMap[iPoly];
+        while( nId != panPolyIdMap[nId] )
+            nId = panPolyIdMap[nId];
+        panPolyIdMap[iPoly] = nId;
+        if( nId == iPoly )
+        {
+            anFinalId[iPoly] = static_cast<GInt32>(anValue.size());
+            anValue.push_back( oEnum.panPolyValue[iPoly] );
+        }
+    }
+
+    anSize.assign( anValue.size(), 0 );
+    for( auto &nId: anId )
+    {
+        if( nId >= 0 )
+        {
+            nId = anFinalId[panPolyIdMap[nId]];
+            if( anSize[nId] < MY_MAX_INT )
+                anSize[nId]++;
+        }
+    }
+
+    anSeamIdx.assign( anValue.size(), -1 );
+    const bool bTopSeam = psStripe->nYOff > 0;
+    const bool bBottomSeam = psStripe->nYOff + nLines < psCtxt->nYSize;
+    const GInt32 *panBottomId = anId.data() + (nLines - 1) * nXSizeS;
+    for( int iX = 0; iX < nXSize; iX++ )
+    {
+        if( bTopSeam && anId[iX] >= 0 )
+            anSeamIdx[anId[iX]] = 0;
+        if( bBottomSeam && panBottomId[iX] >= 0 )
+            anSeamIdx[panBottomId[iX]] = 0;
+    }
+    int nSeam = 0;
+    for( auto &nIdx: anSeamIdx )
+    {
+        if( nIdx == 0 )
+            nIdx = nSeam++;
+    }
+}
+
+/************************************************************************/
+/*                        GDALSieveSeamPassJob()                        */
+/*                                                                      */
+/*      First pass: collect the seam polygons of a stripe.              */
+/************************************************************************/
+
+static void GDALSieveSeamPassJob( void *pData )
+
+{
+    GDALSieveStripe *psStripe = static_cast<GDALSieveStripe *>(pData);
+    const int nXSize = psStripe->psCtxt->nXSize;
+
+    std::vector<GInt32> anId;
+    std::vector<int> anSize;
+    std::vector<GInt32> anValue;
+    std::vector<GInt32> anSeamIdx;
+    GDALSieveEnumerateStripe( psStripe, anId, anSize, anValue, anSeamIdx );
+
+    for( size_t iPoly = 0; iPoly < anSeamIdx.size(); iPoly++ )
+    {
+        if( anSeamIdx[iPoly] >= 0 )
+        {
+            psStripe->anSeamSize.push_back( anSize[iPoly] );
+            psStripe->anSeamValue.push_back( anValue[iPoly] );
+        }
+    }
+
+    const GInt32 *panBottomId =
+        anId.data() + static_cast<size_t>(psStripe->nLines - 1) * nXSize;
+    psStripe->anTopSeamIdx.resize( nXSize );
+    psStripe->anBottomSeamIdx.resize( nXSize );
+    for( int iX = 0; iX < nXSize; iX++ )
+    {
+        psStripe->anTopSeamIdx[iX] =
+            anId[iX] >= 0 ? anSeamIdx[anId[iX]] : -1;
+        psStripe->anBottomSeamIdx[iX] =
+            panBottomId[iX] >= 0 ? anSeamIdx[panBottomId[iX]] : -1;
+    }
+}
+
+/************************************************************************/
+/*                      GDALSieveNeighbourPassJob()                     */
+/*                                                                      */
+/*      Second and third passes: find the biggest neighbour of the      */
+/*      polygons of a stripe, and either report it for seam polygons,   */
+/*      or apply the merges.                                            */
+/************************************************************************/
+
+static void GDALSieveNeighbourPassJob( void *pData )
+
+{
+    GDALSieveStripe *psStripe = static_cast<GDALSieveStripe *>(pData);
+    const GDALSieveContext *psCtxt = psStripe->psCtxt;
+    const int nXSize = psCtxt->nXSize;
+    const size_t nXSizeS = static_cast<size_t>(nXSize);
+    const int nLines = psStripe->nLines;
+    const int nSizeThreshold = psCtxt->nSizeThreshold;
+
+    std::vector<GInt32> anId;
+    std::vector<int> anSize;
+    std::vector<GInt32> anValue;
+    std::vector<GInt32> anSeamIdx;
+    GDALSieveEnumerateStripe( psStripe, anId, anSize, anValue, anSeamIdx );
+
+/* -------------------------------------------------------------------- */
+/*      Seam polygons take their global identity and size, including    */
+/*      those of the last line of the previous stripe that are          */
+/*      neighbours of the first line of this one.                       */
+/* -------------------------------------------------------------------- */
+    std::vector<int> anGlobalId( anValue.size(), -1 );
+    std::map<int, int> oMapGlobalToLocal;
+    for( size_t iPoly = 0; iPoly < anValue.size(); iPoly++ )
+    {
+        if( anSeamIdx[iPoly] < 0 )
+            continue;
+        const int nGlobalId = psCtxt->anGlobalId[
+            psCtxt->anSeamBase[psStripe->iStripe] + anSeamIdx[iPoly]];
+        const auto oIter = oMapGlobalToLocal.find(nGlobalId);
+        if( oIter != oMapGlobalToLocal.end() )
+        {
+            // Seam polygons of a stripe may be parts of the same polygon
+            // joined in another stripe.
+            anGlobalId[iPoly] = nGlobalId;
+            continue;
+        }
+        oMapGlobalToLocal[nGlobalId] = static_cast<int>(iPoly);
+        anGlobalId[iPoly] = nGlobalId;
+        anSize[iPoly] = psCtxt->anGlobalSize[nGlobalId];
+    }
+    std::vector<GInt32> anAboveId;
+    if( psStripe->iStripe > 0 )
+    {
+        const std::vector<GInt32> &anAboveGlobalId =
+            psCtxt->aanBottomGlobalId[psStripe->iStripe - 1];
+        anAboveId.resize( nXSizeS );
+        for( int iX = 0; iX < nXSize; iX++ )
+        {
+            const int nGlobalId = anAboveGlobalId[iX];
+            if( nGlobalId < 0 )
+            {
+                anAboveId[iX] = -1;
+                continue;
+            }
+            const auto oIter = oMapGlobalToLocal.find(nGlobalId);
+            if( oIter != oMapGlobalToLocal.end() )
+            {
+                anAboveId[iX] = oIter->second;
+                continue;
+            }
+            anAboveId[iX] = static_cast<GInt32>(anValue.size());
+            oMapGlobalToLocal[nGlobalId] = anAboveId[iX];
+            anValue.push_back( psCtxt->anGlobalValue[nGlobalId] );
+            anSize.push_back( psCtxt->anGlobalSize[nGlobalId] );
+            anGlobalId.push_back( nGlobalId );
+        }
+    }
+    // Parts of the same global polygon all refer to the first one.
+    const int nPolys = static_cast<int>(anValue.size());
+    std::vector<int> anRef( nPolys );
+    for( int iPoly = 0; iPoly < nPolys; iPoly++ )
+        anRef[iPoly] = anGlobalId[iPoly] >= 0 ?
+            oMapGlobalToLocal[anGlobalId[iPoly]] : iPoly;
+
+/* -------------------------------------------------------------------- */
+/*      Check neighbours in the same order as GDALSieveFilter().        */
+/* -------------------------------------------------------------------- */
+    std::vector<int> anBigNeighbour( nPolys, -1 );
+    for( auto &nId: anId )
+    {
+        if( nId >= 0 )
+            nId = anRef[nId];
+    }
+
+    const bool b8Connected = psCtxt->nConnectedness == 8;
+    for( int iLine = 0; iLine < nLines; iLine++ )
+    {
+        const GInt32 *panThisLineId = anId.data() + iLine * nXSizeS;
+        const GInt32 *panLastLineId =
+            iLine > 0 ? anId.data() + (iLine - 1) * nXSizeS :
+            !anAboveId.empty() ? anAboveId.data() : nullptr;
+
+        for( int iX = 0; iX < nXSize; iX++ )
+        {
+            if( panLastLineId )
+            {
+                CompareNeighbour( panThisLineId[iX], panLastLineId[iX],
+                                  anRef.data(), nullptr,
+                                  anSize, anBigNeighbour );
+
+                if( iX > 0 && b8Connected )
+                    CompareNeighbour( panThisLineId[iX],
+                                      panLastLineId[iX-1],
+                                      anRef.data(), nullptr,
+                                      anSize, anBigNeighbour );
+
+                if( iX < nXSize-1 && b8Connected )
+                    CompareNeighbour( panThisLineId[iX],
+                                      panLastLineId[iX+1],
+                                      anRef.data(), nullptr,
+                                      anSize, anBigNeighbour );
+            }
+
+            if( iX > 0 )
+                CompareNeighbour( panThisLineId[iX], panThisLineId[iX-1],
+                                  anRef.data(), nullptr,
+                                  anSize, anBigNeighbour );
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Follow the chains of biggest neighbours of small polygons,      */
+/*      till a big enough polygon, a dead end, or a seam polygon.       */
+/* -------------------------------------------------------------------- */
+    std::vector<GDALSieveTarget> aoTarget( nPolys );
+    std::vector<bool> abInChain( nPolys );
+    std::vector<int> anChain;
+    const auto GetTarget = [&](int iPoly)
+    {
+        if( aoTarget[iPoly].eKind != GDALSieveTarget::UNKNOWN )
+            return aoTarget[iPoly];
+
+        GDALSieveTarget oTarget;
+        anChain.clear();
+        int iCur = iPoly;
+        while( true )
+        {
+            anChain.push_back(iCur);
+            abInChain[iCur] = true;
+            const int iNext = anBigNeighbour[iCur];
+            if( iNext < 0 )
+            {
+                oTarget.eKind = GDALSieveTarget::FAILED;
+                break;
+            }
+            if( anSize[iNext] >= nSizeThreshold )
+            {
+                oTarget.eKind = GDALSieveTarget::FOUND;
+                oTarget.nValue = anValue[iNext];
+                break;
+            }
+            if( anGlobalId[iNext] >= 0 )
+            {
+                oTarget.eKind = GDALSieveTarget::SEAM;
+                oTarget.nGlobalId = anGlobalId[iNext];
+                break;
+            }
+            if( aoTarget[iNext].eKind != GDALSieveTarget::UNKNOWN )
+            {
+                oTarget = aoTarget[iNext];
+                break;
+            }
+            // Cycle on an already visited polygon.
+            if( abInChain[iNext] )
+            {
+                oTarget.eKind = GDALSieveTarget::FAILED;
+                break;
+            }
+            iCur = iNext;
+        }
+        for( const int i: anChain )
+        {
+            aoTarget[i] = oTarget;
+            abInChain[i] = false;
+        }
+        return oTarget;
+    };
+
+    if( psStripe->nPass == 2 )
+    {
+        for( int iPoly = 0; iPoly < nPolys; iPoly++ )
+        {
+            const int iBig = anBigNeighbour[iPoly];
+            if( anRef[iPoly] != iPoly || anGlobalId[iPoly] < 0 || iBig < 0 )
+                continue;
+            GDALSieveCandidate oCandidate;
+            oCandidate.nGlobalId = anGlobalId[iPoly];
+            oCandidate.nSize = anSize[iBig];
+            if( anGlobalId[iBig] >= 0 )
+            {
+                oCandidate.nCandidateGlobalId = anGlobalId[iBig];
+            }
+            else if( anSize[iBig] >= nSizeThreshold )
+            {
+                oCandidate.oTarget.eKind = GDALSieveTarget::FOUND;
+                oCandidate.oTarget.nValue = anValue[iBig];
+            }
+            else
+            {
+                oCandidate.oTarget = GetTarget(iBig);
+            }
+            psStripe->aoCandidates.push_back( oCandidate );
+        }
+        return;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Third pass: find the new value of each polygon, and apply it.   */
+/* -------------------------------------------------------------------- */
+    std::vector<GInt32> anNewValue( nPolys, GP_NODATA_MARKER );
+    for( int iPoly = 0; iPoly < nPolys; iPoly++ )
+    {
+        if( anRef[iPoly] != iPoly )
+            continue;
+        if( anGlobalId[iPoly] >= 0 )
+        {
+            anNewValue[iPoly] = psCtxt->anGlobalNewValue[anGlobalId[iPoly]];
+            continue;
+        }
+        if( anValue[iPoly] == GP_NODATA_MARKER ||
+            anSize[iPoly] >= nSizeThreshold )
+            continue;
+
+        psStripe->nSieveTargets++;
+        if( anBigNeighbour[iPoly] < 0 )
+        {
+            psStripe->nIsolatedSmall++;
+            continue;
+        }
+        const GDALSieveTarget oTarget = GetTarget(iPoly);
+        if( oTarget.eKind == GDALSieveTarget::FOUND )
+            anNewValue[iPoly] = oTarget.nValue;
+        else if( oTarget.eKind == GDALSieveTarget::SEAM )
+            anNewValue[iPoly] = psCtxt->anGlobalNewValue[oTarget.nGlobalId];
+        if( anNewValue[iPoly] == GP_NODATA_MARKER )
+            psStripe->nFailedMerges++;
+    }
+
+    for( size_t i = 0; i < anId.size(); i++ )
+    {
+        if( anId[i] >= 0 && anNewValue[anId[i]] != GP_NODATA_MARKER &&
+            psStripe->anVal[i] != anNewValue[anId[i]] )
+        {
+            psStripe->anVal[i] = anNewValue[anId[i]];
+            psStripe->bModified = true;
+        }
+    }
+}
+
+/************************************************************************/
+/*                       GDALSieveFilterStripes()                       */
+/************************************************************************/
+
+static CPLErr
+GDALSieveFilterStripes( GDALRasterBandH hSrcBand, GDALRasterBandH hMaskBand,
+                        GDALRasterBandH hDstBand,
+                        int nSizeThreshold, int nConnectedness, int nThreads,
+                        GDALProgressFunc pfnProgress,
+                        void * pProgressArg )
+{
+    GDALSieveContext sCtxt;
+    const int nXSize = GDALGetRasterBandXSize( hSrcBand );
+    const int nYSize = GDALGetRasterBandYSize( hSrcBand );
+    sCtxt.nXSize = nXSize;
+    sCtxt.nYSize = nYSize;
+    sCtxt.nConnectedness = nConnectedness;
+    sCtxt.nSizeThreshold = nSizeThreshold;
+
+    CPLWorkerThreadPool *poPool =
+        nThreads > 1 ? CPLGetGlobalWorkerThreadPool(nThreads) : nullptr;
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if( poPool )
+    {
+        nThreads = std::min(nThreads, poPool->GetThreadCount());
+        poJobQueue = poPool->CreateJobQueue(nThreads);
+    }
+    else
+    {
+        nThreads = 1;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Determine the stripe height, so that all threads have           */
+/*      something to do.                                                */
+/* -------------------------------------------------------------------- */
+    const int nStripeLines = GDALGetStripeLines(
+        nYSize,
+        static_cast<GIntBig>(nXSize) * (3 * sizeof(GInt32) + sizeof(GByte)),
+        nThreads );
+    const int nStripes = (nYSize + nStripeLines - 1) / nStripeLines;
+    CPLDebug( "GDALSieveFilter", "Using %d stripes of %d lines, %d thread(s)",
+              nStripes, nStripeLines, nThreads );
+
+    std::vector<GDALSieveStripe> asStripes(nThreads);
+    std::vector<GByte> abyMask;
+    std::vector<int> anParent;
+    std::vector<GInt32> anLastBottomSeamIdx;
+    std::vector<GInt32> anLastBottomValue;
+    std::vector<int> anSeamSize;
+    std::vector<GInt32> anSeamValue;
+    std::vector<GDALSieveCandidate> aoBest;
+    GDALSieveStripe sStats;
+    CPLErr eErr = CE_None;
+
+    const auto Find = [&anParent](int i)
+    {
+        while( anParent[i] != i )
+        {
+            anParent[i] = anParent[anParent[i]];
+            i = anParent[i];
+        }
+        return i;
+    };
+
+    for( int nPass = 1; eErr == CE_None && nPass <= 3; nPass++ )
+    {
+        const double dfProgressStart = nPass == 1 ? 0.0 :
+                                       nPass == 2 ? 0.25 : 0.5;
+        const double dfProgressRatio = nPass == 3 ? 0.5 : 0.25;
+
+        for( int iStripe = 0; eErr == CE_None && iStripe < nStripes;
+             iStripe += nThreads )
+        {
+            const int nBatch = std::min(nThreads, nStripes - iStripe);
+
+/* -------------------------------------------------------------------- */
+/*      Read the stripes of this batch.                                 */
+/* -------------------------------------------------------------------- */
+            for( int i = 0; eErr == CE_None && i < nBatch; i++ )
+            {
+                GDALSieveStripe &sStripe = asStripes[i];
+                sStripe = GDALSieveStripe();
+                sStripe.psCtxt = &sCtxt;
+                sStripe.iStripe = iStripe + i;
+                sStripe.nYOff = sStripe.iStripe * nStripeLines;
+                sStripe.nLines =
+                    std::min(nStripeLines, nYSize - sStripe.nYOff);
+                sStripe.nPass = nPass;
+
+                const size_t nPixels =
+                    static_cast<size_t>(nXSize) * sStripe.nLines;
+                sStripe.anVal.resize(nPixels);
+                eErr = GDALRasterIO( hSrcBand, GF_Read,
+                                     0, sStripe.nYOff, nXSize, sStripe.nLines,
+                                     sStripe.anVal.data(),
+                                     nXSize, sStripe.nLines,
+                                     GDT_Int32, 0, 0 );
+                sStripe.anMaskedVal = sStripe.anVal;
+                if( eErr == CE_None && hMaskBand != nullptr )
+                {
+                    abyMask.resize(nPixels);
+                    eErr = GDALRasterIO( hMaskBand, GF_Read,
+                                         0, sStripe.nYOff,
+                                         nXSize, sStripe.nLines,
+                                         abyMask.data(),
+                                         nXSize, sStripe.nLines,
+                                         GDT_Byte, 0, 0 );
+                    for( size_t j = 0; j < nPixels; j++ )
+                    {
+                        if( abyMask[j] == 0 )
+                            sStripe.anMaskedVal[j] = GP_NODATA_MARKER;
+                    }
+                }
+                if( nPass != 3 )
+                    sStripe.anVal.clear();
+            }
+            if( eErr != CE_None )
+                break;
+
+/* -------------------------------------------------------------------- */
+/*      Process them.                                                   */
+/* -------------------------------------------------------------------- */
+            const CPLThreadFunc pfnJob = nPass == 1 ? GDALSieveSeamPassJob :
+                                         GDALSieveNeighbourPassJob;
+            if( nBatch == 1 )
+            {
+                pfnJob( &asStripes[0] );
+            }
+            else
+            {
+                std::vector<void *> apData;
+                for( int i = 0; i < nBatch; i++ )
+                    apData.push_back( &asStripes[i] );
+                poJobQueue->SubmitJobs( pfnJob, apData );
+                poJobQueue->WaitCompletion();
+            }
+
+/* -------------------------------------------------------------------- */
+/*      Gather their results, in stripe order.                          */
+/* -------------------------------------------------------------------- */
+            for( int i = 0; eErr == CE_None && i < nBatch; i++ )
+            {
+                GDALSieveStripe &sStripe = asStripes[i];
+                if( nPass == 1 )
+                {
+                    // Union-find of the seam polygons through the pixels
+                    // on both sides of the seam above this stripe.
+                    const int nBase = static_cast<int>(anParent.size());
+                    sCtxt.anSeamBase.push_back( nBase );
+                    for( size_t j = 0; j < sStripe.anSeamSize.size(); j++ )
+                        anParent.push_back( static_cast<int>(nBase + j) );
+                    anSeamSize.insert( anSeamSize.end(),
+                                       sStripe.anSeamSize.begin(),
+                                       sStripe.anSeamSize.end() );
+                    anSeamValue.insert( anSeamValue.end(),
+                                        sStripe.anSeamValue.begin(),
+                                        sStripe.anSeamValue.end() );
+
+                    const int nDiag = nConnectedness == 8 ? 1 : 0;
+                    for( int iX = 0; sStripe.iStripe > 0 && iX < nXSize;
+                         iX++ )
+                    {
+                        if( anLastBottomSeamIdx[iX] < 0 )
+                            continue;
+                        for( int iXBelow = std::max(0, iX - nDiag);
+                             iXBelow <= std::min(nXSize - 1, iX + nDiag);
+                             iXBelow++ )
+                        {
+                            const GInt32 nVal = sStripe.anMaskedVal[iXBelow];
+                            if( sStripe.anTopSeamIdx[iXBelow] >= 0 &&
+                                nVal == anLastBottomValue[iX] )
+                            {
+                                const int nRoot1 = Find(
+                                    sCtxt.anSeamBase[sStripe.iStripe - 1] +
+                                    anLastBottomSeamIdx[iX] );
+                                const int nRoot2 = Find(
+                                    nBase + sStripe.anTopSeamIdx[iXBelow] );
+                                if( nRoot1 != nRoot2 )
+                                    anParent[std::max(nRoot1, nRoot2)] =
+                                        std::min(nRoot1, nRoot2);
+                            }
+                        }
+                    }
+
+                    anLastBottomSeamIdx = sStripe.anBottomSeamIdx;
+                    anLastBottomValue.assign(
+                        sStripe.anMaskedVal.end() - nXSize,
+                        sStripe.anMaskedVal.end() );
+                    sCtxt.aanBottomGlobalId.push_back(
+                        std::move(sStripe.anBottomSeamIdx) );
+                }
+                else if( nPass == 2 )
+                {
+                    // Keep the first biggest neighbour met.
+                    for( const auto &oCandidate: sStripe.aoCandidates )
+                    {
+                        GDALSieveCandidate &oBest =
+                            aoBest[oCandidate.nGlobalId];
+                        if( oBest.nSize < oCandidate.nSize )
+                            oBest = oCandidate;
+                    }
+                }
+                else
+                {
+                    if( sStripe.bModified || hDstBand != hSrcBand )
+                    {
+                        eErr = GDALRasterIO( hDstBand, GF_Write,
+                                             0, sStripe.nYOff,
+                                             nXSize, sStripe.nLines,
+                                             sStripe.anVal.data(),
+                                             nXSize, sStripe.nLines,
+                                             GDT_Int32, 0, 0 );
+                    }
+                    sStats.nSieveTargets += sStripe.nSieveTargets;
+                    sStats.nIsolatedSmall += sStripe.nIsolatedSmall;
+                    sStats.nFailedMerges += sStripe.nFailedMerges;
+                }
+                sStripe = GDALSieveStripe();
+
+/* -------------------------------------------------------------------- */
+/*      Report progress, and support interrupts.                        */
+/* -------------------------------------------------------------------- */
+                const int nLinesDone = std::min(
+                    nYSize, (iStripe + i + 1) * nStripeLines);
+                if( eErr == CE_None &&
+                    !pfnProgress( dfProgressStart + dfProgressRatio *
+                                      (nLinesDone /
+                                       static_cast<double>(nYSize)),
+                                  "", pProgressArg ) )
+                {
+                    CPLError( CE_Failure, CPLE_UserInterrupt,
+                              "User terminated" );
+                    eErr = CE_Failure;
+                }
+            }
+        }
+        if( eErr != CE_None )
+            break;
+
+        if( nPass == 1 )
+        {
+/* -------------------------------------------------------------------- */
+/*      Number the global polygons, and sum their sizes.                */
+/* -------------------------------------------------------------------- */
+            const int nSeams = static_cast<int>(anParent.size());
+            sCtxt.anGlobalId.assign( nSeams, -1 );
+            for( int i = 0; i < nSeams; i++ )
+            {
+                const int nRoot = Find(i);
+                if( sCtxt.anGlobalId[nRoot] < 0 )
+                {
+                    sCtxt.anGlobalId[nRoot] =
+                        static_cast<int>(sCtxt.anGlobalSize.size());
+                    sCtxt.anGlobalSize.push_back( 0 );
+                    sCtxt.anGlobalValue.push_back( anSeamValue[i] );
+                }
+                const int nGlobalId = sCtxt.anGlobalId[nRoot];
+                sCtxt.anGlobalId[i] = nGlobalId;
+                sCtxt.anGlobalSize[nGlobalId] = static_cast<int>(
+                    std::min(static_cast<GIntBig>(MY_MAX_INT),
+                             static_cast<GIntBig>(
+                                 sCtxt.anGlobalSize[nGlobalId]) +
+                             anSeamSize[i]));
+            }
+            anParent.clear();
+            anParent.shrink_to_fit();
+            for( int i = 0; i < nStripes; i++ )
+            {
+                for( auto &nId: sCtxt.aanBottomGlobalId[i] )
+                {
+                    if( nId >= 0 )
+                        nId = sCtxt.anGlobalId[sCtxt.anSeamBase[i] + nId];
+                }
+            }
+            CPLDebug( "GDALSieveFilter",
+                      "%d polygon parts along seams forming %d polygons.",
+                      nSeams, static_cast<int>(sCtxt.anGlobalSize.size()) );
+            aoBest.resize( sCtxt.anGlobalSize.size() );
+        }
+        else if( nPass == 2 )
+        {
+/* -------------------------------------------------------------------- */
+/*      Resolve the merges of the global polygons.                      */
+/* -------------------------------------------------------------------- */
+            const int nGlobal = static_cast<int>(sCtxt.anGlobalSize.size());
+            sCtxt.anGlobalNewValue.assign( nGlobal, GP_NODATA_MARKER );
+            std::vector<GDALSieveTarget> aoTarget( nGlobal );
+            std::vector<bool> abInChain( nGlobal );
+            std::vector<int> anChain;
+            for( int iPoly = 0; iPoly < nGlobal; iPoly++ )
+            {
+                if( sCtxt.anGlobalValue[iPoly] == GP_NODATA_MARKER ||
+                    sCtxt.anGlobalSize[iPoly] >= nSizeThreshold )
+                    continue;
+
+                sStats.nSieveTargets++;
+                if( aoBest[iPoly].nSize < 0 )
+                {
+                    sStats.nIsolatedSmall++;
+                    continue;
+                }
+
+                GDALSieveTarget oTarget;
+                anChain.clear();
+                int iCur = iPoly;
+                while( true )
+                {
+                    anChain.push_back(iCur);
+                    abInChain[iCur] = true;
+                    const GDALSieveCandidate &oBest = aoBest[iCur];
+                    if( oBest.nSize < 0 )
+                    {
+                        oTarget.eKind = GDALSieveTarget::FAILED;
+                        break;
+                    }
+                    int iNext = oBest.nCandidateGlobalId;
+                    if( iNext < 0 )
+                    {
+                        if( oBest.oTarget.eKind != GDALSieveTarget::SEAM )
+                        {
+                            oTarget = oBest.oTarget;
+                            break;
+                        }
+                        iNext = oBest.oTarget.nGlobalId;
+                    }
+                    else if( sCtxt.anGlobalSize[iNext] >= nSizeThreshold )
+                    {
+                        oTarget.eKind = GDALSieveTarget::FOUND;
+                        oTarget.nValue = sCtxt.anGlobalValue[iNext];
+                        break;
+                    }
+                    if( aoTarget[iNext].eKind != GDALSieveTarget::UNKNOWN )
+                    {
+                        oTarget = aoTarget[iNext];
+                        break;
+                    }
+                    if( abInChain[iNext] )
+                    {
+                        oTarget.eKind = GDALSieveTarget::FAILED;
+                        break;
+                    }
+                    iCur = iNext;
+                }
+                for( const int i: anChain )
+                {
+                    aoTarget[i] = oTarget;
+                    abInChain[i] = false;
+                }
+
+                if( oTarget.eKind == GDALSieveTarget::FOUND )
+                    sCtxt.anGlobalNewValue[iPoly] = oTarget.nValue;
+                else
+                    sStats.nFailedMerges++;
+            }
+            aoBest.clear();
+            aoBest.shrink_to_fit();
+        }
+    }
+
+    CPLDebug( "GDALSieveFilter",
+              "Small Polygons: %d, Isolated: %d, Unmergable: %d",
+              sStats.nSieveTargets, sStats.nIsolatedSmall,
+              sStats.nFailedMerges );
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                          GDALSieveFilter()                           */
 /************************************************************************/
@@ -187,8 +1036,18 @@ static inline void CompareNeighbour( int nPolyId1, int nPolyId2,
  * @param nConnectedness either 4 indicating that diagonal pixels are not
  * considered directly adjacent for polygon membership purposes or 8
  * indicating they are.
- * @param papszOptions algorithm options in name=value list form.  None
- * currently supported.
+ * @param papszOptions algorithm options in name=value list form.  The
+ * following options are supported:
+ * <dl>
+ * <dt>"NUM_THREADS":</dt> (GDAL >= 3.1) Number of threads, or ALL_CPUS.
+ * When this option is set, even to 1, the raster is processed by stripes
+ * of lines, whose total height is determined by the GDAL_SWATH_SIZE
+ * configuration option (defaulting to a quarter of the block cache size),
+ * in parallel.  Memory use is then proportional to the number of polygons
+ * crossing the stripe boundaries, rather than to the total number of
+ * polygons, and stripes left unchanged are not rewritten when hDstBand is
+ * hSrcBand.  The result is the same.
+ * </dl>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
  * @param pProgressArg callback argument passed to pfnProgress.
@@ -200,7 +1059,7 @@ CPLErr CPL_STDCALL
 GDALSieveFilter( GDALRasterBandH hSrcBand, GDALRasterBandH hMaskBand,
                  GDALRasterBandH hDstBand,
                  int nSizeThreshold, int nConnectedness,
-                 CPL_UNUSED char **papszOptions,
+                 char **papszOptions,
                  GDALProgressFunc pfnProgress,
                  void * pProgressArg )
 {
@@ -210,6 +1069,17 @@ GDALSieveFilter( GDALRasterBandH hSrcBand, GDALRasterBandH hMaskBand,
     if( pfnProgress == nullptr )
         pfnProgress = GDALDummyProgress;
 
+    // GDAL_NUM_THREADS is not taken into account, for consistency with
+    // GDALPolygonize(), where the stripe mode changes the output.
+    const char *pszThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if( pszThreads != nullptr )
+    {
+        const int nThreads = CPLGetNumThreads(pszThreads);
+        return GDALSieveFilterStripes( hSrcBand, hMaskBand, hDstBand,
+                                       nSizeThreshold, nConnectedness,
+                                       nThreads, pfnProgress, pProgressArg );
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Allocate working buffers.                                       */
 /* -------------------------------------------------------------------- */
@@ -0,0 +1,136 @@
+/******************************************************************************
+ *
+ * Project:  GDAL
+ * Purpose:  Helpers for the algorithms processing rasters by stripes.
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+#include "gdal_alg_priv.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "cpl_conv.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal.h"
+
+CPL_CVSID("$Id$")
+
+/************************************************************************/
+/*                        GDALGetStripeLines()                          */
+/************************************************************************/
+
+/** Return the number of lines of the stripes in which to process a raster
+ * of nYSize lines.
+ *
+ * As in GDALDatasetCopyWholeRaster(), the working buffers of all the stripes
+ * processed at the same time are limited to GDAL_SWATH_SIZE, or a quarter of
+ * the block cache size. When nStripesAtOnce is greater than 1, the stripes
+ * are also made small enough so that there are at least that many of them.
+ *
+ * @param nYSize number of lines of the raster.
+ * @param nBytesPerLine bytes of working buffers needed for one line.
+ * @param nStripesAtOnce number of stripes processed at the same time.
+ * @return the number of lines of a stripe, between 1 and nYSize.
+ */
+int GDALGetStripeLines( int nYSize, GIntBig nBytesPerLine,
+                        int nStripesAtOnce )
+{
+    nStripesAtOnce = std::max(1, nStripesAtOnce);
+    const char *pszSwathSize = CPLGetConfigOption("GDAL_SWATH_SIZE", nullptr);
+    const GIntBig nSwathSize = pszSwathSize ? CPLAtoGIntBig(pszSwathSize) :
+                                              GDALGetCacheMax64() / 4;
+    const GIntBig nMaxLines =
+        (static_cast<GIntBig>(nYSize) + nStripesAtOnce - 1) / nStripesAtOnce;
+    return static_cast<int>(
+        std::max(GIntBig(1),
+                 std::min(nMaxLines,
+                          nSwathSize / std::max(GIntBig(1),
+                                                nBytesPerLine *
+                                                nStripesAtOnce))));
+}
+
+/************************************************************************/
+/*                          GDALRunRangeJobs()                          */
+/************************************************************************/
+
+namespace {
+struct GDALRangeJob
+{
+    GDALRangeJobFunc pfnFunc = nullptr;
+    void *pUserData = nullptr;
+    int nStart = 0;
+    int nEnd = 0;
+};
+} // namespace
+
+static void GDALRangeJobThreadFunc( void *pData )
+{
+    const GDALRangeJob *psJob = static_cast<const GDALRangeJob *>(pData);
+    psJob->pfnFunc(psJob->pUserData, psJob->nStart, psJob->nEnd);
+}
+
+/** Split [0, nCount[ in ranges, and run pfnFunc on each of them.
+ *
+ * The ranges are at most nMaxJobs, and have at least nMinPerJob items when
+ * possible. They are run in poJobQueue, and waited for, if it is not null,
+ * and in the calling thread otherwise.
+ *
+ * @param poJobQueue job queue, or nullptr.
+ * @param nMaxJobs maximum number of ranges.
+ * @param nCount number of items.
+ * @param nMinPerJob minimum number of items of a range.
+ * @param pfnFunc function called with pUserData and a range.
+ * @param pUserData user data passed to pfnFunc.
+ */
+void GDALRunRangeJobs( CPLJobQueue *poJobQueue, int nMaxJobs,
+                       int nCount, int nMinPerJob,
+                       GDALRangeJobFunc pfnFunc, void *pUserData )
+{
+    if( poJobQueue == nullptr )
+        nMaxJobs = 1;
+    const int nJobs =
+        std::max(1, std::min(nMaxJobs, nCount / std::max(1, nMinPerJob)));
+    if( nJobs == 1 )
+    {
+        pfnFunc(pUserData, 0, nCount);
+        return;
+    }
+
+    std::vector<GDALRangeJob> asJobs(nJobs);
+    std::vector<void *> apData;
+    for( int i = 0; i < nJobs; i++ )
+    {
+        asJobs[i].pfnFunc = pfnFunc;
+        asJobs[i].pUserData = pUserData;
+        asJobs[i].nStart = static_cast<int>(
+            static_cast<GIntBig>(nCount) * i / nJobs);
+        asJobs[i].nEnd = static_cast<int>(
+            static_cast<GIntBig>(nCount) * (i + 1) / nJobs);
+        apData.push_back(&asJobs[i]);
+    }
+    poJobQueue->SubmitJobs(GDALRangeJobThreadFunc, apData);
+    poJobQueue->WaitCompletion();
+}
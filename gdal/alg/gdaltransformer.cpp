@@ -42,6 +42,7 @@
 #include <cstring>
 
 #include <algorithm>
+#include <chrono>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -955,6 +956,12 @@ typedef struct {
     void     *pDstTransformArg;
     GDALTransformerFunc pDstTransformer;
 
+    // Per-stage timing, reported when the transformer is destroyed, if
+    // the GDAL_WARP_DEBUG_TIMING configuration option is set.
+    bool     bDebugTiming;
+    GIntBig  nTimedPoints;
+    double   adfStageTime[3]; // src georef, reprojection, dst georef
+
 } GDALGenImgProjTransformInfo;
 
 /************************************************************************/
@@ -976,6 +983,8 @@ GDALCreateSimilarGenImgProjTransformer( void *hTransformArg,
             CPLMalloc(sizeof(GDALGenImgProjTransformInfo)));
 
     memcpy(psClonedInfo, psInfo, sizeof(GDALGenImgProjTransformInfo));
+    psClonedInfo->nTimedPoints = 0;
+    memset(psClonedInfo->adfStageTime, 0, sizeof(psClonedInfo->adfStageTime));
 
     if( psClonedInfo->pSrcTransformArg )
         psClonedInfo->pSrcTransformArg =
@@ -1176,6 +1185,9 @@ static GDALGenImgProjTransformInfo* GDALCreateGenImgProjTransformerInternal()
     psInfo->sTI.pfnSerialize = GDALSerializeGenImgProjTransformer;
     psInfo->sTI.pfnCreateSimilar = GDALCreateSimilarGenImgProjTransformer;
 
+    psInfo->bDebugTiming =
+        CPLTestBool(CPLGetConfigOption("GDAL_WARP_DEBUG_TIMING", "NO"));
+
     return psInfo;
 }
 
@@ -2265,6 +2277,18 @@ void GDALDestroyGenImgProjTransformer( void *hTransformArg )
     GDALGenImgProjTransformInfo *psInfo =
         static_cast<GDALGenImgProjTransformInfo *>(hTransformArg);
 
+    if( psInfo->bDebugTiming && psInfo->nTimedPoints > 0 )
+    {
+        CPLDebug("WARP_TIMING",
+                 "GDALGenImgProjTransform(): " CPL_FRMT_GIB " points, "
+                 "source georeferencing: %.3f s, reprojection: %.3f s, "
+                 "destination georeferencing: %.3f s",
+                 psInfo->nTimedPoints,
+                 psInfo->adfStageTime[0],
+                 psInfo->adfStageTime[1],
+                 psInfo->adfStageTime[2]);
+    }
+
     if( psInfo->pSrcTransformArg != nullptr )
         GDALDestroyTransformer( psInfo->pSrcTransformArg );
 
@@ -2277,6 +2301,58 @@ void GDALDestroyGenImgProjTransformer( void *hTransformArg )
     CPLFree( psInfo );
 }
 
+/************************************************************************/
+/*                   GDALApplyGeoTransformToPoints()                    */
+/************************************************************************/
+
+static void GDALApplyGeoTransformToPoints( const double *padfGeoTransform,
+                                           int nPointCount,
+                                           double *padfX, double *padfY,
+                                           const int *panSuccess )
+{
+    bool bAllSuccess = true;
+    for( int i = 0; i < nPointCount; i++ )
+    {
+        if( !panSuccess[i] )
+        {
+            bAllSuccess = false;
+            break;
+        }
+    }
+
+    const double dfGT0 = padfGeoTransform[0];
+    const double dfGT1 = padfGeoTransform[1];
+    const double dfGT2 = padfGeoTransform[2];
+    const double dfGT3 = padfGeoTransform[3];
+    const double dfGT4 = padfGeoTransform[4];
+    const double dfGT5 = padfGeoTransform[5];
+
+    if( bAllSuccess )
+    {
+        // Common case: branch-less loop that the compiler can vectorize.
+        for( int i = 0; i < nPointCount; i++ )
+        {
+            const double dfX = padfX[i];
+            const double dfY = padfY[i];
+            padfX[i] = dfGT0 + dfX * dfGT1 + dfY * dfGT2;
+            padfY[i] = dfGT3 + dfX * dfGT4 + dfY * dfGT5;
+        }
+        return;
+    }
+
+    for( int i = 0; i < nPointCount; i++ )
+    {
+        if( !panSuccess[i] )
+            continue;
+
+        const double dfNewX = dfGT0 + padfX[i] * dfGT1 + padfY[i] * dfGT2;
+        const double dfNewY = dfGT3 + padfX[i] * dfGT4 + padfY[i] * dfGT5;
+
+        padfX[i] = dfNewX;
+        padfY[i] = dfNewY;
+    }
+}
+
 /************************************************************************/
 /*                      GDALGenImgProjTransform()                       */
 /************************************************************************/
@@ -2332,6 +2408,24 @@ int GDALGenImgProjTransform( void *pTransformArgIn, int bDstToSrc,
         pTransformer = psInfo->pSrcTransformer;
     }
 
+    const bool bDebugTiming = psInfo->bDebugTiming;
+    auto oLastTime = bDebugTiming ? std::chrono::steady_clock::now() :
+                                    std::chrono::steady_clock::time_point();
+    // Accumulates the time elapsed since the previous call into the
+    // specified stage.
+    const auto AddStageTime = [psInfo, bDebugTiming, &oLastTime](int iStage)
+    {
+        if( bDebugTiming )
+        {
+            const auto oNow = std::chrono::steady_clock::now();
+            psInfo->adfStageTime[iStage] +=
+                std::chrono::duration<double>(oNow - oLastTime).count();
+            oLastTime = oNow;
+        }
+    };
+    if( bDebugTiming )
+        psInfo->nTimedPoints += nPointCount;
+
     if( pTransformArg != nullptr )
     {
         if( !pTransformer( pTransformArg, FALSE,
@@ -2341,22 +2435,10 @@ int GDALGenImgProjTransform( void *pTransformArgIn, int bDstToSrc,
     }
     else
     {
-        for( int i = 0; i < nPointCount; i++ )
-        {
-            if( !panSuccess[i] )
-                continue;
-
-            const double dfNewX = padfGeoTransform[0]
-                + padfX[i] * padfGeoTransform[1]
-                + padfY[i] * padfGeoTransform[2];
-            const double dfNewY = padfGeoTransform[3]
-                + padfX[i] * padfGeoTransform[4]
-                + padfY[i] * padfGeoTransform[5];
-
-            padfX[i] = dfNewX;
-            padfY[i] = dfNewY;
-        }
+        GDALApplyGeoTransformToPoints( padfGeoTransform, nPointCount,
+                                       padfX, padfY, panSuccess );
     }
+    AddStageTime(0);
 
 /* -------------------------------------------------------------------- */
 /*      Reproject if needed.                                            */
@@ -2367,6 +2449,7 @@ int GDALGenImgProjTransform( void *pTransformArgIn, int bDstToSrc,
                                  nPointCount, padfX, padfY, padfZ,
                                  panSuccess ) )
             return FALSE;
+        AddStageTime(1);
     }
 
 /* -------------------------------------------------------------------- */
@@ -2395,22 +2478,10 @@ int GDALGenImgProjTransform( void *pTransformArgIn, int bDstToSrc,
     }
     else
     {
-        for( int i = 0; i < nPointCount; i++ )
-        {
-            if( !panSuccess[i] )
-                continue;
-
-            const double dfNewX = padfGeoTransform[0]
-                + padfX[i] * padfGeoTransform[1]
-                + padfY[i] * padfGeoTransform[2];
-            const double dfNewY = padfGeoTransform[3]
-                + padfX[i] * padfGeoTransform[4]
-                + padfY[i] * padfGeoTransform[5];
-
-            padfX[i] = dfNewX;
-            padfY[i] = dfNewY;
-        }
+        GDALApplyGeoTransformToPoints( padfGeoTransform, nPointCount,
+                                       padfX, padfY, panSuccess );
     }
+    AddStageTime(2);
 
     return TRUE;
 }
@@ -40,11 +40,13 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory>
 #include <new>
 #include <vector>
 
 #include "cpl_atomic_ops.h"
 #include "cpl_conv.h"
+#include "cpl_cpu_features.h"
 #include "cpl_error.h"
 #include "cpl_multiproc.h"
 #include "cpl_progress.h"
@@ -54,6 +56,7 @@
 #include "gdal.h"
 #include "gdal_alg.h"
 #include "gdal_alg_priv.h"
+#include "gdalwarpkernel_avx2.h"
 #include "gdalwarpkernel_opencl.h"
 
 // We restrict to 64bit processors because they are guaranteed to have SSE2.
@@ -272,42 +275,42 @@ static CPLErr GWKGenericMonoThread( GDALWarpKernel *poWK,
 }
 
 /************************************************************************/
-/*                     GWKThreadInitTransformer()                       */
+/*                          GWKCloneTransformer()                       */
 /************************************************************************/
 
-static void GWKThreadInitTransformer(void* pData)
+static void* GWKCloneTransformer(GDALTransformerFunc pfnTransformer,
+                                 void* pTransformerArg)
 {
-    GWKJobStruct* psJob = static_cast<GWKJobStruct*>(pData);
-    if( psJob->pTransformerArg == nullptr )
-        psJob->pTransformerArg =
-            GDALCloneTransformer(psJob->pTransformerArgInit);
-    if( psJob->pTransformerArg != nullptr )
+    void* pClonedTransformerArg = GDALCloneTransformer(pTransformerArg);
+    if( pClonedTransformerArg != nullptr )
     {
         // In case of lazy opening (for example RPCDEM), do a dummy
-        // transformation to be sure that the DEM is really opened with the
-        // context of this thread.
+        // transformation to be sure that the DEM is really opened now,
+        // and not concurrently by several jobs.
         double dfX = 0.5;
         double dfY = 0.5;
         double dfZ = 0.0;
         int bSuccess = FALSE;
         CPLPushErrorHandler(CPLQuietErrorHandler);
-        psJob->pfnTransformerInit(psJob->pTransformerArg, TRUE, 1,
-                                  &dfX, &dfY, &dfZ, &bSuccess );
+        pfnTransformer(pClonedTransformerArg, TRUE, 1,
+                       &dfX, &dfY, &dfZ, &bSuccess );
         CPLPopErrorHandler();
     }
+    return pClonedTransformerArg;
 }
 
 /************************************************************************/
 /*                          GWKThreadsCreate()                          */
 /************************************************************************/
 
-typedef struct
+struct GWKThreadData
 {
-    CPLWorkerThreadPool* poThreadPool;
-    GWKJobStruct* pasThreadJob;
-    CPLCond* hCond;
-    CPLMutex* hCondMutex;
-} GWKThreadData;
+    std::unique_ptr<CPLJobQueue> poJobQueue{};
+    int nThreads = 0;
+    GWKJobStruct* pasThreadJob = nullptr;
+    CPLCond* hCond = nullptr;
+    CPLMutex* hCondMutex = nullptr;
+};
 
 void* GWKThreadsCreate( char** papszWarpOptions,
                         GDALTransformerFunc pfnTransformer,
@@ -328,22 +331,29 @@ void* GWKThreadsCreate( char** papszWarpOptions,
     if( nThreads > 128 )
         nThreads = 128;
 
-    GWKThreadData* psThreadData = static_cast<GWKThreadData *>(
-        VSI_CALLOC_VERBOSE(1, sizeof(GWKThreadData)));
+    GWKThreadData* psThreadData = new (std::nothrow) GWKThreadData();
     if( psThreadData == nullptr )
         return nullptr;
 
+    CPLWorkerThreadPool* poThreadPool =
+        nThreads ? CPLGetGlobalWorkerThreadPool(nThreads) : nullptr;
+    if( poThreadPool )
+        nThreads = std::min(nThreads, poThreadPool->GetThreadCount());
+    if( nThreads <= 1 )
+        poThreadPool = nullptr;
+
     CPLCond* hCond = nullptr;
-    if( nThreads )
+    if( poThreadPool )
         hCond = CPLCreateCond();
-    if( nThreads && hCond )
+    if( poThreadPool && hCond )
     {
 /* -------------------------------------------------------------------- */
-/*      Duplicate pTransformerArg per thread.                           */
+/*      Duplicate pTransformerArg per job.                              */
 /* -------------------------------------------------------------------- */
         bool bTransformerCloningSuccess = true;
 
         psThreadData->hCond = hCond;
+        psThreadData->nThreads = nThreads;
         psThreadData->pasThreadJob = static_cast<GWKJobStruct *>(
             VSI_CALLOC_VERBOSE(sizeof(GWKJobStruct), nThreads));
         if( psThreadData->pasThreadJob == nullptr )
@@ -360,7 +370,6 @@ void* GWKThreadsCreate( char** papszWarpOptions,
         }
         CPLReleaseMutex(psThreadData->hCondMutex);
 
-        std::vector<void*> apInitData;
         for( int i = 0; i < nThreads; i++ )
         {
             psThreadData->pasThreadJob[i].hCond = psThreadData->hCond;
@@ -368,29 +377,19 @@ void* GWKThreadsCreate( char** papszWarpOptions,
             psThreadData->pasThreadJob[i].pfnTransformerInit = pfnTransformer;
             psThreadData->pasThreadJob[i].pTransformerArgInit = pTransformerArg;
             if( i == 0 )
+            {
                 psThreadData->pasThreadJob[i].pTransformerArg = pTransformerArg;
+            }
             else
-                psThreadData->pasThreadJob[i].pTransformerArg = nullptr;
-            apInitData.push_back(&(psThreadData->pasThreadJob[i]));
-        }
-
-        psThreadData->poThreadPool = new (std::nothrow) CPLWorkerThreadPool();
-        if( psThreadData->poThreadPool == nullptr ||
-            !psThreadData->poThreadPool->Setup(nThreads,
-                                          GWKThreadInitTransformer,
-                                          &apInitData[0]) )
-        {
-            GWKThreadsEnd(psThreadData);
-            return nullptr;
-        }
-
-        for( int i = 1; i < nThreads; i++ )
-        {
-            if( psThreadData->pasThreadJob[i].pTransformerArg == nullptr )
             {
-                CPLDebug("WARP", "Cannot deserialize transformer");
-                bTransformerCloningSuccess = false;
-                break;
+                psThreadData->pasThreadJob[i].pTransformerArg =
+                    GWKCloneTransformer(pfnTransformer, pTransformerArg);
+                if( psThreadData->pasThreadJob[i].pTransformerArg == nullptr )
+                {
+                    CPLDebug("WARP", "Cannot deserialize transformer");
+                    bTransformerCloningSuccess = false;
+                    break;
+                }
             }
         }
 
@@ -404,12 +403,15 @@ void* GWKThreadsCreate( char** papszWarpOptions,
             }
             CPLFree(psThreadData->pasThreadJob);
             psThreadData->pasThreadJob = nullptr;
-            delete psThreadData->poThreadPool;
-            psThreadData->poThreadPool = nullptr;
+            psThreadData->nThreads = 0;
 
             CPLDebug("WARP", "Cannot duplicate transformer function. "
                      "Falling back to mono-thread computation");
         }
+        else
+        {
+            psThreadData->poJobQueue = poThreadPool->CreateJobQueue(nThreads);
+        }
     }
 
     return psThreadData;
@@ -425,26 +427,22 @@ void GWKThreadsEnd( void* psThreadDataIn )
         return;
 
     GWKThreadData* psThreadData = static_cast<GWKThreadData *>(psThreadDataIn);
-    if( psThreadData->poThreadPool )
+    psThreadData->poJobQueue.reset();
+    if( psThreadData->pasThreadJob )
     {
-        const int nThreads = psThreadData->poThreadPool->GetThreadCount();
-        if( psThreadData->pasThreadJob )
+        for( int i = 1; i < psThreadData->nThreads; i++ )
         {
-            for( int i = 1; i < nThreads; i++ )
-            {
-                if( psThreadData->pasThreadJob[i].pTransformerArg )
-                    GDALDestroyTransformer(psThreadData->
-                                        pasThreadJob[i].pTransformerArg);
-            }
+            if( psThreadData->pasThreadJob[i].pTransformerArg )
+                GDALDestroyTransformer(psThreadData->
+                                    pasThreadJob[i].pTransformerArg);
         }
-        delete psThreadData->poThreadPool;
     }
     CPLFree(psThreadData->pasThreadJob);
     if( psThreadData->hCond )
         CPLDestroyCond(psThreadData->hCond);
     if( psThreadData->hCondMutex )
         CPLDestroyMutex(psThreadData->hCondMutex);
-    CPLFree(psThreadData);
+    delete psThreadData;
 }
 
 /************************************************************************/
@@ -474,13 +472,12 @@ static CPLErr GWKRun( GDALWarpKernel *poWK,
 
     GWKThreadData* psThreadData =
         static_cast<GWKThreadData*>(poWK->psThreadData);
-    if( psThreadData == nullptr || psThreadData->poThreadPool == nullptr )
+    if( psThreadData == nullptr || psThreadData->poJobQueue == nullptr )
     {
         return GWKGenericMonoThread(poWK, pfnFunc);
     }
 
-    int nThreads =
-        std::min(psThreadData->poThreadPool->GetThreadCount(), nDstYSize / 2);
+    int nThreads = std::min(psThreadData->nThreads, nDstYSize / 2);
     // Config option mostly useful for tests to be able to test multithreading
     // with small rasters
     const int nWarpChunkSize = atoi(
@@ -500,6 +497,14 @@ static CPLErr GWKRun( GDALWarpKernel *poWK,
     volatile int bStop = FALSE;
     volatile int nCounter = 0;
 
+    // When we run in a job of the pool (for example when warping for a VRT
+    // source read in a worker thread), blocking on the progress condition
+    // could park all the workers while our jobs are queued: progress is then
+    // reported as jobs complete, the waits running pending jobs.
+    const bool bProgress = poWK->pfnProgress != GDALDummyProgress;
+    const bool bInWorkerThread =
+        psThreadData->poJobQueue->GetPool()->IsCurrentThreadWorker();
+
     CPLAcquireMutex(psThreadData->hCondMutex, 1000);
 
 /* -------------------------------------------------------------------- */
@@ -515,18 +520,43 @@ static CPLErr GWKRun( GDALWarpKernel *poWK,
             static_cast<int>((static_cast<GIntBig>(i + 1)) *
                              nDstYSize / nThreads);
         psThreadData->pasThreadJob[i].pbStop = &bStop;
-        if( poWK->pfnProgress != GDALDummyProgress )
+        if( bProgress )
             psThreadData->pasThreadJob[i].pfnProgress = GWKProgressThread;
         else
             psThreadData->pasThreadJob[i].pfnProgress = nullptr;
-        psThreadData->poThreadPool->SubmitJob( pfnFunc,
+        psThreadData->poJobQueue->SubmitJob( pfnFunc,
                             static_cast<void*>(&psThreadData->pasThreadJob[i]) );
     }
 
 /* -------------------------------------------------------------------- */
 /*      Report progress.                                                */
 /* -------------------------------------------------------------------- */
-    if( poWK->pfnProgress != GDALDummyProgress )
+    if( bProgress && bInWorkerThread )
+    {
+        CPLReleaseMutex(psThreadData->hCondMutex);
+        // Each WaitEvent() returns after the completion of at least one job.
+        for( int i = 0; i < nThreads; i++ )
+        {
+            psThreadData->poJobQueue->WaitEvent();
+
+            CPLAcquireMutex(psThreadData->hCondMutex, 1000);
+            const int nCounterLocal = nCounter;
+            CPLReleaseMutex(psThreadData->hCondMutex);
+            if( !poWK->pfnProgress(
+                    poWK->dfProgressBase + poWK->dfProgressScale *
+                    (nCounterLocal / static_cast<double>(nDstYSize)),
+                    "", poWK->pProgress ) )
+            {
+                CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+                CPLAcquireMutex(psThreadData->hCondMutex, 1000);
+                bStop = TRUE;
+                CPLReleaseMutex(psThreadData->hCondMutex);
+                break;
+            }
+        }
+        CPLAcquireMutex(psThreadData->hCondMutex, 1000);
+    }
+    else if( bProgress )
     {
         while( nCounter < nDstYSize )
         {
@@ -551,7 +581,7 @@ static CPLErr GWKRun( GDALWarpKernel *poWK,
 /* -------------------------------------------------------------------- */
 /*      Wait for all jobs to complete.                                  */
 /* -------------------------------------------------------------------- */
-    psThreadData->poThreadPool->WaitCompletion();
+    psThreadData->poJobQueue->WaitCompletion();
 
     return !bStop ? CE_None : CE_Failure;
 }
@@ -5207,6 +5237,47 @@ static CPLErr GWKRealCase( GDALWarpKernel *poWK )
     return GWKRun( poWK, "GWKRealCase", GWKRealCaseThread );
 }
 
+#ifdef HAVE_AVX2_AT_COMPILE_TIME
+
+/************************************************************************/
+/*                       GWKGetAVX2RowFunc()                            */
+/************************************************************************/
+
+template<class T>
+static GWKResampleNoMasksRowFunc GWKGetAVX2RowFunc( GDALResampleAlg )
+{
+    return nullptr;
+}
+
+template<>
+GWKResampleNoMasksRowFunc GWKGetAVX2RowFunc<float>( GDALResampleAlg eResample )
+{
+    return eResample == GRA_Bilinear ?
+                GWKBilinearResampleNoMasksRow_AVX2_Float :
+           eResample == GRA_Cubic ?
+                GWKCubicResampleNoMasksRow_AVX2_Float : nullptr;
+}
+
+template<>
+GWKResampleNoMasksRowFunc GWKGetAVX2RowFunc<GInt16>( GDALResampleAlg eResample )
+{
+    return eResample == GRA_Bilinear ?
+                GWKBilinearResampleNoMasksRow_AVX2_Short :
+           eResample == GRA_Cubic ?
+                GWKCubicResampleNoMasksRow_AVX2_Short : nullptr;
+}
+
+template<>
+GWKResampleNoMasksRowFunc GWKGetAVX2RowFunc<GUInt16>( GDALResampleAlg eResample )
+{
+    return eResample == GRA_Bilinear ?
+                GWKBilinearResampleNoMasksRow_AVX2_UShort :
+           eResample == GRA_Cubic ?
+                GWKCubicResampleNoMasksRow_AVX2_UShort : nullptr;
+}
+
+#endif
+
 /************************************************************************/
 /*                GWKResampleNoMasksOrDstDensityOnlyThreadInternal()    */
 /************************************************************************/
@@ -5251,6 +5322,15 @@ static void GWKResampleNoMasksOrDstDensityOnlyThreadInternal( void* pData )
     for( int iDstX = 0; iDstX < nDstXSize; iDstX++ )
         padfX[nDstXSize + iDstX] = iDstX + 0.5 + poWK->nDstXOff;
 
+#ifdef HAVE_AVX2_AT_COMPILE_TIME
+    // Processes runs of 8 pixels whose resampling kernel is fully inside
+    // the source window. Other pixels go through the generic code below.
+    const GWKResampleNoMasksRowFunc pfnAVX2Row =
+        ( bUse4SamplesFormula && CPLHaveRuntimeAVX2() &&
+          CPLTestBool(CPLGetConfigOption("GDAL_USE_AVX2", "YES")) ) ?
+            GWKGetAVX2RowFunc<T>(eResample) : nullptr;
+#endif
+
 /* ==================================================================== */
 /*      Loop over output lines.                                         */
 /* ==================================================================== */
@@ -5287,6 +5367,18 @@ static void GWKResampleNoMasksOrDstDensityOnlyThreadInternal( void* pData )
 /* ==================================================================== */
         for( int iDstX = 0; iDstX < nDstXSize; iDstX++ )
         {
+#ifdef HAVE_AVX2_AT_COMPILE_TIME
+            if( pfnAVX2Row )
+            {
+                const int iNextDstX = pfnAVX2Row(poWK, iDstY, iDstX,
+                                                 padfX, padfY, pabSuccess);
+                if( iNextDstX != iDstX )
+                {
+                    iDstX = iNextDstX - 1;
+                    continue;
+                }
+            }
+#endif
             GPtrDiff_t iSrcOffset = 0;
             if( !GWKCheckAndComputeSrcOffsets(pabSuccess, iDstX, padfX, padfY,
                                               poWK, nSrcXSize, nSrcYSize,
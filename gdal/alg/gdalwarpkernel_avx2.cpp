@@ -0,0 +1,502 @@
+/******************************************************************************
+ *
+ * Project:  High Performance Image Reprojector
+ * Purpose:  AVX2 implementation of the bilinear and cubic resampling kernels
+ *           for the no-mask/no-nodata case.
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "gdalwarpkernel_avx2.h"
+
+#ifdef HAVE_AVX2_AT_COMPILE_TIME
+#include <immintrin.h>
+
+#include <limits>
+
+CPL_CVSID("$Id$")
+
+// All computations are done in double precision, with the same order of
+// operations as the generic code, so that the result is bit-exact with it.
+// 8 destination pixels are processed at a time, as 2 x 4 doubles.
+
+namespace {
+
+struct GWK8Doubles
+{
+    __m256d lo; // pixels 0 to 3
+    __m256d hi; // pixels 4 to 7
+};
+
+/************************************************************************/
+/*                           Arithmetic helpers                         */
+/************************************************************************/
+
+inline GWK8Doubles GWKSet1(double dfVal)
+{
+    GWK8Doubles r;
+    r.lo = _mm256_set1_pd(dfVal);
+    r.hi = r.lo;
+    return r;
+}
+
+inline GWK8Doubles operator+(const GWK8Doubles& a, const GWK8Doubles& b)
+{
+    GWK8Doubles r;
+    r.lo = _mm256_add_pd(a.lo, b.lo);
+    r.hi = _mm256_add_pd(a.hi, b.hi);
+    return r;
+}
+
+inline GWK8Doubles operator-(const GWK8Doubles& a, const GWK8Doubles& b)
+{
+    GWK8Doubles r;
+    r.lo = _mm256_sub_pd(a.lo, b.lo);
+    r.hi = _mm256_sub_pd(a.hi, b.hi);
+    return r;
+}
+
+inline GWK8Doubles operator*(const GWK8Doubles& a, const GWK8Doubles& b)
+{
+    GWK8Doubles r;
+    r.lo = _mm256_mul_pd(a.lo, b.lo);
+    r.hi = _mm256_mul_pd(a.hi, b.hi);
+    return r;
+}
+
+inline GWK8Doubles GWKFloor(const GWK8Doubles& a)
+{
+    GWK8Doubles r;
+    r.lo = _mm256_floor_pd(a.lo);
+    r.hi = _mm256_floor_pd(a.hi);
+    return r;
+}
+
+inline GWK8Doubles GWKTrunc(const GWK8Doubles& a)
+{
+    GWK8Doubles r;
+    r.lo = _mm256_round_pd(a.lo, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    r.hi = _mm256_round_pd(a.hi, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    return r;
+}
+
+inline GWK8Doubles GWKClamp(const GWK8Doubles& a, double dfMin, double dfMax)
+{
+    const __m256d vmin = _mm256_set1_pd(dfMin);
+    const __m256d vmax = _mm256_set1_pd(dfMax);
+    GWK8Doubles r;
+    r.lo = _mm256_min_pd(_mm256_max_pd(a.lo, vmin), vmax);
+    r.hi = _mm256_min_pd(_mm256_max_pd(a.hi, vmin), vmax);
+    return r;
+}
+
+// Returns true if dfMin <= a <= dfMax for the 8 values (false for NaN)
+inline bool GWKAllInRange(const GWK8Doubles& a, double dfMin, double dfMax)
+{
+    const __m256d vmin = _mm256_set1_pd(dfMin);
+    const __m256d vmax = _mm256_set1_pd(dfMax);
+    const __m256d lo = _mm256_and_pd(_mm256_cmp_pd(a.lo, vmin, _CMP_GE_OQ),
+                                     _mm256_cmp_pd(a.lo, vmax, _CMP_LE_OQ));
+    const __m256d hi = _mm256_and_pd(_mm256_cmp_pd(a.hi, vmin, _CMP_GE_OQ),
+                                     _mm256_cmp_pd(a.hi, vmax, _CMP_LE_OQ));
+    return (_mm256_movemask_pd(lo) & _mm256_movemask_pd(hi)) == 0xF;
+}
+
+inline GWK8Doubles GWKLoad8(const double* padf, double dfOff)
+{
+    const __m256d vOff = _mm256_set1_pd(dfOff);
+    GWK8Doubles r;
+    r.lo = _mm256_sub_pd(_mm256_loadu_pd(padf), vOff);
+    r.hi = _mm256_sub_pd(_mm256_loadu_pd(padf + 4), vOff);
+    return r;
+}
+
+// Converts 8 doubles holding integer values to 8 int32
+inline __m256i GWKToInt32(const GWK8Doubles& a)
+{
+    return _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm256_cvttpd_epi32(a.lo)),
+        _mm256_cvttpd_epi32(a.hi), 1);
+}
+
+inline GWK8Doubles GWKFromInt32(__m256i a)
+{
+    GWK8Doubles r;
+    r.lo = _mm256_cvtepi32_pd(_mm256_castsi256_si128(a));
+    r.hi = _mm256_cvtepi32_pd(_mm256_extracti128_si256(a, 1));
+    return r;
+}
+
+/************************************************************************/
+/*                              GWKAVX2Type                             */
+/************************************************************************/
+
+// LoadPair() fetches the source values at indices idx and idx+1.
+// Store() converts to the output data type, with the same rounding as
+// GWKRoundValueT(), and stores 8 values.
+
+template<class T> struct GWKAVX2Type;
+
+template<> struct GWKAVX2Type<float>
+{
+    static inline GWK8Doubles Load(const float* pSrc, __m256i idx)
+    {
+        const __m256 v = _mm256_i32gather_ps(pSrc, idx, 4);
+        GWK8Doubles r;
+        r.lo = _mm256_cvtps_pd(_mm256_castps256_ps128(v));
+        r.hi = _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1));
+        return r;
+    }
+
+    static inline void LoadPair(const float* pSrc, __m256i idx,
+                                GWK8Doubles& first, GWK8Doubles& second)
+    {
+        first = Load(pSrc, idx);
+        second = Load(pSrc, _mm256_add_epi32(idx, _mm256_set1_epi32(1)));
+    }
+
+    static inline void Store(float* pDst, const GWK8Doubles& a)
+    {
+        _mm256_storeu_ps(pDst, _mm256_insertf128_ps(
+            _mm256_castps128_ps256(_mm256_cvtpd_ps(a.lo)),
+            _mm256_cvtpd_ps(a.hi), 1));
+    }
+};
+
+// For 16-bit types, a single 32-bit gather at idx returns both the value
+// at idx (low 16 bits) and the one at idx+1 (high 16 bits). Callers
+// guarantee that idx+1 is inside the source buffer.
+
+template<> struct GWKAVX2Type<GInt16>
+{
+    static inline void LoadPair(const GInt16* pSrc, __m256i idx,
+                                GWK8Doubles& first, GWK8Doubles& second)
+    {
+        const __m256i v = _mm256_i32gather_epi32(
+            reinterpret_cast<const int*>(pSrc), idx, 2);
+        first = GWKFromInt32(_mm256_srai_epi32(_mm256_slli_epi32(v, 16), 16));
+        second = GWKFromInt32(_mm256_srai_epi32(v, 16));
+    }
+
+    static inline void Store(GInt16* pDst, const GWK8Doubles& a)
+    {
+        const GWK8Doubles rounded = GWKFloor(a + GWKSet1(0.5));
+        const __m128i lo = _mm256_cvttpd_epi32(rounded.lo);
+        const __m128i hi = _mm256_cvttpd_epi32(rounded.hi);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst),
+                         _mm_packs_epi32(lo, hi));
+    }
+};
+
+template<> struct GWKAVX2Type<GUInt16>
+{
+    static inline void LoadPair(const GUInt16* pSrc, __m256i idx,
+                                GWK8Doubles& first, GWK8Doubles& second)
+    {
+        const __m256i v = _mm256_i32gather_epi32(
+            reinterpret_cast<const int*>(pSrc), idx, 2);
+        first = GWKFromInt32(_mm256_and_si256(v, _mm256_set1_epi32(0xFFFF)));
+        second = GWKFromInt32(_mm256_srli_epi32(v, 16));
+    }
+
+    static inline void Store(GUInt16* pDst, const GWK8Doubles& a)
+    {
+        const GWK8Doubles rounded = GWKTrunc(a + GWKSet1(0.5));
+        const __m128i lo = _mm256_cvttpd_epi32(rounded.lo);
+        const __m128i hi = _mm256_cvttpd_epi32(rounded.hi);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst),
+                         _mm_packus_epi32(lo, hi));
+    }
+};
+
+template<class T> inline GWK8Doubles GWKClampToType(const GWK8Doubles& a)
+{
+    return GWKClamp(a, std::numeric_limits<T>::min(),
+                    std::numeric_limits<T>::max());
+}
+
+template<> inline GWK8Doubles GWKClampToType<float>(const GWK8Doubles& a)
+{
+    return a;
+}
+
+/************************************************************************/
+/*                        GWKAllSuccessful()                            */
+/************************************************************************/
+
+inline bool GWKAllSuccessful(const int* pabSuccess)
+{
+    const __m256i v = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(pabSuccess));
+    return _mm256_movemask_epi8(
+        _mm256_cmpeq_epi32(v, _mm256_setzero_si256())) == 0;
+}
+
+inline void GWKSetDstDensity(const GDALWarpKernel *poWK,
+                             GPtrDiff_t iDstOffset)
+{
+    if( poWK->pafDstDensity )
+        _mm256_storeu_ps(poWK->pafDstDensity + iDstOffset,
+                         _mm256_set1_ps(1.0f));
+}
+
+/************************************************************************/
+/*                GWKBilinearResampleNoMasksRow_AVX2()                  */
+/************************************************************************/
+
+template<class T>
+int GWKBilinearResampleNoMasksRow_AVX2( const GDALWarpKernel *poWK,
+                                        int iDstY, int iDstX,
+                                        const double *padfX,
+                                        const double *padfY,
+                                        const int *pabSuccess )
+{
+    const int nSrcXSize = poWK->nSrcXSize;
+    const int nSrcYSize = poWK->nSrcYSize;
+    const int nDstXSize = poWK->nDstXSize;
+    // Offsets are computed as 32-bit integers.
+    if( static_cast<GIntBig>(nSrcXSize) * nSrcYSize >
+                                        std::numeric_limits<int>::max() )
+        return iDstX;
+
+    const __m256i vSrcXSize = _mm256_set1_epi32(nSrcXSize);
+    const GWK8Doubles vHalf = GWKSet1(0.5);
+    const GWK8Doubles vOne = GWKSet1(1.0);
+    const GWK8Doubles vOneAndHalf = GWKSet1(1.5);
+
+    for( ; iDstX + 8 <= nDstXSize; iDstX += 8 )
+    {
+        if( !GWKAllSuccessful(pabSuccess + iDstX) )
+            break;
+        const GWK8Doubles dfSrcX = GWKLoad8(padfX + iDstX, poWK->nSrcXOff);
+        const GWK8Doubles dfSrcY = GWKLoad8(padfY + iDstX, poWK->nSrcYOff);
+        const GWK8Doubles dfX = GWKFloor(dfSrcX - vHalf);
+        const GWK8Doubles dfY = GWKFloor(dfSrcY - vHalf);
+        if( !GWKAllInRange(dfX, 0, nSrcXSize - 2) ||
+            !GWKAllInRange(dfY, 0, nSrcYSize - 2) )
+            break;
+
+        const __m256i iSrcOffset = _mm256_add_epi32(
+            GWKToInt32(dfX),
+            _mm256_mullo_epi32(GWKToInt32(dfY), vSrcXSize));
+        const __m256i iSrcOffsetNextLine =
+            _mm256_add_epi32(iSrcOffset, vSrcXSize);
+        const GWK8Doubles dfRatioX = vOneAndHalf - (dfSrcX - dfX);
+        const GWK8Doubles dfRatioY = vOneAndHalf - (dfSrcY - dfY);
+        const GWK8Doubles dfOneMinusRatioX = vOne - dfRatioX;
+        const GWK8Doubles dfOneMinusRatioY = vOne - dfRatioY;
+
+        const GPtrDiff_t iDstOffset =
+            iDstX + static_cast<GPtrDiff_t>(iDstY) * nDstXSize;
+        for( int iBand = 0; iBand < poWK->nBands; iBand++ )
+        {
+            const T* pSrc =
+                reinterpret_cast<const T*>(poWK->papabySrcImage[iBand]);
+            GWK8Doubles v00, v01, v10, v11;
+            GWKAVX2Type<T>::LoadPair(pSrc, iSrcOffset, v00, v01);
+            GWKAVX2Type<T>::LoadPair(pSrc, iSrcOffsetNextLine, v10, v11);
+            const GWK8Doubles dfAccumulator =
+                (v00 * dfRatioX + v01 * dfOneMinusRatioX) * dfRatioY +
+                (v10 * dfRatioX + v11 * dfOneMinusRatioX) * dfOneMinusRatioY;
+            GWKAVX2Type<T>::Store(
+                reinterpret_cast<T*>(poWK->papabyDstImage[iBand]) + iDstOffset,
+                dfAccumulator);
+        }
+        GWKSetDstDensity(poWK, iDstOffset);
+    }
+    return iDstX;
+}
+
+/************************************************************************/
+/*                  GWKCubicResampleNoMasksRow_AVX2()                   */
+/************************************************************************/
+
+template<class T>
+int GWKCubicResampleNoMasksRow_AVX2( const GDALWarpKernel *poWK,
+                                     int iDstY, int iDstX,
+                                     const double *padfX,
+                                     const double *padfY,
+                                     const int *pabSuccess )
+{
+    const int nSrcXSize = poWK->nSrcXSize;
+    const int nSrcYSize = poWK->nSrcYSize;
+    const int nDstXSize = poWK->nDstXSize;
+    // Offsets are computed as 32-bit integers.
+    if( static_cast<GIntBig>(nSrcXSize) * nSrcYSize >
+                                        std::numeric_limits<int>::max() )
+        return iDstX;
+
+    const __m256i vSrcXSize = _mm256_set1_epi32(nSrcXSize);
+    const __m256i vTwo = _mm256_set1_epi32(2);
+    const GWK8Doubles vHalf = GWKSet1(0.5);
+    const GWK8Doubles vOne = GWKSet1(1.0);
+    const GWK8Doubles vTwoD = GWKSet1(2.0);
+    const GWK8Doubles vThree = GWKSet1(3.0);
+    const GWK8Doubles vFour = GWKSet1(4.0);
+    const GWK8Doubles vFive = GWKSet1(5.0);
+
+    for( ; iDstX + 8 <= nDstXSize; iDstX += 8 )
+    {
+        if( !GWKAllSuccessful(pabSuccess + iDstX) )
+            break;
+        const GWK8Doubles dfSrcXMinusHalf =
+            GWKLoad8(padfX + iDstX, poWK->nSrcXOff) - vHalf;
+        const GWK8Doubles dfSrcYMinusHalf =
+            GWKLoad8(padfY + iDstX, poWK->nSrcYOff) - vHalf;
+        const GWK8Doubles dfX = GWKTrunc(dfSrcXMinusHalf);
+        const GWK8Doubles dfY = GWKTrunc(dfSrcYMinusHalf);
+        // Pixels close to the border use bilinear resampling in the
+        // generic code.
+        if( !GWKAllInRange(dfX, 1, nSrcXSize - 3) ||
+            !GWKAllInRange(dfY, 1, nSrcYSize - 3) )
+            break;
+
+        // Offset of the top-left pixel of the 4x4 kernel.
+        const __m256i iSrcOffset = _mm256_sub_epi32(
+            _mm256_add_epi32(
+                GWKToInt32(dfX),
+                _mm256_mullo_epi32(GWKToInt32(dfY), vSrcXSize)),
+            _mm256_add_epi32(vSrcXSize, _mm256_set1_epi32(1)));
+
+        // Same as GWKCubicComputeWeights()
+        const GWK8Doubles dfDeltaX = dfSrcXMinusHalf - dfX;
+        const GWK8Doubles dfHalfX = vHalf * dfDeltaX;
+        const GWK8Doubles dfThreeX = vThree * dfDeltaX;
+        const GWK8Doubles dfHalfX2 = dfHalfX * dfDeltaX;
+        const GWK8Doubles c0 =
+            dfHalfX * (GWKSet1(-1.0) + dfDeltaX * (vTwoD - dfDeltaX));
+        const GWK8Doubles c1 =
+            vOne + dfHalfX2 * (GWKSet1(-5.0) + dfThreeX);
+        const GWK8Doubles c2 =
+            dfHalfX * (vOne + dfDeltaX * (vFour - dfThreeX));
+        const GWK8Doubles c3 = dfHalfX2 * (GWKSet1(-1.0) + dfDeltaX);
+
+        const GWK8Doubles dfDeltaY = dfSrcYMinusHalf - dfY;
+        const GWK8Doubles dfDeltaY2 = dfDeltaY * dfDeltaY;
+        const GWK8Doubles dfDeltaY3 = dfDeltaY2 * dfDeltaY;
+
+        const GPtrDiff_t iDstOffset =
+            iDstX + static_cast<GPtrDiff_t>(iDstY) * nDstXSize;
+        for( int iBand = 0; iBand < poWK->nBands; iBand++ )
+        {
+            const T* pSrc =
+                reinterpret_cast<const T*>(poWK->papabySrcImage[iBand]);
+            GWK8Doubles adfValue[4];
+            __m256i iOffset = iSrcOffset;
+            for( int i = 0; i < 4; i++ )
+            {
+                GWK8Doubles v0, v1, v2, v3;
+                GWKAVX2Type<T>::LoadPair(pSrc, iOffset, v0, v1);
+                GWKAVX2Type<T>::LoadPair(pSrc,
+                                         _mm256_add_epi32(iOffset, vTwo),
+                                         v2, v3);
+                adfValue[i] = c0 * v0 + c1 * v1 + c2 * v2 + c3 * v3;
+                iOffset = _mm256_add_epi32(iOffset, vSrcXSize);
+            }
+
+            // Same as CubicConvolution()
+            const GWK8Doubles& f0 = adfValue[0];
+            const GWK8Doubles& f1 = adfValue[1];
+            const GWK8Doubles& f2 = adfValue[2];
+            const GWK8Doubles& f3 = adfValue[3];
+            const GWK8Doubles dfValue = f1 + vHalf * (
+                dfDeltaY * (f2 - f0) +
+                dfDeltaY2 * (vTwoD * f0 - vFive * f1 + vFour * f2 - f3) +
+                dfDeltaY3 * (vThree * (f1 - f2) + f3 - f0));
+
+            GWKAVX2Type<T>::Store(
+                reinterpret_cast<T*>(poWK->papabyDstImage[iBand]) + iDstOffset,
+                GWKClampToType<T>(dfValue));
+        }
+        GWKSetDstDensity(poWK, iDstOffset);
+    }
+    return iDstX;
+}
+
+} // namespace
+
+/************************************************************************/
+/*                        Exported entry points                         */
+/************************************************************************/
+
+int GWKBilinearResampleNoMasksRow_AVX2_Float( const GDALWarpKernel *poWK,
+                                              int iDstY, int iDstX,
+                                              const double *padfX,
+                                              const double *padfY,
+                                              const int *pabSuccess )
+{
+    return GWKBilinearResampleNoMasksRow_AVX2<float>(
+        poWK, iDstY, iDstX, padfX, padfY, pabSuccess);
+}
+
+int GWKBilinearResampleNoMasksRow_AVX2_Short( const GDALWarpKernel *poWK,
+                                              int iDstY, int iDstX,
+                                              const double *padfX,
+                                              const double *padfY,
+                                              const int *pabSuccess )
+{
+    return GWKBilinearResampleNoMasksRow_AVX2<GInt16>(
+        poWK, iDstY, iDstX, padfX, padfY, pabSuccess);
+}
+
+int GWKBilinearResampleNoMasksRow_AVX2_UShort( const GDALWarpKernel *poWK,
+                                               int iDstY, int iDstX,
+                                               const double *padfX,
+                                               const double *padfY,
+                                               const int *pabSuccess )
+{
+    return GWKBilinearResampleNoMasksRow_AVX2<GUInt16>(
+        poWK, iDstY, iDstX, padfX, padfY, pabSuccess);
+}
+
+int GWKCubicResampleNoMasksRow_AVX2_Float( const GDALWarpKernel *poWK,
+                                           int iDstY, int iDstX,
+                                           const double *padfX,
+                                           const double *padfY,
+                                           const int *pabSuccess )
+{
+    return GWKCubicResampleNoMasksRow_AVX2<float>(
+        poWK, iDstY, iDstX, padfX, padfY, pabSuccess);
+}
+
+int GWKCubicResampleNoMasksRow_AVX2_Short( const GDALWarpKernel *poWK,
+                                           int iDstY, int iDstX,
+                                           const double *padfX,
+                                           const double *padfY,
+                                           const int *pabSuccess )
+{
+    return GWKCubicResampleNoMasksRow_AVX2<GInt16>(
+        poWK, iDstY, iDstX, padfX, padfY, pabSuccess);
+}
+
+int GWKCubicResampleNoMasksRow_AVX2_UShort( const GDALWarpKernel *poWK,
+                                            int iDstY, int iDstX,
+                                            const double *padfX,
+                                            const double *padfY,
+                                            const int *pabSuccess )
+{
+    return GWKCubicResampleNoMasksRow_AVX2<GUInt16>(
+        poWK, iDstY, iDstX, padfX, padfY, pabSuccess);
+}
+
+#endif /* HAVE_AVX2_AT_COMPILE_TIME */
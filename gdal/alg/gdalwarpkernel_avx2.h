@@ -0,0 +1,91 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  High Performance Image Reprojector
+ * Purpose:  AVX2 implementation of some of the resampling kernels
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef GDALWARPKERNEL_AVX2_H_INCLUDED
+#define GDALWARPKERNEL_AVX2_H_INCLUDED
+
+#ifndef DOXYGEN_SKIP
+
+#include "gdalwarper.h"
+
+#ifdef HAVE_AVX2_AT_COMPILE_TIME
+
+// Those functions process a run of destination pixels of line iDstY,
+// starting at iDstX, by groups of 8 pixels. They stop at the first group
+// where one of the pixels is not successfully transformed or where the
+// resampling kernel of one of the pixels is not fully inside the source
+// window, and return the index of the first pixel that has not been
+// processed (iDstX if none), so that the caller can use the generic code
+// path for it.
+// They must only be used on the no-mask/no-nodata code path, when the
+// 4-sample formula applies (no downsampling), and give the same results
+// as GWKBilinearResampleNoMasks4SampleT() / GWKCubicResampleNoMasks4SampleT()
+
+typedef int (*GWKResampleNoMasksRowFunc)( const GDALWarpKernel *poWK,
+                                          int iDstY, int iDstX,
+                                          const double *padfX,
+                                          const double *padfY,
+                                          const int *pabSuccess );
+
+int GWKBilinearResampleNoMasksRow_AVX2_Float( const GDALWarpKernel *poWK,
+                                              int iDstY, int iDstX,
+                                              const double *padfX,
+                                              const double *padfY,
+                                              const int *pabSuccess );
+int GWKBilinearResampleNoMasksRow_AVX2_Short( const GDALWarpKernel *poWK,
+                                              int iDstY, int iDstX,
+                                              const double *padfX,
+                                              const double *padfY,
+                                              const int *pabSuccess );
+int GWKBilinearResampleNoMasksRow_AVX2_UShort( const GDALWarpKernel *poWK,
+                                               int iDstY, int iDstX,
+                                               const double *padfX,
+                                               const double *padfY,
+                                               const int *pabSuccess );
+int GWKCubicResampleNoMasksRow_AVX2_Float( const GDALWarpKernel *poWK,
+                                           int iDstY, int iDstX,
+                                           const double *padfX,
+                                           const double *padfY,
+                                           const int *pabSuccess );
+int GWKCubicResampleNoMasksRow_AVX2_Short( const GDALWarpKernel *poWK,
+                                           int iDstY, int iDstX,
+                                           const double *padfX,
+                                           const double *padfY,
+                                           const int *pabSuccess );
+int GWKCubicResampleNoMasksRow_AVX2_UShort( const GDALWarpKernel *poWK,
+                                            int iDstY, int iDstX,
+                                            const double *padfX,
+                                            const double *padfY,
+                                            const int *pabSuccess );
+
+#endif /* HAVE_AVX2_AT_COMPILE_TIME */
+
+#endif /* #ifndef DOXYGEN_SKIP */
+
+#endif /* GDALWARPKERNEL_AVX2_H_INCLUDED */
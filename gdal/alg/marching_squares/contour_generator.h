@@ -71,6 +71,16 @@ public:
         }
         return CE_None;
     }
+    // Start at line lineIdx, previousLine being line lineIdx - 1, so that
+    // a stripe of the raster can be processed independently
+    void startAtLine( size_t lineIdx, const double* previousLine )
+    {
+        lineIdx_ = lineIdx;
+        if ( previousLine != nullptr )
+            std::copy( previousLine, previousLine + width_, previousLine_.begin() );
+        else
+            std::fill( previousLine_.begin(), previousLine_.end(), NaN );
+    }
 private:
     size_t width_;
     size_t height_;
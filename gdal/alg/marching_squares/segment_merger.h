@@ -65,7 +65,13 @@ struct SegmentMerger
                     debug("remaining unclosed contour");
             }
         }
-        // write all remaining (non-closed) lines
+        emitRemainingLines();
+    }
+
+    // Write all remaining (non-closed) lines. Used when processing
+    // a stripe of the raster, whose lines are completed by StripeMerger.
+    void emitRemainingLines()
+    {
         for (auto it = lines_.begin(); it!=lines_.end(); ++it)
         {
             const int levelIdx = it->first;
@@ -0,0 +1,222 @@
+/******************************************************************************
+ *
+ * Project:  Marching square algorithm
+ * Purpose:  Merge of contour lines computed on stripes of a raster.
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+#ifndef MARCHING_SQUARES_STRIPE_MERGER_H
+#define MARCHING_SQUARES_STRIPE_MERGER_H
+
+#include "point.h"
+#include "utility.h"
+
+#include <iterator>
+#include <list>
+#include <map>
+#include <utility>
+
+namespace marching_squares {
+
+// StripeMerger: join the lines produced by SegmentMerger's run on
+// consecutive horizontal stripes of a raster.
+//
+// A stripe starting at line y0 of the raster is processed from the line of
+// squares whose upper corners are the centers of line y0 - 1, so the lines
+// of two consecutive stripes can only be joined at their end points lying
+// on the horizontal line of pixel centers separating them (the "seam").
+// Lines touching a seam are kept until the stripe on the other side has
+// been added, other lines are written directly.
+template <typename LineWriter>
+struct StripeMerger
+{
+    StripeMerger( LineWriter& lineWriter, bool polygonize_ )
+        : polygonize( polygonize_ )
+        , lineWriter_( lineWriter )
+    {}
+
+    ~StripeMerger()
+    {
+        if ( polygonize && ! lines_.empty() )
+            debug("remaining unclosed contour");
+        // write all remaining (non-closed) lines
+        while ( ! lines_.empty() )
+        {
+            lineWriter_.addLine( lines_.front().level, lines_.front().ls, /* closed */ false );
+            lines_.pop_front();
+        }
+    }
+
+    // Start a new stripe. topY is the ordinate of its upper seam, and
+    // bottomY the one of its lower seam (NaN if it has none).
+    void beginningOfStripe( double topY, double bottomY )
+    {
+        topY_ = topY;
+        bottomY_ = bottomY;
+    }
+
+    // Add a line produced by the stripe.
+    void addLine( double level, LineString& ls, bool closed )
+    {
+        if ( closed || ls.front() == ls.back() )
+        {
+            lineWriter_.addLine( level, ls, closed );
+            return;
+        }
+
+        // join with the lines of the previous stripes ending on the
+        // upper seam, or with the lines of this stripe already joined to
+        // them
+        LineEx line;
+        line.level = level;
+        line.ls.swap( ls );
+        bool merged = true;
+        while ( merged && !( line.ls.front() == line.ls.back() ) )
+        {
+            merged = false;
+            for ( const bool atFront : { true, false } )
+            {
+                const Point& p = atFront ? line.ls.front() : line.ls.back();
+                if ( p.y != topY_ )
+                    continue;
+                auto itEnd = topEnds_.find( std::make_pair( level, p.x ) );
+                if ( itEnd == topEnds_.end() )
+                    continue;
+
+                auto other = itEnd->second;
+                unindex_( other );
+                LineString& ols = other->ls;
+                if ( atFront )
+                {
+                    if ( ols.front() == p )
+                        ols.reverse();
+                    ols.pop_back();
+                    line.ls.splice( line.ls.begin(), ols );
+                }
+                else
+                {
+                    if ( ols.back() == p )
+                        ols.reverse();
+                    ols.pop_front();
+                    line.ls.splice( line.ls.end(), ols );
+                }
+                lines_.erase( other );
+                merged = true;
+                break;
+            }
+        }
+
+        if ( line.ls.front() == line.ls.back() )
+        {
+            // ring closed
+            lineWriter_.addLine( level, line.ls, /* closed */ true );
+            return;
+        }
+
+        const bool onTop = line.ls.front().y == topY_ || line.ls.back().y == topY_;
+        const bool onBottom = line.ls.front().y == bottomY_ || line.ls.back().y == bottomY_;
+        if ( ! onTop && ! onBottom )
+        {
+            lineWriter_.addLine( level, line.ls, /* closed */ false );
+            return;
+        }
+
+        // wait for the other side of the seams
+        lines_.push_back( LineEx() );
+        lines_.back().level = level;
+        lines_.back().ls.swap( line.ls );
+        index_( std::prev( lines_.end() ) );
+    }
+
+    // End the current stripe: the lines still ending on its upper seam
+    // will not be extended there anymore.
+    void endOfStripe()
+    {
+        while ( ! topEnds_.empty() )
+        {
+            auto it = topEnds_.begin()->second;
+            unindex_( it, topEnds_ );
+            if ( it->ls.front().y != bottomY_ && it->ls.back().y != bottomY_ )
+            {
+                lineWriter_.addLine( it->level, it->ls, /* closed */ false );
+                lines_.erase( it );
+            }
+        }
+        topEnds_.swap( bottomEnds_ );
+    }
+
+    // non copyable
+    StripeMerger( const StripeMerger<LineWriter>& ) = delete;
+    StripeMerger<LineWriter>& operator=( const StripeMerger<LineWriter>& ) = delete;
+
+    const bool polygonize;
+private:
+    struct LineEx
+    {
+        double level = 0.0;
+        LineString ls = LineString();
+    };
+    typedef std::list<LineEx> Lines;
+    // (level, x) of line ends on a seam
+    typedef std::map< std::pair<double, double>, typename Lines::iterator > Ends;
+
+    LineWriter &lineWriter_;
+    // lines ending on a seam
+    Lines lines_ = Lines();
+    // their ends on the upper seam of the current stripe
+    Ends topEnds_ = Ends();
+    // their ends on its lower seam
+    Ends bottomEnds_ = Ends();
+    double topY_ = NaN;
+    double bottomY_ = NaN;
+
+    void index_( typename Lines::iterator it )
+    {
+        for ( const Point* p : { &it->ls.front(), &it->ls.back() } )
+        {
+            if ( p->y == topY_ )
+                topEnds_.insert( std::make_pair( std::make_pair( it->level, p->x ), it ) );
+            else if ( p->y == bottomY_ )
+                bottomEnds_.insert( std::make_pair( std::make_pair( it->level, p->x ), it ) );
+        }
+    }
+
+    void unindex_( typename Lines::iterator it, Ends& ends )
+    {
+        for ( const Point* p : { &it->ls.front(), &it->ls.back() } )
+        {
+            auto itEnd = ends.find( std::make_pair( it->level, p->x ) );
+            if ( itEnd != ends.end() && itEnd->second == it )
+                ends.erase( itEnd );
+        }
+    }
+
+    void unindex_( typename Lines::iterator it )
+    {
+        unindex_( it, topEnds_ );
+        unindex_( it, bottomEnds_ );
+    }
+};
+
+}
+#endif
@@ -35,6 +35,7 @@
 #include <string.h>
 
 #include <algorithm>
+#include <chrono>
 #include <memory>
 #include <vector>
 
@@ -47,6 +48,7 @@
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 
 CPL_CVSID("$Id$")
 
@@ -327,12 +329,11 @@ static void AddEdges( GInt32 *panThisLineId, GInt32 *panLastLineId,
 }
 
 /************************************************************************/
-/*                         EmitPolygonToLayer()                         */
+/*                       GPCreatePolygonGeometry()                      */
 /************************************************************************/
 
-static CPLErr
-EmitPolygonToLayer( OGRLayerH hOutLayer, int iPixValField,
-                    RPolygon *poRPoly, double *padfGeoTransform )
+static OGRGeometryH
+GPCreatePolygonGeometry( RPolygon *poRPoly, const double *padfGeoTransform )
 
 {
 /* -------------------------------------------------------------------- */
@@ -374,6 +375,21 @@ EmitPolygonToLayer( OGRLayerH hOutLayer, int iPixValField,
         OGR_G_AddGeometryDirectly( hPolygon, hRing );
     }
 
+    return hPolygon;
+}
+
+/************************************************************************/
+/*                        GPWriteGeometryToLayer()                      */
+/*                                                                      */
+/*      Write a polygon geometry, whose ownership is taken, as a new    */
+/*      feature.                                                        */
+/************************************************************************/
+
+static CPLErr
+GPWriteGeometryToLayer( OGRLayerH hOutLayer, int iPixValField,
+                        OGRGeometryH hPolygon, double dfPolyValue )
+
+{
 /* -------------------------------------------------------------------- */
 /*      Create the feature object.                                      */
 /* -------------------------------------------------------------------- */
@@ -382,7 +398,7 @@ EmitPolygonToLayer( OGRLayerH hOutLayer, int iPixValField,
     OGR_F_SetGeometryDirectly( hFeat, hPolygon );
 
     if( iPixValField >= 0 )
-        OGR_F_SetFieldDouble( hFeat, iPixValField, poRPoly->dfPolyValue );
+        OGR_F_SetFieldDouble( hFeat, iPixValField, dfPolyValue );
 
 /* -------------------------------------------------------------------- */
 /*      Write the to the layer.                                         */
@@ -397,6 +413,21 @@ EmitPolygonToLayer( OGRLayerH hOutLayer, int iPixValField,
     return eErr;
 }
 
+/************************************************************************/
+/*                         EmitPolygonToLayer()                         */
+/************************************************************************/
+
+static CPLErr
+EmitPolygonToLayer( OGRLayerH hOutLayer, int iPixValField,
+                    RPolygon *poRPoly, const double *padfGeoTransform )
+
+{
+    return GPWriteGeometryToLayer(
+        hOutLayer, iPixValField,
+        GPCreatePolygonGeometry( poRPoly, padfGeoTransform ),
+        poRPoly->dfPolyValue );
+}
+
 /************************************************************************/
 /*                          GPMaskImageData()                           */
 /*                                                                      */
@@ -426,6 +457,620 @@ GPMaskImageData( GDALRasterBandH hMaskBand, GByte* pabyMaskLine,
     return CE_None;
 }
 
+/************************************************************************/
+/*                         GPGetGeoTransform()                          */
+/*                                                                      */
+/*      Get the geotransform, if there is one, so we can convert the    */
+/*      vectors into georeferenced coordinates.                         */
+/************************************************************************/
+
+static void GPGetGeoTransform( GDALRasterBandH hSrcBand, char **papszOptions,
+                               double *padfGeoTransform )
+
+{
+    const char* pszDatasetForGeoRef = CSLFetchNameValue(papszOptions,
+                                                        "DATASET_FOR_GEOREF");
+    if( pszDatasetForGeoRef )
+    {
+        GDALDatasetH hSrcDS = GDALOpen(pszDatasetForGeoRef, GA_ReadOnly);
+        if( hSrcDS )
+        {
+            GDALGetGeoTransform( hSrcDS, padfGeoTransform );
+            GDALClose(hSrcDS);
+        }
+    }
+    else
+    {
+        GDALDatasetH hSrcDS = GDALGetBandDataset( hSrcBand );
+        if( hSrcDS )
+            GDALGetGeoTransform( hSrcDS, padfGeoTransform );
+    }
+}
+
+/************************************************************************/
+/*                           GPReportStats()                            */
+/************************************************************************/
+
+static void GPReportStats( GIntBig nPolygons,
+                           std::chrono::steady_clock::time_point oStart )
+
+{
+    const double dfElapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - oStart).count();
+    CPLDebug( "GDALPolygonize",
+              CPL_FRMT_GIB " polygons emitted in %.3f s (%.0f polygons/s).",
+              nPolygons, dfElapsed,
+              dfElapsed > 0 ? static_cast<double>(nPolygons) / dfElapsed
+                            : 0.0 );
+}
+
+/************************************************************************/
+/* ==================================================================== */
+/*      Stripe based polygonization.                                    */
+/*                                                                      */
+/*      The raster is cut in stripes of lines that are polygonized      */
+/*      independently, possibly by several threads.  Polygons that do   */
+/*      not touch the top or bottom line of their stripe are complete   */
+/*      and turned into geometries right away.  The other ones are      */
+/*      stitched with the polygons of the adjacent stripes, across      */
+/*      the stripe boundaries (seams), in a sequential pass.            */
+/* ==================================================================== */
+/************************************************************************/
+
+// Polygon touching a seam, possibly gathering parts from several stripes.
+struct GPSeamPolygon
+{
+    std::unique_ptr<RPolygon> poPoly{};
+    // Top most, then left most, pixel of the polygon.  The first string of
+    // the part owning it belongs to the outer ring.
+    int nFirstY = 0;
+    int nFirstX = 0;
+    bool bTouchesBottom = false;
+};
+
+template<class DataType>
+struct GPStripe
+{
+    int nXSize = 0;
+    int nYSize = 0;
+    int nYOff = 0;
+    int nLines = 0;
+    int nConnectedness = 4;
+    const double *padfGeoTransform = nullptr;
+
+    // Input: pixel values of the stripe, masked, with the line above and
+    // the line below it (GP_NODATA_MARKER outside of the raster).
+    std::vector<DataType> aVal{};
+
+    // Output: polygons not touching a seam.
+    std::vector<OGRGeometryH> ahPolygons{};
+    std::vector<double> adfPolyValues{};
+
+    // Output: polygons touching a seam, and index of the polygon of each
+    // pixel of the first and last lines of the stripe (or -1).
+    std::vector<GPSeamPolygon> aoSeamPolygons{};
+    std::vector<GInt32> anTopId{};
+    std::vector<GInt32> anBottomId{};
+};
+
+/************************************************************************/
+/*                       GPPolygonizeStripeJob()                        */
+/************************************************************************/
+
+template<class DataType, class EqualityTest>
+static void GPPolygonizeStripeJob( void *pData )
+
+{
+    GPStripe<DataType> *psStripe = static_cast<GPStripe<DataType> *>(pData);
+    const int nXSize = psStripe->nXSize;
+    const int nLines = psStripe->nLines;
+    const size_t nXSizeS = static_cast<size_t>(nXSize);
+    const bool bTopSeam = psStripe->nYOff > 0;
+    const bool bBottomSeam =
+        psStripe->nYOff + nLines < psStripe->nYSize;
+
+/* -------------------------------------------------------------------- */
+/*      Enumerate the polygons of the stripe, keeping the ids of all    */
+/*      its pixels.                                                     */
+/* -------------------------------------------------------------------- */
+    GDALRasterPolygonEnumeratorT<DataType,
+                                 EqualityTest> oEnum(psStripe->nConnectedness);
+    std::vector<GInt32> anId(nXSizeS * nLines);
+    DataType *panVal = psStripe->aVal.data() + nXSizeS;
+
+    for( int iLine = 0; iLine < nLines; iLine++ )
+    {
+        if( iLine == 0 )
+            oEnum.ProcessLine( nullptr, panVal, nullptr, anId.data(),
+                               nXSize );
+        else
+            oEnum.ProcessLine( panVal + (iLine - 1) * nXSizeS,
+                               panVal + iLine * nXSizeS,
+                               anId.data() + (iLine - 1) * nXSizeS,
+                               anId.data() + iLine * nXSizeS,
+                               nXSize );
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Resolve the merges, and renumber the final polygons             */
+/*      contiguously.                                                   */
+/* -------------------------------------------------------------------- */
+    GInt32 *panPolyIdMap = oEnum.panPolyIdMap;
+    int nPolys = 0;
+    for( int iPoly = 0; iPoly < oEnum.nNextPolygonId; iPoly++ )
+    {
+        int nId = panPolyIdMap[iPoly];
+        while( nId != panPolyIdMap[nId] )
+            nId = panPolyIdMap[nId];
+        panPolyIdMap[iPoly] = nId;
+    }
+    std::vector<GInt32> anFinalId(oEnum.nNextPolygonId, -1);
+    std::vector<double> adfValue;
+    for( int iPoly = 0; iPoly < oEnum.nNextPolygonId; iPoly++ )
+    {
+        if( panPolyIdMap[iPoly] == iPoly )
+        {
+            anFinalId[iPoly] = nPolys++;
+            adfValue.push_back( oEnum.panPolyValue[iPoly] );
+        }
+    }
+    for( auto &nId: anId )
+    {
+        if( nId >= 0 )
+            nId = anFinalId[panPolyIdMap[nId]];
+    }
+    oEnum.Clear();
+
+    std::vector<bool> abTouchesTop(nPolys);
+    std::vector<bool> abTouchesBottom(nPolys);
+    for( int iX = 0; iX < nXSize; iX++ )
+    {
+        if( bTopSeam && anId[iX] >= 0 )
+            abTouchesTop[anId[iX]] = true;
+        if( bBottomSeam && anId[(nLines - 1) * nXSizeS + iX] >= 0 )
+            abTouchesBottom[anId[(nLines - 1) * nXSizeS + iX]] = true;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Collect the pixel edges, in the same order as in the second     */
+/*      pass of GDALPolygonizeT().  Along the seams, whether there is   */
+/*      an edge is found from the pixel values of the adjacent line,    */
+/*      and the edge is only added to the polygon of this stripe.       */
+/* -------------------------------------------------------------------- */
+    EqualityTest eq;
+    std::vector<std::unique_ptr<RPolygon>> apoPoly(nPolys);
+    std::vector<GPSeamPolygon> aoSeam(nPolys);
+    const auto AddSegment =
+        [&apoPoly, &adfValue, &aoSeam](int nId, int x1, int y1, int x2, int y2)
+    {
+        if( !apoPoly[nId] )
+        {
+            apoPoly[nId].reset(new RPolygon(adfValue[nId]));
+            aoSeam[nId].nFirstX = x1;
+            aoSeam[nId].nFirstY = y1;
+        }
+        apoPoly[nId]->AddSegment( x1, y1, x2, y2 );
+    };
+
+    for( int iLine = 0; iLine <= nLines; iLine++ )
+    {
+        const int iY = psStripe->nYOff + iLine;
+        const GInt32 *panThisLineId =
+            iLine < nLines ? anId.data() + iLine * nXSizeS : nullptr;
+        const GInt32 *panLastLineId =
+            iLine > 0 ? anId.data() + (iLine - 1) * nXSizeS : nullptr;
+        const DataType *panThisLineVal = panVal + iLine * nXSizeS;
+        const DataType *panLastLineVal = panVal + (iLine - 1) * nXSizeS;
+
+        for( int iX = 0; iX < nXSize; iX++ )
+        {
+            const int nThisId = panThisLineId ? panThisLineId[iX] : -1;
+            const int nPreviousId = panLastLineId ? panLastLineId[iX] : -1;
+            const int nLeftId =
+                panThisLineId && iX > 0 ? panThisLineId[iX - 1] : -1;
+
+            if( nThisId != nLeftId )
+            {
+                if( nLeftId != -1 )
+                    AddSegment( nLeftId, iX, iY, iX, iY + 1 );
+                if( nThisId != -1 )
+                    AddSegment( nThisId, iX, iY, iX, iY + 1 );
+            }
+
+            if( panThisLineId && panLastLineId )
+            {
+                if( nThisId != nPreviousId )
+                {
+                    if( nThisId != -1 )
+                        AddSegment( nThisId, iX, iY, iX + 1, iY );
+                    if( nPreviousId != -1 )
+                        AddSegment( nPreviousId, iX, iY, iX + 1, iY );
+                }
+            }
+            else if( panThisLineVal[iX] == GP_NODATA_MARKER ||
+                     panLastLineVal[iX] == GP_NODATA_MARKER ||
+                     !eq.operator()(panThisLineVal[iX],
+                                    panLastLineVal[iX]) )
+            {
+                if( nThisId != -1 )
+                    AddSegment( nThisId, iX, iY, iX + 1, iY );
+                if( nPreviousId != -1 )
+                    AddSegment( nPreviousId, iX, iY, iX + 1, iY );
+            }
+        }
+
+        if( panThisLineId && panThisLineId[nXSize - 1] != -1 )
+            AddSegment( panThisLineId[nXSize - 1],
+                        nXSize, iY, nXSize, iY + 1 );
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Turn complete polygons into geometries, and set aside the       */
+/*      ones touching a seam.                                           */
+/* -------------------------------------------------------------------- */
+    std::vector<GInt32> anSeamId(nPolys, -1);
+    for( int iPoly = 0; iPoly < nPolys; iPoly++ )
+    {
+        if( abTouchesTop[iPoly] || abTouchesBottom[iPoly] )
+        {
+            anSeamId[iPoly] =
+                static_cast<GInt32>(psStripe->aoSeamPolygons.size());
+            aoSeam[iPoly].poPoly = std::move(apoPoly[iPoly]);
+            aoSeam[iPoly].bTouchesBottom = abTouchesBottom[iPoly];
+            psStripe->aoSeamPolygons.push_back( std::move(aoSeam[iPoly]) );
+        }
+        else
+        {
+            psStripe->ahPolygons.push_back(
+                GPCreatePolygonGeometry( apoPoly[iPoly].get(),
+                                         psStripe->padfGeoTransform ) );
+            psStripe->adfPolyValues.push_back( adfValue[iPoly] );
+            apoPoly[iPoly].reset();
+        }
+    }
+
+    psStripe->anTopId.assign( nXSizeS, -1 );
+    psStripe->anBottomId.assign( nXSizeS, -1 );
+    for( int iX = 0; iX < nXSize; iX++ )
+    {
+        if( bTopSeam && anId[iX] >= 0 )
+            psStripe->anTopId[iX] = anSeamId[anId[iX]];
+        if( bBottomSeam && anId[(nLines - 1) * nXSizeS + iX] >= 0 )
+            psStripe->anBottomId[iX] =
+                anSeamId[anId[(nLines - 1) * nXSizeS + iX]];
+    }
+}
+
+/************************************************************************/
+/*                        GPStitchSeamPolygons()                        */
+/*                                                                      */
+/*      Merge the polygons of a stripe touching its top seam with the   */
+/*      pending polygons of the stripe above, and write the polygons    */
+/*      that are then complete.  The polygons touching the bottom seam  */
+/*      become the pending ones.                                        */
+/************************************************************************/
+
+template<class DataType, class EqualityTest>
+static CPLErr
+GPStitchSeamPolygons( GPStripe<DataType> *psStripe,
+                      std::vector<GPSeamPolygon> &aoPending,
+                      std::vector<GInt32> &anPendingId,
+                      std::vector<DataType> &aPendingVal,
+                      OGRLayerH hOutLayer, int iPixValField,
+                      GIntBig &nPolygonsEmitted )
+
+{
+    EqualityTest eq;
+    const int nXSize = psStripe->nXSize;
+    const int nPending = static_cast<int>(aoPending.size());
+    std::vector<GPSeamPolygon> &aoLocal = psStripe->aoSeamPolygons;
+    const int nNodes = nPending + static_cast<int>(aoLocal.size());
+
+/* -------------------------------------------------------------------- */
+/*      Union-find of the pending polygons (first) and of the stripe    */
+/*      ones, connected through the pixels on both sides of the seam.   */
+/* -------------------------------------------------------------------- */
+    std::vector<int> anParent(nNodes);
+    for( int i = 0; i < nNodes; i++ )
+        anParent[i] = i;
+    const auto Find = [&anParent](int i)
+    {
+        while( anParent[i] != i )
+        {
+            anParent[i] = anParent[anParent[i]];
+            i = anParent[i];
+        }
+        return i;
+    };
+
+    const int nDiag = psStripe->nConnectedness == 8 ? 1 : 0;
+    const DataType *panTopVal = psStripe->aVal.data() + nXSize;
+    for( int iX = 0; nPending > 0 && iX < nXSize; iX++ )
+    {
+        if( anPendingId[iX] < 0 )
+            continue;
+        for( int iXBelow = std::max(0, iX - nDiag);
+             iXBelow <= std::min(nXSize - 1, iX + nDiag);
+             iXBelow++ )
+        {
+            if( psStripe->anTopId[iXBelow] >= 0 &&
+                eq.operator()(aPendingVal[iX], panTopVal[iXBelow]) )
+            {
+                const int nRoot1 = Find( anPendingId[iX] );
+                const int nRoot2 = Find( nPending +
+                                         psStripe->anTopId[iXBelow] );
+                if( nRoot1 != nRoot2 )
+                    anParent[std::max(nRoot1, nRoot2)] =
+                        std::min(nRoot1, nRoot2);
+            }
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Gather the parts of each polygon, the one holding the outer     */
+/*      ring start first.                                               */
+/* -------------------------------------------------------------------- */
+    std::vector<int> anGroup(nNodes, -1);
+    std::vector<std::vector<int>> aanGroupNodes;
+    for( int i = 0; i < nNodes; i++ )
+    {
+        const int nRoot = Find(i);
+        if( anGroup[nRoot] < 0 )
+        {
+            anGroup[nRoot] = static_cast<int>(aanGroupNodes.size());
+            aanGroupNodes.resize(aanGroupNodes.size() + 1);
+        }
+        anGroup[i] = anGroup[nRoot];
+        aanGroupNodes[anGroup[i]].push_back(i);
+    }
+
+    const auto Node = [&aoPending, &aoLocal, nPending](int i)
+        -> GPSeamPolygon &
+    {
+        return i < nPending ? aoPending[i] : aoLocal[i - nPending];
+    };
+
+    std::vector<GPSeamPolygon> aoGroups(aanGroupNodes.size());
+    for( size_t iGroup = 0; iGroup < aanGroupNodes.size(); iGroup++ )
+    {
+        std::vector<int> &anNodes = aanGroupNodes[iGroup];
+        std::sort(anNodes.begin(), anNodes.end(),
+            [&Node](int a, int b)
+            {
+                const GPSeamPolygon &oA = Node(a);
+                const GPSeamPolygon &oB = Node(b);
+                return oA.nFirstY < oB.nFirstY ||
+                       (oA.nFirstY == oB.nFirstY && oA.nFirstX < oB.nFirstX);
+            });
+
+        // Only the parts from this stripe can touch its bottom seam.
+        bool bTouchesBottom = false;
+        for( const int i: anNodes )
+            bTouchesBottom |= i >= nPending && Node(i).bTouchesBottom;
+
+        GPSeamPolygon &oGroup = aoGroups[iGroup];
+        oGroup = std::move(Node(anNodes[0]));
+        oGroup.bTouchesBottom = bTouchesBottom;
+        for( size_t i = 1; i < anNodes.size(); i++ )
+        {
+            GPSeamPolygon &oPart = Node(anNodes[i]);
+            for( auto &anString: oPart.poPoly->aanXY )
+                oGroup.poPoly->aanXY.push_back( std::move(anString) );
+            oPart.poPoly.reset();
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Write the complete polygons, and keep the other ones pending    */
+/*      for the next seam.                                              */
+/* -------------------------------------------------------------------- */
+    CPLErr eErr = CE_None;
+    std::vector<int> anNewPendingId(aoGroups.size(), -1);
+    aoPending.clear();
+    for( size_t iGroup = 0; iGroup < aoGroups.size(); iGroup++ )
+    {
+        GPSeamPolygon &oGroup = aoGroups[iGroup];
+        if( oGroup.bTouchesBottom )
+        {
+            anNewPendingId[iGroup] = static_cast<int>(aoPending.size());
+            aoPending.push_back( std::move(oGroup) );
+        }
+        else if( eErr == CE_None )
+        {
+            eErr = EmitPolygonToLayer( hOutLayer, iPixValField,
+                                       oGroup.poPoly.get(),
+                                       psStripe->padfGeoTransform );
+            nPolygonsEmitted++;
+        }
+    }
+
+    anPendingId.assign( nXSize, -1 );
+    for( int iX = 0; iX < nXSize; iX++ )
+    {
+        if( psStripe->anBottomId[iX] >= 0 )
+            anPendingId[iX] =
+                anNewPendingId[anGroup[nPending + psStripe->anBottomId[iX]]];
+    }
+    aPendingVal.assign(
+        psStripe->aVal.begin() +
+            static_cast<size_t>(psStripe->nLines) * nXSize,
+        psStripe->aVal.begin() +
+            static_cast<size_t>(psStripe->nLines + 1) * nXSize );
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                       GDALPolygonizeStripesT()                       */
+/************************************************************************/
+
+template<class DataType, class EqualityTest>
+static CPLErr
+GDALPolygonizeStripesT( GDALRasterBandH hSrcBand,
+                        GDALRasterBandH hMaskBand,
+                        OGRLayerH hOutLayer, int iPixValField,
+                        int nConnectedness, int nThreads,
+                        const double *padfGeoTransform,
+                        GDALProgressFunc pfnProgress,
+                        void * pProgressArg,
+                        GDALDataType eDT )
+
+{
+    const int nXSize = GDALGetRasterBandXSize( hSrcBand );
+    const int nYSize = GDALGetRasterBandYSize( hSrcBand );
+    const auto oStart = std::chrono::steady_clock::now();
+
+    CPLWorkerThreadPool *poPool =
+        nThreads > 1 ? CPLGetGlobalWorkerThreadPool(nThreads) : nullptr;
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if( poPool )
+    {
+        nThreads = std::min(nThreads, poPool->GetThreadCount());
+        poJobQueue = poPool->CreateJobQueue(nThreads);
+    }
+    else
+    {
+        nThreads = 1;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Determine the stripe height, so that all threads have           */
+/*      something to do.                                                */
+/* -------------------------------------------------------------------- */
+    const int nStripeLines = GDALGetStripeLines(
+        nYSize,
+        static_cast<GIntBig>(nXSize) *
+            (sizeof(DataType) + sizeof(GInt32) + sizeof(GByte)),
+        nThreads );
+    const int nStripes = (nYSize + nStripeLines - 1) / nStripeLines;
+    CPLDebug( "GDALPolygonize", "Using %d stripes of %d lines, %d thread(s)",
+              nStripes, nStripeLines, nThreads );
+
+    std::vector<GPStripe<DataType>> asStripes(nThreads);
+    std::vector<GByte> abyMask;
+    std::vector<GPSeamPolygon> aoPending;
+    std::vector<GInt32> anPendingId;
+    std::vector<DataType> aPendingVal;
+    GIntBig nPolygonsEmitted = 0;
+    CPLErr eErr = CE_None;
+
+    for( int iStripe = 0; eErr == CE_None && iStripe < nStripes;
+         iStripe += nThreads )
+    {
+        const int nBatch = std::min(nThreads, nStripes - iStripe);
+
+/* -------------------------------------------------------------------- */
+/*      Read the stripes of this batch.                                 */
+/* -------------------------------------------------------------------- */
+        for( int i = 0; eErr == CE_None && i < nBatch; i++ )
+        {
+            GPStripe<DataType> &sStripe = asStripes[i];
+            sStripe = GPStripe<DataType>();
+            sStripe.nXSize = nXSize;
+            sStripe.nYSize = nYSize;
+            sStripe.nYOff = (iStripe + i) * nStripeLines;
+            sStripe.nLines = std::min(nStripeLines, nYSize - sStripe.nYOff);
+            sStripe.nConnectedness = nConnectedness;
+            sStripe.padfGeoTransform = padfGeoTransform;
+
+            // Read the line above and the one below too, if they exist.
+            const int nYStart = std::max(0, sStripe.nYOff - 1);
+            const int nYEnd =
+                std::min(nYSize, sStripe.nYOff + sStripe.nLines + 1);
+            const size_t nPixels =
+                static_cast<size_t>(nXSize) * (nYEnd - nYStart);
+            sStripe.aVal.assign(
+                static_cast<size_t>(nXSize) * (sStripe.nLines + 2),
+                static_cast<DataType>(GP_NODATA_MARKER) );
+            DataType *panVal = sStripe.aVal.data() +
+                static_cast<size_t>(nXSize) * (nYStart - sStripe.nYOff + 1);
+            eErr = GDALRasterIO( hSrcBand, GF_Read,
+                                 0, nYStart, nXSize, nYEnd - nYStart,
+                                 panVal, nXSize, nYEnd - nYStart,
+                                 eDT, 0, 0 );
+            if( eErr == CE_None && hMaskBand != nullptr )
+            {
+                abyMask.resize(nPixels);
+                eErr = GDALRasterIO( hMaskBand, GF_Read,
+                                     0, nYStart, nXSize, nYEnd - nYStart,
+                                     abyMask.data(), nXSize, nYEnd - nYStart,
+                                     GDT_Byte, 0, 0 );
+                for( size_t j = 0; j < nPixels; j++ )
+                {
+                    if( abyMask[j] == 0 )
+                        panVal[j] = GP_NODATA_MARKER;
+                }
+            }
+        }
+        if( eErr != CE_None )
+            break;
+
+/* -------------------------------------------------------------------- */
+/*      Polygonize them.                                                */
+/* -------------------------------------------------------------------- */
+        if( nBatch == 1 )
+        {
+            GPPolygonizeStripeJob<DataType, EqualityTest>( &asStripes[0] );
+        }
+        else
+        {
+            std::vector<void *> apData;
+            for( int i = 0; i < nBatch; i++ )
+                apData.push_back( &asStripes[i] );
+            poJobQueue->SubmitJobs(
+                GPPolygonizeStripeJob<DataType, EqualityTest>, apData );
+            poJobQueue->WaitCompletion();
+        }
+
+/* -------------------------------------------------------------------- */
+/*      Write their complete polygons, and stitch the other ones        */
+/*      with those of the stripe above.                                 */
+/* -------------------------------------------------------------------- */
+        for( int i = 0; i < nBatch; i++ )
+        {
+            GPStripe<DataType> &sStripe = asStripes[i];
+            for( size_t j = 0; j < sStripe.ahPolygons.size(); j++ )
+            {
+                if( eErr == CE_None )
+                {
+                    eErr = GPWriteGeometryToLayer( hOutLayer, iPixValField,
+                                                   sStripe.ahPolygons[j],
+                                                   sStripe.adfPolyValues[j] );
+                    nPolygonsEmitted++;
+                }
+                else
+                {
+                    OGR_G_DestroyGeometry( sStripe.ahPolygons[j] );
+                }
+            }
+            sStripe.ahPolygons.clear();
+
+            if( eErr == CE_None )
+                eErr = GPStitchSeamPolygons<DataType, EqualityTest>(
+                    &sStripe, aoPending, anPendingId, aPendingVal,
+                    hOutLayer, iPixValField, nPolygonsEmitted );
+            sStripe = GPStripe<DataType>();
+
+/* -------------------------------------------------------------------- */
+/*      Report progress, and support interrupts.                        */
+/* -------------------------------------------------------------------- */
+            const int nLinesDone =
+                std::min(nYSize, (iStripe + i + 1) * nStripeLines);
+            if( eErr == CE_None &&
+                !pfnProgress( nLinesDone / static_cast<double>(nYSize),
+                              "", pProgressArg ) )
+            {
+                CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+                eErr = CE_Failure;
+            }
+        }
+    }
+
+    GPReportStats( nPolygonsEmitted, oStart );
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                           GDALPolygonizeT()                          */
 /************************************************************************/
@@ -461,11 +1106,34 @@ GDALPolygonizeT( GDALRasterBandH hSrcBand,
         return CE_Failure;
     }
 
+/* -------------------------------------------------------------------- */
+/*      Get the geotransform, if there is one, so we can convert the    */
+/*      vectors into georeferenced coordinates.                         */
+/* -------------------------------------------------------------------- */
+    double adfGeoTransform[6] = { 0.0, 1.0, 0.0, 0.0, 0.0, 1.0 };
+    GPGetGeoTransform( hSrcBand, papszOptions, adfGeoTransform );
+
+/* -------------------------------------------------------------------- */
+/*      If a number of threads is specified, process by stripes.        */
+/*      GDAL_NUM_THREADS is not taken into account, as the order of     */
+/*      the polygons would then depend on the environment.              */
+/* -------------------------------------------------------------------- */
+    const char *pszThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if( pszThreads != nullptr )
+    {
+        const int nThreads = CPLGetNumThreads(pszThreads);
+        return GDALPolygonizeStripesT<DataType, EqualityTest>(
+            hSrcBand, hMaskBand, hOutLayer, iPixValField, nConnectedness,
+            nThreads, adfGeoTransform, pfnProgress, pProgressArg, eDT );
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Allocate working buffers.                                       */
 /* -------------------------------------------------------------------- */
     const int nXSize = GDALGetRasterBandXSize( hSrcBand );
     const int nYSize = GDALGetRasterBandYSize( hSrcBand );
+    const auto oStart = std::chrono::steady_clock::now();
+    GIntBig nPolygonsEmitted = 0;
 
     DataType *panLastLineVal = static_cast<DataType *>(
         VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize + 2));
@@ -493,30 +1161,6 @@ GDALPolygonizeT( GDALRasterBandH hSrcBand,
         return CE_Failure;
     }
 
-/* -------------------------------------------------------------------- */
-/*      Get the geotransform, if there is one, so we can convert the    */
-/*      vectors into georeferenced coordinates.                         */
-/* -------------------------------------------------------------------- */
-    double adfGeoTransform[6] = { 0.0, 1.0, 0.0, 0.0, 0.0, 1.0 };
-
-    const char* pszDatasetForGeoRef = CSLFetchNameValue(papszOptions,
-                                                        "DATASET_FOR_GEOREF");
-    if( pszDatasetForGeoRef )
-    {
-        GDALDatasetH hSrcDS = GDALOpen(pszDatasetForGeoRef, GA_ReadOnly);
-        if( hSrcDS )
-        {
-            GDALGetGeoTransform( hSrcDS, adfGeoTransform );
-            GDALClose(hSrcDS);
-        }
-    }
-    else
-    {
-        GDALDatasetH hSrcDS = GDALGetBandDataset( hSrcBand );
-        if( hSrcDS )
-            GDALGetGeoTransform( hSrcDS, adfGeoTransform );
-    }
-
 /* -------------------------------------------------------------------- */
 /*      The first pass over the raster is only used to build up the     */
 /*      polygon id map so we will know in advance what polygons are     */
@@ -661,6 +1305,7 @@ GDALPolygonizeT( GDALRasterBandH hSrcBand,
                     eErr =
                         EmitPolygonToLayer( hOutLayer, iPixValField,
                                             papoPoly[iX], adfGeoTransform );
+                    nPolygonsEmitted++;
 
                     delete papoPoly[iX];
                     papoPoly[iX] = nullptr;
@@ -697,6 +1342,7 @@ GDALPolygonizeT( GDALRasterBandH hSrcBand,
         {
             eErr = EmitPolygonToLayer( hOutLayer, iPixValField,
                                        papoPoly[iX], adfGeoTransform );
+            nPolygonsEmitted++;
 
             delete papoPoly[iX];
             papoPoly[iX] = nullptr;
@@ -713,6 +1359,8 @@ GDALPolygonizeT( GDALRasterBandH hSrcBand,
     CPLFree( pabyMaskLine );
     CPLFree( papoPoly );
 
+    GPReportStats( nPolygonsEmitted, oStart );
+
     return eErr;
 }
 
@@ -814,6 +1462,13 @@ GBool GDALFloatEquals( float A, float B )
  * <dl>
  * <dt>"8CONNECTED":</dt> May be set to "8" to use 8 connectedness.
  * Otherwise 4 connectedness will be applied to the algorithm
+ * <dt>"NUM_THREADS":</dt> (GDAL >= 3.1) Number of threads, or ALL_CPUS.
+ * When this option is set, even to 1, the raster is processed by stripes
+ * of lines, whose total height is determined by the GDAL_SWATH_SIZE
+ * configuration option (defaulting to a quarter of the block cache size),
+ * polygonized in parallel and stitched together, so that the memory used for polygon
+ * enumerations does not depend on the raster size.  The polygons are the
+ * same, but their order, and the starting vertex of their rings, differ.
  * </dl>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
@@ -890,6 +1545,13 @@ GDALPolygonize( GDALRasterBandH hSrcBand,
  * <dl>
  * <dt>"8CONNECTED":</dt> May be set to "8" to use 8 connectedness.
  * Otherwise 4 connectedness will be applied to the algorithm
+ * <dt>"NUM_THREADS":</dt> (GDAL >= 3.1) Number of threads, or ALL_CPUS.
+ * When this option is set, even to 1, the raster is processed by stripes
+ * of lines, whose total height is determined by the GDAL_SWATH_SIZE
+ * configuration option (defaulting to a quarter of the block cache size),
+ * polygonized in parallel and stitched together, so that the memory used for polygon
+ * enumerations does not depend on the raster size.  The polygons are the
+ * same, but their order, and the starting vertex of their rings, differ.
  * </dl>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
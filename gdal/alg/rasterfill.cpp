@@ -30,19 +30,23 @@
 
 #include "cpl_port.h"
 #include "gdal_alg.h"
+#include "gdal_alg_priv.h"
 
 #include <cmath>
 #include <cstring>
 
 #include <algorithm>
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 
 CPL_CVSID("$Id$")
@@ -59,10 +63,10 @@ static void
 GDALFilterLine( float *pafLastLine, float *pafThisLine, float *pafNextLine,
                 float *pafOutLine,
                 GByte *pabyLastTMask, GByte *pabyThisTMask, GByte*pabyNextTMask,
-                GByte *pabyThisFMask, int nXSize )
+                GByte *pabyThisFMask, int nXSize, int nXStart, int nXEnd )
 
 {
-    for( int iX = 0; iX < nXSize; iX++ )
+    for( int iX = nXStart; iX < nXEnd; iX++ )
     {
         if( !pabyThisFMask[iX] )
         {
@@ -136,6 +140,37 @@ GDALFilterLine( float *pafLastLine, float *pafThisLine, float *pafNextLine,
     }
 }
 
+/************************************************************************/
+/*                         GDALFilterLineJob()                          */
+/************************************************************************/
+
+namespace {
+struct GDALFilterLineJob
+{
+    float *pafLastLine = nullptr;
+    float *pafThisLine = nullptr;
+    float *pafNextLine = nullptr;
+    float *pafOutLine = nullptr;
+    GByte *pabyLastTMask = nullptr;
+    GByte *pabyThisTMask = nullptr;
+    GByte *pabyNextTMask = nullptr;
+    GByte *pabyThisFMask = nullptr;
+    int nXSize = 0;
+    int nXStart = 0;
+    int nXEnd = 0;
+};
+} // namespace
+
+static void GDALFilterLineJobFunc( void *pData )
+{
+    GDALFilterLineJob *psJob = static_cast<GDALFilterLineJob *>(pData);
+    GDALFilterLine( psJob->pafLastLine, psJob->pafThisLine,
+                    psJob->pafNextLine, psJob->pafOutLine,
+                    psJob->pabyLastTMask, psJob->pabyThisTMask,
+                    psJob->pabyNextTMask, psJob->pabyThisFMask,
+                    psJob->nXSize, psJob->nXStart, psJob->nXEnd );
+}
+
 /************************************************************************/
 /*                          GDALMultiFilter()                           */
 /*                                                                      */
@@ -157,6 +192,8 @@ GDALMultiFilter( GDALRasterBandH hTargetBand,
                  GDALRasterBandH hTargetMaskBand,
                  GDALRasterBandH hFiltMaskBand,
                  int nIterations,
+                 CPLJobQueue *poJobQueue,
+                 int nThreads,
                  GDALProgressFunc pfnProgress,
                  void * pProgressArg )
 
@@ -164,6 +201,25 @@ GDALMultiFilter( GDALRasterBandH hTargetBand,
     const int nXSize = GDALGetRasterBandXSize(hTargetBand);
     const int nYSize = GDALGetRasterBandYSize(hTargetBand);
 
+/* -------------------------------------------------------------------- */
+/*      Lines are only worth splitting between threads if they are      */
+/*      large enough.                                                   */
+/* -------------------------------------------------------------------- */
+    constexpr int MIN_PIXELS_PER_FILTER_JOB = 16384;
+    const int nJobs = poJobQueue == nullptr ? 1 :
+        std::max(1, std::min(nThreads, nXSize / MIN_PIXELS_PER_FILTER_JOB));
+    std::vector<GDALFilterLineJob> asJobs(nJobs);
+    std::vector<void *> apJobs;
+    for( int i = 0; i < nJobs; i++ )
+    {
+        asJobs[i].nXSize = nXSize;
+        asJobs[i].nXStart = static_cast<int>(
+            static_cast<GIntBig>(nXSize) * i / nJobs);
+        asJobs[i].nXEnd = static_cast<int>(
+            static_cast<GIntBig>(nXSize) * (i + 1) / nJobs);
+        apJobs.push_back(&asJobs[i]);
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Report starting progress value.                                 */
 /* -------------------------------------------------------------------- */
@@ -283,16 +339,26 @@ GDALMultiFilter( GDALRasterBandH hTargetBand,
                 continue;
             }
 
-            GDALFilterLine(
-                pafSLastPass + iLastOffset * nXSize,
-                pafLastPass  + iThisOffset * nXSize,
-                pafThisPass  + iNextOffset * nXSize,
-                pafThisPass  + iThisOffset * nXSize,
-                pabyTMaskBuf + iLastOffset * nXSize,
-                pabyTMaskBuf + iThisOffset * nXSize,
-                pabyTMaskBuf + iNextOffset * nXSize,
-                pabyFMaskBuf + iThisOffset * nXSize,
-                nXSize );
+            for( auto &sJob : asJobs )
+            {
+                sJob.pafLastLine   = pafSLastPass + iLastOffset * nXSize;
+                sJob.pafThisLine   = pafLastPass  + iThisOffset * nXSize;
+                sJob.pafNextLine   = pafThisPass  + iNextOffset * nXSize;
+                sJob.pafOutLine    = pafThisPass  + iThisOffset * nXSize;
+                sJob.pabyLastTMask = pabyTMaskBuf + iLastOffset * nXSize;
+                sJob.pabyThisTMask = pabyTMaskBuf + iThisOffset * nXSize;
+                sJob.pabyNextTMask = pabyTMaskBuf + iNextOffset * nXSize;
+                sJob.pabyThisFMask = pabyFMaskBuf + iThisOffset * nXSize;
+            }
+            if( nJobs == 1 )
+            {
+                GDALFilterLineJobFunc(&asJobs[0]);
+            }
+            else
+            {
+                poJobQueue->SubmitJobs(GDALFilterLineJobFunc, apJobs);
+                poJobQueue->WaitCompletion();
+            }
         }
 
 /* -------------------------------------------------------------------- */
@@ -365,6 +431,241 @@ inline void QUAD_CHECK(double& dfQuadDist, float& fQuadValue,
     }
 }
 
+/************************************************************************/
+/*                       GDALFillNodataContext                          */
+/*                                                                      */
+/*      The raster is processed by stripes of lines. The "last known    */
+/*      value" of each column is carried from one stripe to the next    */
+/*      one by the top-down and bottom-up sweeps, which are split       */
+/*      between threads by ranges of columns. The interpolation of a    */
+/*      line only depends on the results of the sweeps for that line,   */
+/*      so it is split between threads by ranges of lines.              */
+/************************************************************************/
+
+namespace {
+
+struct GDALFillNodataContext
+{
+    int nXSize = 0;
+    double dfMaxSearchDist = 0;
+    int nMaxSearchDist = 0;
+    GUInt32 nNoDataVal = 0;
+    bool bHasNoData = false;
+    float fNoData = 0;
+
+    // Current stripe.
+    int nStripeYOff = 0;
+    int nStripeLines = 0;
+    GByte *pabyMask = nullptr;
+    float *pafScanline = nullptr;
+    // Top-down "last known" line and value, including the current line.
+    GUInt32 *panTopDownY = nullptr;
+    float *pafTopDownValue = nullptr;
+    // Bottom-up "last known" line and value, excluding the current line.
+    GUInt32 *panBottomUpY = nullptr;
+    float *pafBottomUpValue = nullptr;
+    GByte *pabyFiltMask = nullptr;
+
+    // State of the current sweep, for each column.
+    GUInt32 *panLastY = nullptr;
+    float *pafLastValue = nullptr;
+};
+
+} // namespace
+
+/************************************************************************/
+/*                       GDALFillNodataTopDown()                        */
+/************************************************************************/
+
+static void GDALFillNodataTopDown( void *pData, int nStart, int nEnd )
+{
+    GDALFillNodataContext *psCtxt = static_cast<GDALFillNodataContext *>(pData);
+    GUInt32 *panLastY = psCtxt->panLastY;
+    float *pafLastValue = psCtxt->pafLastValue;
+
+    for( int iLine = 0; iLine < psCtxt->nStripeLines; iLine++ )
+    {
+        const int iY = psCtxt->nStripeYOff + iLine;
+        const size_t nOffset = static_cast<size_t>(iLine) * psCtxt->nXSize;
+        const GByte *pabyMask = psCtxt->pabyMask + nOffset;
+        const float *pafScanline = psCtxt->pafScanline + nOffset;
+        GUInt32 *panThisY = psCtxt->panTopDownY + nOffset;
+        float *pafThisValue = psCtxt->pafTopDownValue + nOffset;
+
+        // Figure out the most recent pixel for each column.
+        for( int iX = nStart; iX < nEnd; iX++ )
+        {
+            if( pabyMask[iX] )
+            {
+                pafLastValue[iX] = pafScanline[iX];
+                panLastY[iX] = iY;
+            }
+            else if( !(iY <= psCtxt->dfMaxSearchDist + panLastY[iX]) )
+            {
+                panLastY[iX] = psCtxt->nNoDataVal;
+            }
+            panThisY[iX] = panLastY[iX];
+            pafThisValue[iX] = pafLastValue[iX];
+        }
+    }
+}
+
+/************************************************************************/
+/*                       GDALFillNodataBottomUp()                       */
+/************************************************************************/
+
+static void GDALFillNodataBottomUp( void *pData, int nStart, int nEnd )
+{
+    GDALFillNodataContext *psCtxt = static_cast<GDALFillNodataContext *>(pData);
+    GUInt32 *panLastY = psCtxt->panLastY;
+    float *pafLastValue = psCtxt->pafLastValue;
+
+    for( int iLine = psCtxt->nStripeLines - 1; iLine >= 0; iLine-- )
+    {
+        const int iY = psCtxt->nStripeYOff + iLine;
+        const size_t nOffset = static_cast<size_t>(iLine) * psCtxt->nXSize;
+        const GByte *pabyMask = psCtxt->pabyMask + nOffset;
+        const float *pafScanline = psCtxt->pafScanline + nOffset;
+        GUInt32 *panBottomUpY = psCtxt->panBottomUpY + nOffset;
+        float *pafBottomUpValue = psCtxt->pafBottomUpValue + nOffset;
+
+        for( int iX = nStart; iX < nEnd; iX++ )
+        {
+            // The interpolation of this line uses the values found below
+            // it.
+            panBottomUpY[iX] = panLastY[iX];
+            pafBottomUpValue[iX] = pafLastValue[iX];
+
+            // Figure out the most recent pixel for each column.
+            if( pabyMask[iX] )
+            {
+                pafLastValue[iX] = pafScanline[iX];
+                panLastY[iX] = iY;
+            }
+            else if( !(panLastY[iX] - iY <= psCtxt->dfMaxSearchDist) )
+            {
+                panLastY[iX] = psCtxt->nNoDataVal;
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                      GDALFillNodataInterpolate()                     */
+/************************************************************************/
+
+static void GDALFillNodataInterpolate( void *pData, int nStart, int nEnd )
+{
+    GDALFillNodataContext *psCtxt = static_cast<GDALFillNodataContext *>(pData);
+    const int nXSize = psCtxt->nXSize;
+    const double dfMaxSearchDist = psCtxt->dfMaxSearchDist;
+    const GUInt32 nNoDataVal = psCtxt->nNoDataVal;
+
+    for( int iLine = nStart; iLine < nEnd; iLine++ )
+    {
+        const int iY = psCtxt->nStripeYOff + iLine;
+        const size_t nOffset = static_cast<size_t>(iLine) * nXSize;
+        GByte *pabyMask = psCtxt->pabyMask + nOffset;
+        float *pafScanline = psCtxt->pafScanline + nOffset;
+        const GUInt32 *panTopDownY = psCtxt->panTopDownY + nOffset;
+        const float *pafTopDownValue = psCtxt->pafTopDownValue + nOffset;
+        const GUInt32 *panLastY = psCtxt->panBottomUpY + nOffset;
+        const float *pafLastValue = psCtxt->pafBottomUpValue + nOffset;
+        GByte *pabyFiltMask = psCtxt->pabyFiltMask + nOffset;
+
+/* -------------------------------------------------------------------- */
+/*      Attempt to interpolate any pixels that are nodata.              */
+/* -------------------------------------------------------------------- */
+        memset( pabyFiltMask, 0, nXSize );
+        for( int iX = 0; iX < nXSize; iX++ )
+        {
+            int nThisMaxSearchDist = psCtxt->nMaxSearchDist;
+
+            // If this was a valid target - no change.
+            if( pabyMask[iX] )
+                continue;
+
+            // Quadrants 0:topleft, 1:bottomleft, 2:topright, 3:bottomright
+            double adfQuadDist[4] = {};
+            float fQuadValue[4] = {};
+
+            for( int iQuad = 0; iQuad < 4; iQuad++ )
+            {
+                adfQuadDist[iQuad] = dfMaxSearchDist + 1.0;
+                fQuadValue[iQuad] = 0.0;
+            }
+
+            // Step left and right by one pixel searching for the closest
+            // target value for each quadrant.
+            for( int iStep = 0; iStep <= nThisMaxSearchDist; iStep++ )
+            {
+                const int iLeftX = std::max(0, iX - iStep);
+                const int iRightX = std::min(nXSize - 1, iX + iStep);
+
+                // Top left includes current line.
+                QUAD_CHECK(adfQuadDist[0], fQuadValue[0],
+                           iLeftX, panTopDownY[iLeftX], iX, iY,
+                           pafTopDownValue[iLeftX], nNoDataVal );
+
+                // Bottom left.
+                QUAD_CHECK(adfQuadDist[1], fQuadValue[1],
+                           iLeftX, panLastY[iLeftX], iX, iY,
+                           pafLastValue[iLeftX], nNoDataVal );
+
+                // Top right and bottom right do no include center pixel.
+                if( iStep == 0 )
+                     continue;
+
+                // Top right includes current line.
+                QUAD_CHECK(adfQuadDist[2], fQuadValue[2],
+                           iRightX, panTopDownY[iRightX], iX, iY,
+                           pafTopDownValue[iRightX], nNoDataVal );
+
+                // Bottom right.
+                QUAD_CHECK(adfQuadDist[3], fQuadValue[3],
+                           iRightX, panLastY[iRightX], iX, iY,
+                           pafLastValue[iRightX], nNoDataVal );
+
+                // Every four steps, recompute maximum distance.
+                if( (iStep & 0x3) == 0 )
+                    nThisMaxSearchDist = static_cast<int>(floor(
+                        std::max(std::max(adfQuadDist[0], adfQuadDist[1]),
+                                 std::max(adfQuadDist[2], adfQuadDist[3]))));
+            }
+
+            double dfWeightSum = 0.0;
+            double dfValueSum = 0.0;
+            bool bHasSrcValues = false;
+
+            for( int iQuad = 0; iQuad < 4; iQuad++ )
+            {
+                if( adfQuadDist[iQuad] <= dfMaxSearchDist )
+                {
+                    const double dfWeight = 1.0 / adfQuadDist[iQuad];
+
+                    bHasSrcValues = dfWeight != 0;
+                    if( !psCtxt->bHasNoData ||
+                        fQuadValue[iQuad] != psCtxt->fNoData )
+                    {
+                        dfWeightSum += dfWeight;
+                        dfValueSum += fQuadValue[iQuad] * dfWeight;
+                    }
+                }
+            }
+
+            if( bHasSrcValues )
+            {
+                pabyMask[iX] = 255;
+                pabyFiltMask[iX] = 255;
+                if( dfWeightSum > 0.0 )
+                    pafScanline[iX] = static_cast<float>(dfValueSum / dfWeightSum);
+                else
+                    pafScanline[iX] = psCtxt->fNoData;
+            }
+        }
+    }
+}
+
 /************************************************************************/
 /*                           GDALFillNodata()                           */
 /************************************************************************/
@@ -401,7 +702,16 @@ inline void QUAD_CHECK(double& dfQuadDist, float& fQuadValue,
  * <li>NODATA=value (starting with GDAL 2.4).
  * Source pixels at that value will be ignored by the interpolator. Warning:
  * currently this will not be honored by smoothing passes.</li>
+ * <li>NUM_THREADS=n/ALL_CPUS (starting with GDAL 3.1). Number of threads
+ * used for the interpolation and smoothing passes. Defaults to the value of
+ * the GDAL_NUM_THREADS configuration option, or 1. The result does not
+ * depend on it.</li>
  * </ul>
+ *
+ * Starting with GDAL 3.1, the raster is processed by stripes of lines, whose
+ * height is determined by the GDAL_SWATH_SIZE configuration option
+ * (defaulting to a quarter of the block cache size), so that memory usage
+ * does not depend on the raster height.
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
  *
@@ -556,41 +866,87 @@ GDALFillNodata( GDALRasterBandH hTargetBand,
     GDALRasterBandH hFiltMaskBand = GDALGetRasterBand( hFiltMaskDS, 1 );
 
 /* -------------------------------------------------------------------- */
-/*      Allocate buffers for last scanline and this scanline.           */
+/*      Determine the stripe height.                                    */
 /* -------------------------------------------------------------------- */
+    const int nStripeLines = GDALGetStripeLines(
+        nYSize,
+        static_cast<GIntBig>(nXSize) *
+            (2 * sizeof(GByte) + 3 * sizeof(float) + 2 * sizeof(GUInt32)),
+        1 );
+    const int nStripes = (nYSize + nStripeLines - 1) / nStripeLines;
 
-    GUInt32 *panLastY =
-        static_cast<GUInt32 *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(GUInt32)));
-    GUInt32 *panThisY =
-        static_cast<GUInt32 *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(GUInt32)));
-    GUInt32 *panTopDownY =
-        static_cast<GUInt32 *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(GUInt32)));
-    float *pafLastValue =
-        static_cast<float *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(float)));
-    float *pafThisValue =
-        static_cast<float *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(float)));
-    float *pafTopDownValue =
-        static_cast<float *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(float)));
-    float *pafScanline =
-        static_cast<float *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(float)));
-    GByte *pabyMask = static_cast<GByte *>(VSI_CALLOC_VERBOSE(nXSize, 1));
-    GByte *pabyFiltMask = static_cast<GByte *>(VSI_CALLOC_VERBOSE(nXSize, 1));
+/* -------------------------------------------------------------------- */
+/*      How many threads?                                               */
+/* -------------------------------------------------------------------- */
+    int nThreads =
+        CPLGetNumThreads(CSLFetchNameValue(papszOptions, "NUM_THREADS"));
+    CPLWorkerThreadPool *poPool =
+        nThreads > 1 ? CPLGetGlobalWorkerThreadPool(nThreads) : nullptr;
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if( poPool )
+    {
+        nThreads = std::min(nThreads, poPool->GetThreadCount());
+        poJobQueue = poPool->CreateJobQueue(nThreads);
+    }
+    // Columns handled by a job of the top-down and bottom-up sweeps.
+    constexpr int MIN_COLUMNS_PER_JOB = 256;
+
+/* -------------------------------------------------------------------- */
+/*      Allocate buffers for a stripe, and for the per-column state     */
+/*      of the sweeps.                                                  */
+/* -------------------------------------------------------------------- */
+    GDALFillNodataContext sCtxt;
+    sCtxt.nXSize = nXSize;
+    sCtxt.dfMaxSearchDist = dfMaxSearchDist;
+    sCtxt.nMaxSearchDist = nMaxSearchDist;
+    sCtxt.nNoDataVal = nNoDataVal;
+    sCtxt.bHasNoData = bHasNoData;
+    sCtxt.fNoData = fNoData;
+
+    std::vector<GByte> abyMask;
+    std::vector<GByte> abyFiltMask;
+    std::vector<float> afScanline;
+    std::vector<float> afTopDownValue;
+    std::vector<float> afBottomUpValue;
+    std::vector<GUInt32> anTopDownY;
+    std::vector<GUInt32> anBottomUpY;
+    std::vector<GUInt32> anLastY;
+    std::vector<float> afLastValue;
 
     CPLErr eErr = CE_None;
 
-    if( panLastY == nullptr || panThisY == nullptr || panTopDownY == nullptr ||
-        pafLastValue == nullptr || pafThisValue == nullptr ||
-        pafTopDownValue == nullptr ||
-        pafScanline == nullptr || pabyMask == nullptr || pabyFiltMask == nullptr )
+    try
     {
+        const size_t nStripeSize = static_cast<size_t>(nStripeLines) * nXSize;
+        abyMask.resize(nStripeSize);
+        abyFiltMask.resize(nStripeSize);
+        afScanline.resize(nStripeSize);
+        afTopDownValue.resize(nStripeSize);
+        afBottomUpValue.resize(nStripeSize);
+        anTopDownY.resize(nStripeSize);
+        anBottomUpY.resize(nStripeSize);
+        anLastY.resize(nXSize);
+        afLastValue.resize(nXSize);
+    }
+    catch( const std::bad_alloc & )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate buffers for GDALFillNodata()");
         eErr = CE_Failure;
         goto end;
     }
 
-    for( int iX = 0; iX < nXSize; iX++ )
-    {
-        panLastY[iX] = nNoDataVal;
-    }
+    sCtxt.pabyMask = abyMask.data();
+    sCtxt.pabyFiltMask = abyFiltMask.data();
+    sCtxt.pafScanline = afScanline.data();
+    sCtxt.pafTopDownValue = afTopDownValue.data();
+    sCtxt.pafBottomUpValue = afBottomUpValue.data();
+    sCtxt.panTopDownY = anTopDownY.data();
+    sCtxt.panBottomUpY = anBottomUpY.data();
+    sCtxt.panLastY = anLastY.data();
+    sCtxt.pafLastValue = afLastValue.data();
+
+    std::fill(anLastY.begin(), anLastY.end(), nNoDataVal);
 
 /* ==================================================================== */
 /*      Make first pass from top to bottom collecting the "last         */
@@ -598,21 +954,27 @@ GDALFillNodata( GDALRasterBandH hTargetBand,
 /*      files.                                                          */
 /* ==================================================================== */
 
-    for( int iY = 0; iY < nYSize && eErr == CE_None; iY++ )
+    for( int iStripe = 0; iStripe < nStripes && eErr == CE_None; iStripe++ )
     {
+        const int nYOff = iStripe * nStripeLines;
+        const int nLines = std::min(nStripeLines, nYSize - nYOff);
+        sCtxt.nStripeYOff = nYOff;
+        sCtxt.nStripeLines = nLines;
+
 /* -------------------------------------------------------------------- */
-/*      Read data and mask for this line.                               */
+/*      Read data and mask for this stripe.                             */
 /* -------------------------------------------------------------------- */
         eErr =
-            GDALRasterIO( hMaskBand, GF_Read, 0, iY, nXSize, 1,
-                          pabyMask, nXSize, 1, GDT_Byte, 0, 0 );
+            GDALRasterIO( hMaskBand, GF_Read, 0, nYOff, nXSize, nLines,
+                          sCtxt.pabyMask, nXSize, nLines, GDT_Byte, 0, 0 );
 
         if( eErr != CE_None )
             break;
 
         eErr =
-            GDALRasterIO( hTargetBand, GF_Read, 0, iY, nXSize, 1,
-                          pafScanline, nXSize, 1, GDT_Float32, 0, 0 );
+            GDALRasterIO( hTargetBand, GF_Read, 0, nYOff, nXSize, nLines,
+                          sCtxt.pafScanline, nXSize, nLines,
+                          GDT_Float32, 0, 0 );
 
         if( eErr != CE_None )
             break;
@@ -620,50 +982,30 @@ GDALFillNodata( GDALRasterBandH hTargetBand,
 /* -------------------------------------------------------------------- */
 /*      Figure out the most recent pixel for each column.               */
 /* -------------------------------------------------------------------- */
-
-        for( int iX = 0; iX < nXSize; iX++ )
-        {
-            if( pabyMask[iX] )
-            {
-                pafThisValue[iX] = pafScanline[iX];
-                panThisY[iX] = iY;
-            }
-            else if( iY <= dfMaxSearchDist + panLastY[iX] )
-            {
-                pafThisValue[iX] = pafLastValue[iX];
-                panThisY[iX] = panLastY[iX];
-            }
-            else
-            {
-                panThisY[iX] = nNoDataVal;
-            }
-        }
+        GDALRunRangeJobs( poJobQueue.get(), nThreads, nXSize,
+                          MIN_COLUMNS_PER_JOB, GDALFillNodataTopDown, &sCtxt );
 
 /* -------------------------------------------------------------------- */
 /*      Write out best index/value to working files.                    */
 /* -------------------------------------------------------------------- */
-        eErr = GDALRasterIO( hYBand, GF_Write, 0, iY, nXSize, 1,
-                             panThisY, nXSize, 1, GDT_UInt32, 0, 0 );
+        eErr = GDALRasterIO( hYBand, GF_Write, 0, nYOff, nXSize, nLines,
+                             sCtxt.panTopDownY, nXSize, nLines,
+                             GDT_UInt32, 0, 0 );
         if( eErr != CE_None )
             break;
 
-        eErr = GDALRasterIO( hValBand, GF_Write, 0, iY, nXSize, 1,
-                             pafThisValue, nXSize, 1, GDT_Float32, 0, 0 );
+        eErr = GDALRasterIO( hValBand, GF_Write, 0, nYOff, nXSize, nLines,
+                             sCtxt.pafTopDownValue, nXSize, nLines,
+                             GDT_Float32, 0, 0 );
         if( eErr != CE_None )
             break;
 
-/* -------------------------------------------------------------------- */
-/*      Flip this/last buffers.                                         */
-/* -------------------------------------------------------------------- */
-        std::swap(pafThisValue, pafLastValue);
-        std::swap(panThisY, panLastY);
-
 /* -------------------------------------------------------------------- */
 /*      report progress.                                                */
 /* -------------------------------------------------------------------- */
         if( eErr == CE_None &&
             !pfnProgress(
-                dfProgressRatio * (0.5*(iY+1) /
+                dfProgressRatio * (0.5*(nYOff+nLines) /
                                    static_cast<double>(nYSize)),
                 "Filling...", pProgressArg ) )
         {
@@ -672,190 +1014,90 @@ GDALFillNodata( GDALRasterBandH hTargetBand,
         }
     }
 
-    for( int iX = 0; iX < nXSize; iX++ )
-    {
-        panLastY[iX] = nNoDataVal;
-    }
+    std::fill(anLastY.begin(), anLastY.end(), nNoDataVal);
 
 /* ==================================================================== */
 /*      Now we will do collect similar this/last information from       */
 /*      bottom to top and use it in combination with the top to         */
 /*      bottom search info to interpolate.                              */
 /* ==================================================================== */
-    for( int iY = nYSize-1; iY >= 0 && eErr == CE_None; iY-- )
+    for( int iStripe = nStripes - 1; iStripe >= 0 && eErr == CE_None;
+         iStripe-- )
     {
+        const int nYOff = iStripe * nStripeLines;
+        const int nLines = std::min(nStripeLines, nYSize - nYOff);
+        sCtxt.nStripeYOff = nYOff;
+        sCtxt.nStripeLines = nLines;
+
         eErr =
-            GDALRasterIO( hMaskBand, GF_Read, 0, iY, nXSize, 1,
-                          pabyMask, nXSize, 1, GDT_Byte, 0, 0 );
+            GDALRasterIO( hMaskBand, GF_Read, 0, nYOff, nXSize, nLines,
+                          sCtxt.pabyMask, nXSize, nLines, GDT_Byte, 0, 0 );
 
         if( eErr != CE_None )
             break;
 
         eErr =
-            GDALRasterIO( hTargetBand, GF_Read, 0, iY, nXSize, 1,
-                          pafScanline, nXSize, 1, GDT_Float32, 0, 0 );
+            GDALRasterIO( hTargetBand, GF_Read, 0, nYOff, nXSize, nLines,
+                          sCtxt.pafScanline, nXSize, nLines,
+                          GDT_Float32, 0, 0 );
 
         if( eErr != CE_None )
             break;
 
-/* -------------------------------------------------------------------- */
-/*      Figure out the most recent pixel for each column.               */
-/* -------------------------------------------------------------------- */
-
-        for( int iX = 0; iX < nXSize; iX++ )
-        {
-            if( pabyMask[iX] )
-            {
-                pafThisValue[iX] = pafScanline[iX];
-                panThisY[iX] = iY;
-            }
-            else if( panLastY[iX] - iY <= dfMaxSearchDist )
-            {
-                pafThisValue[iX] = pafLastValue[iX];
-                panThisY[iX] = panLastY[iX];
-            }
-            else
-            {
-                panThisY[iX] = nNoDataVal;
-            }
-        }
-
 /* -------------------------------------------------------------------- */
 /*      Load the last y and corresponding value from the top down pass. */
 /* -------------------------------------------------------------------- */
         eErr =
-            GDALRasterIO( hYBand, GF_Read, 0, iY, nXSize, 1,
-                          panTopDownY, nXSize, 1, GDT_UInt32, 0, 0 );
+            GDALRasterIO( hYBand, GF_Read, 0, nYOff, nXSize, nLines,
+                          sCtxt.panTopDownY, nXSize, nLines,
+                          GDT_UInt32, 0, 0 );
 
         if( eErr != CE_None )
             break;
 
         eErr =
-            GDALRasterIO( hValBand, GF_Read, 0, iY, nXSize, 1,
-                          pafTopDownValue, nXSize, 1, GDT_Float32, 0, 0 );
+            GDALRasterIO( hValBand, GF_Read, 0, nYOff, nXSize, nLines,
+                          sCtxt.pafTopDownValue, nXSize, nLines,
+                          GDT_Float32, 0, 0 );
 
         if( eErr != CE_None )
             break;
 
 /* -------------------------------------------------------------------- */
-/*      Attempt to interpolate any pixels that are nodata.              */
+/*      Figure out the most recent pixel for each column, then          */
+/*      interpolate the nodata pixels of each line.                     */
 /* -------------------------------------------------------------------- */
-        memset( pabyFiltMask, 0, nXSize );
-        for( int iX = 0; iX < nXSize; iX++ )
-        {
-            int nThisMaxSearchDist = nMaxSearchDist;
-
-            // If this was a valid target - no change.
-            if( pabyMask[iX] )
-                continue;
+        GDALRunRangeJobs( poJobQueue.get(), nThreads, nXSize,
+                          MIN_COLUMNS_PER_JOB, GDALFillNodataBottomUp, &sCtxt );
 
-            // Quadrants 0:topleft, 1:bottomleft, 2:topright, 3:bottomright
-            double adfQuadDist[4] = {};
-            float fQuadValue[4] = {};
-
-            for( int iQuad = 0; iQuad < 4; iQuad++ )
-            {
-                adfQuadDist[iQuad] = dfMaxSearchDist + 1.0;
-                fQuadValue[iQuad] = 0.0;
-            }
-
-            // Step left and right by one pixel searching for the closest
-            // target value for each quadrant.
-            for( int iStep = 0; iStep <= nThisMaxSearchDist; iStep++ )
-            {
-                const int iLeftX = std::max(0, iX - iStep);
-                const int iRightX = std::min(nXSize - 1, iX + iStep);
-
-                // Top left includes current line.
-                QUAD_CHECK(adfQuadDist[0], fQuadValue[0],
-                           iLeftX, panTopDownY[iLeftX], iX, iY,
-                           pafTopDownValue[iLeftX], nNoDataVal );
-
-                // Bottom left.
-                QUAD_CHECK(adfQuadDist[1], fQuadValue[1],
-                           iLeftX, panLastY[iLeftX], iX, iY,
-                           pafLastValue[iLeftX], nNoDataVal );
-
-                // Top right and bottom right do no include center pixel.
-                if( iStep == 0 )
-                     continue;
-
-                // Top right includes current line.
-                QUAD_CHECK(adfQuadDist[2], fQuadValue[2],
-                           iRightX, panTopDownY[iRightX], iX, iY,
-                           pafTopDownValue[iRightX], nNoDataVal );
-
-                // Bottom right.
-                QUAD_CHECK(adfQuadDist[3], fQuadValue[3],
-                           iRightX, panLastY[iRightX], iX, iY,
-                           pafLastValue[iRightX], nNoDataVal );
-
-                // Every four steps, recompute maximum distance.
-                if( (iStep & 0x3) == 0 )
-                    nThisMaxSearchDist = static_cast<int>(floor(
-                        std::max(std::max(adfQuadDist[0], adfQuadDist[1]),
-                                 std::max(adfQuadDist[2], adfQuadDist[3]))));
-            }
-
-            double dfWeightSum = 0.0;
-            double dfValueSum = 0.0;
-            bool bHasSrcValues = false;
-
-            for( int iQuad = 0; iQuad < 4; iQuad++ )
-            {
-                if( adfQuadDist[iQuad] <= dfMaxSearchDist )
-                {
-                    const double dfWeight = 1.0 / adfQuadDist[iQuad];
-
-                    bHasSrcValues = dfWeight != 0;
-                    if( !bHasNoData || fQuadValue[iQuad] != fNoData )
-                    {
-                        dfWeightSum += dfWeight;
-                        dfValueSum += fQuadValue[iQuad] * dfWeight;
-                    }
-                }
-            }
-
-            if( bHasSrcValues )
-            {
-                pabyMask[iX] = 255;
-                pabyFiltMask[iX] = 255;
-                if( dfWeightSum > 0.0 )
-                    pafScanline[iX] = static_cast<float>(dfValueSum / dfWeightSum);
-                else
-                    pafScanline[iX] = fNoData;
-            }
-        }
+        GDALRunRangeJobs( poJobQueue.get(), nThreads, nLines, 1,
+                          GDALFillNodataInterpolate, &sCtxt );
 
 /* -------------------------------------------------------------------- */
 /*      Write out the updated data and mask information.                */
 /* -------------------------------------------------------------------- */
         eErr =
-            GDALRasterIO( hTargetBand, GF_Write, 0, iY, nXSize, 1,
-                          pafScanline, nXSize, 1, GDT_Float32, 0, 0 );
+            GDALRasterIO( hTargetBand, GF_Write, 0, nYOff, nXSize, nLines,
+                          sCtxt.pafScanline, nXSize, nLines,
+                          GDT_Float32, 0, 0 );
 
         if( eErr != CE_None )
             break;
 
         eErr =
-            GDALRasterIO( hFiltMaskBand, GF_Write, 0, iY, nXSize, 1,
-                          pabyFiltMask, nXSize, 1, GDT_Byte, 0, 0 );
+            GDALRasterIO( hFiltMaskBand, GF_Write, 0, nYOff, nXSize, nLines,
+                          sCtxt.pabyFiltMask, nXSize, nLines,
+                          GDT_Byte, 0, 0 );
 
         if( eErr != CE_None )
             break;
 
-/* -------------------------------------------------------------------- */
-/*      Flip this/last buffers.                                         */
-/* -------------------------------------------------------------------- */
-        std::swap(pafThisValue, pafLastValue);
-        std::swap(panThisY, panLastY);
-
 /* -------------------------------------------------------------------- */
 /*      report progress.                                                */
 /* -------------------------------------------------------------------- */
         if( eErr == CE_None &&
             !pfnProgress(
-                dfProgressRatio*(0.5+0.5*(nYSize-iY) /
+                dfProgressRatio*(0.5+0.5*(nYSize-nYOff) /
                                  static_cast<double>(nYSize)),
                 "Filling...", pProgressArg) )
         {
@@ -879,6 +1121,7 @@ GDALFillNodata( GDALRasterBandH hTargetBand,
 
         eErr = GDALMultiFilter( hTargetBand, hMaskBand, hFiltMaskBand,
                                 nSmoothingIterations,
+                                poJobQueue.get(), nThreads,
                                 GDALScaledProgress, pScaledProgress );
 
         GDALDestroyScaledProgress( pScaledProgress );
@@ -888,16 +1131,6 @@ GDALFillNodata( GDALRasterBandH hTargetBand,
 /*      Close and clean up temporary files. Free working buffers        */
 /* -------------------------------------------------------------------- */
 end:
-    CPLFree(panLastY);
-    CPLFree(panThisY);
-    CPLFree(panTopDownY);
-    CPLFree(pafLastValue);
-    CPLFree(pafThisValue);
-    CPLFree(pafTopDownValue);
-    CPLFree(pafScanline);
-    CPLFree(pabyMask);
-    CPLFree(pabyFiltMask);
-
     GDALClose( hYDS );
     GDALClose( hValDS );
     GDALClose( hFiltMaskDS );
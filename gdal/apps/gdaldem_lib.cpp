@@ -101,12 +101,18 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
+#include <climits>
+#include <deque>
 #include <limits>
+#include <memory>
+#include <vector>
 
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
 
@@ -155,6 +161,7 @@ struct GDALDEMProcessingOptions
     bool bMultiDirectional;
     char** papszCreateOptions;
     int nBand;
+    int nNumThreads;
 };
 
 /************************************************************************/
@@ -274,6 +281,520 @@ GInt32 INTERPOL(GInt32 a, GInt32 b, int bSrcHasNoData, GInt32 fSrcNoDataValue)
     return nVal;
 }
 
+/************************************************************************/
+/*                  GDALGeneric3x3ProcessingParams                      */
+/************************************************************************/
+
+// Settings shared by all the lines (and all the threads) of a 3x3
+// processing.
+template<class T>
+struct GDALGeneric3x3ProcessingParams
+{
+    int nXSize;
+    int nYSize;
+    typename GDALGeneric3x3ProcessingAlg<T>::type pfnAlg;
+    typename GDALGeneric3x3ProcessingAlg_multisample<T>::type pfnAlg_multisample;
+    void* pData;
+    bool bComputeAtEdges;
+    bool bSrcHasNoData;
+    bool bIsSrcNoDataNan;
+    T fSrcNoDataValue;
+    float fDstNoDataValue;
+};
+
+/************************************************************************/
+/*                     GDALGeneric3x3LineHasNoData()                    */
+/************************************************************************/
+
+template<class T>
+static bool GDALGeneric3x3LineHasNoData(
+    const GDALGeneric3x3ProcessingParams<T>& sParams, const T* pafLine );
+
+template<>
+bool GDALGeneric3x3LineHasNoData(
+    const GDALGeneric3x3ProcessingParams<GInt32>& sParams,
+    const GInt32* pafLine )
+{
+    if( !sParams.bSrcHasNoData )
+        return false;
+    const GInt32 fSrcNoDataValue = sParams.fSrcNoDataValue;
+    const int nXSize = sParams.nXSize;
+    int iX = 0;
+    for( ; iX + 3 < nXSize; iX +=4 )
+    {
+        if( pafLine[iX] == fSrcNoDataValue ||
+            pafLine[iX + 1] == fSrcNoDataValue ||
+            pafLine[iX + 2] == fSrcNoDataValue ||
+            pafLine[iX + 3] == fSrcNoDataValue )
+        {
+            return true;
+        }
+    }
+    for( ; iX < nXSize; iX++ )
+    {
+        if( pafLine[iX] == fSrcNoDataValue )
+            return true;
+    }
+    return false;
+}
+
+template<>
+bool GDALGeneric3x3LineHasNoData(
+    const GDALGeneric3x3ProcessingParams<float>& sParams,
+    const float* pafLine )
+{
+    if( !sParams.bSrcHasNoData )
+        return false;
+    const float fSrcNoDataValue = sParams.fSrcNoDataValue;
+    const int nXSize = sParams.nXSize;
+    for( int iX = 0; iX < nXSize; iX++ )
+    {
+        // Same test as in ComputeVal()
+        if( (!sParams.bIsSrcNoDataNan &&
+             ARE_REAL_EQUAL(pafLine[iX], fSrcNoDataValue)) ||
+            (sParams.bIsSrcNoDataNan && CPLIsNan(pafLine[iX])) )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                    GDALGeneric3x3ProcessFirstLine()                  */
+/************************************************************************/
+
+// Computes the first line of the output from the first 2 lines of the
+// source (pafLine2 may be null if the raster has a single line).
+template<class T>
+static void GDALGeneric3x3ProcessFirstLine(
+    const GDALGeneric3x3ProcessingParams<T>& sParams,
+    const T* pafLine1, const T* pafLine2, float* pafOutputBuf )
+{
+    const int nXSize = sParams.nXSize;
+    if( !(sParams.bComputeAtEdges && nXSize >= 2 && sParams.nYSize >= 2) )
+    {
+        // Exclude the edges
+        for( int j = 0; j < nXSize; j++ )
+        {
+            pafOutputBuf[j] = sParams.fDstNoDataValue;
+        }
+        return;
+    }
+
+    const bool bSrcHasNoData = sParams.bSrcHasNoData;
+    const T fSrcNoDataValue = sParams.fSrcNoDataValue;
+    for( int j = 0; j < nXSize; j++ )
+    {
+        int jmin = (j == 0) ? j : j - 1;
+        int jmax = (j == nXSize - 1) ? j : j + 1;
+
+        T afWin[9] = {
+            INTERPOL(pafLine1[jmin], pafLine2[jmin],
+                     bSrcHasNoData, fSrcNoDataValue),
+            INTERPOL(pafLine1[j],    pafLine2[j],
+                     bSrcHasNoData, fSrcNoDataValue),
+            INTERPOL(pafLine1[jmax], pafLine2[jmax],
+                     bSrcHasNoData, fSrcNoDataValue),
+            pafLine1[jmin],
+            pafLine1[j],
+            pafLine1[jmax],
+            pafLine2[jmin],
+            pafLine2[j],
+            pafLine2[jmax]
+        };
+        pafOutputBuf[j] = ComputeVal(
+            bSrcHasNoData,
+            fSrcNoDataValue,
+            sParams.bIsSrcNoDataNan,
+            afWin, sParams.fDstNoDataValue,
+            sParams.pfnAlg, sParams.pData, sParams.bComputeAtEdges);
+    }
+}
+
+/************************************************************************/
+/*                    GDALGeneric3x3ProcessLastLine()                   */
+/************************************************************************/
+
+// Computes the last line of the output from the last 2 lines of the
+// source.
+template<class T>
+static void GDALGeneric3x3ProcessLastLine(
+    const GDALGeneric3x3ProcessingParams<T>& sParams,
+    const T* pafLine1, const T* pafLine2, float* pafOutputBuf )
+{
+    const int nXSize = sParams.nXSize;
+    if( !(sParams.bComputeAtEdges && nXSize >= 2 && sParams.nYSize >= 2) )
+    {
+        // Exclude the edges
+        for( int j = 0; j < nXSize; j++ )
+        {
+            pafOutputBuf[j] = sParams.fDstNoDataValue;
+        }
+        return;
+    }
+
+    const bool bSrcHasNoData = sParams.bSrcHasNoData;
+    const T fSrcNoDataValue = sParams.fSrcNoDataValue;
+    for( int j = 0; j < nXSize; j++ )
+    {
+        int jmin = (j == 0) ? j : j - 1;
+        int jmax = (j == nXSize - 1) ? j : j + 1;
+
+        T afWin[9] = {
+            pafLine1[jmin],
+            pafLine1[j],
+            pafLine1[jmax],
+            pafLine2[jmin],
+            pafLine2[j],
+            pafLine2[jmax],
+            INTERPOL(pafLine2[jmin], pafLine1[jmin],
+                     bSrcHasNoData, fSrcNoDataValue),
+            INTERPOL(pafLine2[j], pafLine1[j],
+                     bSrcHasNoData, fSrcNoDataValue),
+            INTERPOL(pafLine2[jmax], pafLine1[jmax],
+                     bSrcHasNoData, fSrcNoDataValue),
+        };
+
+        pafOutputBuf[j] = ComputeVal(
+            bSrcHasNoData,
+            fSrcNoDataValue,
+            sParams.bIsSrcNoDataNan,
+            afWin, sParams.fDstNoDataValue,
+            sParams.pfnAlg, sParams.pData, sParams.bComputeAtEdges);
+    }
+}
+
+/************************************************************************/
+/*                      GDALGeneric3x3ProcessLine()                     */
+/************************************************************************/
+
+// Computes a line of the output that is neither the first nor the last
+// one, from the source lines above, at and below it, found at the
+// nLine1Off, nLine2Off and nLine3Off offsets of pafThreeLineWin.
+template<class T>
+static void GDALGeneric3x3ProcessLine(
+    const GDALGeneric3x3ProcessingParams<T>& sParams,
+    const T* pafThreeLineWin,
+    int nLine1Off, int nLine2Off, int nLine3Off,
+    bool bOneOfThreeLinesHasNoData,
+    float* pafOutputBuf )
+{
+    const int nXSize = sParams.nXSize;
+    const bool bSrcHasNoData = sParams.bSrcHasNoData;
+    const T fSrcNoDataValue = sParams.fSrcNoDataValue;
+
+    if( sParams.bComputeAtEdges && nXSize >= 2 )
+    {
+        int j = 0;
+        T afWin[9] = {
+            INTERPOL(pafThreeLineWin[nLine1Off + j],
+                     pafThreeLineWin[nLine1Off + j+1],
+                     bSrcHasNoData, fSrcNoDataValue),
+            pafThreeLineWin[nLine1Off + j],
+            pafThreeLineWin[nLine1Off + j+1],
+            INTERPOL(pafThreeLineWin[nLine2Off + j],
+                     pafThreeLineWin[nLine2Off + j+1],
+                     bSrcHasNoData, fSrcNoDataValue),
+            pafThreeLineWin[nLine2Off + j],
+            pafThreeLineWin[nLine2Off + j+1],
+            INTERPOL(pafThreeLineWin[nLine3Off + j],
+                     pafThreeLineWin[nLine3Off + j+1],
+                     bSrcHasNoData, fSrcNoDataValue),
+            pafThreeLineWin[nLine3Off + j],
+            pafThreeLineWin[nLine3Off + j+1]
+        };
+
+        pafOutputBuf[j] =
+            ComputeVal(
+                bOneOfThreeLinesHasNoData,
+                fSrcNoDataValue,
+                sParams.bIsSrcNoDataNan,
+                afWin, sParams.fDstNoDataValue,
+                sParams.pfnAlg, sParams.pData, sParams.bComputeAtEdges);
+    }
+    else
+    {
+        // Exclude the edges
+        pafOutputBuf[0] = sParams.fDstNoDataValue;
+    }
+
+    int j = 1;
+    if( sParams.pfnAlg_multisample && !bOneOfThreeLinesHasNoData )
+    {
+        j = sParams.pfnAlg_multisample(pafThreeLineWin,
+                                       nLine1Off,
+                                       nLine2Off,
+                                       nLine3Off,
+                                       nXSize,
+                                       sParams.pData,
+                                       pafOutputBuf);
+    }
+
+    for( ; j < nXSize - 1; j++ )
+    {
+        T afWin[9] = {
+            pafThreeLineWin[nLine1Off + j-1],
+            pafThreeLineWin[nLine1Off + j],
+            pafThreeLineWin[nLine1Off + j+1],
+            pafThreeLineWin[nLine2Off + j-1],
+            pafThreeLineWin[nLine2Off + j],
+            pafThreeLineWin[nLine2Off + j+1],
+            pafThreeLineWin[nLine3Off + j-1],
+            pafThreeLineWin[nLine3Off + j],
+            pafThreeLineWin[nLine3Off + j+1]
+        };
+
+        pafOutputBuf[j] =
+            ComputeVal(
+                bOneOfThreeLinesHasNoData,
+                fSrcNoDataValue,
+                sParams.bIsSrcNoDataNan,
+                afWin, sParams.fDstNoDataValue,
+                sParams.pfnAlg, sParams.pData, sParams.bComputeAtEdges);
+    }
+
+    if( sParams.bComputeAtEdges && nXSize >= 2 )
+    {
+        j = nXSize - 1;
+
+        T afWin[9] = {
+            pafThreeLineWin[nLine1Off + j-1],
+            pafThreeLineWin[nLine1Off + j],
+            INTERPOL(pafThreeLineWin[nLine1Off + j],
+                     pafThreeLineWin[nLine1Off + j-1],
+                     bSrcHasNoData, fSrcNoDataValue),
+            pafThreeLineWin[nLine2Off + j-1],
+            pafThreeLineWin[nLine2Off + j],
+            INTERPOL(pafThreeLineWin[nLine2Off + j],
+                     pafThreeLineWin[nLine2Off + j-1],
+                     bSrcHasNoData, fSrcNoDataValue),
+            pafThreeLineWin[nLine3Off + j-1],
+            pafThreeLineWin[nLine3Off + j],
+            INTERPOL(pafThreeLineWin[nLine3Off + j],
+                     pafThreeLineWin[nLine3Off + j-1],
+                     bSrcHasNoData, fSrcNoDataValue)
+        };
+
+        pafOutputBuf[j] =
+            ComputeVal(
+                bOneOfThreeLinesHasNoData,
+                fSrcNoDataValue,
+                sParams.bIsSrcNoDataNan,
+                afWin, sParams.fDstNoDataValue,
+                sParams.pfnAlg, sParams.pData, sParams.bComputeAtEdges);
+    }
+    else
+    {
+        // Exclude the edges
+        if( nXSize > 1 )
+            pafOutputBuf[nXSize - 1] = sParams.fDstNoDataValue;
+    }
+}
+
+/************************************************************************/
+/*                      GDALGeneric3x3StripeJob                         */
+/************************************************************************/
+
+// A stripe of output lines computed by a worker thread. The source lines
+// of the stripe, plus the line above and below it when they exist, are
+// read by the calling thread, which also writes the output lines.
+template<class T>
+struct GDALGeneric3x3StripeJob
+{
+    const GDALGeneric3x3ProcessingParams<T>* psParams = nullptr;
+    int                 nYOff = 0;
+    int                 nYCount = 0;
+    int                 nSrcYOff = 0;
+    int                 nSrcYCount = 0;
+    T*                  pafSrc = nullptr;
+    float*              pafOutputBuf = nullptr;
+    std::atomic<bool>   bFinished{false};
+
+    GDALGeneric3x3StripeJob() = default;
+    ~GDALGeneric3x3StripeJob()
+    {
+        VSIFree(pafSrc);
+        VSIFree(pafOutputBuf);
+    }
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALGeneric3x3StripeJob)
+
+    static void Process( void* pData );
+};
+
+template<class T>
+void GDALGeneric3x3StripeJob<T>::Process( void* pData )
+{
+    GDALGeneric3x3StripeJob<T>* psJob =
+        static_cast<GDALGeneric3x3StripeJob<T>*>(pData);
+    const GDALGeneric3x3ProcessingParams<T>& sParams = *(psJob->psParams);
+    const int nXSize = sParams.nXSize;
+    const int nYSize = sParams.nYSize;
+    const T* pafSrc = psJob->pafSrc;
+
+    // In case none of the 3 lines have nodata values, then no need to
+    // check it in ComputeVal()
+    std::vector<bool> abLineHasNoDataValue(psJob->nSrcYCount);
+    for( int i = 0; i < psJob->nSrcYCount; i++ )
+    {
+        abLineHasNoDataValue[i] = GDALGeneric3x3LineHasNoData(
+            sParams, pafSrc + static_cast<size_t>(i) * nXSize);
+    }
+
+    for( int iY = psJob->nYOff; iY < psJob->nYOff + psJob->nYCount; iY++ )
+    {
+        const int i = iY - psJob->nSrcYOff;
+        float* pafOutputBuf = psJob->pafOutputBuf +
+            static_cast<size_t>(iY - psJob->nYOff) * nXSize;
+        if( iY == 0 )
+        {
+            GDALGeneric3x3ProcessFirstLine(
+                sParams, pafSrc,
+                nYSize >= 2 ? pafSrc + nXSize : nullptr,
+                pafOutputBuf);
+        }
+        else if( iY == nYSize - 1 )
+        {
+            GDALGeneric3x3ProcessLastLine(
+                sParams,
+                pafSrc + static_cast<size_t>(i - 1) * nXSize,
+                pafSrc + static_cast<size_t>(i) * nXSize,
+                pafOutputBuf);
+        }
+        else
+        {
+            GDALGeneric3x3ProcessLine(
+                sParams, pafSrc,
+                (i - 1) * nXSize, i * nXSize, (i + 1) * nXSize,
+                abLineHasNoDataValue[i - 1] ||
+                abLineHasNoDataValue[i] ||
+                abLineHasNoDataValue[i + 1],
+                pafOutputBuf);
+        }
+    }
+
+    psJob->bFinished = true;
+}
+
+/************************************************************************/
+/*               GDALGeneric3x3ProcessingMultiThreaded()                */
+/************************************************************************/
+
+// Splits the raster in horizontal stripes that are computed by nThreads
+// threads of poPool, and written in order.
+template<class T>
+static
+CPLErr GDALGeneric3x3ProcessingMultiThreaded(
+    const GDALGeneric3x3ProcessingParams<T>& sParams,
+    GDALRasterBandH hSrcBand,
+    GDALRasterBandH hDstBand,
+    GDALDataType eReadDT,
+    CPLWorkerThreadPool* poPool,
+    int nThreads,
+    GDALProgressFunc pfnProgress,
+    void *pProgressData )
+{
+    const int nXSize = sParams.nXSize;
+    const int nYSize = sParams.nYSize;
+
+    // A few stripes per thread, so that reading, computing and writing
+    // overlap, but not too small, as the lines above and below each
+    // stripe are read twice. Line offsets in a stripe must fit in an int.
+    int nStripeHeight = std::max(16, std::min(256,
+                            DIV_ROUND_UP(nYSize, 4 * nThreads)));
+    nStripeHeight = std::max(1, std::min(nStripeHeight,
+                                         INT_MAX / nXSize - 2));
+    // Allow computation of a few stripes to be in advance over writing,
+    // while bounding memory usage.
+    const size_t nMaxPendingJobs = 2 * static_cast<size_t>(nThreads);
+
+    std::deque<std::unique_ptr<GDALGeneric3x3StripeJob<T>>> apoJobs;
+    // Declared after apoJobs, so that it waits for the jobs before their
+    // buffers are freed in case of early exit.
+    auto poJobQueue = poPool->CreateJobQueue(nThreads);
+
+    const auto WriteFinishedJobs = [&](size_t nMaxRemainingJobs)
+    {
+        while( !apoJobs.empty() )
+        {
+            const GDALGeneric3x3StripeJob<T>* psJob = apoJobs.front().get();
+            if( !psJob->bFinished )
+            {
+                if( apoJobs.size() <= nMaxRemainingJobs )
+                    break;
+                poJobQueue->WaitEvent();
+                continue;
+            }
+
+            const CPLErr eErr = GDALRasterIO(hDstBand, GF_Write,
+                                   0, psJob->nYOff, nXSize, psJob->nYCount,
+                                   psJob->pafOutputBuf,
+                                   nXSize, psJob->nYCount,
+                                   GDT_Float32, 0, 0);
+            if( eErr != CE_None )
+                return eErr;
+
+            if( !pfnProgress( 1.0 * (psJob->nYOff + psJob->nYCount) / nYSize,
+                              nullptr, pProgressData ) )
+            {
+                CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+                return CE_Failure;
+            }
+            apoJobs.pop_front();
+        }
+        return CE_None;
+    };
+
+    CPLErr eErr = CE_None;
+    for( int nYOff = 0; eErr == CE_None && nYOff < nYSize;
+         nYOff += nStripeHeight )
+    {
+        std::unique_ptr<GDALGeneric3x3StripeJob<T>> poJob(
+            new GDALGeneric3x3StripeJob<T>());
+        poJob->psParams = &sParams;
+        poJob->nYOff = nYOff;
+        poJob->nYCount = std::min(nStripeHeight, nYSize - nYOff);
+        poJob->nSrcYOff = std::max(0, nYOff - 1);
+        poJob->nSrcYCount =
+            std::min(nYSize, nYOff + poJob->nYCount + 1) - poJob->nSrcYOff;
+        poJob->pafSrc = static_cast<T*>(VSI_MALLOC3_VERBOSE(
+            sizeof(T), nXSize, poJob->nSrcYCount));
+        poJob->pafOutputBuf = static_cast<float*>(VSI_MALLOC3_VERBOSE(
+            sizeof(float), nXSize, poJob->nYCount));
+        if( poJob->pafSrc == nullptr || poJob->pafOutputBuf == nullptr )
+        {
+            eErr = CE_Failure;
+            break;
+        }
+
+        eErr = GDALRasterIO(hSrcBand, GF_Read,
+                            0, poJob->nSrcYOff, nXSize, poJob->nSrcYCount,
+                            poJob->pafSrc, nXSize, poJob->nSrcYCount,
+                            eReadDT, 0, 0);
+        if( eErr != CE_None )
+            break;
+
+        if( !poJobQueue->SubmitJob(GDALGeneric3x3StripeJob<T>::Process,
+                                   poJob.get()) )
+        {
+            eErr = CE_Failure;
+            break;
+        }
+        apoJobs.push_back(std::move(poJob));
+
+        eErr = WriteFinishedJobs(nMaxPendingJobs);
+    }
+
+    if( eErr == CE_None )
+        eErr = WriteFinishedJobs(0);
+    else
+        // Make sure no job still references the buffers.
+        poJobQueue->WaitCompletion();
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                  GDALGeneric3x3Processing()                          */
 /************************************************************************/
@@ -287,6 +808,7 @@ CPLErr GDALGeneric3x3Processing(
     typename GDALGeneric3x3ProcessingAlg_multisample<T>::type pfnAlg_multisample,
     void *pData,
     bool bComputeAtEdges,
+    int nNumThreads,
     GDALProgressFunc pfnProgress,
     void *pProgressData )
 {
@@ -305,19 +827,6 @@ CPLErr GDALGeneric3x3Processing(
     const int nXSize = GDALGetRasterBandXSize(hSrcBand);
     const int nYSize = GDALGetRasterBandYSize(hSrcBand);
 
-    // 1 line destination buffer.
-    float *pafOutputBuf = static_cast<float *>(
-        VSI_MALLOC2_VERBOSE(sizeof(float), nXSize));
-    // 3 line rotating source buffer.
-    T *pafThreeLineWin  = static_cast<T *>(
-        VSI_MALLOC2_VERBOSE(3 * sizeof(T), nXSize + 1));
-    if( pafOutputBuf == nullptr || pafThreeLineWin == nullptr )
-    {
-        VSIFree(pafOutputBuf);
-        VSIFree(pafThreeLineWin);
-        return CE_Failure;
-    }
-
     GDALDataType eReadDT;
     int bSrcHasNoData = FALSE;
     const double dfNoDataValue =
@@ -365,6 +874,46 @@ CPLErr GDALGeneric3x3Processing(
     if( !bDstHasNoData )
         fDstNoDataValue = 0.0;
 
+    GDALGeneric3x3ProcessingParams<T> sParams;
+    sParams.nXSize = nXSize;
+    sParams.nYSize = nYSize;
+    sParams.pfnAlg = pfnAlg;
+    sParams.pfnAlg_multisample = pfnAlg_multisample;
+    sParams.pData = pData;
+    sParams.bComputeAtEdges = bComputeAtEdges;
+    sParams.bSrcHasNoData = CPL_TO_BOOL(bSrcHasNoData);
+    sParams.bIsSrcNoDataNan = CPL_TO_BOOL(bIsSrcNoDataNan);
+    sParams.fSrcNoDataValue = fSrcNoDataValue;
+    sParams.fDstNoDataValue = fDstNoDataValue;
+
+    if( nNumThreads > 1 && nYSize > 2 )
+    {
+        CPLWorkerThreadPool* poPool = CPLGetGlobalWorkerThreadPool(nNumThreads);
+        if( poPool && poPool->GetThreadCount() > 1 )
+        {
+            CPLErr eErr = GDALGeneric3x3ProcessingMultiThreaded(
+                sParams, hSrcBand, hDstBand, eReadDT, poPool,
+                std::min(nNumThreads, poPool->GetThreadCount()),
+                pfnProgress, pProgressData);
+            if( eErr == CE_None )
+                pfnProgress( 1.0, nullptr, pProgressData );
+            return eErr;
+        }
+    }
+
+    // 1 line destination buffer.
+    float *pafOutputBuf = static_cast<float *>(
+        VSI_MALLOC2_VERBOSE(sizeof(float), nXSize));
+    // 3 line rotating source buffer.
+    T *pafThreeLineWin  = static_cast<T *>(
+        VSI_MALLOC2_VERBOSE(3 * sizeof(T), nXSize + 1));
+    if( pafOutputBuf == nullptr || pafThreeLineWin == nullptr )
+    {
+        VSIFree(pafOutputBuf);
+        VSIFree(pafThreeLineWin);
+        return CE_Failure;
+    }
+
     int nLine1Off = 0;
     int nLine2Off = nXSize;
     int nLine3Off = 2*nXSize;
@@ -402,72 +951,18 @@ CPLErr GDALGeneric3x3Processing(
 
             return CE_Failure;
         }
-        if( std::numeric_limits<T>::is_integer && bSrcHasNoData )
-        {
-            abLineHasNoDataValue[i] = false;
-            for( int iX = 0; iX < nXSize; iX++ )
-            {
-                if( pafThreeLineWin[i * nXSize + iX] == fSrcNoDataValue )
-                {
-                    abLineHasNoDataValue[i] = true;
-                    break;
-                }
-            }
-        }
+        abLineHasNoDataValue[i] =
+            GDALGeneric3x3LineHasNoData(sParams, pafThreeLineWin + i * nXSize);
       }
     }  // End extra scope for VC12
 
-    CPLErr eErr = CE_None;
-    if( bComputeAtEdges && nXSize >= 2 && nYSize >= 2 )
-    {
-        for( int j = 0; j < nXSize; j++ )
-        {
-            int jmin = (j == 0) ? j : j - 1;
-            int jmax = (j == nXSize - 1) ? j : j + 1;
-
-            T afWin[9] = {
-                INTERPOL(pafThreeLineWin[jmin], pafThreeLineWin[nXSize + jmin],
-                         bSrcHasNoData, fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[j],    pafThreeLineWin[nXSize + j],
-                         bSrcHasNoData, fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[jmax], pafThreeLineWin[nXSize + jmax],
-                         bSrcHasNoData, fSrcNoDataValue),
-                pafThreeLineWin[jmin],
-                pafThreeLineWin[j],
-                pafThreeLineWin[jmax],
-                pafThreeLineWin[nXSize + jmin],
-                pafThreeLineWin[nXSize + j],
-                pafThreeLineWin[nXSize + jmax]
-            };
-            pafOutputBuf[j] = ComputeVal(
-                CPL_TO_BOOL(bSrcHasNoData),
-                fSrcNoDataValue,
-                CPL_TO_BOOL(bIsSrcNoDataNan),
-                afWin, fDstNoDataValue,
-                pfnAlg, pData, bComputeAtEdges);
-        }
-        eErr = GDALRasterIO(hDstBand, GF_Write,
-                    0, 0, nXSize, 1,
-                    pafOutputBuf, nXSize, 1, GDT_Float32, 0, 0);
-    }
-    else
-    {
-        // Exclude the edges
-        for( int j = 0; j < nXSize; j++ )
-        {
-            pafOutputBuf[j] = fDstNoDataValue;
-        }
-        eErr = GDALRasterIO(hDstBand, GF_Write,
-                    0, 0, nXSize, 1,
-                    pafOutputBuf, nXSize, 1, GDT_Float32, 0, 0);
-
-        if( eErr == CE_None && nYSize > 1 )
-        {
-            eErr = GDALRasterIO(hDstBand, GF_Write,
-                        0, nYSize - 1, nXSize, 1,
-                        pafOutputBuf, nXSize, 1, GDT_Float32, 0, 0);
-        }
-    }
+    GDALGeneric3x3ProcessFirstLine(sParams,
+                                   pafThreeLineWin,
+                                   pafThreeLineWin + nXSize,
+                                   pafOutputBuf);
+    CPLErr eErr = GDALRasterIO(hDstBand, GF_Write,
+                               0, 0, nXSize, 1,
+                               pafOutputBuf, nXSize, 1, GDT_Float32, 0, 0);
     if( eErr != CE_None )
     {
         CPLFree(pafOutputBuf);
@@ -498,145 +993,16 @@ CPLErr GDALGeneric3x3Processing(
 
         // In case none of the 3 lines have nodata values, then no need to
         // check it in ComputeVal()
-        bool bOneOfThreeLinesHasNoData = CPL_TO_BOOL(bSrcHasNoData);
-        if( std::numeric_limits<T>::is_integer && bSrcHasNoData )
-        {
-            bool bLastLineHasNoDataValue = false;
-            int iX = 0;
-            for( ; iX + 3 < nXSize; iX +=4 )
-            {
-                if( pafThreeLineWin[nLine3Off + iX] == fSrcNoDataValue ||
-                    pafThreeLineWin[nLine3Off + iX + 1] == fSrcNoDataValue ||
-                    pafThreeLineWin[nLine3Off + iX + 2] == fSrcNoDataValue ||
-                    pafThreeLineWin[nLine3Off + iX + 3] == fSrcNoDataValue )
-                {
-                    bLastLineHasNoDataValue = true;
-                    break;
-                }
-            }
-            if( !bLastLineHasNoDataValue )
-            {
-                for( ; iX < nXSize; iX++ )
-                {
-                    if( pafThreeLineWin[nLine3Off + iX] == fSrcNoDataValue )
-                    {
-                        bLastLineHasNoDataValue = true;
-                    }
-                }
-            }
-            abLineHasNoDataValue[nLine3Off / nXSize] = bLastLineHasNoDataValue;
-
-            bOneOfThreeLinesHasNoData = abLineHasNoDataValue[0] ||
-                                abLineHasNoDataValue[1] ||
-                                abLineHasNoDataValue[2];
-        }
-
-        if( bComputeAtEdges && nXSize >= 2 )
-        {
-            int j = 0;
-            T afWin[9] = {
-                INTERPOL(pafThreeLineWin[nLine1Off + j],
-                         pafThreeLineWin[nLine1Off + j+1],
-                         bSrcHasNoData, fSrcNoDataValue),
-                pafThreeLineWin[nLine1Off + j],
-                pafThreeLineWin[nLine1Off + j+1],
-                INTERPOL(pafThreeLineWin[nLine2Off + j],
-                         pafThreeLineWin[nLine2Off + j+1],
-                         bSrcHasNoData, fSrcNoDataValue),
-                pafThreeLineWin[nLine2Off + j],
-                pafThreeLineWin[nLine2Off + j+1],
-                INTERPOL(pafThreeLineWin[nLine3Off + j],
-                         pafThreeLineWin[nLine3Off + j+1],
-                         bSrcHasNoData, fSrcNoDataValue),
-                pafThreeLineWin[nLine3Off + j],
-                pafThreeLineWin[nLine3Off + j+1]
-            };
-
-            pafOutputBuf[j] =
-                ComputeVal(
-                    CPL_TO_BOOL(bOneOfThreeLinesHasNoData),
-                    fSrcNoDataValue,
-                    CPL_TO_BOOL(bIsSrcNoDataNan),
-                    afWin, fDstNoDataValue,
-                    pfnAlg, pData, bComputeAtEdges);
-        }
-        else
-        {
-            // Exclude the edges
-            pafOutputBuf[0] = fDstNoDataValue;
-        }
-
-        int j = 1;
-        if( pfnAlg_multisample && !bOneOfThreeLinesHasNoData )
-        {
-            j = pfnAlg_multisample(pafThreeLineWin,
-                                   nLine1Off,
-                                   nLine2Off,
-                                   nLine3Off,
-                                   nXSize,
-                                   pData,
-                                   pafOutputBuf);
-        }
-
-        for( ; j < nXSize - 1; j++ )
-        {
-            T afWin[9] = {
-                pafThreeLineWin[nLine1Off + j-1],
-                pafThreeLineWin[nLine1Off + j],
-                pafThreeLineWin[nLine1Off + j+1],
-                pafThreeLineWin[nLine2Off + j-1],
-                pafThreeLineWin[nLine2Off + j],
-                pafThreeLineWin[nLine2Off + j+1],
-                pafThreeLineWin[nLine3Off + j-1],
-                pafThreeLineWin[nLine3Off + j],
-                pafThreeLineWin[nLine3Off + j+1]
-            };
-
-            pafOutputBuf[j] =
-                ComputeVal(
-                    CPL_TO_BOOL(bOneOfThreeLinesHasNoData),
-                    fSrcNoDataValue,
-                    CPL_TO_BOOL(bIsSrcNoDataNan),
-                    afWin, fDstNoDataValue,
-                    pfnAlg, pData, bComputeAtEdges);
-        }
+        abLineHasNoDataValue[nLine3Off / nXSize] =
+            GDALGeneric3x3LineHasNoData(sParams, pafThreeLineWin + nLine3Off);
+        const bool bOneOfThreeLinesHasNoData = abLineHasNoDataValue[0] ||
+                                               abLineHasNoDataValue[1] ||
+                                               abLineHasNoDataValue[2];
 
-        if( bComputeAtEdges && nXSize >= 2 )
-        {
-            j = nXSize - 1;
-
-            T afWin[9] = {
-                pafThreeLineWin[nLine1Off + j-1],
-                pafThreeLineWin[nLine1Off + j],
-                INTERPOL(pafThreeLineWin[nLine1Off + j],
-                         pafThreeLineWin[nLine1Off + j-1],
-                         bSrcHasNoData, fSrcNoDataValue),
-                pafThreeLineWin[nLine2Off + j-1],
-                pafThreeLineWin[nLine2Off + j],
-                INTERPOL(pafThreeLineWin[nLine2Off + j],
-                         pafThreeLineWin[nLine2Off + j-1],
-                         bSrcHasNoData, fSrcNoDataValue),
-                pafThreeLineWin[nLine3Off + j-1],
-                pafThreeLineWin[nLine3Off + j],
-                INTERPOL(pafThreeLineWin[nLine3Off + j],
-                         pafThreeLineWin[nLine3Off + j-1],
-                         bSrcHasNoData, fSrcNoDataValue)
-            };
-
-            pafOutputBuf[j] =
-                ComputeVal(
-                    CPL_TO_BOOL(bOneOfThreeLinesHasNoData),
-                    fSrcNoDataValue,
-                    CPL_TO_BOOL(bIsSrcNoDataNan),
-                    afWin, fDstNoDataValue,
-                    pfnAlg, pData, bComputeAtEdges);
-        }
-        else
-        {
-            // Exclude the edges
-            if( nXSize > 1 )
-                pafOutputBuf[nXSize - 1] = fDstNoDataValue;
-        }
+        GDALGeneric3x3ProcessLine(sParams, pafThreeLineWin,
+                                  nLine1Off, nLine2Off, nLine3Off,
+                                  bOneOfThreeLinesHasNoData,
+                                  pafOutputBuf);
 
         /* -----------------------------------------
          * Write Line to Raster
@@ -668,38 +1034,12 @@ CPLErr GDALGeneric3x3Processing(
         nLine3Off = nTemp;
     }
 
-    if( bComputeAtEdges && nXSize >= 2 && nYSize >= 2 )
+    if( nYSize > 1 )
     {
-        for( int j = 0; j < nXSize; j++ )
-        {
-            int jmin = (j == 0) ? j : j - 1;
-            int jmax = (j == nXSize - 1) ? j : j + 1;
-
-            T afWin[9] = {
-                pafThreeLineWin[nLine1Off + jmin],
-                pafThreeLineWin[nLine1Off + j],
-                pafThreeLineWin[nLine1Off + jmax],
-                pafThreeLineWin[nLine2Off + jmin],
-                pafThreeLineWin[nLine2Off + j],
-                pafThreeLineWin[nLine2Off + jmax],
-                INTERPOL(pafThreeLineWin[nLine2Off + jmin],
-                         pafThreeLineWin[nLine1Off + jmin],
-                         bSrcHasNoData, fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[nLine2Off + j],
-                         pafThreeLineWin[nLine1Off + j],
-                         bSrcHasNoData, fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[nLine2Off + jmax],
-                         pafThreeLineWin[nLine1Off + jmax],
-                         bSrcHasNoData, fSrcNoDataValue),
-            };
-
-            pafOutputBuf[j] = ComputeVal(
-                CPL_TO_BOOL(bSrcHasNoData),
-                fSrcNoDataValue,
-                CPL_TO_BOOL(bIsSrcNoDataNan),
-                afWin, fDstNoDataValue,
-                pfnAlg, pData, bComputeAtEdges);
-        }
+        GDALGeneric3x3ProcessLastLine(sParams,
+                                      pafThreeLineWin + nLine1Off,
+                                      pafThreeLineWin + nLine2Off,
+                                      pafOutputBuf);
         eErr = GDALRasterIO(hDstBand, GF_Write,
                             0, i, nXSize, 1,
                             pafOutputBuf, nXSize, 1, GDT_Float32, 0, 0);
@@ -1104,6 +1444,109 @@ int GDALHillshadeAlg_same_res_multisample( const T* pafThreeLineWin,
     }
     return j;
 }
+
+// Float32 version: the gradient is accumulated in single precision, and
+// the shade value computed in double precision, with the same operations
+// as GDALHillshadeAlg_same_res<float>(), so that the results are identical.
+template<>
+int GDALHillshadeAlg_same_res_multisample<float>( const float* pafThreeLineWin,
+                                                  int nLine1Off,
+                                                  int nLine2Off,
+                                                  int nLine3Off,
+                                                  int nXSize,
+                                                  void* pData,
+                                                  float* pafOutputBuf )
+{
+    GDALHillshadeAlgData* psData = static_cast<GDALHillshadeAlgData*>(pData);
+    const __m128d reg_fact_x = _mm_load1_pd(
+                      &(psData->sin_az_mul_cos_alt_mul_z_mul_254_mul_inv_res));
+    const __m128d reg_fact_y = _mm_load1_pd (
+                      &(psData->cos_az_mul_cos_alt_mul_z_mul_254_mul_inv_res));
+    const __m128d reg_constant_num = _mm_load1_pd(
+                      &(psData->sin_altRadians_mul_254));
+    const __m128d reg_constant_denom = _mm_load1_pd(
+                      &(psData->square_z_mul_square_inv_res));
+    const __m128d reg_half = _mm_set1_pd(0.5);
+    const __m128d reg_one = _mm_add_pd(reg_half, reg_half);
+    const __m128d reg_one_and_a_half = _mm_add_pd(reg_one, reg_half);
+
+    int j = 1;  // Used after for.
+    for( ; j < nXSize - 4; j+= 4 )
+    {
+        const float* firstLine  = pafThreeLineWin + nLine1Off + j-1;
+        const float* secondLine = pafThreeLineWin + nLine2Off + j-1;
+        const float* thirdLine  = pafThreeLineWin + nLine3Off + j-1;
+
+        __m128 firstLine0 = _mm_loadu_ps( firstLine );
+        __m128 firstLine1 = _mm_loadu_ps( firstLine + 1 );
+        __m128 firstLine2 = _mm_loadu_ps( firstLine + 2 );
+        __m128 thirdLine0 = _mm_loadu_ps( thirdLine );
+        __m128 thirdLine1 = _mm_loadu_ps( thirdLine + 1 );
+        __m128 thirdLine2 = _mm_loadu_ps( thirdLine + 2 );
+        __m128 accX = _mm_sub_ps( firstLine0, thirdLine2 );
+        const __m128 six_minus_two = _mm_sub_ps( thirdLine0, firstLine2 );
+        __m128 accY = accX;
+        const __m128 three_minus_five = _mm_sub_ps(
+                          _mm_loadu_ps( secondLine ),
+                          _mm_loadu_ps( secondLine + 2 ) );
+        const __m128 one_minus_seven = _mm_sub_ps( firstLine1, thirdLine1 );
+        accX = _mm_add_ps(accX, three_minus_five);
+        accY = _mm_add_ps(accY, one_minus_seven);
+        accX = _mm_add_ps(accX, three_minus_five);
+        accY = _mm_add_ps(accY, one_minus_seven);
+        accX = _mm_add_ps(accX, six_minus_two);
+        accY = _mm_sub_ps(accY, six_minus_two);
+
+        __m128d reg_x0 = _mm_cvtps_pd(accX);
+        __m128d reg_x1 = _mm_cvtps_pd(_mm_movehl_ps(accX, accX));
+        __m128d reg_y0 = _mm_cvtps_pd(accY);
+        __m128d reg_y1 = _mm_cvtps_pd(_mm_movehl_ps(accY, accY));
+        __m128d reg_xx_plus_yy0 = _mm_add_pd( _mm_mul_pd(reg_x0, reg_x0),
+                                              _mm_mul_pd(reg_y0, reg_y0) );
+        __m128d reg_xx_plus_yy1 = _mm_add_pd( _mm_mul_pd(reg_x1, reg_x1),
+                                              _mm_mul_pd(reg_y1, reg_y1) );
+
+        __m128d reg_numerator0 = _mm_add_pd(reg_constant_num,
+                  _mm_add_pd( _mm_mul_pd(reg_fact_x, reg_x0),
+                              _mm_mul_pd(reg_fact_y, reg_y0) ) );
+        __m128d reg_numerator1 = _mm_add_pd(reg_constant_num,
+                  _mm_add_pd( _mm_mul_pd(reg_fact_x, reg_x1),
+                              _mm_mul_pd(reg_fact_y, reg_y1) ) );
+        __m128d reg_denominator0 = _mm_add_pd(reg_one,
+                              _mm_mul_pd(reg_constant_denom, reg_xx_plus_yy0));
+        __m128d reg_denominator1 = _mm_add_pd(reg_one,
+                              _mm_mul_pd(reg_constant_denom, reg_xx_plus_yy1));
+
+        // Same approximation of 1 / sqrt(b) as ApproxADivByInvSqrtB()
+        __m128d regB0 = reg_denominator0;
+        __m128d regB1 = reg_denominator1;
+        __m128d regB0_half = _mm_mul_pd( regB0, reg_half );
+        __m128d regB1_half = _mm_mul_pd( regB1, reg_half );
+        regB0 = _mm_cvtps_pd( _mm_rsqrt_ps( _mm_cvtpd_ps( regB0 ) ) );
+        regB1 = _mm_cvtps_pd( _mm_rsqrt_ps( _mm_cvtpd_ps( regB1 ) ) );
+        regB0 = _mm_mul_pd(regB0, _mm_sub_pd( reg_one_and_a_half,
+                                             _mm_mul_pd(regB0_half,
+                                                  _mm_mul_pd(regB0, regB0)) ) );
+        regB1 = _mm_mul_pd(regB1, _mm_sub_pd( reg_one_and_a_half,
+                                            _mm_mul_pd(regB1_half,
+                                                  _mm_mul_pd(regB1, regB1)) ) );
+        reg_numerator0 = _mm_mul_pd(reg_numerator0, regB0);
+        reg_numerator1 = _mm_mul_pd(reg_numerator1, regB1);
+
+        // cang = cang_mul_254 <= 0.0 ? 1.0 : 1.0 + cang_mul_254.
+        // _mm_max_pd() returns its second argument when one of them is NaN.
+        reg_numerator0 = _mm_max_pd(reg_one,
+                                    _mm_add_pd(reg_one, reg_numerator0));
+        reg_numerator1 = _mm_max_pd(reg_one,
+                                    _mm_add_pd(reg_one, reg_numerator1));
+
+        __m128 res = _mm_movelh_ps(_mm_cvtpd_ps(reg_numerator0),
+                                   _mm_cvtpd_ps(reg_numerator1));
+
+        _mm_storeu_ps( pafOutputBuf + j, res);
+    }
+    return j;
+}
 #endif
 
 static const double INV_SQUARE_OF_HALF_PI = 1.0 / ((M_PI*M_PI)/4);
@@ -1323,6 +1766,103 @@ float GDALSlopeHornAlg( const T* afWin, float /*fDstNoDataValue*/, void* pData )
     return static_cast<float>(100*(sqrt(key) / (8*psData->scale)));
 }
 
+#ifdef HAVE_16_SSE_REG
+template<class T>
+static
+int GDALSlopeHornAlg_multisample( const T* pafThreeLineWin,
+                                  int nLine1Off,
+                                  int nLine2Off,
+                                  int nLine3Off,
+                                  int nXSize,
+                                  void* pData,
+                                  float* pafOutputBuf );
+
+// Float32 version: same operations as GDALSlopeHornAlg<float>(), on 4
+// pixels at a time, except the atan() of the degree format that remains
+// scalar.
+template<>
+int GDALSlopeHornAlg_multisample<float>( const float* pafThreeLineWin,
+                                         int nLine1Off,
+                                         int nLine2Off,
+                                         int nLine3Off,
+                                         int nXSize,
+                                         void* pData,
+                                         float* pafOutputBuf )
+{
+    const GDALSlopeAlgData* psData = static_cast<const GDALSlopeAlgData*>(pData);
+    const __m128d reg_ewres = _mm_set1_pd(psData->ewres);
+    const __m128d reg_nsres = _mm_set1_pd(psData->nsres);
+    const __m128d reg_8_mul_scale = _mm_set1_pd(8 * psData->scale);
+    const __m128d reg_100 = _mm_set1_pd(100.0);
+    const bool bDegrees = psData->slopeFormat == 1;
+
+    int j = 1;  // Used after for.
+    for( ; j < nXSize - 4; j+= 4 )
+    {
+        const float* firstLine  = pafThreeLineWin + nLine1Off + j-1;
+        const float* secondLine = pafThreeLineWin + nLine2Off + j-1;
+        const float* thirdLine  = pafThreeLineWin + nLine3Off + j-1;
+
+        const __m128 win0 = _mm_loadu_ps( firstLine );
+        const __m128 win1 = _mm_loadu_ps( firstLine + 1 );
+        const __m128 win2 = _mm_loadu_ps( firstLine + 2 );
+        const __m128 win3 = _mm_loadu_ps( secondLine );
+        const __m128 win5 = _mm_loadu_ps( secondLine + 2 );
+        const __m128 win6 = _mm_loadu_ps( thirdLine );
+        const __m128 win7 = _mm_loadu_ps( thirdLine + 1 );
+        const __m128 win8 = _mm_loadu_ps( thirdLine + 2 );
+
+        // (afWin[0] + afWin[3] + afWin[3] + afWin[6]) -
+        // (afWin[2] + afWin[5] + afWin[5] + afWin[8])
+        const __m128 accX = _mm_sub_ps(
+            _mm_add_ps(_mm_add_ps(_mm_add_ps(win0, win3), win3), win6),
+            _mm_add_ps(_mm_add_ps(_mm_add_ps(win2, win5), win5), win8));
+        // (afWin[6] + afWin[7] + afWin[7] + afWin[8]) -
+        // (afWin[0] + afWin[1] + afWin[1] + afWin[2])
+        const __m128 accY = _mm_sub_ps(
+            _mm_add_ps(_mm_add_ps(_mm_add_ps(win6, win7), win7), win8),
+            _mm_add_ps(_mm_add_ps(_mm_add_ps(win0, win1), win1), win2));
+
+        const __m128d reg_dx0 = _mm_div_pd(_mm_cvtps_pd(accX), reg_ewres);
+        const __m128d reg_dx1 = _mm_div_pd(
+            _mm_cvtps_pd(_mm_movehl_ps(accX, accX)), reg_ewres);
+        const __m128d reg_dy0 = _mm_div_pd(_mm_cvtps_pd(accY), reg_nsres);
+        const __m128d reg_dy1 = _mm_div_pd(
+            _mm_cvtps_pd(_mm_movehl_ps(accY, accY)), reg_nsres);
+
+        __m128d reg_val0 = _mm_div_pd(
+            _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(reg_dx0, reg_dx0),
+                                   _mm_mul_pd(reg_dy0, reg_dy0))),
+            reg_8_mul_scale);
+        __m128d reg_val1 = _mm_div_pd(
+            _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(reg_dx1, reg_dx1),
+                                   _mm_mul_pd(reg_dy1, reg_dy1))),
+            reg_8_mul_scale);
+
+        if( bDegrees )
+        {
+            double adfVal[4];
+            _mm_storeu_pd(adfVal, reg_val0);
+            _mm_storeu_pd(adfVal + 2, reg_val1);
+            for( int k = 0; k < 4; k++ )
+            {
+                pafOutputBuf[j + k] = static_cast<float>(
+                    atan(adfVal[k]) * kdfRadiansToDegrees);
+            }
+        }
+        else
+        {
+            reg_val0 = _mm_mul_pd(reg_100, reg_val0);
+            reg_val1 = _mm_mul_pd(reg_100, reg_val1);
+            _mm_storeu_ps( pafOutputBuf + j,
+                           _mm_movelh_ps(_mm_cvtpd_ps(reg_val0),
+                                         _mm_cvtpd_ps(reg_val1)) );
+        }
+    }
+    return j;
+}
+#endif
+
 template<class T>
 static
 float GDALSlopeZevenbergenThorneAlg( const T* afWin,
@@ -3491,6 +4031,7 @@ GDALDatasetH GDALDEMProcessing( const char *pszDest,
     GDALGeneric3x3ProcessingAlg<float>::type pfnAlgFloat = nullptr;
     GDALGeneric3x3ProcessingAlg<GInt32>::type pfnAlgInt32 = nullptr;
     GDALGeneric3x3ProcessingAlg_multisample<GInt32>::type pfnAlgInt32_multisample = nullptr;
+    GDALGeneric3x3ProcessingAlg_multisample<float>::type pfnAlgFloat_multisample = nullptr;
 
     if( eUtilityMode == HILL_SHADE && psOptions->bMultiDirectional )
     {
@@ -3559,6 +4100,8 @@ GDALDatasetH GDALDEMProcessing( const char *pszDest,
                     pfnAlgFloat = GDALHillshadeAlg_same_res<float>;
                     pfnAlgInt32 = GDALHillshadeAlg_same_res<GInt32>;
 #ifdef HAVE_16_SSE_REG
+                    pfnAlgFloat_multisample =
+                                GDALHillshadeAlg_same_res_multisample<float>;
                     pfnAlgInt32_multisample =
                                 GDALHillshadeAlg_same_res_multisample<GInt32>;
 #endif
@@ -3586,6 +4129,9 @@ GDALDatasetH GDALDEMProcessing( const char *pszDest,
         {
             pfnAlgFloat = GDALSlopeHornAlg<float>;
             pfnAlgInt32 = GDALSlopeHornAlg<GInt32>;
+#ifdef HAVE_16_SSE_REG
+            pfnAlgFloat_multisample = GDALSlopeHornAlg_multisample<float>;
+#endif
         }
     }
 
@@ -3832,15 +4378,17 @@ GDALDatasetH GDALDEMProcessing( const char *pszDest,
                                              pfnAlgInt32_multisample,
                                              pData,
                                              psOptions->bComputeAtEdges,
+                                             psOptions->nNumThreads,
                                              pfnProgress, pProgressData);
         }
         else
         {
             GDALGeneric3x3Processing<float>(hSrcBand, hDstBand,
                                             pfnAlgFloat,
-                                            nullptr,
+                                            pfnAlgFloat_multisample,
                                             pData,
                                             psOptions->bComputeAtEdges,
+                                            psOptions->nNumThreads,
                                             pfnProgress, pProgressData);
         }
     }
@@ -3898,6 +4446,7 @@ GDALDEMProcessingOptions *GDALDEMProcessingOptionsNew(
     psOptions->bMultiDirectional = false;
     psOptions->nBand = 1;
     psOptions->papszCreateOptions = nullptr;
+    psOptions->nNumThreads = 1;
     bool bAzimuthSpecified = false;
     bool bAltSpecified = false;
 
@@ -4075,6 +4624,10 @@ GDALDEMProcessingOptions *GDALDEMProcessingOptionsNew(
             psOptions->papszCreateOptions =
                 CSLAddString( psOptions->papszCreateOptions, papszArgv[++i] );
         }
+        else if( i + 1 < argc && EQUAL(papszArgv[i], "-nt") )
+        {
+            psOptions->nNumThreads = CPLGetNumThreads(papszArgv[++i]);
+        }
         else if( papszArgv[i][0] == '-' )
         {
             CPLError(CE_Failure, CPLE_NotSupported,
@@ -80,7 +80,7 @@ static void Usage( const char* pszAdditionalMsg = nullptr, bool bShort = true )
         "               [-dim XY|XYZ|XYM|XYZM|layer_dim] [layer [layer ...]]\n"
         "\n"
         "Advanced options :\n"
-        "               [-gt n] [-ds_transaction]\n"
+        "               [-gt n] [-ds_transaction] [-nt n|ALL_CPUS]\n"
         "               [[-oo NAME=VALUE] ...] [[-doo NAME=VALUE] ...]\n"
         "               [-clipsrc [xmin ymin xmax ymax]|WKT|datasource|spat_extent]\n"
         "               [-clipsrcsql sql_statement] [-clipsrclayer layer]\n"
@@ -145,6 +145,7 @@ static void Usage( const char* pszAdditionalMsg = nullptr, bool bShort = true )
         " -dialect value: select a dialect, usually OGRSQL to avoid native sql.\n"
         " -skipfailures: skip features or layers that fail to convert\n"
         " -gt n: group n features per transaction (default 20000). n can be set to unlimited\n"
+        " -nt n: number of threads used to process geometries (default 1), or ALL_CPUS\n"
         " -spat xmin ymin xmax ymax: spatial query extents\n"
         " -simplify tolerance: distance tolerance for simplification.\n"
         " -segmentize max_dist: maximum distance between 2 nodes.\n"
@@ -39,7 +39,12 @@
 #include <cstring>
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <unordered_set>
 #include <string>
@@ -49,9 +54,11 @@
 #include "commonutils.h"
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_multiproc.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_alg.h"
 #include "gdal_priv.h"
@@ -120,6 +127,11 @@ struct GDALVectorTranslateOptions
     /*! allow or suppress progress monitor and other non-error output */
     bool bQuiet;
 
+    /*! number of worker threads used to process the geometries of the features
+        (reprojection, clipping, ...), in addition to a reading thread and the
+        writing (calling) thread. 1 (default) disables multi-threading. (GDAL >= 3.1) */
+    int nNumThreads;
+
     /*! output file format name */
     char *pszFormat;
 
@@ -354,6 +366,11 @@ typedef struct
     GIntBig      nFeaturesRead;
     bool         bPerFeatureCT;
     OGRLayer    *poDstLayer;
+    // Cached at setup time, so that worker threads do not call
+    // GetLayerDefn() on the layers.
+    OGRFeatureDefn *poDstFDefn;
+    int          nSrcGeomFieldCount;
+    int          nDstGeomFieldCount;
     OGRCoordinateTransformation **papoCT; // size: poDstLayer->GetLayerDefn()->GetFieldCount();
     char       ***papapszTransformOptions; // size: poDstLayer->GetLayerDefn()->GetFieldCount();
     int         *panMap;
@@ -409,6 +426,19 @@ public:
                                       GIntBig& nTotalEventsDone);
 };
 
+/************************************************************************/
+/*                            TranslatedPart                            */
+/************************************************************************/
+
+// Destination feature built from a source feature (or from one of the
+// parts of its geometry with -explodecollections), before it is written.
+struct TranslatedPart
+{
+    std::unique_ptr<OGRFeature> poDstFeature{}; // nullptr if clipped out
+    bool        bSetFromFailed = false;
+    bool        bReprojectionFailed = false;
+};
+
 class LayerTranslator
 {
 public:
@@ -440,6 +470,23 @@ public:
                                   GDALProgressFunc pfnProgress,
                                   void *pProgressArg,
                                   GDALVectorTranslateOptions *psOptions);
+
+    void                TranslateParts(OGRFeature* poFeature,
+                                       TargetLayerInfo* psInfo,
+                                       OGRCoordinateTransformation** papoCT,
+                                       char*** papapszTransformOptions,
+                                       OGRSpatialReference* poOutputSRS,
+                                       OGRGeometryFactory::TransformWithOptionsCache& transformWithOptionsCache,
+                                       const GDALVectorTranslateOptions *psOptions,
+                                       std::vector<TranslatedPart>& aoParts);
+
+    bool                WriteParts(OGRFeature* poFeature,
+                                   std::vector<TranslatedPart>& aoParts,
+                                   TargetLayerInfo* psInfo,
+                                   int& nFeaturesInTransaction,
+                                   GIntBig& nTotalEventsDone,
+                                   GIntBig& nFeaturesWritten,
+                                   GDALVectorTranslateOptions *psOptions);
 };
 
 static OGRLayer* GetLayerAndOverwriteIfNecessary(GDALDataset *poDstDS,
@@ -4232,12 +4279,15 @@ TargetLayerInfo* SetupTargetLayer::Setup(OGRLayer* poSrcLayer,
     psInfo->bPerFeatureCT = false;
     psInfo->poSrcLayer = poSrcLayer;
     psInfo->poDstLayer = poDstLayer;
+    psInfo->poDstFDefn = poDstLayer->GetLayerDefn();
+    psInfo->nSrcGeomFieldCount =
+        poSrcLayer->GetLayerDefn()->GetGeomFieldCount();
+    psInfo->nDstGeomFieldCount = psInfo->poDstFDefn->GetGeomFieldCount();
     psInfo->papoCT = static_cast<OGRCoordinateTransformation **>(
-        CPLCalloc(poDstLayer->GetLayerDefn()->GetGeomFieldCount(),
+        CPLCalloc(psInfo->nDstGeomFieldCount,
                   sizeof(OGRCoordinateTransformation*)));
     psInfo->papapszTransformOptions = static_cast<char ***>(
-        CPLCalloc(poDstLayer->GetLayerDefn()->GetGeomFieldCount(),
-                  sizeof(char**)));
+        CPLCalloc(psInfo->nDstGeomFieldCount, sizeof(char**)));
     psInfo->panMap = panMap;
     psInfo->iSrcZField = iSrcZField;
     psInfo->iSrcFIDField = iSrcFIDField;
@@ -4476,432 +4526,961 @@ static bool SetupCT( TargetLayerInfo* psInfo,
 }
 
 /************************************************************************/
-/*                     LayerTranslator::Translate()                     */
+/*                    LayerTranslator::TranslateParts()                 */
 /************************************************************************/
 
-int LayerTranslator::Translate( OGRFeature* poFeatureIn,
-                                TargetLayerInfo* psInfo,
-                                GIntBig nCountLayerFeatures,
-                                GIntBig* pnReadFeatureCount,
-                                GIntBig& nTotalEventsDone,
-                                GDALProgressFunc pfnProgress,
-                                void *pProgressArg,
-                                GDALVectorTranslateOptions *psOptions )
+// Build the destination feature(s) of a source feature: attribute mapping
+// and geometry processing (clipping, simplification, reprojection...).
+// Nothing is written to the target layer, so that this can be run in worker
+// threads with their own coordinate transformations and cache. The geometry
+// of the source feature may be stolen.
+
+void LayerTranslator::TranslateParts(
+                OGRFeature* poFeature,
+                TargetLayerInfo* psInfo,
+                OGRCoordinateTransformation** papoCT,
+                char*** papapszTransformOptions,
+                OGRSpatialReference* poOutputSRS,
+                OGRGeometryFactory::TransformWithOptionsCache& transformWithOptionsCache,
+                const GDALVectorTranslateOptions *psOptions,
+                std::vector<TranslatedPart>& aoParts )
 {
     const int eGType = m_eGType;
-    OGRSpatialReference* poOutputSRS = m_poOutputSRS;
 
-    OGRLayer *poSrcLayer = psInfo->poSrcLayer;
-    OGRLayer *poDstLayer = psInfo->poDstLayer;
+    OGRFeatureDefn *poDstFDefn = psInfo->poDstFDefn;
     int* const panMap = psInfo->panMap;
     const int iSrcZField = psInfo->iSrcZField;
     const bool bPreserveFID = psInfo->bPreserveFID;
-    const int nSrcGeomFieldCount = poSrcLayer->GetLayerDefn()->GetGeomFieldCount();
-    const int nDstGeomFieldCount = poDstLayer->GetLayerDefn()->GetGeomFieldCount();
+    const int nSrcGeomFieldCount = psInfo->nSrcGeomFieldCount;
+    const int nDstGeomFieldCount = psInfo->nDstGeomFieldCount;
     const bool bExplodeCollections = m_bExplodeCollections && nDstGeomFieldCount <= 1;
 
-    if( poOutputSRS == nullptr && !m_bNullifyOutputSRS )
+    int nParts = 0;
+    int nIters = 1;
+    if (bExplodeCollections)
     {
-        if( nSrcGeomFieldCount == 1 )
+        OGRGeometry* poSrcGeometry;
+        if( psInfo->iRequestedSrcGeomField >= 0 )
+            poSrcGeometry = poFeature->GetGeomFieldRef(
+                                    psInfo->iRequestedSrcGeomField);
+        else
+            poSrcGeometry = poFeature->GetGeometryRef();
+        if (poSrcGeometry &&
+            OGR_GT_IsSubClassOf(poSrcGeometry->getGeometryType(), wkbGeometryCollection) )
         {
-            poOutputSRS = poSrcLayer->GetSpatialRef();
-        }
-        else if( psInfo->iRequestedSrcGeomField > 0 )
-        {
-            poOutputSRS = poSrcLayer->GetLayerDefn()->GetGeomFieldDefn(
-                psInfo->iRequestedSrcGeomField)->GetSpatialRef();
+            nParts = poSrcGeometry->toGeometryCollection()->getNumGeometries();
+            nIters = nParts;
+            if (nIters == 0)
+                nIters = 1;
         }
     }
 
-/* -------------------------------------------------------------------- */
-/*      Transfer features.                                              */
-/* -------------------------------------------------------------------- */
-    if( psOptions->nGroupTransactions )
+    for(int iPart = 0; iPart < nIters; iPart++)
     {
-        if( psOptions->nLayerTransaction )
-        {
-            if( poDstLayer->StartTransaction() == OGRERR_FAILURE )
-                return false;
-        }
-    }
+        aoParts.emplace_back();
+        TranslatedPart& oPart = aoParts.back();
 
-    OGRFeature *poFeature = nullptr;
-    int         nFeaturesInTransaction = 0;
-    GIntBig      nCount = 0; /* written + failed */
-    GIntBig      nFeaturesWritten = 0;
+        CPLErrorReset();
+        std::unique_ptr<OGRFeature> poDstFeature(
+            OGRFeature::CreateFeature( poDstFDefn ));
 
-    bool bRet = true;
-    CPLErrorReset();
-    OGRGeometryFactory::TransformWithOptionsCache transformWithOptionsCache;
-    while( true )
-    {
-        if( m_nLimit >= 0 && psInfo->nFeaturesRead >= m_nLimit )
+        /* Optimization to avoid duplicating the source geometry in the */
+        /* target feature : we steal it from the source feature for now... */
+        OGRGeometry* poStolenGeometry = nullptr;
+        if( !bExplodeCollections && nSrcGeomFieldCount == 1 &&
+            (nDstGeomFieldCount == 1 ||
+             (nDstGeomFieldCount == 0 && m_poClipSrc)) )
         {
-            break;
+            poStolenGeometry = poFeature->StealGeometry();
+        }
+        else if( !bExplodeCollections &&
+                 psInfo->iRequestedSrcGeomField >= 0 )
+        {
+            poStolenGeometry = poFeature->StealGeometry(
+                psInfo->iRequestedSrcGeomField);
         }
 
-        if( poFeatureIn != nullptr )
-            poFeature = poFeatureIn;
-        else if( psOptions->nFIDToFetch != OGRNullFID )
-            poFeature = poSrcLayer->GetFeature(psOptions->nFIDToFetch);
-        else
-            poFeature = poSrcLayer->GetNextFeature();
-
-        if( poFeature == nullptr )
+        if( nDstGeomFieldCount == 0 && poStolenGeometry && m_poClipSrc )
         {
-            if( CPLGetLastErrorType() == CE_Failure )
+            OGRGeometry* poClipped = poStolenGeometry->Intersection(m_poClipSrc);
+            delete poStolenGeometry;
+            poStolenGeometry = nullptr;
+            if (poClipped == nullptr || poClipped->IsEmpty())
             {
-                bRet = false;
+                delete poClipped;
+                continue;
             }
-            break;
+            delete poClipped;
         }
 
-        if( psInfo->nFeaturesRead == 0 || psInfo->bPerFeatureCT )
+        if( poDstFeature->SetFrom( poFeature, panMap, TRUE ) != OGRERR_NONE )
         {
-            if( !SetupCT( psInfo, poSrcLayer, m_bTransform, m_bWrapDateline,
-                          m_osDateLineOffset, m_poUserSourceSRS,
-                          poFeature, poOutputSRS, m_poGCPCoordTrans) )
-            {
-                OGRFeature::DestroyFeature( poFeature );
-                return false;
-            }
+            OGRGeometryFactory::destroyGeometry( poStolenGeometry );
+            oPart.bSetFromFailed = true;
+            return;
         }
 
-        psInfo->nFeaturesRead ++;
+        /* ... and now we can attach the stolen geometry */
+        if( poStolenGeometry )
+        {
+            poDstFeature->SetGeometryDirectly(poStolenGeometry);
+        }
+
+        if( bPreserveFID )
+            poDstFeature->SetFID( poFeature->GetFID() );
+        else if( psInfo->iSrcFIDField >= 0 &&
+                 poFeature->IsFieldSetAndNotNull(psInfo->iSrcFIDField))
+            poDstFeature->SetFID( poFeature->GetFieldAsInteger64(psInfo->iSrcFIDField) );
 
-        int nParts = 0;
-        int nIters = 1;
-        if (bExplodeCollections)
+        /* Erase native data if asked explicitly */
+        if( !m_bNativeData )
         {
-            OGRGeometry* poSrcGeometry;
-            if( psInfo->iRequestedSrcGeomField >= 0 )
-                poSrcGeometry = poFeature->GetGeomFieldRef(
-                                        psInfo->iRequestedSrcGeomField);
-            else
-                poSrcGeometry = poFeature->GetGeometryRef();
-            if (poSrcGeometry &&
-                OGR_GT_IsSubClassOf(poSrcGeometry->getGeometryType(), wkbGeometryCollection) )
-            {
-                nParts = poSrcGeometry->toGeometryCollection()->getNumGeometries();
-                nIters = nParts;
-                if (nIters == 0)
-                    nIters = 1;
-            }
+            poDstFeature->SetNativeData(nullptr);
+            poDstFeature->SetNativeMediaType(nullptr);
         }
 
-        OGRFeature *poDstFeature = nullptr;
-        for(int iPart = 0; iPart < nIters; iPart++)
+        bool bSkip = false;
+        for( int iGeom = 0; !bSkip && iGeom < nDstGeomFieldCount; iGeom ++ )
         {
-            if( psOptions->nLayerTransaction &&
-                ++nFeaturesInTransaction == psOptions->nGroupTransactions )
+            OGRGeometry* poDstGeometry = poDstFeature->StealGeometry(iGeom);
+            if (poDstGeometry == nullptr)
+                continue;
+
+            if (nParts > 0)
             {
-                if( poDstLayer->CommitTransaction() == OGRERR_FAILURE ||
-                    poDstLayer->StartTransaction() == OGRERR_FAILURE )
-                {
-                    OGRFeature::DestroyFeature( poFeature );
-                    return false;
-                }
-                nFeaturesInTransaction = 0;
+                /* For -explodecollections, extract the iPart(th) of the geometry */
+                OGRGeometry* poPart = poDstGeometry->toGeometryCollection()->getGeometryRef(iPart);
+                poDstGeometry->toGeometryCollection()->removeGeometry(iPart, FALSE);
+                delete poDstGeometry;
+                poDstGeometry = poPart;
+                assert(poDstGeometry);
             }
-            else if( !psOptions->nLayerTransaction &&
-                     psOptions->nGroupTransactions >= 0 &&
-                     ++nTotalEventsDone >= psOptions->nGroupTransactions )
+
+            if (iSrcZField != -1)
             {
-                if( m_poODS->CommitTransaction() == OGRERR_FAILURE ||
-                        m_poODS->StartTransaction(psOptions->bForceTransaction) == OGRERR_FAILURE )
-                {
-                    OGRFeature::DestroyFeature( poFeature );
-                    return false;
-                }
-                nTotalEventsDone = 0;
+                SetZ(poDstGeometry, poFeature->GetFieldAsDouble(iSrcZField));
+                /* This will correct the coordinate dimension to 3 */
+                OGRGeometry* poDupGeometry = poDstGeometry->clone();
+                delete poDstGeometry;
+                poDstGeometry = poDupGeometry;
             }
 
-            CPLErrorReset();
-            poDstFeature = OGRFeature::CreateFeature( poDstLayer->GetLayerDefn() );
+            if (m_nCoordDim == 2 || m_nCoordDim == 3)
+            {
+                poDstGeometry->setCoordinateDimension( m_nCoordDim );
+            }
+            else if (m_nCoordDim == 4)
+            {
+                poDstGeometry->set3D( TRUE );
+                poDstGeometry->setMeasured( TRUE );
+            }
+            else if (m_nCoordDim == COORD_DIM_XYM)
+            {
+                poDstGeometry->set3D( FALSE );
+                poDstGeometry->setMeasured( TRUE );
+            }
+            else if ( m_nCoordDim == COORD_DIM_LAYER_DIM )
+            {
+                const OGRwkbGeometryType eDstLayerGeomType =
+                  poDstFDefn->GetGeomFieldDefn(iGeom)->GetType();
+                poDstGeometry->set3D( wkbHasZ(eDstLayerGeomType) );
+                poDstGeometry->setMeasured( wkbHasM(eDstLayerGeomType) );
+            }
 
-            /* Optimization to avoid duplicating the source geometry in the */
-            /* target feature : we steal it from the source feature for now... */
-            OGRGeometry* poStolenGeometry = nullptr;
-            if( !bExplodeCollections && nSrcGeomFieldCount == 1 &&
-                (nDstGeomFieldCount == 1 ||
-                 (nDstGeomFieldCount == 0 && m_poClipSrc)) )
+            if (m_eGeomOp == GEOMOP_SEGMENTIZE)
             {
-                poStolenGeometry = poFeature->StealGeometry();
+                if (m_dfGeomOpParam > 0)
+                    poDstGeometry->segmentize(m_dfGeomOpParam);
             }
-            else if( !bExplodeCollections &&
-                     psInfo->iRequestedSrcGeomField >= 0 )
+            else if (m_eGeomOp == GEOMOP_SIMPLIFY_PRESERVE_TOPOLOGY)
             {
-                poStolenGeometry = poFeature->StealGeometry(
-                    psInfo->iRequestedSrcGeomField);
+                if (m_dfGeomOpParam > 0)
+                {
+                    OGRGeometry* poNewGeom = poDstGeometry->SimplifyPreserveTopology(m_dfGeomOpParam);
+                    if (poNewGeom)
+                    {
+                        delete poDstGeometry;
+                        poDstGeometry = poNewGeom;
+                    }
+                }
             }
 
-            if( nDstGeomFieldCount == 0 && poStolenGeometry && m_poClipSrc )
+            if (m_poClipSrc)
             {
-                OGRGeometry* poClipped = poStolenGeometry->Intersection(m_poClipSrc);
-                delete poStolenGeometry;
-                poStolenGeometry = nullptr;
+                OGRGeometry* poClipped = poDstGeometry->Intersection(m_poClipSrc);
+                delete poDstGeometry;
                 if (poClipped == nullptr || poClipped->IsEmpty())
                 {
                     delete poClipped;
-                    goto end_loop;
+                    bSkip = true;
+                    break;
                 }
-                delete poClipped;
+                poDstGeometry = poClipped;
             }
 
-            if( poDstFeature->SetFrom( poFeature, panMap, TRUE ) != OGRERR_NONE )
+            OGRCoordinateTransformation* poCT = papoCT[iGeom];
+            char** papszTransformOptions = papapszTransformOptions[iGeom];
+
+            if( poCT != nullptr || papszTransformOptions != nullptr)
             {
-                if( psOptions->nGroupTransactions )
+                OGRGeometry* poReprojectedGeom =
+                    OGRGeometryFactory::transformWithOptions(
+                        poDstGeometry, poCT, papszTransformOptions, transformWithOptionsCache);
+                if( poReprojectedGeom == nullptr )
                 {
-                    if( psOptions->nLayerTransaction )
+                    // Reported by WriteParts()
+                    oPart.bReprojectionFailed = true;
+                    if( !psOptions->bSkipFailures )
                     {
-                        if( poDstLayer->CommitTransaction() != OGRERR_NONE )
-                        {
-                            OGRFeature::DestroyFeature( poFeature );
-                            OGRFeature::DestroyFeature( poDstFeature );
-                            OGRGeometryFactory::destroyGeometry( poStolenGeometry );
-                            return false;
-                        }
+                        delete poDstGeometry;
+                        return;
                     }
                 }
 
-                CPLError( CE_Failure, CPLE_AppDefined,
-                        "Unable to translate feature " CPL_FRMT_GIB " from layer %s.",
-                        poFeature->GetFID(), poSrcLayer->GetName() );
-
-                OGRFeature::DestroyFeature( poFeature );
-                OGRFeature::DestroyFeature( poDstFeature );
-                OGRGeometryFactory::destroyGeometry( poStolenGeometry );
-                return false;
+                delete poDstGeometry;
+                poDstGeometry = poReprojectedGeom;
             }
-
-            /* ... and now we can attach the stolen geometry */
-            if( poStolenGeometry )
+            else if (poOutputSRS != nullptr)
             {
-                poDstFeature->SetGeometryDirectly(poStolenGeometry);
+                poDstGeometry->assignSpatialReference(poOutputSRS);
             }
 
-            if( bPreserveFID )
-                poDstFeature->SetFID( poFeature->GetFID() );
-            else if( psInfo->iSrcFIDField >= 0 &&
-                     poFeature->IsFieldSetAndNotNull(psInfo->iSrcFIDField))
-                poDstFeature->SetFID( poFeature->GetFieldAsInteger64(psInfo->iSrcFIDField) );
-
-            /* Erase native data if asked explicitly */
-            if( !m_bNativeData )
+            if (m_poClipDst)
             {
-                poDstFeature->SetNativeData(nullptr);
-                poDstFeature->SetNativeMediaType(nullptr);
-            }
-
-            for( int iGeom = 0; iGeom < nDstGeomFieldCount; iGeom ++ )
-            {
-                OGRGeometry* poDstGeometry = poDstFeature->StealGeometry(iGeom);
-                if (poDstGeometry == nullptr)
-                    continue;
-
-                if (nParts > 0)
+                if( poDstGeometry == nullptr )
                 {
-                    /* For -explodecollections, extract the iPart(th) of the geometry */
-                    OGRGeometry* poPart = poDstGeometry->toGeometryCollection()->getGeometryRef(iPart);
-                    poDstGeometry->toGeometryCollection()->removeGeometry(iPart, FALSE);
-                    delete poDstGeometry;
-                    poDstGeometry = poPart;
-                    assert(poDstGeometry);
+                    bSkip = true;
+                    break;
                 }
 
-                if (iSrcZField != -1)
+                OGRGeometry* poClipped = poDstGeometry->Intersection(m_poClipDst);
+                delete poDstGeometry;
+                if (poClipped == nullptr || poClipped->IsEmpty())
                 {
-                    SetZ(poDstGeometry, poFeature->GetFieldAsDouble(iSrcZField));
-                    /* This will correct the coordinate dimension to 3 */
-                    OGRGeometry* poDupGeometry = poDstGeometry->clone();
-                    delete poDstGeometry;
-                    poDstGeometry = poDupGeometry;
+                    delete poClipped;
+                    bSkip = true;
+                    break;
                 }
 
-                if (m_nCoordDim == 2 || m_nCoordDim == 3)
-                {
-                    poDstGeometry->setCoordinateDimension( m_nCoordDim );
-                }
-                else if (m_nCoordDim == 4)
-                {
-                    poDstGeometry->set3D( TRUE );
-                    poDstGeometry->setMeasured( TRUE );
-                }
-                else if (m_nCoordDim == COORD_DIM_XYM)
-                {
-                    poDstGeometry->set3D( FALSE );
-                    poDstGeometry->setMeasured( TRUE );
-                }
-                else if ( m_nCoordDim == COORD_DIM_LAYER_DIM )
-                {
-                    const OGRwkbGeometryType eDstLayerGeomType =
-                      poDstLayer->GetLayerDefn()->GetGeomFieldDefn(iGeom)->GetType();
-                    poDstGeometry->set3D( wkbHasZ(eDstLayerGeomType) );
-                    poDstGeometry->setMeasured( wkbHasM(eDstLayerGeomType) );
-                }
+                poDstGeometry = poClipped;
+            }
 
-                if (m_eGeomOp == GEOMOP_SEGMENTIZE)
+            if( eGType != GEOMTYPE_UNCHANGED )
+            {
+                poDstGeometry = OGRGeometryFactory::forceTo(
+                        poDstGeometry, static_cast<OGRwkbGeometryType>(eGType));
+            }
+            else if( m_eGeomTypeConversion == GTC_PROMOTE_TO_MULTI ||
+                     m_eGeomTypeConversion == GTC_CONVERT_TO_LINEAR ||
+                     m_eGeomTypeConversion == GTC_CONVERT_TO_CURVE )
+            {
+                if( poDstGeometry != nullptr )
                 {
-                    if (m_dfGeomOpParam > 0)
-                        poDstGeometry->segmentize(m_dfGeomOpParam);
+                    OGRwkbGeometryType eTargetType = poDstGeometry->getGeometryType();
+                    eTargetType = ConvertType(m_eGeomTypeConversion, eTargetType);
+                    poDstGeometry = OGRGeometryFactory::forceTo(poDstGeometry, eTargetType);
                 }
-                else if (m_eGeomOp == GEOMOP_SIMPLIFY_PRESERVE_TOPOLOGY)
+            }
+
+            poDstFeature->SetGeomFieldDirectly(iGeom, poDstGeometry);
+        }
+
+        if( !bSkip )
+            oPart.poDstFeature = std::move(poDstFeature);
+    }
+}
+
+/************************************************************************/
+/*                      LayerTranslator::WriteParts()                   */
+/************************************************************************/
+
+// Write the destination feature(s) built by TranslateParts(), and manage
+// transactions. Returns false if the translation must be stopped.
+
+bool LayerTranslator::WriteParts( OGRFeature* poFeature,
+                                  std::vector<TranslatedPart>& aoParts,
+                                  TargetLayerInfo* psInfo,
+                                  int& nFeaturesInTransaction,
+                                  GIntBig& nTotalEventsDone,
+                                  GIntBig& nFeaturesWritten,
+                                  GDALVectorTranslateOptions *psOptions )
+{
+    OGRLayer *poSrcLayer = psInfo->poSrcLayer;
+    OGRLayer *poDstLayer = psInfo->poDstLayer;
+    const bool bPreserveFID = psInfo->bPreserveFID;
+
+    for( auto& oPart: aoParts )
+    {
+        if( psOptions->nLayerTransaction &&
+            ++nFeaturesInTransaction == psOptions->nGroupTransactions )
+        {
+            if( poDstLayer->CommitTransaction() == OGRERR_FAILURE ||
+                poDstLayer->StartTransaction() == OGRERR_FAILURE )
+            {
+                return false;
+            }
+            nFeaturesInTransaction = 0;
+        }
+        else if( !psOptions->nLayerTransaction &&
+                 psOptions->nGroupTransactions >= 0 &&
+                 ++nTotalEventsDone >= psOptions->nGroupTransactions )
+        {
+            if( m_poODS->CommitTransaction() == OGRERR_FAILURE ||
+                    m_poODS->StartTransaction(psOptions->bForceTransaction) == OGRERR_FAILURE )
+            {
+                return false;
+            }
+            nTotalEventsDone = 0;
+        }
+
+        if( oPart.bSetFromFailed )
+        {
+            if( psOptions->nGroupTransactions )
+            {
+                if( psOptions->nLayerTransaction )
                 {
-                    if (m_dfGeomOpParam > 0)
+                    if( poDstLayer->CommitTransaction() != OGRERR_NONE )
                     {
-                        OGRGeometry* poNewGeom = poDstGeometry->SimplifyPreserveTopology(m_dfGeomOpParam);
-                        if (poNewGeom)
-                        {
-                            delete poDstGeometry;
-                            poDstGeometry = poNewGeom;
-                        }
+                        return false;
                     }
                 }
+            }
 
-                if (m_poClipSrc)
+            CPLError( CE_Failure, CPLE_AppDefined,
+                    "Unable to translate feature " CPL_FRMT_GIB " from layer %s.",
+                    poFeature->GetFID(), poSrcLayer->GetName() );
+            return false;
+        }
+
+        if( oPart.bReprojectionFailed )
+        {
+            if( psOptions->nGroupTransactions )
+            {
+                if( psOptions->nLayerTransaction )
                 {
-                    OGRGeometry* poClipped = poDstGeometry->Intersection(m_poClipSrc);
-                    delete poDstGeometry;
-                    if (poClipped == nullptr || poClipped->IsEmpty())
+                    if( poDstLayer->CommitTransaction() != OGRERR_NONE &&
+                        !psOptions->bSkipFailures )
                     {
-                        delete poClipped;
-                        goto end_loop;
+                        return false;
                     }
-                    poDstGeometry = poClipped;
                 }
+            }
 
-                OGRCoordinateTransformation* poCT = psInfo->papoCT[iGeom];
-                char** papszTransformOptions = psInfo->papapszTransformOptions[iGeom];
+            CPLError( CE_Failure, CPLE_AppDefined, "Failed to reproject feature " CPL_FRMT_GIB " (geometry probably out of source or destination SRS).",
+                      poFeature->GetFID() );
+            if( !psOptions->bSkipFailures )
+            {
+                return false;
+            }
+        }
 
-                if( poCT != nullptr || papszTransformOptions != nullptr)
-                {
-                    OGRGeometry* poReprojectedGeom =
-                        OGRGeometryFactory::transformWithOptions(
-                            poDstGeometry, poCT, papszTransformOptions, transformWithOptionsCache);
-                    if( poReprojectedGeom == nullptr )
-                    {
-                        if( psOptions->nGroupTransactions )
-                        {
-                            if( psOptions->nLayerTransaction )
-                            {
-                                if( poDstLayer->CommitTransaction() != OGRERR_NONE &&
-                                    !psOptions->bSkipFailures )
-                                {
-                                    OGRFeature::DestroyFeature( poFeature );
-                                    OGRFeature::DestroyFeature( poDstFeature );
-                                    delete poDstGeometry;
-                                    return false;
-                                }
-                            }
-                        }
+        // Clipped out.
+        OGRFeature* poDstFeature = oPart.poDstFeature.get();
+        if( poDstFeature == nullptr )
+            continue;
 
-                        CPLError( CE_Failure, CPLE_AppDefined, "Failed to reproject feature " CPL_FRMT_GIB " (geometry probably out of source or destination SRS).",
-                                  poFeature->GetFID() );
-                        if( !psOptions->bSkipFailures )
-                        {
-                            OGRFeature::DestroyFeature( poFeature );
-                            OGRFeature::DestroyFeature( poDstFeature );
-                            delete poDstGeometry;
-                            return false;
-                        }
-                    }
+        CPLErrorReset();
+        if( poDstLayer->CreateFeature( poDstFeature ) == OGRERR_NONE )
+        {
+            nFeaturesWritten ++;
+            if( (bPreserveFID && poDstFeature->GetFID() != poFeature->GetFID()) ||
+                (!bPreserveFID && psInfo->iSrcFIDField >= 0 && poFeature->IsFieldSetAndNotNull(psInfo->iSrcFIDField) &&
+                 poDstFeature->GetFID() != poFeature->GetFieldAsInteger64(psInfo->iSrcFIDField)) )
+            {
+                CPLError( CE_Warning, CPLE_AppDefined,
+                          "Feature id not preserved");
+            }
+        }
+        else if( !psOptions->bSkipFailures )
+        {
+            if( psOptions->nGroupTransactions )
+            {
+                if( psOptions->nLayerTransaction )
+                    poDstLayer->RollbackTransaction();
+            }
 
-                    delete poDstGeometry;
-                    poDstGeometry = poReprojectedGeom;
+            CPLError( CE_Failure, CPLE_AppDefined,
+                    "Unable to write feature " CPL_FRMT_GIB " from layer %s.",
+                    poFeature->GetFID(), poSrcLayer->GetName() );
+            return false;
+        }
+        else
+        {
+            CPLDebug( "GDALVectorTranslate", "Unable to write feature " CPL_FRMT_GIB " into layer %s.",
+                       poFeature->GetFID(), poSrcLayer->GetName() );
+            if( psOptions->nGroupTransactions )
+            {
+                if( psOptions->nLayerTransaction )
+                {
+                    poDstLayer->RollbackTransaction();
+                    CPL_IGNORE_RET_VAL(poDstLayer->StartTransaction());
                 }
-                else if (poOutputSRS != nullptr)
+                else
                 {
-                    poDstGeometry->assignSpatialReference(poOutputSRS);
+                    m_poODS->RollbackTransaction();
+                    m_poODS->StartTransaction(psOptions->bForceTransaction);
                 }
+            }
+        }
+    }
 
-                if (m_poClipDst)
-                {
-                    if( poDstGeometry == nullptr )
-                        goto end_loop;
+    return true;
+}
 
-                    OGRGeometry* poClipped = poDstGeometry->Intersection(m_poClipDst);
-                    delete poDstGeometry;
-                    if (poClipped == nullptr || poClipped->IsEmpty())
-                    {
-                        delete poClipped;
-                        goto end_loop;
-                    }
+/************************************************************************/
+/*                        LayerTranslatorPipeline                       */
+/************************************************************************/
 
-                    poDstGeometry = poClipped;
-                }
+// Multi-threaded translation of a layer, for -nt. A reader thread fetches
+// batches of source features, which are processed by a pool of worker
+// threads with TranslateParts(), and the calling thread gets the results
+// with GetNext(), in the order of the source layer, to write them.
+// The number of batches in flight is bounded.
 
-                if( eGType != GEOMTYPE_UNCHANGED )
-                {
-                    poDstGeometry = OGRGeometryFactory::forceTo(
-                            poDstGeometry, static_cast<OGRwkbGeometryType>(eGType));
-                }
-                else if( m_eGeomTypeConversion == GTC_PROMOTE_TO_MULTI ||
-                         m_eGeomTypeConversion == GTC_CONVERT_TO_LINEAR ||
-                         m_eGeomTypeConversion == GTC_CONVERT_TO_CURVE )
-                {
-                    if( poDstGeometry != nullptr )
-                    {
-                        OGRwkbGeometryType eTargetType = poDstGeometry->getGeometryType();
-                        eTargetType = ConvertType(m_eGeomTypeConversion, eTargetType);
-                        poDstGeometry = OGRGeometryFactory::forceTo(poDstGeometry, eTargetType);
-                    }
-                }
+class LayerTranslatorPipeline
+{
+    struct ErrorRecord
+    {
+        CPLErr      eErrClass;
+        CPLErrorNum nErrNo;
+        CPLString   osMsg;
+    };
+
+    struct Job
+    {
+        LayerTranslatorPipeline*                  poPipeline = nullptr;
+        std::vector<OGRFeature*>                  apoSrcFeatures{};
+        std::vector<std::vector<TranslatedPart>>  aaoParts{};
+        std::vector<ErrorRecord>                  asErrors{};
+        bool                                      bFinished = false;
+
+        Job() = default;
+        ~Job()
+        {
+            for( auto poFeature: apoSrcFeatures )
+                OGRFeature::DestroyFeature(poFeature);
+        }
+
+        CPL_DISALLOW_COPY_ASSIGN(Job)
+    };
+
+    // Coordinate transformations are not thread-safe, so each worker
+    // thread uses its own ones.
+    struct WorkerContext
+    {
+        TargetLayerInfo*                              psCTInfo = nullptr;
+        OGRGeometryFactory::TransformWithOptionsCache oCache{};
+    };
+
+    static const size_t knFeaturesPerJob = 256;
 
-                poDstFeature->SetGeomFieldDirectly(iGeom, poDstGeometry);
+    LayerTranslator*              m_poTranslator;
+    TargetLayerInfo*              m_psInfo;
+    OGRSpatialReference*          m_poOutputSRS;
+    GDALVectorTranslateOptions*   m_psOptions;
+    int                           m_nThreads;
+
+    std::unique_ptr<CPLJobQueue>                    m_poJobQueue{};
+    std::vector<std::unique_ptr<WorkerContext>>     m_apoContexts{};
+    std::vector<WorkerContext*>                     m_apoFreeContexts{};
+    std::mutex                                      m_oContextMutex{};
+
+    CPLJoinableThread*                 m_hReaderThread = nullptr;
+    std::vector<ErrorRecord>           m_asReaderErrors{};
+    bool                               m_bReadError = false;
+
+    std::mutex                         m_oMutex{};
+    std::condition_variable            m_oCV{};
+    std::deque<std::unique_ptr<Job>>   m_apoJobs{};
+    size_t                             m_nMaxPendingJobs;
+    // Jobs submitted and not finished. Bounded by m_nThreads, as each of
+    // them uses a WorkerContext, and the shared pool may have more threads.
+    int                                m_nRunningJobs = 0;
+    bool                               m_bReaderDone = false;
+    std::atomic<bool>                  m_bStop{false};
+
+    std::unique_ptr<Job>               m_poCurJob{};
+    size_t                             m_iCurFeature = 0;
+
+    CPL_DISALLOW_COPY_ASSIGN(LayerTranslatorPipeline)
+
+    static void CPL_STDCALL ErrorHandler( CPLErr eErrClass,
+                                          CPLErrorNum nErrNo,
+                                          const char* pszMsg );
+    static void ReaderThreadFunc( void* pData );
+    static void JobFunc( void* pData );
+
+    bool    SubmitJob( std::unique_ptr<Job>&& poJob );
+    void    Read();
+    void    Stop();
+
+  public:
+    LayerTranslatorPipeline( LayerTranslator* poTranslator,
+                             TargetLayerInfo* psInfo,
+                             OGRSpatialReference* poOutputSRS,
+                             GDALVectorTranslateOptions* psOptions ) :
+        m_poTranslator(poTranslator),
+        m_psInfo(psInfo),
+        m_poOutputSRS(poOutputSRS),
+        m_psOptions(psOptions),
+        m_nThreads(psOptions->nNumThreads),
+        m_nMaxPendingJobs(2 * static_cast<size_t>(psOptions->nNumThreads))
+    {}
+
+    ~LayerTranslatorPipeline();
+
+    bool    Start( OGRFeature* poFirstFeature );
+    bool    GetNext( OGRFeature*& poFeature,
+                     std::vector<TranslatedPart>& aoParts );
+    bool    HasReadError() const { return m_bReadError; }
+};
+
+/************************************************************************/
+/*                 LayerTranslatorPipeline::ErrorHandler()              */
+/************************************************************************/
+
+// Errors emitted in the reader and worker threads are collected, and
+// re-emitted by the calling thread in GetNext().
+void CPL_STDCALL LayerTranslatorPipeline::ErrorHandler( CPLErr eErrClass,
+                                                        CPLErrorNum nErrNo,
+                                                        const char* pszMsg )
+{
+    std::vector<ErrorRecord>* pasErrors =
+        static_cast<std::vector<ErrorRecord>*>(CPLGetErrorHandlerUserData());
+    ErrorRecord sError;
+    sError.eErrClass = eErrClass;
+    sError.nErrNo = nErrNo;
+    sError.osMsg = pszMsg;
+    pasErrors->push_back(sError);
+}
+
+/************************************************************************/
+/*                    LayerTranslatorPipeline::Start()                  */
+/************************************************************************/
+
+// On success, takes ownership of poFirstFeature, which will be returned by
+// the first call to GetNext().
+bool LayerTranslatorPipeline::Start( OGRFeature* poFirstFeature )
+{
+    CPLWorkerThreadPool* poPool = CPLGetGlobalWorkerThreadPool(m_nThreads);
+    if( poPool == nullptr )
+        return false;
+    m_nThreads = std::min(m_nThreads, poPool->GetThreadCount());
+
+    const int nDstGeomFieldCount = m_psInfo->nDstGeomFieldCount;
+    for( int i = 0; i < m_nThreads; i++ )
+    {
+        std::unique_ptr<WorkerContext> poContext(new WorkerContext());
+        TargetLayerInfo* psCTInfo = static_cast<TargetLayerInfo *>(
+            CPLMalloc(sizeof(TargetLayerInfo)));
+        *psCTInfo = *m_psInfo;
+        psCTInfo->nFeaturesRead = 0;
+        psCTInfo->panMap = nullptr;
+        psCTInfo->papoCT = static_cast<OGRCoordinateTransformation **>(
+            CPLCalloc(nDstGeomFieldCount,
+                      sizeof(OGRCoordinateTransformation*)));
+        psCTInfo->papapszTransformOptions = static_cast<char ***>(
+            CPLCalloc(nDstGeomFieldCount, sizeof(char**)));
+        poContext->psCTInfo = psCTInfo;
+        m_apoFreeContexts.push_back(poContext.get());
+        m_apoContexts.push_back(std::move(poContext));
+
+        if( !SetupCT( psCTInfo, m_psInfo->poSrcLayer,
+                      m_poTranslator->m_bTransform,
+                      m_poTranslator->m_bWrapDateline,
+                      m_poTranslator->m_osDateLineOffset,
+                      m_poTranslator->m_poUserSourceSRS,
+                      poFirstFeature, m_poOutputSRS,
+                      m_poTranslator->m_poGCPCoordTrans) )
+        {
+            return false;
+        }
+    }
+
+    m_poJobQueue = poPool->CreateJobQueue(m_nThreads);
+
+    std::unique_ptr<Job> poJob(new Job());
+    poJob->apoSrcFeatures.push_back(poFirstFeature);
+    if( !SubmitJob(std::move(poJob)) )
+    {
+        // Do not free poFirstFeature, as the caller keeps its ownership.
+        m_apoJobs.back()->apoSrcFeatures.clear();
+        return false;
+    }
+
+    m_hReaderThread = CPLCreateJoinableThread(ReaderThreadFunc, this);
+    if( m_hReaderThread == nullptr )
+    {
+        // The first job is already submitted, so we cannot fallback to the
+        // single-threaded mode.
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot create reading thread");
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_bReadError = true;
+        m_bReaderDone = true;
+    }
+
+    CPLDebug("GDALVectorTranslate",
+             "Using %d threads to translate layer %s", m_nThreads,
+             m_psInfo->poSrcLayer->GetName());
+    return true;
+}
+
+/************************************************************************/
+/*                  LayerTranslatorPipeline::SubmitJob()                */
+/************************************************************************/
+
+bool LayerTranslatorPipeline::SubmitJob( std::unique_ptr<Job>&& poJob )
+{
+    Job* psJob = poJob.get();
+    psJob->poPipeline = this;
+    psJob->aaoParts.resize(psJob->apoSrcFeatures.size());
+    {
+        std::unique_lock<std::mutex> oLock(m_oMutex);
+        m_oCV.wait(oLock, [this]{
+            return m_bStop || (m_apoJobs.size() < m_nMaxPendingJobs &&
+                               m_nRunningJobs < m_nThreads); });
+        if( m_bStop )
+            return false;
+        m_apoJobs.push_back(std::move(poJob));
+        m_nRunningJobs++;
+    }
+    if( !m_poJobQueue->SubmitJob(JobFunc, psJob) )
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        psJob->bFinished = true;
+        m_nRunningJobs--;
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*              LayerTranslatorPipeline::ReaderThreadFunc()             */
+/************************************************************************/
+
+void LayerTranslatorPipeline::ReaderThreadFunc( void* pData )
+{
+    static_cast<LayerTranslatorPipeline*>(pData)->Read();
+}
+
+/************************************************************************/
+/*                    LayerTranslatorPipeline::Read()                   */
+/************************************************************************/
+
+void LayerTranslatorPipeline::Read()
+{
+    OGRLayer* poSrcLayer = m_psInfo->poSrcLayer;
+    const GIntBig nLimit = m_poTranslator->m_nLimit;
+
+    CPLPushErrorHandlerEx(ErrorHandler, &m_asReaderErrors);
+    bool bEOF = false;
+    while( !bEOF && !m_bStop )
+    {
+        std::unique_ptr<Job> poJob(new Job());
+        while( poJob->apoSrcFeatures.size() < knFeaturesPerJob && !m_bStop )
+        {
+            if( nLimit >= 0 && m_psInfo->nFeaturesRead >= nLimit )
+            {
+                bEOF = true;
+                break;
             }
 
             CPLErrorReset();
-            if( poDstLayer->CreateFeature( poDstFeature ) == OGRERR_NONE )
+            OGRFeature* poFeature = poSrcLayer->GetNextFeature();
+            if( poFeature == nullptr )
             {
-                nFeaturesWritten ++;
-                if( (bPreserveFID && poDstFeature->GetFID() != poFeature->GetFID()) ||
-                    (!bPreserveFID && psInfo->iSrcFIDField >= 0 && poFeature->IsFieldSetAndNotNull(psInfo->iSrcFIDField) &&
-                     poDstFeature->GetFID() != poFeature->GetFieldAsInteger64(psInfo->iSrcFIDField)) )
-                {
-                    CPLError( CE_Warning, CPLE_AppDefined,
-                              "Feature id not preserved");
-                }
+                if( CPLGetLastErrorType() == CE_Failure )
+                    m_bReadError = true;
+                bEOF = true;
+                break;
             }
-            else if( !psOptions->bSkipFailures )
+
+            m_psInfo->nFeaturesRead ++;
+            poJob->apoSrcFeatures.push_back(poFeature);
+        }
+
+        poJob->asErrors = std::move(m_asReaderErrors);
+        m_asReaderErrors.clear();
+        if( poJob->apoSrcFeatures.empty() && poJob->asErrors.empty() )
+            break;
+        if( !SubmitJob(std::move(poJob)) )
+            break;
+    }
+    CPLPopErrorHandler();
+
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_bReaderDone = true;
+    }
+    m_oCV.notify_all();
+}
+
+/************************************************************************/
+/*                   LayerTranslatorPipeline::JobFunc()                 */
+/************************************************************************/
+
+void LayerTranslatorPipeline::JobFunc( void* pData )
+{
+    Job* psJob = static_cast<Job*>(pData);
+    LayerTranslatorPipeline* poThis = psJob->poPipeline;
+
+    WorkerContext* poContext;
+    {
+        std::lock_guard<std::mutex> oLock(poThis->m_oContextMutex);
+        CPLAssert( !poThis->m_apoFreeContexts.empty() );
+        poContext = poThis->m_apoFreeContexts.back();
+        poThis->m_apoFreeContexts.pop_back();
+    }
+
+    CPLPushErrorHandlerEx(ErrorHandler, &psJob->asErrors);
+    for( size_t i = 0; i < psJob->apoSrcFeatures.size() && !poThis->m_bStop;
+         i++ )
+    {
+        poThis->m_poTranslator->TranslateParts(
+            psJob->apoSrcFeatures[i], poThis->m_psInfo,
+            poContext->psCTInfo->papoCT,
+            poContext->psCTInfo->papapszTransformOptions,
+            poThis->m_poOutputSRS,
+            poContext->oCache,
+            poThis->m_psOptions,
+            psJob->aaoParts[i]);
+    }
+    CPLPopErrorHandler();
+
+    {
+        std::lock_guard<std::mutex> oLock(poThis->m_oContextMutex);
+        poThis->m_apoFreeContexts.push_back(poContext);
+    }
+    {
+        std::lock_guard<std::mutex> oLock(poThis->m_oMutex);
+        psJob->bFinished = true;
+        poThis->m_nRunningJobs--;
+    }
+    poThis->m_oCV.notify_all();
+}
+
+/************************************************************************/
+/*                   LayerTranslatorPipeline::GetNext()                 */
+/************************************************************************/
+
+// Returns the next source feature, and its translated parts. The caller
+// takes ownership of poFeature.
+bool LayerTranslatorPipeline::GetNext( OGRFeature*& poFeature,
+                                       std::vector<TranslatedPart>& aoParts )
+{
+    while( true )
+    {
+        if( m_poCurJob &&
+            m_iCurFeature < m_poCurJob->apoSrcFeatures.size() )
+        {
+            poFeature = m_poCurJob->apoSrcFeatures[m_iCurFeature];
+            m_poCurJob->apoSrcFeatures[m_iCurFeature] = nullptr;
+            aoParts = std::move(m_poCurJob->aaoParts[m_iCurFeature]);
+            m_iCurFeature ++;
+            return true;
+        }
+
+        m_poCurJob.reset();
+        {
+            std::unique_lock<std::mutex> oLock(m_oMutex);
+            m_oCV.wait(oLock, [this]{
+                return (!m_apoJobs.empty() && m_apoJobs.front()->bFinished) ||
+                       (m_apoJobs.empty() && m_bReaderDone); });
+            if( m_apoJobs.empty() )
+                return false;
+            m_poCurJob = std::move(m_apoJobs.front());
+            m_apoJobs.pop_front();
+        }
+        // Let the reader thread submit a new job.
+        m_oCV.notify_all();
+
+        m_iCurFeature = 0;
+        for( const auto& sError: m_poCurJob->asErrors )
+        {
+            CPLError(sError.eErrClass, sError.nErrNo, "%s",
+                     sError.osMsg.c_str());
+        }
+    }
+}
+
+/************************************************************************/
+/*                    LayerTranslatorPipeline::Stop()                   */
+/************************************************************************/
+
+void LayerTranslatorPipeline::Stop()
+{
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_bStop = true;
+    }
+    m_oCV.notify_all();
+    if( m_hReaderThread )
+    {
+        CPLJoinThread(m_hReaderThread);
+        m_hReaderThread = nullptr;
+    }
+    if( m_poJobQueue )
+        m_poJobQueue->WaitCompletion();
+}
+
+/************************************************************************/
+/*              LayerTranslatorPipeline::~LayerTranslatorPipeline()     */
+/************************************************************************/
+
+LayerTranslatorPipeline::~LayerTranslatorPipeline()
+{
+    Stop();
+    m_poCurJob.reset();
+    m_apoJobs.clear();
+    for( auto& poContext: m_apoContexts )
+        FreeTargetLayerInfo(poContext->psCTInfo);
+}
+
+/************************************************************************/
+/*                     LayerTranslator::Translate()                     */
+/************************************************************************/
+
+int LayerTranslator::Translate( OGRFeature* poFeatureIn,
+                                TargetLayerInfo* psInfo,
+                                GIntBig nCountLayerFeatures,
+                                GIntBig* pnReadFeatureCount,
+                                GIntBig& nTotalEventsDone,
+                                GDALProgressFunc pfnProgress,
+                                void *pProgressArg,
+                                GDALVectorTranslateOptions *psOptions )
+{
+    OGRSpatialReference* poOutputSRS = m_poOutputSRS;
+
+    OGRLayer *poSrcLayer = psInfo->poSrcLayer;
+    OGRLayer *poDstLayer = psInfo->poDstLayer;
+    const int nSrcGeomFieldCount = poSrcLayer->GetLayerDefn()->GetGeomFieldCount();
+
+    if( poOutputSRS == nullptr && !m_bNullifyOutputSRS )
+    {
+        if( nSrcGeomFieldCount == 1 )
+        {
+            poOutputSRS = poSrcLayer->GetSpatialRef();
+        }
+        else if( psInfo->iRequestedSrcGeomField > 0 )
+        {
+            poOutputSRS = poSrcLayer->GetLayerDefn()->GetGeomFieldDefn(
+                psInfo->iRequestedSrcGeomField)->GetSpatialRef();
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Transfer features.                                              */
+/* -------------------------------------------------------------------- */
+    if( psOptions->nGroupTransactions )
+    {
+        if( psOptions->nLayerTransaction )
+        {
+            if( poDstLayer->StartTransaction() == OGRERR_FAILURE )
+                return false;
+        }
+    }
+
+    OGRFeature *poFeature = nullptr;
+    int         nFeaturesInTransaction = 0;
+    GIntBig      nCount = 0; /* written + failed */
+    GIntBig      nFeaturesWritten = 0;
+
+    // With -nt, the pipeline is started once the coordinate
+    // transformation has been set up from the first feature.
+    bool bTryMultiThreading = psOptions->nNumThreads > 1 &&
+                              poFeatureIn == nullptr &&
+                              psOptions->nFIDToFetch == OGRNullFID;
+    std::unique_ptr<LayerTranslatorPipeline> poPipeline;
+
+    bool bRet = true;
+    CPLErrorReset();
+    OGRGeometryFactory::TransformWithOptionsCache transformWithOptionsCache;
+    std::vector<TranslatedPart> aoParts;
+    while( true )
+    {
+        aoParts.clear();
+
+        if( poPipeline )
+        {
+            if( !poPipeline->GetNext(poFeature, aoParts) )
             {
-                if( psOptions->nGroupTransactions )
-                {
-                    if( psOptions->nLayerTransaction )
-                        poDstLayer->RollbackTransaction();
-                }
+                if( poPipeline->HasReadError() )
+                    bRet = false;
+                break;
+            }
+            goto write_parts;
+        }
 
-                CPLError( CE_Failure, CPLE_AppDefined,
-                        "Unable to write feature " CPL_FRMT_GIB " from layer %s.",
-                        poFeature->GetFID(), poSrcLayer->GetName() );
+        if( m_nLimit >= 0 && psInfo->nFeaturesRead >= m_nLimit )
+        {
+            break;
+        }
+
+        if( poFeatureIn != nullptr )
+            poFeature = poFeatureIn;
+        else if( psOptions->nFIDToFetch != OGRNullFID )
+            poFeature = poSrcLayer->GetFeature(psOptions->nFIDToFetch);
+        else
+            poFeature = poSrcLayer->GetNextFeature();
+
+        if( poFeature == nullptr )
+        {
+            if( CPLGetLastErrorType() == CE_Failure )
+            {
+                bRet = false;
+            }
+            break;
+        }
 
+        if( psInfo->nFeaturesRead == 0 || psInfo->bPerFeatureCT )
+        {
+            if( !SetupCT( psInfo, poSrcLayer, m_bTransform, m_bWrapDateline,
+                          m_osDateLineOffset, m_poUserSourceSRS,
+                          poFeature, poOutputSRS, m_poGCPCoordTrans) )
+            {
                 OGRFeature::DestroyFeature( poFeature );
-                OGRFeature::DestroyFeature( poDstFeature );
                 return false;
             }
+        }
+
+        psInfo->nFeaturesRead ++;
+
+        if( bTryMultiThreading )
+        {
+            bTryMultiThreading = false;
+            // Reading and writing are done in different threads, and
+            // per-feature or GCP based coordinate transformations
+            // cannot be duplicated for each worker thread.
+            if( m_poSrcDS == m_poODS || psInfo->bPerFeatureCT ||
+                m_poGCPCoordTrans != nullptr )
+            {
+                CPLDebug("GDALVectorTranslate",
+                         "Multi-threaded translation not possible for "
+                         "layer %s", poSrcLayer->GetName());
+            }
             else
             {
-                CPLDebug( "GDALVectorTranslate", "Unable to write feature " CPL_FRMT_GIB " into layer %s.",
-                           poFeature->GetFID(), poSrcLayer->GetName() );
-                if( psOptions->nGroupTransactions )
-                {
-                    if( psOptions->nLayerTransaction )
-                    {
-                        poDstLayer->RollbackTransaction();
-                        CPL_IGNORE_RET_VAL(poDstLayer->StartTransaction());
-                    }
-                    else
-                    {
-                        m_poODS->RollbackTransaction();
-                        m_poODS->StartTransaction(psOptions->bForceTransaction);
-                    }
-                }
+                poPipeline.reset(new LayerTranslatorPipeline(
+                    this, psInfo, poOutputSRS, psOptions));
+                if( poPipeline->Start(poFeature) )
+                    continue;
+                poPipeline.reset();
             }
-
-end_loop:
-            OGRFeature::DestroyFeature( poDstFeature );
         }
 
+        TranslateParts( poFeature, psInfo,
+                        psInfo->papoCT, psInfo->papapszTransformOptions,
+                        poOutputSRS, transformWithOptionsCache,
+                        psOptions, aoParts );
+
+write_parts:
+        const bool bWriteOK = WriteParts( poFeature, aoParts, psInfo,
+                                          nFeaturesInTransaction,
+                                          nTotalEventsDone, nFeaturesWritten,
+                                          psOptions );
         OGRFeature::DestroyFeature( poFeature );
+        if( !bWriteOK )
+            return false;
 
         /* Report progress */
         nCount ++;
@@ -4924,6 +5503,7 @@ end_loop:
         if( poFeatureIn != nullptr )
             break;
     }
+    poPipeline.reset();
 
     if( psOptions->nGroupTransactions )
     {
@@ -5004,6 +5584,7 @@ GDALVectorTranslateOptions *GDALVectorTranslateOptionsNew(char** papszArgv,
     psOptions->nGroupTransactions = 20000;
     psOptions->nFIDToFetch = OGRNullFID;
     psOptions->bQuiet = false;
+    psOptions->nNumThreads = 1;
     psOptions->pszFormat = nullptr;
     psOptions->papszLayers = nullptr;
     psOptions->papszDSCO = nullptr;
@@ -5239,6 +5820,10 @@ GDALVectorTranslateOptions *GDALVectorTranslateOptionsNew(char** papszArgv,
                     psOptions->nGroupTransactions = atoi(papszArgv[i]);
             }
         }
+        else if( i+1 < nArgc && EQUAL(papszArgv[i],"-nt") )
+        {
+            psOptions->nNumThreads = CPLGetNumThreads(papszArgv[++i]);
+        }
         else if ( EQUAL(papszArgv[i],"-ds_transaction") )
         {
             psOptions->nLayerTransaction = FALSE;
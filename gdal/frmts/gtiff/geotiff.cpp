@@ -55,6 +55,7 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -109,8 +110,6 @@
 CPL_CVSID("$Id$")
 
 static bool bGlobalInExternalOvr = false;
-static std::mutex gMutexThreadPool;
-CPLWorkerThreadPool *gpoCompressThreadPool = nullptr;
 
 // Only libtiff 4.0.4 can handle between 32768 and 65535 directories.
 #if TIFFLIB_VERSION >= 20120922
@@ -252,6 +251,37 @@ typedef struct
     bool          bTIFFIsBigEndian;
     bool          bReady;
 } GTiffCompressionJob;
+
+struct GTiffDecompressionError
+{
+    CPLErr        eErrClass = CE_None;
+    CPLErrorNum   nErrNo = CPLE_None;
+    CPLString     osMsg{};
+};
+
+struct GTiffDecompressionJob
+{
+    vsi_l_offset  nOffset = 0;
+    GByte        *pabyCompressedBuffer = nullptr;
+    GPtrDiff_t    nCompressedBufferSize = 0;
+    GByte        *pabyBuffer = nullptr;
+    GPtrDiff_t    nBufferSize = 0;
+    GPtrDiff_t    nReqSize = 0;
+    int           nBlockId = 0;
+    int           nXBlock = 0;
+    int           nYBlock = 0;
+    int           nBand = 0;  // 0 for pixel-interleaved blocks (all bands)
+    bool          bSuccess = false;
+    // Errors emitted while decoding, emitted again by the calling thread.
+    std::vector<GTiffDecompressionError> asErrors{};
+};
+
+typedef struct
+{
+    std::vector<GTiffDecompressionJob> *pasJobs;
+    std::atomic<int>                   *pnNextJob;
+    TIFF                               *hTIFF;  // Owned by the dataset.
+} GTiffDecompressionWorker;
 #if !defined(__MINGW32__)
 }
 #endif
@@ -306,8 +336,13 @@ private:
     CPLVirtualMem        *m_pBaseMapping = nullptr;
     GByte                *m_pTempBufferForCommonDirectIO = nullptr;
     CPLVirtualMem        *m_psVirtualMemIOMapping = nullptr;
-    CPLWorkerThreadPool  *m_poCompressThreadPool = nullptr;
+    std::unique_ptr<CPLJobQueue> m_poCompressQueue{};
     CPLMutex             *m_hCompressThreadPoolMutex = nullptr;
+    // Shared pool used for decompression, not owned.
+    CPLWorkerThreadPool  *m_poDecompressThreadPool = nullptr;
+    // TIFF handles on the same directory as m_hTIFF, only used for decoding
+    // in worker threads.
+    std::vector<TIFF*>    m_ahDecompressTIFF{};
 
 #ifdef SUPPORTS_GET_OFFSET_BYTECOUNT
     lru11::Cache<int, std::pair<vsi_l_offset, vsi_l_offset>> m_oCacheStrileToOffsetByteCount{1024};
@@ -337,6 +372,7 @@ private:
     int         m_nLastWrittenBlockId = -1; // used for m_bStreamingOut
     int         m_nRefBaseMapping = 0;
     int         m_nGCPCount = 0;
+    int         m_nDecompressThreads = 0;
 
     GTIFFKeysFlavorEnum m_eGeoTIFFKeysFlavor = GEOTIFF_KEYS_STANDARD;
     GeoTIFFVersionEnum m_eGeoTIFFVersion = GEOTIFF_VERSION_AUTO;
@@ -379,6 +415,7 @@ private:
     };
 
     VirtualMemIOEnum m_eVirtualMemIOUsage = VirtualMemIOEnum::NO;
+    bool m_bFileMappingFailed = false;
 
     GTiffProfile m_eProfile = GTiffProfile::GDALGEOTIFF;
 
@@ -416,6 +453,7 @@ private:
     bool        m_bFillEmptyTilesAtClosing:1;
     bool        m_bTreatAsSplit:1;
     bool        m_bTreatAsSplitBitmap:1;
+    bool        m_bTreatAsRGBA:1;
     bool        m_bClipWarn:1;
     bool        m_bIMDRPCMetadataLoaded:1;
     bool        m_bEXIFMetadataLoaded:1;
@@ -501,6 +539,7 @@ private:
     void           DiscardLsb(GByte* pabyBuffer, GPtrDiff_t nBytes, int iBand) const;
     void           GetDiscardLsbOption( char** papszOptions );
     void           InitCompressionThreads( char** papszOptions );
+    void           InitDecompressionThreads( char** papszOptions );
     void           InitCreationOrOpenOptions( char** papszOptions );
     static void    ThreadCompressionFunc( void* pData );
     void           WaitCompletionForJobIdx( int i );
@@ -511,6 +550,15 @@ private:
     bool           SubmitCompressionJob( int nStripOrTile, GByte* pabyData,
                                          GPtrDiff_t cc, int nHeight) ;
 
+    static void    ThreadDecompressionFunc( void* pData );
+    bool           IsMultiThreadedReadCompatible();
+    int            GetMultiThreadedReadBlockRows( int nXOff, int nXSize,
+                                                  int nBandCount );
+    CPLErr         PreloadBlocksMultiThreaded( int nXOff, int nYOff,
+                                               int nXSize, int nYSize,
+                                               int nBandCount,
+                                               const int* panBandMap );
+
     int            GuessJPEGQuality( bool& bOutHasQuantizationTable,
                                      bool& bOutHasHuffmanTable );
 
@@ -525,6 +573,7 @@ private:
                              GSpacing nBandSpace,
                              GDALRasterIOExtraArg* psExtraArg );
 
+    GByte*         GetFileMapping( size_t& nMappingSize );
     int            VirtualMemIO( GDALRWFlag eRWFlag,
                                  int nXOff, int nYOff, int nXSize, int nYSize,
                                  void * pData, int nBufXSize, int nBufYSize,
@@ -1240,6 +1289,9 @@ public:
                                                int *pnPixelSpace,
                                                GIntBig *pnLineSpace,
                                                char **papszOptions )  override final;
+    virtual const void     *GetMappedBlock( int nXBlockOff, int nYBlockOff,
+                                            GSpacing *pnPixelSpace,
+                                            GSpacing *pnLineSpace ) override final;
 
     GDALRasterAttributeTable* GetDefaultRAT() override final;
     virtual CPLErr  GetHistogram(
@@ -1875,6 +1927,76 @@ void GTiffRasterBand::DropReferenceVirtualMem( void* pUserData )
     CPLFree(pUserData);
 }
 
+/************************************************************************/
+/*                           GetMappedBlock()                           */
+/************************************************************************/
+
+const void *GTiffRasterBand::GetMappedBlock( int nXBlockOff, int nYBlockOff,
+                                             GSpacing *pnPixelSpace,
+                                             GSpacing *pnLineSpace )
+{
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDataType);
+    const int l_nBlocksPerRow = DIV_ROUND_UP(nRasterXSize, nBlockXSize);
+    const int l_nBlocksPerColumn = DIV_ROUND_UP(nRasterYSize, nBlockYSize);
+    if( m_poGDS->eAccess != GA_ReadOnly || m_poGDS->m_bStreamingIn ||
+        m_poGDS->m_nCompression != COMPRESSION_NONE ||
+        m_poGDS->m_nPhotometric == PHOTOMETRIC_YCBCR ||
+        m_poGDS->m_nBitsPerSample != nDTSize * 8 ||
+        (TIFFIsByteSwapped(m_poGDS->m_hTIFF) && nDTSize > 1) ||
+        // Exclude bands whose blocks are not TIFF strips or tiles, such as
+        // split strips.
+        nBlockXSize != m_poGDS->m_nBlockXSize ||
+        nBlockYSize != m_poGDS->m_nBlockYSize ||
+        nXBlockOff < 0 || nYBlockOff < 0 ||
+        nXBlockOff >= l_nBlocksPerRow || nYBlockOff >= l_nBlocksPerColumn )
+    {
+        return nullptr;
+    }
+
+    int nBlockId = nXBlockOff + nYBlockOff * l_nBlocksPerRow;
+    if( m_poGDS->m_nPlanarConfig == PLANARCONFIG_SEPARATE )
+        nBlockId += (nBand - 1) * m_poGDS->m_nBlocksPerBand;
+
+    vsi_l_offset nOffset = 0;
+    vsi_l_offset nSize = 0;
+    if( !m_poGDS->IsBlockAvailable(nBlockId, &nOffset, &nSize) )
+        return nullptr;
+
+    GSpacing nPixelSpace = nDTSize;
+    vsi_l_offset nBandOffset = 0;
+    if( m_poGDS->m_nPlanarConfig == PLANARCONFIG_CONTIG )
+    {
+        nPixelSpace *= m_poGDS->nBands;
+        nBandOffset = static_cast<vsi_l_offset>(nBand - 1) * nDTSize;
+    }
+    const GSpacing nLineSpace = nPixelSpace * nBlockXSize;
+
+    // Only the part of edge blocks inside the raster is required to be
+    // present, as strips at the bottom are generally truncated.
+    const int nValidXSize =
+        std::min(nBlockXSize, nRasterXSize - nXBlockOff * nBlockXSize);
+    const int nValidYSize =
+        std::min(nBlockYSize, nRasterYSize - nYBlockOff * nBlockYSize);
+    const vsi_l_offset nRequiredSize =
+        static_cast<vsi_l_offset>(nValidYSize - 1) * nLineSpace +
+        static_cast<vsi_l_offset>(nValidXSize - 1) * nPixelSpace +
+        nBandOffset + nDTSize;
+    if( nSize < nRequiredSize )
+        return nullptr;
+
+    size_t nMappingSize = 0;
+    const GByte* pabyMapping = m_poGDS->GetFileMapping(nMappingSize);
+    if( pabyMapping == nullptr || nOffset > nMappingSize ||
+        nMappingSize - nOffset < nRequiredSize )
+    {
+        return nullptr;
+    }
+
+    *pnPixelSpace = nPixelSpace;
+    *pnLineSpace = nLineSpace;
+    return pabyMapping + nOffset + nBandOffset;
+}
+
 /************************************************************************/
 /*                     GetVirtualMemAutoInternal()                      */
 /************************************************************************/
@@ -2190,6 +2312,59 @@ CPLErr GTiffDataset::IRasterIO( GDALRWFlag eRWFlag,
             return static_cast<CPLErr>(nErr);
     }
 
+    if( eRWFlag == GF_Read && IsMultiThreadedReadCompatible() )
+    {
+        const int nBlockRows =
+            GetMultiThreadedReadBlockRows(nXOff, nXSize, nBandCount);
+        const int nYBlock1 = nYOff / m_nBlockYSize;
+        const int nYBlock2 = (nYOff + nYSize - 1) / m_nBlockYSize;
+        if( nBlockRows > 0 && nYBlock2 - nYBlock1 + 1 <= nBlockRows )
+        {
+            if( PreloadBlocksMultiThreaded(nXOff, nYOff, nXSize, nYSize,
+                                           nBandCount, panBandMap) != CE_None )
+            {
+                return CE_Failure;
+            }
+        }
+        else if( nBlockRows > 0 &&
+                 nXSize == nBufXSize && nYSize == nBufYSize )
+        {
+/* -------------------------------------------------------------------- */
+/*      Process the request by slabs of block rows whose decoded size   */
+/*      fits in the block cache. Each slab is handled by a recursive    */
+/*      call, which goes through the above branch.                      */
+/* -------------------------------------------------------------------- */
+            GDALRasterIOExtraArg sExtraArg;
+            INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+            sExtraArg.eResampleAlg = psExtraArg->eResampleAlg;
+            CPLErr eErr = CE_None;
+            for( int nYBlock = nYBlock1;
+                 eErr == CE_None && nYBlock <= nYBlock2;
+                 nYBlock += nBlockRows )
+            {
+                const int nSlabYOff = std::max(nYOff, nYBlock * m_nBlockYSize);
+                const int nSlabYEnd = std::min(nYOff + nYSize,
+                            (nYBlock + nBlockRows) * m_nBlockYSize);
+                void* pScaledProgress = GDALCreateScaledProgress(
+                    static_cast<double>(nSlabYOff - nYOff) / nYSize,
+                    static_cast<double>(nSlabYEnd - nYOff) / nYSize,
+                    psExtraArg->pfnProgress, psExtraArg->pProgressData );
+                sExtraArg.pfnProgress = GDALScaledProgress;
+                sExtraArg.pProgressData = pScaledProgress;
+                eErr = IRasterIO( eRWFlag, nXOff, nSlabYOff,
+                                  nXSize, nSlabYEnd - nSlabYOff,
+                                  static_cast<GByte*>(pData) +
+                                      (nSlabYOff - nYOff) * nLineSpace,
+                                  nXSize, nSlabYEnd - nSlabYOff,
+                                  eBufType, nBandCount, panBandMap,
+                                  nPixelSpace, nLineSpace, nBandSpace,
+                                  &sExtraArg );
+                GDALDestroyScaledProgress( pScaledProgress );
+            }
+            return eErr;
+        }
+    }
+
     void* pBufferedData = nullptr;
     if( eAccess == GA_ReadOnly &&
         eRWFlag == GF_Read &&
@@ -2222,6 +2397,386 @@ CPLErr GTiffDataset::IRasterIO( GDALRWFlag eRWFlag,
     return eErr;
 }
 
+/************************************************************************/
+/*                    IsMultiThreadedReadCompatible()                   */
+/************************************************************************/
+
+bool GTiffDataset::IsMultiThreadedReadCompatible()
+{
+#ifdef SUPPORTS_GET_OFFSET_BYTECOUNT
+    const int nThreads = m_poBaseDS ? m_poBaseDS->m_nDecompressThreads :
+                                      m_nDecompressThreads;
+    // Only deal with the plain GTiffRasterBand case, where a decoded
+    // strile maps directly to one block per band.
+    return nThreads > 1 &&
+           eAccess == GA_ReadOnly &&
+           !m_bStreamingIn &&
+           nBands > 0 &&
+           (m_nPlanarConfig == PLANARCONFIG_SEPARATE || nBands < 128) &&
+           m_nCompression != COMPRESSION_NONE &&
+           m_nCompression != COMPRESSION_OJPEG &&
+           !m_bTreatAsRGBA &&
+           !m_bTreatAsSplit &&
+           !m_bTreatAsSplitBitmap &&
+           !m_bPromoteTo8Bits &&
+           (m_nBitsPerSample == 8 || m_nBitsPerSample == 16 ||
+            m_nBitsPerSample == 32 || m_nBitsPerSample == 64) &&
+           m_nBitsPerSample == GDALGetDataTypeSizeBits(
+                                GetRasterBand(1)->GetRasterDataType());
+#else
+    return false;
+#endif
+}
+
+/************************************************************************/
+/*                    GetMultiThreadedReadBlockRows()                   */
+/*                                                                      */
+/*      Return the maximum number of block rows of the specified        */
+/*      window that can be decoded at once without pushing too much     */
+/*      the block cache, or 0 if even one block row does not fit.       */
+/************************************************************************/
+
+int GTiffDataset::GetMultiThreadedReadBlockRows( int nXOff, int nXSize,
+                                                 int nBandCount )
+{
+    const int nXBlock1 = nXOff / m_nBlockXSize;
+    const int nXBlock2 = (nXOff + nXSize - 1) / m_nBlockXSize;
+    const int nBandsDecoded =
+        m_nPlanarConfig == PLANARCONFIG_SEPARATE ? nBandCount : nBands;
+    const GIntBig nBlockRowSize =
+        static_cast<GIntBig>(nXBlock2 - nXBlock1 + 1) *
+        m_nBlockXSize * m_nBlockYSize * nBandsDecoded *
+        (m_nBitsPerSample / 8);
+    const GIntBig nBudget = GDALGetCacheMax64() / 4;
+    if( nBlockRowSize > nBudget )
+        return 0;
+    return static_cast<int>(
+        std::min(static_cast<GIntBig>(INT_MAX), nBudget / nBlockRowSize));
+}
+
+/************************************************************************/
+/*                      ThreadDecompressionFunc()                       */
+/************************************************************************/
+
+// Errors are collected by the worker threads and emitted again by the
+// calling thread, so that they are reported as if it had decoded the
+// blocks.
+static void CPL_STDCALL GTiffDecompressionErrorHandler( CPLErr eErrClass,
+                                                        CPLErrorNum nErrNo,
+                                                        const char* pszMsg )
+{
+    GTiffDecompressionJob* psJob =
+        static_cast<GTiffDecompressionJob *>(CPLGetErrorHandlerUserData());
+    GTiffDecompressionError sError;
+    sError.eErrClass = eErrClass;
+    sError.nErrNo = nErrNo;
+    sError.osMsg = pszMsg;
+    psJob->asErrors.push_back(sError);
+}
+
+void GTiffDataset::ThreadDecompressionFunc( void* pData )
+{
+#ifdef SUPPORTS_GET_OFFSET_BYTECOUNT
+    GTiffDecompressionWorker* psWorker =
+        static_cast<GTiffDecompressionWorker *>(pData);
+    std::vector<GTiffDecompressionJob>& asJobs = *(psWorker->pasJobs);
+
+    while( true )
+    {
+        const int i = (*psWorker->pnNextJob)++;
+        if( i >= static_cast<int>(asJobs.size()) )
+            break;
+        GTiffDecompressionJob& sJob = asJobs[i];
+        if( sJob.nReqSize < sJob.nBufferSize )
+            memset( sJob.pabyBuffer, 0, sJob.nBufferSize );
+        CPLPushErrorHandlerEx(GTiffDecompressionErrorHandler, &sJob);
+        sJob.bSuccess =
+            TIFFReadFromUserBuffer( psWorker->hTIFF, sJob.nBlockId,
+                                    sJob.pabyCompressedBuffer,
+                                    sJob.nCompressedBufferSize,
+                                    sJob.pabyBuffer, sJob.nReqSize ) != 0;
+        CPLPopErrorHandler();
+    }
+#else
+    CPL_IGNORE_RET_VAL(pData);
+#endif
+}
+
+/************************************************************************/
+/*                     PreloadBlocksMultiThreaded()                     */
+/*                                                                      */
+/*      Fetch the compressed data of all the strips/tiles intersecting  */
+/*      the window that are not already in the block cache, decode      */
+/*      them in parallel in worker threads, and push the result into    */
+/*      the block cache. The blocks that are not handled that way       */
+/*      (sparse ones for example) will be read by IReadBlock(). Read    */
+/*      and decoding errors are emitted, and CE_Failure returned,       */
+/*      unless GTIFF_IGNORE_READ_ERRORS is set, in which case the       */
+/*      failed blocks are also left to IReadBlock().                    */
+/************************************************************************/
+
+CPLErr GTiffDataset::PreloadBlocksMultiThreaded( int nXOff, int nYOff,
+                                               int nXSize, int nYSize,
+                                               int nBandCount,
+                                               const int* panBandMap )
+{
+    Crystalize();
+
+    const int nXBlock1 = nXOff / m_nBlockXSize;
+    const int nYBlock1 = nYOff / m_nBlockYSize;
+    const int nXBlock2 = (nXOff + nXSize - 1) / m_nBlockXSize;
+    const int nYBlock2 = (nYOff + nYSize - 1) / m_nBlockYSize;
+    const int nBlocksPerRow = DIV_ROUND_UP(nRasterXSize, m_nBlockXSize);
+    const bool bSeparate =
+        nBands == 1 || m_nPlanarConfig == PLANARCONFIG_SEPARATE;
+
+    const GPtrDiff_t nBlockBufSize = static_cast<GPtrDiff_t>(
+        TIFFIsTiled(m_hTIFF) ? TIFFTileSize(m_hTIFF) : TIFFStripSize(m_hTIFF));
+    if( nBlockBufSize <= 0 )
+        return CE_None;
+
+/* -------------------------------------------------------------------- */
+/*      Collect the striles to decode.                                  */
+/* -------------------------------------------------------------------- */
+    std::vector<GTiffDecompressionJob> asJobs;
+    const auto IsCached = [this](int iBand, int nXBlock, int nYBlock)
+    {
+        GDALRasterBlock* poBlock = cpl::down_cast<GTiffRasterBand*>(
+            GetRasterBand(iBand))->TryGetLockedBlockRef(nXBlock, nYBlock);
+        if( poBlock == nullptr )
+            return false;
+        poBlock->DropLock();
+        return true;
+    };
+    for( int nYBlock = nYBlock1; nYBlock <= nYBlock2; ++nYBlock )
+    {
+        // Same logic as in GTiffRasterBand::IReadBlock() for partially
+        // encoded bottom-most striles.
+        GPtrDiff_t nReqSize = nBlockBufSize;
+        if( nYBlock * m_nBlockYSize > nRasterYSize - m_nBlockYSize )
+        {
+            nReqSize = (nBlockBufSize / m_nBlockYSize)
+                * (m_nBlockYSize - static_cast<int>(
+                    (static_cast<GIntBig>(nYBlock + 1) * m_nBlockYSize)
+                        % nRasterYSize));
+        }
+
+        for( int nXBlock = nXBlock1; nXBlock <= nXBlock2; ++nXBlock )
+        {
+            const int nBlockIdBand0 = nXBlock + nYBlock * nBlocksPerRow;
+            for( int i = 0; i < (bSeparate ? nBandCount : 1); ++i )
+            {
+                GTiffDecompressionJob sJob;
+                sJob.nXBlock = nXBlock;
+                sJob.nYBlock = nYBlock;
+                sJob.nBufferSize = nBlockBufSize;
+                sJob.nReqSize = nReqSize;
+                if( bSeparate )
+                {
+                    sJob.nBand = panBandMap[i];
+                    if( IsCached(sJob.nBand, nXBlock, nYBlock) )
+                        continue;
+                    sJob.nBlockId = nBlockIdBand0 +
+                                    (sJob.nBand - 1) * m_nBlocksPerBand;
+                }
+                else
+                {
+                    bool bAllCached = true;
+                    for( int j = 0; bAllCached && j < nBandCount; ++j )
+                        bAllCached = IsCached(panBandMap[j], nXBlock, nYBlock);
+                    if( bAllCached || nBlockIdBand0 == m_nLoadedBlock )
+                        continue;
+                    sJob.nBand = 0;
+                    sJob.nBlockId = nBlockIdBand0;
+                }
+
+                vsi_l_offset nSize = 0;
+                if( !IsBlockAvailable(sJob.nBlockId,
+                                      &sJob.nOffset, &nSize) ||
+                    nSize == 0 ||
+                    nSize > static_cast<vsi_l_offset>(INT_MAX) )
+                {
+                    // Sparse or unusual striles are left to IReadBlock().
+                    continue;
+                }
+                sJob.nCompressedBufferSize = static_cast<GPtrDiff_t>(nSize);
+                asJobs.push_back(sJob);
+            }
+        }
+    }
+
+    // Not worth the overhead.
+    if( asJobs.size() < 2 )
+        return CE_None;
+
+/* -------------------------------------------------------------------- */
+/*      Get the thread pool and the decoding TIFF handles.              */
+/* -------------------------------------------------------------------- */
+    GTiffDataset* poPoolDS = m_poBaseDS ? m_poBaseDS : this;
+    if( poPoolDS->m_poDecompressThreadPool == nullptr )
+    {
+        poPoolDS->m_poDecompressThreadPool =
+            CPLGetGlobalWorkerThreadPool(poPoolDS->m_nDecompressThreads);
+        if( poPoolDS->m_poDecompressThreadPool == nullptr )
+        {
+            poPoolDS->m_nDecompressThreads = 0;
+            return CE_None;
+        }
+        poPoolDS->m_nDecompressThreads =
+            std::min(poPoolDS->m_nDecompressThreads,
+                     poPoolDS->m_poDecompressThreadPool->GetThreadCount());
+        CPLDebug("GTiff", "Using %d threads for decompression",
+                 poPoolDS->m_nDecompressThreads);
+        if( poPoolDS->m_nDecompressThreads < 2 )
+        {
+            poPoolDS->m_nDecompressThreads = 0;
+            return CE_None;
+        }
+    }
+
+    const int nThreads = std::min(poPoolDS->m_nDecompressThreads,
+                                  static_cast<int>(asJobs.size()));
+    while( static_cast<int>(m_ahDecompressTIFF.size()) < nThreads )
+    {
+        TIFF* hTIFF = VSI_TIFFOpenChild(m_hTIFF);
+        if( hTIFF == nullptr )
+            return CE_None;
+        if( !TIFFSetSubDirectory(hTIFF, m_nDirOffset) )
+        {
+            XTIFFClose(hTIFF);
+            return CE_None;
+        }
+        if( m_nCompression == COMPRESSION_JPEG )
+        {
+            int nColorMode = JPEGCOLORMODE_RAW;
+            if( TIFFGetField(m_hTIFF, TIFFTAG_JPEGCOLORMODE, &nColorMode) &&
+                nColorMode == JPEGCOLORMODE_RGB )
+            {
+                TIFFSetField(hTIFF, TIFFTAG_JPEGCOLORMODE, JPEGCOLORMODE_RGB);
+            }
+        }
+        m_ahDecompressTIFF.push_back(hTIFF);
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Allocate buffers and fetch compressed data in a single          */
+/*      multi-range request.                                            */
+/* -------------------------------------------------------------------- */
+    std::vector<void*> apData(asJobs.size());
+    std::vector<vsi_l_offset> anOffsets(asJobs.size());
+    std::vector<size_t> anSizes(asJobs.size());
+    bool bOK = true;
+    for( size_t i = 0; i < asJobs.size(); ++i )
+    {
+        GTiffDecompressionJob& sJob = asJobs[i];
+        anOffsets[i] = sJob.nOffset;
+        anSizes[i] = static_cast<size_t>(sJob.nCompressedBufferSize);
+        sJob.pabyCompressedBuffer = static_cast<GByte*>(
+            VSI_MALLOC_VERBOSE(anSizes[i]));
+        sJob.pabyBuffer = static_cast<GByte*>(
+            VSI_MALLOC_VERBOSE(sJob.nBufferSize));
+        apData[i] = sJob.pabyCompressedBuffer;
+        if( sJob.pabyCompressedBuffer == nullptr || sJob.pabyBuffer == nullptr )
+            bOK = false;
+    }
+
+    VSILFILE* fp = VSI_TIFFGetVSILFile(TIFFClientdata(m_hTIFF));
+    if( bOK &&
+        VSIFReadMultiRangeL(static_cast<int>(asJobs.size()),
+                            &apData[0], &anOffsets[0], &anSizes[0],
+                            fp) != 0 )
+    {
+        bOK = false;
+        if( !m_bIgnoreReadErrors )
+        {
+            CPLError(CE_Failure, CPLE_FileIO,
+                     "Cannot read the data of %d %s",
+                     static_cast<int>(asJobs.size()),
+                     TIFFIsTiled(m_hTIFF) ? "tiles" : "strips");
+        }
+    }
+    CPLErr eErr = CE_None;
+    if( !bOK && !m_bIgnoreReadErrors )
+        eErr = CE_Failure;
+
+/* -------------------------------------------------------------------- */
+/*      Decode in parallel.                                             */
+/* -------------------------------------------------------------------- */
+    if( bOK )
+    {
+        std::atomic<int> nNextJob(0);
+        std::vector<GTiffDecompressionWorker> asWorkers(nThreads);
+        std::vector<void*> apWorkers;
+        for( int i = 0; i < nThreads; ++i )
+        {
+            asWorkers[i].pasJobs = &asJobs;
+            asWorkers[i].pnNextJob = &nNextJob;
+            asWorkers[i].hTIFF = m_ahDecompressTIFF[i];
+            apWorkers.push_back(&asWorkers[i]);
+        }
+        auto poJobQueue =
+            poPoolDS->m_poDecompressThreadPool->CreateJobQueue(nThreads);
+        poJobQueue->SubmitJobs(ThreadDecompressionFunc, apWorkers);
+        poJobQueue->WaitCompletion();
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Push decoded blocks into the block cache.                       */
+/* -------------------------------------------------------------------- */
+    const int nWordBytes = m_nBitsPerSample / 8;
+    const GDALDataType eDT = GetRasterBand(1)->GetRasterDataType();
+    const GPtrDiff_t nBlockPixels =
+        static_cast<GPtrDiff_t>(m_nBlockXSize) * m_nBlockYSize;
+    for( auto& sJob: asJobs )
+    {
+        if( bOK && !(m_bIgnoreReadErrors && !sJob.bSuccess) )
+        {
+            for( const auto& sError: sJob.asErrors )
+                CPLError(sError.eErrClass, sError.nErrNo, "%s",
+                         sError.osMsg.c_str());
+            if( !sJob.bSuccess )
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         TIFFIsTiled(m_hTIFF) ?
+                            "TIFFReadEncodedTile() failed." :
+                            "TIFFReadEncodedStrip() failed.");
+                eErr = CE_Failure;
+            }
+        }
+        if( bOK && sJob.bSuccess )
+        {
+            const int iBandStart = sJob.nBand == 0 ? 1 : sJob.nBand;
+            const int iBandEnd = sJob.nBand == 0 ? nBands : sJob.nBand;
+            for( int iBand = iBandStart; iBand <= iBandEnd; ++iBand )
+            {
+                GDALRasterBlock* poBlock =
+                    GetRasterBand(iBand)->GetLockedBlockRef(
+                        sJob.nXBlock, sJob.nYBlock, TRUE);
+                if( poBlock == nullptr )
+                    continue;
+                if( sJob.nBand != 0 )
+                {
+                    memcpy(poBlock->GetDataRef(), sJob.pabyBuffer,
+                           nBlockPixels * nWordBytes);
+                }
+                else
+                {
+                    GDALCopyWords64(
+                        sJob.pabyBuffer + (iBand - 1) * nWordBytes, eDT,
+                        nBands * nWordBytes,
+                        poBlock->GetDataRef(), eDT, nWordBytes,
+                        nBlockPixels);
+                }
+                poBlock->DropLock();
+            }
+        }
+        VSIFree(sJob.pabyCompressedBuffer);
+        VSIFree(sJob.pabyBuffer);
+    }
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                        FetchBufferVirtualMemIO                       */
 /************************************************************************/
@@ -2288,6 +2843,52 @@ public:
     static const EMULATED_BOOL bMinimizeIO = false;
 };
 
+/************************************************************************/
+/*                           GetFileMapping()                           */
+/************************************************************************/
+
+// Return the content of the whole file in memory, either the buffer of a
+// /vsimem/ file, or a read-only memory mapping of a local file.
+GByte* GTiffDataset::GetFileMapping( size_t& nMappingSize )
+{
+    if( STARTS_WITH(m_pszFilename, "/vsimem/") )
+    {
+        vsi_l_offset nDataLength = 0;
+        GByte* pabyData =
+            VSIGetMemFileBuffer(m_pszFilename, &nDataLength, FALSE);
+        nMappingSize = static_cast<size_t>(nDataLength);
+        return pabyData;
+    }
+
+    if( m_psVirtualMemIOMapping == nullptr )
+    {
+        if( m_bFileMappingFailed )
+            return nullptr;
+        m_bFileMappingFailed = true;
+
+        VSILFILE* fp = VSI_TIFFGetVSILFile(TIFFClientdata( m_hTIFF ));
+        if( !CPLIsVirtualMemFileMapAvailable() ||
+            VSIFGetNativeFileDescriptorL(fp) == nullptr )
+        {
+            return nullptr;
+        }
+        if( VSIFSeekL(fp, 0, SEEK_END) != 0 )
+            return nullptr;
+        const vsi_l_offset nLength = VSIFTellL(fp);
+        if( static_cast<size_t>(nLength) != nLength )
+            return nullptr;
+        m_psVirtualMemIOMapping = CPLVirtualMemFileMapNew(
+            fp, 0, nLength, VIRTUALMEM_READONLY, nullptr, nullptr);
+        if( m_psVirtualMemIOMapping == nullptr )
+            return nullptr;
+        m_bFileMappingFailed = false;
+    }
+
+    nMappingSize = CPLVirtualMemGetSize(m_psVirtualMemIOMapping);
+    return static_cast<GByte *>(
+        CPLVirtualMemGetAddr(m_psVirtualMemIOMapping) );
+}
+
 /************************************************************************/
 /*                         VirtualMemIO()                               */
 /************************************************************************/
@@ -2325,66 +2926,30 @@ int GTiffDataset::VirtualMemIO( GDALRWFlag eRWFlag,
     }
 
     size_t nMappingSize = 0;
-    GByte* pabySrcData = nullptr;
-    if( STARTS_WITH(m_pszFilename, "/vsimem/") )
+    GByte* pabySrcData = GetFileMapping(nMappingSize);
+    if( pabySrcData == nullptr )
     {
-        vsi_l_offset nDataLength = 0;
-        pabySrcData =
-            VSIGetMemFileBuffer(m_pszFilename, &nDataLength, FALSE);
-        nMappingSize = static_cast<size_t>(nDataLength);
-        if( pabySrcData == nullptr )
-            return -1;
+        if( !STARTS_WITH(m_pszFilename, "/vsimem/") )
+            m_eVirtualMemIOUsage = VirtualMemIOEnum::NO;
+        return -1;
     }
-    else if( m_psVirtualMemIOMapping == nullptr )
+    if( m_eVirtualMemIOUsage == VirtualMemIOEnum::IF_ENOUGH_RAM &&
+        m_psVirtualMemIOMapping != nullptr )
     {
-        VSILFILE* fp = VSI_TIFFGetVSILFile(TIFFClientdata( m_hTIFF ));
-        if( !CPLIsVirtualMemFileMapAvailable() ||
-            VSIFGetNativeFileDescriptorL(fp) == nullptr )
-        {
-            m_eVirtualMemIOUsage = VirtualMemIOEnum::NO;
-            return -1;
-        }
-        if( VSIFSeekL(fp, 0, SEEK_END) != 0 )
-        {
-            m_eVirtualMemIOUsage = VirtualMemIOEnum::NO;
-            return -1;
-        }
-        const vsi_l_offset nLength = VSIFTellL(fp);
-        if( static_cast<size_t>(nLength) != nLength )
-        {
-            m_eVirtualMemIOUsage = VirtualMemIOEnum::NO;
-            return -1;
-        }
-        if( m_eVirtualMemIOUsage == VirtualMemIOEnum::IF_ENOUGH_RAM )
-        {
-            GIntBig nRAM = CPLGetUsablePhysicalRAM();
-            if( static_cast<GIntBig>(nLength) > nRAM )
-            {
-                CPLDebug( "GTiff",
-                          "Not enough RAM to map whole file into memory." );
-                m_eVirtualMemIOUsage = VirtualMemIOEnum::NO;
-                return -1;
-            }
-        }
-        m_psVirtualMemIOMapping = CPLVirtualMemFileMapNew(
-            fp, 0, nLength, VIRTUALMEM_READONLY, nullptr, nullptr);
-        if( m_psVirtualMemIOMapping == nullptr )
+        GIntBig nRAM = CPLGetUsablePhysicalRAM();
+        if( static_cast<GIntBig>(nMappingSize) > nRAM )
         {
+            CPLDebug( "GTiff",
+                      "Not enough RAM to map whole file into memory." );
             m_eVirtualMemIOUsage = VirtualMemIOEnum::NO;
             return -1;
         }
         m_eVirtualMemIOUsage = VirtualMemIOEnum::YES;
     }
-
-    if( m_psVirtualMemIOMapping )
-    {
 #ifdef DEBUG
+    if( m_psVirtualMemIOMapping )
         CPLDebug("GTiff", "Using VirtualMemIO");
 #endif
-        nMappingSize = CPLVirtualMemGetSize(m_psVirtualMemIOMapping);
-        pabySrcData = static_cast<GByte *>(
-            CPLVirtualMemGetAddr(m_psVirtualMemIOMapping) );
-    }
 
     if( TIFFIsByteSwapped(m_hTIFF) && m_pTempBufferForCommonDirectIO == nullptr )
     {
@@ -4517,6 +5082,56 @@ CPLErr GTiffRasterBand::IRasterIO( GDALRWFlag eRWFlag,
             return static_cast<CPLErr>(nErr);
     }
 
+    if( eRWFlag == GF_Read && m_poGDS->IsMultiThreadedReadCompatible() )
+    {
+        const int nBlockRows =
+            m_poGDS->GetMultiThreadedReadBlockRows(nXOff, nXSize, 1);
+        const int nYBlock1 = nYOff / nBlockYSize;
+        const int nYBlock2 = (nYOff + nYSize - 1) / nBlockYSize;
+        if( nBlockRows > 0 && nYBlock2 - nYBlock1 + 1 <= nBlockRows )
+        {
+            if( m_poGDS->PreloadBlocksMultiThreaded(nXOff, nYOff,
+                                                    nXSize, nYSize,
+                                                    1, &nBand) != CE_None )
+            {
+                return CE_Failure;
+            }
+        }
+        else if( nBlockRows > 0 &&
+                 nXSize == nBufXSize && nYSize == nBufYSize )
+        {
+            // Process the request by slabs of block rows, as in
+            // GTiffDataset::IRasterIO().
+            GDALRasterIOExtraArg sExtraArg;
+            INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+            sExtraArg.eResampleAlg = psExtraArg->eResampleAlg;
+            CPLErr eErr = CE_None;
+            for( int nYBlock = nYBlock1;
+                 eErr == CE_None && nYBlock <= nYBlock2;
+                 nYBlock += nBlockRows )
+            {
+                const int nSlabYOff = std::max(nYOff, nYBlock * nBlockYSize);
+                const int nSlabYEnd = std::min(nYOff + nYSize,
+                            (nYBlock + nBlockRows) * nBlockYSize);
+                void* pScaledProgress = GDALCreateScaledProgress(
+                    static_cast<double>(nSlabYOff - nYOff) / nYSize,
+                    static_cast<double>(nSlabYEnd - nYOff) / nYSize,
+                    psExtraArg->pfnProgress, psExtraArg->pProgressData );
+                sExtraArg.pfnProgress = GDALScaledProgress;
+                sExtraArg.pProgressData = pScaledProgress;
+                eErr = IRasterIO( eRWFlag, nXOff, nSlabYOff,
+                                  nXSize, nSlabYEnd - nSlabYOff,
+                                  static_cast<GByte*>(pData) +
+                                      (nSlabYOff - nYOff) * nLineSpace,
+                                  nXSize, nSlabYEnd - nSlabYOff,
+                                  eBufType, nPixelSpace, nLineSpace,
+                                  &sExtraArg );
+                GDALDestroyScaledProgress( pScaledProgress );
+            }
+            return eErr;
+        }
+    }
+
     void* pBufferedData = nullptr;
     if( m_poGDS->eAccess == GA_ReadOnly &&
         eRWFlag == GF_Read &&
@@ -7688,6 +8303,7 @@ GTiffDataset::GTiffDataset():
     m_bFillEmptyTilesAtClosing(false),
     m_bTreatAsSplit(false),
     m_bTreatAsSplitBitmap(false),
+    m_bTreatAsRGBA(false),
     m_bClipWarn(false),
     m_bIMDRPCMetadataLoaded(false),
     m_bEXIFMetadataLoaded(false),
@@ -7797,18 +8413,11 @@ int GTiffDataset::Finalize()
 /* -------------------------------------------------------------------- */
     FlushCacheInternal( true );
 
-    // Destroy compression pool.
-    if( m_poCompressThreadPool )
+    // Destroy compression queue.
+    if( m_poCompressQueue )
     {
-        m_poCompressThreadPool->WaitCompletion();
-
-        // Save thread pool for later reuse.
-        {
-            std::lock_guard<std::mutex> oLock(gMutexThreadPool);
-            delete gpoCompressThreadPool;
-            gpoCompressThreadPool = m_poCompressThreadPool;
-            m_poCompressThreadPool = nullptr;
-        }
+        m_poCompressQueue->WaitCompletion();
+        m_poCompressQueue.reset();
 
         for( int i = 0; i < static_cast<int>(m_asCompressionJobs.size()); ++i )
         {
@@ -7822,6 +8431,8 @@ int GTiffDataset::Finalize()
         CPLDestroyMutex(m_hCompressThreadPoolMutex);
     }
 
+    m_poDecompressThreadPool = nullptr;
+
 /* -------------------------------------------------------------------- */
 /*      If there is still changed metadata, then presumably we want     */
 /*      to push it into PAM.                                            */
@@ -7875,6 +8486,11 @@ int GTiffDataset::Finalize()
         delete m_poColorTable;
     m_poColorTable = nullptr;
 
+    // Must be closed before m_hTIFF, since they are child handles of it.
+    for( TIFF* hTIFF: m_ahDecompressTIFF )
+        XTIFFClose( hTIFF );
+    m_ahDecompressTIFF.clear();
+
     if( m_hTIFF )
     {
         XTIFFClose( m_hTIFF );
@@ -8810,7 +9426,7 @@ void GTiffDataset::InitCompressionThreads( char** papszOptions )
         pszValue = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
     if( pszValue )
     {
-        const int nThreads =
+        int nThreads =
             EQUAL(pszValue, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszValue);
         if( nThreads > 1 )
         {
@@ -8822,34 +9438,16 @@ void GTiffDataset::InitCompressionThreads( char** papszOptions )
             }
             else
             {
-                CPLDebug("GTiff", "Using %d threads for compression", nThreads);
-
-                // Try to reuse previously created thread pool
+                CPLWorkerThreadPool* poThreadPool =
+                    CPLGetGlobalWorkerThreadPool(nThreads);
+                if( poThreadPool != nullptr )
                 {
-                    std::lock_guard<std::mutex> oLock(gMutexThreadPool);
-                    if( gpoCompressThreadPool &&
-                        gpoCompressThreadPool->GetThreadCount() == nThreads )
-                    {
-                        m_poCompressThreadPool = gpoCompressThreadPool;
-                    }
-                    else
-                    {
-                        delete gpoCompressThreadPool;
-                    }
-                    gpoCompressThreadPool = nullptr;
-                }
+                    nThreads =
+                        std::min(nThreads, poThreadPool->GetThreadCount());
+                    CPLDebug("GTiff", "Using %d threads for compression",
+                             nThreads);
+                    m_poCompressQueue = poThreadPool->CreateJobQueue(nThreads);
 
-                if( m_poCompressThreadPool == nullptr )
-                {
-                    m_poCompressThreadPool = new CPLWorkerThreadPool();
-                    if( !m_poCompressThreadPool->Setup(nThreads, nullptr, nullptr) )
-                    {
-                        delete m_poCompressThreadPool;
-                        m_poCompressThreadPool = nullptr;
-                    }
-                }
-                if( m_poCompressThreadPool != nullptr )
-                {
                     // Add a margin of an extra job w.r.t thread number
                     // so as to optimize compression time (enables the main
                     // thread to do boring I/O while all CPUs are working).
@@ -8892,6 +9490,40 @@ void GTiffDataset::InitCompressionThreads( char** papszOptions )
     }
 }
 
+/************************************************************************/
+/*                       InitDecompressionThreads()                     */
+/************************************************************************/
+
+void GTiffDataset::InitDecompressionThreads( char** papszOptions )
+{
+    // Raster == tile, then no need for threads
+    if( m_nBlockXSize == nRasterXSize && m_nBlockYSize == nRasterYSize )
+        return;
+
+    const char* pszValue = CSLFetchNameValue( papszOptions, "NUM_THREADS" );
+    if( pszValue == nullptr )
+        pszValue = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if( pszValue )
+    {
+        const int nThreads =
+            EQUAL(pszValue, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszValue);
+        if( nThreads > 1 )
+        {
+            // The thread pool is only created at the first request that
+            // can take advantage of it.
+            m_nDecompressThreads = nThreads;
+        }
+        else if( nThreads < 0 ||
+                 (!EQUAL(pszValue, "0") &&
+                  !EQUAL(pszValue, "1") &&
+                  !EQUAL(pszValue, "ALL_CPUS")) )
+        {
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "Invalid value for NUM_THREADS: %s", pszValue);
+        }
+    }
+}
+
 /************************************************************************/
 /*                       GetGTIFFKeysFlavor()                           */
 /************************************************************************/
@@ -9173,8 +9805,8 @@ void GTiffDataset::WriteRawStripOrTile( int nStripOrTile,
 
 void GTiffDataset::WaitCompletionForJobIdx(int i)
 {
-    auto poTP = m_poBaseDS ?
-        m_poBaseDS->m_poCompressThreadPool : m_poCompressThreadPool;
+    auto poQueue = m_poBaseDS ?
+        m_poBaseDS->m_poCompressQueue.get() : m_poCompressQueue.get();
     auto& oQueue = m_poBaseDS ? m_poBaseDS->m_asQueueJobIdx : m_asQueueJobIdx;
     auto& asJobs = m_poBaseDS ? m_poBaseDS->m_asCompressionJobs : m_asCompressionJobs;
     auto mutex = m_poBaseDS ? m_poBaseDS->m_hCompressThreadPoolMutex : m_hCompressThreadPoolMutex;
@@ -9198,7 +9830,7 @@ void GTiffDataset::WaitCompletionForJobIdx(int i)
                         asJobs[i].nStripOrTile);
                 bHasWarned = true;
             }
-            poTP->WaitEvent();
+            poQueue->WaitEvent();
         }
         else
         {
@@ -9225,12 +9857,12 @@ void GTiffDataset::WaitCompletionForJobIdx(int i)
 
 void GTiffDataset::WaitCompletionForBlock(int nBlockId)
 {
-    auto poTP = m_poBaseDS ?
-        m_poBaseDS->m_poCompressThreadPool : m_poCompressThreadPool;
+    auto poQueue = m_poBaseDS ?
+        m_poBaseDS->m_poCompressQueue.get() : m_poCompressQueue.get();
     auto& oQueue = m_poBaseDS ? m_poBaseDS->m_asQueueJobIdx : m_asQueueJobIdx;
     auto& asJobs = m_poBaseDS ? m_poBaseDS->m_asCompressionJobs : m_asCompressionJobs;
 
-    if( poTP != nullptr )
+    if( poQueue != nullptr )
     {
         for( int i = 0; i < static_cast<int>(asJobs.size()); ++i )
         {
@@ -9261,10 +9893,10 @@ bool GTiffDataset::SubmitCompressionJob( int nStripOrTile, GByte* pabyData,
 /* -------------------------------------------------------------------- */
 /*      Should we do compression in a worker thread ?                   */
 /* -------------------------------------------------------------------- */
-    auto poTP = m_poBaseDS ?
-        m_poBaseDS->m_poCompressThreadPool : m_poCompressThreadPool;
+    auto poQueue = m_poBaseDS ?
+        m_poBaseDS->m_poCompressQueue.get() : m_poCompressQueue.get();
 
-    if( !( poTP != nullptr &&
+    if( !( poQueue != nullptr &&
            (m_nCompression == COMPRESSION_ADOBE_DEFLATE ||
             m_nCompression == COMPRESSION_LZW ||
             m_nCompression == COMPRESSION_PACKBITS ||
@@ -9356,7 +9988,7 @@ bool GTiffDataset::SubmitCompressionJob( int nStripOrTile, GByte* pabyData,
         TIFFGetField( m_hTIFF, TIFFTAG_PREDICTOR, &psJob->nPredictor );
     }
 
-    poTP->SubmitJob(ThreadCompressionFunc, psJob);
+    poQueue->SubmitJob(ThreadCompressionFunc, psJob);
     oQueue.push(nNextCompressionJobAvail);
 
     return true;
@@ -9889,10 +10521,11 @@ void GTiffDataset::FlushCacheInternal( bool bFlushDirectory )
     m_bLoadedBlockDirty = false;
 
     // Finish compression
-    auto poTP = m_poBaseDS ? m_poBaseDS->m_poCompressThreadPool : m_poCompressThreadPool;
-    if( poTP )
+    auto poQueue = m_poBaseDS ?
+        m_poBaseDS->m_poCompressQueue.get() : m_poCompressQueue.get();
+    if( poQueue )
     {
-        poTP->WaitCompletion();
+        poQueue->WaitCompletion();
 
         // Flush remaining data
         auto& oQueue = m_poBaseDS ? m_poBaseDS->m_asQueueJobIdx : m_asQueueJobIdx;
@@ -12611,6 +13244,10 @@ GDALDataset *GTiffDataset::Open( GDALOpenInfo * poOpenInfo )
     {
         poDS->InitCreationOrOpenOptions(poOpenInfo->papszOpenOptions);
     }
+    else
+    {
+        poDS->InitDecompressionThreads(poOpenInfo->papszOpenOptions);
+    }
 
     poDS->m_bLoadPam = true;
     poDS->m_bColorProfileMetadataChanged = false;
@@ -14087,6 +14724,7 @@ CPLErr GTiffDataset::OpenOffset( TIFF *hTIFFIn,
 /* -------------------------------------------------------------------- */
 /*      Create band information objects.                                */
 /* -------------------------------------------------------------------- */
+    m_bTreatAsRGBA = bTreatAsRGBA;
     for( int iBand = 0; iBand < nBands; ++iBand )
     {
         if( bTreatAsRGBA )
@@ -19437,9 +20075,6 @@ void GDALDeregister_GTiff( GDALDriver * )
         TIFFUnRegisterCODEC(pLercCodec);
     pLercCodec = nullptr;
 #endif
-
-    delete gpoCompressThreadPool;
-    gpoCompressThreadPool = nullptr;
 }
 
 /************************************************************************/
@@ -19759,7 +20394,7 @@ void GDALRegister_GTiff()
     poDriver->SetMetadataItem( GDAL_DMD_CREATIONOPTIONLIST, osOptions );
     poDriver->SetMetadataItem( GDAL_DMD_OPENOPTIONLIST,
 "<OpenOptionList>"
-"   <Option name='NUM_THREADS' type='string' description='Number of worker threads for compression. Can be set to ALL_CPUS' default='1'/>"
+"   <Option name='NUM_THREADS' type='string' description='Number of worker threads for compression (in update mode) or decompression (in read-only mode). Can be set to ALL_CPUS' default='1'/>"
 "   <Option name='GEOTIFF_KEYS_FLAVOR' type='string-select' default='STANDARD' description='Which flavor of GeoTIFF keys must be used (for writing)'>"
 "       <Value>STANDARD</Value>"
 "       <Value>ESRI_PE</Value>"
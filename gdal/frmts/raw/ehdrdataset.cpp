@@ -335,6 +335,22 @@ CPLErr EHdrRasterBand::IRasterIO( GDALRWFlag eRWFlag,
                                      psExtraArg);
 }
 
+/************************************************************************/
+/*                           GetMappedBlock()                           */
+/************************************************************************/
+
+const void *EHdrRasterBand::GetMappedBlock( int nXBlockOff, int nYBlockOff,
+                                            GSpacing *pnPixelSpace,
+                                            GSpacing *pnLineSpace )
+{
+    // Sub-byte pixels cannot be exposed in their native type.
+    if (nBits < 8)
+        return nullptr;
+
+    return RawRasterBand::GetMappedBlock(nXBlockOff, nYBlockOff,
+                                         pnPixelSpace, pnLineSpace);
+}
+
 /************************************************************************/
 /*                              OSR_GDS()                               */
 /************************************************************************/
@@ -31,6 +31,7 @@
 
 #include "cpl_minixml.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal_frmts.h"
 #include "ogr_spatialref.h"
 
@@ -1576,6 +1577,55 @@ CPLErr VRTDataset::AdviseRead( int nXOff, int nYOff, int nXSize, int nYSize,
                                eDT, nBandCount, panBandList, papszOptions);
 }
 
+/************************************************************************/
+/*                        GetSourceThreadPool()                         */
+/*                                                                      */
+/*      Return the thread pool used to read sources in parallel, or     */
+/*      nullptr if this has not been enabled with the NUM_THREADS open  */
+/*      option or the VRT_NUM_THREADS configuration option.             */
+/************************************************************************/
+
+CPLWorkerThreadPool* VRTDataset::GetSourceThreadPool()
+{
+    if( m_nSourceThreads < 0 )
+    {
+        m_nSourceThreads = 0;
+        const char* pszValue =
+            CSLFetchNameValue( papszOpenOptions, "NUM_THREADS" );
+        if( pszValue == nullptr )
+            pszValue = CPLGetConfigOption("VRT_NUM_THREADS", nullptr);
+        if( pszValue )
+        {
+            const int nThreads = CPLGetNumThreads(pszValue);
+            if( nThreads > 1 )
+            {
+                // Each worker references at least one dataset of the proxy
+                // pool at a time, so leave room for the calling thread and
+                // for datasets referenced in a cascaded way.
+                const int nMaxPoolSize = std::max(2,
+                    atoi(CPLGetConfigOption("GDAL_MAX_DATASET_POOL_SIZE",
+                                            "100")));
+                m_nSourceThreads = std::min(nThreads, nMaxPoolSize / 2);
+            }
+        }
+    }
+    if( m_nSourceThreads <= 1 )
+        return nullptr;
+
+    if( m_poSourceThreadPool == nullptr )
+    {
+        m_poSourceThreadPool = CPLGetGlobalWorkerThreadPool(m_nSourceThreads);
+        if( m_poSourceThreadPool == nullptr )
+            m_nSourceThreads = 0;
+        else
+            m_nSourceThreads = std::min(m_nSourceThreads,
+                                    m_poSourceThreadPool->GetThreadCount());
+        if( m_nSourceThreads <= 1 )
+            m_poSourceThreadPool = nullptr;
+    }
+    return m_poSourceThreadPool;
+}
+
 /************************************************************************/
 /*                              IRasterIO()                             */
 /************************************************************************/
@@ -1692,6 +1742,18 @@ CPLErr VRTDataset::IRasterIO( GDALRWFlag eRWFlag,
         // they don't necessary instantiate all underlying rasterbands.
         VRTSourcedRasterBand* poBand = reinterpret_cast<VRTSourcedRasterBand *>(
             papoBands[nBands - 1] );
+
+        if( poBand->MultiThreadedSourcesRasterIO(
+                                    nXOff, nYOff, nXSize, nYSize,
+                                    pData, nBufXSize, nBufYSize,
+                                    eBufType,
+                                    nBandCount, panBandMap,
+                                    nPixelSpace, nLineSpace, nBandSpace,
+                                    psExtraArg, eErr) )
+        {
+            return eErr;
+        }
+
         for( int iSource = 0;
              eErr == CE_None && iSource < poBand->nSources;
              iSource++ )
@@ -48,6 +48,8 @@ int VRTApplyMetadata( CPLXMLNode *, GDALMajorObject * );
 CPLXMLNode *VRTSerializeMetadata( GDALMajorObject * );
 CPLErr GDALRegisterDefaultPixelFunc();
 
+class CPLWorkerThreadPool;
+
 #if 0
 int VRTWarpedOverviewTransform( void *pTransformArg, int bDstToSrc,
                                 int nPointCount,
@@ -189,6 +191,11 @@ class CPL_DLL VRTDataset : public GDALDataset
 
     std::map<CPLString, GDALDataset*> m_oMapSharedSources;
 
+    // Number of threads to read sources in parallel. -1 = not yet evaluated
+    int            m_nSourceThreads = -1;
+    // Shared pool, not owned.
+    CPLWorkerThreadPool *m_poSourceThreadPool = nullptr;
+
     VRTRasterBand*      InitBand(const char* pszSubclass, int nBand,
                                  bool bAllowPansharpened);
 
@@ -255,6 +262,10 @@ class CPL_DLL VRTDataset : public GDALDataset
     virtual CPLErr IBuildOverviews( const char *, int, int *,
                                     int, int *, GDALProgressFunc, void * ) override;
 
+    CPLWorkerThreadPool* GetSourceThreadPool();
+    /** Maximum number of sources read in parallel */
+    int                 GetSourceThreadCount() const { return m_nSourceThreads; }
+
     /* Used by PDF driver for example */
     GDALDataset*        GetSingleSimpleSource();
     void                BuildVirtualOverviews();
@@ -550,6 +561,14 @@ class CPL_DLL VRTSourcedRasterBand : public VRTRasterBand
     bool           CanUseSourcesMinMaxImplementations();
     void           CheckSource( VRTSimpleSource *poSS );
 
+    bool           GetSourceGroupsForMultiThreadedIO(
+                        int nXOff, int nYOff, int nXSize, int nYSize,
+                        int nBufXSize, int nBufYSize,
+                        std::vector<std::vector<int>>& aanGroups );
+    static bool    GetSourceDatasetKeys( VRTSimpleSource* poSource,
+                                         std::vector<CPLString>& aosKeys,
+                                         int nRecursionDepth );
+
     CPL_DISALLOW_COPY_ASSIGN(VRTSourcedRasterBand)
 
   public:
@@ -570,6 +589,16 @@ class CPL_DLL VRTSourcedRasterBand : public VRTRasterBand
                               GSpacing nPixelSpace, GSpacing nLineSpace,
                               GDALRasterIOExtraArg* psExtraArg) override;
 
+    bool           MultiThreadedSourcesRasterIO(
+                              int nXOff, int nYOff, int nXSize, int nYSize,
+                              void *pData, int nBufXSize, int nBufYSize,
+                              GDALDataType eBufType,
+                              int nBandCount, int *panBandMap,
+                              GSpacing nPixelSpace, GSpacing nLineSpace,
+                              GSpacing nBandSpace,
+                              GDALRasterIOExtraArg* psExtraArg,
+                              CPLErr& eErr );
+
     virtual int IGetDataCoverageStatus( int nXOff, int nYOff,
                                         int nXSize, int nYSize,
                                         int nMaskFlagStop,
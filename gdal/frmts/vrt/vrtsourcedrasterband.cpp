@@ -31,12 +31,16 @@
 #include "gdal_vrt.h"
 #include "vrtdataset.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstddef>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <map>
 #include <string>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -45,8 +49,10 @@
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_proxy.h"
 #include "ogr_geometry.h"
 
 CPL_CVSID("$Id$")
@@ -280,13 +286,27 @@ CPLErr VRTSourcedRasterBand::IRasterIO( GDALRWFlag eRWFlag,
 
     m_nRecursionCounter++;
 
+/* -------------------------------------------------------------------- */
+/*      If the sources do not overlap, read them in parallel if this    */
+/*      has been enabled.                                               */
+/* -------------------------------------------------------------------- */
+    CPLErr eErr = CE_None;
+    if( MultiThreadedSourcesRasterIO( nXOff, nYOff, nXSize, nYSize,
+                                      pData, nBufXSize, nBufYSize,
+                                      eBufType, 0, nullptr,
+                                      nPixelSpace, nLineSpace, 0,
+                                      psExtraArg, eErr ) )
+    {
+        m_nRecursionCounter--;
+        return eErr;
+    }
+
     GDALProgressFunc const pfnProgressGlobal = psExtraArg->pfnProgress;
     void * const pProgressDataGlobal = psExtraArg->pProgressData;
 
 /* -------------------------------------------------------------------- */
 /*      Overlay each source in turn over top this.                      */
 /* -------------------------------------------------------------------- */
-    CPLErr eErr = CE_None;
     for( int iSource = 0; eErr == CE_None && iSource < nSources; iSource++ )
     {
         psExtraArg->pfnProgress = GDALScaledProgress;
@@ -316,6 +336,447 @@ CPLErr VRTSourcedRasterBand::IRasterIO( GDALRWFlag eRWFlag,
     return eErr;
 }
 
+/************************************************************************/
+/*                        GetSourceDatasetKeys()                        */
+/*                                                                      */
+/*      Collect the keys of the datasets that reading a source may      */
+/*      use: the absolute file name of its dataset, or for a nested     */
+/*      VRT dataset, the keys of the sources of its bands. Returns      */
+/*      false if they cannot be determined without opening datasets,    */
+/*      as for VRT files referenced through the proxy pool, or if the   */
+/*      nested VRT has overviews or mask bands, which may open other    */
+/*      datasets.                                                       */
+/************************************************************************/
+
+bool VRTSourcedRasterBand::GetSourceDatasetKeys(
+                        VRTSimpleSource* poSource,
+                        std::vector<CPLString>& aosKeys,
+                        int nRecursionDepth )
+{
+    if( nRecursionDepth == 32 )
+        return false;
+
+    GDALRasterBand* poSrcBand = poSource->m_poMaskBandMainBand ?
+        poSource->m_poMaskBandMainBand : poSource->m_poRasterBand;
+    GDALDataset* poSrcDS = poSrcBand ? poSrcBand->GetDataset() : nullptr;
+    if( poSrcDS == nullptr )
+        return false;
+
+    VRTDataset* poNestedVRTDS = dynamic_cast<VRTDataset *>(poSrcDS);
+    if( poNestedVRTDS != nullptr )
+    {
+        if( poSource->m_poMaskBandMainBand != nullptr ||
+            poNestedVRTDS->m_poMaskBand != nullptr ||
+            !poNestedVRTDS->m_apoOverviews.empty() )
+        {
+            return false;
+        }
+        for( int iBand = 1; iBand <= poNestedVRTDS->GetRasterCount(); iBand++ )
+        {
+            VRTSourcedRasterBand* poNestedBand =
+                dynamic_cast<VRTSourcedRasterBand *>(
+                    poNestedVRTDS->GetRasterBand(iBand));
+            if( poNestedBand == nullptr ||
+                poNestedBand->m_poMaskBand != nullptr ||
+                !poNestedBand->m_apoOverviews.empty() )
+            {
+                return false;
+            }
+            for( int iSource = 0; iSource < poNestedBand->nSources; iSource++ )
+            {
+                if( !poNestedBand->papoSources[iSource]->IsSimpleSource() ||
+                    !GetSourceDatasetKeys(
+                        static_cast<VRTSimpleSource *>(
+                            poNestedBand->papoSources[iSource]),
+                        aosKeys, nRecursionDepth + 1) )
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    CPLString osKey(poSrcDS->GetDescription());
+    if( osKey.empty() )
+    {
+        osKey.Printf("%p", poSrcDS);
+    }
+    else
+    {
+        if( dynamic_cast<GDALProxyPoolDataset *>(poSrcDS) != nullptr &&
+            (STARTS_WITH_CI(osKey, "<VRTDataset") ||
+             EQUAL(CPLGetExtension(osKey), "vrt")) )
+        {
+            return false;
+        }
+        // Normalize relative names, so that different names of a same
+        // file, which may resolve to a same dataset (for example with
+        // GDALOpenShared()), are grouped together.
+        if( CPLIsFilenameRelative(osKey) )
+        {
+            char* pszCurDir = CPLGetCurrentDir();
+            if( pszCurDir != nullptr )
+                osKey = CPLFormFilename(pszCurDir, osKey, nullptr);
+            CPLFree(pszCurDir);
+        }
+        osKey.replaceAll("/./", '/');
+    }
+    aosKeys.push_back(osKey);
+    return true;
+}
+
+/************************************************************************/
+/*                 GetSourceGroupsForMultiThreadedIO()                  */
+/*                                                                      */
+/*      Check if the sources intersecting the request write to          */
+/*      pairwise disjoint windows of the output buffer, in which case   */
+/*      the order in which they are read does not matter. Sources are   */
+/*      then grouped so that sources using a same dataset, directly or  */
+/*      through nested VRT datasets, are read by the same thread, as    */
+/*      datasets must not be used by several threads at once.           */
+/************************************************************************/
+
+bool VRTSourcedRasterBand::GetSourceGroupsForMultiThreadedIO(
+                        int nXOff, int nYOff, int nXSize, int nYSize,
+                        int nBufXSize, int nBufYSize,
+                        std::vector<std::vector<int>>& aanGroups )
+{
+    struct SourceWindow
+    {
+        int nXOff;
+        int nYOff;
+        int nXSize;
+        int nYSize;
+    };
+    std::vector<SourceWindow> asWindows;
+    std::vector<int> anSources;
+    // Union-find of the sources sharing a dataset.
+    std::vector<int> anParent;
+    std::map<CPLString, int> oMapDatasetToSource;
+    const auto GetRoot = [&anParent](int i)
+    {
+        while( anParent[i] != i )
+        {
+            anParent[i] = anParent[anParent[i]];
+            i = anParent[i];
+        }
+        return i;
+    };
+
+    for( int iSource = 0; iSource < nSources; iSource++ )
+    {
+        if( !papoSources[iSource]->IsSimpleSource() )
+            return false;
+        VRTSimpleSource* const poSource =
+            static_cast<VRTSimpleSource *>( papoSources[iSource] );
+
+        double dfReqXOff = 0.0;
+        double dfReqYOff = 0.0;
+        double dfReqXSize = 0.0;
+        double dfReqYSize = 0.0;
+        int nReqXOff = 0;
+        int nReqYOff = 0;
+        int nReqXSize = 0;
+        int nReqYSize = 0;
+        SourceWindow sWindow;
+        if( !poSource->GetSrcDstWindow( nXOff, nYOff, nXSize, nYSize,
+                              nBufXSize, nBufYSize,
+                              &dfReqXOff, &dfReqYOff, &dfReqXSize, &dfReqYSize,
+                              &nReqXOff, &nReqYOff, &nReqXSize, &nReqYSize,
+                              &sWindow.nXOff, &sWindow.nYOff,
+                              &sWindow.nXSize, &sWindow.nYSize ) )
+        {
+            continue;
+        }
+
+        std::vector<CPLString> aosKeys;
+        if( !GetSourceDatasetKeys( poSource, aosKeys, 0 ) )
+            return false;
+
+        const int i = static_cast<int>(anSources.size());
+        anSources.push_back(iSource);
+        anParent.push_back(i);
+        for( const auto& osKey: aosKeys )
+        {
+            auto oIter = oMapDatasetToSource.find(osKey);
+            if( oIter == oMapDatasetToSource.end() )
+                oMapDatasetToSource[osKey] = i;
+            else
+                anParent[GetRoot(i)] = GetRoot(oIter->second);
+        }
+        asWindows.push_back(sWindow);
+    }
+
+    std::map<int, int> oMapRootToGroup;
+    for( int i = 0; i < static_cast<int>(anSources.size()); i++ )
+    {
+        const int nRoot = GetRoot(i);
+        auto oIter = oMapRootToGroup.find(nRoot);
+        if( oIter == oMapRootToGroup.end() )
+        {
+            oMapRootToGroup[nRoot] = static_cast<int>(aanGroups.size());
+            aanGroups.push_back(std::vector<int>(1, anSources[i]));
+        }
+        else
+        {
+            aanGroups[oIter->second].push_back(anSources[i]);
+        }
+    }
+
+    if( aanGroups.size() < 2 )
+        return false;
+
+    // Check that the output windows do not overlap, by sweeping them in
+    // increasing Y order.
+    std::sort(asWindows.begin(), asWindows.end(),
+              [](const SourceWindow& a, const SourceWindow& b)
+              { return a.nYOff < b.nYOff; });
+    for( size_t i = 0; i < asWindows.size(); i++ )
+    {
+        const SourceWindow& a = asWindows[i];
+        for( size_t j = i + 1; j < asWindows.size() &&
+                               asWindows[j].nYOff < a.nYOff + a.nYSize; j++ )
+        {
+            const SourceWindow& b = asWindows[j];
+            if( b.nXOff < a.nXOff + a.nXSize && a.nXOff < b.nXOff + b.nXSize )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                       SourceGroupRasterIOJob()                       */
+/************************************************************************/
+
+namespace {
+
+struct VRTSourceGroupIOContext
+{
+    VRTSourcedRasterBand *poBand;
+    int                   nXOff;
+    int                   nYOff;
+    int                   nXSize;
+    int                   nYSize;
+    void                 *pData;
+    int                   nBufXSize;
+    int                   nBufYSize;
+    GDALDataType          eBufType;
+    int                   nBandCount;  // 0 for band-level RasterIO
+    int                  *panBandMap;
+    GSpacing              nPixelSpace;
+    GSpacing              nLineSpace;
+    GSpacing              nBandSpace;
+    GDALRIOResampleAlg    eResampleAlg;
+    std::atomic<int>      nCompletedSources;
+    std::atomic<int>      nCompletedJobs;
+    std::atomic<bool>     bStop;
+};
+
+struct VRTSourceGroupIOError
+{
+    CPLErr      eErrClass;
+    CPLErrorNum nErrNo;
+    CPLString   osMsg;
+};
+
+struct VRTSourceGroupIOJob
+{
+    VRTSourceGroupIOContext           *psContext;
+    const std::vector<int>            *panSources;
+    CPLErr                             eErr;
+    std::vector<VRTSourceGroupIOError> asErrors;
+};
+
+} // namespace
+
+// Errors are collected by the worker threads and re-emitted by the
+// calling thread, so that they are reported as if the sources had been
+// read by it.
+static void CPL_STDCALL SourceGroupErrorHandler( CPLErr eErrClass,
+                                                 CPLErrorNum nErrNo,
+                                                 const char* pszMsg )
+{
+    VRTSourceGroupIOJob* psJob =
+        static_cast<VRTSourceGroupIOJob *>(CPLGetErrorHandlerUserData());
+    VRTSourceGroupIOError sError;
+    sError.eErrClass = eErrClass;
+    sError.nErrNo = nErrNo;
+    sError.osMsg = pszMsg;
+    psJob->asErrors.push_back(sError);
+}
+
+static void SourceGroupRasterIOJob( void* pData )
+{
+    VRTSourceGroupIOJob* psJob = static_cast<VRTSourceGroupIOJob *>(pData);
+    VRTSourceGroupIOContext* psContext = psJob->psContext;
+    VRTSourcedRasterBand* poBand = psContext->poBand;
+
+    GDALRasterIOExtraArg sExtraArg;
+    INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+    sExtraArg.eResampleAlg = psContext->eResampleAlg;
+
+    CPLPushErrorHandlerEx(SourceGroupErrorHandler, psJob);
+    for( size_t i = 0; i < psJob->panSources->size(); i++ )
+    {
+        if( psContext->bStop )
+            break;
+
+        VRTSimpleSource* poSource = static_cast<VRTSimpleSource *>(
+            poBand->papoSources[(*psJob->panSources)[i]] );
+        if( psContext->nBandCount == 0 )
+        {
+            psJob->eErr = poSource->RasterIO(
+                poBand->GetRasterDataType(),
+                psContext->nXOff, psContext->nYOff,
+                psContext->nXSize, psContext->nYSize,
+                psContext->pData,
+                psContext->nBufXSize, psContext->nBufYSize,
+                psContext->eBufType,
+                psContext->nPixelSpace, psContext->nLineSpace,
+                &sExtraArg );
+        }
+        else
+        {
+            psJob->eErr = poSource->DatasetRasterIO(
+                poBand->GetRasterDataType(),
+                psContext->nXOff, psContext->nYOff,
+                psContext->nXSize, psContext->nYSize,
+                psContext->pData,
+                psContext->nBufXSize, psContext->nBufYSize,
+                psContext->eBufType,
+                psContext->nBandCount, psContext->panBandMap,
+                psContext->nPixelSpace, psContext->nLineSpace,
+                psContext->nBandSpace,
+                &sExtraArg );
+        }
+        psContext->nCompletedSources++;
+        if( psJob->eErr != CE_None )
+        {
+            psContext->bStop = true;
+            break;
+        }
+    }
+    CPLPopErrorHandler();
+
+    psContext->nCompletedJobs++;
+}
+
+/************************************************************************/
+/*                    MultiThreadedSourcesRasterIO()                    */
+/*                                                                      */
+/*      Read the sources intersecting the request in parallel, when     */
+/*      the dataset has been opened with NUM_THREADS (or the            */
+/*      VRT_NUM_THREADS configuration option is set) and the sources    */
+/*      do not overlap. Returns false, without doing any I/O, if the    */
+/*      request must be processed sequentially. Otherwise eErr is set   */
+/*      to the result of the read. If nBandCount > 0, the sources are   */
+/*      read with VRTSimpleSource::DatasetRasterIO().                   */
+/************************************************************************/
+
+bool VRTSourcedRasterBand::MultiThreadedSourcesRasterIO(
+                              int nXOff, int nYOff, int nXSize, int nYSize,
+                              void *pData, int nBufXSize, int nBufYSize,
+                              GDALDataType eBufType,
+                              int nBandCount, int *panBandMap,
+                              GSpacing nPixelSpace, GSpacing nLineSpace,
+                              GSpacing nBandSpace,
+                              GDALRasterIOExtraArg* psExtraArg,
+                              CPLErr& eErr )
+{
+    VRTDataset* poVRTDS = dynamic_cast<VRTDataset *>(poDS);
+    if( poVRTDS == nullptr )
+        return false;
+    CPLWorkerThreadPool* poPool = poVRTDS->GetSourceThreadPool();
+    if( poPool == nullptr )
+        return false;
+
+    std::vector<std::vector<int>> aanGroups;
+    if( !GetSourceGroupsForMultiThreadedIO( nXOff, nYOff, nXSize, nYSize,
+                                            nBufXSize, nBufYSize, aanGroups ) )
+        return false;
+
+    VRTSourceGroupIOContext sContext;
+    sContext.poBand = this;
+    sContext.nXOff = nXOff;
+    sContext.nYOff = nYOff;
+    sContext.nXSize = nXSize;
+    sContext.nYSize = nYSize;
+    sContext.pData = pData;
+    sContext.nBufXSize = nBufXSize;
+    sContext.nBufYSize = nBufYSize;
+    sContext.eBufType = eBufType;
+    sContext.nBandCount = nBandCount;
+    sContext.panBandMap = panBandMap;
+    sContext.nPixelSpace = nPixelSpace;
+    sContext.nLineSpace = nLineSpace;
+    sContext.nBandSpace = nBandSpace;
+    sContext.eResampleAlg = psExtraArg->eResampleAlg;
+    sContext.nCompletedSources = 0;
+    sContext.nCompletedJobs = 0;
+    sContext.bStop = false;
+
+    int nTotalSources = 0;
+    std::vector<VRTSourceGroupIOJob> asJobs(aanGroups.size());
+    std::vector<void*> apJobs;
+    for( size_t i = 0; i < aanGroups.size(); i++ )
+    {
+        asJobs[i].psContext = &sContext;
+        asJobs[i].panSources = &aanGroups[i];
+        asJobs[i].eErr = CE_None;
+        apJobs.push_back(&asJobs[i]);
+        nTotalSources += static_cast<int>(aanGroups[i].size());
+    }
+
+    // Read the biggest groups first to balance the load.
+    std::stable_sort(apJobs.begin(), apJobs.end(),
+        [](const void* a, const void* b)
+        {
+            return static_cast<const VRTSourceGroupIOJob*>(a)->
+                        panSources->size() >
+                   static_cast<const VRTSourceGroupIOJob*>(b)->
+                        panSources->size();
+        });
+
+    // The pool is shared with other users and may have more threads than
+    // allowed for this dataset, so limit the number of running jobs.
+    auto poJobQueue =
+        poPool->CreateJobQueue(poVRTDS->GetSourceThreadCount());
+    poJobQueue->SubmitJobs(SourceGroupRasterIOJob, apJobs);
+    bool bInterrupted = false;
+    while( sContext.nCompletedJobs < static_cast<int>(asJobs.size()) )
+    {
+        poJobQueue->WaitEvent();
+        if( psExtraArg->pfnProgress != nullptr && !bInterrupted &&
+            !psExtraArg->pfnProgress(
+                    1.0 * sContext.nCompletedSources / nTotalSources, "",
+                    psExtraArg->pProgressData) )
+        {
+            bInterrupted = true;
+            sContext.bStop = true;
+        }
+    }
+
+    eErr = CE_None;
+    for( size_t i = 0; i < asJobs.size(); i++ )
+    {
+        for( const auto& sError : asJobs[i].asErrors )
+            CPLError(sError.eErrClass, sError.nErrNo, "%s",
+                     sError.osMsg.c_str());
+        if( asJobs[i].eErr != CE_None )
+            eErr = asJobs[i].eErr;
+    }
+    if( bInterrupted && eErr == CE_None )
+    {
+        CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+        eErr = CE_Failure;
+    }
+
+    return true;
+}
+
 /************************************************************************/
 /*                         IGetDataCoverageStatus()                     */
 /************************************************************************/
@@ -269,6 +269,9 @@ typedef void *GDALRasterAttributeTableH;
 /** Opaque type used for the C bindings of the C++ GDALAsyncReader class */
 typedef void *GDALAsyncReaderH;
 
+/** Opaque type used for the C bindings of the C++ GDALRasterIORequest class */
+typedef void *GDALRasterIORequestH;
+
 /** Type to express pixel, line or band spacing. Signed 64 bit integer. */
 typedef GIntBig GSpacing;
 
@@ -659,6 +662,14 @@ CPLErr CPL_DLL CPL_STDCALL GDALDatasetRasterIOEx(
     GSpacing nPixelSpace, GSpacing nLineSpace, GSpacing nBandSpace,
     GDALRasterIOExtraArg* psExtraArg) CPL_WARN_UNUSED_RESULT;
 
+GDALRasterIORequestH CPL_DLL GDALDatasetAsyncRasterIO(
+    GDALDatasetH hDS,
+    int nDSXOff, int nDSYOff, int nDSXSize, int nDSYSize,
+    void * pBuffer, int nBXSize, int nBYSize, GDALDataType eBDataType,
+    int nBandCount, int *panBandMap,
+    GSpacing nPixelSpace, GSpacing nLineSpace, GSpacing nBandSpace,
+    GDALRasterIOExtraArg* psExtraArg) CPL_WARN_UNUSED_RESULT;
+
 CPLErr CPL_DLL CPL_STDCALL GDALDatasetAdviseRead( GDALDatasetH hDS,
     int nDSXOff, int nDSYOff, int nDSXSize, int nDSYSize,
     int nBXSize, int nBYSize, GDALDataType eBDataType,
@@ -788,6 +799,13 @@ CPLErr CPL_DLL CPL_STDCALL GDALRasterAdviseRead( GDALRasterBandH hRB,
     int nDSXOff, int nDSYOff, int nDSXSize, int nDSYSize,
     int nBXSize, int nBYSize, GDALDataType eBDataType, CSLConstList papszOptions );
 
+GDALRasterIORequestH CPL_DLL GDALRasterAsyncRasterIO(
+    GDALRasterBandH hBand,
+    int nDSXOff, int nDSYOff, int nDSXSize, int nDSYSize,
+    void * pBuffer, int nBXSize, int nBYSize, GDALDataType eBDataType,
+    GSpacing nPixelSpace, GSpacing nLineSpace,
+    GDALRasterIOExtraArg* psExtraArg) CPL_WARN_UNUSED_RESULT;
+
 CPLErr CPL_DLL CPL_STDCALL
 GDALRasterIO( GDALRasterBandH hRBand, GDALRWFlag eRWFlag,
               int nDSXOff, int nDSYOff, int nDSXSize, int nDSYSize,
@@ -953,6 +971,16 @@ int CPL_DLL CPL_STDCALL GDALARLockBuffer(GDALAsyncReaderH hARIO,
                                         double dfTimeout);
 void CPL_DLL CPL_STDCALL GDALARUnlockBuffer(GDALAsyncReaderH hARIO);
 
+/* ==================================================================== */
+/*     GDALRasterIORequest                                              */
+/* ==================================================================== */
+
+int CPL_DLL GDALRasterIORequestWait(GDALRasterIORequestH hRequest,
+                                    double dfTimeout);
+CPLErr CPL_DLL GDALRasterIORequestGetResult(GDALRasterIORequestH hRequest);
+void CPL_DLL GDALRasterIORequestCancel(GDALRasterIORequestH hRequest);
+void CPL_DLL GDALRasterIORequestDestroy(GDALRasterIORequestH hRequest);
+
 /* -------------------------------------------------------------------- */
 /*      Helper functions.                                               */
 /* -------------------------------------------------------------------- */
@@ -1246,6 +1274,11 @@ CPLVirtualMem CPL_DLL* GDALGetVirtualMemAuto( GDALRasterBandH hBand,
                                               GIntBig *pnLineSpace,
                                               CSLConstList papszOptions ) CPL_WARN_UNUSED_RESULT;
 
+const void CPL_DLL* GDALGetMappedBlock( GDALRasterBandH hBand,
+                                        int nXBlockOff, int nYBlockOff,
+                                        GSpacing *pnPixelSpace,
+                                        GSpacing *pnLineSpace );
+
 /**! Enumeration to describe the tile organization */
 typedef enum
 {
@@ -50,6 +50,7 @@ class GDALRasterAttributeTable;
 class GDALProxyDataset;
 class GDALProxyRasterBand;
 class GDALAsyncReader;
+class GDALRasterIORequest;
 
 /* -------------------------------------------------------------------- */
 /*      Pull in the public declarations.  This gets the C apis, and     */
@@ -383,6 +384,15 @@ class CPL_DLL GDALDataset : public GDALMajorObject
                               int, int *, GSpacing, GSpacing, GSpacing,
                               GDALRasterIOExtraArg* psExtraArg ) CPL_WARN_UNUSED_RESULT;
 
+    virtual std::unique_ptr<GDALRasterIORequest>
+                   IAsyncRasterIO( int nXOff, int nYOff, int nXSize, int nYSize,
+                                   void *pData, int nBufXSize, int nBufYSize,
+                                   GDALDataType eBufType,
+                                   int nBandCount, int *panBandMap,
+                                   GSpacing nPixelSpace, GSpacing nLineSpace,
+                                   GSpacing nBandSpace,
+                                   GDALRasterIOExtraArg* psExtraArg );
+
     CPLErr BlockBasedRasterIO( GDALRWFlag, int, int, int, int,
                                void *, int, int, GDALDataType,
                                int, int *, GSpacing, GSpacing, GSpacing,
@@ -544,6 +554,15 @@ class CPL_DLL GDALDataset : public GDALMajorObject
                          char **papszOptions);
     virtual void EndAsyncReader(GDALAsyncReader *);
 
+    std::unique_ptr<GDALRasterIORequest>
+                AsyncRasterIO( int nXOff, int nYOff, int nXSize, int nYSize,
+                               void *pData, int nBufXSize, int nBufYSize,
+                               GDALDataType eBufType,
+                               int nBandCount, int *panBandMap,
+                               GSpacing nPixelSpace, GSpacing nLineSpace,
+                               GSpacing nBandSpace,
+                               GDALRasterIOExtraArg* psExtraArg = nullptr );
+
     CPLErr      RasterIO( GDALRWFlag, int, int, int, int,
                           void *, int, int, GDALDataType,
                           int, int *, GSpacing, GSpacing, GSpacing,
@@ -1246,6 +1265,13 @@ class CPL_DLL GDALRasterBand : public GDALMajorObject
                                int nBufXSize, int nBufYSize,
                                GDALDataType eBufType, char **papszOptions );
 
+    std::unique_ptr<GDALRasterIORequest>
+                AsyncRasterIO( int nXOff, int nYOff, int nXSize, int nYSize,
+                               void *pData, int nBufXSize, int nBufYSize,
+                               GDALDataType eBufType,
+                               GSpacing nPixelSpace, GSpacing nLineSpace,
+                               GDALRasterIOExtraArg* psExtraArg = nullptr );
+
     virtual CPLErr  GetHistogram( double dfMin, double dfMax,
                           int nBuckets, GUIntBig * panHistogram,
                           int bIncludeOutOfRange, int bApproxOK,
@@ -1270,6 +1296,10 @@ class CPL_DLL GDALRasterBand : public GDALMajorObject
                                                GIntBig *pnLineSpace,
                                                char **papszOptions ) CPL_WARN_UNUSED_RESULT;
 
+    virtual const void     *GetMappedBlock( int nXBlockOff, int nYBlockOff,
+                                            GSpacing *pnPixelSpace,
+                                            GSpacing *pnLineSpace );
+
     int GetDataCoverageStatus( int nXOff, int nYOff,
                                int nXSize, int nYSize,
                                int nMaskFlagStop = 0,
@@ -1586,6 +1616,58 @@ CPL_C_START
 GDALDriverManager CPL_DLL * GetGDALDriverManager( void );
 CPL_C_END
 
+/* ******************************************************************** */
+/*                         GDALRasterIORequest                          */
+/* ******************************************************************** */
+
+/**
+ * Handle on a read request run asynchronously, returned by
+ * GDALDataset::AsyncRasterIO() and GDALRasterBand::AsyncRasterIO().
+ *
+ * The output buffer must not be accessed until the request has completed.
+ * Destroying a request that has not completed cancels it if it has not
+ * started yet, and waits for its completion otherwise.
+ *
+ * @since GDAL 3.1
+ */
+class CPL_DLL GDALRasterIORequest
+{
+    CPL_DISALLOW_COPY_ASSIGN(GDALRasterIORequest)
+
+  public:
+    GDALRasterIORequest();
+    virtual ~GDALRasterIORequest();
+
+    /** Wait for the completion of the request.
+     *
+     * @param dfTimeout Maximum time to wait, in seconds, or a negative value
+     *                  to wait until completion.
+     * @return true if the request has completed.
+     */
+    virtual bool   Wait( double dfTimeout = -1.0 ) = 0;
+
+    /** Return the result of the request, after waiting for its completion.
+     *
+     * Errors emitted while processing the request are emitted again by
+     * the first call to this method.
+     */
+    virtual CPLErr GetResult() = 0;
+
+    /** Cancel the request, if it has not started yet.
+     *
+     * GetResult() returns CE_Failure for a cancelled request.
+     */
+    virtual void   Cancel() = 0;
+
+    /** Return whether the request has completed, without waiting. */
+    bool           IsDone() { return Wait(0.0); }
+};
+
+//! @cond Doxygen_Suppress
+void GDALWaitAsyncRasterIORequests( const void* pKey );
+void GDALCleanupAsyncRasterIO();
+//! @endcond
+
 /* ******************************************************************** */
 /*                          GDALAsyncReader                             */
 /* ******************************************************************** */
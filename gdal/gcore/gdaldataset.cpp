@@ -270,6 +270,10 @@ GDALDataset::GDALDataset(int bForceCachedIOIn):
 GDALDataset::~GDALDataset()
 
 {
+    // Requests started with AsyncRasterIO() must complete before the
+    // dataset is destroyed, whichever way it is.
+    GDALWaitAsyncRasterIORequests(this);
+
     // we don't want to report destruction of datasets that
     // were never really open or meant as internal
     if( !bIsInternal && (nBands != 0 || !EQUAL(GetDescription(), "")) )
@@ -3547,6 +3551,11 @@ void CPL_STDCALL GDALClose( GDALDatasetH hDS )
 
     GDALDataset *poDS = GDALDataset::FromHandle(hDS);
 
+    // Requests started with AsyncRasterIO() must complete before the
+    // dataset can be destroyed. ~GDALDataset() waits for them too, but
+    // only once the driver specific part of the dataset is gone.
+    GDALWaitAsyncRasterIORequests(poDS);
+
     if (poDS->GetShared())
     {
 /* -------------------------------------------------------------------- */
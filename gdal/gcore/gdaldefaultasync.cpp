@@ -2,7 +2,8 @@
  *
  * Project:  GDAL Core
  * Purpose:  Implementation of GDALDefaultAsyncReader and the
- *           GDALAsyncReader base class.
+ *           GDALAsyncReader base class, and of asynchronous RasterIO()
+ *           requests.
  * Author:   Frank Warmerdam, warmerdam@pobox.com
  *
  ******************************************************************************
@@ -30,11 +31,20 @@
 #include "cpl_port.h"
 #include "gdal_priv.h"
 
+#include <chrono>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 
 CPL_CVSID("$Id$")
@@ -410,3 +420,800 @@ GDALDefaultAsyncReader::GetNextUpdatedRegion( double /*dfTimeout*/,
     else
         return GARIO_ERROR;
 }
+
+/************************************************************************/
+/* ==================================================================== */
+/*                         GDALRasterIORequest                          */
+/* ==================================================================== */
+/************************************************************************/
+
+/************************************************************************/
+/*                        GDALRasterIORequest()                         */
+/************************************************************************/
+
+GDALRasterIORequest::GDALRasterIORequest() = default;
+
+/************************************************************************/
+/*                       ~GDALRasterIORequest()                         */
+/************************************************************************/
+
+GDALRasterIORequest::~GDALRasterIORequest() = default;
+
+/************************************************************************/
+/* ==================================================================== */
+/*                      GDALAsyncRasterIOExecutor                       */
+/* ==================================================================== */
+/************************************************************************/
+
+// Requests on a dataset are run one after the other, by a single job of
+// a thread pool dedicated to the requests, as datasets cannot be used
+// concurrently from several threads. Requests on different datasets run in
+// parallel. That pool is distinct from the one of
+// CPLGetGlobalWorkerThreadPool(), as requests mostly wait for I/O.
+// Before running the requests queued since its last round, the job
+// advises the dataset of all of them, so that drivers able to fetch
+// several windows at once in AdviseRead() can overlap the I/O of the
+// outstanding requests.
+
+namespace {
+
+struct GDALAsyncRasterIOError
+{
+    CPLErr      eErrClass = CE_None;
+    CPLErrorNum nErrNo = CPLE_None;
+    CPLString   osMsg{};
+};
+
+struct GDALAsyncRasterIOTask
+{
+    enum class Status { PENDING, RUNNING, DONE };
+
+    std::function<CPLErr()> fnRead{};
+    std::function<void()>   fnAdvise{};
+    Status                  eStatus = Status::PENDING;
+    bool                    bCancelled = false;
+    CPLErr                  eErr = CE_None;
+    std::vector<GDALAsyncRasterIOError> asErrors{};
+};
+
+class GDALAsyncRasterIOExecutor :
+            public std::enable_shared_from_this<GDALAsyncRasterIOExecutor>
+{
+    CPL_DISALLOW_COPY_ASSIGN(GDALAsyncRasterIOExecutor)
+
+    // Object whose accesses are serialized: a dataset, or a band without
+    // dataset.
+    const void* m_pKey;
+    std::deque<std::shared_ptr<GDALAsyncRasterIOTask>> m_apoPending{};
+    bool m_bRunning = false;
+
+    static void JobFunc( void* pData );
+    static void CPL_STDCALL ErrorHandler( CPLErr eErrClass,
+                                          CPLErrorNum nErrNo,
+                                          const char* pszMsg );
+    void Run();
+
+  public:
+    std::mutex m_mutex{};
+    std::condition_variable m_cv{};
+
+    explicit GDALAsyncRasterIOExecutor( const void* pKey ) : m_pKey(pKey) {}
+    ~GDALAsyncRasterIOExecutor();
+
+    static std::shared_ptr<GDALAsyncRasterIOExecutor> Get( const void* pKey,
+                                                           bool bCreate );
+    void Submit( const std::shared_ptr<GDALAsyncRasterIOTask>& poTask );
+    void WaitIdle();
+};
+
+std::mutex goExecutorsMutex;
+std::map<const void*, std::weak_ptr<GDALAsyncRasterIOExecutor>>
+                                                            goMapExecutors;
+
+std::mutex goPoolMutex;
+std::unique_ptr<CPLWorkerThreadPool> gpoPool;
+std::unique_ptr<CPLJobQueue> gpoJobQueue;
+bool gbPoolSetupDone = false;
+
+/************************************************************************/
+/*                           GetJobQueue()                              */
+/************************************************************************/
+
+// Returns the queue of the pool running the requests, creating it on the
+// first call. Returns nullptr if it cannot be created, in which case the
+// requests are run synchronously.
+CPLJobQueue* GetJobQueue()
+{
+    std::lock_guard<std::mutex> oLock(goPoolMutex);
+    if( !gbPoolSetupDone )
+    {
+        gbPoolSetupDone = true;
+        const int nThreads = CPLGetNumThreads(
+            CPLGetConfigOption("GDAL_ASYNC_RASTERIO_NUM_THREADS", "8"));
+        gpoPool.reset(new CPLWorkerThreadPool());
+        if( gpoPool->Setup(nThreads, nullptr, nullptr, false) ||
+            gpoPool->GetThreadCount() > 0 )
+        {
+            gpoJobQueue = gpoPool->CreateJobQueue();
+        }
+        else
+        {
+            gpoPool.reset();
+        }
+    }
+    return gpoJobQueue.get();
+}
+
+/************************************************************************/
+/*                    ~GDALAsyncRasterIOExecutor()                      */
+/************************************************************************/
+
+GDALAsyncRasterIOExecutor::~GDALAsyncRasterIOExecutor()
+{
+    std::lock_guard<std::mutex> oLock(goExecutorsMutex);
+    auto oIter = goMapExecutors.find(m_pKey);
+    // The entry may already point to a new executor for the same dataset.
+    if( oIter != goMapExecutors.end() && oIter->second.expired() )
+        goMapExecutors.erase(oIter);
+}
+
+/************************************************************************/
+/*                                Get()                                 */
+/************************************************************************/
+
+std::shared_ptr<GDALAsyncRasterIOExecutor>
+GDALAsyncRasterIOExecutor::Get( const void* pKey, bool bCreate )
+{
+    std::lock_guard<std::mutex> oLock(goExecutorsMutex);
+    auto oIter = goMapExecutors.find(pKey);
+    std::shared_ptr<GDALAsyncRasterIOExecutor> poExecutor;
+    if( oIter != goMapExecutors.end() )
+        poExecutor = oIter->second.lock();
+    if( !poExecutor && bCreate )
+    {
+        poExecutor = std::make_shared<GDALAsyncRasterIOExecutor>(pKey);
+        goMapExecutors[pKey] = poExecutor;
+    }
+    return poExecutor;
+}
+
+/************************************************************************/
+/*                               Submit()                               */
+/************************************************************************/
+
+void GDALAsyncRasterIOExecutor::Submit(
+                        const std::shared_ptr<GDALAsyncRasterIOTask>& poTask )
+{
+    CPLJobQueue* poJobQueue = GetJobQueue();
+
+    {
+        std::lock_guard<std::mutex> oLock(m_mutex);
+        m_apoPending.push_back(poTask);
+        if( m_bRunning )
+            return;
+        m_bRunning = true;
+        if( poJobQueue )
+        {
+            // The job keeps the executor alive until it has finished.
+            poJobQueue->SubmitJob(JobFunc,
+                new std::shared_ptr<GDALAsyncRasterIOExecutor>(
+                                                    shared_from_this()));
+            return;
+        }
+    }
+
+    // No thread available: read synchronously.
+    Run();
+}
+
+/************************************************************************/
+/*                              JobFunc()                               */
+/************************************************************************/
+
+void GDALAsyncRasterIOExecutor::JobFunc( void* pData )
+{
+    auto ppoExecutor =
+        static_cast<std::shared_ptr<GDALAsyncRasterIOExecutor>*>(pData);
+    (*ppoExecutor)->Run();
+    delete ppoExecutor;
+}
+
+/************************************************************************/
+/*                            ErrorHandler()                            */
+/************************************************************************/
+
+// Errors are collected by the worker thread, and emitted again by the
+// thread calling GetResult().
+void CPL_STDCALL GDALAsyncRasterIOExecutor::ErrorHandler( CPLErr eErrClass,
+                                                          CPLErrorNum nErrNo,
+                                                          const char* pszMsg )
+{
+    GDALAsyncRasterIOTask* poTask =
+        static_cast<GDALAsyncRasterIOTask*>(CPLGetErrorHandlerUserData());
+    GDALAsyncRasterIOError sError;
+    sError.eErrClass = eErrClass;
+    sError.nErrNo = nErrNo;
+    sError.osMsg = pszMsg;
+    poTask->asErrors.push_back(sError);
+}
+
+/************************************************************************/
+/*                                Run()                                 */
+/************************************************************************/
+
+void GDALAsyncRasterIOExecutor::Run()
+{
+    while( true )
+    {
+        std::vector<std::shared_ptr<GDALAsyncRasterIOTask>> apoTasks;
+        {
+            std::lock_guard<std::mutex> oLock(m_mutex);
+            if( m_apoPending.empty() )
+            {
+                m_bRunning = false;
+                m_cv.notify_all();
+                return;
+            }
+            apoTasks.assign(m_apoPending.begin(), m_apoPending.end());
+            m_apoPending.clear();
+        }
+
+        if( apoTasks.size() > 1 )
+        {
+            std::vector<std::function<void()>> afnAdvise;
+            {
+                std::lock_guard<std::mutex> oLock(m_mutex);
+                for( const auto& poTask: apoTasks )
+                {
+                    if( !poTask->bCancelled && poTask->fnAdvise )
+                        afnAdvise.push_back(poTask->fnAdvise);
+                }
+            }
+            CPLErrorHandlerPusher oPusher(CPLQuietErrorHandler);
+            for( const auto& fnAdvise: afnAdvise )
+                fnAdvise();
+        }
+
+        for( const auto& poTask: apoTasks )
+        {
+            {
+                std::lock_guard<std::mutex> oLock(m_mutex);
+                if( poTask->bCancelled )
+                {
+                    poTask->eErr = CE_Failure;
+                    poTask->eStatus = GDALAsyncRasterIOTask::Status::DONE;
+                    m_cv.notify_all();
+                    continue;
+                }
+                poTask->eStatus = GDALAsyncRasterIOTask::Status::RUNNING;
+            }
+
+            CPLErr eErr;
+            {
+                CPLErrorHandlerPusher oPusher(ErrorHandler, poTask.get());
+                eErr = poTask->fnRead();
+            }
+            // Release what the request references as soon as possible.
+            poTask->fnRead = nullptr;
+            poTask->fnAdvise = nullptr;
+
+            std::lock_guard<std::mutex> oLock(m_mutex);
+            poTask->eErr = eErr;
+            poTask->eStatus = GDALAsyncRasterIOTask::Status::DONE;
+            m_cv.notify_all();
+        }
+    }
+}
+
+/************************************************************************/
+/*                              WaitIdle()                              */
+/************************************************************************/
+
+void GDALAsyncRasterIOExecutor::WaitIdle()
+{
+    std::unique_lock<std::mutex> oLock(m_mutex);
+    m_cv.wait(oLock, [this]{ return !m_bRunning && m_apoPending.empty(); });
+}
+
+/************************************************************************/
+/* ==================================================================== */
+/*                     GDALDefaultRasterIORequest                       */
+/* ==================================================================== */
+/************************************************************************/
+
+class GDALDefaultRasterIORequest final: public GDALRasterIORequest
+{
+    std::shared_ptr<GDALAsyncRasterIOExecutor> m_poExecutor;
+    std::shared_ptr<GDALAsyncRasterIOTask> m_poTask;
+    bool m_bErrorsEmitted = false;
+
+  public:
+    GDALDefaultRasterIORequest(
+        const std::shared_ptr<GDALAsyncRasterIOExecutor>& poExecutor,
+        const std::shared_ptr<GDALAsyncRasterIOTask>& poTask ) :
+        m_poExecutor(poExecutor), m_poTask(poTask) {}
+
+    ~GDALDefaultRasterIORequest() override
+    {
+        Cancel();
+        Wait();
+    }
+
+    bool Wait( double dfTimeout = -1.0 ) override;
+    CPLErr GetResult() override;
+    void Cancel() override;
+};
+
+/************************************************************************/
+/*                                Wait()                                */
+/************************************************************************/
+
+bool GDALDefaultRasterIORequest::Wait( double dfTimeout )
+{
+    std::unique_lock<std::mutex> oLock(m_poExecutor->m_mutex);
+    const auto IsDone = [this]
+        { return m_poTask->eStatus == GDALAsyncRasterIOTask::Status::DONE; };
+    if( dfTimeout < 0 )
+    {
+        // When waiting from a request being run (for example a VRT whose
+        // sources are read with requests), blocking could park all the
+        // threads of the pool while the request is queued: run pending
+        // jobs instead.
+        CPLJobQueue* poJobQueue = nullptr;
+        if( !IsDone() )
+        {
+            oLock.unlock();
+            poJobQueue = GetJobQueue();
+            if( poJobQueue &&
+                !poJobQueue->GetPool()->IsCurrentThreadWorker() )
+            {
+                poJobQueue = nullptr;
+            }
+            oLock.lock();
+        }
+        while( poJobQueue && !IsDone() )
+        {
+            oLock.unlock();
+            poJobQueue->WaitEvent();
+            oLock.lock();
+        }
+        m_poExecutor->m_cv.wait(oLock, IsDone);
+        return true;
+    }
+    return m_poExecutor->m_cv.wait_for(
+        oLock, std::chrono::duration<double>(dfTimeout), IsDone);
+}
+
+/************************************************************************/
+/*                             GetResult()                              */
+/************************************************************************/
+
+CPLErr GDALDefaultRasterIORequest::GetResult()
+{
+    Wait();
+    if( !m_bErrorsEmitted )
+    {
+        m_bErrorsEmitted = true;
+        for( const auto& sError: m_poTask->asErrors )
+            CPLError(sError.eErrClass, sError.nErrNo, "%s",
+                     sError.osMsg.c_str());
+        if( m_poTask->bCancelled && m_poTask->asErrors.empty() &&
+            m_poTask->eErr != CE_None )
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt,
+                     "RasterIO request cancelled");
+        }
+    }
+    return m_poTask->eErr;
+}
+
+/************************************************************************/
+/*                               Cancel()                               */
+/************************************************************************/
+
+void GDALDefaultRasterIORequest::Cancel()
+{
+    std::lock_guard<std::mutex> oLock(m_poExecutor->m_mutex);
+    if( m_poTask->eStatus == GDALAsyncRasterIOTask::Status::PENDING )
+        m_poTask->bCancelled = true;
+}
+
+/************************************************************************/
+/*                      SubmitAsyncRasterIOTask()                       */
+/************************************************************************/
+
+std::unique_ptr<GDALRasterIORequest>
+SubmitAsyncRasterIOTask( const void* pKey,
+                         const std::shared_ptr<GDALAsyncRasterIOTask>& poTask )
+{
+    auto poExecutor = GDALAsyncRasterIOExecutor::Get(pKey, true);
+    poExecutor->Submit(poTask);
+    return std::unique_ptr<GDALRasterIORequest>(
+        new GDALDefaultRasterIORequest(poExecutor, poTask));
+}
+
+} // namespace
+
+/************************************************************************/
+/*                   GDALWaitAsyncRasterIORequests()                    */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+// Called by the destructors of GDALDataset and GDALRasterBand (and before
+// by GDALClose(), so that the driver specific part of the dataset is still
+// alive), so that requests still pending do not access an object being
+// destroyed.
+void GDALWaitAsyncRasterIORequests( const void* pKey )
+{
+    {
+        std::lock_guard<std::mutex> oLock(goExecutorsMutex);
+        if( goMapExecutors.empty() )
+            return;
+    }
+    auto poExecutor = GDALAsyncRasterIOExecutor::Get(pKey, false);
+    if( poExecutor )
+        poExecutor->WaitIdle();
+}
+
+/************************************************************************/
+/*                     GDALCleanupAsyncRasterIO()                       */
+/************************************************************************/
+
+// Called by GDALDestroyDriverManager() to stop the threads running the
+// requests.
+void GDALCleanupAsyncRasterIO()
+{
+    std::lock_guard<std::mutex> oLock(goPoolMutex);
+    gpoJobQueue.reset();
+    gpoPool.reset();
+    gbPoolSetupDone = false;
+}
+//! @endcond
+
+/************************************************************************/
+/*                           IAsyncRasterIO()                           */
+/************************************************************************/
+
+/**
+ * \brief Start an asynchronous read request.
+ *
+ * This is the method that drivers may override to process requests in
+ * their own way, for example to issue the I/O of several outstanding
+ * requests together. The parameters have been validated and copied by
+ * GDALDataset::AsyncRasterIO(), and psExtraArg is not nullptr.
+ *
+ * The default implementation runs the requests on a dataset one after the
+ * other, in a thread of a pool dedicated to the requests, whose size is set
+ * with the GDAL_ASYNC_RASTERIO_NUM_THREADS configuration option (8 by
+ * default). If that pool cannot be created, requests are read
+ * synchronously. Before reading a group of requests queued together, it
+ * calls AdviseRead() for each of them. No driver overrides this method yet.
+ *
+ * @since GDAL 3.1
+ */
+
+std::unique_ptr<GDALRasterIORequest>
+GDALDataset::IAsyncRasterIO( int nXOff, int nYOff, int nXSize, int nYSize,
+                             void *pData, int nBufXSize, int nBufYSize,
+                             GDALDataType eBufType,
+                             int nBandCount, int *panBandMap,
+                             GSpacing nPixelSpace, GSpacing nLineSpace,
+                             GSpacing nBandSpace,
+                             GDALRasterIOExtraArg* psExtraArg )
+{
+    std::vector<int> anBandMap(panBandMap, panBandMap + nBandCount);
+    const GDALRasterIOExtraArg sExtraArg = *psExtraArg;
+
+    auto poTask = std::make_shared<GDALAsyncRasterIOTask>();
+    poTask->fnRead = [=]() mutable
+    {
+        return RasterIO(GF_Read, nXOff, nYOff, nXSize, nYSize,
+                        pData, nBufXSize, nBufYSize, eBufType,
+                        nBandCount, anBandMap.data(),
+                        nPixelSpace, nLineSpace, nBandSpace,
+                        const_cast<GDALRasterIOExtraArg*>(&sExtraArg));
+    };
+    poTask->fnAdvise = [=]() mutable
+    {
+        CPL_IGNORE_RET_VAL(AdviseRead(nXOff, nYOff, nXSize, nYSize,
+                                      nBufXSize, nBufYSize, eBufType,
+                                      nBandCount, anBandMap.data(),
+                                      nullptr));
+    };
+    return SubmitAsyncRasterIOTask(this, poTask);
+}
+
+/************************************************************************/
+/*                           AsyncRasterIO()                            */
+/************************************************************************/
+
+/**
+ * \brief Read a region of image data for multiple bands asynchronously.
+ *
+ * This method has the same parameters as GDALDataset::RasterIO() in
+ * GF_Read mode, but returns immediately a request object, on which
+ * GDALRasterIORequest::Wait() and GDALRasterIORequest::GetResult() can be
+ * called to wait for the completion of the read. Several requests may be
+ * in flight at the same time. Requests on different datasets are read in
+ * parallel, and drivers implementing AdviseRead() can overlap the I/O of the
+ * requests on a dataset.
+ *
+ * The pData buffer must be kept alive, and must not be accessed, until the
+ * request has completed. panBandMap and psExtraArg are copied. If a progress
+ * function is set in psExtraArg, it is called from another thread.
+ *
+ * While requests are pending, the dataset must not be used from the calling
+ * thread, other than to submit new requests. Closing the dataset waits for
+ * the completion of pending requests, but the request objects must be
+ * destroyed before the dataset.
+ *
+ * This method is the same as the C GDALDatasetAsyncRasterIO() function.
+ *
+ * @return a request object, or nullptr in case of invalid parameters.
+ * @since GDAL 3.1
+ */
+
+std::unique_ptr<GDALRasterIORequest>
+GDALDataset::AsyncRasterIO( int nXOff, int nYOff, int nXSize, int nYSize,
+                            void *pData, int nBufXSize, int nBufYSize,
+                            GDALDataType eBufType,
+                            int nBandCount, int *panBandMap,
+                            GSpacing nPixelSpace, GSpacing nLineSpace,
+                            GSpacing nBandSpace,
+                            GDALRasterIOExtraArg* psExtraArg )
+{
+    if( pData == nullptr )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "The buffer into which the data should be read is null" );
+        return nullptr;
+    }
+
+    std::vector<int> anBandMap;
+    if( panBandMap == nullptr )
+    {
+        for( int i = 0; i < nBandCount; ++i )
+            anBandMap.push_back(i + 1);
+        panBandMap = anBandMap.data();
+    }
+
+    int bStopProcessing = FALSE;
+    if( ValidateRasterIOOrAdviseReadParameters( "AsyncRasterIO()",
+                                &bStopProcessing,
+                                nXOff, nYOff, nXSize, nYSize,
+                                nBufXSize, nBufYSize,
+                                nBandCount, panBandMap) != CE_None ||
+        bStopProcessing )
+    {
+        return nullptr;
+    }
+
+    GDALRasterIOExtraArg sExtraArg;
+    if( psExtraArg == nullptr )
+    {
+        INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+        psExtraArg = &sExtraArg;
+    }
+    else if( psExtraArg->nVersion != RASTERIO_EXTRA_ARG_CURRENT_VERSION )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "Unhandled version of GDALRasterIOExtraArg" );
+        return nullptr;
+    }
+
+    const int nPixelSize = GDALGetDataTypeSizeBytes(eBufType);
+    if( nPixelSpace == 0 )
+        nPixelSpace = nPixelSize;
+    if( nLineSpace == 0 )
+        nLineSpace = nPixelSpace * nBufXSize;
+    if( nBandSpace == 0 )
+        nBandSpace = nLineSpace * nBufYSize;
+
+    return IAsyncRasterIO(nXOff, nYOff, nXSize, nYSize,
+                          pData, nBufXSize, nBufYSize, eBufType,
+                          nBandCount, panBandMap,
+                          nPixelSpace, nLineSpace, nBandSpace,
+                          psExtraArg);
+}
+
+/************************************************************************/
+/*                      GDALDatasetAsyncRasterIO()                      */
+/************************************************************************/
+
+/**
+ * \brief Read a region of image data for multiple bands asynchronously.
+ *
+ * @see GDALDataset::AsyncRasterIO()
+ * @return a request handle to destroy with GDALRasterIORequestDestroy(),
+ *         or NULL in case of invalid parameters.
+ * @since GDAL 3.1
+ */
+
+GDALRasterIORequestH GDALDatasetAsyncRasterIO(
+    GDALDatasetH hDS,
+    int nXOff, int nYOff, int nXSize, int nYSize,
+    void * pData, int nBufXSize, int nBufYSize, GDALDataType eBufType,
+    int nBandCount, int *panBandMap,
+    GSpacing nPixelSpace, GSpacing nLineSpace, GSpacing nBandSpace,
+    GDALRasterIOExtraArg* psExtraArg )
+{
+    VALIDATE_POINTER1( hDS, "GDALDatasetAsyncRasterIO", nullptr );
+
+    return GDALDataset::FromHandle(hDS)->AsyncRasterIO(
+        nXOff, nYOff, nXSize, nYSize, pData, nBufXSize, nBufYSize, eBufType,
+        nBandCount, panBandMap, nPixelSpace, nLineSpace, nBandSpace,
+        psExtraArg).release();
+}
+
+/************************************************************************/
+/*                           AsyncRasterIO()                            */
+/************************************************************************/
+
+/**
+ * \brief Read a region of image data for this band asynchronously.
+ *
+ * This method has the same parameters as GDALRasterBand::RasterIO() in
+ * GF_Read mode, and the same behaviour as GDALDataset::AsyncRasterIO().
+ * Requests on the bands of a dataset and on the dataset itself are
+ * processed one after the other.
+ *
+ * This method is the same as the C GDALRasterAsyncRasterIO() function.
+ *
+ * @return a request object, or nullptr in case of invalid parameters.
+ * @since GDAL 3.1
+ */
+
+std::unique_ptr<GDALRasterIORequest>
+GDALRasterBand::AsyncRasterIO( int nXOff, int nYOff, int nXSize, int nYSize,
+                               void *pData, int nBufXSize, int nBufYSize,
+                               GDALDataType eBufType,
+                               GSpacing nPixelSpace, GSpacing nLineSpace,
+                               GDALRasterIOExtraArg* psExtraArg )
+{
+    if( pData == nullptr )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "The buffer into which the data should be read is null" );
+        return nullptr;
+    }
+    if( nXOff < 0 || nXOff > INT_MAX - nXSize || nXOff + nXSize > nRasterXSize
+        || nYOff < 0 || nYOff > INT_MAX - nYSize ||
+        nYOff + nYSize > nRasterYSize )
+    {
+        CPLError( CE_Failure, CPLE_IllegalArg,
+                  "Access window out of range in AsyncRasterIO().  "
+                  "Requested (%d,%d) of size %dx%d on raster of %dx%d.",
+                  nXOff, nYOff, nXSize, nYSize, nRasterXSize, nRasterYSize );
+        return nullptr;
+    }
+
+    GDALRasterIOExtraArg sExtraArg;
+    if( psExtraArg == nullptr )
+    {
+        INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+    }
+    else if( psExtraArg->nVersion != RASTERIO_EXTRA_ARG_CURRENT_VERSION )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "Unhandled version of GDALRasterIOExtraArg" );
+        return nullptr;
+    }
+    else
+    {
+        sExtraArg = *psExtraArg;
+    }
+
+    auto poTask = std::make_shared<GDALAsyncRasterIOTask>();
+    poTask->fnRead = [=]() mutable
+    {
+        return RasterIO(GF_Read, nXOff, nYOff, nXSize, nYSize,
+                        pData, nBufXSize, nBufYSize, eBufType,
+                        nPixelSpace, nLineSpace, &sExtraArg);
+    };
+    poTask->fnAdvise = [=]()
+    {
+        CPL_IGNORE_RET_VAL(AdviseRead(nXOff, nYOff, nXSize, nYSize,
+                                      nBufXSize, nBufYSize, eBufType,
+                                      nullptr));
+    };
+    // Bands without dataset are serialized on their own.
+    return SubmitAsyncRasterIOTask(
+        poDS ? static_cast<const void*>(poDS) : this, poTask);
+}
+
+/************************************************************************/
+/*                      GDALRasterAsyncRasterIO()                       */
+/************************************************************************/
+
+/**
+ * \brief Read a region of image data for this band asynchronously.
+ *
+ * @see GDALRasterBand::AsyncRasterIO()
+ * @return a request handle to destroy with GDALRasterIORequestDestroy(),
+ *         or NULL in case of invalid parameters.
+ * @since GDAL 3.1
+ */
+
+GDALRasterIORequestH GDALRasterAsyncRasterIO(
+    GDALRasterBandH hBand,
+    int nXOff, int nYOff, int nXSize, int nYSize,
+    void * pData, int nBufXSize, int nBufYSize, GDALDataType eBufType,
+    GSpacing nPixelSpace, GSpacing nLineSpace,
+    GDALRasterIOExtraArg* psExtraArg )
+{
+    VALIDATE_POINTER1( hBand, "GDALRasterAsyncRasterIO", nullptr );
+
+    return GDALRasterBand::FromHandle(hBand)->AsyncRasterIO(
+        nXOff, nYOff, nXSize, nYSize, pData, nBufXSize, nBufYSize, eBufType,
+        nPixelSpace, nLineSpace, psExtraArg).release();
+}
+
+/************************************************************************/
+/*                      GDALRasterIORequestWait()                       */
+/************************************************************************/
+
+/**
+ * \brief Wait for the completion of an asynchronous read request.
+ *
+ * @see GDALRasterIORequest::Wait()
+ * @return TRUE if the request has completed.
+ * @since GDAL 3.1
+ */
+
+int GDALRasterIORequestWait( GDALRasterIORequestH hRequest, double dfTimeout )
+{
+    VALIDATE_POINTER1( hRequest, "GDALRasterIORequestWait", FALSE );
+    return static_cast<GDALRasterIORequest*>(hRequest)->Wait(dfTimeout);
+}
+
+/************************************************************************/
+/*                    GDALRasterIORequestGetResult()                    */
+/************************************************************************/
+
+/**
+ * \brief Return the result of an asynchronous read request.
+ *
+ * @see GDALRasterIORequest::GetResult()
+ * @since GDAL 3.1
+ */
+
+CPLErr GDALRasterIORequestGetResult( GDALRasterIORequestH hRequest )
+{
+    VALIDATE_POINTER1( hRequest, "GDALRasterIORequestGetResult", CE_Failure );
+    return static_cast<GDALRasterIORequest*>(hRequest)->GetResult();
+}
+
+/************************************************************************/
+/*                     GDALRasterIORequestCancel()                      */
+/************************************************************************/
+
+/**
+ * \brief Cancel an asynchronous read request, if it has not started yet.
+ *
+ * @see GDALRasterIORequest::Cancel()
+ * @since GDAL 3.1
+ */
+
+void GDALRasterIORequestCancel( GDALRasterIORequestH hRequest )
+{
+    VALIDATE_POINTER0( hRequest, "GDALRasterIORequestCancel" );
+    static_cast<GDALRasterIORequest*>(hRequest)->Cancel();
+}
+
+/************************************************************************/
+/*                     GDALRasterIORequestDestroy()                     */
+/************************************************************************/
+
+/**
+ * \brief Destroy an asynchronous read request.
+ *
+ * If the request has not completed, it is cancelled if it has not started
+ * yet, and waited for otherwise.
+ *
+ * @since GDAL 3.1
+ */
+
+void GDALRasterIORequestDestroy( GDALRasterIORequestH hRequest )
+{
+    delete static_cast<GDALRasterIORequest*>(hRequest);
+}
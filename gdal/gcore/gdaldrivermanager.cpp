@@ -40,6 +40,7 @@
 #include "cpl_port.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal_alg.h"
 #include "gdal_alg_priv.h"
 #include "gdal.h"
@@ -232,6 +233,13 @@ GDALDriverManager::~GDALDriverManager()
 /* -------------------------------------------------------------------- */
     PamCleanProxyDB();
 
+/* -------------------------------------------------------------------- */
+/*      Stop the threads running asynchronous RasterIO requests, and    */
+/*      the ones of the shared worker thread pool.                      */
+/* -------------------------------------------------------------------- */
+    GDALCleanupAsyncRasterIO();
+    CPLCleanupGlobalWorkerThreadPool();
+
 /* -------------------------------------------------------------------- */
 /*      Blow away all the finder hints paths.  We really should not     */
 /*      be doing all of them, but it is currently hard to keep track    */
@@ -84,6 +84,10 @@ GDALRasterBand::GDALRasterBand(int bForceCachedIOIn):
 GDALRasterBand::~GDALRasterBand()
 
 {
+    // Requests started with AsyncRasterIO() on a band without dataset.
+    if( poDS == nullptr )
+        GDALWaitAsyncRasterIORequests(this);
+
     GDALRasterBand::FlushCache();
 
     delete poBandBlockCache;
@@ -6695,6 +6699,89 @@ CPLVirtualMem * GDALGetVirtualMemAuto( GDALRasterBandH hBand,
                                       const_cast<char**>(papszOptions) );
 }
 
+/************************************************************************/
+/*                           GetMappedBlock()                           */
+/************************************************************************/
+
+/** \brief Return a read-only pointer to the data of a block in a memory
+ * mapping of the file.
+ *
+ * This method allows reading a block without copying it through the block
+ * cache, when the file is stored on a local file system (or in /vsimem/)
+ * and the block is stored uncompressed, with the data type of the band and
+ * in the byte order of the CPU. When those requirements are not met, nullptr
+ * is returned, without emitting any error, and the caller should fall back
+ * to RasterIO() or ReadBlock().
+ *
+ * If p is the returned pointer and base_type the type matching
+ * GDALGetRasterDataType(), the element of coordinates (x, y) inside the
+ * block can be accessed with
+ * *(const base_type*) ((const GByte*)p + x * *pnPixelSpace + y * *pnLineSpace)
+ *
+ * For blocks at the right or bottom edge of the raster, only the elements
+ * that are inside the raster may be accessed.
+ *
+ * The pointer remains valid until the dataset is closed. It is only
+ * returned for datasets opened in read-only mode. Accessing it may raise
+ * a SIGBUS signal if the file is truncated by another process.
+ *
+ * At the time of writing, the GeoTIFF driver and "raw" drivers (EHdr, ...)
+ * implement this method. The default implementation returns nullptr.
+ *
+ * This method is the same as the C GDALGetMappedBlock() function.
+ *
+ * @param nXBlockOff the horizontal block offset, with zero indicating
+ * the left most block, 1 the next block and so forth.
+ *
+ * @param nYBlockOff the vertical block offset, with zero indicating
+ * the top most block, 1 the next block and so forth.
+ *
+ * @param pnPixelSpace Output parameter giving the byte offset from the start
+ * of one pixel value to the start of the next pixel value within a line.
+ *
+ * @param pnLineSpace Output parameter giving the byte offset from the start
+ * of one line of the block to the start of the next.
+ *
+ * @return a pointer to the first element of the block, or nullptr.
+ *
+ * @since GDAL 3.1
+ */
+
+const void *GDALRasterBand::GetMappedBlock( int /* nXBlockOff */,
+                                            int /* nYBlockOff */,
+                                            GSpacing * /* pnPixelSpace */,
+                                            GSpacing * /* pnLineSpace */ )
+{
+    return nullptr;
+}
+
+/************************************************************************/
+/*                         GDALGetMappedBlock()                         */
+/************************************************************************/
+
+/**
+ * \brief Return a read-only pointer to the data of a block in a memory
+ * mapping of the file.
+ *
+ * @see GDALRasterBand::GetMappedBlock()
+ * @since GDAL 3.1
+ */
+
+const void * GDALGetMappedBlock( GDALRasterBandH hBand,
+                                 int nXBlockOff, int nYBlockOff,
+                                 GSpacing *pnPixelSpace,
+                                 GSpacing *pnLineSpace )
+{
+    VALIDATE_POINTER1( hBand, "GDALGetMappedBlock", nullptr );
+    VALIDATE_POINTER1( pnPixelSpace, "GDALGetMappedBlock", nullptr );
+    VALIDATE_POINTER1( pnLineSpace, "GDALGetMappedBlock", nullptr );
+
+    GDALRasterBand *poBand = GDALRasterBand::FromHandle(hBand);
+
+    return poBand->GetMappedBlock( nXBlockOff, nYBlockOff,
+                                   pnPixelSpace, pnLineSpace );
+}
+
 /************************************************************************/
 /*                        GDALGetDataCoverageStatus()                   */
 /************************************************************************/
@@ -33,6 +33,7 @@
 #include "gdal_priv.h"
 
 #include <algorithm>
+#include <atomic>
 #include <climits>
 #include <cstring>
 
@@ -48,21 +49,38 @@ CPL_CVSID("$Id$")
 static bool bCacheMaxInitialized = false;
 // Will later be overridden by the default 5% if GDAL_CACHEMAX not defined.
 static GIntBig nCacheMax = 40 * 1024 * 1024;
-static volatile GIntBig nCacheUsed = 0;
-
-static GDALRasterBlock *poOldest = nullptr;  // Tail.
-static GDALRasterBlock *poNewest = nullptr;  // Head.
+// Updated from several shard locks, hence atomic.
+static std::atomic<GIntBig> nCacheUsed(0);
 
 static int nDisableDirtyBlockFlushCounter = 0;
 
-#if 0
-static CPLMutex *hRBLock = nullptr;
-#define INITIALIZE_LOCK CPLMutexHolderD( &hRBLock )
-#define TAKE_LOCK       CPLMutexHolderOptionalLockD( hRBLock )
-#define DESTROY_LOCK    CPLDestroyMutex( hRBLock )
-#else
+/* -------------------------------------------------------------------- */
+/*      The LRU list of cached blocks can be split in several shards,   */
+/*      each with its own lock, so that threads working on different    */
+/*      blocks do not all contend on a single lock in Touch() and       */
+/*      Internalize(). A block is assigned to a shard from a hash of    */
+/*      its band and block coordinates. The GDAL_CACHEMAX budget        */
+/*      remains global and is enforced by evicting from the shard of    */
+/*      the block being internalized first, and then from the other     */
+/*      ones. With a single shard (the default), the behaviour is the   */
+/*      one of a strict global LRU.                                     */
+/* -------------------------------------------------------------------- */
 
-static CPLLock* hRBLock = nullptr;
+namespace {
+struct GDALRasterBlockShard
+{
+    CPLLock         *hLock;
+    GDALRasterBlock *poOldest;  // Tail.
+    GDALRasterBlock *poNewest;  // Head.
+};
+}
+
+constexpr int MAX_RB_SHARDS = 64;
+static GDALRasterBlockShard asShards[MAX_RB_SHARDS];
+static int nShards = 0;
+static int nFlushShardCounter = 0;
+
+static CPLLock* hRBLock = nullptr;  // Also the lock of the first shard.
 static bool bDebugContention = false;
 static bool bSleepsForBockCacheDebug = false;
 static CPLLockType GetLockType()
@@ -92,12 +110,86 @@ static CPLLockType GetLockType()
     return static_cast<CPLLockType>(nLockType);
 }
 
-#define INITIALIZE_LOCK         CPLLockHolderD( &hRBLock, GetLockType() ); \
-                                CPLLockSetDebugPerf(hRBLock, bDebugContention)
-#define TAKE_LOCK               CPLLockHolderOptionalLockD( hRBLock )
-#define DESTROY_LOCK            CPLDestroyLock( hRBLock )
+/************************************************************************/
+/*                        InitializeShards()                            */
+/*                                                                      */
+/*      Must be called with hRBLock held.                               */
+/************************************************************************/
 
-#endif
+static void InitializeShards()
+{
+    if( nShards > 0 )
+        return;
+
+    const char* pszShards = CPLGetConfigOption("GDAL_RB_SHARDS", "1");
+    int nRequestedShards;
+    if( EQUAL(pszShards, "AUTO") || EQUAL(pszShards, "ALL_CPUS") )
+    {
+        // Round up to the next power of two so that hashes spread evenly.
+        const int nCPUs = CPLGetNumCPUs();
+        nRequestedShards = 1;
+        while( nRequestedShards < nCPUs && nRequestedShards < MAX_RB_SHARDS )
+            nRequestedShards *= 2;
+    }
+    else
+    {
+        nRequestedShards = atoi(pszShards);
+        if( nRequestedShards < 1 || nRequestedShards > MAX_RB_SHARDS )
+        {
+            CPLError(CE_Warning, CPLE_NotSupported,
+                     "GDAL_RB_SHARDS=%s not supported. "
+                     "Should be AUTO or a value between 1 and %d. "
+                     "Using 1", pszShards, MAX_RB_SHARDS);
+            nRequestedShards = 1;
+        }
+    }
+
+    asShards[0].hLock = hRBLock;
+    for( int i = 1; i < nRequestedShards; ++i )
+    {
+        asShards[i].hLock = CPLCreateLock(GetLockType());
+        if( asShards[i].hLock == nullptr )
+        {
+            nRequestedShards = i;
+            break;
+        }
+        CPLLockSetDebugPerf(asShards[i].hLock, bDebugContention);
+    }
+    if( nRequestedShards > 1 )
+        CPLDebug("GDAL", "Using %d block cache shards", nRequestedShards);
+    nShards = nRequestedShards;
+}
+
+/************************************************************************/
+/*                           GetShardIndex()                            */
+/************************************************************************/
+
+static int GetShardIndex( GDALRasterBlock* poBlock )
+{
+    if( nShards <= 1 )
+        return 0;
+    // Mix the band pointer (which also identifies the dataset) with the
+    // block coordinates, so that the blocks of a single band are spread
+    // over all shards.
+    GUIntBig nHash = static_cast<GUIntBig>(
+        reinterpret_cast<GUIntptr_t>(poBlock->GetBand())) >> 4;
+    nHash = nHash * 31 + static_cast<unsigned>(poBlock->GetXOff());
+    nHash = nHash * 31 + static_cast<unsigned>(poBlock->GetYOff());
+    nHash ^= nHash >> 17;
+    nHash *= 0x9E3779B97F4A7C15ULL;
+    nHash ^= nHash >> 29;
+    return static_cast<int>(nHash % static_cast<unsigned>(nShards));
+}
+
+static GDALRasterBlockShard& GetShard( GDALRasterBlock* poBlock )
+{
+    return asShards[GetShardIndex(poBlock)];
+}
+
+#define INITIALIZE_LOCK         CPLLockHolderD( &hRBLock, GetLockType() ); \
+                                CPLLockSetDebugPerf(hRBLock, bDebugContention); \
+                                InitializeShards()
+#define TAKE_SHARD_LOCK(shard)  CPLLockHolderOptionalLockD( (shard).hLock )
 
 //#define ENABLE_DEBUG
 
@@ -400,6 +492,11 @@ int CPL_STDCALL GDALFlushCacheBlock()
  * GDALRasterBlock - instead it it utilized by the RasterIO() interfaces
  * to implement caching.
  *
+ * The LRU list can be split into several independently locked shards with
+ * the GDAL_RB_SHARDS configuration option (AUTO or a number between 1 and 64,
+ * defaults to 1), to reduce lock contention when many threads access
+ * the cache. The cache limit remains global to all shards.
+ *
  * Some driver classes are implemented in a fashion that completely avoids
  * use of the GDAL raster cache (and GDALRasterBlock) though this is not very
  * common.
@@ -431,11 +528,24 @@ int CPL_STDCALL GDALFlushCacheBlock()
 int GDALRasterBlock::FlushCacheBlock( int bDirtyBlocksOnly )
 
 {
-    GDALRasterBlock *poTarget;
+    GDALRasterBlock *poTarget = nullptr;
 
     {
         INITIALIZE_LOCK;
-        poTarget = poOldest;
+    }
+
+    // Start from a different shard at each call, so that repeated calls
+    // (GDALSetCacheMax64(), FlushDirtyBlocks()) drain all shards evenly.
+    const int nStartShard = nShards > 1 ?
+        static_cast<unsigned>(CPLAtomicInc(&nFlushShardCounter)) %
+            static_cast<unsigned>(nShards) : 0;
+    for( int iShardIter = 0;
+         poTarget == nullptr && iShardIter < nShards; ++iShardIter )
+    {
+        GDALRasterBlockShard& oShard =
+            asShards[(nStartShard + iShardIter) % nShards];
+        TAKE_SHARD_LOCK(oShard);
+        poTarget = oShard.poOldest;
 
         while( poTarget != nullptr )
         {
@@ -450,7 +560,7 @@ int GDALRasterBlock::FlushCacheBlock( int bDirtyBlocksOnly )
         }
 
         if( poTarget == nullptr )
-            return FALSE;
+            continue;
         if( bSleepsForBockCacheDebug )
             CPLSleep(CPLAtof(
                 CPLGetConfigOption(
@@ -460,6 +570,9 @@ int GDALRasterBlock::FlushCacheBlock( int bDirtyBlocksOnly )
         poTarget->GetBand()->UnreferenceBlock(poTarget);
     }
 
+    if( poTarget == nullptr )
+        return FALSE;
+
     if( bSleepsForBockCacheDebug )
         CPLSleep(CPLAtof(
             CPLGetConfigOption("GDAL_RB_FLUSHBLOCK_SLEEP_AFTER_RB_LOCK", "0")));
@@ -707,19 +820,20 @@ void GDALRasterBlock::Detach()
 {
     if( bMustDetach )
     {
-        TAKE_LOCK;
+        TAKE_SHARD_LOCK(GetShard(this));
         Detach_unlocked();
     }
 }
 
 void GDALRasterBlock::Detach_unlocked()
 {
-    if( poOldest == this )
-        poOldest = poPrevious;
+    GDALRasterBlockShard& oShard = GetShard(this);
+    if( oShard.poOldest == this )
+        oShard.poOldest = poPrevious;
 
-    if( poNewest == this )
+    if( oShard.poNewest == this )
     {
-        poNewest = poNext;
+        oShard.poNewest = poNext;
     }
 
     if( poPrevious != nullptr )
@@ -753,27 +867,33 @@ void GDALRasterBlock::Detach_unlocked()
 void GDALRasterBlock::Verify()
 
 {
-    TAKE_LOCK;
-
-    CPLAssert( (poNewest == nullptr && poOldest == nullptr)
-               || (poNewest != nullptr && poOldest != nullptr) );
-
-    if( poNewest != nullptr )
+    for( int iShard = 0; iShard < nShards; ++iShard )
     {
-        CPLAssert( poNewest->poPrevious == nullptr );
-        CPLAssert( poOldest->poNext == nullptr );
+        GDALRasterBlockShard& oShard = asShards[iShard];
+        TAKE_SHARD_LOCK(oShard);
 
-        GDALRasterBlock* poLast = nullptr;
-        for( GDALRasterBlock *poBlock = poNewest;
-             poBlock != nullptr;
-             poBlock = poBlock->poNext )
+        CPLAssert( (oShard.poNewest == nullptr && oShard.poOldest == nullptr)
+                   || (oShard.poNewest != nullptr &&
+                       oShard.poOldest != nullptr) );
+
+        if( oShard.poNewest != nullptr )
         {
-            CPLAssert( poBlock->poPrevious == poLast );
+            CPLAssert( oShard.poNewest->poPrevious == nullptr );
+            CPLAssert( oShard.poOldest->poNext == nullptr );
 
-            poLast = poBlock;
-        }
+            GDALRasterBlock* poLast = nullptr;
+            for( GDALRasterBlock *poBlock = oShard.poNewest;
+                 poBlock != nullptr;
+                 poBlock = poBlock->poNext )
+            {
+                CPLAssert( poBlock->poPrevious == poLast );
+                CPLAssert( GetShardIndex(poBlock) == iShard );
 
-        CPLAssert( poOldest == poLast );
+                poLast = poBlock;
+            }
+
+            CPLAssert( oShard.poOldest == poLast );
+        }
     }
 }
 
@@ -784,8 +904,10 @@ void GDALRasterBlock::Verify() {}
 #ifdef notdef
 void GDALRasterBlock::CheckNonOrphanedBlocks( GDALRasterBand* poBand )
 {
-    TAKE_LOCK;
-    for( GDALRasterBlock *poBlock = poNewest;
+  for( int iShard = 0; iShard < nShards; ++iShard )
+  {
+    TAKE_SHARD_LOCK(asShards[iShard]);
+    for( GDALRasterBlock *poBlock = asShards[iShard].poNewest;
                           poBlock != nullptr;
                           poBlock = poBlock->poNext )
     {
@@ -805,6 +927,7 @@ void GDALRasterBlock::CheckNonOrphanedBlocks( GDALRasterBand* poBand )
                        poBand->GetDataset()->GetDescription());
         }
     }
+  }
 }
 #endif
 
@@ -858,11 +981,13 @@ CPLErr GDALRasterBlock::Write()
 void GDALRasterBlock::Touch()
 
 {
+    GDALRasterBlockShard& oShard = GetShard(this);
+
     // Can be safely tested outside the lock
-    if( poNewest == this )
+    if( oShard.poNewest == this )
         return;
 
-    TAKE_LOCK;
+    TAKE_SHARD_LOCK(oShard);
     Touch_unlocked();
 }
 
@@ -875,15 +1000,16 @@ void GDALRasterBlock::Touch_unlocked()
     // 1. Thread 1 calls Touch() and poNewest != this at that point
     // 2. Thread 2 detaches poNewest
     // 3. Thread 1 arrives here
-    if( poNewest == this )
+    GDALRasterBlockShard& oShard = GetShard(this);
+    if( oShard.poNewest == this )
         return;
 
     // We should not try to touch a block that has been detached.
     // If that happen, corruption has already occurred.
     CPLAssert(bMustDetach);
 
-    if( poOldest == this )
-        poOldest = this->poPrevious;
+    if( oShard.poOldest == this )
+        oShard.poOldest = this->poPrevious;
 
     if( poPrevious != nullptr )
         poPrevious->poNext = poNext;
@@ -892,19 +1018,19 @@ void GDALRasterBlock::Touch_unlocked()
         poNext->poPrevious = poPrevious;
 
     poPrevious = nullptr;
-    poNext = poNewest;
+    poNext = oShard.poNewest;
 
-    if( poNewest != nullptr )
+    if( oShard.poNewest != nullptr )
     {
-        CPLAssert( poNewest->poPrevious == nullptr );
-        poNewest->poPrevious = this;
+        CPLAssert( oShard.poNewest->poPrevious == nullptr );
+        oShard.poNewest->poPrevious = this;
     }
-    poNewest = this;
+    oShard.poNewest = this;
 
-    if( poOldest == nullptr )
+    if( oShard.poOldest == nullptr )
     {
         CPLAssert( poPrevious == nullptr && poNext == nullptr );
-        poOldest = this;
+        oShard.poOldest = this;
     }
 #ifdef ENABLE_DEBUG
     Verify();
@@ -942,7 +1068,12 @@ CPLErr GDALRasterBlock::Internalize()
 
 /* -------------------------------------------------------------------- */
 /*      Flush old blocks if we are nearing our memory limit.            */
+/*      We first evict from the shard of this block, and then from      */
+/*      the other shards, never holding more than one shard lock.       */
 /* -------------------------------------------------------------------- */
+    const int nOwnShard = GetShardIndex(this);
+    int iShardIter = 0;
+    bool bTouched = false;
     bool bFirstIter = true;
     bool bLoopAgain = false;
     do
@@ -950,12 +1081,17 @@ CPLErr GDALRasterBlock::Internalize()
         bLoopAgain = false;
         GDALRasterBlock* apoBlocksToFree[64] = { nullptr };
         int nBlocksToFree = 0;
+
+        if( bFirstIter )
+            nCacheUsed += GetEffectiveBlockSize(nSizeInBytes);
+
+        while( !bLoopAgain && iShardIter < nShards )
         {
-            TAKE_LOCK;
+            const int iShard = (nOwnShard + iShardIter) % nShards;
+            GDALRasterBlockShard& oShard = asShards[iShard];
+            TAKE_SHARD_LOCK(oShard);
 
-            if( bFirstIter )
-                nCacheUsed += GetEffectiveBlockSize(nSizeInBytes);
-            GDALRasterBlock *poTarget = poOldest;
+            GDALRasterBlock *poTarget = oShard.poOldest;
             while( nCacheUsed > nCurCacheMax )
             {
                 while( poTarget != nullptr )
@@ -1009,8 +1145,16 @@ CPLErr GDALRasterBlock::Internalize()
         /* ------------------------------------------------------------------ */
         /*      Add this block to the list.                                   */
         /* ------------------------------------------------------------------ */
-            if( !bLoopAgain )
+            if( !bLoopAgain && !bTouched && iShard == nOwnShard )
+            {
                 Touch_unlocked();
+                bTouched = true;
+            }
+
+            if( nCacheUsed <= nCurCacheMax )
+                iShardIter = nShards;
+            else if( !bLoopAgain )
+                ++iShardIter;  // No more candidate in this shard.
         }
 
         bFirstIter = false;
@@ -1048,6 +1192,12 @@ CPLErr GDALRasterBlock::Internalize()
     }
     while(bLoopAgain);
 
+    if( !bTouched )
+    {
+        TAKE_SHARD_LOCK(GetShard(this));
+        Touch_unlocked();
+    }
+
     if( pNewData == nullptr )
     {
         pNewData = VSI_MALLOC_ALIGNED_AUTO_VERBOSE( nSizeInBytes );
@@ -1109,8 +1259,15 @@ void GDALRasterBlock::MarkClean()
 /*! @cond Doxygen_Suppress */
 void GDALRasterBlock::DestroyRBMutex()
 {
+    for( int i = 1; i < nShards; ++i )
+    {
+        CPLDestroyLock(asShards[i].hLock);
+        asShards[i].hLock = nullptr;
+    }
+    asShards[0].hLock = nullptr;
+    nShards = 0;
     if( hRBLock != nullptr )
-        DESTROY_LOCK;
+        CPLDestroyLock( hRBLock );
     hRBLock = nullptr;
 }
 /*! @endcond */
@@ -1185,7 +1342,7 @@ int GDALRasterBlock::DropLockForRemovalFromStorage()
 #endif
 
     // Wait for the block for having been unreferenced.
-    TAKE_LOCK;
+    TAKE_SHARD_LOCK(GetShard(this));
 
     return FALSE;
 }
@@ -1194,14 +1351,17 @@ int GDALRasterBlock::DropLockForRemovalFromStorage()
 void GDALRasterBlock::DumpAll()
 {
     int iBlock = 0;
-    for( GDALRasterBlock *poBlock = poNewest;
-         poBlock != nullptr;
-         poBlock = poBlock->poNext )
+    for( int iShard = 0; iShard < nShards; ++iShard )
     {
-        printf("Block %d\n", iBlock);/*ok*/
-        poBlock->DumpBlock();
-        printf("\n");/*ok*/
-        iBlock++;
+        for( GDALRasterBlock *poBlock = asShards[iShard].poNewest;
+             poBlock != nullptr;
+             poBlock = poBlock->poNext )
+        {
+            printf("Block %d (shard %d)\n", iBlock, iShard);/*ok*/
+            poBlock->DumpBlock();
+            printf("\n");/*ok*/
+            iBlock++;
+        }
     }
 }
 
@@ -35,13 +35,19 @@
 #include <cstdlib>
 
 #include <algorithm>
+#include <atomic>
+#include <deque>
+#include <functional>
 #include <limits>
+#include <memory>
 #include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
+#include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdalwarper.h"
 
@@ -3033,6 +3039,288 @@ GDALDataType GDALGetOvrWorkDataType( const char* pszResampling,
     return GDT_Float32;
 }
 
+namespace {
+
+/************************************************************************/
+/*                      GDALOverviewResampleBuffer                      */
+/************************************************************************/
+
+// In-memory raster band that receives what a resampling function writes
+// for a window of an overview band. This lets resampling functions run in
+// worker threads, the real overview band being only written by the
+// calling thread. Values are stored with the data type of the overview
+// band, so that the conversion is the one the overview band would do.
+
+class GDALOverviewResampleBuffer final: public GDALRasterBand
+{
+    GDALRasterBand *m_poOvrBand = nullptr;
+    int             m_nDstXOff = 0;
+    int             m_nDstYOff = 0;
+    int             m_nDstXSize = 0;
+    int             m_nDstYSize = 0;
+    GByte          *m_pabyData = nullptr;
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALOverviewResampleBuffer)
+
+  protected:
+    CPLErr IReadBlock( int, int, void * ) override;
+    CPLErr IRasterIO( GDALRWFlag eRWFlag,
+                      int nXOff, int nYOff, int nXSize, int nYSize,
+                      void * pData, int nBufXSize, int nBufYSize,
+                      GDALDataType eBufType,
+                      GSpacing nPixelSpace, GSpacing nLineSpace,
+                      GDALRasterIOExtraArg* psExtraArg ) override;
+
+  public:
+    GDALOverviewResampleBuffer( GDALRasterBand* poOvrBand,
+                                int nDstXOff, int nDstXOff2,
+                                int nDstYOff, int nDstYOff2 );
+    ~GDALOverviewResampleBuffer() override;
+
+    bool   Init();
+    CPLErr WriteToOverview();
+};
+
+GDALOverviewResampleBuffer::GDALOverviewResampleBuffer(
+                                GDALRasterBand* poOvrBand,
+                                int nDstXOff, int nDstXOff2,
+                                int nDstYOff, int nDstYOff2 ) :
+    m_poOvrBand(poOvrBand),
+    m_nDstXOff(nDstXOff),
+    m_nDstYOff(nDstYOff),
+    m_nDstXSize(nDstXOff2 - nDstXOff),
+    m_nDstYSize(nDstYOff2 - nDstYOff)
+{
+    nRasterXSize = poOvrBand->GetXSize();
+    nRasterYSize = poOvrBand->GetYSize();
+    nBlockXSize = nRasterXSize;
+    nBlockYSize = 1;
+    eDataType = poOvrBand->GetRasterDataType();
+    eAccess = GA_Update;
+
+    // Used by GDALResampleChunk32R_ConvolutionT()
+    const char* pszNBITS =
+        poOvrBand->GetMetadataItem("NBITS", "IMAGE_STRUCTURE");
+    if( pszNBITS )
+        GDALRasterBand::SetMetadataItem("NBITS", pszNBITS, "IMAGE_STRUCTURE");
+}
+
+GDALOverviewResampleBuffer::~GDALOverviewResampleBuffer()
+{
+    VSIFree(m_pabyData);
+}
+
+bool GDALOverviewResampleBuffer::Init()
+{
+    m_pabyData = static_cast<GByte*>(VSI_MALLOC3_VERBOSE(
+        m_nDstXSize, m_nDstYSize, GDALGetDataTypeSizeBytes(eDataType)));
+    return m_pabyData != nullptr;
+}
+
+CPLErr GDALOverviewResampleBuffer::IReadBlock( int, int, void * )
+{
+    CPLError(CE_Failure, CPLE_NotSupported,
+             "GDALOverviewResampleBuffer::IReadBlock() not supported");
+    return CE_Failure;
+}
+
+CPLErr GDALOverviewResampleBuffer::IRasterIO(
+                            GDALRWFlag eRWFlag,
+                            int nXOff, int nYOff, int nXSize, int nYSize,
+                            void * pData, int nBufXSize, int nBufYSize,
+                            GDALDataType eBufType,
+                            GSpacing nPixelSpace, GSpacing nLineSpace,
+                            GDALRasterIOExtraArg* /* psExtraArg */ )
+{
+    if( eRWFlag != GF_Write ||
+        nBufXSize != nXSize || nBufYSize != nYSize ||
+        nXOff < m_nDstXOff || nXOff + nXSize > m_nDstXOff + m_nDstXSize ||
+        nYOff < m_nDstYOff || nYOff + nYSize > m_nDstYOff + m_nDstYSize )
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "GDALOverviewResampleBuffer::IRasterIO(): "
+                 "unexpected request");
+        return CE_Failure;
+    }
+
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDataType);
+    for( int iY = 0; iY < nYSize; iY++ )
+    {
+        GDALCopyWords(
+            static_cast<GByte*>(pData) + iY * nLineSpace,
+            eBufType, static_cast<int>(nPixelSpace),
+            m_pabyData + (static_cast<size_t>(nYOff - m_nDstYOff + iY) *
+                                m_nDstXSize + (nXOff - m_nDstXOff)) * nDTSize,
+            eDataType, nDTSize,
+            nXSize );
+    }
+    return CE_None;
+}
+
+CPLErr GDALOverviewResampleBuffer::WriteToOverview()
+{
+    return m_poOvrBand->RasterIO(GF_Write,
+                                 m_nDstXOff, m_nDstYOff,
+                                 m_nDstXSize, m_nDstYSize,
+                                 m_pabyData, m_nDstXSize, m_nDstYSize,
+                                 eDataType, 0, 0, nullptr);
+}
+
+/************************************************************************/
+/*                       GDALOverviewResampleQueue                      */
+/************************************************************************/
+
+typedef std::function<CPLErr(GDALRasterBand*)> GDALOverviewResampleFunc;
+
+struct GDALOverviewResampleError
+{
+    CPLErr      eErrClass = CE_None;
+    CPLErrorNum nErrNo = CPLE_None;
+    CPLString   osMsg{};
+};
+
+struct GDALOverviewResampleJob
+{
+    GDALOverviewResampleFunc                    fnResample{};
+    std::unique_ptr<GDALOverviewResampleBuffer> poBuffer{};
+    CPLErr                                      eErr = CE_None;
+    std::vector<GDALOverviewResampleError>      asErrors{};
+    std::atomic<bool>                           bFinished{false};
+};
+
+// Dispatches resampling of overview windows to the shared thread pool, and
+// writes the results to the overview bands, from the calling thread, in the
+// order the windows were submitted. Without thread pool, the resampling
+// is directly done on the overview band by Submit().
+
+class GDALOverviewResampleQueue
+{
+    std::unique_ptr<CPLJobQueue> m_poJobQueue{};
+    size_t m_nMaxPendingJobs = 0;
+    std::deque<std::unique_ptr<GDALOverviewResampleJob>> m_apoJobs{};
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALOverviewResampleQueue)
+
+    static void CPL_STDCALL ErrorHandler( CPLErr eErrClass,
+                                          CPLErrorNum nErrNo,
+                                          const char* pszMsg );
+    static void JobFunc( void* pData );
+    CPLErr WriteFinishedJobs( size_t nMaxRemainingJobs );
+
+  public:
+    explicit GDALOverviewResampleQueue( int nThreads );
+    ~GDALOverviewResampleQueue();
+
+    bool IsMultiThreaded() const { return m_poJobQueue != nullptr; }
+
+    CPLErr Submit( GDALRasterBand* poOvrBand,
+                   int nDstXOff, int nDstXOff2,
+                   int nDstYOff, int nDstYOff2,
+                   const GDALOverviewResampleFunc& fnResample );
+    CPLErr WaitAll() { return WriteFinishedJobs(0); }
+};
+
+GDALOverviewResampleQueue::GDALOverviewResampleQueue( int nThreads )
+{
+    CPLWorkerThreadPool* poPool =
+        nThreads > 1 ? CPLGetGlobalWorkerThreadPool(nThreads) : nullptr;
+    if( poPool )
+        nThreads = std::min(nThreads, poPool->GetThreadCount());
+    if( poPool && nThreads > 1 )
+    {
+        m_poJobQueue = poPool->CreateJobQueue(nThreads);
+        // Allow resampling of a few chunks to be in advance over writing,
+        // while bounding memory usage.
+        m_nMaxPendingJobs = 2 * static_cast<size_t>(nThreads);
+    }
+}
+
+GDALOverviewResampleQueue::~GDALOverviewResampleQueue()
+{
+    // Normally done by the caller with WaitAll(). In case of early exit,
+    // make sure no job still references the buffers.
+    if( m_poJobQueue )
+        m_poJobQueue->WaitCompletion();
+}
+
+// Errors are collected by the worker threads and re-emitted by the
+// calling thread.
+void CPL_STDCALL GDALOverviewResampleQueue::ErrorHandler( CPLErr eErrClass,
+                                                          CPLErrorNum nErrNo,
+                                                          const char* pszMsg )
+{
+    GDALOverviewResampleJob* psJob =
+        static_cast<GDALOverviewResampleJob*>(CPLGetErrorHandlerUserData());
+    GDALOverviewResampleError sError;
+    sError.eErrClass = eErrClass;
+    sError.nErrNo = nErrNo;
+    sError.osMsg = pszMsg;
+    psJob->asErrors.push_back(sError);
+}
+
+void GDALOverviewResampleQueue::JobFunc( void* pData )
+{
+    GDALOverviewResampleJob* psJob =
+        static_cast<GDALOverviewResampleJob*>(pData);
+    CPLPushErrorHandlerEx(ErrorHandler, psJob);
+    psJob->eErr = psJob->fnResample(psJob->poBuffer.get());
+    CPLPopErrorHandler();
+    // Release the source chunks as soon as possible.
+    psJob->fnResample = nullptr;
+    psJob->bFinished = true;
+}
+
+CPLErr GDALOverviewResampleQueue::Submit(
+                                GDALRasterBand* poOvrBand,
+                                int nDstXOff, int nDstXOff2,
+                                int nDstYOff, int nDstYOff2,
+                                const GDALOverviewResampleFunc& fnResample )
+{
+    if( !m_poJobQueue )
+        return fnResample(poOvrBand);
+
+    std::unique_ptr<GDALOverviewResampleJob> poJob(
+        new GDALOverviewResampleJob());
+    poJob->fnResample = fnResample;
+    poJob->poBuffer.reset(new GDALOverviewResampleBuffer(
+        poOvrBand, nDstXOff, nDstXOff2, nDstYOff, nDstYOff2));
+    if( !poJob->poBuffer->Init() )
+        return CE_Failure;
+    if( !m_poJobQueue->SubmitJob(JobFunc, poJob.get()) )
+        return CE_Failure;
+    m_apoJobs.push_back(std::move(poJob));
+
+    return WriteFinishedJobs(m_nMaxPendingJobs);
+}
+
+CPLErr GDALOverviewResampleQueue::WriteFinishedJobs( size_t nMaxRemainingJobs )
+{
+    CPLErr eErr = CE_None;
+    while( !m_apoJobs.empty() )
+    {
+        GDALOverviewResampleJob* psJob = m_apoJobs.front().get();
+        if( !psJob->bFinished )
+        {
+            if( m_apoJobs.size() <= nMaxRemainingJobs )
+                break;
+            m_poJobQueue->WaitEvent();
+            continue;
+        }
+
+        for( const auto& sError : psJob->asErrors )
+            CPLError(sError.eErrClass, sError.nErrNo, "%s",
+                     sError.osMsg.c_str());
+        if( psJob->eErr == CE_None && eErr == CE_None )
+            psJob->eErr = psJob->poBuffer->WriteToOverview();
+        if( psJob->eErr != CE_None )
+            eErr = psJob->eErr;
+        m_apoJobs.pop_front();
+    }
+    return eErr;
+}
+
+} // namespace
+
 /************************************************************************/
 /*                      GDALRegenerateOverviews()                       */
 /************************************************************************/
@@ -3227,22 +3515,35 @@ GDALRegenerateOverviews( GDALRasterBandH hSrcBand,
     const int nMaxChunkYSizeQueried =
         nFullResYChunk + 2 * nKernelRadius * nMaxOvrFactor;
 
-    GByte *pabyChunkNodataMask = nullptr;
-    void *pChunk =
-        VSI_MALLOC3_VERBOSE(
-            GDALGetDataTypeSizeBytes(eType), nMaxChunkYSizeQueried, nWidth );
-    if( bUseNoDataMask )
+    // When resampling is done in worker threads, the chunk buffers are
+    // shared with the pending jobs, so new ones are allocated when the
+    // previous ones are still in use.
+    GDALOverviewResampleQueue oQueue(CPLGetNumThreads(nullptr));
+    std::shared_ptr<void> poChunk;
+    std::shared_ptr<GByte> pabyChunkNodataMaskHolder;
+    const auto AllocChunk = [&]()
     {
-        pabyChunkNodataMask =
-            static_cast<GByte*>(VSI_MALLOC2_VERBOSE( nMaxChunkYSizeQueried, nWidth ));
-    }
+        if( poChunk && poChunk.use_count() == 1 &&
+            (!bUseNoDataMask || pabyChunkNodataMaskHolder.use_count() == 1) )
+        {
+            return true;
+        }
+        poChunk.reset(
+            VSI_MALLOC3_VERBOSE(
+                GDALGetDataTypeSizeBytes(eType), nMaxChunkYSizeQueried, nWidth ),
+            VSIFree);
+        if( bUseNoDataMask )
+        {
+            pabyChunkNodataMaskHolder.reset(
+                static_cast<GByte*>(VSI_MALLOC2_VERBOSE( nMaxChunkYSizeQueried, nWidth )),
+                VSIFree);
+        }
+        return poChunk != nullptr &&
+               (!bUseNoDataMask || pabyChunkNodataMaskHolder != nullptr);
+    };
 
-    if( pChunk == nullptr || (bUseNoDataMask && pabyChunkNodataMask == nullptr))
-    {
-        CPLFree(pChunk);
-        CPLFree(pabyChunkNodataMask);
+    if( !AllocChunk() )
         return CE_Failure;
-    }
 
     int bHasNoData = FALSE;
     const float fNoDataValue =
@@ -3281,6 +3582,14 @@ GDALRegenerateOverviews( GDALRasterBandH hSrcBand,
         if( nChunkYOffQueried + nChunkYSizeQueried > nHeight )
             nChunkYSizeQueried = nHeight - nChunkYOffQueried;
 
+        if( !AllocChunk() )
+        {
+            eErr = CE_Failure;
+            break;
+        }
+        void* pChunk = poChunk.get();
+        GByte* pabyChunkNodataMask = pabyChunkNodataMaskHolder.get();
+
         // Read chunk.
         if( eErr == CE_None )
             eErr = poSrcBand->RasterIO(
@@ -3399,35 +3708,58 @@ GDALRegenerateOverviews( GDALRasterBandH hSrcBand,
                 0, nDstYOff, nDstWidth, nDstYOff2 - nDstYOff );
 #endif
 
+            const GDALDataType eSrcDataType = poSrcBand->GetRasterDataType();
+            const std::shared_ptr<void> poChunkRef(poChunk);
+            const std::shared_ptr<GByte> pabyChunkNodataMaskRef(
+                                                pabyChunkNodataMaskHolder);
+            GDALOverviewResampleFunc fnResample;
             if( eType == GDT_Byte ||
                 eType == GDT_UInt16 ||
                 eType == GDT_Float32 )
-                eErr = pfnResampleFn(
-                    dfXRatioDstToSrc, dfYRatioDstToSrc,
-                    0.0, 0.0,
-                    eType,
-                    pChunk,
-                    pabyChunkNodataMask,
-                    0, nWidth,
-                    nChunkYOffQueried, nChunkYSizeQueried,
-                    0, nDstWidth,
-                    nDstYOff, nDstYOff2,
-                    papoOvrBands[iOverview], pszResampling,
-                    bHasNoData, fNoDataValue, poColorTable,
-                    poSrcBand->GetRasterDataType(),
-                    bPropagateNoData);
+            {
+                fnResample = [=](GDALRasterBand* poDstBand)
+                {
+                    return pfnResampleFn(
+                        dfXRatioDstToSrc, dfYRatioDstToSrc,
+                        0.0, 0.0,
+                        eType,
+                        poChunkRef.get(),
+                        pabyChunkNodataMaskRef.get(),
+                        0, nWidth,
+                        nChunkYOffQueried, nChunkYSizeQueried,
+                        0, nDstWidth,
+                        nDstYOff, nDstYOff2,
+                        poDstBand, pszResampling,
+                        bHasNoData, fNoDataValue, poColorTable,
+                        eSrcDataType,
+                        bPropagateNoData);
+                };
+            }
             else
-                eErr = GDALResampleChunkC32R(
-                    nWidth, nHeight,
-                    static_cast<float*>(pChunk),
-                    nChunkYOffQueried, nChunkYSizeQueried,
-                    nDstYOff, nDstYOff2,
-                    papoOvrBands[iOverview], pszResampling);
+            {
+                fnResample = [=](GDALRasterBand* poDstBand)
+                {
+                    return GDALResampleChunkC32R(
+                        nWidth, nHeight,
+                        static_cast<float*>(poChunkRef.get()),
+                        nChunkYOffQueried, nChunkYSizeQueried,
+                        nDstYOff, nDstYOff2,
+                        poDstBand, pszResampling);
+                };
+            }
+            eErr = oQueue.Submit(papoOvrBands[iOverview],
+                                 0, nDstWidth, nDstYOff, nDstYOff2,
+                                 fnResample);
         }
     }
 
-    VSIFree( pChunk );
-    VSIFree( pabyChunkNodataMask );
+    {
+        const CPLErr eErrWait = oQueue.WaitAll();
+        if( eErr == CE_None )
+            eErr = eErrWait;
+    }
+    poChunk.reset();
+    pabyChunkNodataMaskHolder.reset();
 
 /* -------------------------------------------------------------------- */
 /*      Renormalized overview mean / stddev if needed.                  */
@@ -3647,6 +3979,8 @@ GDALRegenerateOverviewsMultiBand( int nBands, GDALRasterBand** papoSrcBands,
     const bool bPropagateNoData =
         CPLTestBool( CPLGetConfigOption("GDAL_OVR_PROPAGATE_NODATA", "NO") );
 
+    GDALOverviewResampleQueue oQueue(CPLGetNumThreads(nullptr));
+
     // Second pass to do the real job.
     double dfCurPixelCount = 0;
     CPLErr eErr = CE_None;
@@ -3714,48 +4048,39 @@ GDALRegenerateOverviewsMultiBand( int nBands, GDALRasterBand** papoSrcBands,
         const int nFullResXChunkQueried =
             nFullResXChunk + 2 * nKernelRadius * nOvrFactor;
 
-        void** papaChunk = static_cast<void **>(
-            VSI_MALLOC_VERBOSE(nBands * sizeof(void*)) );
-        if( papaChunk == nullptr )
+        // When resampling is done in worker threads, the chunk buffers are
+        // shared with the pending jobs, so new ones are allocated when the
+        // previous ones are still in use.
+        std::vector<std::shared_ptr<void>> apoChunks(nBands);
+        std::shared_ptr<GByte> poChunkNoDataMask;
+        const auto AllocChunks = [&]()
         {
-            CPLFree(pabHasNoData);
-            CPLFree(pafNoDataValue);
-            return CE_Failure;
-        }
-        GByte* pabyChunkNoDataMask = nullptr;
-        for( int iBand = 0; iBand < nBands; ++iBand )
-        {
-            papaChunk[iBand] = VSI_MALLOC3_VERBOSE(
-                nFullResXChunkQueried,
-                nFullResYChunkQueried,
-                GDALGetDataTypeSizeBytes(eWrkDataType) );
-            if( papaChunk[iBand] == nullptr )
+            for( int iBand = 0; iBand < nBands; ++iBand )
             {
-                while ( --iBand >= 0)
-                    CPLFree(papaChunk[iBand]);
-                CPLFree(papaChunk);
-                CPLFree(pabHasNoData);
-                CPLFree(pafNoDataValue);
-                return CE_Failure;
+                if( apoChunks[iBand] && apoChunks[iBand].use_count() == 1 )
+                    continue;
+                apoChunks[iBand].reset(
+                    VSI_MALLOC3_VERBOSE(
+                        nFullResXChunkQueried,
+                        nFullResYChunkQueried,
+                        GDALGetDataTypeSizeBytes(eWrkDataType) ),
+                    VSIFree);
+                if( apoChunks[iBand] == nullptr )
+                    return false;
             }
-        }
-        if( bUseNoDataMask )
-        {
-            pabyChunkNoDataMask = static_cast<GByte *>(
-                VSI_MALLOC2_VERBOSE( nFullResXChunkQueried,
-                                     nFullResYChunkQueried ) );
-            if( pabyChunkNoDataMask == nullptr )
+            if( bUseNoDataMask &&
+                !(poChunkNoDataMask && poChunkNoDataMask.use_count() == 1) )
             {
-                for( int iBand = 0; iBand < nBands; ++iBand )
-                {
-                    CPLFree(papaChunk[iBand]);
-                }
-                CPLFree(papaChunk);
-                CPLFree(pabHasNoData);
-                CPLFree(pafNoDataValue);
-                return CE_Failure;
+                poChunkNoDataMask.reset(
+                    static_cast<GByte *>(
+                        VSI_MALLOC2_VERBOSE( nFullResXChunkQueried,
+                                             nFullResYChunkQueried ) ),
+                    VSIFree);
+                if( poChunkNoDataMask == nullptr )
+                    return false;
             }
-        }
+            return true;
+        };
 
         int nDstYOff = 0;
         // Iterate on destination overview, block by block.
@@ -3839,6 +4164,12 @@ GDALRegenerateOverviewsMultiBand( int nBands, GDALRasterBand** papoSrcBands,
                     nDstXOff, nDstYOff, nDstXCount, nDstYCount );
 #endif
 
+                if( !AllocChunks() )
+                {
+                    eErr = CE_Failure;
+                    break;
+                }
+
                 // Read the source buffers for all the bands.
                 for( int iBand = 0; iBand < nBands && eErr == CE_None; ++iBand )
                 {
@@ -3851,7 +4182,7 @@ GDALRegenerateOverviewsMultiBand( int nBands, GDALRasterBand** papoSrcBands,
                         GF_Read,
                         nChunkXOffQueried, nChunkYOffQueried,
                         nChunkXSizeQueried, nChunkYSizeQueried,
-                        papaChunk[iBand],
+                        apoChunks[iBand].get(),
                         nChunkXSizeQueried, nChunkYSizeQueried,
                         eWrkDataType, 0, 0, nullptr );
                 }
@@ -3868,7 +4199,7 @@ GDALRegenerateOverviewsMultiBand( int nBands, GDALRasterBand** papoSrcBands,
                         GF_Read,
                         nChunkXOffQueried, nChunkYOffQueried,
                         nChunkXSizeQueried, nChunkYSizeQueried,
-                        pabyChunkNoDataMask,
+                        poChunkNoDataMask.get(),
                         nChunkXSizeQueried, nChunkYSizeQueried,
                         GDT_Byte, 0, 0, nullptr );
                 }
@@ -3876,37 +4207,54 @@ GDALRegenerateOverviewsMultiBand( int nBands, GDALRasterBand** papoSrcBands,
                 // Compute the resulting overview block.
                 for( int iBand = 0; iBand < nBands && eErr == CE_None; ++iBand )
                 {
-                    eErr = pfnResampleFn(
-                        dfXRatioDstToSrc, dfYRatioDstToSrc,
-                        0.0, 0.0,
-                        eWrkDataType,
-                        papaChunk[iBand],
-                        pabyChunkNoDataMask,
-                        nChunkXOffQueried, nChunkXSizeQueried,
-                        nChunkYOffQueried, nChunkYSizeQueried,
+                    const std::shared_ptr<void> poChunkRef(apoChunks[iBand]);
+                    const std::shared_ptr<GByte> poChunkNoDataMaskRef(
+                                                        poChunkNoDataMask);
+                    const int bHasNoData = pabHasNoData[iBand];
+                    const float fNoDataValue = pafNoDataValue[iBand];
+                    eErr = oQueue.Submit(
+                        papapoOverviewBands[iBand][iOverview],
                         nDstXOff, nDstXOff + nDstXCount,
                         nDstYOff, nDstYOff + nDstYCount,
-                        papapoOverviewBands[iBand][iOverview],
-                        pszResampling,
-                        pabHasNoData[iBand],
-                        pafNoDataValue[iBand],
-                        /*poColorTable*/ nullptr,
-                        eDataType,
-                        bPropagateNoData);
+                        [=](GDALRasterBand* poDstBand)
+                        {
+                            return pfnResampleFn(
+                                dfXRatioDstToSrc, dfYRatioDstToSrc,
+                                0.0, 0.0,
+                                eWrkDataType,
+                                poChunkRef.get(),
+                                poChunkNoDataMaskRef.get(),
+                                nChunkXOffQueried, nChunkXSizeQueried,
+                                nChunkYOffQueried, nChunkYSizeQueried,
+                                nDstXOff, nDstXOff + nDstXCount,
+                                nDstYOff, nDstYOff + nDstYCount,
+                                poDstBand,
+                                pszResampling,
+                                bHasNoData,
+                                fNoDataValue,
+                                /*poColorTable*/ nullptr,
+                                eDataType,
+                                bPropagateNoData);
+                        });
                 }
             }
 
             dfCurPixelCount += static_cast<double>(nYCount) * nSrcWidth;
         }
 
+        // Write pending blocks before flushing, as the next level may be
+        // computed from this one.
+        {
+            const CPLErr eErrWait = oQueue.WaitAll();
+            if( eErr == CE_None )
+                eErr = eErrWait;
+        }
+
         // Flush the data to overviews.
         for( int iBand = 0; iBand < nBands; ++iBand )
         {
-            CPLFree(papaChunk[iBand]);
             papapoOverviewBands[iBand][iOverview]->FlushCache();
         }
-        CPLFree(papaChunk);
-        CPLFree(pabyChunkNoDataMask);
     }
 
     CPLFree(pabHasNoData);
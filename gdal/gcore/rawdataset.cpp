@@ -196,6 +196,9 @@ RawRasterBand::~RawRasterBand()
 
     RawRasterBand::FlushCache();
 
+    if( psMapping )
+        CPLVirtualMemFree(psMapping);
+
     if (bOwnsFP)
     {
         if( VSIFCloseL(fpRawL) != 0 )
@@ -343,6 +346,16 @@ CPLErr RawRasterBand::IReadBlock(CPL_UNUSED int nBlockXOff,
 {
     CPLAssert(nBlockXOff == 0);
 
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDataType);
+    if( CanUseVirtualMemIO(nBlockXSize, 1, nBlockXSize, 1, nDTSize) )
+    {
+        GDALCopyWords(GetMapping() +
+                          static_cast<size_t>(nBlockYOff) * nLineOffset,
+                      eDataType, nPixelOffset,
+                      pImage, eDataType, nDTSize, nBlockXSize);
+        return CE_None;
+    }
+
     if (pLineBuffer == nullptr)
         return CE_Failure;
 
@@ -576,6 +589,140 @@ int RawRasterBand::CanUseDirectIO(int /* nXOff */,
     return CPLTestBool(pszGDAL_ONE_BIG_READ);
 }
 
+/************************************************************************/
+/*                             GetMapping()                             */
+/************************************************************************/
+
+// Return the address of the first pixel of the band in a read-only memory
+// mapping of the file, or nullptr if the band cannot be mapped.
+const GByte *RawRasterBand::GetMapping()
+{
+    if( eAccess != GA_ReadOnly )
+        return nullptr;
+
+    if( !bMappingTried )
+    {
+        bMappingTried = true;
+
+        const vsi_l_offset nSize =
+            static_cast<vsi_l_offset>(nRasterYSize - 1) * nLineOffset +
+            static_cast<vsi_l_offset>(nRasterXSize - 1) * nPixelOffset +
+            GDALGetDataTypeSizeBytes(eDataType);
+        // Mapping pages beyond the end of the file would cause SIGBUS
+        // when they are accessed.
+        if( VSIFGetNativeFileDescriptorL(fpRawL) == nullptr ||
+            !CPLIsVirtualMemFileMapAvailable() ||
+            (eDataType != GDT_Byte && !bNativeOrder) ||
+            nPixelOffset <= 0 ||
+            nLineOffset <= 0 ||
+            static_cast<size_t>(nSize) != nSize ||
+            VSIFSeekL(fpRawL, 0, SEEK_END) != 0 ||
+            VSIFTellL(fpRawL) < nImgOffset + nSize )
+        {
+            return nullptr;
+        }
+
+        psMapping = CPLVirtualMemFileMapNew(
+            fpRawL, nImgOffset, nSize, VIRTUALMEM_READONLY, nullptr, nullptr);
+        if( psMapping == nullptr )
+            return nullptr;
+        CPLDebug("RAW", "Band %d mapped in memory", nBand);
+    }
+
+    if( psMapping == nullptr )
+        return nullptr;
+    return static_cast<const GByte *>(CPLVirtualMemGetAddr(psMapping));
+}
+
+/************************************************************************/
+/*                         CanUseVirtualMemIO()                         */
+/************************************************************************/
+
+int RawRasterBand::CanUseVirtualMemIO(int nXSize, int nYSize,
+                                      int nBufXSize, int nBufYSize,
+                                      GSpacing nPixelSpace)
+{
+    // Read directly from a memory mapping of the file, without going
+    // through the block cache, if RAW_VIRTUAL_MEM_IO is enabled and the
+    // request is not resampled.
+
+    if( nXSize != nBufXSize || nYSize != nBufYSize ||
+        nPixelSpace > INT_MAX || nPixelSpace < INT_MIN )
+    {
+        return FALSE;
+    }
+
+    const char *pszVirtualMemIO =
+        CPLGetConfigOption("RAW_VIRTUAL_MEM_IO", "NO");
+    const bool bIfEnoughRAM = EQUAL(pszVirtualMemIO, "IF_ENOUGH_RAM");
+    if( !bIfEnoughRAM && !CPLTestBool(pszVirtualMemIO) )
+        return FALSE;
+
+    if( GetMapping() == nullptr )
+        return FALSE;
+
+    if( bIfEnoughRAM &&
+        static_cast<GIntBig>(CPLVirtualMemGetSize(psMapping)) >
+                                                CPLGetUsablePhysicalRAM() )
+    {
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                            VirtualMemIO()                            */
+/************************************************************************/
+
+CPLErr RawRasterBand::VirtualMemIO(int nXOff, int nYOff,
+                                   int nXSize, int nYSize,
+                                   void *pData, GDALDataType eBufType,
+                                   GSpacing nPixelSpace, GSpacing nLineSpace,
+                                   GDALRasterIOExtraArg* psExtraArg)
+{
+    const GByte *pabyMapping = GetMapping();
+    for( int iLine = 0; iLine < nYSize; iLine++ )
+    {
+        GDALCopyWords(
+            pabyMapping +
+                static_cast<size_t>(nYOff + iLine) * nLineOffset +
+                static_cast<size_t>(nXOff) * nPixelOffset,
+            eDataType, nPixelOffset,
+            static_cast<GByte *>(pData) +
+                static_cast<GPtrDiff_t>(iLine) * nLineSpace,
+            eBufType, static_cast<int>(nPixelSpace), nXSize);
+
+        if( psExtraArg->pfnProgress != nullptr &&
+            !psExtraArg->pfnProgress(1.0 * (iLine + 1) / nYSize, "",
+                                     psExtraArg->pProgressData) )
+        {
+            return CE_Failure;
+        }
+    }
+    return CE_None;
+}
+
+/************************************************************************/
+/*                           GetMappedBlock()                           */
+/************************************************************************/
+
+const void *RawRasterBand::GetMappedBlock( int nXBlockOff, int nYBlockOff,
+                                           GSpacing *pnPixelSpace,
+                                           GSpacing *pnLineSpace )
+{
+    if( nXBlockOff != 0 || nYBlockOff < 0 || nYBlockOff >= nRasterYSize )
+        return nullptr;
+
+    const GByte *pabyMapping = GetMapping();
+    if( pabyMapping == nullptr )
+        return nullptr;
+
+    *pnPixelSpace = nPixelOffset;
+    *pnLineSpace = nLineOffset;
+    return pabyMapping + static_cast<size_t>(nYBlockOff) * nLineOffset;
+}
+
 /************************************************************************/
 /*                             IRasterIO()                              */
 /************************************************************************/
@@ -597,6 +744,13 @@ CPLErr RawRasterBand::IRasterIO( GDALRWFlag eRWFlag,
 #endif
     const int nBufDataSize = GDALGetDataTypeSizeBytes(eBufType);
 
+    if( eRWFlag == GF_Read &&
+        CanUseVirtualMemIO(nXSize, nYSize, nBufXSize, nBufYSize, nPixelSpace) )
+    {
+        return VirtualMemIO(nXOff, nYOff, nXSize, nYSize, pData, eBufType,
+                            nPixelSpace, nLineSpace, psExtraArg);
+    }
+
     if( !CanUseDirectIO(nXOff, nYOff, nXSize, nYSize, eBufType, psExtraArg) )
     {
         return GDALRasterBand::IRasterIO(eRWFlag, nXOff, nYOff,
@@ -1128,8 +1282,13 @@ CPLErr RawDataset::IRasterIO( GDALRWFlag eRWFlag,
             RawRasterBand *poBand = dynamic_cast<RawRasterBand *>(
                 GetRasterBand(panBandMap[iBandIndex]));
             if( poBand == nullptr ||
-                !poBand->CanUseDirectIO(nXOff, nYOff,
-                                        nXSize, nYSize, eBufType, psExtraArg) )
+                !(poBand->CanUseDirectIO(nXOff, nYOff,
+                                         nXSize, nYSize, eBufType,
+                                         psExtraArg) ||
+                  (eRWFlag == GF_Read &&
+                   poBand->CanUseVirtualMemIO(nXSize, nYSize,
+                                              nBufXSize, nBufYSize,
+                                              nPixelSpace))) )
             {
                 break;
             }
@@ -100,6 +100,9 @@ protected:
 
     int         bOwnsFP{};
 
+    CPLVirtualMem *psMapping{};
+    bool        bMappingTried{};
+
     int         Seek( vsi_l_offset, int );
     size_t      Read( void *, size_t, size_t );
     size_t      Write( void *, size_t, size_t );
@@ -118,6 +121,15 @@ protected:
                                GDALDataType eBufType,
                                GDALRasterIOExtraArg* psExtraArg);
 
+    const GByte *GetMapping();
+    int         CanUseVirtualMemIO(int nXSize, int nYSize,
+                                   int nBufXSize, int nBufYSize,
+                                   GSpacing nPixelSpace);
+    CPLErr      VirtualMemIO(int nXOff, int nYOff, int nXSize, int nYSize,
+                             void *pData, GDALDataType eBufType,
+                             GSpacing nPixelSpace, GSpacing nLineSpace,
+                             GDALRasterIOExtraArg* psExtraArg);
+
 public:
 
     enum class OwnFP
@@ -159,6 +171,10 @@ public:
                                       GIntBig *pnLineSpace,
                                       char **papszOptions ) override;
 
+    const void    *GetMappedBlock( int nXBlockOff, int nYBlockOff,
+                                   GSpacing *pnPixelSpace,
+                                   GSpacing *pnLineSpace ) override;
+
     CPLErr          AccessLine( int iLine );
 
     void            SetAccess( GDALAccess eAccess );
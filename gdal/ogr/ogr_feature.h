@@ -792,6 +792,123 @@ inline OGRFeature::ConstFieldIterator end(const OGRFeatureUniquePtr& poFeature)
 
 //! @endcond
 
+/************************************************************************/
+/*                           OGRFeatureBatch                            */
+/************************************************************************/
+
+/**
+ * A batch of features stored in column-oriented buffers.
+ *
+ * Each attribute field and each geometry field of the feature definition
+ * is stored in its own Column:
+ * <ul>
+ * <li>OFTInteger, OFTInteger64, OFTReal fields are stored as contiguous
+ *     arrays of int, GIntBig and double.</li>
+ * <li>OFTDate, OFTTime and OFTDateTime fields are stored as a contiguous
+ *     array of OGRField, whose Date member is set.</li>
+ * <li>OFTString and OFTBinary fields are stored as a data buffer, and an
+ *     array of GetLength()+1 offsets into it, the value of row i being the
+ *     bytes between anOffsets[i] and anOffsets[i+1]. Strings are not
+ *     nul-terminated.</li>
+ * <li>OFTIntegerList, OFTInteger64List and OFTRealList fields are stored
+ *     the same way, the data buffer being the concatenation of the
+ *     (int, GIntBig or double) elements of the lists.</li>
+ * <li>OFTStringList fields are stored the same way, each element of a list
+ *     being followed by a nul character.</li>
+ * <li>Geometry fields are stored as WKB, with the same layout as OFTBinary
+ *     fields.</li>
+ * </ul>
+ * Each column has also a validity bitmap, bit i (least significant bit
+ * first) of which is set if the value of row i is set and not null.
+ *
+ * Batches are filled with OGRLayer::GetNextFeatureBatch().
+ *
+ * @since GDAL 3.1
+ */
+
+class CPL_DLL OGRFeatureBatch
+{
+  public:
+    /** Column of a batch. */
+    struct CPL_DLL Column
+    {
+        /** Validity bitmap */
+        std::vector<GByte>   abyValidity{};
+        /** Values of fixed width types */
+        std::vector<GByte>   abyValues{};
+        /** Offsets into abyData, for variable width types */
+        std::vector<GUInt32> anOffsets{};
+        /** Data of variable width types */
+        std::vector<GByte>   abyData{};
+    };
+
+  private:
+    OGRFeatureDefn      *m_poDefn = nullptr;
+    int                  m_nLength = 0;
+    std::vector<GIntBig> m_anFIDs{};
+    std::vector<Column>  m_aoFields{};
+    std::vector<Column>  m_aoGeomFields{};
+    std::vector<int>     m_anValueSize{};
+
+    void                 SetValid( Column& oColumn );
+    bool                 AppendData( Column& oColumn, const void* pData,
+                                     size_t nBytes );
+
+    CPL_DISALLOW_COPY_ASSIGN(OGRFeatureBatch)
+
+  public:
+    explicit             OGRFeatureBatch( OGRFeatureDefn* poDefn );
+                        ~OGRFeatureBatch();
+
+    /** Return the feature definition of the batch. */
+    OGRFeatureDefn      *GetDefnRef() { return m_poDefn; }
+
+    void                 Reset();
+
+    /** Return the number of rows of the batch. */
+    int                  GetLength() const { return m_nLength; }
+    /** Return the array of the GetLength() feature ids of the batch. */
+    const GIntBig       *GetFIDs() const { return m_anFIDs.data(); }
+
+    /** Return the column of an attribute field. */
+    const Column&        GetFieldColumn( int iField ) const
+                                            { return m_aoFields[iField]; }
+    /** Return the column of a geometry field. */
+    const Column&        GetGeomFieldColumn( int iGeomField ) const
+                                        { return m_aoGeomFields[iGeomField]; }
+
+    bool                 IsFieldSetAndNotNull( int iField, int iRow ) const;
+    bool                 IsGeomFieldSet( int iGeomField, int iRow ) const;
+
+    const int           *GetFieldAsIntegerArray( int iField ) const;
+    const GIntBig       *GetFieldAsInteger64Array( int iField ) const;
+    const double        *GetFieldAsDoubleArray( int iField ) const;
+    const OGRField      *GetFieldAsDateTimeArray( int iField ) const;
+    const GByte         *GetFieldAsBinary( int iField, int iRow,
+                                           int* pnBytes ) const;
+    const GByte         *GetGeometryWKB( int iGeomField, int iRow,
+                                         int* pnBytes ) const;
+
+    OGRFeature          *GetFeature( int iRow ) const;
+
+    int                  AddRow( GIntBig nFID );
+    bool                 AddFeature( const OGRFeature* poFeature );
+
+    bool                 SetFieldInteger( int iField, int nValue );
+    bool                 SetFieldInteger64( int iField, GIntBig nValue );
+    bool                 SetFieldDouble( int iField, double dfValue );
+    bool                 SetFieldString( int iField, const char* pszValue,
+                                         size_t nLen );
+    bool                 SetFieldString( int iField, const char* pszValue );
+    bool                 SetFieldBinary( int iField, const GByte* pabyData,
+                                         size_t nBytes );
+    bool                 SetField( int iField, const OGRField* psField );
+    bool                 SetGeometryWKB( int iGeomField, const GByte* pabyWKB,
+                                         size_t nBytes );
+    bool                 SetGeometry( int iGeomField,
+                                      const OGRGeometry* poGeom );
+};
+
 /************************************************************************/
 /*                           OGRFeatureQuery                            */
 /************************************************************************/
@@ -1308,6 +1308,47 @@ int OGRCoordinateTransformation::Transform(
     return bOverallSuccess;
 }
 
+/************************************************************************/
+/*                        ApplyDataAxisMapping()                        */
+/************************************************************************/
+
+static void ApplyDataAxisMapping( const std::vector<int>& mapping,
+                                  int nCount,
+                                  double *x, double *y, double *z )
+{
+    if( mapping.size() < 2 || (mapping[0] == 1 && mapping[1] == 2) )
+        return;
+
+    if( mapping[0] == 2 && mapping[1] == 1 )
+    {
+        // Most common case (geographic CRS with lat/long order): tight loop
+        for( int i = 0; i < nCount; i++ )
+        {
+            std::swap(x[i], y[i]);
+        }
+    }
+    else
+    {
+        for( int i = 0; i < nCount; i++ )
+        {
+            double newX = (mapping[0] == 1) ? x[i] :
+                (mapping[0] == -1) ? -x[i] : (mapping[0] == 2) ? y[i] : -y[i];
+            double newY = (mapping[1] == 2) ? y[i] :
+                (mapping[1] == -2) ? -y[i] : (mapping[1] == 1) ? x[i] : -x[i];
+            x[i] = newX;
+            y[i] = newY;
+        }
+    }
+
+    if( z && mapping.size() >= 3 && mapping[2] == -3 )
+    {
+        for( int i = 0; i < nCount; i++ )
+        {
+            z[i] = -z[i];
+        }
+    }
+}
+
 /************************************************************************/
 /*                             Transform()                              */
 /************************************************************************/
@@ -1350,21 +1391,8 @@ int OGRProjCT::Transform( int nCount, double *x, double *y, double *z,
 /* -------------------------------------------------------------------- */
     if( poSRSSource )
     {
-        const auto& mapping = poSRSSource->GetDataAxisToSRSAxisMapping();
-        if( mapping.size() >= 2 && (mapping[0] != 1 || mapping[1] != 2) )
-        {
-            for( int i = 0; i < nCount; i++ )
-            {
-                double newX = (mapping[0] == 1) ? x[i] :
-                    (mapping[0] == -1) ? -x[i] : (mapping[0] == 2) ? y[i] : -y[i];
-                double newY = (mapping[1] == 2) ? y[i] :
-                    (mapping[1] == -2) ? -y[i] : (mapping[1] == 1) ? x[i] : -x[i];
-                x[i] = newX;
-                y[i] = newY;
-                if( z && mapping.size() >= 3 && mapping[2] == -3)
-                    z[i] = -z[i];
-            }
-        }
+        ApplyDataAxisMapping( poSRSSource->GetDataAxisToSRSAxisMapping(),
+                              nCount, x, y, z );
     }
 
 /* -------------------------------------------------------------------- */
@@ -1755,21 +1783,8 @@ int OGRProjCT::Transform( int nCount, double *x, double *y, double *z,
 /* -------------------------------------------------------------------- */
     if( poSRSTarget )
     {
-        const auto& mapping = poSRSTarget->GetDataAxisToSRSAxisMapping();
-        if( mapping.size() >= 2 && (mapping[0] != 1 || mapping[1] != 2) )
-        {
-            for( int i = 0; i < nCount; i++ )
-            {
-                double newX = (mapping[0] == 1) ? x[i] :
-                    (mapping[0] == -1) ? -x[i] : (mapping[0] == 2) ? y[i] : -y[i];
-                double newY = (mapping[1] == 2) ? y[i] :
-                    (mapping[1] == -2) ? -y[i] : (mapping[1] == 1) ? x[i] : -x[i];
-                x[i] = newX;
-                y[i] = newY;
-                if( z && mapping.size() >= 3 && mapping[2] == -3)
-                    z[i] = -z[i];
-            }
-        }
+        ApplyDataAxisMapping( poSRSTarget->GetDataAxisToSRSAxisMapping(),
+                              nCount, x, y, z );
     }
 
 #ifdef DEBUG_VERBOSE
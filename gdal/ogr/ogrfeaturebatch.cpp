@@ -0,0 +1,959 @@
+/******************************************************************************
+ *
+ * Project:  OpenGIS Simple Features Reference Implementation
+ * Purpose:  The OGRFeatureBatch class implementation.
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+#include "ogr_feature.h"
+
+#include <climits>
+#include <cstring>
+#include <limits>
+#include <new>
+
+#include "cpl_conv.h"
+#include "cpl_error.h"
+#include "cpl_string.h"
+#include "ogr_api.h"
+#include "ogr_core.h"
+#include "ogr_p.h"
+
+CPL_CVSID("$Id$")
+
+/************************************************************************/
+/*                          OGRFeatureBatch()                           */
+/************************************************************************/
+
+/**
+ * \brief Constructor
+ *
+ * The batch will hold features of the passed feature definition, whose
+ * reference count is incremented.
+ *
+ * @param poDefn feature definition of the features of the batch.
+ */
+
+OGRFeatureBatch::OGRFeatureBatch( OGRFeatureDefn* poDefn ) :
+    m_poDefn(poDefn),
+    m_aoFields(poDefn->GetFieldCount()),
+    m_aoGeomFields(poDefn->GetGeomFieldCount()),
+    m_anValueSize(poDefn->GetFieldCount())
+{
+    m_poDefn->Reference();
+
+    for( int iField = 0; iField < m_poDefn->GetFieldCount(); iField++ )
+    {
+        switch( m_poDefn->GetFieldDefn(iField)->GetType() )
+        {
+            case OFTInteger:
+                m_anValueSize[iField] = static_cast<int>(sizeof(int));
+                break;
+            case OFTInteger64:
+                m_anValueSize[iField] = static_cast<int>(sizeof(GIntBig));
+                break;
+            case OFTReal:
+                m_anValueSize[iField] = static_cast<int>(sizeof(double));
+                break;
+            case OFTDate:
+            case OFTTime:
+            case OFTDateTime:
+                m_anValueSize[iField] = static_cast<int>(sizeof(OGRField));
+                break;
+            default:
+                m_anValueSize[iField] = 0;
+                break;
+        }
+    }
+
+    Reset();
+}
+
+/************************************************************************/
+/*                         ~OGRFeatureBatch()                           */
+/************************************************************************/
+
+OGRFeatureBatch::~OGRFeatureBatch()
+{
+    m_poDefn->Release();
+}
+
+/************************************************************************/
+/*                               Reset()                                */
+/************************************************************************/
+
+/**
+ * \brief Remove all rows from the batch.
+ *
+ * The memory allocated by the columns is kept, so that it can be reused
+ * by the next rows.
+ */
+
+void OGRFeatureBatch::Reset()
+{
+    m_nLength = 0;
+    m_anFIDs.clear();
+    for( size_t i = 0; i < m_aoFields.size(); i++ )
+    {
+        Column& oColumn = m_aoFields[i];
+        oColumn.abyValidity.clear();
+        oColumn.abyValues.clear();
+        oColumn.anOffsets.clear();
+        oColumn.abyData.clear();
+        if( m_anValueSize[i] == 0 )
+            oColumn.anOffsets.push_back(0);
+    }
+    for( auto& oColumn: m_aoGeomFields )
+    {
+        oColumn.abyValidity.clear();
+        oColumn.anOffsets.clear();
+        oColumn.abyData.clear();
+        oColumn.anOffsets.push_back(0);
+    }
+}
+
+/************************************************************************/
+/*                               AddRow()                               */
+/************************************************************************/
+
+/**
+ * \brief Append a new row to the batch.
+ *
+ * All fields of the new row are null, until set with one of the
+ * SetFieldXXX() or SetGeometryXXX() methods, which apply to the last
+ * row of the batch. Each field of a row must be set at most once.
+ *
+ * @param nFID feature id of the new row.
+ * @return the index of the new row, or -1 in case of error (the batch is
+ * then left unchanged).
+ */
+
+int OGRFeatureBatch::AddRow( GIntBig nFID )
+{
+    const int iRow = m_nLength;
+    if( iRow == INT_MAX )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Too many rows in a feature batch");
+        return -1;
+    }
+    const bool bNewValidityByte = (iRow % 8) == 0;
+    try
+    {
+        m_anFIDs.push_back(nFID);
+        for( size_t i = 0; i < m_aoFields.size(); i++ )
+        {
+            Column& oColumn = m_aoFields[i];
+            if( bNewValidityByte )
+                oColumn.abyValidity.push_back(0);
+            if( m_anValueSize[i] == 0 )
+                oColumn.anOffsets.push_back(oColumn.anOffsets.back());
+            else
+                oColumn.abyValues.resize(
+                    oColumn.abyValues.size() + m_anValueSize[i]);
+        }
+        for( auto& oColumn: m_aoGeomFields )
+        {
+            if( bNewValidityByte )
+                oColumn.abyValidity.push_back(0);
+            oColumn.anOffsets.push_back(oColumn.anOffsets.back());
+        }
+    }
+    catch( const std::bad_alloc& )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate a new row in a feature batch");
+
+        // Shrink the columns that have already been grown.
+        const size_t nValidityBytes = (static_cast<size_t>(iRow) + 7) / 8;
+        m_anFIDs.resize(iRow);
+        for( size_t i = 0; i < m_aoFields.size(); i++ )
+        {
+            Column& oColumn = m_aoFields[i];
+            oColumn.abyValidity.resize(nValidityBytes);
+            if( m_anValueSize[i] == 0 )
+                oColumn.anOffsets.resize(iRow + 1);
+            else
+                oColumn.abyValues.resize(
+                    static_cast<size_t>(iRow) * m_anValueSize[i]);
+        }
+        for( auto& oColumn: m_aoGeomFields )
+        {
+            oColumn.abyValidity.resize(nValidityBytes);
+            oColumn.anOffsets.resize(iRow + 1);
+        }
+        return -1;
+    }
+    m_nLength++;
+    return iRow;
+}
+
+/************************************************************************/
+/*                              SetValid()                              */
+/************************************************************************/
+
+void OGRFeatureBatch::SetValid( Column& oColumn )
+{
+    const int iRow = m_nLength - 1;
+    oColumn.abyValidity[iRow / 8] |=
+        static_cast<GByte>(1 << (iRow % 8));
+}
+
+/************************************************************************/
+/*                             AppendData()                             */
+/************************************************************************/
+
+bool OGRFeatureBatch::AppendData( Column& oColumn, const void* pData,
+                                  size_t nBytes )
+{
+    const size_t nOldSize = oColumn.abyData.size();
+    if( nBytes > std::numeric_limits<GUInt32>::max() - nOldSize )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Too much data in a column of a feature batch");
+        return false;
+    }
+    const GByte* pabyData = static_cast<const GByte*>(pData);
+    try
+    {
+        oColumn.abyData.insert(oColumn.abyData.end(),
+                               pabyData, pabyData + nBytes);
+    }
+    catch( const std::bad_alloc& )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate %u bytes in a column of a feature batch",
+                 static_cast<unsigned>(nBytes));
+        return false;
+    }
+    oColumn.anOffsets.back() = static_cast<GUInt32>(nOldSize + nBytes);
+    SetValid(oColumn);
+    return true;
+}
+
+/************************************************************************/
+/*                          SetFieldInteger()                           */
+/************************************************************************/
+
+/**
+ * \brief Set an integer value in the last row.
+ *
+ * The value is converted to the type of the field if needed.
+ *
+ * @param iField field index.
+ * @param nValue value.
+ * @return false if the value could not be stored in the batch.
+ */
+
+bool OGRFeatureBatch::SetFieldInteger( int iField, int nValue )
+{
+    switch( m_poDefn->GetFieldDefn(iField)->GetType() )
+    {
+        case OFTInteger:
+        {
+            Column& oColumn = m_aoFields[iField];
+            memcpy(oColumn.abyValues.data() +
+                        static_cast<size_t>(m_nLength - 1) * sizeof(int),
+                   &nValue, sizeof(int));
+            SetValid(oColumn);
+            return true;
+        }
+        case OFTInteger64:
+            return SetFieldInteger64(iField, nValue);
+        case OFTReal:
+            return SetFieldDouble(iField, nValue);
+        case OFTString:
+            return SetFieldString(iField, CPLSPrintf("%d", nValue));
+        default:
+            return true;
+    }
+}
+
+/************************************************************************/
+/*                         SetFieldInteger64()                          */
+/************************************************************************/
+
+/**
+ * \brief Set a 64 bit integer value in the last row.
+ *
+ * The value is converted to the type of the field if needed.
+ *
+ * @param iField field index.
+ * @param nValue value.
+ * @return false if the value could not be stored in the batch.
+ */
+
+bool OGRFeatureBatch::SetFieldInteger64( int iField, GIntBig nValue )
+{
+    switch( m_poDefn->GetFieldDefn(iField)->GetType() )
+    {
+        case OFTInteger:
+        {
+            const int nVal32 =
+                nValue < INT_MIN ? INT_MIN :
+                nValue > INT_MAX ? INT_MAX : static_cast<int>(nValue);
+            if( nVal32 != nValue )
+            {
+                CPLError(CE_Warning, CPLE_AppDefined,
+                         "Integer overflow occurred when trying to set "
+                         "32bit field.");
+            }
+            return SetFieldInteger(iField, nVal32);
+        }
+        case OFTInteger64:
+        {
+            Column& oColumn = m_aoFields[iField];
+            memcpy(oColumn.abyValues.data() +
+                        static_cast<size_t>(m_nLength - 1) * sizeof(GIntBig),
+                   &nValue, sizeof(GIntBig));
+            SetValid(oColumn);
+            return true;
+        }
+        case OFTReal:
+            return SetFieldDouble(iField, static_cast<double>(nValue));
+        case OFTString:
+            return SetFieldString(iField, CPLSPrintf(CPL_FRMT_GIB, nValue));
+        default:
+            return true;
+    }
+}
+
+/************************************************************************/
+/*                           SetFieldDouble()                           */
+/************************************************************************/
+
+/**
+ * \brief Set a floating point value in the last row.
+ *
+ * The value is converted to the type of the field if needed.
+ *
+ * @param iField field index.
+ * @param dfValue value.
+ * @return false if the value could not be stored in the batch.
+ */
+
+bool OGRFeatureBatch::SetFieldDouble( int iField, double dfValue )
+{
+    switch( m_poDefn->GetFieldDefn(iField)->GetType() )
+    {
+        case OFTInteger:
+            return SetFieldInteger(iField,
+                                   dfValue < INT_MIN ? INT_MIN :
+                                   dfValue > INT_MAX ? INT_MAX :
+                                                static_cast<int>(dfValue));
+        case OFTInteger64:
+            return SetFieldInteger64(iField, static_cast<GIntBig>(dfValue));
+        case OFTReal:
+        {
+            Column& oColumn = m_aoFields[iField];
+            memcpy(oColumn.abyValues.data() +
+                        static_cast<size_t>(m_nLength - 1) * sizeof(double),
+                   &dfValue, sizeof(double));
+            SetValid(oColumn);
+            return true;
+        }
+        case OFTString:
+        {
+            char szTempBuffer[128] = {};
+            OGRFormatDouble(szTempBuffer, sizeof(szTempBuffer), dfValue, '.');
+            return SetFieldString(iField, szTempBuffer);
+        }
+        default:
+            return true;
+    }
+}
+
+/************************************************************************/
+/*                           SetFieldString()                           */
+/************************************************************************/
+
+/**
+ * \brief Set a string value in the last row.
+ *
+ * The value is converted to the type of the field if needed.
+ *
+ * @param iField field index.
+ * @param pszValue value (does not need to be nul-terminated)
+ * @param nLen number of bytes of the value.
+ * @return false if the value could not be stored in the batch.
+ */
+
+bool OGRFeatureBatch::SetFieldString( int iField, const char* pszValue,
+                                      size_t nLen )
+{
+    switch( m_poDefn->GetFieldDefn(iField)->GetType() )
+    {
+        case OFTString:
+        case OFTBinary:
+            return AppendData(m_aoFields[iField], pszValue, nLen);
+        case OFTInteger:
+        case OFTInteger64:
+        case OFTReal:
+        case OFTDate:
+        case OFTTime:
+        case OFTDateTime:
+        {
+            const std::string osValue(pszValue, nLen);
+            OGRField sField;
+            if( m_anValueSize[iField] == static_cast<int>(sizeof(OGRField)) )
+            {
+                if( OGRParseDate(osValue.c_str(), &sField, 0) )
+                    return SetField(iField, &sField);
+                return true;
+            }
+            if( m_anValueSize[iField] == static_cast<int>(sizeof(int)) )
+                return SetFieldInteger(iField, atoi(osValue.c_str()));
+            if( m_poDefn->GetFieldDefn(iField)->GetType() == OFTReal )
+                return SetFieldDouble(iField, CPLAtof(osValue.c_str()));
+            return SetFieldInteger64(iField, CPLAtoGIntBig(osValue.c_str()));
+        }
+        default:
+            return true;
+    }
+}
+
+/**
+ * \brief Set a nul-terminated string value in the last row.
+ *
+ * The value is converted to the type of the field if needed.
+ *
+ * @param iField field index.
+ * @param pszValue value.
+ * @return false if the value could not be stored in the batch.
+ */
+
+bool OGRFeatureBatch::SetFieldString( int iField, const char* pszValue )
+{
+    return SetFieldString(iField, pszValue, strlen(pszValue));
+}
+
+/************************************************************************/
+/*                           SetFieldBinary()                           */
+/************************************************************************/
+
+/**
+ * \brief Set a binary value in the last row.
+ *
+ * Only applies to OFTBinary and OFTString fields.
+ *
+ * @param iField field index.
+ * @param pabyData value.
+ * @param nBytes number of bytes of the value.
+ * @return false if the value could not be stored in the batch.
+ */
+
+bool OGRFeatureBatch::SetFieldBinary( int iField, const GByte* pabyData,
+                                      size_t nBytes )
+{
+    const OGRFieldType eType = m_poDefn->GetFieldDefn(iField)->GetType();
+    if( eType == OFTBinary || eType == OFTString )
+        return AppendData(m_aoFields[iField], pabyData, nBytes);
+    return true;
+}
+
+/************************************************************************/
+/*                              SetField()                              */
+/************************************************************************/
+
+/**
+ * \brief Set a value in the last row from a raw field.
+ *
+ * The raw field must be of the type of the field, as in
+ * OGRFeature::SetField(int, const OGRField*). Unset and null raw fields
+ * leave the value null.
+ *
+ * @param iField field index.
+ * @param psField value.
+ * @return false if the value could not be stored in the batch.
+ */
+
+bool OGRFeatureBatch::SetField( int iField, const OGRField* psField )
+{
+    if( OGR_RawField_IsUnset(psField) || OGR_RawField_IsNull(psField) )
+        return true;
+
+    Column& oColumn = m_aoFields[iField];
+    switch( m_poDefn->GetFieldDefn(iField)->GetType() )
+    {
+        case OFTInteger:
+            return SetFieldInteger(iField, psField->Integer);
+        case OFTInteger64:
+            return SetFieldInteger64(iField, psField->Integer64);
+        case OFTReal:
+            return SetFieldDouble(iField, psField->Real);
+        case OFTString:
+            return SetFieldString(iField, psField->String);
+        case OFTBinary:
+            return AppendData(oColumn, psField->Binary.paData,
+                              psField->Binary.nCount);
+        case OFTDate:
+        case OFTTime:
+        case OFTDateTime:
+            memcpy(oColumn.abyValues.data() +
+                        static_cast<size_t>(m_nLength - 1) * sizeof(OGRField),
+                   psField, sizeof(OGRField));
+            SetValid(oColumn);
+            return true;
+        case OFTIntegerList:
+            return AppendData(oColumn, psField->IntegerList.paList,
+                              sizeof(int) * psField->IntegerList.nCount);
+        case OFTInteger64List:
+            return AppendData(oColumn, psField->Integer64List.paList,
+                              sizeof(GIntBig) * psField->Integer64List.nCount);
+        case OFTRealList:
+            return AppendData(oColumn, psField->RealList.paList,
+                              sizeof(double) * psField->RealList.nCount);
+        case OFTStringList:
+        {
+            std::vector<GByte> abyList;
+            for( int i = 0; i < psField->StringList.nCount; i++ )
+            {
+                const char* pszStr = psField->StringList.paList[i];
+                abyList.insert(abyList.end(), pszStr,
+                               pszStr + strlen(pszStr) + 1);
+            }
+            return AppendData(oColumn, abyList.data(), abyList.size());
+        }
+        default:
+            return true;
+    }
+}
+
+/************************************************************************/
+/*                           SetGeometryWKB()                           */
+/************************************************************************/
+
+/**
+ * \brief Set a geometry in the last row from its WKB representation.
+ *
+ * @param iGeomField geometry field index.
+ * @param pabyWKB WKB geometry.
+ * @param nBytes number of bytes of pabyWKB.
+ * @return false if the geometry could not be stored in the batch.
+ */
+
+bool OGRFeatureBatch::SetGeometryWKB( int iGeomField, const GByte* pabyWKB,
+                                      size_t nBytes )
+{
+    return AppendData(m_aoGeomFields[iGeomField], pabyWKB, nBytes);
+}
+
+/************************************************************************/
+/*                            SetGeometry()                             */
+/************************************************************************/
+
+/**
+ * \brief Set a geometry in the last row.
+ *
+ * The geometry is exported as ISO WKB, in little endian order.
+ *
+ * @param iGeomField geometry field index.
+ * @param poGeom geometry, or nullptr.
+ * @return false if the geometry could not be stored in the batch.
+ */
+
+bool OGRFeatureBatch::SetGeometry( int iGeomField, const OGRGeometry* poGeom )
+{
+    if( poGeom == nullptr )
+        return true;
+
+    Column& oColumn = m_aoGeomFields[iGeomField];
+    const size_t nOldSize = oColumn.abyData.size();
+    const size_t nBytes = static_cast<size_t>(poGeom->WkbSize());
+    if( nBytes > std::numeric_limits<GUInt32>::max() - nOldSize )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Too much data in a column of a feature batch");
+        return false;
+    }
+    try
+    {
+        oColumn.abyData.resize(nOldSize + nBytes);
+    }
+    catch( const std::bad_alloc& )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate %u bytes in a column of a feature batch",
+                 static_cast<unsigned>(nBytes));
+        return false;
+    }
+    if( poGeom->exportToWkb(wkbNDR, oColumn.abyData.data() + nOldSize,
+                            wkbVariantIso) != OGRERR_NONE )
+    {
+        oColumn.abyData.resize(nOldSize);
+        return false;
+    }
+    oColumn.anOffsets.back() = static_cast<GUInt32>(nOldSize + nBytes);
+    SetValid(oColumn);
+    return true;
+}
+
+/************************************************************************/
+/*                             AddFeature()                             */
+/************************************************************************/
+
+/**
+ * \brief Append a feature to the batch.
+ *
+ * The feature must be of the feature definition of the batch. Ignored
+ * fields are left null.
+ *
+ * @param poFeature feature.
+ * @return false if the feature could not be stored in the batch.
+ */
+
+bool OGRFeatureBatch::AddFeature( const OGRFeature* poFeature )
+{
+    if( AddRow(poFeature->GetFID()) < 0 )
+        return false;
+    for( int iField = 0; iField < m_poDefn->GetFieldCount(); iField++ )
+    {
+        if( !m_poDefn->GetFieldDefn(iField)->IsIgnored() &&
+            !SetField(iField, poFeature->GetRawFieldRef(iField)) )
+        {
+            return false;
+        }
+    }
+    for( int iGeomField = 0; iGeomField < m_poDefn->GetGeomFieldCount();
+         iGeomField++ )
+    {
+        if( !m_poDefn->GetGeomFieldDefn(iGeomField)->IsIgnored() &&
+            !SetGeometry(iGeomField,
+                         poFeature->GetGeomFieldRef(iGeomField)) )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                        IsFieldSetAndNotNull()                        */
+/************************************************************************/
+
+/**
+ * \brief Return whether a field of a row is set and not null.
+ *
+ * @param iField field index.
+ * @param iRow row index.
+ * @return true if the value is set and not null.
+ */
+
+bool OGRFeatureBatch::IsFieldSetAndNotNull( int iField, int iRow ) const
+{
+    return (m_aoFields[iField].abyValidity[iRow / 8] &
+                (1 << (iRow % 8))) != 0;
+}
+
+/************************************************************************/
+/*                           IsGeomFieldSet()                           */
+/************************************************************************/
+
+/**
+ * \brief Return whether a geometry field of a row is set.
+ *
+ * @param iGeomField geometry field index.
+ * @param iRow row index.
+ * @return true if the geometry is set.
+ */
+
+bool OGRFeatureBatch::IsGeomFieldSet( int iGeomField, int iRow ) const
+{
+    return (m_aoGeomFields[iGeomField].abyValidity[iRow / 8] &
+                (1 << (iRow % 8))) != 0;
+}
+
+/************************************************************************/
+/*                       GetFieldAsIntegerArray()                       */
+/************************************************************************/
+
+/**
+ * \brief Return the values of an OFTInteger field.
+ *
+ * @param iField field index.
+ * @return an array of GetLength() values (undefined for null values), or
+ * nullptr if the field is not of type OFTInteger.
+ */
+
+const int* OGRFeatureBatch::GetFieldAsIntegerArray( int iField ) const
+{
+    if( m_poDefn->GetFieldDefn(iField)->GetType() != OFTInteger )
+        return nullptr;
+    return reinterpret_cast<const int*>(m_aoFields[iField].abyValues.data());
+}
+
+/************************************************************************/
+/*                      GetFieldAsInteger64Array()                      */
+/************************************************************************/
+
+/**
+ * \brief Return the values of an OFTInteger64 field.
+ *
+ * @param iField field index.
+ * @return an array of GetLength() values (undefined for null values), or
+ * nullptr if the field is not of type OFTInteger64.
+ */
+
+const GIntBig* OGRFeatureBatch::GetFieldAsInteger64Array( int iField ) const
+{
+    if( m_poDefn->GetFieldDefn(iField)->GetType() != OFTInteger64 )
+        return nullptr;
+    return reinterpret_cast<const GIntBig*>(
+        m_aoFields[iField].abyValues.data());
+}
+
+/************************************************************************/
+/*                       GetFieldAsDoubleArray()                        */
+/************************************************************************/
+
+/**
+ * \brief Return the values of an OFTReal field.
+ *
+ * @param iField field index.
+ * @return an array of GetLength() values (undefined for null values), or
+ * nullptr if the field is not of type OFTReal.
+ */
+
+const double* OGRFeatureBatch::GetFieldAsDoubleArray( int iField ) const
+{
+    if( m_poDefn->GetFieldDefn(iField)->GetType() != OFTReal )
+        return nullptr;
+    return reinterpret_cast<const double*>(
+        m_aoFields[iField].abyValues.data());
+}
+
+/************************************************************************/
+/*                      GetFieldAsDateTimeArray()                       */
+/************************************************************************/
+
+/**
+ * \brief Return the values of an OFTDate, OFTTime or OFTDateTime field.
+ *
+ * @param iField field index.
+ * @return an array of GetLength() values, whose Date member is set
+ * (undefined for null values), or nullptr if the field is not of a date or
+ * time type.
+ */
+
+const OGRField* OGRFeatureBatch::GetFieldAsDateTimeArray( int iField ) const
+{
+    if( m_anValueSize[iField] != static_cast<int>(sizeof(OGRField)) )
+        return nullptr;
+    return reinterpret_cast<const OGRField*>(
+        m_aoFields[iField].abyValues.data());
+}
+
+/************************************************************************/
+/*                          GetFieldAsBinary()                          */
+/************************************************************************/
+
+/**
+ * \brief Return the value of a variable width field of a row.
+ *
+ * Applies to OFTString, OFTBinary and list fields.
+ *
+ * @param iField field index.
+ * @param iRow row index.
+ * @param pnBytes pointer to an integer that will be set to the number of
+ * bytes of the value.
+ * @return a pointer to the value (not nul-terminated), or nullptr if the
+ * field is not of a variable width type, or if the value is null.
+ */
+
+const GByte* OGRFeatureBatch::GetFieldAsBinary( int iField, int iRow,
+                                                int* pnBytes ) const
+{
+    *pnBytes = 0;
+    if( m_anValueSize[iField] != 0 || !IsFieldSetAndNotNull(iField, iRow) )
+        return nullptr;
+    const Column& oColumn = m_aoFields[iField];
+    *pnBytes = static_cast<int>(oColumn.anOffsets[iRow + 1] -
+                                oColumn.anOffsets[iRow]);
+    return oColumn.abyData.data() + oColumn.anOffsets[iRow];
+}
+
+/************************************************************************/
+/*                           GetGeometryWKB()                           */
+/************************************************************************/
+
+/**
+ * \brief Return the WKB geometry of a row.
+ *
+ * @param iGeomField geometry field index.
+ * @param iRow row index.
+ * @param pnBytes pointer to an integer that will be set to the number of
+ * bytes of the WKB geometry.
+ * @return a pointer to the WKB geometry, or nullptr if the geometry is
+ * not set.
+ */
+
+const GByte* OGRFeatureBatch::GetGeometryWKB( int iGeomField, int iRow,
+                                              int* pnBytes ) const
+{
+    *pnBytes = 0;
+    if( !IsGeomFieldSet(iGeomField, iRow) )
+        return nullptr;
+    const Column& oColumn = m_aoGeomFields[iGeomField];
+    *pnBytes = static_cast<int>(oColumn.anOffsets[iRow + 1] -
+                                oColumn.anOffsets[iRow]);
+    return oColumn.abyData.data() + oColumn.anOffsets[iRow];
+}
+
+/************************************************************************/
+/*                             GetFeature()                             */
+/************************************************************************/
+
+/**
+ * \brief Build a feature from a row.
+ *
+ * Fields whose value is not set in the row are set to null.
+ *
+ * @param iRow row index.
+ * @return a new feature, to be freed with delete.
+ */
+
+OGRFeature* OGRFeatureBatch::GetFeature( int iRow ) const
+{
+    OGRFeature* poFeature = new OGRFeature(m_poDefn);
+    poFeature->SetFID(m_anFIDs[iRow]);
+
+    for( int iField = 0; iField < m_poDefn->GetFieldCount(); iField++ )
+    {
+        if( !IsFieldSetAndNotNull(iField, iRow) )
+        {
+            poFeature->SetFieldNull(iField);
+            continue;
+        }
+
+        const Column& oColumn = m_aoFields[iField];
+        const GByte* pabyValue = oColumn.abyValues.data() +
+            static_cast<size_t>(iRow) * m_anValueSize[iField];
+        int nBytes = 0;
+        const GByte* pabyData = GetFieldAsBinary(iField, iRow, &nBytes);
+        switch( m_poDefn->GetFieldDefn(iField)->GetType() )
+        {
+            case OFTInteger:
+            {
+                int nVal = 0;
+                memcpy(&nVal, pabyValue, sizeof(int));
+                poFeature->SetField(iField, nVal);
+                break;
+            }
+            case OFTInteger64:
+            {
+                GIntBig nVal = 0;
+                memcpy(&nVal, pabyValue, sizeof(GIntBig));
+                poFeature->SetField(iField, nVal);
+                break;
+            }
+            case OFTReal:
+            {
+                double dfVal = 0;
+                memcpy(&dfVal, pabyValue, sizeof(double));
+                poFeature->SetField(iField, dfVal);
+                break;
+            }
+            case OFTDate:
+            case OFTTime:
+            case OFTDateTime:
+            {
+                OGRField sField;
+                memcpy(&sField, pabyValue, sizeof(OGRField));
+                poFeature->SetField(iField, &sField);
+                break;
+            }
+            case OFTString:
+            {
+                const std::string osVal(
+                    reinterpret_cast<const char*>(pabyData), nBytes);
+                poFeature->SetField(iField, osVal.c_str());
+                break;
+            }
+            case OFTBinary:
+                poFeature->SetField(iField, nBytes, pabyData);
+                break;
+            case OFTIntegerList:
+            {
+                std::vector<int> anList(nBytes / sizeof(int));
+                if( !anList.empty() )
+                    memcpy(anList.data(), pabyData, nBytes);
+                poFeature->SetField(iField, static_cast<int>(anList.size()),
+                                    anList.data());
+                break;
+            }
+            case OFTInteger64List:
+            {
+                std::vector<GIntBig> anList(nBytes / sizeof(GIntBig));
+                if( !anList.empty() )
+                    memcpy(anList.data(), pabyData, nBytes);
+                poFeature->SetField(iField, static_cast<int>(anList.size()),
+                                    anList.data());
+                break;
+            }
+            case OFTRealList:
+            {
+                std::vector<double> adfList(nBytes / sizeof(double));
+                if( !adfList.empty() )
+                    memcpy(adfList.data(), pabyData, nBytes);
+                poFeature->SetField(iField, static_cast<int>(adfList.size()),
+                                    adfList.data());
+                break;
+            }
+            case OFTStringList:
+            {
+                CPLStringList aosList;
+                int nOffset = 0;
+                while( nOffset < nBytes )
+                {
+                    const char* pszStr =
+                        reinterpret_cast<const char*>(pabyData + nOffset);
+                    aosList.AddString(pszStr);
+                    nOffset += static_cast<int>(strlen(pszStr)) + 1;
+                }
+                poFeature->SetField(iField, aosList.List());
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    for( int iGeomField = 0; iGeomField < m_poDefn->GetGeomFieldCount();
+         iGeomField++ )
+    {
+        int nBytes = 0;
+        const GByte* pabyWKB = GetGeometryWKB(iGeomField, iRow, &nBytes);
+        if( pabyWKB == nullptr )
+            continue;
+        OGRGeometry* poGeom = nullptr;
+        OGRGeometryFactory::createFromWkb(
+            pabyWKB,
+            m_poDefn->GetGeomFieldDefn(iGeomField)->GetSpatialRef(),
+            &poGeom, nBytes);
+        poFeature->SetGeomFieldDirectly(iGeomField, poGeom);
+    }
+
+    return poFeature;
+}
@@ -534,6 +534,60 @@ OGRErr OGR_L_SetNextByIndex( OGRLayerH hLayer, GIntBig nIndex )
     return OGRLayer::FromHandle(hLayer)->SetNextByIndex( nIndex );
 }
 
+/************************************************************************/
+/*                        GetNextFeatureBatch()                         */
+/************************************************************************/
+
+/**
+ \brief Fetch the next batch of features from this layer.
+
+ This method fetches up to nMaxRows features, in column-oriented buffers
+ (see OGRFeatureBatch), starting at the current read position, as
+ GetNextFeature() would do. Spatial and attribute filters, and ignored
+ fields, are honoured. The previous content of the batch is discarded.
+
+ The default implementation calls GetNextFeature() and adds the returned
+ features to the batch. Drivers that can directly fill the batch from their
+ storage, without instantiating OGRFeature objects, override it and
+ report the OLCFastGetNextFeatureBatch capability.
+
+ Calls to GetNextFeatureBatch() and GetNextFeature() can be interleaved.
+
+ @param poBatch batch to fill, that must have been created with the
+ feature definition returned by GetLayerDefn().
+ @param nMaxRows maximum number of features to fetch.
+
+ @return the number of features in the batch, 0 when no more features are
+ available, or -1 in case of error.
+
+ @since GDAL 3.1
+*/
+
+int OGRLayer::GetNextFeatureBatch( OGRFeatureBatch* poBatch, int nMaxRows )
+
+{
+    if( poBatch->GetDefnRef() != GetLayerDefn() )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "GetNextFeatureBatch(): batch not created with the "
+                 "feature definition of the layer");
+        return -1;
+    }
+
+    poBatch->Reset();
+    while( poBatch->GetLength() < nMaxRows )
+    {
+        OGRFeature* poFeature = GetNextFeature();
+        if( poFeature == nullptr )
+            break;
+        const bool bOK = poBatch->AddFeature(poFeature);
+        delete poFeature;
+        if( !bOK )
+            return -1;
+    }
+    return poBatch->GetLength();
+}
+
 /************************************************************************/
 /*                        OGR_L_GetNextFeature()                        */
 /************************************************************************/
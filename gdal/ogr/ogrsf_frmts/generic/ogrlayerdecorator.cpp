@@ -97,6 +97,17 @@ OGRFeature *OGRLayerDecorator::GetNextFeature()
     return m_poDecoratedLayer->GetNextFeature();
 }
 
+int         OGRLayerDecorator::GetNextFeatureBatch( OGRFeatureBatch* poBatch,
+                                                    int nMaxRows )
+{
+    if( !m_poDecoratedLayer ) return 0;
+    // Decorators that expose their own feature definition build their
+    // features in GetNextFeature(), so go through it.
+    if( GetLayerDefn() != m_poDecoratedLayer->GetLayerDefn() )
+        return OGRLayer::GetNextFeatureBatch(poBatch, nMaxRows);
+    return m_poDecoratedLayer->GetNextFeatureBatch(poBatch, nMaxRows);
+}
+
 OGRErr      OGRLayerDecorator::SetNextByIndex( GIntBig nIndex )
 {
     if( !m_poDecoratedLayer ) return OGRERR_FAILURE;
@@ -60,6 +60,8 @@ class CPL_DLL OGRLayerDecorator : public OGRLayer
 
     virtual void        ResetReading() override;
     virtual OGRFeature *GetNextFeature() override;
+    virtual int         GetNextFeatureBatch( OGRFeatureBatch* poBatch,
+                                             int nMaxRows ) override;
     virtual OGRErr      SetNextByIndex( GIntBig nIndex ) override;
     virtual OGRFeature *GetFeature( GIntBig nFID ) override;
     virtual OGRErr      ISetFeature( OGRFeature *poFeature ) override;
@@ -93,6 +93,13 @@ OGRFeature *OGRMutexedLayer::GetNextFeature()
     return OGRLayerDecorator::GetNextFeature();
 }
 
+int         OGRMutexedLayer::GetNextFeatureBatch( OGRFeatureBatch* poBatch,
+                                                  int nMaxRows )
+{
+    CPLMutexHolderOptionalLockD(m_hMutex);
+    return OGRLayerDecorator::GetNextFeatureBatch(poBatch, nMaxRows);
+}
+
 OGRErr      OGRMutexedLayer::SetNextByIndex( GIntBig nIndex )
 {
     CPLMutexHolderOptionalLockD(m_hMutex);
@@ -376,7 +376,12 @@ class OGRGeoPackageLayer : public OGRLayer, public IOGRSQLiteGetSpatialWhere
     void                BuildFeatureDefn( const char *pszLayerName,
                                            sqlite3_stmt *hStmt );
 
+    int                 FilterGeometryFromHeader(sqlite3_stmt* hStmt);
+    GIntBig             TranslateFID(sqlite3_stmt* hStmt);
+    OGRGeometry*        TranslateGeometry(sqlite3_stmt* hStmt);
     OGRFeature*         TranslateFeature(sqlite3_stmt* hStmt);
+    bool                TranslateFeatureToBatch(sqlite3_stmt* hStmt,
+                                                OGRFeatureBatch* poBatch);
 
   public:
 
@@ -434,6 +439,7 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
     bool                        m_bTruncateFields;
     bool                        m_bDeferredCreation;
     int                         m_iFIDAsRegularColumnIndex;
+    bool                        m_bBatchEOF;
 
     CPLString                   m_osIdentifierLCO;
     CPLString                   m_osDescriptionLCO;
@@ -494,6 +500,8 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
     OGRErr              SetAttributeFilter( const char *pszQuery ) override;
     OGRErr              SyncToDisk() override;
     OGRFeature*         GetNextFeature() override;
+    int                 GetNextFeatureBatch( OGRFeatureBatch* poBatch,
+                                             int nMaxRows ) override;
     OGRFeature*         GetFeature(GIntBig nFID) override;
     OGRErr              StartTransaction() override;
     OGRErr              CommitTransaction() override;
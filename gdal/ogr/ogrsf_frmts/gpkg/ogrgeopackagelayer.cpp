@@ -136,9 +136,19 @@ OGRFeature *OGRGeoPackageLayer::GetNextFeature()
             bDoStep = true;
         }
 
+        // Try to evaluate the spatial filter from the envelope of the
+        // geometry blob, before building the feature.
+        const int nHeaderFilter = (m_poFilterGeom != nullptr) ?
+            FilterGeometryFromHeader(m_poQueryStatement) : -1;
+        if( nHeaderFilter == 0 )
+        {
+            iNextShapeId++;
+            continue;
+        }
+
         OGRFeature *poFeature = TranslateFeature(m_poQueryStatement);
 
-        if( (m_poFilterGeom == nullptr
+        if( (m_poFilterGeom == nullptr || nHeaderFilter == 1
             || FilterGeometry( poFeature->GetGeomFieldRef(m_iGeomFieldFilter) ) )
             && (m_poAttrQuery == nullptr
                 || m_poAttrQuery->Evaluate( poFeature )) )
@@ -149,64 +159,271 @@ OGRFeature *OGRGeoPackageLayer::GetNextFeature()
 }
 
 /************************************************************************/
-/*                         TranslateFeature()                           */
+/*                      FilterGeometryFromHeader()                      */
+/*                                                                      */
+/*      Evaluate the spatial filter against the envelope of the         */
+/*      geometry blob of the current row, that is read from the         */
+/*      GeoPackage header (or from the WKB for points, which            */
+/*      generally have no envelope in their header), without parsing    */
+/*      the geometry.                                                   */
+/*      Returns 0 if the row can be rejected, 1 if it can be accepted,  */
+/*      and -1 if FilterGeometry() must be run on the geometry.         */
 /************************************************************************/
 
-OGRFeature *OGRGeoPackageLayer::TranslateFeature( sqlite3_stmt* hStmt )
+int OGRGeoPackageLayer::FilterGeometryFromHeader( sqlite3_stmt* hStmt )
 
 {
-/* -------------------------------------------------------------------- */
-/*      Create a feature from the current result.                       */
-/* -------------------------------------------------------------------- */
-    OGRFeature *poFeature = new OGRFeature( m_poFeatureDefn );
+    if( iGeomCol < 0 ||
+        m_poFeatureDefn->GetGeomFieldDefn(0)->IsIgnored() )
+    {
+        return -1;
+    }
 
-/* -------------------------------------------------------------------- */
-/*      Set FID if we have a column to set it from.                     */
-/* -------------------------------------------------------------------- */
+    // A null geometry never intersects the filter.
+    if( sqlite3_column_type(hStmt, iGeomCol) == SQLITE_NULL )
+        return 0;
+
+    const int nBLOBLen = sqlite3_column_bytes(hStmt, iGeomCol);
+    // coverity[tainted_data_return]
+    const GByte* pabyBLOB = static_cast<const GByte*>(
+        sqlite3_column_blob(hStmt, iGeomCol));
+    GPkgHeader oHeader;
+    if( pabyBLOB == nullptr ||
+        GPkgHeaderFromWKB(pabyBLOB, nBLOBLen, &oHeader) != OGRERR_NONE ||
+        oHeader.bEmpty )
+    {
+        return -1;
+    }
+
+    OGREnvelope sGeomEnv;
+    if( oHeader.bExtentHasXY )
+    {
+        sGeomEnv.MinX = oHeader.MinX;
+        sGeomEnv.MinY = oHeader.MinY;
+        sGeomEnv.MaxX = oHeader.MaxX;
+        sGeomEnv.MaxY = oHeader.MaxY;
+    }
+    else
+    {
+        // Point: byte order, geometry type and 2 doubles at least.
+        const GByte* pabyWKB = pabyBLOB + oHeader.nHeaderLen;
+        if( static_cast<size_t>(nBLOBLen) < oHeader.nHeaderLen + 5 + 16 ||
+            (pabyWKB[0] != wkbNDR && pabyWKB[0] != wkbXDR) )
+        {
+            return -1;
+        }
+        const OGRwkbByteOrder eByteOrder =
+            static_cast<OGRwkbByteOrder>(pabyWKB[0]);
+        GUInt32 nGeomType = 0;
+        memcpy(&nGeomType, pabyWKB + 1, 4);
+        if( OGR_SWAP(eByteOrder) )
+            CPL_SWAP32PTR(&nGeomType);
+        // wkbPoint, wkbPoint25D, and ISO Point Z/M/ZM
+        if( nGeomType != wkbPoint && nGeomType != wkbPoint25D &&
+            nGeomType != 1001 && nGeomType != 2001 && nGeomType != 3001 )
+        {
+            return -1;
+        }
+        double dfX = 0.0;
+        double dfY = 0.0;
+        memcpy(&dfX, pabyWKB + 5, 8);
+        memcpy(&dfY, pabyWKB + 5 + 8, 8);
+        if( OGR_SWAP(eByteOrder) )
+        {
+            CPL_SWAPDOUBLE(&dfX);
+            CPL_SWAPDOUBLE(&dfY);
+        }
+        // POINT EMPTY is encoded with NaN coordinates.
+        if( CPLIsNan(dfX) || CPLIsNan(dfY) )
+            return -1;
+        sGeomEnv.MinX = dfX;
+        sGeomEnv.MinY = dfY;
+        sGeomEnv.MaxX = dfX;
+        sGeomEnv.MaxY = dfY;
+    }
+
+    // Same logic as the first steps of OGRLayer::FilterGeometry()
+    if( sGeomEnv.MaxX < m_sFilterEnvelope.MinX
+        || sGeomEnv.MaxY < m_sFilterEnvelope.MinY
+        || m_sFilterEnvelope.MaxX < sGeomEnv.MinX
+        || m_sFilterEnvelope.MaxY < sGeomEnv.MinY )
+    {
+        return 0;
+    }
+
+    if( m_bFilterIsEnvelope &&
+        sGeomEnv.MinX >= m_sFilterEnvelope.MinX &&
+        sGeomEnv.MinY >= m_sFilterEnvelope.MinY &&
+        sGeomEnv.MaxX <= m_sFilterEnvelope.MaxX &&
+        sGeomEnv.MaxY <= m_sFilterEnvelope.MaxY )
+    {
+        return 1;
+    }
+
+    return -1;
+}
+
+/************************************************************************/
+/*                            TranslateFID()                            */
+/*                                                                      */
+/*      Return the FID of the current result, and advance the          */
+/*      feature counters.                                               */
+/************************************************************************/
+
+GIntBig OGRGeoPackageLayer::TranslateFID( sqlite3_stmt* hStmt )
+
+{
+    GIntBig nFID = iNextShapeId;
     if( iFIDCol >= 0 )
     {
-        poFeature->SetFID( sqlite3_column_int64( hStmt, iFIDCol ) );
-        if( m_pszFidColumn == nullptr && poFeature->GetFID() == 0 )
+        nFID = sqlite3_column_int64( hStmt, iFIDCol );
+        if( m_pszFidColumn == nullptr && nFID == 0 )
         {
-            // Miht be the case for views with joins.
-            poFeature->SetFID( iNextShapeId );
+            // Might be the case for views with joins.
+            nFID = iNextShapeId;
         }
     }
-    else
-        poFeature->SetFID( iNextShapeId );
 
     iNextShapeId++;
 
     m_nFeaturesRead++;
 
-/* -------------------------------------------------------------------- */
-/*      Process Geometry if we have a column.                           */
-/* -------------------------------------------------------------------- */
-    if( iGeomCol >= 0 )
+    return nFID;
+}
+
+/************************************************************************/
+/*                           TranslateField()                           */
+/*                                                                      */
+/*      Decode a non-null column of the current result into a raw       */
+/*      field value. String and binary values point to the memory of    */
+/*      the statement, and are only valid until its next step.          */
+/*      Returns false if the value cannot be decoded, in which case     */
+/*      the field must be left unset.                                   */
+/************************************************************************/
+
+static bool TranslateField( sqlite3_stmt* hStmt, int iRawField,
+                            OGRFieldType eType, OGRField* psField )
+
+{
+    // So that no value can be mistaken for the unset or null markers.
+    psField->Set.nMarker2 = 0;
+    psField->Set.nMarker3 = 0;
+
+    switch( eType )
     {
-        OGRGeomFieldDefn* poGeomFieldDefn = m_poFeatureDefn->GetGeomFieldDefn(0);
-        if ( sqlite3_column_type(hStmt, iGeomCol) != SQLITE_NULL &&
-            !poGeomFieldDefn->IsIgnored() )
+        case OFTInteger:
+            psField->Integer = sqlite3_column_int( hStmt, iRawField );
+            return true;
+
+        case OFTInteger64:
+            psField->Integer64 = sqlite3_column_int64( hStmt, iRawField );
+            return true;
+
+        case OFTReal:
+            psField->Real = sqlite3_column_double( hStmt, iRawField );
+            return true;
+
+        case OFTBinary:
         {
-            OGRSpatialReference* poSrs = poGeomFieldDefn->GetSpatialRef();
-            int iGpkgSize = sqlite3_column_bytes(hStmt, iGeomCol);
+            psField->Binary.nCount = sqlite3_column_bytes( hStmt, iRawField );
             // coverity[tainted_data_return]
-            GByte *pabyGpkg = (GByte *)sqlite3_column_blob(hStmt, iGeomCol);
-            OGRGeometry *poGeom = GPkgGeometryToOGR(pabyGpkg, iGpkgSize, nullptr);
-            if ( poGeom == nullptr )
-            {
-                // Try also spatialite geometry blobs
-                if( OGRSQLiteLayer::ImportSpatiaLiteGeometry( pabyGpkg, iGpkgSize,
-                                                              &poGeom ) != OGRERR_NONE )
-                {
-                    CPLError( CE_Failure, CPLE_AppDefined, "Unable to read geometry");
-                }
-            }
-            if( poGeom != nullptr )
-                poGeom->assignSpatialReference(poSrs);
-            poFeature->SetGeometryDirectly( poGeom );
+            psField->Binary.paData = const_cast<GByte*>(
+                static_cast<const GByte*>(
+                    sqlite3_column_blob( hStmt, iRawField ) ));
+            return true;
+        }
+
+        case OFTDate:
+        {
+            const char* pszTxt = reinterpret_cast<const char*>(
+                sqlite3_column_text( hStmt, iRawField ));
+            int nYear, nMonth, nDay;
+            if( sscanf(pszTxt, "%d-%d-%d", &nYear, &nMonth, &nDay) != 3 )
+                return false;
+            psField->Date.Year = static_cast<GInt16>(nYear);
+            psField->Date.Month = static_cast<GByte>(nMonth);
+            psField->Date.Day = static_cast<GByte>(nDay);
+            psField->Date.Hour = 0;
+            psField->Date.Minute = 0;
+            psField->Date.TZFlag = 0;
+            psField->Date.Reserved = 0;
+            psField->Date.Second = 0.0f;
+            return true;
+        }
+
+        case OFTDateTime:
+        {
+            const char* pszTxt = reinterpret_cast<const char*>(
+                sqlite3_column_text( hStmt, iRawField ));
+            return OGRParseXMLDateTime(pszTxt, psField) != 0;
+        }
+
+        case OFTString:
+            psField->String = const_cast<char*>(reinterpret_cast<const char*>(
+                sqlite3_column_text( hStmt, iRawField )));
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+/************************************************************************/
+/*                         TranslateGeometry()                          */
+/*                                                                      */
+/*      Build the geometry of the current result, or return nullptr    */
+/*      if it is null.                                                  */
+/************************************************************************/
+
+OGRGeometry *OGRGeoPackageLayer::TranslateGeometry( sqlite3_stmt* hStmt )
+
+{
+    if( iGeomCol < 0 || sqlite3_column_type(hStmt, iGeomCol) == SQLITE_NULL )
+        return nullptr;
+
+    OGRGeomFieldDefn* poGeomFieldDefn = m_poFeatureDefn->GetGeomFieldDefn(0);
+    OGRSpatialReference* poSrs = poGeomFieldDefn->GetSpatialRef();
+    int iGpkgSize = sqlite3_column_bytes(hStmt, iGeomCol);
+    // coverity[tainted_data_return]
+    GByte *pabyGpkg = (GByte *)sqlite3_column_blob(hStmt, iGeomCol);
+    OGRGeometry *poGeom = GPkgGeometryToOGR(pabyGpkg, iGpkgSize, nullptr);
+    if ( poGeom == nullptr )
+    {
+        // Try also spatialite geometry blobs
+        if( OGRSQLiteLayer::ImportSpatiaLiteGeometry( pabyGpkg, iGpkgSize,
+                                                      &poGeom ) != OGRERR_NONE )
+        {
+            CPLError( CE_Failure, CPLE_AppDefined, "Unable to read geometry");
         }
     }
+    if( poGeom != nullptr )
+        poGeom->assignSpatialReference(poSrs);
+    return poGeom;
+}
+
+/************************************************************************/
+/*                         TranslateFeature()                           */
+/************************************************************************/
+
+OGRFeature *OGRGeoPackageLayer::TranslateFeature( sqlite3_stmt* hStmt )
+
+{
+/* -------------------------------------------------------------------- */
+/*      Create a feature from the current result.                       */
+/* -------------------------------------------------------------------- */
+    OGRFeature *poFeature = new OGRFeature( m_poFeatureDefn );
+
+    poFeature->SetFID( TranslateFID( hStmt ) );
+
+/* -------------------------------------------------------------------- */
+/*      Process Geometry if we have a column.                           */
+/* -------------------------------------------------------------------- */
+    if( iGeomCol >= 0 &&
+        sqlite3_column_type(hStmt, iGeomCol) != SQLITE_NULL &&
+        !m_poFeatureDefn->GetGeomFieldDefn(0)->IsIgnored() )
+    {
+        poFeature->SetGeometryDirectly( TranslateGeometry( hStmt ) );
+    }
 
 /* -------------------------------------------------------------------- */
 /*      set the fields.                                                 */
@@ -225,63 +442,90 @@ OGRFeature *OGRGeoPackageLayer::TranslateFeature( sqlite3_stmt* hStmt )
             continue;
         }
 
-        switch( poFieldDefn->GetType() )
+        OGRField sField;
+        if( TranslateField( hStmt, iRawField, poFieldDefn->GetType(),
+                            &sField ) )
         {
-            case OFTInteger:
-                poFeature->SetField( iField,
-                    sqlite3_column_int( hStmt, iRawField ) );
-                break;
-
-            case OFTInteger64:
-                poFeature->SetField( iField,
-                    sqlite3_column_int64( hStmt, iRawField ) );
-                break;
-
-            case OFTReal:
-                poFeature->SetField( iField,
-                    sqlite3_column_double( hStmt, iRawField ) );
-                break;
-
-            case OFTBinary:
-            {
-                const int nBytes = sqlite3_column_bytes( hStmt, iRawField );
-                // coverity[tainted_data_return]
-                const GByte* pabyData = reinterpret_cast<const GByte*>(
-                    sqlite3_column_blob( hStmt, iRawField ) );
-                poFeature->SetField( iField, nBytes,
-                                     const_cast<GByte*>(pabyData) );
-                break;
-            }
+            poFeature->SetField( iField, &sField );
+        }
+    }
 
-            case OFTDate:
-            {
-                const char* pszTxt = (const char*)sqlite3_column_text( hStmt, iRawField );
-                int nYear, nMonth, nDay;
-                if( sscanf(pszTxt, "%d-%d-%d", &nYear, &nMonth, &nDay) == 3 )
-                    poFeature->SetField(iField, nYear, nMonth, nDay, 0, 0, 0, 0);
-                break;
-            }
+    return poFeature;
+}
+
+/************************************************************************/
+/*                       TranslateFeatureToBatch()                      */
+/************************************************************************/
+
+// Same as TranslateFeature(), but appends the current result to a batch,
+// without going through OGRFeature and OGRGeometry objects. Returns false
+// if the feature could not be stored in the batch.
+
+bool OGRGeoPackageLayer::TranslateFeatureToBatch( sqlite3_stmt* hStmt,
+                                                  OGRFeatureBatch* poBatch )
+
+{
+    if( poBatch->AddRow( TranslateFID( hStmt ) ) < 0 )
+        return false;
 
-            case OFTDateTime:
+/* -------------------------------------------------------------------- */
+/*      Process Geometry if we have a column.                           */
+/* -------------------------------------------------------------------- */
+    if( iGeomCol >= 0 &&
+        sqlite3_column_type(hStmt, iGeomCol) != SQLITE_NULL &&
+        !m_poFeatureDefn->GetGeomFieldDefn(0)->IsIgnored() )
+    {
+        const int iGpkgSize = sqlite3_column_bytes(hStmt, iGeomCol);
+        // coverity[tainted_data_return]
+        const GByte *pabyGpkg = static_cast<const GByte*>(
+            sqlite3_column_blob(hStmt, iGeomCol));
+        GPkgHeader oHeader;
+        if( GPkgHeaderFromWKB(pabyGpkg, iGpkgSize, &oHeader) == OGRERR_NONE )
+        {
+            // The GeoPackage blob embeds the WKB geometry after its header.
+            if( !poBatch->SetGeometryWKB( 0, pabyGpkg + oHeader.nHeaderLen,
+                                          iGpkgSize - oHeader.nHeaderLen ) )
+                return false;
+        }
+        else
+        {
+            // Try also spatialite geometry blobs
+            OGRGeometry *poGeom = nullptr;
+            if( OGRSQLiteLayer::ImportSpatiaLiteGeometry(
+                    pabyGpkg, iGpkgSize, &poGeom ) != OGRERR_NONE )
             {
-                const char* pszTxt = (const char*)sqlite3_column_text( hStmt, iRawField );
-                OGRField sField;
-                if( OGRParseXMLDateTime(pszTxt, &sField) )
-                    poFeature->SetField(iField, &sField);
-                break;
+                CPLError( CE_Failure, CPLE_AppDefined, "Unable to read geometry");
             }
+            const bool bOK = poBatch->SetGeometry( 0, poGeom );
+            delete poGeom;
+            if( !bOK )
+                return false;
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      set the fields.                                                 */
+/* -------------------------------------------------------------------- */
+    for( int iField = 0; iField < m_poFeatureDefn->GetFieldCount(); iField++ )
+    {
+        OGRFieldDefn *poFieldDefn = m_poFeatureDefn->GetFieldDefn( iField );
+        if ( poFieldDefn->IsIgnored() )
+            continue;
 
-            case OFTString:
-                poFeature->SetField( iField,
-                        (const char *) sqlite3_column_text( hStmt, iRawField ) );
-                break;
+        const int iRawField = panFieldOrdinals[iField];
 
-            default:
-                break;
+        if( sqlite3_column_type( hStmt, iRawField ) == SQLITE_NULL )
+            continue;
+
+        OGRField sField;
+        if( TranslateField( hStmt, iRawField, poFieldDefn->GetType(),
+                            &sField ) &&
+            !poBatch->SetField( iField, &sField ) )
+        {
+            return false;
         }
     }
-
-    return poFeature;
+    return true;
 }
 
 /************************************************************************/
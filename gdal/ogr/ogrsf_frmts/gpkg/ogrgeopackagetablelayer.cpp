@@ -1094,6 +1094,7 @@ OGRGeoPackageTableLayer::OGRGeoPackageTableLayer(
     m_bTruncateFields(false),
     m_bDeferredCreation(false),
     m_iFIDAsRegularColumnIndex(-1),
+    m_bBatchEOF(false),
     m_bHasReadMetadataFromStorage(false),
     m_bHasTriedDetectingFID64(false),
     m_eASPatialVariant(GPKG_ATTRIBUTES)
@@ -2039,6 +2040,7 @@ void OGRGeoPackageTableLayer::ResetReading()
         return;
 
     OGRGeoPackageLayer::ResetReading();
+    m_bBatchEOF = false;
 
     if ( m_poInsertStatement )
     {
@@ -2155,6 +2157,102 @@ OGRFeature* OGRGeoPackageTableLayer::GetNextFeature()
     return poFeature;
 }
 
+/************************************************************************/
+/*                        GetNextFeatureBatch()                         */
+/************************************************************************/
+
+int OGRGeoPackageTableLayer::GetNextFeatureBatch( OGRFeatureBatch* poBatch,
+                                                  int nMaxRows )
+{
+    if( !m_bFeatureDefnCompleted )
+        GetLayerDefn();
+
+    if( poBatch->GetDefnRef() != m_poFeatureDefn ||
+        (m_poFilterGeom != nullptr &&
+         m_poFeatureDefn->GetGeomFieldDefn(0)->IsIgnored()) )
+    {
+        return OGRLayer::GetNextFeatureBatch(poBatch, nMaxRows);
+    }
+
+    if( m_bDeferredCreation && RunDeferredCreationIfNecessary() != OGRERR_NONE )
+        return -1;
+
+    CreateSpatialIndexIfNecessary();
+
+    poBatch->Reset();
+
+    // The end of the result set was reached by the previous call: do not
+    // restart a new iteration.
+    if( m_bBatchEOF )
+    {
+        m_bBatchEOF = false;
+        return 0;
+    }
+
+    while( poBatch->GetLength() < nMaxRows )
+    {
+        if( m_poQueryStatement == nullptr )
+        {
+            ResetStatement();
+            if (m_poQueryStatement == nullptr)
+                return -1;
+        }
+
+        if( bDoStep )
+        {
+            int rc = sqlite3_step( m_poQueryStatement );
+            if( rc != SQLITE_ROW )
+            {
+                if ( rc != SQLITE_DONE )
+                {
+                    sqlite3_reset(m_poQueryStatement);
+                    CPLError( CE_Failure, CPLE_AppDefined,
+                            "In GetNextFeatureBatch(): sqlite3_step() : %s",
+                            sqlite3_errmsg(m_poDS->GetDB()) );
+                }
+
+                ClearStatement();
+
+                m_bBatchEOF = poBatch->GetLength() > 0;
+                break;
+            }
+        }
+        else
+        {
+            bDoStep = true;
+        }
+
+        // The spatial filter is evaluated on the envelope of the geometry
+        // blob, and the geometry is only built when that is not enough to
+        // decide. Accepted geometries are copied as WKB in all cases.
+        if( m_poFilterGeom != nullptr )
+        {
+            const int nHeaderFilter =
+                FilterGeometryFromHeader(m_poQueryStatement);
+            if( nHeaderFilter < 0 )
+            {
+                std::unique_ptr<OGRGeometry> poGeom(
+                    TranslateGeometry(m_poQueryStatement));
+                if( !FilterGeometry(poGeom.get()) )
+                {
+                    iNextShapeId++;
+                    continue;
+                }
+            }
+            else if( nHeaderFilter == 0 )
+            {
+                iNextShapeId++;
+                continue;
+            }
+        }
+
+        if( !TranslateFeatureToBatch(m_poQueryStatement, poBatch) )
+            return -1;
+    }
+
+    return poBatch->GetLength();
+}
+
 /************************************************************************/
 /*                        GetFeature()                                  */
 /************************************************************************/
@@ -2655,6 +2753,11 @@ int OGRGeoPackageTableLayer::TestCapability ( const char * pszCap )
         return TRUE;
     else if( EQUAL(pszCap,OLCMeasuredGeometries) )
         return TRUE;
+    else if( EQUAL(pszCap,OLCFastGetNextFeatureBatch) )
+    {
+        return m_poFilterGeom == nullptr ||
+               !GetLayerDefn()->GetGeomFieldDefn(0)->IsIgnored();
+    }
     else
     {
         return OGRGeoPackageLayer::TestCapability(pszCap);
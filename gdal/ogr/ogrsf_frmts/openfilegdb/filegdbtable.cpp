@@ -2174,6 +2174,8 @@ class FileGDBOGRGeometryConverterImpl final : public FileGDBOGRGeometryConverter
        virtual                         ~FileGDBOGRGeometryConverterImpl();
 
        virtual OGRGeometry*             GetAsGeometry(const OGRField* psField) override;
+       virtual bool                     GetAsWKB(const OGRField* psField,
+                                                 std::vector<GByte>& abyWKB) override;
 };
 
 /************************************************************************/
@@ -3256,6 +3258,257 @@ OGRGeometry* FileGDBOGRGeometryConverterImpl::GetAsGeometry(const OGRField* psFi
     return nullptr;
 }
 
+/************************************************************************/
+/*                          WKB writing helpers                         */
+/************************************************************************/
+
+static void AppendWKBUInt32(std::vector<GByte>& abyWKB, GUInt32 nVal)
+{
+    CPL_LSBPTR32(&nVal);
+    const GByte* pabyVal = reinterpret_cast<const GByte*>(&nVal);
+    abyWKB.insert(abyWKB.end(), pabyVal, pabyVal + sizeof(nVal));
+}
+
+static void AppendWKBHeader(std::vector<GByte>& abyWKB,
+                            OGRwkbGeometryType eFlatType,
+                            bool bHasZ, bool bHasM)
+{
+    abyWKB.push_back(static_cast<GByte>(wkbNDR));
+    // ISO WKB geometry type
+    AppendWKBUInt32(abyWKB, static_cast<GUInt32>(eFlatType) +
+                            (bHasZ ? 1000 : 0) + (bHasM ? 2000 : 0));
+}
+
+static void AppendWKBPoint(std::vector<GByte>& abyWKB,
+                           const double* padfXYZM, int nDims)
+{
+    for( int i = 0; i < nDims; i++ )
+    {
+        double dfVal = padfXYZM[i];
+        CPL_LSBPTR64(&dfVal);
+        const GByte* pabyVal = reinterpret_cast<const GByte*>(&dfVal);
+        abyWKB.insert(abyWKB.end(), pabyVal, pabyVal + sizeof(dfVal));
+    }
+}
+
+/************************************************************************/
+/*                             GetAsWKB()                               */
+/************************************************************************/
+
+bool FileGDBOGRGeometryConverterImpl::GetAsWKB(const OGRField* psField,
+                                               std::vector<GByte>& abyWKB)
+{
+    // Decoding errors are reported, and result in a null geometry, as
+    // in GetAsGeometry().
+    const bool errorRetValue = true;
+    abyWKB.clear();
+
+    GByte* pabyCur = psField->Binary.paData;
+    GByte* pabyEnd = pabyCur + psField->Binary.nCount;
+    GUInt32 nGeomType = 0;
+    ReadVarUInt32NoCheck(pabyCur, nGeomType);
+
+    bool bHasZ = (nGeomType & EXT_SHAPE_Z_FLAG) != 0;
+    bool bHasM = (nGeomType & EXT_SHAPE_M_FLAG) != 0;
+    switch( (nGeomType & 0xff) )
+    {
+        case SHPT_NULL:
+            return true;
+
+        case SHPT_POINTZ:
+        case SHPT_POINTZM:
+            bHasZ = true; /* go on */
+            CPL_FALLTHROUGH
+        case SHPT_POINT:
+        case SHPT_POINTM:
+        case SHPT_GENERALPOINT:
+        {
+            if( nGeomType == SHPT_POINTM || nGeomType == SHPT_POINTZM )
+                bHasM = true;
+
+            GUIntBig x = 0;
+            GUIntBig y = 0;
+            ReadVarUInt64NoCheck(pabyCur, x);
+            ReadVarUInt64NoCheck(pabyCur, y);
+
+            double adfXYZM[4] = {
+                (x - 1) / poGeomField->GetXYScale() + poGeomField->GetXOrigin(),
+                (y - 1) / poGeomField->GetXYScale() + poGeomField->GetYOrigin(),
+                0.0, 0.0 };
+            int nDims = 2;
+            if( bHasZ )
+            {
+                GUIntBig z = 0;
+                ReadVarUInt64NoCheck(pabyCur, z);
+                const double dfZScale = SanitizeScale(poGeomField->GetZScale());
+                adfXYZM[nDims++] = (z - 1) / dfZScale + poGeomField->GetZOrigin();
+            }
+            if( bHasM )
+            {
+                GUIntBig m = 0;
+                ReadVarUInt64NoCheck(pabyCur, m);
+                const double dfMScale = SanitizeScale(poGeomField->GetMScale());
+                adfXYZM[nDims++] = (m - 1) / dfMScale + poGeomField->GetMOrigin();
+            }
+
+            AppendWKBHeader(abyWKB, wkbPoint, bHasZ, bHasM);
+            AppendWKBPoint(abyWKB, adfXYZM, nDims);
+            return true;
+        }
+
+        case SHPT_MULTIPOINTZM:
+        case SHPT_MULTIPOINTZ:
+            bHasZ = true; /* go on */
+            CPL_FALLTHROUGH
+        case SHPT_MULTIPOINT:
+        case SHPT_MULTIPOINTM:
+        {
+            if( nGeomType == SHPT_MULTIPOINTM || nGeomType == SHPT_MULTIPOINTZM )
+                bHasM = true;
+
+            GUInt32 nPoints = 0;
+            returnErrorIf(!ReadVarUInt32(pabyCur, pabyEnd, nPoints) );
+            if( nPoints == 0 )
+                return false;
+
+            returnErrorIf(!SkipVarUInt(pabyCur, pabyEnd, 4) );
+
+            // Each point is at least 2 bytes long.
+            returnErrorIf(nPoints > static_cast<GUInt32>(pabyEnd - pabyCur));
+            std::vector<double> adfX(nPoints);
+            std::vector<double> adfY(nPoints);
+            std::vector<double> adfZ(bHasZ ? nPoints : 0);
+            std::vector<double> adfM(bHasM ? nPoints : 0);
+
+            GIntBig dx = 0;
+            GIntBig dy = 0;
+            XYArraySetter xySetter(adfX.data(), adfY.data());
+            returnErrorIf(!ReadXYArray<XYArraySetter>(xySetter,
+                            pabyCur, pabyEnd, nPoints, dx, dy) );
+            if( bHasZ )
+            {
+                GIntBig dz = 0;
+                FileGDBArraySetter zSetter(adfZ.data());
+                returnErrorIf(!ReadZArray<FileGDBArraySetter>(zSetter,
+                                pabyCur, pabyEnd, nPoints, dz) );
+            }
+            // See GetAsGeometry() about the possible absence of M.
+            if( bHasM && pabyCur + nPoints <= pabyEnd )
+            {
+                GIntBig dm = 0;
+                FileGDBArraySetter mSetter(adfM.data());
+                returnErrorIf(!ReadMArray<FileGDBArraySetter>(mSetter,
+                                pabyCur, pabyEnd, nPoints, dm) );
+            }
+            else
+            {
+                bHasM = false;
+            }
+
+            AppendWKBHeader(abyWKB, wkbMultiPoint, bHasZ, bHasM);
+            AppendWKBUInt32(abyWKB, nPoints);
+            for( GUInt32 i = 0; i < nPoints; i++ )
+            {
+                double adfXYZM[4] = { adfX[i], adfY[i], 0.0, 0.0 };
+                int nDims = 2;
+                if( bHasZ )
+                    adfXYZM[nDims++] = adfZ[i];
+                if( bHasM )
+                    adfXYZM[nDims++] = adfM[i];
+                AppendWKBHeader(abyWKB, wkbPoint, bHasZ, bHasM);
+                AppendWKBPoint(abyWKB, adfXYZM, nDims);
+            }
+            return true;
+        }
+
+        case SHPT_ARCZ:
+        case SHPT_ARCZM:
+            bHasZ = true; /* go on */
+            CPL_FALLTHROUGH
+        case SHPT_ARC:
+        case SHPT_ARCM:
+        case SHPT_GENERALPOLYLINE:
+        {
+            if( nGeomType == SHPT_ARCM || nGeomType == SHPT_ARCZM )
+                bHasM = true;
+
+            GUInt32 nPoints = 0;
+            GUInt32 nParts = 0;
+            GUInt32 nCurves = 0;
+            returnErrorIf(!ReadPartDefs(pabyCur, pabyEnd, nPoints, nParts, nCurves,
+                              (nGeomType & EXT_SHAPE_CURVE_FLAG) != 0,
+                              false) );
+            if( nPoints == 0 || nParts == 0 || nCurves != 0 )
+                return false;
+
+            std::vector<double> adfX(nPoints);
+            std::vector<double> adfY(nPoints);
+            std::vector<double> adfZ(bHasZ ? nPoints : 0);
+            std::vector<double> adfM(bHasM ? nPoints : 0);
+
+            // Parts are stored one after the other, with the deltas of
+            // the coordinates running over the parts.
+            GIntBig dx = 0;
+            GIntBig dy = 0;
+            XYArraySetter xySetter(adfX.data(), adfY.data());
+            returnErrorIf(!ReadXYArray<XYArraySetter>(xySetter,
+                            pabyCur, pabyEnd, nPoints, dx, dy) );
+            if( bHasZ )
+            {
+                GIntBig dz = 0;
+                FileGDBArraySetter zSetter(adfZ.data());
+                returnErrorIf(!ReadZArray<FileGDBArraySetter>(zSetter,
+                                pabyCur, pabyEnd, nPoints, dz) );
+            }
+            if( bHasM )
+            {
+                // See GetAsGeometry() about the possible absence of M: the
+                // geometry is then not measured.
+                GIntBig dm = 0;
+                GUInt32 iPoint = 0;
+                for( GUInt32 i = 0; i < nParts; i++ )
+                {
+                    if( pabyCur + panPointCount[i] > pabyEnd )
+                    {
+                        bHasM = false;
+                        break;
+                    }
+                    FileGDBArraySetter mSetter(adfM.data() + iPoint);
+                    returnErrorIf(!ReadMArray<FileGDBArraySetter>(mSetter,
+                                    pabyCur, pabyEnd, panPointCount[i], dm) );
+                    iPoint += panPointCount[i];
+                }
+            }
+
+            // Always a MultiLineString, as returned by the OpenFileGDB
+            // layers.
+            AppendWKBHeader(abyWKB, wkbMultiLineString, bHasZ, bHasM);
+            AppendWKBUInt32(abyWKB, nParts);
+            GUInt32 iPoint = 0;
+            for( GUInt32 i = 0; i < nParts; i++ )
+            {
+                AppendWKBHeader(abyWKB, wkbLineString, bHasZ, bHasM);
+                AppendWKBUInt32(abyWKB, panPointCount[i]);
+                for( GUInt32 j = 0; j < panPointCount[i]; j++, iPoint++ )
+                {
+                    double adfXYZM[4] = { adfX[iPoint], adfY[iPoint], 0.0, 0.0 };
+                    int nDims = 2;
+                    if( bHasZ )
+                        adfXYZM[nDims++] = adfZ[iPoint];
+                    if( bHasM )
+                        adfXYZM[nDims++] = adfM[iPoint];
+                    AppendWKBPoint(abyWKB, adfXYZM, nDims);
+                }
+            }
+            return true;
+        }
+
+        default:
+            // Polygons, whose rings have to be organized, multipatches
+            return false;
+    }
+}
+
 /************************************************************************/
 /*                           BuildConverter()                           */
 /************************************************************************/
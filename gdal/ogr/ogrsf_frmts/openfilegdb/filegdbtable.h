@@ -384,6 +384,14 @@ class FileGDBOGRGeometryConverter
 
        virtual OGRGeometry*                GetAsGeometry(const OGRField* psField) = 0;
 
+       /* Translate the geometry to ISO WKB, without going through an
+          OGRGeometry. Polylines are returned as MultiLineString. Returns
+          false if the geometry cannot be translated this way (polygons,
+          curves, ...), in which case GetAsGeometry() should be used.
+          abyWKB is left empty for null geometries. */
+       virtual bool                        GetAsWKB(const OGRField* psField,
+                                                    std::vector<GByte>& abyWKB) = 0;
+
        static FileGDBOGRGeometryConverter* BuildConverter(const FileGDBGeomField* poGeomField);
        static OGRwkbGeometryType           GetGeometryTypeFromESRI(const char* pszESRIGeometryType);
 };
@@ -75,8 +75,11 @@ class OGROpenFileGDBLayer final: public OGRLayer
     int               BuildLayerDefinition();
     int               BuildGeometryColumnGDBv10();
     OGRFeature       *GetCurrentFeature();
+    OGRGeometry      *GetGeometry(const OGRField* psField);
+    bool              AddCurrentFeatureToBatch(OGRFeatureBatch* poBatch);
 
     FileGDBOGRGeometryConverter* m_poGeomConverter;
+    std::vector<GByte> m_abyBatchWKB{};
 
     int               m_iFieldToReadAsBinary;
 
@@ -128,6 +131,8 @@ public:
 
   virtual void        ResetReading() override;
   virtual OGRFeature* GetNextFeature() override;
+  virtual int         GetNextFeatureBatch( OGRFeatureBatch* poBatch,
+                                           int nMaxRows ) override;
   virtual OGRFeature* GetFeature( GIntBig nFeatureId ) override;
   virtual OGRErr      SetNextByIndex( GIntBig nIndex ) override;
 
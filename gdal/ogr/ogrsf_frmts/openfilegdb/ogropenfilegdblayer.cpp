@@ -1458,6 +1458,39 @@ OGRErr OGROpenFileGDBLayer::SetAttributeFilter( const char* pszFilter )
     return eErr;
 }
 
+/***********************************************************************/
+/*                            GetGeometry()                            */
+/***********************************************************************/
+
+OGRGeometry* OGROpenFileGDBLayer::GetGeometry(const OGRField* psField)
+{
+    OGRGeometry* poGeom = m_poGeomConverter->GetAsGeometry(psField);
+    if( poGeom != nullptr )
+    {
+        OGRwkbGeometryType eFlattenType = wkbFlatten(poGeom->getGeometryType());
+        if( eFlattenType == wkbPolygon )
+            poGeom = OGRGeometryFactory::forceToMultiPolygon(poGeom);
+        else if( eFlattenType == wkbCurvePolygon)
+        {
+            OGRMultiSurface* poMS = new OGRMultiSurface();
+            poMS->addGeometryDirectly( poGeom );
+            poGeom = poMS;
+        }
+        else if( eFlattenType == wkbLineString )
+            poGeom = OGRGeometryFactory::forceToMultiLineString(poGeom);
+        else if (eFlattenType == wkbCompoundCurve)
+        {
+            OGRMultiCurve* poMC = new OGRMultiCurve();
+            poMC->addGeometryDirectly( poGeom );
+            poGeom = poMC;
+        }
+
+        poGeom->assignSpatialReference(
+            m_poFeatureDefn->GetGeomFieldDefn(0)->GetSpatialRef() );
+    }
+    return poGeom;
+}
+
 /***********************************************************************/
 /*                         GetCurrentFeature()                         */
 /***********************************************************************/
@@ -1506,30 +1539,9 @@ OGRFeature* OGROpenFileGDBLayer::GetCurrentFeature()
                     return nullptr;
                 }
 
-                OGRGeometry* poGeom = m_poGeomConverter->GetAsGeometry(psField);
+                OGRGeometry* poGeom = GetGeometry(psField);
                 if( poGeom != nullptr )
                 {
-                    OGRwkbGeometryType eFlattenType = wkbFlatten(poGeom->getGeometryType());
-                    if( eFlattenType == wkbPolygon )
-                        poGeom = OGRGeometryFactory::forceToMultiPolygon(poGeom);
-                    else if( eFlattenType == wkbCurvePolygon)
-                    {
-                        OGRMultiSurface* poMS = new OGRMultiSurface();
-                        poMS->addGeometryDirectly( poGeom );
-                        poGeom = poMS;
-                    }
-                    else if( eFlattenType == wkbLineString )
-                        poGeom = OGRGeometryFactory::forceToMultiLineString(poGeom);
-                    else if (eFlattenType == wkbCompoundCurve)
-                    {
-                        OGRMultiCurve* poMC = new OGRMultiCurve();
-                        poMC->addGeometryDirectly( poGeom );
-                        poGeom = poMC;
-                    }
-
-                    poGeom->assignSpatialReference(
-                        m_poFeatureDefn->GetGeomFieldDefn(0)->GetSpatialRef() );
-
                     if( poFeature == nullptr )
                         poFeature = new OGRFeature(m_poFeatureDefn);
                     poFeature->SetGeometryDirectly( poGeom );
@@ -1671,6 +1683,150 @@ OGRFeature* OGROpenFileGDBLayer::GetNextFeature()
     }
 }
 
+/***********************************************************************/
+/*                      AddCurrentFeatureToBatch()                     */
+/***********************************************************************/
+
+bool OGROpenFileGDBLayer::AddCurrentFeatureToBatch(OGRFeatureBatch* poBatch)
+{
+    int iOGRIdx = 0;
+    const int iRow = m_poLyrTable->GetCurRow();
+    if( poBatch->AddRow(iRow + 1) < 0 )
+        return false;
+    for(int iGDBIdx=0;iGDBIdx<m_poLyrTable->GetFieldCount();iGDBIdx++)
+    {
+        if( iGDBIdx == m_iGeomFieldIdx )
+        {
+            if( m_poFeatureDefn->GetGeomFieldDefn(0)->IsIgnored() )
+            {
+                if( m_eSpatialIndexState == SPI_IN_BUILDING )
+                    m_eSpatialIndexState = SPI_INVALID;
+                continue;
+            }
+
+            const OGRField* psField = m_poLyrTable->GetFieldValue(iGDBIdx);
+            if( psField != nullptr )
+            {
+                if( m_eSpatialIndexState == SPI_IN_BUILDING )
+                {
+                    OGREnvelope sFeatureEnvelope;
+                    if( m_poLyrTable->GetFeatureExtent(psField,
+                                                       &sFeatureEnvelope) )
+                    {
+                        CPLRectObj sBounds;
+                        sBounds.minx = sFeatureEnvelope.MinX;
+                        sBounds.miny = sFeatureEnvelope.MinY;
+                        sBounds.maxx = sFeatureEnvelope.MaxX;
+                        sBounds.maxy = sFeatureEnvelope.MaxY;
+                        CPLQuadTreeInsertWithBounds(m_pQuadTree,
+                                                    (void*)(size_t)iRow,
+                                                    &sBounds);
+                    }
+                }
+
+                if( m_poGeomConverter->GetAsWKB(psField, m_abyBatchWKB) )
+                {
+                    if( !m_abyBatchWKB.empty() &&
+                        !poBatch->SetGeometryWKB(0, m_abyBatchWKB.data(),
+                                                 m_abyBatchWKB.size()) )
+                    {
+                        return false;
+                    }
+                }
+                else
+                {
+                    OGRGeometry* poGeom = GetGeometry(psField);
+                    const bool bOK = poBatch->SetGeometry(0, poGeom);
+                    delete poGeom;
+                    if( !bOK )
+                        return false;
+                }
+            }
+        }
+        else
+        {
+            if( !m_poFeatureDefn->GetFieldDefn(iOGRIdx)->IsIgnored() )
+            {
+                const OGRField* psField = m_poLyrTable->GetFieldValue(iGDBIdx);
+                bool bOK = true;
+                if( psField == nullptr )
+                {
+                    // Left unset, which is read back as null.
+                }
+                else if( iGDBIdx == m_iFieldToReadAsBinary )
+                {
+                    bOK = poBatch->SetFieldString(iOGRIdx,
+                                    (const char*) psField->Binary.paData);
+                }
+                else
+                {
+                    bOK = poBatch->SetField(iOGRIdx, psField);
+                }
+                if( !bOK )
+                    return false;
+            }
+            iOGRIdx ++;
+        }
+    }
+
+    if( m_poLyrTable->HasDeletedFeaturesListed() )
+    {
+        poBatch->SetFieldInteger(m_poFeatureDefn->GetFieldCount() - 1,
+                                 m_poLyrTable->IsCurRowDeleted());
+    }
+    return true;
+}
+
+/***********************************************************************/
+/*                        GetNextFeatureBatch()                        */
+/***********************************************************************/
+
+int OGROpenFileGDBLayer::GetNextFeatureBatch( OGRFeatureBatch* poBatch,
+                                              int nMaxRows )
+{
+    if( !BuildLayerDefinition() )
+        return -1;
+
+    // Filters are evaluated on OGRFeature objects.
+    if( m_nFilteredFeatureCount >= 0 || m_poIterator != nullptr ||
+        m_poFilterGeom != nullptr || m_poAttrQuery != nullptr ||
+        poBatch->GetDefnRef() != m_poFeatureDefn )
+    {
+        return OGRLayer::GetNextFeatureBatch(poBatch, nMaxRows);
+    }
+
+    poBatch->Reset();
+    if( m_bEOF )
+        return 0;
+
+    while( poBatch->GetLength() < nMaxRows &&
+           m_iCurFeat < m_poLyrTable->GetTotalRecordCount() )
+    {
+        m_iCurFeat = m_poLyrTable->GetAndSelectNextNonEmptyRow(m_iCurFeat);
+        if( m_iCurFeat < 0 )
+        {
+            m_bEOF = TRUE;
+            if( m_poLyrTable->HasGotError() )
+                return -1;
+            break;
+        }
+        m_iCurFeat ++;
+        if( !AddCurrentFeatureToBatch(poBatch) ||
+            m_poLyrTable->HasGotError() )
+        {
+            return -1;
+        }
+        if( m_eSpatialIndexState == SPI_IN_BUILDING &&
+            m_iCurFeat == m_poLyrTable->GetTotalRecordCount() )
+        {
+            CPLDebug("OpenFileGDB", "SPI_COMPLETED");
+            m_eSpatialIndexState = SPI_COMPLETED;
+        }
+    }
+
+    return poBatch->GetLength();
+}
+
 /***********************************************************************/
 /*                          GetFeature()                               */
 /***********************************************************************/
@@ -1902,6 +2058,10 @@ int OGROpenFileGDBLayer::TestCapability( const char * pszCap )
     {
         return TRUE; /* ? */
     }
+    else if( EQUAL(pszCap,OLCFastGetNextFeatureBatch) )
+    {
+        return m_poFilterGeom == nullptr && m_poAttrQuery == nullptr;
+    }
 
     return FALSE;
 }
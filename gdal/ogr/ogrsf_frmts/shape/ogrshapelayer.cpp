@@ -895,6 +895,52 @@ OGRFeature *OGRShapeLayer::GetNextFeature()
     }
 }
 
+/************************************************************************/
+/*                        GetNextFeatureBatch()                         */
+/************************************************************************/
+
+int OGRShapeLayer::GetNextFeatureBatch( OGRFeatureBatch* poBatch,
+                                        int nMaxRows )
+
+{
+    if( !TouchLayer() )
+        return -1;
+
+    // Filters are evaluated on OGRFeature objects.
+    if( m_poAttrQuery != nullptr || m_poFilterGeom != nullptr ||
+        panMatchingFIDs != nullptr || poBatch->GetDefnRef() != poFeatureDefn )
+    {
+        return OGRLayer::GetNextFeatureBatch(poBatch, nMaxRows);
+    }
+
+    poBatch->Reset();
+    while( poBatch->GetLength() < nMaxRows &&
+           iNextShapeId < nTotalShapeCount )
+    {
+        if( hDBF )
+        {
+            if( DBFIsRecordDeleted( hDBF, iNextShapeId ) )
+            {
+                iNextShapeId++;
+                continue;
+            }
+            if( VSIFEofL(VSI_SHP_GetVSIL(hDBF->fp)) )
+                break;  //* I/O error.
+        }
+
+        const OGRErr eErr =
+            SHPReadOGRFeatureToBatch( hSHP, hDBF, poFeatureDefn,
+                                      iNextShapeId, osEncoding, poBatch );
+        iNextShapeId++;
+        if( eErr == OGRERR_NONE )
+            m_nFeaturesRead++;
+        else if( eErr != OGRERR_NON_EXISTING_FEATURE )
+            return -1;
+    }
+
+    return poBatch->GetLength();
+}
+
 /************************************************************************/
 /*                             GetFeature()                             */
 /************************************************************************/
@@ -1612,6 +1658,9 @@ int OGRShapeLayer::TestCapability( const char * pszCap )
     if( EQUAL(pszCap,OLCFastSetNextByIndex) )
         return m_poFilterGeom == nullptr && m_poAttrQuery == nullptr;
 
+    if( EQUAL(pszCap,OLCFastGetNextFeatureBatch) )
+        return m_poFilterGeom == nullptr && m_poAttrQuery == nullptr;
+
     if( EQUAL(pszCap,OLCCreateField) )
         return bUpdateAccess;
 
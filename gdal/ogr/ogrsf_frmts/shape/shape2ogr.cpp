@@ -31,6 +31,8 @@
 #include "cpl_port.h"
 #include "ogrshape.h"
 
+#include <cerrno>
+#include <climits>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
@@ -38,6 +40,7 @@
 #include <algorithm>
 #include <limits>
 #include <memory>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -1136,6 +1139,118 @@ OGRFeatureDefn *SHPReadOGRFeatureDefn( const char * pszName,
     return poDefn;
 }
 
+/************************************************************************/
+/*                      SHPReadOGRObjectForDefn()                       */
+/*                                                                      */
+/*      Read a shape as an OGRGeometry, and set its Z/M flags from      */
+/*      the geometry type of the layer.                                 */
+/************************************************************************/
+
+static OGRGeometry *SHPReadOGRObjectForDefn( SHPHandle hSHP,
+                                             OGRFeatureDefn * poDefn,
+                                             int iShape, SHPObject *psShape )
+{
+    OGRGeometry* poGeometry = SHPReadOGRObject( hSHP, iShape, psShape );
+
+    // Two possibilities are expected here (both are tested by
+    // GDAL Autotests):
+    //   1. Read valid geometry and assign it directly.
+    //   2. Read and assign null geometry if it can not be read
+    //      correctly from a shapefile.
+    //
+    // It is NOT required here to test poGeometry == NULL.
+
+    if( poGeometry )
+    {
+        // Set/unset flags.
+        const OGRwkbGeometryType eMyGeomType =
+            poDefn->GetGeomFieldDefn(0)->GetType();
+
+        if( eMyGeomType != wkbUnknown )
+        {
+            OGRwkbGeometryType eGeomInType =
+                poGeometry->getGeometryType();
+            if( wkbHasZ(eMyGeomType) && !wkbHasZ(eGeomInType) )
+            {
+                poGeometry->set3D(TRUE);
+            }
+            else if( !wkbHasZ(eMyGeomType) && wkbHasZ(eGeomInType) )
+            {
+                poGeometry->set3D(FALSE);
+            }
+            if( wkbHasM(eMyGeomType) && !wkbHasM(eGeomInType) )
+            {
+                poGeometry->setMeasured(TRUE);
+            }
+            else if( !wkbHasM(eMyGeomType) && wkbHasM(eGeomInType) )
+            {
+                poGeometry->setMeasured(FALSE);
+            }
+        }
+    }
+
+    return poGeometry;
+}
+
+/************************************************************************/
+/*                         SHPReadOGRDate()                             */
+/************************************************************************/
+
+static void SHPReadOGRDate( const char* pszDateValue, OGRField* psFld )
+{
+    memset( psFld, 0, sizeof(*psFld) );
+
+    if( strlen(pszDateValue) >= 10 &&
+        pszDateValue[2] == '/' && pszDateValue[5] == '/' )
+    {
+        psFld->Date.Month = static_cast<GByte>(atoi(pszDateValue + 0));
+        psFld->Date.Day   = static_cast<GByte>(atoi(pszDateValue + 3));
+        psFld->Date.Year  = static_cast<GInt16>(atoi(pszDateValue + 6));
+    }
+    else
+    {
+        const int nFullDate = atoi(pszDateValue);
+        psFld->Date.Year = static_cast<GInt16>(nFullDate / 10000);
+        psFld->Date.Month = static_cast<GByte>((nFullDate / 100) % 100);
+        psFld->Date.Day = static_cast<GByte>(nFullDate % 100);
+    }
+}
+
+/************************************************************************/
+/*                     SHPReadOGRIntegerAttribute()                     */
+/*                                                                      */
+/*      Read the value of an OFTInteger field. Values that do not fit   */
+/*      in an int are clamped, with a warning, as OGRFeature::SetField()*/
+/*      does for strings.                                               */
+/************************************************************************/
+
+static int SHPReadOGRIntegerAttribute( DBFHandle hDBF, int iShape, int iField,
+                                       const OGRFeatureDefn* poDefn )
+{
+    const char* const pszValue = DBFReadStringAttribute( hDBF, iShape, iField );
+
+    // As allowed by C standard, some systems like MSVC do not reset errno.
+    errno = 0;
+
+    char *pszLast = nullptr;
+    const long nVal = strtol(pszValue, &pszLast, 10);
+    const int nClampedVal =
+        nVal > INT_MAX ? INT_MAX :
+        nVal < INT_MIN ? INT_MIN : static_cast<int>(nVal);
+    if( (errno == ERANGE || nVal != static_cast<long>(nClampedVal) ||
+         *pszLast != '\0') &&
+        CPLTestBool( CPLGetConfigOption( "OGR_SETFIELD_NUMERIC_WARNING",
+                                         "YES" ) ) )
+    {
+        CPLError(
+            CE_Warning, CPLE_AppDefined,
+            "Value '%s' of field %s.%s parsed incompletely to integer %d.",
+            pszValue, poDefn->GetName(),
+            poDefn->GetFieldDefn(iField)->GetNameRef(), nClampedVal );
+    }
+    return nClampedVal;
+}
+
 /************************************************************************/
 /*                         SHPReadOGRFeature()                          */
 /************************************************************************/
@@ -1175,47 +1290,8 @@ OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
     {
         if( !poDefn->IsGeometryIgnored() )
         {
-            OGRGeometry* poGeometry =
-                SHPReadOGRObject( hSHP, iShape, psShape );
-
-            // Two possibilities are expected here (both are tested by
-            // GDAL Autotests):
-            //   1. Read valid geometry and assign it directly.
-            //   2. Read and assign null geometry if it can not be read
-            //      correctly from a shapefile.
-            //
-            // It is NOT required here to test poGeometry == NULL.
-
-            if( poGeometry )
-            {
-                // Set/unset flags.
-                const OGRwkbGeometryType eMyGeomType =
-                    poFeature->GetDefnRef()->GetGeomFieldDefn(0)->GetType();
-
-                if( eMyGeomType != wkbUnknown )
-                {
-                    OGRwkbGeometryType eGeomInType =
-                        poGeometry->getGeometryType();
-                    if( wkbHasZ(eMyGeomType) && !wkbHasZ(eGeomInType) )
-                    {
-                        poGeometry->set3D(TRUE);
-                    }
-                    else if( !wkbHasZ(eMyGeomType) && wkbHasZ(eGeomInType) )
-                    {
-                        poGeometry->set3D(FALSE);
-                    }
-                    if( wkbHasM(eMyGeomType) && !wkbHasM(eGeomInType) )
-                    {
-                        poGeometry->setMeasured(TRUE);
-                    }
-                    else if( !wkbHasM(eMyGeomType) && wkbHasM(eGeomInType) )
-                    {
-                        poGeometry->setMeasured(FALSE);
-                    }
-                }
-            }
-
-            poFeature->SetGeometryDirectly( poGeometry );
+            poFeature->SetGeometryDirectly(
+                SHPReadOGRObjectForDefn( hSHP, poDefn, iShape, psShape ) );
         }
         else if( psShape != nullptr )
         {
@@ -1260,6 +1336,20 @@ OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
               break;
           }
           case OFTInteger:
+          {
+              if( DBFIsAttributeNULL( hDBF, iShape, iField ) )
+              {
+                  poFeature->SetFieldNull(iField);
+              }
+              else
+              {
+                  poFeature->SetField(
+                      iField,
+                      SHPReadOGRIntegerAttribute( hDBF, iShape, iField,
+                                                  poDefn ) );
+              }
+              break;
+          }
           case OFTInteger64:
           case OFTReal:
           {
@@ -1293,36 +1383,347 @@ OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
                   continue;
 
               OGRField sFld;
-              memset( &sFld, 0, sizeof(sFld) );
+              SHPReadOGRDate( pszDateValue, &sFld );
+              poFeature->SetField( iField, &sFld );
+          }
+          break;
+
+          default:
+            CPLAssert( false );
+        }
+    }
 
-              if( strlen(pszDateValue) >= 10 &&
-                  pszDateValue[2] == '/' && pszDateValue[5] == '/' )
+    if( poFeature != nullptr )
+        poFeature->SetFID( iShape );
+
+    return poFeature;
+}
+
+/************************************************************************/
+/*                         SHPAppendWKBUInt32()                         */
+/************************************************************************/
+
+static void SHPAppendWKBUInt32( std::vector<GByte>& abyWKB, GUInt32 nVal )
+{
+    CPL_LSBPTR32(&nVal);
+    const GByte* pabyVal = reinterpret_cast<const GByte*>(&nVal);
+    abyWKB.insert(abyWKB.end(), pabyVal, pabyVal + sizeof(nVal));
+}
+
+/************************************************************************/
+/*                        SHPAppendWKBHeader()                          */
+/************************************************************************/
+
+static void SHPAppendWKBHeader( std::vector<GByte>& abyWKB,
+                                OGRwkbGeometryType eFlatType,
+                                bool bHasZ, bool bHasM )
+{
+    abyWKB.push_back(static_cast<GByte>(wkbNDR));
+    // ISO WKB geometry type.
+    SHPAppendWKBUInt32(abyWKB, static_cast<GUInt32>(eFlatType) +
+                               (bHasZ ? 1000 : 0) + (bHasM ? 2000 : 0));
+}
+
+/************************************************************************/
+/*                        SHPAppendWKBPoints()                          */
+/************************************************************************/
+
+static void SHPAppendWKBPoints( std::vector<GByte>& abyWKB,
+                                const SHPObject *psShape,
+                                int nStart, int nCount,
+                                bool bHasZ, bool bHasM )
+{
+    for( int i = nStart; i < nStart + nCount; i++ )
+    {
+        double adfXYZM[4] = { psShape->padfX[i], psShape->padfY[i], 0, 0 };
+        int nDims = 2;
+        if( bHasZ )
+            adfXYZM[nDims++] = psShape->padfZ ? psShape->padfZ[i] : 0.0;
+        if( bHasM )
+            adfXYZM[nDims++] = psShape->padfM ? psShape->padfM[i] : 0.0;
+        for( int j = 0; j < nDims; j++ )
+            CPL_LSBPTR64(&adfXYZM[j]);
+        const GByte* pabyXYZM = reinterpret_cast<const GByte*>(adfXYZM);
+        abyWKB.insert(abyWKB.end(), pabyXYZM,
+                      pabyXYZM + nDims * sizeof(double));
+    }
+}
+
+/************************************************************************/
+/*                         SHPReadOGRObjectWKB()                        */
+/*                                                                      */
+/*      Translate a shape to ISO WKB, as SHPReadOGRObjectForDefn()      */
+/*      would do, without going through an OGRGeometry. Returns false   */
+/*      for polygons with several rings, whose organization into        */
+/*      polygons requires OGRGeometry objects, and multipatches.        */
+/*      abyWKB is left empty for null geometries.                       */
+/************************************************************************/
+
+static bool SHPReadOGRObjectWKB( const SHPObject *psShape,
+                                 OGRwkbGeometryType eLayerGeomType,
+                                 std::vector<GByte>& abyWKB )
+{
+    abyWKB.clear();
+
+    bool bHasZ = false;
+    bool bHasM = false;
+    switch( psShape->nSHPType )
+    {
+        case SHPT_NULL:
+            return true;
+        case SHPT_POINT:
+        case SHPT_MULTIPOINT:
+        case SHPT_ARC:
+        case SHPT_POLYGON:
+            break;
+        case SHPT_POINTZ:
+            bHasZ = true;
+            bHasM = CPL_TO_BOOL(psShape->bMeasureIsUsed);
+            break;
+        case SHPT_POINTM:
+            bHasM = true;
+            break;
+        case SHPT_MULTIPOINTZ:
+            bHasZ = true;
+            bHasM = psShape->padfM != nullptr;
+            break;
+        case SHPT_ARCZ:
+        case SHPT_POLYGONZ:
+            bHasZ = psShape->padfZ != nullptr;
+            bHasM = psShape->padfM != nullptr;
+            break;
+        case SHPT_MULTIPOINTM:
+        case SHPT_ARCM:
+        case SHPT_POLYGONM:
+            bHasM = psShape->padfM != nullptr;
+            break;
+        default:
+            return false;
+    }
+    if( eLayerGeomType != wkbUnknown )
+    {
+        bHasZ = CPL_TO_BOOL(wkbHasZ(eLayerGeomType));
+        bHasM = CPL_TO_BOOL(wkbHasM(eLayerGeomType));
+    }
+
+    switch( psShape->nSHPType )
+    {
+        case SHPT_POINT:
+        case SHPT_POINTZ:
+        case SHPT_POINTM:
+            SHPAppendWKBHeader(abyWKB, wkbPoint, bHasZ, bHasM);
+            SHPAppendWKBPoints(abyWKB, psShape, 0, 1, bHasZ, bHasM);
+            return true;
+
+        case SHPT_MULTIPOINT:
+        case SHPT_MULTIPOINTZ:
+        case SHPT_MULTIPOINTM:
+            if( psShape->nVertices == 0 )
+                return true;
+            SHPAppendWKBHeader(abyWKB, wkbMultiPoint, bHasZ, bHasM);
+            SHPAppendWKBUInt32(abyWKB, psShape->nVertices);
+            for( int i = 0; i < psShape->nVertices; i++ )
+            {
+                SHPAppendWKBHeader(abyWKB, wkbPoint, bHasZ, bHasM);
+                SHPAppendWKBPoints(abyWKB, psShape, i, 1, bHasZ, bHasM);
+            }
+            return true;
+
+        case SHPT_ARC:
+        case SHPT_ARCZ:
+        case SHPT_ARCM:
+            if( psShape->nParts == 0 )
+                return true;
+            if( psShape->nParts == 1 )
+            {
+                SHPAppendWKBHeader(abyWKB, wkbLineString, bHasZ, bHasM);
+                SHPAppendWKBUInt32(abyWKB, psShape->nVertices);
+                SHPAppendWKBPoints(abyWKB, psShape, 0, psShape->nVertices,
+                                   bHasZ, bHasM);
+                return true;
+            }
+            SHPAppendWKBHeader(abyWKB, wkbMultiLineString, bHasZ, bHasM);
+            SHPAppendWKBUInt32(abyWKB, psShape->nParts);
+            for( int iPart = 0; iPart < psShape->nParts; iPart++ )
+            {
+                int nStart = 0;
+                int nEnd = 0;
+                RingStartEnd( const_cast<SHPObject*>(psShape), iPart,
+                              &nStart, &nEnd );
+                const int nPoints = std::max(0, nEnd - nStart + 1);
+                SHPAppendWKBHeader(abyWKB, wkbLineString, bHasZ, bHasM);
+                SHPAppendWKBUInt32(abyWKB, nPoints);
+                SHPAppendWKBPoints(abyWKB, psShape, nStart, nPoints,
+                                   bHasZ, bHasM);
+            }
+            return true;
+
+        default:  // Polygons
+        {
+            if( psShape->nParts == 0 )
+                return true;
+            if( psShape->nParts > 1 )
+                return false;
+            int nStart = 0;
+            int nEnd = 0;
+            RingStartEnd( const_cast<SHPObject*>(psShape), 0,
+                          &nStart, &nEnd );
+            const int nPoints = std::max(0, nEnd - nStart + 1);
+            SHPAppendWKBHeader(abyWKB, wkbPolygon, bHasZ, bHasM);
+            SHPAppendWKBUInt32(abyWKB, 1);
+            SHPAppendWKBUInt32(abyWKB, nPoints);
+            SHPAppendWKBPoints(abyWKB, psShape, nStart, nPoints,
+                               bHasZ, bHasM);
+            return true;
+        }
+    }
+}
+
+/************************************************************************/
+/*                      SHPReadOGRFeatureToBatch()                      */
+/*                                                                      */
+/*      Same as SHPReadOGRFeature(), but appends the shape and its      */
+/*      attributes to a batch. Returns OGRERR_NON_EXISTING_FEATURE if   */
+/*      the shape is out of range, in which case nothing is appended,   */
+/*      and OGRERR_FAILURE if it could not be stored in the batch.      */
+/************************************************************************/
+
+OGRErr SHPReadOGRFeatureToBatch( SHPHandle hSHP, DBFHandle hDBF,
+                                 OGRFeatureDefn * poDefn, int iShape,
+                                 const char *pszSHPEncoding,
+                                 OGRFeatureBatch* poBatch )
+
+{
+    if( iShape < 0
+        || (hSHP != nullptr && iShape >= hSHP->nRecords)
+        || (hDBF != nullptr && iShape >= hDBF->nRecords) )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "Attempt to read shape with feature id (%d) out of available"
+                  " range.", iShape );
+        return OGRERR_NON_EXISTING_FEATURE;
+    }
+
+    if( poBatch->AddRow( iShape ) < 0 )
+        return OGRERR_FAILURE;
+
+    if( hSHP != nullptr && !poDefn->IsGeometryIgnored() )
+    {
+        SHPObject *psShape = SHPReadObject( hSHP, iShape );
+        if( psShape != nullptr )
+        {
+            std::vector<GByte> abyWKB;
+            if( SHPReadOGRObjectWKB( psShape,
+                                     poDefn->GetGeomFieldDefn(0)->GetType(),
+                                     abyWKB ) )
+            {
+                SHPDestroyObject( psShape );
+                if( !abyWKB.empty() &&
+                    !poBatch->SetGeometryWKB( 0, abyWKB.data(),
+                                              abyWKB.size() ) )
+                {
+                    return OGRERR_FAILURE;
+                }
+            }
+            else
+            {
+                OGRGeometry* poGeometry =
+                    SHPReadOGRObjectForDefn( hSHP, poDefn, iShape, psShape );
+                const bool bOK = poBatch->SetGeometry( 0, poGeometry );
+                delete poGeometry;
+                if( !bOK )
+                    return OGRERR_FAILURE;
+            }
+        }
+    }
+
+    for( int iField = 0;
+         hDBF != nullptr && iField < poDefn->GetFieldCount();
+         iField++ )
+    {
+        const OGRFieldDefn * const poFieldDefn = poDefn->GetFieldDefn(iField);
+        if( poFieldDefn->IsIgnored() )
+            continue;
+
+        bool bOK = true;
+        switch( poFieldDefn->GetType() )
+        {
+          case OFTString:
+          {
+              const char * const pszFieldVal =
+                  DBFReadStringAttribute( hDBF, iShape, iField );
+              if( pszFieldVal != nullptr && pszFieldVal[0] != '\0' )
               {
-                  sFld.Date.Month = static_cast<GByte>(atoi(pszDateValue + 0));
-                  sFld.Date.Day   = static_cast<GByte>(atoi(pszDateValue + 3));
-                  sFld.Date.Year  = static_cast<GInt16>(atoi(pszDateValue + 6));
+                if( pszSHPEncoding[0] != '\0' )
+                {
+                    char * const pszUTF8Field =
+                        CPLRecode( pszFieldVal, pszSHPEncoding, CPL_ENC_UTF8);
+                    bOK = poBatch->SetFieldString( iField, pszUTF8Field );
+                    CPLFree( pszUTF8Field );
+                }
+                else
+                    bOK = poBatch->SetFieldString( iField, pszFieldVal );
               }
-              else
+              break;
+          }
+          case OFTInteger:
+          {
+              if( !DBFIsAttributeNULL( hDBF, iShape, iField ) )
               {
-                  const int nFullDate = atoi(pszDateValue);
-                  sFld.Date.Year = static_cast<GInt16>(nFullDate / 10000);
-                  sFld.Date.Month = static_cast<GByte>((nFullDate / 100) % 100);
-                  sFld.Date.Day = static_cast<GByte>(nFullDate % 100);
+                  poBatch->SetFieldInteger(
+                      iField, SHPReadOGRIntegerAttribute( hDBF, iShape, iField,
+                                                          poDefn ) );
               }
+              break;
+          }
+          case OFTInteger64:
+          {
+              // Not read as a double, which could lose precision.
+              if( !DBFIsAttributeNULL( hDBF, iShape, iField ) )
+              {
+                  poBatch->SetFieldInteger64(
+                      iField, CPLAtoGIntBig(
+                          DBFReadStringAttribute( hDBF, iShape, iField ) ) );
+              }
+              break;
+          }
+          case OFTReal:
+          {
+              if( !DBFIsAttributeNULL( hDBF, iShape, iField ) )
+              {
+                  poBatch->SetFieldDouble(
+                      iField, DBFReadDoubleAttribute( hDBF, iShape, iField ) );
+              }
+              break;
+          }
+          case OFTDate:
+          {
+              if( DBFIsAttributeNULL( hDBF, iShape, iField ) )
+                  continue;
 
-              poFeature->SetField( iField, &sFld );
+              const char* const pszDateValue =
+                  DBFReadStringAttribute(hDBF,iShape,iField);
+
+              // Some DBF files have fields filled with spaces
+              // (trimmed by DBFReadStringAttribute) to indicate null
+              // values for dates (#4265).
+              if( pszDateValue[0] == '\0' )
+                  continue;
+
+              OGRField sFld;
+              SHPReadOGRDate( pszDateValue, &sFld );
+              poBatch->SetField( iField, &sFld );
           }
           break;
 
           default:
             CPLAssert( false );
         }
+        if( !bOK )
+            return OGRERR_FAILURE;
     }
 
-    if( poFeature != nullptr )
-        poFeature->SetFID( iShape );
-
-    return poFeature;
+    return OGRERR_NONE;
 }
 
 /************************************************************************/
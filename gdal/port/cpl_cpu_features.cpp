@@ -40,6 +40,8 @@ CPL_CVSID("$Id$")
 
 #define CPUID_SSE_EDX_BIT       25
 
+#define CPUID_AVX2_EBX_BIT      5
+
 #define BIT_XMM_STATE           (1 << 1)
 #define BIT_YMM_STATE           (2 << 1)
 
@@ -67,10 +69,29 @@ CPL_CVSID("$Id$")
 
 #define CPL_CPUID(level, array) GCC_CPUID(level, array[0], array[1], array[2], array[3])
 
+#if defined(__x86_64)
+#define GCC_CPUIDEX(level, subleaf, a, b, c, d) \
+  __asm__ ("xchgq %%rbx, %q1\n"                 \
+           "cpuid\n"                            \
+           "xchgq %%rbx, %q1"                   \
+       : "=a" (a), "=r" (b), "=c" (c), "=d" (d) \
+       : "0" (level), "2" (subleaf))
+#else
+#define GCC_CPUIDEX(level, subleaf, a, b, c, d) \
+  __asm__ ("xchgl %%ebx, %1\n"                  \
+           "cpuid\n"                            \
+           "xchgl %%ebx, %1"                    \
+       : "=a" (a), "=r" (b), "=c" (c), "=d" (d) \
+       : "0" (level), "2" (subleaf))
+#endif
+
+#define CPL_CPUIDEX(level, subleaf, array) GCC_CPUIDEX(level, subleaf, array[0], array[1], array[2], array[3])
+
 #elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
 
 #include <intrin.h>
 #define CPL_CPUID(level, array) __cpuid(array, level)
+#define CPL_CPUIDEX(level, subleaf, array) __cpuidex(array, level, subleaf)
 
 #endif
 
@@ -209,4 +230,107 @@ bool CPLHaveRuntimeAVX()
 
 #endif // defined(HAVE_AVX_AT_COMPILE_TIME) && !defined(CPLHaveRuntimeAVX)
 
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) && !defined(HAVE_INLINE_AVX2)
+
+/************************************************************************/
+/*                         CPLHaveRuntimeAVX2()                         */
+/************************************************************************/
+
+#if defined(__GNUC__)
+
+static bool CPLDetectRuntimeAVX2()
+{
+    int cpuinfo[4] = { 0, 0, 0, 0 };
+    CPL_CPUID(0, cpuinfo);
+    if( cpuinfo[REG_EAX] < 7 )
+    {
+        return false;
+    }
+
+    CPL_CPUID(1, cpuinfo);
+
+    // Check OSXSAVE feature.
+    if( (cpuinfo[REG_ECX] & (1 << CPUID_OSXSAVE_ECX_BIT)) == 0 )
+    {
+        return false;
+    }
+
+    // Check AVX feature.
+    if( (cpuinfo[REG_ECX] & (1 << CPUID_AVX_ECX_BIT)) == 0 )
+    {
+        return false;
+    }
+
+    // Issue XGETBV and check the XMM and YMM state bit.
+    unsigned int nXCRLow;
+    unsigned int nXCRHigh;
+    __asm__ ("xgetbv" : "=a" (nXCRLow), "=d" (nXCRHigh) : "c" (0));
+    if( (nXCRLow & ( BIT_XMM_STATE | BIT_YMM_STATE )) !=
+                ( BIT_XMM_STATE | BIT_YMM_STATE ) )
+    {
+        return false;
+    }
+
+    // Check AVX2 feature.
+    CPL_CPUIDEX(7, 0, cpuinfo);
+    return (cpuinfo[REG_EBX] & (1 << CPUID_AVX2_EBX_BIT)) != 0;
+}
+
+bool bCPLHasAVX2 = false;
+static void CPLHaveRuntimeAVX2Initialize() __attribute__ ((constructor));
+static void CPLHaveRuntimeAVX2Initialize()
+{
+    bCPLHasAVX2 = CPLDetectRuntimeAVX2();
+}
+
+#elif defined(_MSC_FULL_VER) && (_MSC_FULL_VER >= 160040219) && (defined(_M_IX86) || defined(_M_X64))
+// _xgetbv available only in Visual Studio 2010 SP1 or later
+
+bool CPLHaveRuntimeAVX2()
+{
+    int cpuinfo[4] = { 0, 0, 0, 0 };
+    CPL_CPUID(0, cpuinfo);
+    if( cpuinfo[REG_EAX] < 7 )
+    {
+        return false;
+    }
+
+    CPL_CPUID(1, cpuinfo);
+
+    // Check OSXSAVE feature.
+    if( (cpuinfo[REG_ECX] & (1 << CPUID_OSXSAVE_ECX_BIT)) == 0 )
+    {
+        return false;
+    }
+
+    // Check AVX feature.
+    if( (cpuinfo[REG_ECX] & (1 << CPUID_AVX_ECX_BIT)) == 0 )
+    {
+        return false;
+    }
+
+    // Issue XGETBV and check the XMM and YMM state bit.
+    unsigned __int64 xcrFeatureMask = _xgetbv(_XCR_XFEATURE_ENABLED_MASK);
+    if( (xcrFeatureMask & ( BIT_XMM_STATE | BIT_YMM_STATE )) !=
+                          ( BIT_XMM_STATE | BIT_YMM_STATE ) )
+    {
+        return false;
+    }
+
+    // Check AVX2 feature.
+    CPL_CPUIDEX(7, 0, cpuinfo);
+    return (cpuinfo[REG_EBX] & (1 << CPUID_AVX2_EBX_BIT)) != 0;
+}
+
+#else
+
+bool CPLHaveRuntimeAVX2()
+{
+    return false;
+}
+
+#endif
+
+#endif // defined(HAVE_AVX2_AT_COMPILE_TIME) && !defined(HAVE_INLINE_AVX2)
+
 //! @endcond
@@ -373,6 +373,7 @@ void CPL_DLL VSIInstallSubFileHandler(void);
 void VSIInstallCurlFileHandler(void);
 void CPL_DLL VSICurlClearCache(void);
 void CPL_DLL VSICurlPartialClearCache(const char* pszFilenamePrefix);
+char CPL_DLL **VSICurlGetDiskCacheStatistics(void);
 void VSIInstallCurlStreamingFileHandler(void);
 void VSIInstallS3FileHandler(void);
 void VSIInstallS3StreamingFileHandler(void);
@@ -40,6 +40,7 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <set>
@@ -2321,6 +2322,12 @@ const char* VSIGetFileSystemOptions( const char* pszFilename )
 **
 ** The VSIFileManager maintains a list of file type handlers (mem, large
 ** file, etc).  It should be thread safe.
+**
+** Handlers are only added, never removed until VSICleanupFileManager().
+** Each installation publishes an immutable copy of the list of handlers,
+** so that GetHandler(), called by every VSI function, does not need to
+** take any lock. Previous copies are kept alive until the cleanup, as
+** other threads may still be walking them.
 **/
 
 /************************************************************************/
@@ -2359,10 +2366,29 @@ VSIFileManager::~VSIFileManager()
 
 static VSIFileManager *poManager = nullptr;
 static CPLMutex* hVSIFileManagerMutex = nullptr;
+// Set once all the built-in handlers are installed.
+static std::atomic<VSIFileManager*> gpoInitializedManager{nullptr};
+
+namespace {
+struct VSIHandlerList
+{
+    std::vector<std::pair<std::string, VSIFilesystemHandler*>> aoHandlers{};
+    VSIFilesystemHandler* poDefaultHandler = nullptr;
+};
+} // namespace
+
+static std::atomic<const VSIHandlerList*> gpoHandlerList{nullptr};
+static std::vector<std::unique_ptr<VSIHandlerList>> gapoHandlerLists;
 
 VSIFileManager *VSIFileManager::Get()
 {
+      VSIFileManager* poInitializedManager =
+          gpoInitializedManager.load(std::memory_order_acquire);
+      if( poInitializedManager != nullptr )
+          return poInitializedManager;
+
       CPLMutexHolder oHolder(&hVSIFileManagerMutex);
+      // Also reached recursively by the VSIInstallXXXX() functions below.
       if ( poManager != nullptr ) {
         return poManager;
       }
@@ -2397,6 +2423,7 @@ VSIFileManager *VSIFileManager::Get()
       VSIInstallTarFileHandler();
       VSIInstallCryptFileHandler();
 
+      gpoInitializedManager.store(poManager, std::memory_order_release);
       return poManager;
 
 }
@@ -2426,12 +2453,15 @@ char ** VSIFileManager::GetPrefixes()
 VSIFilesystemHandler *VSIFileManager::GetHandler( const char *pszPath )
 
 {
-    VSIFileManager *poThis = Get();
+    Get();
+    const VSIHandlerList* poList =
+        gpoHandlerList.load(std::memory_order_acquire);
+    if( poList == nullptr )
+        return nullptr;
     const size_t nPathLen = strlen(pszPath);
 
-    for( std::map<std::string, VSIFilesystemHandler*>::const_iterator iter =
-             poThis->oHandlers.begin();
-         iter != poThis->oHandlers.end();
+    for( auto iter = poList->aoHandlers.begin();
+         iter != poList->aoHandlers.end();
          ++iter )
     {
         const char* pszIterKey = iter->first.c_str();
@@ -2452,7 +2482,7 @@ VSIFilesystemHandler *VSIFileManager::GetHandler( const char *pszPath )
             return iter->second;
     }
 
-    return poThis->poDefaultHandler;
+    return poList->poDefaultHandler;
 }
 
 /************************************************************************/
@@ -2463,10 +2493,19 @@ void VSIFileManager::InstallHandler( const std::string& osPrefix,
                                      VSIFilesystemHandler *poHandler )
 
 {
+    CPLMutexHolder oHolder( &hVSIFileManagerMutex );
+    VSIFileManager *poThis = Get();
     if( osPrefix == "" )
-        Get()->poDefaultHandler = poHandler;
+        poThis->poDefaultHandler = poHandler;
     else
-        Get()->oHandlers[osPrefix] = poHandler;
+        poThis->oHandlers[osPrefix] = poHandler;
+
+    std::unique_ptr<VSIHandlerList> poList(new VSIHandlerList());
+    poList->aoHandlers.assign(poThis->oHandlers.begin(),
+                              poThis->oHandlers.end());
+    poList->poDefaultHandler = poThis->poDefaultHandler;
+    gpoHandlerList.store(poList.get(), std::memory_order_release);
+    gapoHandlerLists.emplace_back(std::move(poList));
 }
 
 /************************************************************************/
@@ -2476,6 +2515,10 @@ void VSIFileManager::InstallHandler( const std::string& osPrefix,
 void VSICleanupFileManager()
 
 {
+    gpoInitializedManager.store(nullptr);
+    gpoHandlerList.store(nullptr);
+    gapoHandlerLists.clear();
+
     if( poManager )
     {
         delete poManager;
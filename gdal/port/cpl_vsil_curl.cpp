@@ -31,9 +31,12 @@
 #include "cpl_vsil_curl_class.h"
 
 #include <algorithm>
+#include <atomic>
 #include <set>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "cpl_aws.h"
 #include "cpl_minixml.h"
@@ -44,6 +47,7 @@
 #include "cpl_vsi_virtual.h"
 #include "cpl_http.h"
 #include "cpl_mem_cache.h"
+#include "cpl_sha256.h"
 
 CPL_CVSID("$Id$")
 
@@ -64,6 +68,12 @@ void VSICurlPartialClearCache(const char* )
     // Not supported.
 }
 
+char** VSICurlGetDiskCacheStatistics( void )
+{
+    // Not supported.
+    return nullptr;
+}
+
 /************************************************************************/
 /*                      VSICurlInstallReadCbk()                         */
 /************************************************************************/
@@ -720,6 +730,71 @@ void MultiPerform(CURLM* hCurlMultiHandle, CURL* hEasyHandle)
         curl_multi_remove_handle(hCurlMultiHandle, hEasyHandle);
 }
 
+/************************************************************************/
+/*                   VSICurlGetMaxParallelRequests()                    */
+/************************************************************************/
+
+static int VSICurlGetMaxParallelRequests()
+{
+    return std::max(1, atoi(
+        CPLGetConfigOption("GDAL_HTTP_MAX_PARALLEL_REQUESTS", "10")));
+}
+
+/************************************************************************/
+/*                        MultiPerformBounded()                         */
+/************************************************************************/
+
+// Runs the transfers of all the easy handles, with at most nMaxParallel of
+// them in flight at the same time. The handles are left attached to the
+// multi handle, so that the caller can inspect and remove them.
+static void MultiPerformBounded(CURLM* hCurlMultiHandle,
+                                const std::vector<CURL*>& ahEasyHandles,
+                                int nMaxParallel)
+{
+    size_t iNext = 0;
+    for( ; iNext < ahEasyHandles.size() &&
+           iNext < static_cast<size_t>(nMaxParallel); ++iNext )
+    {
+        curl_multi_add_handle(hCurlMultiHandle, ahEasyHandles[iNext]);
+    }
+
+    int repeats = 0;
+    void* old_handler = CPLHTTPIgnoreSigPipe();
+    while( true )
+    {
+        int still_running;
+        while (curl_multi_perform(hCurlMultiHandle, &still_running) ==
+                                        CURLM_CALL_MULTI_PERFORM )
+        {
+            // loop
+        }
+
+        // Replace each completed transfer by a pending one.
+        bool bAdded = false;
+        CURLMsg *msg;
+        do {
+            int msgq = 0;
+            msg = curl_multi_info_read(hCurlMultiHandle, &msgq);
+            if( msg && msg->msg == CURLMSG_DONE &&
+                iNext < ahEasyHandles.size() )
+            {
+                curl_multi_add_handle(hCurlMultiHandle,
+                                      ahEasyHandles[iNext]);
+                ++iNext;
+                bAdded = true;
+            }
+        } while(msg);
+
+        if( bAdded )
+            continue;
+        if( !still_running )
+            break;
+
+        CPLMultiPerformWait(hCurlMultiHandle, repeats);
+    }
+    CPLHTTPRestoreSigPipeHandler(old_handler);
+}
+
 /************************************************************************/
 /*                       VSICurlDummyWriteFunc()                        */
 /************************************************************************/
@@ -1224,6 +1299,9 @@ bool VSICurlHandle::DownloadRegion( const vsi_l_offset startOffset,
     if( oFileProp.eExists == EXIST_NO )
         return false;
 
+    if( DownloadRegionParallel(startOffset, nBlocks) )
+        return true;
+
     CURLM* hCurlMultiHandle = poFS->GetCurlMultiHandleFor(m_pszURL);
 
     bool bHasExpired = false;
@@ -1520,6 +1598,81 @@ retry:
     return true;
 }
 
+/************************************************************************/
+/*                       DownloadRegionParallel()                       */
+/************************************************************************/
+
+// Downloads a large region with several ranged GET requests run in
+// parallel, so that their latencies overlap. This is what makes large reads
+// and the read-ahead of sequential reads efficient on high latency links.
+// Returns false if the region is too small, or if one of the requests
+// failed, in which case the caller downloads it with a single request.
+bool VSICurlHandle::DownloadRegionParallel( const vsi_l_offset startOffset,
+                                            const int nBlocks )
+{
+    // Do not issue requests smaller than that.
+    constexpr int MIN_BLOCKS_PER_REQUEST = 8;
+    const int nRequests = std::min(VSICurlGetMaxParallelRequests(),
+                                   nBlocks / MIN_BLOCKS_PER_REQUEST);
+    if( nRequests < 2 ||
+        !STARTS_WITH(m_pszURL, "http") ||
+        !oFileProp.bHasComputedFileSize ||
+        startOffset >= oFileProp.fileSize )
+    {
+        return false;
+    }
+
+    bool bHasExpired = false;
+    const CPLString osURL(GetRedirectURLIfValid(bHasExpired));
+    if( bHasExpired )
+        return false;
+
+    const vsi_l_offset nEndOffset = std::min(
+        startOffset + static_cast<vsi_l_offset>(nBlocks) * DOWNLOAD_CHUNK_SIZE,
+        oFileProp.fileSize);
+    const size_t nTotalSize = static_cast<size_t>(nEndOffset - startOffset);
+    char* pabyBuffer = static_cast<char*>(VSI_MALLOC_VERBOSE(nTotalSize));
+    if( pabyBuffer == nullptr )
+        return false;
+
+    // Split on chunk boundaries.
+    const size_t nRequestSize =
+        static_cast<size_t>((nBlocks + nRequests - 1) / nRequests) *
+        DOWNLOAD_CHUNK_SIZE;
+    std::vector<void*> apData;
+    std::vector<vsi_l_offset> anOffsets;
+    std::vector<size_t> anSizes;
+    for( size_t nPos = 0; nPos < nTotalSize; nPos += nRequestSize )
+    {
+        apData.push_back(pabyBuffer + nPos);
+        anOffsets.push_back(startOffset + nPos);
+        anSizes.push_back(std::min(nRequestSize, nTotalSize - nPos));
+    }
+
+    // Errors are not reported, since the caller will retry.
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    const int nRet = ReadMultiRangeParallel(osURL,
+                                            static_cast<int>(apData.size()),
+                                            apData.data(),
+                                            anOffsets.data(),
+                                            anSizes.data(),
+                                            false);
+    CPLPopErrorHandler();
+
+    if( nRet == 0 )
+    {
+        DownloadRegionPostProcess(startOffset, nBlocks,
+                                  pabyBuffer, nTotalSize);
+    }
+    else
+    {
+        CPLDebug("VSICURL", "Parallel download of %s failed. "
+                 "Retrying with a single request", m_pszURL);
+    }
+    VSIFree(pabyBuffer);
+    return nRet == 0;
+}
+
 /************************************************************************/
 /*                      DownloadRegionPostProcess()                     */
 /************************************************************************/
@@ -1606,8 +1759,14 @@ size_t VSICurlHandle::Read( void * const pBufferIn, size_t const nSize,
                 // In case of consecutive reads (of small size), we use a
                 // heuristic that we will read the file sequentially, so
                 // we double the requested size to decrease the number of
-                // client/server roundtrips.
-                if( nBlocksToDownload < 100 )
+                // client/server roundtrips. As large regions are downloaded
+                // with parallel requests, we can read further ahead when
+                // they are enabled, while keeping room in the region cache.
+                const int nMaxParallel = VSICurlGetMaxParallelRequests();
+                const int nMaxBlocksToDownload = nMaxParallel > 1 ?
+                    std::max(100, std::min(N_MAX_REGIONS / 4,
+                                           100 * nMaxParallel)) : 100;
+                if( nBlocksToDownload < nMaxBlocksToDownload )
                     nBlocksToDownload *= 2;
             }
             else
@@ -1643,7 +1802,22 @@ size_t VSICurlHandle::Read( void * const pBufferIn, size_t const nSize,
             if( nBlocksToDownload > N_MAX_REGIONS )
                 nBlocksToDownload = N_MAX_REGIONS;
 
-            if( DownloadRegion(nOffsetToDownload, nBlocksToDownload) == false )
+            // If another handle is already downloading this chunk, wait for
+            // it and use its result instead of requesting it again.
+            const int nBlocksClaimed = poFS->BeginRegionDownload(
+                m_pszURL, nOffsetToDownload, nBlocksToDownload);
+            if( nBlocksClaimed == 0 )
+            {
+                // If the other download failed, start over, which will
+                // either download the chunk or stop at end of file.
+                continue;
+            }
+
+            const bool bSuccess =
+                DownloadRegion(nOffsetToDownload, nBlocksClaimed);
+            poFS->EndRegionDownload(m_pszURL, nOffsetToDownload,
+                                    nBlocksClaimed);
+            if( !bSuccess )
             {
                 if( !bInterrupted )
                     bEOF = true;
@@ -1719,6 +1893,27 @@ int VSICurlHandle::ReadMultiRange( int const nRanges, void ** const ppData,
                                     nRanges, ppData, panOffsets, panSizes);
     }
 
+    const bool bMergeConsecutiveRanges = CPLTestBool(CPLGetConfigOption(
+        "GDAL_HTTP_MERGE_CONSECUTIVE_RANGES", "TRUE"));
+
+    return ReadMultiRangeParallel(osURL, nRanges, ppData, panOffsets,
+                                  panSizes, bMergeConsecutiveRanges);
+}
+
+/************************************************************************/
+/*                       ReadMultiRangeParallel()                       */
+/************************************************************************/
+
+// Issues one ranged GET request per range (or per group of consecutive
+// ranges if bMergeConsecutiveRanges), with at most
+// GDAL_HTTP_MAX_PARALLEL_REQUESTS of them in flight at the same time.
+int VSICurlHandle::ReadMultiRangeParallel( const CPLString& osURL,
+                                           int const nRanges,
+                                           void ** const ppData,
+                                           const vsi_l_offset* const panOffsets,
+                                           const size_t* const panSizes,
+                                           bool bMergeConsecutiveRanges )
+{
     CURLM * hMultiHandle = poFS->GetCurlMultiHandleFor(osURL);
 #ifdef CURLPIPE_MULTIPLEX
     // Enable HTTP/2 multiplexing (ignored if an older version of HTTP is
@@ -1750,9 +1945,6 @@ int VSICurlHandle::ReadMultiRange( int const nRanges, void ** const ppData,
     asWriteFuncHeaderData.resize(nRanges);
     asCurlErrors.resize(nRanges);
 
-    const bool bMergeConsecutiveRanges = CPLTestBool(CPLGetConfigOption(
-        "GDAL_HTTP_MERGE_CONSECUTIVE_RANGES", "TRUE"));
-
     for( int i = 0, iRequest = 0; i < nRanges; )
     {
         size_t nSize = 0;
@@ -1767,7 +1959,10 @@ int VSICurlHandle::ReadMultiRange( int const nRanges, void ** const ppData,
         }
         nSize += panSizes[iNext];
         if( nSize == 0 )
+        {
+            i = iNext + 1;
             continue;
+        }
 
         CURL* hCurlHandle = curl_easy_init();
         aHandles.push_back(hCurlHandle);
@@ -1830,7 +2025,6 @@ int VSICurlHandle::ReadMultiRange( int const nRanges, void ** const ppData,
         headers = VSICurlMergeHeaders(headers, GetCurlHeaders("GET", headers));
         curl_easy_setopt(hCurlHandle, CURLOPT_HTTPHEADER, headers);
         aHeaders.push_back(headers);
-        curl_multi_add_handle(hMultiHandle, hCurlHandle);
 
         i = iNext + 1;
         iRequest ++;
@@ -1838,7 +2032,8 @@ int VSICurlHandle::ReadMultiRange( int const nRanges, void ** const ppData,
 
     if( !aHandles.empty() )
     {
-        MultiPerform(hMultiHandle);
+        MultiPerformBounded(hMultiHandle, aHandles,
+                            VSICurlGetMaxParallelRequests());
     }
 
     int nRet = 0;
@@ -1856,7 +2051,7 @@ int VSICurlHandle::ReadMultiRange( int const nRanges, void ** const ppData,
         long response_code = 0;
         curl_easy_getinfo(aHandles[iReq], CURLINFO_HTTP_CODE, &response_code);
 
-        if( ENABLE_DEBUG && asCurlErrors[iRange].szCurlErrBuf[0] != '\0' )
+        if( ENABLE_DEBUG && asCurlErrors[iReq].szCurlErrBuf[0] != '\0' )
         {
             char rangeStr[512] = {};
             snprintf(rangeStr, sizeof(rangeStr),
@@ -1868,7 +2063,7 @@ int VSICurlHandle::ReadMultiRange( int const nRanges, void ** const ppData,
                      osURL.c_str(),
                      rangeStr,
                      static_cast<int>(response_code),
-                     asCurlErrors[iRange].szCurlErrBuf);
+                     asCurlErrors[iReq].szCurlErrBuf);
         }
 
         if( (response_code != 206 && response_code != 225) ||
@@ -2356,7 +2551,7 @@ int       VSICurlHandle::Close()
 /************************************************************************/
 
 VSICurlFilesystemHandler::VSICurlFilesystemHandler():
-    oRegionCache{static_cast<size_t>(N_MAX_REGIONS)},
+    oRegionCache{static_cast<size_t>(N_MAX_REGIONS), 10, 1},
     oCacheFileProp{100 * 1024},
     oCacheDirList{1024, 0}
 {
@@ -2444,6 +2639,385 @@ CURLM* VSICurlFilesystemHandler::GetCurlMultiHandleFor(const CPLString& /*osURL*
     return conn.hCurlMultiHandle;
 }
 
+/************************************************************************/
+/*                          VSICurlDiskCache                            */
+/************************************************************************/
+
+// Persistent cache of downloaded chunks, in a local directory set with the
+// CPL_VSIL_CURL_DISK_CACHE_DIR configuration option, that complements the
+// in-memory region cache of the /vsicurl/ like filesystems.
+//
+// Each chunk is stored in its own file, whose name is the SHA256 of a key
+// made of the URL, the ETag or last modification time, and size of the
+// remote file, the chunk size and the chunk offset, so that a modified
+// remote file is never served from stale chunks. Files are written under
+// a temporary name and renamed, so that concurrent processes only see
+// complete files. When the total size of the cache exceeds
+// CPL_VSIL_CURL_DISK_CACHE_SIZE, the least recently written files are
+// removed.
+
+class VSICurlDiskCache
+{
+    CPL_DISALLOW_COPY_ASSIGN(VSICurlDiskCache)
+
+    CPLString           m_osDir;
+    std::atomic<GIntBig> m_nMaxSize{0};
+
+    std::mutex          m_oMutex{};
+    bool                m_bScanned = false;
+    bool                m_bScanInProgress = false;
+    GIntBig             m_nEstimatedSize = 0;
+    GIntBig             m_nBytesWrittenSinceScan = 0;
+
+    std::atomic<GIntBig> m_nHits{0};
+    std::atomic<GIntBig> m_nMisses{0};
+    std::atomic<GIntBig> m_nWrites{0};
+    std::atomic<GIntBig> m_nBytesWritten{0};
+    std::atomic<GIntBig> m_nEvictions{0};
+
+    static constexpr const char* MAGIC = "GDALVCC1";
+
+    static CPLString GetValidator( const FileProp& oFileProp );
+    CPLString GetFilename( const CPLString& osKey ) const;
+    void ScanAndEvict();
+
+  public:
+    VSICurlDiskCache( const char* pszDir, GIntBig nMaxSize ) :
+        m_osDir(pszDir), m_nMaxSize(nMaxSize) {}
+
+    const CPLString& GetDir() const { return m_osDir; }
+    void SetMaxSize( GIntBig nMaxSize ) { m_nMaxSize = nMaxSize; }
+
+    static CPLString GetKey( const char* pszURL, const FileProp& oFileProp,
+                             vsi_l_offset nOffset );
+
+    bool Get( const CPLString& osKey, std::string& osData );
+    void Put( const CPLString& osKey, const char* pData, size_t nSize );
+
+    char** GetStatistics() const;
+};
+
+/************************************************************************/
+/*                           GetValidator()                             */
+/************************************************************************/
+
+CPLString VSICurlDiskCache::GetValidator( const FileProp& oFileProp )
+{
+    if( oFileProp.eExists != EXIST_YES || !oFileProp.bHasComputedFileSize )
+        return CPLString();
+    CPLString osValidator;
+    if( !oFileProp.ETag.empty() )
+        osValidator = "ETag=" + oFileProp.ETag;
+    else if( oFileProp.mTime != 0 )
+        osValidator.Printf("mtime=" CPL_FRMT_GIB,
+                           static_cast<GIntBig>(oFileProp.mTime));
+    else
+        return CPLString();
+    osValidator += CPLSPrintf(";size=" CPL_FRMT_GUIB,
+                              static_cast<GUIntBig>(oFileProp.fileSize));
+    return osValidator;
+}
+
+/************************************************************************/
+/*                              GetKey()                                */
+/************************************************************************/
+
+// Returns an empty string if the remote file has no validator that would
+// allow to detect that it has been modified.
+CPLString VSICurlDiskCache::GetKey( const char* pszURL,
+                                    const FileProp& oFileProp,
+                                    vsi_l_offset nOffset )
+{
+    const CPLString osValidator(GetValidator(oFileProp));
+    if( osValidator.empty() )
+        return osValidator;
+    CPLString osKey(pszURL);
+    osKey += '\n';
+    osKey += osValidator;
+    osKey += CPLSPrintf("\nchunk_size=%d\noffset=" CPL_FRMT_GUIB,
+                        DOWNLOAD_CHUNK_SIZE, static_cast<GUIntBig>(nOffset));
+    return osKey;
+}
+
+/************************************************************************/
+/*                            GetFilename()                             */
+/************************************************************************/
+
+CPLString VSICurlDiskCache::GetFilename( const CPLString& osKey ) const
+{
+    GByte abyHash[CPL_SHA256_HASH_SIZE];
+    CPL_SHA256(osKey.data(), osKey.size(), abyHash);
+    CPLString osHash;
+    for( int i = 0; i < CPL_SHA256_HASH_SIZE; i++ )
+        osHash += CPLSPrintf("%02x", abyHash[i]);
+    // Spread files in 256 sub-directories.
+    return CPLFormFilename(
+        CPLFormFilename(m_osDir, osHash.substr(0, 2).c_str(), nullptr),
+        osHash, nullptr);
+}
+
+/************************************************************************/
+/*                                Get()                                 */
+/************************************************************************/
+
+bool VSICurlDiskCache::Get( const CPLString& osKey, std::string& osData )
+{
+    VSILFILE* fp = VSIFOpenL(GetFilename(osKey), "rb");
+    bool bOK = false;
+    if( fp != nullptr )
+    {
+        // Header: magic, key size, key, data size, followed by the data.
+        char szMagic[8] = {};
+        GUInt32 nKeySize = 0;
+        std::string osStoredKey;
+        GUInt64 nDataSize = 0;
+        if( VSIFReadL(szMagic, sizeof(szMagic), 1, fp) == 1 &&
+            memcmp(szMagic, MAGIC, sizeof(szMagic)) == 0 &&
+            VSIFReadL(&nKeySize, sizeof(nKeySize), 1, fp) == 1 )
+        {
+            CPL_LSBPTR32(&nKeySize);
+            // A different key in the file would be a hash collision.
+            if( nKeySize == osKey.size() )
+            {
+                osStoredKey.resize(nKeySize);
+                if( VSIFReadL(&osStoredKey[0], nKeySize, 1, fp) == 1 &&
+                    osStoredKey == osKey &&
+                    VSIFReadL(&nDataSize, sizeof(nDataSize), 1, fp) == 1 )
+                {
+                    CPL_LSBPTR64(&nDataSize);
+                    if( nDataSize > 0 &&
+                        nDataSize <= static_cast<GUInt64>(DOWNLOAD_CHUNK_SIZE) )
+                    {
+                        osData.resize(static_cast<size_t>(nDataSize));
+                        bOK = VSIFReadL(&osData[0], osData.size(), 1, fp) == 1;
+                    }
+                }
+            }
+        }
+        VSIFCloseL(fp);
+    }
+    if( bOK )
+        m_nHits++;
+    else
+        m_nMisses++;
+    return bOK;
+}
+
+/************************************************************************/
+/*                                Put()                                 */
+/************************************************************************/
+
+void VSICurlDiskCache::Put( const CPLString& osKey,
+                            const char* pData, size_t nSize )
+{
+    const CPLString osFilename(GetFilename(osKey));
+    VSIStatBufL sStat;
+    if( VSIStatL(osFilename, &sStat) == 0 )
+        return;
+
+    const CPLString osSubDir(CPLGetPath(osFilename));
+    if( VSIStatL(osSubDir, &sStat) != 0 )
+    {
+        // Might fail if another process creates it at the same time.
+        VSIMkdirRecursive(osSubDir, 0755);
+    }
+
+    static std::atomic<int> nCounter{0};
+    const CPLString osTmpFilename(CPLSPrintf(
+        "%s.tmp_%d_%d", osFilename.c_str(), CPLGetCurrentProcessID(),
+        ++nCounter));
+    VSILFILE* fp = VSIFOpenL(osTmpFilename, "wb");
+    if( fp == nullptr )
+        return;
+
+    GUInt32 nKeySize = static_cast<GUInt32>(osKey.size());
+    CPL_LSBPTR32(&nKeySize);
+    GUInt64 nDataSize = nSize;
+    CPL_LSBPTR64(&nDataSize);
+    bool bOK =
+        VSIFWriteL(MAGIC, 8, 1, fp) == 1 &&
+        VSIFWriteL(&nKeySize, sizeof(nKeySize), 1, fp) == 1 &&
+        VSIFWriteL(osKey.data(), osKey.size(), 1, fp) == 1 &&
+        VSIFWriteL(&nDataSize, sizeof(nDataSize), 1, fp) == 1 &&
+        VSIFWriteL(pData, nSize, 1, fp) == 1;
+    if( VSIFCloseL(fp) != 0 )
+        bOK = false;
+    // Renaming fails on Windows if the file has been created in the
+    // meantime by another process, which is fine.
+    if( !bOK || VSIRename(osTmpFilename, osFilename) != 0 )
+    {
+        VSIUnlink(osTmpFilename);
+        return;
+    }
+
+    const GIntBig nFileSize =
+        static_cast<GIntBig>(8 + sizeof(GUInt32) + osKey.size() +
+                             sizeof(GUInt64) + nSize);
+    m_nWrites++;
+    m_nBytesWritten += nFileSize;
+
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_nEstimatedSize += nFileSize;
+        m_nBytesWrittenSinceScan += nFileSize;
+        // Other processes may also write in the cache, so rescan it from
+        // time to time, and not only when our own estimate exceeds the
+        // limit.
+        if( m_bScanInProgress ||
+            (m_bScanned && m_nEstimatedSize <= m_nMaxSize &&
+             m_nBytesWrittenSinceScan <= m_nMaxSize / 10) )
+        {
+            return;
+        }
+        m_bScanInProgress = true;
+    }
+    // The scan is done without holding m_oMutex, so that Put() in other
+    // threads is not blocked by the directory traversal.
+    ScanAndEvict();
+}
+
+/************************************************************************/
+/*                           ScanAndEvict()                             */
+/************************************************************************/
+
+// Must be called by the thread that has set m_bScanInProgress, without
+// m_oMutex held.
+void VSICurlDiskCache::ScanAndEvict()
+{
+    struct CacheFile
+    {
+        CPLString osFilename;
+        GIntBig   nSize;
+        GIntBig   nMTime;
+    };
+    std::vector<CacheFile> aoFiles;
+    GIntBig nTotalSize = 0;
+    const GIntBig nNow = static_cast<GIntBig>(time(nullptr));
+
+    char** papszSubDirs = VSIReadDir(m_osDir);
+    for( char** papszIter = papszSubDirs; papszIter && *papszIter; ++papszIter )
+    {
+        if( strlen(*papszIter) != 2 )
+            continue;
+        const CPLString osSubDir(CPLFormFilename(m_osDir, *papszIter, nullptr));
+        char** papszFiles = VSIReadDir(osSubDir);
+        for( char** papszIter2 = papszFiles; papszIter2 && *papszIter2;
+             ++papszIter2 )
+        {
+            if( (*papszIter2)[0] == '.' )
+                continue;
+            CacheFile oFile;
+            oFile.osFilename = CPLFormFilename(osSubDir, *papszIter2, nullptr);
+            VSIStatBufL sStat;
+            if( VSIStatL(oFile.osFilename, &sStat) != 0 )
+                continue;
+            oFile.nSize = static_cast<GIntBig>(sStat.st_size);
+            oFile.nMTime = static_cast<GIntBig>(sStat.st_mtime);
+            if( strstr(*papszIter2, ".tmp_") != nullptr )
+            {
+                // Left over by a process that has been interrupted.
+                if( nNow - oFile.nMTime > 3600 )
+                    VSIUnlink(oFile.osFilename);
+                continue;
+            }
+            nTotalSize += oFile.nSize;
+            aoFiles.push_back(oFile);
+        }
+        CSLDestroy(papszFiles);
+    }
+    CSLDestroy(papszSubDirs);
+
+    const GIntBig nMaxSize = m_nMaxSize;
+    if( nTotalSize > nMaxSize )
+    {
+        // Remove the oldest files, with some margin, so that the next
+        // eviction does not happen too soon.
+        std::sort(aoFiles.begin(), aoFiles.end(),
+                  [](const CacheFile& a, const CacheFile& b)
+                  { return a.nMTime < b.nMTime; });
+        const GIntBig nTargetSize = nMaxSize / 10 * 8;
+        for( const auto& oFile: aoFiles )
+        {
+            if( nTotalSize <= nTargetSize )
+                break;
+            if( VSIUnlink(oFile.osFilename) == 0 )
+                m_nEvictions++;
+            nTotalSize -= oFile.nSize;
+        }
+    }
+
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    m_bScanned = true;
+    m_bScanInProgress = false;
+    m_nEstimatedSize = nTotalSize;
+    m_nBytesWrittenSinceScan = 0;
+}
+
+/************************************************************************/
+/*                           GetStatistics()                            */
+/************************************************************************/
+
+char** VSICurlDiskCache::GetStatistics() const
+{
+    CPLStringList aosStats;
+    aosStats.SetNameValue("HITS", CPLSPrintf(CPL_FRMT_GIB,
+                                             m_nHits.load()));
+    aosStats.SetNameValue("MISSES", CPLSPrintf(CPL_FRMT_GIB,
+                                               m_nMisses.load()));
+    aosStats.SetNameValue("WRITES", CPLSPrintf(CPL_FRMT_GIB,
+                                               m_nWrites.load()));
+    aosStats.SetNameValue("BYTES_WRITTEN", CPLSPrintf(CPL_FRMT_GIB,
+                                                      m_nBytesWritten.load()));
+    aosStats.SetNameValue("EVICTIONS", CPLSPrintf(CPL_FRMT_GIB,
+                                                  m_nEvictions.load()));
+    return aosStats.StealList();
+}
+
+/************************************************************************/
+/*                       VSICurlGetDiskCache()                          */
+/************************************************************************/
+
+static std::mutex goDiskCacheMutex;
+// Instances are never destroyed, as other threads may still be using the
+// cache of a directory when the configuration option is changed.
+static std::map<CPLString, std::unique_ptr<VSICurlDiskCache>> goMapDiskCaches;
+// Directory that could not be created, for which the cache is disabled.
+static CPLString gosDisabledDiskCacheDir;
+
+// Returns the disk cache configured with CPL_VSIL_CURL_DISK_CACHE_DIR, or
+// nullptr if it is not set. The instance of a directory is kept during the
+// life-time of the process, so that its statistics are not lost.
+static VSICurlDiskCache* VSICurlGetDiskCache()
+{
+    const char* pszDir =
+        CPLGetConfigOption("CPL_VSIL_CURL_DISK_CACHE_DIR", nullptr);
+    if( pszDir == nullptr || pszDir[0] == '\0' )
+        return nullptr;
+    const GIntBig nMaxSize = std::max(static_cast<GIntBig>(0), CPLAtoGIntBig(
+        CPLGetConfigOption("CPL_VSIL_CURL_DISK_CACHE_SIZE", "1073741824")));
+
+    std::lock_guard<std::mutex> oLock(goDiskCacheMutex);
+    if( gosDisabledDiskCacheDir == pszDir )
+        return nullptr;
+    auto& poDiskCache = goMapDiskCaches[pszDir];
+    if( poDiskCache == nullptr )
+    {
+        VSIStatBufL sStat;
+        if( VSIStatL(pszDir, &sStat) != 0 &&
+            VSIMkdirRecursive(pszDir, 0755) != 0 )
+        {
+            CPLError(CE_Warning, CPLE_FileIO,
+                     "Cannot create %s. Disk cache disabled", pszDir);
+            goMapDiskCaches.erase(pszDir);
+            gosDisabledDiskCacheDir = pszDir;
+            return nullptr;
+        }
+        poDiskCache.reset(new VSICurlDiskCache(pszDir, nMaxSize));
+    }
+    poDiskCache->SetMaxSize(nMaxSize);
+    return poDiskCache.get();
+}
+
 /************************************************************************/
 /*                          GetRegion()                                 */
 /************************************************************************/
@@ -2452,19 +3026,39 @@ std::shared_ptr<std::string>
 VSICurlFilesystemHandler::GetRegion( const char* pszURL,
                                      vsi_l_offset nFileOffsetStart )
 {
-    CPLMutexHolder oHolder( &hMutex );
-
     nFileOffsetStart =
         (nFileOffsetStart / DOWNLOAD_CHUNK_SIZE) * DOWNLOAD_CHUNK_SIZE;
 
-    std::shared_ptr<std::string> out;
-    if( oRegionCache.tryGet(
-        FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), out) )
+    FileProp oFileProp;
     {
-        return out;
+        std::shared_ptr<std::string> out;
+        if( oRegionCache.tryGet(
+            FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), out) )
+        {
+            return out;
+        }
+
+        if( !oCacheFileProp.tryGet(std::string(pszURL), oFileProp) )
+            return nullptr;
     }
 
-    return nullptr;
+    // Not in memory: try the persistent cache, without holding the mutex
+    // during the file I/O.
+    VSICurlDiskCache* poDiskCache = VSICurlGetDiskCache();
+    if( poDiskCache == nullptr )
+        return nullptr;
+    const CPLString osKey(
+        VSICurlDiskCache::GetKey(pszURL, oFileProp, nFileOffsetStart));
+    if( osKey.empty() )
+        return nullptr;
+    std::shared_ptr<std::string> value(new std::string());
+    if( !poDiskCache->Get(osKey, *value) )
+        return nullptr;
+
+    oRegionCache.insert(
+        FilenameOffsetPair(std::string(pszURL), nFileOffsetStart),
+        value);
+    return value;
 }
 
 /************************************************************************/
@@ -2476,13 +3070,101 @@ void VSICurlFilesystemHandler::AddRegion( const char* pszURL,
                                           size_t nSize,
                                           const char *pData )
 {
-    CPLMutexHolder oHolder( &hMutex );
+    FileProp oFileProp;
+    bool bHasFileProp = false;
+    {
+        std::shared_ptr<std::string> value(new std::string());
+        value->assign(pData, nSize);
+        oRegionCache.insert(
+            FilenameOffsetPair(std::string(pszURL), nFileOffsetStart),
+            value);
 
-    std::shared_ptr<std::string> value(new std::string());
-    value->assign(pData, nSize);
-    oRegionCache.insert(
-        FilenameOffsetPair(std::string(pszURL), nFileOffsetStart),
-        value);
+        bHasFileProp = oCacheFileProp.tryGet(std::string(pszURL), oFileProp);
+    }
+
+    // Only persist complete chunks (or the last one of the file), since a
+    // truncated chunk could not be told apart from a full one on reading.
+    if( !bHasFileProp || nSize == 0 ||
+        (nFileOffsetStart % DOWNLOAD_CHUNK_SIZE) != 0 ||
+        nSize > static_cast<size_t>(DOWNLOAD_CHUNK_SIZE) ||
+        (nSize != static_cast<size_t>(DOWNLOAD_CHUNK_SIZE) &&
+         nFileOffsetStart + nSize != oFileProp.fileSize) )
+    {
+        return;
+    }
+    VSICurlDiskCache* poDiskCache = VSICurlGetDiskCache();
+    if( poDiskCache == nullptr )
+        return;
+    const CPLString osKey(
+        VSICurlDiskCache::GetKey(pszURL, oFileProp, nFileOffsetStart));
+    if( !osKey.empty() )
+        poDiskCache->Put(osKey, pData, nSize);
+}
+
+/************************************************************************/
+/*                        BeginRegionDownload()                         */
+/************************************************************************/
+
+// Registers that the caller is about to download the nBlocks chunks
+// starting at nFileOffsetStart. Returns the number of chunks it must
+// download, which stops before the first chunk already being downloaded by
+// another handle. If the first chunk is itself being downloaded, waits for
+// that download to complete and returns 0: the caller must then look up the
+// region cache again (and call this method again if the download failed).
+// A positive return must be matched by a call to EndRegionDownload().
+int VSICurlFilesystemHandler::BeginRegionDownload(
+                                            const char* pszURL,
+                                            vsi_l_offset nFileOffsetStart,
+                                            int nBlocks )
+{
+    const std::string osURL(pszURL);
+    std::unique_lock<std::mutex> oLock(oInFlightMutex);
+    if( oInFlightRegions.find(
+            FilenameOffsetPair(osURL, nFileOffsetStart)) !=
+                                                    oInFlightRegions.end() )
+    {
+        oInFlightCond.wait(oLock, [this, &osURL, nFileOffsetStart]()
+            { return oInFlightRegions.find(
+                        FilenameOffsetPair(osURL, nFileOffsetStart)) ==
+                                                oInFlightRegions.end(); });
+        return 0;
+    }
+
+    int nClaimed = 0;
+    for( ; nClaimed < nBlocks; nClaimed++ )
+    {
+        if( !oInFlightRegions.insert(FilenameOffsetPair(
+                osURL,
+                nFileOffsetStart + static_cast<vsi_l_offset>(nClaimed) *
+                                                DOWNLOAD_CHUNK_SIZE)).second )
+        {
+            break;
+        }
+    }
+    return nClaimed;
+}
+
+/************************************************************************/
+/*                         EndRegionDownload()                          */
+/************************************************************************/
+
+void VSICurlFilesystemHandler::EndRegionDownload(
+                                            const char* pszURL,
+                                            vsi_l_offset nFileOffsetStart,
+                                            int nBlocks )
+{
+    const std::string osURL(pszURL);
+    {
+        std::lock_guard<std::mutex> oLock(oInFlightMutex);
+        for( int i = 0; i < nBlocks; i++ )
+        {
+            oInFlightRegions.erase(FilenameOffsetPair(
+                osURL,
+                nFileOffsetStart + static_cast<vsi_l_offset>(i) *
+                                                DOWNLOAD_CHUNK_SIZE));
+        }
+    }
+    oInFlightCond.notify_all();
 }
 
 /************************************************************************/
@@ -2493,8 +3175,6 @@ bool
 VSICurlFilesystemHandler::GetCachedFileProp( const char* pszURL,
                                              FileProp& oFileProp )
 {
-    CPLMutexHolder oHolder( &hMutex );
-
     return oCacheFileProp.tryGet(std::string(pszURL), oFileProp);
 }
 
@@ -2506,8 +3186,6 @@ void
 VSICurlFilesystemHandler::SetCachedFileProp( const char* pszURL,
                                              const FileProp& oFileProp )
 {
-    CPLMutexHolder oHolder( &hMutex );
-
     oCacheFileProp.insert(std::string(pszURL), oFileProp);
 }
 
@@ -2519,7 +3197,7 @@ bool
 VSICurlFilesystemHandler::GetCachedDirList( const char* pszURL,
                                             CachedDirList& oCachedDirList )
 {
-    CPLMutexHolder oHolder( &hMutex );
+    std::lock_guard<std::mutex> oLock(oDirListMutex);
 
     return oCacheDirList.tryGet(std::string(pszURL), oCachedDirList);
 }
@@ -2532,7 +3210,7 @@ void
 VSICurlFilesystemHandler::SetCachedDirList( const char* pszURL,
                                             const CachedDirList& oCachedDirList )
 {
-    CPLMutexHolder oHolder( &hMutex );
+    std::lock_guard<std::mutex> oLock(oDirListMutex);
 
     std::string key(pszURL);
     CachedDirList oldValue;
@@ -2584,23 +3262,12 @@ bool VSICurlFilesystemHandler::ExistsInCacheDirList(
 
 void VSICurlFilesystemHandler::InvalidateCachedData( const char* pszURL )
 {
-    CPLMutexHolder oHolder( &hMutex );
-
     oCacheFileProp.remove(std::string(pszURL));
 
     // Invalidate all cached regions for this URL
-    std::list<FilenameOffsetPair> keysToRemove;
     std::string osURL(pszURL);
-    auto lambda = [&keysToRemove, &osURL](
-        const lru11::KeyValuePair<FilenameOffsetPair,
-                                  std::shared_ptr<std::string>>& kv)
-    {
-        if( kv.key.filename_ == osURL )
-            keysToRemove.push_back(kv.key);
-    };
-    oRegionCache.cwalk(lambda);
-    for( auto& key: keysToRemove )
-        oRegionCache.remove(key);
+    oRegionCache.removeIf([&osURL](const FilenameOffsetPair& key)
+                          { return key.filename_ == osURL; });
 }
 
 /************************************************************************/
@@ -2609,14 +3276,15 @@ void VSICurlFilesystemHandler::InvalidateCachedData( const char* pszURL )
 
 void VSICurlFilesystemHandler::ClearCache()
 {
-    CPLMutexHolder oHolder( &hMutex );
-
     oRegionCache.clear();
 
     oCacheFileProp.clear();
 
-    oCacheDirList.clear();
-    nCachedFilesInDirList = 0;
+    {
+        std::lock_guard<std::mutex> oLock(oDirListMutex);
+        oCacheDirList.clear();
+        nCachedFilesInDirList = 0;
+    }
 
     if( !GDALIsInGlobalDestructor() )
     {
@@ -2630,37 +3298,15 @@ void VSICurlFilesystemHandler::ClearCache()
 
 void VSICurlFilesystemHandler::PartialClearCache(const char* pszFilenamePrefix)
 {
-    CPLMutexHolder oHolder( &hMutex );
-
     CPLString osURL = GetURLFromFilename(pszFilenamePrefix);
-    {
-        std::list<FilenameOffsetPair> keysToRemove;
-        auto lambda = [&keysToRemove, &osURL](
-            const lru11::KeyValuePair<FilenameOffsetPair,
-                                                std::shared_ptr<std::string>>& kv)
-        {
-            if( strncmp(kv.key.filename_.c_str(), osURL, osURL.size()) == 0 )
-                keysToRemove.push_back(kv.key);
-        };
-        oRegionCache.cwalk(lambda);
-        for( auto& key: keysToRemove )
-            oRegionCache.remove(key);
-    }
+    oRegionCache.removeIf([&osURL](const FilenameOffsetPair& key)
+        { return strncmp(key.filename_.c_str(), osURL, osURL.size()) == 0; });
 
-    {
-        std::list<std::string> keysToRemove;
-        auto lambda = [&keysToRemove, &osURL](
-            const lru11::KeyValuePair<std::string, FileProp>& kv)
-        {
-            if( strncmp(kv.key.c_str(), osURL, osURL.size()) == 0 )
-                keysToRemove.push_back(kv.key);
-        };
-        oCacheFileProp.cwalk(lambda);
-        for( auto& key: keysToRemove )
-            oCacheFileProp.remove(key);
-    }
+    oCacheFileProp.removeIf([&osURL](const std::string& key)
+        { return strncmp(key.c_str(), osURL, osURL.size()) == 0; });
 
     {
+        std::lock_guard<std::mutex> oLock(oDirListMutex);
         const size_t nLen = strlen(pszFilenamePrefix);
         std::list<std::string> keysToRemove;
         auto lambda = [this, &keysToRemove, pszFilenamePrefix, nLen](
@@ -2725,6 +3371,9 @@ const char* VSICurlFilesystemHandler::GetActualURL(const char* pszFilename)
     "  </Option>" \
     "  <Option name='GDAL_HTTP_MULTIPLEX' type='boolean' " \
         "description='Whether to enable HTTP/2 multiplexing' default='YES'/>" \
+    "  <Option name='GDAL_HTTP_MAX_PARALLEL_REQUESTS' type='integer' " \
+        "description='Maximum number of range requests run in parallel' " \
+        "default='10' min='1'/>" \
     "  <Option name='GDAL_HTTP_MERGE_CONSECUTIVE_RANGES' type='boolean' " \
         "description='Whether to merge consecutive ranges in multirange " \
         "requests' default='YES'/>" \
@@ -2752,6 +3401,12 @@ const char* VSICurlFilesystemHandler::GetActualURL(const char* pszFilename)
     "  <Option name='CPL_VSIL_CURL_CACHE_SIZE' type='integer' " \
         "description='Size in bytes of the global /vsicurl/ cache' " \
         "default='16384000'/>" \
+    "  <Option name='CPL_VSIL_CURL_DISK_CACHE_DIR' type='string' " \
+        "description='Directory where downloaded chunks are persistently " \
+        "cached'/>" \
+    "  <Option name='CPL_VSIL_CURL_DISK_CACHE_SIZE' type='integer' " \
+        "description='Maximum size in bytes of the persistent disk cache' " \
+        "default='1073741824'/>" \
     "  <Option name='CPL_VSIL_CURL_IGNORE_GLACIER_STORAGE' type='boolean' " \
         "description='Whether to skip files with Glacier storage class in " \
         "directory listing.' default='YES'/>"
@@ -3991,7 +4646,7 @@ char** VSICurlFilesystemHandler::ReadDirInternal( const char *pszDirname,
 
 void VSICurlFilesystemHandler::InvalidateDirContent( const char *pszDirname )
 {
-    CPLMutexHolder oHolder( &hMutex );
+    std::lock_guard<std::mutex> oLock(oDirListMutex);
 
     CachedDirList oCachedDirList;
     if( oCacheDirList.tryGet(std::string(pszDirname), oCachedDirList) )
@@ -4340,4 +4995,30 @@ void VSICurlPartialClearCache(const char* pszFilenamePrefix)
         poFSHandler->PartialClearCache(pszFilenamePrefix);
 }
 
+/************************************************************************/
+/*                    VSICurlGetDiskCacheStatistics()                   */
+/************************************************************************/
+
+/**
+ * \brief Return statistics of the persistent disk cache of /vsicurl/ (and
+ * related file systems)
+ *
+ * The disk cache is enabled by setting the CPL_VSIL_CURL_DISK_CACHE_DIR
+ * configuration option. The returned list contains the HITS, MISSES,
+ * WRITES, BYTES_WRITTEN and EVICTIONS counters of the current process, as
+ * KEY=VALUE strings.
+ *
+ * @return a list of strings to free with CSLDestroy(), or NULL if the disk
+ * cache is not enabled.
+ * @since GDAL 3.1
+ */
+
+char** VSICurlGetDiskCacheStatistics( void )
+{
+    cpl::VSICurlDiskCache* poDiskCache = cpl::VSICurlGetDiskCache();
+    if( poDiskCache == nullptr )
+        return nullptr;
+    return poDiskCache->GetStatistics();
+}
+
 #endif /* HAVE_CURL */
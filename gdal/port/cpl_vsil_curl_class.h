@@ -39,12 +39,21 @@
 
 #include <curl/curl.h>
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <set>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 //! @cond Doxygen_Suppress
 
+class CPLWorkerThreadPool;
+
 // 7.18.1
 #if LIBCURL_VERSION_NUM >= 0x071201
 #define HAVE_CURLINFO_REDIRECT_URL
@@ -116,6 +125,110 @@ typedef struct
 #endif
 } WriteFuncStruct;
 
+/************************************************************************/
+/*                           ShardedLRUCache                            */
+/************************************************************************/
+
+// LRU cache split in several independent shards, each with its own lock,
+// so that threads looking up different keys rarely contend. The least
+// recently used entries are evicted per shard.
+template <class Key, class Value, class Hash = std::hash<Key>>
+class ShardedLRUCache
+{
+    using CacheType = lru11::Cache<Key, Value, lru11::NullLock,
+        std::unordered_map<Key,
+            typename std::list<lru11::KeyValuePair<Key, Value>>::iterator,
+            Hash>>;
+
+    struct Shard
+    {
+        std::mutex oMutex{};
+        CacheType  oCache;
+
+        Shard(size_t nMaxSize, size_t nElasticity):
+            oCache(nMaxSize, nElasticity) {}
+    };
+
+    std::vector<std::unique_ptr<Shard>> m_apoShards{};
+
+    Shard& GetShard(const Key& k)
+    {
+        if( m_apoShards.size() == 1 )
+            return *m_apoShards[0];
+        // Mix the bits, as std::hash is often the identity for integers.
+        const GUInt64 nHash =
+            static_cast<GUInt64>(Hash()(k)) * 0x9E3779B97F4A7C15ULL;
+        return *m_apoShards[static_cast<size_t>(nHash >> 32) %
+                            m_apoShards.size()];
+    }
+
+    CPL_DISALLOW_COPY_ASSIGN(ShardedLRUCache)
+
+  public:
+    explicit ShardedLRUCache(size_t nMaxSize, size_t nElasticity = 10,
+                             size_t nShards = 16)
+    {
+        // Small caches are not split, so that their capacity is not
+        // fragmented.
+        if( nMaxSize < 256 )
+            nShards = 1;
+        for( size_t i = 0; i < nShards; i++ )
+        {
+            m_apoShards.emplace_back(new Shard(
+                (nMaxSize + nShards - 1) / nShards, nElasticity / nShards));
+        }
+    }
+
+    void insert(const Key& k, const Value& v)
+    {
+        Shard& oShard = GetShard(k);
+        std::lock_guard<std::mutex> oLock(oShard.oMutex);
+        oShard.oCache.insert(k, v);
+    }
+
+    bool tryGet(const Key& k, Value& v)
+    {
+        Shard& oShard = GetShard(k);
+        std::lock_guard<std::mutex> oLock(oShard.oMutex);
+        return oShard.oCache.tryGet(k, v);
+    }
+
+    void remove(const Key& k)
+    {
+        Shard& oShard = GetShard(k);
+        std::lock_guard<std::mutex> oLock(oShard.oMutex);
+        oShard.oCache.remove(k);
+    }
+
+    void clear()
+    {
+        for( auto& poShard: m_apoShards )
+        {
+            std::lock_guard<std::mutex> oLock(poShard->oMutex);
+            poShard->oCache.clear();
+        }
+    }
+
+    // Remove the entries whose key matches the predicate.
+    template <class Pred> void removeIf(Pred pred)
+    {
+        for( auto& poShard: m_apoShards )
+        {
+            std::lock_guard<std::mutex> oLock(poShard->oMutex);
+            std::vector<Key> aoKeysToRemove;
+            auto lambda = [&aoKeysToRemove, &pred](
+                const lru11::KeyValuePair<Key, Value>& kv)
+            {
+                if( pred(kv.key) )
+                    aoKeysToRemove.push_back(kv.key);
+            };
+            poShard->oCache.cwalk(lambda);
+            for( const auto& key: aoKeysToRemove )
+                poShard->oCache.remove(key);
+        }
+    }
+};
+
 /************************************************************************/
 /*                     VSICurlFilesystemHandler                         */
 /************************************************************************/
@@ -150,22 +263,28 @@ class VSICurlFilesystemHandler : public VSIFilesystemHandler
         }
     };
 
-    using RegionCacheType =
-        lru11::Cache<FilenameOffsetPair, std::shared_ptr<std::string>,
-            lru11::NullLock,
-            std::unordered_map<
-                FilenameOffsetPair,
-                typename std::list<lru11::KeyValuePair<FilenameOffsetPair,
-                    std::shared_ptr<std::string>>>::iterator,
-                    FilenameOffsetPairHasher>>;
-
-    RegionCacheType oRegionCache;
+    // The file property cache is looked up by every stat, so it is sharded.
+    // The region cache is not: a read may download up to N_MAX_REGIONS
+    // chunks at once, and then needs the first of them, which an uneven
+    // spread of the chunks over shards of a fraction of that size could
+    // evict. The directory list cache is guarded by its own mutex, as its
+    // eviction depends on the total number of files.
+    ShardedLRUCache<FilenameOffsetPair, std::shared_ptr<std::string>,
+                    FilenameOffsetPairHasher> oRegionCache;
 
-    lru11::Cache<std::string, FileProp>  oCacheFileProp;
+    ShardedLRUCache<std::string, FileProp>  oCacheFileProp;
 
+    std::mutex                                oDirListMutex{};
     int                                       nCachedFilesInDirList = 0;
     lru11::Cache<std::string, CachedDirList>  oCacheDirList;
 
+    // Chunks being downloaded by a handle, so that other handles wanting
+    // them wait for that download instead of issuing the same request.
+    std::mutex                                oInFlightMutex{};
+    std::condition_variable                   oInFlightCond{};
+    std::unordered_set<FilenameOffsetPair,
+                       FilenameOffsetPairHasher> oInFlightRegions{};
+
     char**              ParseHTMLFileList(const char* pszFilename,
                                           int nMaxFiles,
                                           char* pszData,
@@ -241,6 +360,13 @@ public:
                                    size_t nSize,
                                    const char *pData );
 
+    int                 BeginRegionDownload( const char* pszURL,
+                                             vsi_l_offset nFileOffsetStart,
+                                             int nBlocks );
+    void                EndRegionDownload( const char* pszURL,
+                                           vsi_l_offset nFileOffsetStart,
+                                           int nBlocks );
+
     bool                GetCachedFileProp( const char* pszURL,
                                            FileProp& oFileProp );
     void                SetCachedFileProp( const char* pszURL,
@@ -311,6 +437,13 @@ class VSICurlHandle : public VSIVirtualHandle
     int          ReadMultiRangeSingleGet( int nRanges, void ** ppData,
                                          const vsi_l_offset* panOffsets,
                                          const size_t* panSizes );
+    int          ReadMultiRangeParallel( const CPLString& osURL,
+                                         int nRanges, void ** ppData,
+                                         const vsi_l_offset* panOffsets,
+                                         const size_t* panSizes,
+                                         bool bMergeConsecutiveRanges );
+    bool         DownloadRegionParallel( vsi_l_offset startOffset,
+                                         int nBlocks );
     CPLString    GetRedirectURLIfValid(bool& bHasExpired);
 
   protected:
@@ -466,10 +599,25 @@ class VSIS3WriteHandle final : public VSIVirtualHandle
     double              m_dfRetryDelay = 0.0;
     WriteFuncStruct     m_sWriteFuncHeaderData{};
 
+    // Background upload of parts
+    struct PartUploadJob;
+    int                 m_nMaxParallelUploads = 0;
+    std::unique_ptr<CPLWorkerThreadPool> m_poUploadPool{};
+    std::deque<std::unique_ptr<PartUploadJob>> m_apoPendingParts{};
+    std::vector<GByte*> m_apabyFreeBuffers{};
+    std::mutex          m_oHelperMutex{};
+
     static size_t       ReadCallBackBuffer( char *buffer, size_t size,
                                             size_t nitems, void *instream );
+    static size_t       ReadCallBackPart( char *buffer, size_t size,
+                                          size_t nitems, void *instream );
     bool                InitiateMultipartUpload();
-    bool                UploadPart();
+    bool                UploadPart( int nPartNumber,
+                                    const GByte* pabyBuffer, int nBufferSize,
+                                    CPLString& osEtag );
+    bool                SubmitPart();
+    bool                CollectPartUpload( bool bWait );
+    bool                CollectAllPartUploads();
     static size_t       ReadCallBackXML( char *buffer, size_t size,
                                          size_t nitems, void *instream );
     bool                CompleteMultipart();
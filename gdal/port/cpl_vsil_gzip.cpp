@@ -94,6 +94,8 @@
 #include <zlib.h>
 
 #include <algorithm>
+#include <atomic>
+#include <deque>
 #include <list>
 #include <map>
 #include <memory>
@@ -106,6 +108,7 @@
 #include "cpl_minizip_ioapi.h"
 #include "cpl_minizip_unzip.h"
 #include "cpl_multiproc.h"
+#include "cpl_sha256.h"
 #include "cpl_string.h"
 #include "cpl_time.h"
 #include "cpl_vsi_virtual.h"
@@ -149,6 +152,109 @@ typedef struct
     vsi_l_offset  out;
 } GZipSnapshot;
 
+// Unlike snapshots, which are copies of the opaque zlib state, access points
+// of the random-access index are taken at deflate block boundaries and only
+// hold what is needed to restart inflation there, so that they can be
+// persisted to disk.
+constexpr int GZIP_INDEX_WINDOW_SIZE = 32768;
+
+struct GZipAccessPoint
+{
+    vsi_l_offset      in = 0;   // Offset of the first full byte in base file.
+    vsi_l_offset      out = 0;  // Corresponding uncompressed offset.
+    int               bits = 0; // Bits of the previous byte still to be used.
+    uLong             crc = 0;  // crc32 of the uncompressed data up to out.
+    std::vector<GByte> abyCompressedWindow{}; // Deflated 32 KB window.
+};
+
+struct GZipIndex
+{
+    vsi_l_offset                 startOff = 0;
+    vsi_l_offset                 uncompressed_size = 0; // 0 if unknown.
+    std::vector<GZipAccessPoint> aoPoints{};
+
+    const GZipAccessPoint*       FindPoint( vsi_l_offset nOffset ) const;
+};
+
+/************************************************************************/
+/*                        VSIGZipParallelReader                         */
+/************************************************************************/
+
+// Decompresses the deflate stream ahead of a sequential reader, by splitting
+// it in chunks that can be inflated independently on worker threads. Chunk
+// boundaries are either the access points of a random-access index, or the
+// full flush markers written by VSIGZipWriteHandleMT (and pigz --independent).
+// Any inconsistency is reported through HasFailed(), in which case the caller
+// goes on with the regular single-threaded path.
+
+class VSIGZipParallelReader
+{
+    CPL_DISALLOW_COPY_ASSIGN(VSIGZipParallelReader)
+
+    struct Job
+    {
+        std::vector<GByte>     abyIn{};
+        const GZipAccessPoint* poPoint = nullptr; // Dictionary, or nullptr.
+        size_t                 nExpectedOut = 0;  // 0 if unknown.
+        bool                   bEndsAtMarker = false;
+
+        std::vector<GByte>     abyOut{};
+        uLong                  nCRC = 0;
+        size_t                 nConsumedIn = 0;
+        bool                   bStreamEnd = false;
+        bool                   bError = false;
+        std::atomic<bool>      bFinished{false};
+    };
+
+    VSIVirtualHandle*  m_poBaseHandle = nullptr;
+    vsi_l_offset       m_nStartOff = 0;
+    vsi_l_offset       m_nEndCompressedData = 0;
+    bool               m_bHasGZipTrailer = true;
+    uLong              m_nExpectedCRC = 0;
+    std::shared_ptr<const GZipIndex> m_poIndex{};
+
+    // Producer side.
+    int                m_nNextPoint = -1;  // Index mode: start of next job.
+    vsi_l_offset       m_nNextInPos = 0;   // Marker mode: next byte to read.
+    std::vector<GByte> m_abyPending{};     // Marker mode: unassigned bytes.
+    size_t             m_nScanPos = 0;
+    bool               m_bNoMoreJobs = false;
+
+    int                m_nThreads = 1;
+    std::unique_ptr<CPLJobQueue> m_poJobQueue{};
+    std::deque<std::unique_ptr<Job>> m_apoJobs{};
+
+    // Consumer side.
+    bool               m_bFrontReady = false;
+    size_t             m_nPosInJob = 0;
+    vsi_l_offset       m_nJobStartOut = 0;
+    uLong              m_nCRC = 0;
+    bool               m_bMoreMembers = false;
+    bool               m_bEOF = false;
+    bool               m_bFailed = false;
+
+    static void        DecompressJob( void* pData );
+    bool               PrepareNextJobInput( Job& oJob );
+    bool               FillQueue();
+    bool               PrepareFrontJob();
+
+  public:
+    VSIGZipParallelReader( VSIVirtualHandle* poBaseHandle,
+                           vsi_l_offset nStartOff,
+                           vsi_l_offset nEndCompressedData,
+                           bool bHasGZipTrailer,
+                           uLong nExpectedCRC,
+                           const std::shared_ptr<const GZipIndex>& poIndex );
+    ~VSIGZipParallelReader();
+
+    bool               Init( int nThreads, vsi_l_offset nStartOut );
+    size_t             Read( void* pBuffer, size_t nBytes );
+    bool               Seek( vsi_l_offset nOffset );
+    vsi_l_offset       Tell() const { return m_nJobStartOut + m_nPosInJob; }
+    bool               Eof() const { return m_bEOF; }
+    bool               HasFailed() const { return m_bFailed; }
+};
+
 class VSIGZipHandle final : public VSIVirtualHandle
 {
     VSIVirtualHandle* m_poBaseHandle = nullptr;
@@ -179,6 +285,28 @@ class VSIGZipHandle final : public VSIVirtualHandle
     GZipSnapshot* snapshots = nullptr;
     vsi_l_offset snapshot_byte_interval = 0; /* number of compressed bytes at which we create a "snapshot" */
 
+    std::shared_ptr<const GZipIndex> m_poIndex{};
+    bool              m_bUseIndex = false;
+    bool              m_bIndexBuildTried = false;
+    vsi_l_offset      m_nIndexSpan = 0;
+
+    int               m_nReadThreads = 1;
+    bool              m_bParallelReadDisabled = false;
+    vsi_l_offset      m_nSequentialReadStart = 0;
+    vsi_l_offset      m_nSequentialReadEnd = 0;
+    std::unique_ptr<VSIGZipParallelReader> m_poParallelReader{};
+
+    bool              StartParallelRead();
+    void              StopParallelRead();
+    size_t            gzread( void *pBuffer, size_t nSize, size_t nMemb );
+
+    CPLString         GetIndexFilename() const;
+    bool              GetBaseFileSignature( vsi_l_offset& nMTime ) const;
+    bool              LoadIndex();
+    bool              BuildIndex();
+    void              SaveIndex() const;
+    bool              RestoreAccessPoint( const GZipAccessPoint& oPoint );
+
     void check_header();
     int get_byte();
     int gzseek( vsi_l_offset nOffset, int nWhence );
@@ -220,6 +348,8 @@ class VSIGZipHandle final : public VSIVirtualHandle
 
     void              SaveInfo_unlocked();
     void              UnsetCanSaveInfo() { m_bCanSaveInfo = false; }
+
+    void              EnableIndex();
 };
 
 class VSIGZipFilesystemHandler final : public VSIFilesystemHandler
@@ -284,6 +414,10 @@ VSIGZipHandle* VSIGZipHandle::Duplicate()
     }
 
     poHandle->m_nLastReadOffset = m_nLastReadOffset;
+    poHandle->m_bUseIndex = m_bUseIndex;
+    poHandle->m_bIndexBuildTried = m_bIndexBuildTried;
+    poHandle->m_nIndexSpan = m_nIndexSpan;
+    poHandle->m_poIndex = m_poIndex;
 
     // Most important: duplicate the snapshots!
 
@@ -396,6 +530,7 @@ VSIGZipHandle::VSIGZipHandle( VSIVirtualHandle* poBaseHandle,
             CPLCalloc(sizeof(GZipSnapshot),
                       static_cast<size_t>(
                           compressed_size / snapshot_byte_interval + 1)));
+        m_nReadThreads = CPLGetNumThreads(nullptr);
     }
 }
 
@@ -421,6 +556,8 @@ void VSIGZipHandle::SaveInfo_unlocked()
 
 VSIGZipHandle::~VSIGZipHandle()
 {
+    m_poParallelReader.reset();
+
     if( m_pszBaseFileName && m_bCanSaveInfo )
     {
         VSIFilesystemHandler *poFSHandler =
@@ -613,12 +750,898 @@ int VSIGZipHandle::gzrewind ()
     return VSIFSeekL(reinterpret_cast<VSILFILE*>(m_poBaseHandle), startOff, SEEK_SET);
 }
 
+/************************************************************************/
+/*                       GZipIndex::FindPoint()                         */
+/************************************************************************/
+
+// Returns the last access point whose uncompressed offset is <= nOffset.
+const GZipAccessPoint* GZipIndex::FindPoint( vsi_l_offset nOffset ) const
+{
+    auto oIter = std::upper_bound(
+        aoPoints.begin(), aoPoints.end(), nOffset,
+        [](vsi_l_offset nVal, const GZipAccessPoint& oPoint)
+        { return nVal < oPoint.out; });
+    if( oIter == aoPoints.begin() )
+        return nullptr;
+    --oIter;
+    return &(*oIter);
+}
+
+/************************************************************************/
+/*                           EnableIndex()                              */
+/************************************************************************/
+
+void VSIGZipHandle::EnableIndex()
+{
+    if( m_transparent || m_pszBaseFileName == nullptr )
+        return;
+    m_bUseIndex = true;
+    m_nIndexSpan = static_cast<vsi_l_offset>(std::max(
+        static_cast<GIntBig>(GZIP_INDEX_WINDOW_SIZE),
+        CPLAtoGIntBig(CPLGetConfigOption("CPL_VSIL_GZIP_INDEX_SPAN",
+                                         "1048576"))));
+    if( LoadIndex() && m_poIndex->uncompressed_size != 0 &&
+        m_uncompressed_size == 0 )
+    {
+        m_uncompressed_size = m_poIndex->uncompressed_size;
+    }
+}
+
+/************************************************************************/
+/*                         GetIndexFilename()                           */
+/************************************************************************/
+
+CPLString VSIGZipHandle::GetIndexFilename() const
+{
+    const char* pszDir = CPLGetConfigOption("CPL_VSIL_GZIP_INDEX_DIR", nullptr);
+    if( pszDir == nullptr || pszDir[0] == '\0' )
+        return CPLString(m_pszBaseFileName) + ".gzidx";
+
+    // Several files may share the same basename, so add a hash of the
+    // full filename.
+    GByte abyHash[CPL_SHA256_HASH_SIZE];
+    CPL_SHA256(m_pszBaseFileName, strlen(m_pszBaseFileName), abyHash);
+    CPLString osHash;
+    for( int i = 0; i < 8; i++ )
+        osHash += CPLSPrintf("%02x", abyHash[i]);
+    return CPLFormFilename(
+        pszDir,
+        (CPLString(CPLGetFilename(m_pszBaseFileName)) + "_" + osHash).c_str(),
+        "gzidx");
+}
+
+/************************************************************************/
+/*                       GetBaseFileSignature()                         */
+/************************************************************************/
+
+bool VSIGZipHandle::GetBaseFileSignature( vsi_l_offset& nMTime ) const
+{
+    VSIStatBufL sStat;
+    if( VSIStatL(m_pszBaseFileName, &sStat) != 0 )
+        return false;
+    nMTime = static_cast<vsi_l_offset>(sStat.st_mtime);
+    return true;
+}
+
+/************************************************************************/
+/*                             LoadIndex()                              */
+/************************************************************************/
+
+// Layout of the index file, all integers being little-endian:
+// - "GDALGZI1" magic
+// - uint64 compressed size, uint64 modification time of the .gz file
+// - uint64 offset of the deflate stream, uint64 uncompressed size (or 0)
+// - uint32 number of access points, followed for each of them by
+//   uint64 in, uint64 out, uint32 crc, uint32 bits, uint32 window size
+//   and the deflated window.
+
+static const char GZIP_INDEX_MAGIC[] = "GDALGZI1";
+
+bool VSIGZipHandle::LoadIndex()
+{
+    vsi_l_offset nMTime = 0;
+    if( !GetBaseFileSignature(nMTime) )
+        return false;
+
+    const CPLString osIndexFilename(GetIndexFilename());
+    VSILFILE* fp = VSIFOpenL(osIndexFilename, "rb");
+    if( fp == nullptr )
+        return false;
+
+    const auto ReadUInt64 = [fp](vsi_l_offset& nVal)
+    {
+        GUInt64 nTmp = 0;
+        if( VSIFReadL(&nTmp, sizeof(nTmp), 1, fp) != 1 )
+            return false;
+        CPL_LSBPTR64(&nTmp);
+        nVal = static_cast<vsi_l_offset>(nTmp);
+        return true;
+    };
+    const auto ReadUInt32 = [fp](GUInt32& nVal)
+    {
+        if( VSIFReadL(&nVal, sizeof(nVal), 1, fp) != 1 )
+            return false;
+        CPL_LSBPTR32(&nVal);
+        return true;
+    };
+
+    auto poIndex = std::make_shared<GZipIndex>();
+    bool bOK = false;
+    char szMagic[8] = {};
+    vsi_l_offset nCompressedSize = 0;
+    vsi_l_offset nIndexMTime = 0;
+    GUInt32 nPoints = 0;
+    if( VSIFReadL(szMagic, 8, 1, fp) == 1 &&
+        memcmp(szMagic, GZIP_INDEX_MAGIC, 8) == 0 &&
+        ReadUInt64(nCompressedSize) && ReadUInt64(nIndexMTime) &&
+        ReadUInt64(poIndex->startOff) &&
+        ReadUInt64(poIndex->uncompressed_size) &&
+        ReadUInt32(nPoints) &&
+        nCompressedSize == m_compressed_size && nIndexMTime == nMTime &&
+        poIndex->startOff == startOff )
+    {
+        bOK = true;
+        for( GUInt32 i = 0; bOK && i < nPoints; i++ )
+        {
+            GZipAccessPoint oPoint;
+            GUInt32 nCRC = 0;
+            GUInt32 nBits = 0;
+            GUInt32 nWindowSize = 0;
+            bOK = ReadUInt64(oPoint.in) && ReadUInt64(oPoint.out) &&
+                  ReadUInt32(nCRC) && ReadUInt32(nBits) &&
+                  ReadUInt32(nWindowSize) && nBits < 8 &&
+                  nWindowSize <= 2 * GZIP_INDEX_WINDOW_SIZE &&
+                  oPoint.in > startOff && oPoint.in <= offsetEndCompressedData &&
+                  (poIndex->aoPoints.empty() ||
+                   oPoint.out > poIndex->aoPoints.back().out);
+            if( bOK )
+            {
+                oPoint.crc = nCRC;
+                oPoint.bits = static_cast<int>(nBits);
+                oPoint.abyCompressedWindow.resize(nWindowSize);
+                bOK = VSIFReadL(oPoint.abyCompressedWindow.data(), 1,
+                                nWindowSize, fp) == nWindowSize;
+                poIndex->aoPoints.emplace_back(std::move(oPoint));
+            }
+        }
+    }
+    CPL_IGNORE_RET_VAL(VSIFCloseL(fp));
+
+    if( !bOK )
+    {
+        CPLDebug("GZIP", "Ignoring invalid or outdated index %s",
+                 osIndexFilename.c_str());
+        return false;
+    }
+    CPLDebug("GZIP", "Using index %s with %d access points",
+             osIndexFilename.c_str(), static_cast<int>(nPoints));
+    m_poIndex = std::move(poIndex);
+    return true;
+}
+
+/************************************************************************/
+/*                             SaveIndex()                              */
+/************************************************************************/
+
+void VSIGZipHandle::SaveIndex() const
+{
+    // Do not create sidecar files next to remote files, unless explicitly
+    // asked to through CPL_VSIL_GZIP_INDEX_DIR.
+    const char* pszDir = CPLGetConfigOption("CPL_VSIL_GZIP_INDEX_DIR", nullptr);
+    if( (pszDir == nullptr || pszDir[0] == '\0') &&
+        STARTS_WITH_CI(m_pszBaseFileName, "/vsi") &&
+        !STARTS_WITH_CI(m_pszBaseFileName, "/vsimem/") )
+    {
+        return;
+    }
+
+    vsi_l_offset nMTime = 0;
+    if( !GetBaseFileSignature(nMTime) )
+        return;
+
+    // Write in a temporary file that is then renamed, so that concurrent
+    // readers never see a partial index.
+    const CPLString osIndexFilename(GetIndexFilename());
+    const CPLString osTmpFilename(
+        osIndexFilename + CPLSPrintf(".tmp" CPL_FRMT_GIB,
+                                     static_cast<GIntBig>(CPLGetPID())));
+    VSILFILE* fp = VSIFOpenL(osTmpFilename, "wb");
+    if( fp == nullptr )
+    {
+        CPLDebug("GZIP", "Cannot create %s", osTmpFilename.c_str());
+        return;
+    }
+
+    const auto WriteUInt64 = [fp](vsi_l_offset nVal)
+    {
+        GUInt64 nTmp = static_cast<GUInt64>(nVal);
+        CPL_LSBPTR64(&nTmp);
+        return VSIFWriteL(&nTmp, sizeof(nTmp), 1, fp) == 1;
+    };
+    const auto WriteUInt32 = [fp](GUInt32 nVal)
+    {
+        CPL_LSBPTR32(&nVal);
+        return VSIFWriteL(&nVal, sizeof(nVal), 1, fp) == 1;
+    };
+
+    bool bOK =
+        VSIFWriteL(GZIP_INDEX_MAGIC, 8, 1, fp) == 1 &&
+        WriteUInt64(m_compressed_size) && WriteUInt64(nMTime) &&
+        WriteUInt64(m_poIndex->startOff) &&
+        WriteUInt64(m_poIndex->uncompressed_size) &&
+        WriteUInt32(static_cast<GUInt32>(m_poIndex->aoPoints.size()));
+    for( const auto& oPoint: m_poIndex->aoPoints )
+    {
+        if( !bOK )
+            break;
+        bOK = WriteUInt64(oPoint.in) && WriteUInt64(oPoint.out) &&
+              WriteUInt32(static_cast<GUInt32>(oPoint.crc)) &&
+              WriteUInt32(static_cast<GUInt32>(oPoint.bits)) &&
+              WriteUInt32(static_cast<GUInt32>(
+                  oPoint.abyCompressedWindow.size())) &&
+              VSIFWriteL(oPoint.abyCompressedWindow.data(), 1,
+                         oPoint.abyCompressedWindow.size(), fp) ==
+                  oPoint.abyCompressedWindow.size();
+    }
+    if( VSIFCloseL(fp) != 0 )
+        bOK = false;
+
+    if( !bOK || VSIRename(osTmpFilename, osIndexFilename) != 0 )
+    {
+        CPLDebug("GZIP", "Cannot write %s", osIndexFilename.c_str());
+        VSIUnlink(osTmpFilename);
+    }
+}
+
+/************************************************************************/
+/*                             BuildIndex()                             */
+/************************************************************************/
+
+// Inflates the first member of the .gz file in a single pass, and records
+// an access point at the first deflate block boundary after each span of
+// m_nIndexSpan uncompressed bytes.
+
+bool VSIGZipHandle::BuildIndex()
+{
+    VSILFILE* fp = VSIFOpenL(m_pszBaseFileName, "rb");
+    if( fp == nullptr )
+        return false;
+
+    z_stream sStream;
+    memset(&sStream, 0, sizeof(sStream));
+    if( inflateInit2(&sStream, -MAX_WBITS) != Z_OK )
+    {
+        CPL_IGNORE_RET_VAL(VSIFCloseL(fp));
+        return false;
+    }
+
+    auto poIndex = std::make_shared<GZipIndex>();
+    poIndex->startOff = startOff;
+
+    std::vector<GByte> abyIn(Z_BUFSIZE);
+    std::vector<GByte> abyWindow(GZIP_INDEX_WINDOW_SIZE);
+    std::vector<GByte> abyLinearWindow(GZIP_INDEX_WINDOW_SIZE);
+    vsi_l_offset nPosInFile = startOff;
+    vsi_l_offset nTotalIn = 0;  // Relative to startOff.
+    vsi_l_offset nTotalOut = 0;
+    vsi_l_offset nLastPointOut = 0;
+    uLong nCRC = 0;
+    int ret = Z_OK;
+    bool bOK = VSIFSeekL(fp, startOff, SEEK_SET) == 0;
+    while( bOK && ret != Z_STREAM_END )
+    {
+        if( sStream.avail_in == 0 )
+        {
+            const size_t nToRead = static_cast<size_t>(std::min(
+                static_cast<vsi_l_offset>(Z_BUFSIZE),
+                offsetEndCompressedData - nPosInFile));
+            const size_t nRead = VSIFReadL(abyIn.data(), 1, nToRead, fp);
+            if( nRead == 0 )
+            {
+                bOK = false;
+                break;
+            }
+            nPosInFile += nRead;
+            sStream.avail_in = static_cast<uInt>(nRead);
+            sStream.next_in = abyIn.data();
+        }
+
+        do
+        {
+            if( sStream.avail_out == 0 )
+            {
+                sStream.avail_out = GZIP_INDEX_WINDOW_SIZE;
+                sStream.next_out = abyWindow.data();
+            }
+            Bytef* pabyStart = sStream.next_out;
+            nTotalIn += sStream.avail_in;
+            nTotalOut += sStream.avail_out;
+            ret = inflate(&sStream, Z_BLOCK);
+            nTotalIn -= sStream.avail_in;
+            nTotalOut -= sStream.avail_out;
+            nCRC = crc32(nCRC, pabyStart,
+                         static_cast<uInt>(sStream.next_out - pabyStart));
+            if( ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR )
+            {
+                bOK = false;
+                break;
+            }
+            if( ret == Z_STREAM_END )
+                break;
+
+            // Bit 7 of data_type set means a block boundary, bit 6 set that
+            // this is the end of the last block.
+            if( (sStream.data_type & 128) && !(sStream.data_type & 64) &&
+                nTotalOut - nLastPointOut > m_nIndexSpan )
+            {
+                GZipAccessPoint oPoint;
+                oPoint.in = startOff + nTotalIn;
+                oPoint.out = nTotalOut;
+                oPoint.bits = sStream.data_type & 7;
+                oPoint.crc = nCRC;
+
+                // Linearize the circular window.
+                const uInt nLeft = sStream.avail_out;
+                memcpy(abyLinearWindow.data(),
+                       abyWindow.data() + GZIP_INDEX_WINDOW_SIZE - nLeft,
+                       nLeft);
+                memcpy(abyLinearWindow.data() + nLeft, abyWindow.data(),
+                       GZIP_INDEX_WINDOW_SIZE - nLeft);
+
+                uLongf nCompressedSize = compressBound(GZIP_INDEX_WINDOW_SIZE);
+                oPoint.abyCompressedWindow.resize(nCompressedSize);
+                if( compress2(oPoint.abyCompressedWindow.data(),
+                              &nCompressedSize, abyLinearWindow.data(),
+                              GZIP_INDEX_WINDOW_SIZE, Z_BEST_SPEED) != Z_OK )
+                {
+                    bOK = false;
+                    break;
+                }
+                oPoint.abyCompressedWindow.resize(nCompressedSize);
+                poIndex->aoPoints.emplace_back(std::move(oPoint));
+                nLastPointOut = nTotalOut;
+            }
+        } while( sStream.avail_in != 0 );
+    }
+    inflateEnd(&sStream);
+
+    // Check the trailer. The uncompressed size is only known if the file
+    // is made of a single member.
+    GUInt32 anTrailer[2] = { 0, 0 };
+    if( bOK &&
+        (VSIFSeekL(fp, startOff + nTotalIn, SEEK_SET) != 0 ||
+         VSIFReadL(anTrailer, sizeof(anTrailer), 1, fp) != 1) )
+    {
+        bOK = false;
+    }
+    CPL_IGNORE_RET_VAL(VSIFCloseL(fp));
+    if( bOK )
+    {
+        CPL_LSBPTR32(&anTrailer[0]);
+        CPL_LSBPTR32(&anTrailer[1]);
+        bOK = anTrailer[0] == static_cast<GUInt32>(nCRC);
+    }
+    if( !bOK )
+    {
+        CPLDebug("GZIP", "Cannot build index of %s", m_pszBaseFileName);
+        return false;
+    }
+    if( startOff + nTotalIn + 8 == offsetEndCompressedData &&
+        anTrailer[1] == static_cast<GUInt32>(nTotalOut & 0xFFFFFFFFU) )
+    {
+        poIndex->uncompressed_size = nTotalOut;
+    }
+
+    CPLDebug("GZIP", "Built index of %s with %d access points",
+             m_pszBaseFileName, static_cast<int>(poIndex->aoPoints.size()));
+    m_poIndex = std::move(poIndex);
+    return true;
+}
+
+/************************************************************************/
+/*                        RestoreAccessPoint()                          */
+/************************************************************************/
+
+bool VSIGZipHandle::RestoreAccessPoint( const GZipAccessPoint& oPoint )
+{
+    std::vector<GByte> abyWindow(GZIP_INDEX_WINDOW_SIZE);
+    uLongf nWindowSize = GZIP_INDEX_WINDOW_SIZE;
+    if( uncompress(abyWindow.data(), &nWindowSize,
+                   oPoint.abyCompressedWindow.data(),
+                   static_cast<uLong>(oPoint.abyCompressedWindow.size()))
+                                                                != Z_OK ||
+        nWindowSize != GZIP_INDEX_WINDOW_SIZE )
+    {
+        return false;
+    }
+
+    VSILFILE* fp = reinterpret_cast<VSILFILE*>(m_poBaseHandle);
+    if( VSIFSeekL(fp, oPoint.in - (oPoint.bits ? 1 : 0), SEEK_SET) != 0 )
+        return false;
+    if( inflateReset(&stream) != Z_OK )
+        return false;
+    if( oPoint.bits )
+    {
+        GByte byVal = 0;
+        if( VSIFReadL(&byVal, 1, 1, fp) != 1 ||
+            inflatePrime(&stream, oPoint.bits,
+                         byVal >> (8 - oPoint.bits)) != Z_OK )
+        {
+            return false;
+        }
+    }
+    if( inflateSetDictionary(&stream, abyWindow.data(),
+                             GZIP_INDEX_WINDOW_SIZE) != Z_OK )
+    {
+        return false;
+    }
+
+    stream.avail_in = 0;
+    stream.next_in = inbuf;
+    z_err = Z_OK;
+    z_eof = 0;
+    crc = oPoint.crc;
+    in = oPoint.in - startOff;
+    out = oPoint.out;
+    return true;
+}
+
+/************************************************************************/
+/*                       VSIGZipParallelReader()                        */
+/************************************************************************/
+
+// Sequence of the two empty stored blocks emitted by Z_SYNC_FLUSH followed
+// by Z_FULL_FLUSH, after which the dictionary is reset.
+static const GByte GZIP_FULL_FLUSH_MARKER[] =
+    { 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0xFF, 0xFF };
+
+// In marker mode, chunks are made of at least that many compressed bytes,
+// and we give up if no marker is found in that many bytes.
+constexpr size_t GZIP_MIN_CHUNK_SIZE = 256 * 1024;
+constexpr size_t GZIP_MAX_CHUNK_SIZE = 8 * 1024 * 1024;
+
+VSIGZipParallelReader::VSIGZipParallelReader(
+    VSIVirtualHandle* poBaseHandle,
+    vsi_l_offset nStartOff,
+    vsi_l_offset nEndCompressedData,
+    bool bHasGZipTrailer,
+    uLong nExpectedCRC,
+    const std::shared_ptr<const GZipIndex>& poIndex ) :
+    m_poBaseHandle(poBaseHandle),
+    m_nStartOff(nStartOff),
+    m_nEndCompressedData(nEndCompressedData),
+    m_bHasGZipTrailer(bHasGZipTrailer),
+    m_nExpectedCRC(nExpectedCRC),
+    m_poIndex(poIndex),
+    m_nNextInPos(nStartOff)
+{
+}
+
+/************************************************************************/
+/*                      ~VSIGZipParallelReader()                        */
+/************************************************************************/
+
+VSIGZipParallelReader::~VSIGZipParallelReader()
+{
+    if( m_poJobQueue )
+        m_poJobQueue->WaitCompletion();
+}
+
+/************************************************************************/
+/*                               Init()                                 */
+/************************************************************************/
+
+bool VSIGZipParallelReader::Init( int nThreads, vsi_l_offset nStartOut )
+{
+    // Inflating is CPU-bound: use the shared pool, with at most nThreads
+    // running jobs.
+    CPLWorkerThreadPool* poPool = CPLGetGlobalWorkerThreadPool(nThreads);
+    if( poPool == nullptr )
+        return false;
+    m_nThreads = nThreads;
+    m_poJobQueue = poPool->CreateJobQueue(nThreads);
+    if( m_poIndex )
+    {
+        const GZipAccessPoint* poPoint = m_poIndex->FindPoint(nStartOut);
+        if( poPoint )
+        {
+            m_nNextPoint = static_cast<int>(poPoint - &m_poIndex->aoPoints[0]);
+            m_nJobStartOut = poPoint->out;
+            m_nCRC = poPoint->crc;
+        }
+        // Skipped once the first chunk is decompressed.
+        m_nPosInJob = static_cast<size_t>(nStartOut - m_nJobStartOut);
+    }
+    else if( nStartOut != 0 )
+    {
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                           DecompressJob()                            */
+/************************************************************************/
+
+void VSIGZipParallelReader::DecompressJob( void* pData )
+{
+    Job* psJob = static_cast<Job*>(pData);
+
+    z_stream sStream;
+    memset(&sStream, 0, sizeof(sStream));
+    if( inflateInit2(&sStream, -MAX_WBITS) != Z_OK )
+    {
+        psJob->bError = true;
+        psJob->bFinished = true;
+        return;
+    }
+
+    size_t nInOffset = 0;
+    bool bOK = true;
+    if( psJob->poPoint )
+    {
+        const GZipAccessPoint* poPoint = psJob->poPoint;
+        if( poPoint->bits )
+        {
+            bOK = !psJob->abyIn.empty() &&
+                  inflatePrime(&sStream, poPoint->bits,
+                        psJob->abyIn[0] >> (8 - poPoint->bits)) == Z_OK;
+            nInOffset = 1;
+        }
+        std::vector<GByte> abyWindow(GZIP_INDEX_WINDOW_SIZE);
+        uLongf nWindowSize = GZIP_INDEX_WINDOW_SIZE;
+        bOK = bOK &&
+              uncompress(abyWindow.data(), &nWindowSize,
+                         poPoint->abyCompressedWindow.data(),
+                         static_cast<uLong>(
+                             poPoint->abyCompressedWindow.size())) == Z_OK &&
+              nWindowSize == GZIP_INDEX_WINDOW_SIZE &&
+              inflateSetDictionary(&sStream, abyWindow.data(),
+                                   GZIP_INDEX_WINDOW_SIZE) == Z_OK;
+    }
+
+    psJob->abyOut.resize(psJob->nExpectedOut ? psJob->nExpectedOut :
+                         std::max(static_cast<size_t>(Z_BUFSIZE),
+                                  4 * psJob->abyIn.size()));
+    size_t nOut = 0;
+    sStream.next_in = psJob->abyIn.data() + nInOffset;
+    sStream.avail_in = static_cast<uInt>(psJob->abyIn.size() - nInOffset);
+    while( bOK )
+    {
+        sStream.next_out = psJob->abyOut.data() + nOut;
+        sStream.avail_out = static_cast<uInt>(psJob->abyOut.size() - nOut);
+        const int ret = inflate(&sStream, Z_NO_FLUSH);
+        nOut = psJob->abyOut.size() - sStream.avail_out;
+        if( ret == Z_STREAM_END )
+        {
+            psJob->bStreamEnd = true;
+            break;
+        }
+        if( ret != Z_OK && ret != Z_BUF_ERROR )
+        {
+            bOK = false;
+            break;
+        }
+        if( sStream.avail_out != 0 || psJob->nExpectedOut != 0 )
+            break;
+        psJob->abyOut.resize(2 * psJob->abyOut.size());
+    }
+    psJob->abyOut.resize(nOut);
+    psJob->nConsumedIn = psJob->abyIn.size() - sStream.avail_in;
+
+    if( psJob->nExpectedOut != 0 )
+    {
+        bOK = bOK && nOut == psJob->nExpectedOut;
+    }
+    else if( psJob->bEndsAtMarker )
+    {
+        // The whole input must have been consumed, and we must be at a byte
+        // aligned block boundary, otherwise the marker was a false positive.
+        bOK = bOK && !psJob->bStreamEnd && sStream.avail_in == 0 &&
+              (sStream.data_type & 128) != 0 && (sStream.data_type & 7) == 0;
+    }
+    else
+    {
+        bOK = bOK && psJob->bStreamEnd;
+    }
+    inflateEnd(&sStream);
+
+    if( bOK )
+    {
+        psJob->nCRC = crc32(0, psJob->abyOut.data(),
+                            static_cast<uInt>(psJob->abyOut.size()));
+    }
+    psJob->bError = !bOK;
+    psJob->bFinished = true;
+}
+
+/************************************************************************/
+/*                        PrepareNextJobInput()                         */
+/************************************************************************/
+
+bool VSIGZipParallelReader::PrepareNextJobInput( Job& oJob )
+{
+    VSILFILE* fp = reinterpret_cast<VSILFILE*>(m_poBaseHandle);
+
+    if( m_poIndex )
+    {
+        const auto& aoPoints = m_poIndex->aoPoints;
+        const int nPoints = static_cast<int>(aoPoints.size());
+        vsi_l_offset nStart = m_nStartOff;
+        vsi_l_offset nStartOut = 0;
+        if( m_nNextPoint >= 0 )
+        {
+            const GZipAccessPoint& oPoint = aoPoints[m_nNextPoint];
+            oJob.poPoint = &oPoint;
+            nStart = oPoint.in - (oPoint.bits ? 1 : 0);
+            nStartOut = oPoint.out;
+        }
+        vsi_l_offset nEnd = m_nEndCompressedData;
+        if( m_nNextPoint + 1 < nPoints )
+        {
+            const GZipAccessPoint& oNextPoint = aoPoints[m_nNextPoint + 1];
+            nEnd = oNextPoint.in;
+            oJob.nExpectedOut =
+                static_cast<size_t>(oNextPoint.out - nStartOut);
+        }
+        else
+        {
+            m_bNoMoreJobs = true;
+        }
+        m_nNextPoint++;
+
+        if( nEnd <= nStart )
+            return false;
+        oJob.abyIn.resize(static_cast<size_t>(nEnd - nStart));
+        return VSIFSeekL(fp, nStart, SEEK_SET) == 0 &&
+               VSIFReadL(oJob.abyIn.data(), 1, oJob.abyIn.size(), fp) ==
+                   oJob.abyIn.size();
+    }
+
+    // Marker mode: accumulate compressed data until a marker is found.
+    const GByte* pabyMarkerBegin = GZIP_FULL_FLUSH_MARKER;
+    const GByte* pabyMarkerEnd =
+        GZIP_FULL_FLUSH_MARKER + sizeof(GZIP_FULL_FLUSH_MARKER);
+    while( true )
+    {
+        if( m_abyPending.size() >= GZIP_MIN_CHUNK_SIZE )
+        {
+            const size_t nScanFrom = std::max(m_nScanPos,
+                                              GZIP_MIN_CHUNK_SIZE -
+                                              sizeof(GZIP_FULL_FLUSH_MARKER));
+            auto oIter = std::search(m_abyPending.begin() + nScanFrom,
+                                     m_abyPending.end(),
+                                     pabyMarkerBegin, pabyMarkerEnd);
+            if( oIter != m_abyPending.end() )
+            {
+                const size_t nChunkSize = static_cast<size_t>(
+                    oIter - m_abyPending.begin()) +
+                    sizeof(GZIP_FULL_FLUSH_MARKER);
+                oJob.abyIn.assign(m_abyPending.begin(),
+                                  m_abyPending.begin() + nChunkSize);
+                oJob.bEndsAtMarker = true;
+                m_abyPending.erase(m_abyPending.begin(),
+                                   m_abyPending.begin() + nChunkSize);
+                m_nScanPos = 0;
+                return true;
+            }
+            m_nScanPos = m_abyPending.size() - sizeof(GZIP_FULL_FLUSH_MARKER);
+        }
+
+        if( m_nNextInPos == m_nEndCompressedData )
+        {
+            // Last chunk, or nothing if the previous one ended the stream
+            // (which is then detected as truncated).
+            oJob.abyIn = std::move(m_abyPending);
+            m_abyPending.clear();
+            m_bNoMoreJobs = true;
+            return true;
+        }
+        if( m_abyPending.size() >= GZIP_MAX_CHUNK_SIZE )
+        {
+            CPLDebug("GZIP", "No full flush marker found: not a stream made "
+                     "of independent chunks");
+            return false;
+        }
+
+        const size_t nToRead = static_cast<size_t>(std::min(
+            static_cast<vsi_l_offset>(GZIP_MIN_CHUNK_SIZE),
+            m_nEndCompressedData - m_nNextInPos));
+        const size_t nOldSize = m_abyPending.size();
+        m_abyPending.resize(nOldSize + nToRead);
+        if( VSIFSeekL(fp, m_nNextInPos, SEEK_SET) != 0 ||
+            VSIFReadL(m_abyPending.data() + nOldSize, 1, nToRead, fp) !=
+                nToRead )
+        {
+            return false;
+        }
+        m_nNextInPos += nToRead;
+    }
+}
+
+/************************************************************************/
+/*                             FillQueue()                              */
+/************************************************************************/
+
+bool VSIGZipParallelReader::FillQueue()
+{
+    const size_t nMaxJobs = 2 * static_cast<size_t>(m_nThreads);
+    while( !m_bNoMoreJobs && m_apoJobs.size() < nMaxJobs )
+    {
+        std::unique_ptr<Job> poJob(new Job());
+        if( !PrepareNextJobInput(*poJob) )
+            return false;
+        if( poJob->abyIn.empty() )
+            break;
+        if( !m_poJobQueue->SubmitJob(DecompressJob, poJob.get()) )
+            return false;
+        m_apoJobs.emplace_back(std::move(poJob));
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                          PrepareFrontJob()                           */
+/************************************************************************/
+
+bool VSIGZipParallelReader::PrepareFrontJob()
+{
+    if( !FillQueue() || m_apoJobs.empty() )
+    {
+        m_bFailed = true;
+        return false;
+    }
+
+    Job* psJob = m_apoJobs.front().get();
+    while( !psJob->bFinished )
+        m_poJobQueue->WaitEvent();
+    if( psJob->bError || m_nPosInJob > psJob->abyOut.size() )
+    {
+        m_bFailed = true;
+        return false;
+    }
+
+    if( psJob->bStreamEnd )
+    {
+        // Same checks as the single-threaded code: CRC, and detection of
+        // concatenated members, which we do not handle.
+        const uLong nCRC = crc32_combine(m_nCRC, psJob->nCRC,
+                                         static_cast<z_off_t>(
+                                             psJob->abyOut.size()));
+        const size_t nRemaining = psJob->abyIn.size() - psJob->nConsumedIn;
+        if( m_bHasGZipTrailer )
+        {
+            GUInt32 nReadCRC = 0;
+            if( nRemaining < 8 )
+            {
+                m_bFailed = true;
+                return false;
+            }
+            memcpy(&nReadCRC, psJob->abyIn.data() + psJob->nConsumedIn, 4);
+            CPL_LSBPTR32(&nReadCRC);
+            if( nReadCRC != static_cast<GUInt32>(nCRC) )
+            {
+                m_bFailed = true;
+                return false;
+            }
+            m_bMoreMembers = nRemaining > 8 || !m_abyPending.empty() ||
+                             (m_poIndex == nullptr &&
+                              m_nNextInPos != m_nEndCompressedData);
+        }
+        else if( m_nExpectedCRC != 0 && m_nExpectedCRC != nCRC )
+        {
+            m_bFailed = true;
+            return false;
+        }
+    }
+    else if( m_bNoMoreJobs && m_apoJobs.size() == 1 )
+    {
+        // Truncated stream.
+        m_bFailed = true;
+        return false;
+    }
+
+    m_bFrontReady = true;
+    return true;
+}
+
+/************************************************************************/
+/*                                Read()                                */
+/************************************************************************/
+
+size_t VSIGZipParallelReader::Read( void* pBuffer, size_t nBytes )
+{
+    GByte* pabyBuffer = static_cast<GByte*>(pBuffer);
+    size_t nDone = 0;
+    while( nDone < nBytes && !m_bFailed && !m_bEOF )
+    {
+        if( !m_bFrontReady && !PrepareFrontJob() )
+            break;
+
+        Job* psJob = m_apoJobs.front().get();
+        const size_t nAvail = psJob->abyOut.size() - m_nPosInJob;
+        if( nAvail == 0 )
+        {
+            if( psJob->bStreamEnd )
+            {
+                if( m_bMoreMembers )
+                    m_bFailed = true;
+                else
+                    m_bEOF = true;
+                break;
+            }
+            m_nCRC = crc32_combine(m_nCRC, psJob->nCRC,
+                                   static_cast<z_off_t>(psJob->abyOut.size()));
+            m_nJobStartOut += psJob->abyOut.size();
+            m_nPosInJob = 0;
+            m_apoJobs.pop_front();
+            m_bFrontReady = false;
+            continue;
+        }
+
+        const size_t nToCopy = std::min(nAvail, nBytes - nDone);
+        memcpy(pabyBuffer + nDone, psJob->abyOut.data() + m_nPosInJob,
+               nToCopy);
+        m_nPosInJob += nToCopy;
+        nDone += nToCopy;
+    }
+    return nDone;
+}
+
+/************************************************************************/
+/*                                Seek()                                */
+/************************************************************************/
+
+// Only seeks within the chunk being read are handled.
+
+bool VSIGZipParallelReader::Seek( vsi_l_offset nOffset )
+{
+    if( m_bFailed )
+        return false;
+    if( nOffset == Tell() )
+        return true;
+    if( !m_bFrontReady || nOffset < m_nJobStartOut ||
+        nOffset > m_nJobStartOut + m_apoJobs.front()->abyOut.size() )
+    {
+        return false;
+    }
+    m_nPosInJob = static_cast<size_t>(nOffset - m_nJobStartOut);
+    m_bEOF = false;
+    return true;
+}
+
 /************************************************************************/
 /*                              Seek()                                  */
 /************************************************************************/
 
 int VSIGZipHandle::Seek( vsi_l_offset nOffset, int nWhence )
 {
+    if( m_poParallelReader )
+    {
+        vsi_l_offset nTarget = 0;
+        bool bKnownTarget = true;
+        if( nWhence == SEEK_SET )
+            nTarget = nOffset;
+        else if( nWhence == SEEK_CUR )
+            nTarget = m_poParallelReader->Tell() + nOffset;
+        else if( nWhence == SEEK_END && nOffset == 0 &&
+                 m_uncompressed_size != 0 )
+            nTarget = m_uncompressed_size;
+        else
+            bKnownTarget = false;
+        if( bKnownTarget && m_poParallelReader->Seek(nTarget) )
+            return 0;
+
+        // Out of the data decompressed ahead: resume from the
+        // single-threaded state.
+        if( nWhence == SEEK_CUR )
+        {
+            nOffset = nTarget;
+            nWhence = SEEK_SET;
+        }
+        StopParallelRead();
+    }
+
     /* The semantics of gzseek are different from ::Seek */
     /* It returns the current offset, where as ::Seek should return 0 */
     /* if successful */
@@ -748,6 +1771,43 @@ int VSIGZipHandle::gzseek( vsi_l_offset offset, int whence )
         return -1L;
     }
 
+    if( m_bUseIndex )
+    {
+        const vsi_l_offset nTarget = out + offset;
+        // Building the index costs a full decompression pass, so only do
+        // it when it is going to save a significant amount of inflation,
+        // and make it reusable by the next openings of the file.
+        if( m_poIndex == nullptr && !m_bIndexBuildTried &&
+            offset > m_nIndexSpan )
+        {
+            m_bIndexBuildTried = true;
+            if( BuildIndex() )
+                SaveIndex();
+            if( m_poIndex && m_uncompressed_size == 0 )
+                m_uncompressed_size = m_poIndex->uncompressed_size;
+        }
+        const GZipAccessPoint* poPoint =
+            m_poIndex ? m_poIndex->FindPoint(nTarget) : nullptr;
+        if( poPoint && poPoint->out > out )
+        {
+            if( RestoreAccessPoint(*poPoint) )
+            {
+                offset = nTarget - out;
+            }
+            else
+            {
+                CPLDebug("GZIP", "Cannot restore index access point");
+                m_poIndex.reset();
+                if( gzrewind() < 0 )
+                {
+                    CPL_VSIL_GZ_RETURN(-1);
+                    return -1L;
+                }
+                offset = nTarget;
+            }
+        }
+    }
+
     for( unsigned int i = 0;
          i < m_compressed_size / snapshot_byte_interval + 1;
          i++ )
@@ -814,7 +1874,7 @@ int VSIGZipHandle::gzseek( vsi_l_offset offset, int whence )
             size = static_cast<int>(offset);
 
         int read_size =
-            static_cast<int>(Read(outbuf, 1, static_cast<uInt>(size)));
+            static_cast<int>(gzread(outbuf, 1, static_cast<uInt>(size)));
         if( read_size == 0 )
         {
             // CPL_VSIL_GZ_RETURN(-1);
@@ -879,18 +1939,108 @@ int VSIGZipHandle::gzseek( vsi_l_offset offset, int whence )
 
 vsi_l_offset VSIGZipHandle::Tell()
 {
+    if( m_poParallelReader )
+        return m_poParallelReader->Tell();
 #ifdef ENABLE_DEBUG
     CPLDebug("GZIP", "Tell() = " CPL_FRMT_GUIB, out);
 #endif
     return out;
 }
 
+/************************************************************************/
+/*                          StartParallelRead()                         */
+/************************************************************************/
+
+bool VSIGZipHandle::StartParallelRead()
+{
+    // Chunk boundaries are only known from the start of the stream, unless
+    // there is an index.
+    if( m_nReadThreads <= 1 || m_transparent || m_bParallelReadDisabled ||
+        z_err != Z_OK || m_compressed_size < 1024 * 1024 )
+    {
+        return false;
+    }
+    // An index that does not cover the whole stream (concatenated members)
+    // would make the last chunk extend to the end of the file.
+    // Elsewhere than at the start, wait for the reads to look sequential,
+    // not to decompress ahead at each random access.
+    std::shared_ptr<const GZipIndex> poIndex;
+    if( m_poIndex && m_poIndex->uncompressed_size != 0 )
+        poIndex = m_poIndex;
+    if( out != 0 &&
+        (poIndex == nullptr || out != m_nSequentialReadEnd ||
+         out - m_nSequentialReadStart < m_nIndexSpan) )
+    {
+        return false;
+    }
+    std::unique_ptr<VSIGZipParallelReader> poReader(
+        new VSIGZipParallelReader(m_poBaseHandle, startOff,
+                                  offsetEndCompressedData,
+                                  m_expected_crc == 0, m_expected_crc,
+                                  poIndex));
+    if( !poReader->Init(m_nReadThreads, out) )
+        return false;
+    CPLDebug("GZIP", "Decompressing with %d threads from " CPL_FRMT_GUIB
+             " (%s)", m_nReadThreads, out,
+             poIndex ? "using index" : "using full flush markers");
+    m_poParallelReader = std::move(poReader);
+    return true;
+}
+
+/************************************************************************/
+/*                          StopParallelRead()                          */
+/************************************************************************/
+
+// Restores the single-threaded state at the position of the parallel
+// reader, which has moved the base handle in the meantime.
+
+void VSIGZipHandle::StopParallelRead()
+{
+    const vsi_l_offset nPos = m_poParallelReader->Tell();
+    m_poParallelReader.reset();
+    if( gzrewind() < 0 )
+        return;
+    CPL_IGNORE_RET_VAL(gzseek(nPos, SEEK_SET));
+}
+
 /************************************************************************/
 /*                              Read()                                  */
 /************************************************************************/
 
 size_t VSIGZipHandle::Read( void * const buf, size_t const nSize,
                             size_t const nMemb )
+{
+    if( m_poParallelReader == nullptr && !StartParallelRead() )
+    {
+        if( out != m_nSequentialReadEnd )
+            m_nSequentialReadStart = out;
+        const size_t nRet = gzread(buf, nSize, nMemb);
+        m_nSequentialReadEnd = out;
+        return nRet;
+    }
+
+    const size_t nBytes = nSize * nMemb;
+    size_t nRead = m_poParallelReader->Read(buf, nBytes);
+    if( m_poParallelReader->HasFailed() )
+    {
+        CPLDebug("GZIP", "Going on with single-threaded decompression");
+        m_bParallelReadDisabled = true;
+        StopParallelRead();
+        if( nRead < nBytes && out == Tell() )
+        {
+            nRead += gzread(static_cast<GByte*>(buf) + nRead, 1,
+                            nBytes - nRead);
+        }
+    }
+    return nSize ? nRead / nSize : 0;
+}
+
+/************************************************************************/
+/*                              gzread()                                */
+/************************************************************************/
+
+size_t VSIGZipHandle::gzread( void * const buf, size_t const nSize,
+                              size_t const nMemb )
 {
 #ifdef ENABLE_DEBUG
     CPLDebug("GZIP", "Read(%p, %d, %d)", buf,
@@ -1159,6 +2309,8 @@ size_t VSIGZipHandle::Write( const void * /* pBuffer */,
 
 int VSIGZipHandle::Eof()
 {
+    if( m_poParallelReader )
+        return m_poParallelReader->Eof();
 #ifdef ENABLE_DEBUG
     CPLDebug("GZIP", "Eof()");
 #endif
@@ -1863,22 +3015,13 @@ VSIVirtualHandle* VSICreateGZipWritable( VSIVirtualHandle* poBaseHandle,
                                          int nDeflateTypeIn,
                                          int bAutoCloseBaseHandle )
 {
-    const char* pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
-    if( pszThreads )
+    const int nThreads = CPLGetNumThreads(nullptr);
+    if( nThreads > 1 )
     {
-        int nThreads = 0;
-        if( EQUAL(pszThreads, "ALL_CPUS") )
-            nThreads = CPLGetNumCPUs();
-        else
-            nThreads = atoi(pszThreads);
-        nThreads = std::max(1, std::min(128, nThreads));
-        if( nThreads > 1 )
-        {
-            return new VSIGZipWriteHandleMT( poBaseHandle,
-                                                nThreads,
-                                                nDeflateTypeIn,
-                                                CPL_TO_BOOL(bAutoCloseBaseHandle) );
-        }
+        return new VSIGZipWriteHandleMT( poBaseHandle,
+                                            nThreads,
+                                            nDeflateTypeIn,
+                                            CPL_TO_BOOL(bAutoCloseBaseHandle) );
     }
     return new VSIGZipWriteHandle( poBaseHandle,
                                    nDeflateTypeIn,
@@ -2252,6 +3395,8 @@ VSIGZipHandle* VSIGZipFilesystemHandler::OpenGZipReadOnly(
         delete poHandle;
         return nullptr;
     }
+    if( CPLTestBool(CPLGetConfigOption("CPL_VSIL_GZIP_INDEX", "NO")) )
+        poHandle->EnableIndex();
     return poHandle;
 }
 
@@ -2418,10 +3563,19 @@ const char* VSIGZipFilesystemHandler::GetOptions()
     return
     "<Options>"
     "  <Option name='GDAL_NUM_THREADS' type='string' "
-        "description='Number of threads for compression. Either a integer or ALL_CPUS'/>"
+        "description='Number of threads for compression and decompression. Either a integer or ALL_CPUS'/>"
     "  <Option name='CPL_VSIL_DEFLATE_CHUNK_SIZE' type='string' "
         "description='Chunk of uncompressed data for parallelization. "
         "Use K(ilobytes) or M(egabytes) suffix' default='1M'/>"
+    "  <Option name='CPL_VSIL_GZIP_INDEX' type='boolean' "
+        "description='Whether to build, persist and use a random-access "
+        "index' default='NO'/>"
+    "  <Option name='CPL_VSIL_GZIP_INDEX_SPAN' type='int' "
+        "description='Number of uncompressed bytes between two access "
+        "points of the index' default='1048576'/>"
+    "  <Option name='CPL_VSIL_GZIP_INDEX_DIR' type='string' "
+        "description='Directory where to store index files, instead of "
+        "next to the .gz files'/>"
     "</Options>";
 }
 
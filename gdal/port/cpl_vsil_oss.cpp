@@ -197,7 +197,11 @@ const char* VSIOSSFSHandler::GetOptions()
     "  <Option name='VSIOSS_CHUNK_SIZE' type='int' "
         "description='Size in MB for chunks of files that are uploaded. The"
         "default value of 50 MB allows for files up to 500 GB each' "
-        "default='50' min='1' max='1000'/>" +
+        "default='50' min='1' max='1000'/>"
+    "  <Option name='VSIOSS_PARALLEL_UPLOADS' type='int' "
+        "description='Maximum number of chunks uploaded in the background. "
+        "0 to upload them synchronously' "
+        "default='2' min='0' max='64'/>" +
         VSICurlFilesystemHandler::GetOptionsStatic() +
         "</Options>");
     return osOptions.c_str();
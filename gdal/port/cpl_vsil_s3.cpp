@@ -33,8 +33,10 @@
 #include "cpl_time.h"
 #include "cpl_vsil_curl_priv.h"
 #include "cpl_vsil_curl_class.h"
+#include "cpl_worker_thread_pool.h"
 
 #include <algorithm>
+#include <atomic>
 #include <set>
 #include <map>
 #include <memory>
@@ -664,6 +666,12 @@ VSIS3WriteHandle::VSIS3WriteHandle( IVSIS3LikeFSHandler* poFS,
                     "Cannot allocate working buffer for %s",
                      m_poFS->GetFSPrefix().c_str());
         }
+
+        // Number of parts that can be uploaded in the background while the
+        // next one is filled. 0 means that parts are uploaded synchronously.
+        m_nMaxParallelUploads = std::max(0, std::min(64, atoi(
+            CPLGetConfigOption("VSIS3_PARALLEL_UPLOADS",
+                    CPLGetConfigOption("VSIOSS_PARALLEL_UPLOADS", "2")))));
     }
 }
 
@@ -674,8 +682,11 @@ VSIS3WriteHandle::VSIS3WriteHandle( IVSIS3LikeFSHandler* poFS,
 VSIS3WriteHandle::~VSIS3WriteHandle()
 {
     Close();
+    m_poUploadPool.reset();
     delete m_poS3HandleHelper;
     CPLFree(m_pabyBuffer);
+    for( GByte* pabyBuffer: m_apabyFreeBuffers )
+        CPLFree(pabyBuffer);
     if( m_hCurlMulti )
     {
         if( m_hCurl )
@@ -877,24 +888,41 @@ size_t VSIS3WriteHandle::ReadCallBackBuffer( char *buffer, size_t size,
 }
 
 /************************************************************************/
-/*                           UploadPart()                               */
+/*                          ReadCallBackPart()                          */
 /************************************************************************/
 
-bool VSIS3WriteHandle::UploadPart()
+namespace {
+struct PartReadContext
 {
-    ++m_nPartNumber;
-    if( m_nPartNumber > 10000 )
-    {
-        m_bError = true;
-        CPLError(
-            CE_Failure, CPLE_AppDefined,
-            "10000 parts have been uploaded for %s failed. "
-            "This is the maximum. "
-            "Increase VSIS3_CHUNK_SIZE to a higher value (e.g. 500 for 500 MB)",
-            m_osFilename.c_str());
-        return false;
-    }
+    const GByte* pabyData;
+    int          nSize;
+    int          nOff;
+};
+} // namespace
 
+size_t VSIS3WriteHandle::ReadCallBackPart( char *buffer, size_t size,
+                                           size_t nitems, void *instream )
+{
+    PartReadContext* psCtxt = static_cast<PartReadContext *>(instream);
+    const int nSizeMax = static_cast<int>(size * nitems);
+    const int nSizeToWrite =
+        std::min(nSizeMax, psCtxt->nSize - psCtxt->nOff);
+    memcpy(buffer, psCtxt->pabyData + psCtxt->nOff, nSizeToWrite);
+    psCtxt->nOff += nSizeToWrite;
+    return nSizeToWrite;
+}
+
+/************************************************************************/
+/*                           UploadPart()                               */
+/************************************************************************/
+
+// Uploads one part, and returns its ETag in osEtag. May be called from a
+// worker thread, so the handle state is only accessed under
+// m_oHelperMutex.
+bool VSIS3WriteHandle::UploadPart( int nPartNumber,
+                                   const GByte* pabyBuffer, int nBufferSize,
+                                   CPLString& osEtag )
+{
     bool bRetry;
     double dfRetryDelay = m_dfRetryDelay;
     int nRetryCount = 0;
@@ -903,28 +931,34 @@ bool VSIS3WriteHandle::UploadPart()
     {
         bRetry = false;
 
-        m_nBufferOffReadCallback = 0;
+        PartReadContext sCtxt;
+        sCtxt.pabyData = pabyBuffer;
+        sCtxt.nSize = nBufferSize;
+        sCtxt.nOff = 0;
         CURL* hCurlHandle = curl_easy_init();
-        m_poS3HandleHelper->AddQueryParameter("partNumber",
-                                            CPLSPrintf("%d", m_nPartNumber));
-        m_poS3HandleHelper->AddQueryParameter("uploadId", m_osUploadID);
         curl_easy_setopt(hCurlHandle, CURLOPT_UPLOAD, 1L);
-        curl_easy_setopt(hCurlHandle, CURLOPT_READFUNCTION, ReadCallBackBuffer);
-        curl_easy_setopt(hCurlHandle, CURLOPT_READDATA, this);
-        curl_easy_setopt(hCurlHandle, CURLOPT_INFILESIZE, m_nBufferOff);
+        curl_easy_setopt(hCurlHandle, CURLOPT_READFUNCTION, ReadCallBackPart);
+        curl_easy_setopt(hCurlHandle, CURLOPT_READDATA, &sCtxt);
+        curl_easy_setopt(hCurlHandle, CURLOPT_INFILESIZE, nBufferSize);
 
-        struct curl_slist* headers = static_cast<struct curl_slist*>(
-            CPLHTTPSetOptions(hCurlHandle,
-                            m_poS3HandleHelper->GetURL().c_str(),
-                            nullptr));
-        headers = VSICurlMergeHeaders(headers,
-                        m_poS3HandleHelper->GetCurlHeaders("PUT", headers,
-                                                            m_pabyBuffer,
-                                                            m_nBufferOff));
+        CPLString osURL;
+        struct curl_slist* headers;
+        {
+            std::lock_guard<std::mutex> oLock(m_oHelperMutex);
+            m_poS3HandleHelper->AddQueryParameter("partNumber",
+                                                CPLSPrintf("%d", nPartNumber));
+            m_poS3HandleHelper->AddQueryParameter("uploadId", m_osUploadID);
+            osURL = m_poS3HandleHelper->GetURL();
+            headers = static_cast<struct curl_slist*>(
+                CPLHTTPSetOptions(hCurlHandle, osURL.c_str(), nullptr));
+            headers = VSICurlMergeHeaders(headers,
+                            m_poS3HandleHelper->GetCurlHeaders("PUT", headers,
+                                                                pabyBuffer,
+                                                                nBufferSize));
+            m_poS3HandleHelper->ResetQueryParameters();
+        }
         curl_easy_setopt(hCurlHandle, CURLOPT_HTTPHEADER, headers);
 
-        m_poS3HandleHelper->ResetQueryParameters();
-
         WriteFuncStruct sWriteFuncData;
         VSICURLInitWriteFuncStruct(&sWriteFuncData, nullptr, nullptr, nullptr);
         curl_easy_setopt(hCurlHandle, CURLOPT_WRITEDATA, &sWriteFuncData);
@@ -941,8 +975,8 @@ bool VSIS3WriteHandle::UploadPart()
         szCurlErrBuf[0] = '\0';
         curl_easy_setopt(hCurlHandle, CURLOPT_ERRORBUFFER, szCurlErrBuf );
 
-        MultiPerform(m_poFS->GetCurlMultiHandleFor(m_poS3HandleHelper->GetURL()),
-                        hCurlHandle);
+        // The multi handle is per thread.
+        MultiPerform(m_poFS->GetCurlMultiHandleFor(osURL), hCurlHandle);
 
         VSICURLResetHeaderAndWriterFunctions(hCurlHandle);
 
@@ -963,7 +997,7 @@ bool VSIS3WriteHandle::UploadPart()
                             "HTTP error code: %d - %s. "
                             "Retrying again in %.1f secs",
                             static_cast<int>(response_code),
-                            m_poS3HandleHelper->GetURL().c_str(),
+                            osURL.c_str(),
                             dfRetryDelay);
                 CPLSleep(dfRetryDelay);
                 dfRetryDelay = dfNewRetryDelay;
@@ -975,7 +1009,7 @@ bool VSIS3WriteHandle::UploadPart()
                 CPLDebug(m_poFS->GetDebugKey(), "%s",
                         sWriteFuncData.pBuffer ? sWriteFuncData.pBuffer : "(null)");
                 CPLError(CE_Failure, CPLE_AppDefined, "UploadPart(%d) of %s failed",
-                            m_nPartNumber, m_osFilename.c_str());
+                            nPartNumber, m_osFilename.c_str());
                 bSuccess = false;
             }
         }
@@ -985,19 +1019,18 @@ bool VSIS3WriteHandle::UploadPart()
             size_t nPos = osHeader.ifind("ETag: ");
             if( nPos != std::string::npos )
             {
-                CPLString osEtag(osHeader.substr(nPos + strlen("ETag: ")));
+                osEtag = osHeader.substr(nPos + strlen("ETag: "));
                 const size_t nPosEOL = osEtag.find("\r");
                 if( nPosEOL != std::string::npos )
                     osEtag.resize(nPosEOL);
                 CPLDebug(m_poFS->GetDebugKey(), "Etag for part %d is %s",
-                        m_nPartNumber, osEtag.c_str());
-                m_aosEtags.push_back(osEtag);
+                        nPartNumber, osEtag.c_str());
             }
             else
             {
                 CPLError(CE_Failure, CPLE_AppDefined,
                         "UploadPart(%d) of %s (uploadId = %s) failed",
-                        m_nPartNumber, m_osFilename.c_str(), m_osUploadID.c_str());
+                        nPartNumber, m_osFilename.c_str(), m_osUploadID.c_str());
                 bSuccess = false;
             }
         }
@@ -1012,6 +1045,190 @@ bool VSIS3WriteHandle::UploadPart()
     return bSuccess;
 }
 
+/************************************************************************/
+/*                            PartUploadJob                             */
+/************************************************************************/
+
+struct VSIS3WriteHandle::PartUploadJob
+{
+    VSIS3WriteHandle   *poHandle = nullptr;
+    int                 nPartNumber = 0;
+    GByte              *pabyBuffer = nullptr;
+    int                 nBufferSize = 0;
+    CPLString           osEtag{};
+    bool                bSuccess = false;
+    std::atomic<bool>   bFinished{false};
+
+    // Errors emitted in the worker thread, re-emitted in the calling thread.
+    struct Error
+    {
+        CPLErr      eErr;
+        CPLErrorNum nErrorNum;
+        CPLString   osMsg;
+    };
+    std::vector<Error>  aoErrors{};
+
+    static void CPL_STDCALL ErrorHandler( CPLErr eErr, CPLErrorNum nErrorNum,
+                                          const char* pszMsg )
+    {
+        PartUploadJob* psJob =
+            static_cast<PartUploadJob*>(CPLGetErrorHandlerUserData());
+        Error sError;
+        sError.eErr = eErr;
+        sError.nErrorNum = nErrorNum;
+        sError.osMsg = pszMsg;
+        psJob->aoErrors.push_back(sError);
+    }
+
+    static void Run( void* pData )
+    {
+        PartUploadJob* psJob = static_cast<PartUploadJob*>(pData);
+        CPLPushErrorHandlerEx(ErrorHandler, psJob);
+        CPLSetCurrentErrorHandlerCatchDebug(FALSE);
+        psJob->bSuccess = psJob->poHandle->UploadPart(
+            psJob->nPartNumber, psJob->pabyBuffer, psJob->nBufferSize,
+            psJob->osEtag);
+        CPLPopErrorHandler();
+        psJob->bFinished = true;
+    }
+};
+
+/************************************************************************/
+/*                         CollectPartUpload()                          */
+/************************************************************************/
+
+// Collects the result of the oldest background upload. If bWait is false,
+// returns immediately if it is not finished yet.
+bool VSIS3WriteHandle::CollectPartUpload( bool bWait )
+{
+    PartUploadJob* psJob = m_apoPendingParts.front().get();
+    if( !bWait && !psJob->bFinished )
+        return true;
+    while( !psJob->bFinished )
+        m_poUploadPool->WaitEvent();
+
+    for( const auto& sError: psJob->aoErrors )
+        CPLError(sError.eErr, sError.nErrorNum, "%s", sError.osMsg.c_str());
+    const bool bSuccess = psJob->bSuccess;
+    if( bSuccess )
+    {
+        if( m_aosEtags.size() < static_cast<size_t>(psJob->nPartNumber) )
+            m_aosEtags.resize(psJob->nPartNumber);
+        m_aosEtags[psJob->nPartNumber - 1] = psJob->osEtag;
+    }
+    m_apabyFreeBuffers.push_back(psJob->pabyBuffer);
+    m_apoPendingParts.pop_front();
+    return bSuccess;
+}
+
+/************************************************************************/
+/*                     CollectAllPartUploads()                          */
+/************************************************************************/
+
+bool VSIS3WriteHandle::CollectAllPartUploads()
+{
+    bool bSuccess = true;
+    while( !m_apoPendingParts.empty() )
+    {
+        if( !CollectPartUpload(true) )
+            bSuccess = false;
+    }
+    return bSuccess;
+}
+
+/************************************************************************/
+/*                            SubmitPart()                              */
+/************************************************************************/
+
+// Uploads the content of m_pabyBuffer as the next part. When parallel
+// uploads are enabled, the buffer is handed over to a worker thread and
+// replaced by a new one, so that the caller can go on filling it. Failures
+// of background uploads are reported by a later call, or by Close().
+bool VSIS3WriteHandle::SubmitPart()
+{
+    ++m_nPartNumber;
+    if( m_nPartNumber > 10000 )
+    {
+        m_bError = true;
+        CPLError(
+            CE_Failure, CPLE_AppDefined,
+            "10000 parts have been uploaded for %s failed. "
+            "This is the maximum. "
+            "Increase VSIS3_CHUNK_SIZE to a higher value (e.g. 500 for 500 MB)",
+            m_osFilename.c_str());
+        return false;
+    }
+
+    // Report failures of previous uploads as soon as possible.
+    while( !m_apoPendingParts.empty() &&
+           m_apoPendingParts.front()->bFinished )
+    {
+        if( !CollectPartUpload(false) )
+            return false;
+    }
+
+    GByte* pabyNewBuffer = nullptr;
+    if( m_nMaxParallelUploads > 0 )
+    {
+        if( m_poUploadPool == nullptr )
+        {
+            m_poUploadPool.reset(new CPLWorkerThreadPool());
+            if( !m_poUploadPool->Setup(m_nMaxParallelUploads,
+                                       nullptr, nullptr) )
+            {
+                m_poUploadPool.reset();
+                m_nMaxParallelUploads = 0;
+            }
+        }
+        if( m_poUploadPool != nullptr )
+        {
+            // Bound the number of parts in flight, and thus of buffers.
+            while( m_apoPendingParts.size() >=
+                                static_cast<size_t>(m_nMaxParallelUploads) )
+            {
+                if( !CollectPartUpload(true) )
+                    return false;
+            }
+            if( !m_apabyFreeBuffers.empty() )
+            {
+                pabyNewBuffer = m_apabyFreeBuffers.back();
+                m_apabyFreeBuffers.pop_back();
+            }
+            else
+            {
+                // If we are short of memory, upload synchronously.
+                pabyNewBuffer =
+                    static_cast<GByte *>(VSIMalloc(m_nBufferSize));
+            }
+        }
+    }
+
+    if( pabyNewBuffer == nullptr )
+    {
+        CPLString osEtag;
+        if( !UploadPart(m_nPartNumber, m_pabyBuffer, m_nBufferOff, osEtag) )
+            return false;
+        if( m_aosEtags.size() < static_cast<size_t>(m_nPartNumber) )
+            m_aosEtags.resize(m_nPartNumber);
+        m_aosEtags[m_nPartNumber - 1] = osEtag;
+        return true;
+    }
+
+    std::unique_ptr<PartUploadJob> poJob(new PartUploadJob());
+    poJob->poHandle = this;
+    poJob->nPartNumber = m_nPartNumber;
+    poJob->pabyBuffer = m_pabyBuffer;
+    poJob->nBufferSize = m_nBufferOff;
+    m_pabyBuffer = pabyNewBuffer;
+    if( !m_poUploadPool->SubmitJob(PartUploadJob::Run, poJob.get()) )
+    {
+        m_apabyFreeBuffers.push_back(poJob->pabyBuffer);
+        return false;
+    }
+    m_apoPendingParts.push_back(std::move(poJob));
+    return true;
+}
+
 /************************************************************************/
 /*                      ReadCallBackBufferChunked()                     */
 /************************************************************************/
@@ -1294,7 +1511,7 @@ VSIS3WriteHandle::Write( const void *pBuffer, size_t nSize, size_t nMemb )
                     return 0;
                 }
             }
-            if( !UploadPart() )
+            if( !SubmitPart() )
             {
                 m_bError = true;
                 return 0;
@@ -1708,13 +1925,21 @@ int VSIS3WriteHandle::Close()
         }
         else
         {
+            bool bPartsOK = !m_bError &&
+                            (m_nBufferOff == 0 || SubmitPart());
+            if( !CollectAllPartUploads() )
+                bPartsOK = false;
             if( m_bError )
             {
                 if( !AbortMultipart() )
                     nRet = -1;
             }
-            else if( m_nBufferOff > 0 && !UploadPart() )
+            else if( !bPartsOK )
+            {
+                // A part uploaded in the background failed.
+                AbortMultipart();
                 nRet = -1;
+            }
             else if( !CompleteMultipart() )
                 nRet = -1;
         }
@@ -1823,7 +2048,11 @@ const char* VSIS3FSHandler::GetOptions()
     "  <Option name='VSIS3_CHUNK_SIZE' type='int' "
         "description='Size in MB for chunks of files that are uploaded. The"
         "default value of 50 MB allows for files up to 500 GB each' "
-        "default='50' min='1' max='1000'/>" +
+        "default='50' min='1' max='1000'/>"
+    "  <Option name='VSIS3_PARALLEL_UPLOADS' type='int' "
+        "description='Maximum number of chunks uploaded in the background. "
+        "0 to upload them synchronously' "
+        "default='2' min='0' max='64'/>" +
         VSICurlFilesystemHandler::GetOptionsStatic() +
         "</Options>");
     return osOptions.c_str();
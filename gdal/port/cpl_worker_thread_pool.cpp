@@ -29,7 +29,9 @@
 #include "cpl_port.h"
 #include "cpl_worker_thread_pool.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdlib>
 #include <memory>
 
 #include "cpl_conv.h"
@@ -39,6 +41,14 @@
 
 CPL_CVSID("$Id$")
 
+// Upper bound of the number of threads of a pool. The array of workers is
+// reserved to that size so that it is never reallocated, which lets workers
+// look at their siblings (for work stealing) while threads are added.
+constexpr int knMaxThreads = 1024;
+
+// Worker thread (of any pool) running in the current thread, if any.
+static thread_local CPLWorkerThread* tlsCurrentWorkerThread = nullptr;
+
 /************************************************************************/
 /*                         CPLWorkerThreadPool()                        */
 /************************************************************************/
@@ -48,10 +58,9 @@ CPL_CVSID("$Id$")
  * The pool is in an uninitialized state after this call. The Setup() method
  * must be called.
  */
-CPLWorkerThreadPool::CPLWorkerThreadPool() :
-    hMutex( CPLCreateMutexEx(CPL_MUTEX_REGULAR) )
+CPLWorkerThreadPool::CPLWorkerThreadPool()
 {
-    CPLReleaseMutex(hMutex);
+    aWT.reserve(knMaxThreads);
 }
 
 /************************************************************************/
@@ -64,29 +73,18 @@ CPLWorkerThreadPool::CPLWorkerThreadPool() :
  */
 CPLWorkerThreadPool::~CPLWorkerThreadPool()
 {
-    if( hCond )
-    {
-        WaitCompletion();
+    WaitCompletion();
 
-        CPLAcquireMutex(hMutex, 1000.0);
-        eState = CPLWTS_STOP;
-        CPLReleaseMutex(hMutex);
-
-        for(size_t i=0;i<aWT.size();i++)
-        {
-            CPLAcquireMutex(aWT[i].hMutex, 1000.0);
-            CPLCondSignal(aWT[i].hCond);
-            CPLReleaseMutex(aWT[i].hMutex);
-            CPLJoinThread(aWT[i].hThread);
-            CPLDestroyCond(aWT[i].hCond);
-            CPLDestroyMutex(aWT[i].hMutex);
-        }
-
-        CPLListDestroy(psWaitingWorkerThreadsList);
+    {
+        std::lock_guard<std::mutex> oLock(m_mutex);
+        m_bStop = true;
+        m_cvWorkers.notify_all();
+    }
 
-        CPLDestroyCond(hCond);
+    for( auto& poWT: aWT )
+    {
+        CPLJoinThread(poWT->hThread);
     }
-    CPLDestroyMutex(hMutex);
 }
 
 /************************************************************************/
@@ -98,208 +96,211 @@ void CPLWorkerThreadPool::WorkerThreadFunction(void* user_data)
     CPLWorkerThread* psWT = static_cast<CPLWorkerThread*>(user_data);
     CPLWorkerThreadPool* poTP = psWT->poTP;
 
+    tlsCurrentWorkerThread = psWT;
+
     if( psWT->pfnInitFunc )
         psWT->pfnInitFunc( psWT->pInitData );
 
-    while( true )
     {
-        CPLWorkerThreadJob* psJob = poTP->GetNextJob(psWT);
-        if( psJob == nullptr )
-            break;
+        std::lock_guard<std::mutex> oLock(poTP->m_mutex);
+        poTP->m_nStartedThreads++;
+        poTP->m_cvJobFinished.notify_all();
+    }
 
-        if( psJob->pfnFunc )
-        {
-            psJob->pfnFunc(psJob->pData);
-        }
-        CPLFree(psJob);
+    CPLWorkerThreadJob oJob;
+    while( poTP->GetNextJob(psWT, oJob) )
+    {
+        poTP->RunJob(oJob);
 #if DEBUG_VERBOSE
         CPLDebug("JOB", "%p finished a job", psWT);
 #endif
-        poTP->DeclareJobFinished();
     }
+
+    tlsCurrentWorkerThread = nullptr;
 }
 
 /************************************************************************/
-/*                             SubmitJob()                              */
+/*                       GetCurrentWorkerThread()                       */
 /************************************************************************/
 
-/** Queue a new job.
- *
- * @param pfnFunc Function to run for the job.
- * @param pData User data to pass to the job function.
- * @return true in case of success.
- */
-bool CPLWorkerThreadPool::SubmitJob( CPLThreadFunc pfnFunc, void* pData )
+// Returns the worker of this pool running in the current thread, or nullptr.
+CPLWorkerThread* CPLWorkerThreadPool::GetCurrentWorkerThread() const
 {
-    CPLAssert( !aWT.empty() );
-
-    CPLWorkerThreadJob* psJob = static_cast<CPLWorkerThreadJob *>(
-        VSI_MALLOC_VERBOSE(sizeof(CPLWorkerThreadJob)));
-    if( psJob == nullptr )
-        return false;
-    psJob->pfnFunc = pfnFunc;
-    psJob->pData = pData;
-
-    CPLList* psItem =
-        static_cast<CPLList *>(VSI_MALLOC_VERBOSE(sizeof(CPLList)));
-    if( psItem == nullptr )
-    {
-        VSIFree(psJob);
-        return false;
-    }
-    psItem->pData = psJob;
+    CPLWorkerThread* psWT = tlsCurrentWorkerThread;
+    return psWT && psWT->poTP == this ? psWT : nullptr;
+}
 
-    CPLAcquireMutex(hMutex, 1000.0);
+/************************************************************************/
+/*                              PushJob()                               */
+/************************************************************************/
 
-    psItem->psNext = psJobQueue;
-    psJobQueue = psItem;
-    nPendingJobs++;
+void CPLWorkerThreadPool::PushJob(const CPLWorkerThreadJob& oJob)
+{
+    CPLWorkerThread* psWT = GetCurrentWorkerThread();
 
-    if( psWaitingWorkerThreadsList )
+    // The counters are incremented before the job is visible, so that it
+    // cannot be declared finished before being accounted for.
     {
-        CPLWorkerThread* psWorkerThread =
-            static_cast<CPLWorkerThread *>(psWaitingWorkerThreadsList->pData);
-
-        CPLAssert( psWorkerThread->bMarkedAsWaiting );
-        psWorkerThread->bMarkedAsWaiting = FALSE;
-
-        CPLList* psNext = psWaitingWorkerThreadsList->psNext;
-        CPLList* psToFree = psWaitingWorkerThreadsList;
-        psWaitingWorkerThreadsList = psNext;
-        nWaitingWorkerThreads--;
-
-        // CPLAssert(
-        //   CPLListCount(psWaitingWorkerThreadsList) == nWaitingWorkerThreads);
-
-#if DEBUG_VERBOSE
-        CPLDebug("JOB", "Waking up %p", psWorkerThread);
-#endif
-        CPLAcquireMutex(psWorkerThread->hMutex, 1000.0);
-        CPLReleaseMutex(hMutex);
-        CPLCondSignal(psWorkerThread->hCond);
-        CPLReleaseMutex(psWorkerThread->hMutex);
-
-        CPLFree(psToFree);
+        std::lock_guard<std::mutex> oLock(m_mutex);
+        nPendingJobs++;
+        m_nQueuedJobs++;
+        if( !psWT )
+            m_aoJobQueue.push_back(oJob);
     }
-    else
+    if( psWT )
     {
-        CPLReleaseMutex(hMutex);
+        std::lock_guard<std::mutex> oLock(psWT->mutex);
+        psWT->aoJobs.push_back(oJob);
     }
-
-    return true;
+    m_cvWorkers.notify_one();
 }
 
 /************************************************************************/
-/*                             SubmitJobs()                              */
+/*                               PopJob()                               */
 /************************************************************************/
 
-/** Queue several jobs
- *
- * @param pfnFunc Function to run for the job.
- * @param apData User data instances to pass to the job function.
- * @return true in case of success.
- */
-bool CPLWorkerThreadPool::SubmitJobs(CPLThreadFunc pfnFunc,
-                                     const std::vector<void*>& apData)
+// Takes a queued job without blocking. psWorkerThread may be nullptr.
+bool CPLWorkerThreadPool::PopJob(CPLWorkerThread* psWorkerThread,
+                                 CPLWorkerThreadJob& oJob)
 {
-    CPLAssert( !aWT.empty() );
-
-    CPLAcquireMutex(hMutex, 1000.0);
-
-    CPLList* psJobQueueInit = psJobQueue;
-    bool bRet = true;
+    if( m_nQueuedJobs <= 0 )
+        return false;
 
-    for(size_t i=0;i<apData.size();i++)
+    // Most recently submitted job of our own queue first.
+    if( psWorkerThread )
     {
-        CPLWorkerThreadJob* psJob = static_cast<CPLWorkerThreadJob*>(
-            VSI_MALLOC_VERBOSE(sizeof(CPLWorkerThreadJob)));
-        if( psJob == nullptr )
+        std::lock_guard<std::mutex> oLock(psWorkerThread->mutex);
+        if( !psWorkerThread->aoJobs.empty() )
         {
-            bRet = false;
-            break;
+            oJob = psWorkerThread->aoJobs.back();
+            psWorkerThread->aoJobs.pop_back();
+            m_nQueuedJobs--;
+            return true;
         }
-        psJob->pfnFunc = pfnFunc;
-        psJob->pData = apData[i];
+    }
 
-        CPLList* psItem =
-            static_cast<CPLList *>(VSI_MALLOC_VERBOSE(sizeof(CPLList)));
-        if( psItem == nullptr )
+    // Then jobs submitted from outside the pool, in submission order.
+    {
+        std::lock_guard<std::mutex> oLock(m_mutex);
+        if( !m_aoJobQueue.empty() )
         {
-            VSIFree(psJob);
-            bRet = false;
-            break;
+            oJob = m_aoJobQueue.front();
+            m_aoJobQueue.pop_front();
+            m_nQueuedJobs--;
+            return true;
         }
-        psItem->pData = psJob;
-
-        psItem->psNext = psJobQueue;
-        psJobQueue = psItem;
-        nPendingJobs++;
     }
 
-    if( !bRet )
+    // And finally steal the oldest job of another worker.
+    const int nThreads = m_nThreads;
+    const int nStart = psWorkerThread ? psWorkerThread->nIndex + 1 : 0;
+    for( int i = 0; i < nThreads; i++ )
     {
-        for( CPLList* psIter = psJobQueue; psIter != psJobQueueInit; )
+        CPLWorkerThread* psOther = aWT[(nStart + i) % nThreads].get();
+        if( psOther == psWorkerThread )
+            continue;
+        std::lock_guard<std::mutex> oLock(psOther->mutex);
+        if( !psOther->aoJobs.empty() )
         {
-            CPLList* psNext = psIter->psNext;
-            VSIFree(psIter->pData);
-            VSIFree(psIter);
-            nPendingJobs--;
-            psIter = psNext;
+            oJob = psOther->aoJobs.front();
+            psOther->aoJobs.pop_front();
+            m_nQueuedJobs--;
+#if DEBUG_VERBOSE
+            CPLDebug("JOB", "%p stole a job from %p", psWorkerThread, psOther);
+#endif
+            return true;
         }
     }
 
-    CPLReleaseMutex(hMutex);
+    return false;
+}
 
-    if( !bRet )
-        return false;
+/************************************************************************/
+/*                             GetNextJob()                             */
+/************************************************************************/
 
-    for(size_t i=0;i<apData.size();i++)
+// Waits for a job to be available. Returns false when the pool is stopping.
+bool CPLWorkerThreadPool::GetNextJob( CPLWorkerThread* psWorkerThread,
+                                      CPLWorkerThreadJob& oJob )
+{
+    while( true )
     {
-        CPLAcquireMutex(hMutex, 1000.0);
+        if( PopJob(psWorkerThread, oJob) )
+            return true;
 
-        if( psWaitingWorkerThreadsList && psJobQueue )
+        std::unique_lock<std::mutex> oLock(m_mutex);
+        while( m_nQueuedJobs <= 0 && !m_bStop )
         {
-            CPLWorkerThread* psWorkerThread;
+#if DEBUG_VERBOSE
+            CPLDebug("JOB", "%p sleeping", psWorkerThread);
+#endif
+            m_cvWorkers.wait(oLock);
+        }
+        if( m_bStop )
+            return false;
+    }
+}
+
+/************************************************************************/
+/*                               RunJob()                               */
+/************************************************************************/
 
-            psWorkerThread = static_cast<CPLWorkerThread*>(psWaitingWorkerThreadsList->pData);
+void CPLWorkerThreadPool::RunJob(const CPLWorkerThreadJob& oJob)
+{
+    if( oJob.pfnFunc )
+        oJob.pfnFunc(oJob.pData);
 
-            CPLAssert( psWorkerThread->bMarkedAsWaiting );
-            psWorkerThread->bMarkedAsWaiting = FALSE;
+    {
+        std::lock_guard<std::mutex> oLock(m_mutex);
+        nPendingJobs--;
+        m_cvJobFinished.notify_all();
+    }
 
-            CPLList* psNext = psWaitingWorkerThreadsList->psNext;
-            CPLList* psToFree = psWaitingWorkerThreadsList;
-            psWaitingWorkerThreadsList = psNext;
-            nWaitingWorkerThreads--;
+    // Must be last, as the queue may be destroyed as soon as its last job
+    // is declared finished.
+    if( oJob.poQueue )
+        oJob.poQueue->DeclareJobFinished();
+}
 
-            // CPLAssert(
-            //    CPLListCount(psWaitingWorkerThreadsList) ==
-            //    nWaitingWorkerThreads);
+/************************************************************************/
+/*                             SubmitJob()                              */
+/************************************************************************/
 
-#if DEBUG_VERBOSE
-            CPLDebug("JOB", "Waking up %p", psWorkerThread);
-#endif
-            CPLAcquireMutex(psWorkerThread->hMutex, 1000.0);
+/** Queue a new job.
+ *
+ * @param pfnFunc Function to run for the job.
+ * @param pData User data to pass to the job function.
+ * @return true in case of success.
+ */
+bool CPLWorkerThreadPool::SubmitJob( CPLThreadFunc pfnFunc, void* pData )
+{
+    CPLAssert( m_nThreads > 0 );
 
-            // CPLAssert(psWorkerThread->psNextJob == nullptr);
-            // psWorkerThread->psNextJob =
-            //     (CPLWorkerThreadJob*)psJobQueue->pData;
-            // psNext = psJobQueue->psNext;
-            // CPLFree(psJobQueue);
-            // psJobQueue = psNext;
+    CPLWorkerThreadJob oJob;
+    oJob.pfnFunc = pfnFunc;
+    oJob.pData = pData;
+    PushJob(oJob);
+    return true;
+}
 
-            CPLReleaseMutex(hMutex);
-            CPLCondSignal(psWorkerThread->hCond);
-            CPLReleaseMutex(psWorkerThread->hMutex);
+/************************************************************************/
+/*                             SubmitJobs()                              */
+/************************************************************************/
 
-            CPLFree(psToFree);
-        }
-        else
-        {
-            CPLReleaseMutex(hMutex);
-            break;
-        }
+/** Queue several jobs
+ *
+ * @param pfnFunc Function to run for the job.
+ * @param apData User data instances to pass to the job function.
+ * @return true in case of success.
+ */
+bool CPLWorkerThreadPool::SubmitJobs(CPLThreadFunc pfnFunc,
+                                     const std::vector<void*>& apData)
+{
+    for( void* pData: apData )
+    {
+        if( !SubmitJob(pfnFunc, pData) )
+            return false;
     }
-
     return true;
 }
 
@@ -308,6 +309,10 @@ bool CPLWorkerThreadPool::SubmitJobs(CPLThreadFunc pfnFunc,
 /************************************************************************/
 
 /** Wait for completion of part or whole jobs.
+ *
+ * This waits for all the jobs of the pool, including the ones submitted
+ * by other users of the pool. It must not be called from a job running in
+ * the pool: use a CPLJobQueue for that.
  *
  * @param nMaxRemainingJobs Maximum number of pendings jobs that are allowed
  *                          in the queue after this method has completed. Might be
@@ -317,16 +322,9 @@ void CPLWorkerThreadPool::WaitCompletion(int nMaxRemainingJobs)
 {
     if( nMaxRemainingJobs < 0 )
         nMaxRemainingJobs = 0;
-    CPLAcquireMutex(hMutex, 1000.0);
-    while( true )
-    {
-        int nPendingJobsLocal = nPendingJobs;
-        if( nPendingJobsLocal > nMaxRemainingJobs )
-            CPLCondWait(hCond, hMutex);
-        if( nPendingJobsLocal <= nMaxRemainingJobs )
-            break;
-    }
-    CPLReleaseMutex(hMutex);
+    std::unique_lock<std::mutex> oLock(m_mutex);
+    while( nPendingJobs > nMaxRemainingJobs )
+        m_cvJobFinished.wait(oLock);
 }
 
 /************************************************************************/
@@ -337,21 +335,10 @@ void CPLWorkerThreadPool::WaitCompletion(int nMaxRemainingJobs)
  */
 void CPLWorkerThreadPool::WaitEvent()
 {
-    CPLAcquireMutex(hMutex, 1000.0);
-    while( true )
-    {
-        int nPendingJobsLocal = nPendingJobs;
-        if( nPendingJobsLocal == 0 )
-        {
-            break;
-        }
-        CPLCondWait(hCond, hMutex);
-        if( nPendingJobs < nPendingJobsLocal )
-        {
-            break;
-        }
-    }
-    CPLReleaseMutex(hMutex);
+    std::unique_lock<std::mutex> oLock(m_mutex);
+    const int nPendingJobsLocal = nPendingJobs;
+    while( nPendingJobs > 0 && nPendingJobs >= nPendingJobsLocal )
+        m_cvJobFinished.wait(oLock);
 }
 
 /************************************************************************/
@@ -374,6 +361,9 @@ bool CPLWorkerThreadPool::Setup(int nThreads,
 }
 
 /** Setup the pool.
+ *
+ * Setup() may be called several times: the threads are added to the ones
+ * already launched.
  *
  * @param nThreads Number of threads to launch
  * @param pfnInitFunc Initialization function to run in each thread. May be NULL
@@ -389,159 +379,344 @@ bool CPLWorkerThreadPool::Setup(int nThreads,
 {
     CPLAssert( nThreads > 0 );
 
-    hCond = CPLCreateCond();
-    if( hCond == nullptr )
-        return false;
-
     bool bRet = true;
-    aWT.resize(nThreads);
-    for(int i=0;i<nThreads;i++)
+    for( int i = 0; i < nThreads; i++ )
     {
-        aWT[i].pfnInitFunc = pfnInitFunc;
-        aWT[i].pInitData = pasInitData ? pasInitData[i] : nullptr;
-        aWT[i].poTP = this;
-
-        aWT[i].hMutex = CPLCreateMutexEx(CPL_MUTEX_REGULAR);
-        if( aWT[i].hMutex == nullptr )
+        if( static_cast<int>(aWT.size()) == knMaxThreads )
         {
-            nThreads = i;
-            aWT.resize(nThreads);
-            bRet = false;
-            break;
-        }
-        CPLReleaseMutex(aWT[i].hMutex);
-        aWT[i].hCond = CPLCreateCond();
-        if( aWT[i].hCond == nullptr )
-        {
-            CPLDestroyMutex(aWT[i].hMutex);
-            nThreads = i;
-            aWT.resize(nThreads);
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Too many threads in pool: at most %d are allowed",
+                     knMaxThreads);
             bRet = false;
             break;
         }
 
-        aWT[i].bMarkedAsWaiting = FALSE;
-        // aWT[i].psNextJob = nullptr;
+        std::unique_ptr<CPLWorkerThread> poWT(new CPLWorkerThread());
+        poWT->pfnInitFunc = pfnInitFunc;
+        poWT->pInitData = pasInitData ? pasInitData[i] : nullptr;
+        poWT->poTP = this;
+        poWT->nIndex = static_cast<int>(aWT.size());
+        aWT.emplace_back(std::move(poWT));
 
-        aWT[i].hThread =
-            CPLCreateJoinableThread(WorkerThreadFunction, &(aWT[i]));
-        if( aWT[i].hThread == nullptr )
+        CPLWorkerThread* psWT = aWT.back().get();
+        psWT->hThread = CPLCreateJoinableThread(WorkerThreadFunction, psWT);
+        if( psWT->hThread == nullptr )
         {
-            nThreads = i;
-            aWT.resize(nThreads);
+            aWT.pop_back();
             bRet = false;
             break;
         }
+        m_nThreads++;
     }
 
     if( bWaitallStarted )
     {
-        // Wait all threads to be started
-        while( true )
-        {
-            CPLAcquireMutex(hMutex, 1000.0);
-            int nWaitingWorkerThreadsLocal = nWaitingWorkerThreads;
-            if( nWaitingWorkerThreadsLocal < nThreads )
-                CPLCondWait(hCond, hMutex);
-            CPLReleaseMutex(hMutex);
-            if( nWaitingWorkerThreadsLocal == nThreads )
-                break;
-        }
+        std::unique_lock<std::mutex> oLock(m_mutex);
+        while( m_nStartedThreads < m_nThreads )
+            m_cvJobFinished.wait(oLock);
     }
 
-    if( eState == CPLWTS_ERROR )
-        bRet = false;
-
     return bRet;
 }
 
+/************************************************************************/
+/*                           CreateJobQueue()                           */
+/************************************************************************/
+
+/** Create a new queue of jobs, to be run by the threads of this pool.
+ *
+ * The pool must outlive the returned queue.
+ *
+ * @param nMaxRunningJobs Maximum number of jobs of the queue running at the
+ *                        same time, or 0 for no limit. Jobs submitted above
+ *                        that limit are handed to the pool as the previous
+ *                        ones finish.
+ * @since GDAL 3.1
+ */
+std::unique_ptr<CPLJobQueue>
+CPLWorkerThreadPool::CreateJobQueue(int nMaxRunningJobs)
+{
+    return std::unique_ptr<CPLJobQueue>(
+        new CPLJobQueue(this, std::max(0, nMaxRunningJobs)));
+}
+
+/************************************************************************/
+/*                             CPLJobQueue()                            */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+CPLJobQueue::CPLJobQueue(CPLWorkerThreadPool* poPool, int nMaxRunningJobs) :
+    m_poPool(poPool), m_nMaxRunningJobs(nMaxRunningJobs)
+{
+}
+//! @endcond
+
+/************************************************************************/
+/*                            ~CPLJobQueue()                            */
+/************************************************************************/
+
+/** Destroys the queue, after waiting for the completion of its jobs. */
+CPLJobQueue::~CPLJobQueue()
+{
+    WaitCompletion();
+}
+
 /************************************************************************/
 /*                          DeclareJobFinished()                        */
 /************************************************************************/
 
-void CPLWorkerThreadPool::DeclareJobFinished()
+void CPLJobQueue::DeclareJobFinished()
 {
-    CPLAcquireMutex(hMutex, 1000.0);
-    nPendingJobs--;
-    CPLCondSignal(hCond);
-    CPLReleaseMutex(hMutex);
+    std::lock_guard<std::mutex> oLock(m_mutex);
+    m_nPendingJobs--;
+    if( !m_aoWaitingJobs.empty() )
+    {
+        // The finished job hands its slot to the next waiting one. The
+        // queue cannot be destroyed meanwhile, as that job is pending.
+        CPLWorkerThreadJob oJob = m_aoWaitingJobs.front();
+        m_aoWaitingJobs.pop_front();
+        m_poPool->PushJob(oJob);
+    }
+    else
+    {
+        m_nRunningJobs--;
+    }
+    m_cv.notify_all();
 }
 
 /************************************************************************/
-/*                             GetNextJob()                             */
+/*                             SubmitJob()                              */
 /************************************************************************/
 
-CPLWorkerThreadJob *
-CPLWorkerThreadPool::GetNextJob( CPLWorkerThread* psWorkerThread )
+/** Queue a new job.
+ *
+ * @param pfnFunc Function to run for the job.
+ * @param pData User data to pass to the job function.
+ * @return true in case of success.
+ */
+bool CPLJobQueue::SubmitJob( CPLThreadFunc pfnFunc, void* pData )
 {
-    while(true)
+    CPLAssert( m_poPool->GetThreadCount() > 0 );
+
+    CPLWorkerThreadJob oJob;
+    oJob.pfnFunc = pfnFunc;
+    oJob.pData = pData;
+    oJob.poQueue = this;
+
     {
-        CPLAcquireMutex(hMutex, 1000.0);
-        if( eState == CPLWTS_STOP )
+        std::lock_guard<std::mutex> oLock(m_mutex);
+        m_nPendingJobs++;
+        if( m_nMaxRunningJobs > 0 && m_nRunningJobs >= m_nMaxRunningJobs )
         {
-            CPLReleaseMutex(hMutex);
-            return nullptr;
+            m_aoWaitingJobs.push_back(oJob);
+            return true;
         }
-        CPLList* psTopJobIter = psJobQueue;
-        if( psTopJobIter )
-        {
-            psJobQueue = psTopJobIter->psNext;
+        m_nRunningJobs++;
+    }
 
-#if DEBUG_VERBOSE
-            CPLDebug("JOB", "%p got a job", psWorkerThread);
-#endif
-            CPLWorkerThreadJob* psJob =
-                static_cast<CPLWorkerThreadJob*>(psTopJobIter->pData);
-            CPLReleaseMutex(hMutex);
-            CPLFree(psTopJobIter);
-            return psJob;
-        }
+    m_poPool->PushJob(oJob);
+    return true;
+}
+
+/************************************************************************/
+/*                             SubmitJobs()                              */
+/************************************************************************/
+
+/** Queue several jobs
+ *
+ * @param pfnFunc Function to run for the job.
+ * @param apData User data instances to pass to the job function.
+ * @return true in case of success.
+ */
+bool CPLJobQueue::SubmitJobs(CPLThreadFunc pfnFunc,
+                             const std::vector<void*>& apData)
+{
+    for( void* pData: apData )
+    {
+        if( !SubmitJob(pfnFunc, pData) )
+            return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                                Wait()                                */
+/************************************************************************/
 
-        if( !psWorkerThread->bMarkedAsWaiting )
+// Waits until pred(m_nPendingJobs) is true. When called from a worker of
+// the pool (that is from a job that has submitted child jobs), the worker
+// runs queued jobs instead of blocking, so that nested waits cannot exhaust
+// the threads of the pool.
+template<class Predicate> void CPLJobQueue::Wait(Predicate pred)
+{
+    CPLWorkerThread* psWT = m_poPool->GetCurrentWorkerThread();
+    std::unique_lock<std::mutex> oLock(m_mutex);
+    while( !pred(m_nPendingJobs) )
+    {
+        if( psWT && !m_aoWaitingJobs.empty() )
+        {
+            // Jobs held back by the limit of running jobs are not visible
+            // to the pool: run them directly, as the running ones may be
+            // jobs of this queue waiting for them.
+            CPLWorkerThreadJob oJob = m_aoWaitingJobs.front();
+            m_aoWaitingJobs.pop_front();
+            oLock.unlock();
+            if( oJob.pfnFunc )
+                oJob.pfnFunc(oJob.pData);
+            oLock.lock();
+            m_nPendingJobs--;
+            m_cv.notify_all();
+            continue;
+        }
+        if( psWT )
         {
-            psWorkerThread->bMarkedAsWaiting = TRUE;
-            nWaitingWorkerThreads++;
-            CPLAssert(nWaitingWorkerThreads <= static_cast<int>(aWT.size()));
+            oLock.unlock();
+            CPLWorkerThreadJob oJob;
+            const bool bGotJob = m_poPool->PopJob(psWT, oJob);
+            if( bGotJob )
+                m_poPool->RunJob(oJob);
+            oLock.lock();
+            if( bGotJob )
+                continue;
+        }
+        // Our remaining jobs are all running in other threads.
+        if( !pred(m_nPendingJobs) )
+            m_cv.wait(oLock);
+    }
+}
 
-            CPLList* psItem =
-                static_cast<CPLList *>(VSI_MALLOC_VERBOSE(sizeof(CPLList)));
-            if( psItem == nullptr )
-            {
-                eState = CPLWTS_ERROR;
-                CPLCondSignal(hCond);
+/************************************************************************/
+/*                            WaitCompletion()                          */
+/************************************************************************/
 
-                CPLReleaseMutex(hMutex);
-                return nullptr;
-            }
+/** Wait for completion of part or whole jobs of the queue.
+ *
+ * @param nMaxRemainingJobs Maximum number of pendings jobs that are allowed
+ *                          in the queue after this method has completed. Might be
+ *                          0 to wait for all jobs.
+ */
+void CPLJobQueue::WaitCompletion(int nMaxRemainingJobs)
+{
+    if( nMaxRemainingJobs < 0 )
+        nMaxRemainingJobs = 0;
+    Wait([nMaxRemainingJobs](int nPending)
+         { return nPending <= nMaxRemainingJobs; });
+}
 
-            psItem->pData = psWorkerThread;
-            psItem->psNext = psWaitingWorkerThreadsList;
-            psWaitingWorkerThreadsList = psItem;
+/************************************************************************/
+/*                            WaitEvent()                               */
+/************************************************************************/
 
-#if DEBUG_VERBOSE
-            CPLAssert(CPLListCount(psWaitingWorkerThreadsList) ==
-                      nWaitingWorkerThreads);
-#endif
-        }
+/** Wait for completion of at least one job of the queue, if there are any
+ * remaining.
+ */
+void CPLJobQueue::WaitEvent()
+{
+    int nPendingJobsLocal;
+    {
+        std::lock_guard<std::mutex> oLock(m_mutex);
+        nPendingJobsLocal = m_nPendingJobs;
+    }
+    Wait([nPendingJobsLocal](int nPending)
+         { return nPending == 0 || nPending < nPendingJobsLocal; });
+}
 
-        CPLCondSignal(hCond);
+/************************************************************************/
+/*                    CPLGetGlobalWorkerThreadPool()                    */
+/************************************************************************/
 
-        CPLAcquireMutex(psWorkerThread->hMutex, 1000.0);
-#if DEBUG_VERBOSE
-        CPLDebug("JOB", "%p sleeping", psWorkerThread);
-#endif
-        CPLReleaseMutex(hMutex);
+static std::mutex goGlobalPoolMutex;
+static CPLWorkerThreadPool* gpoGlobalPool = nullptr;
+
+/** Return the process-wide pool of worker threads.
+ *
+ * The pool is created on the first call, and grown when a later call
+ * requests more threads. Its threads are not stopped before
+ * CPLCleanupGlobalWorkerThreadPool(), so the pool may have more threads than
+ * a caller asked for: callers should submit their jobs through a
+ * CPLJobQueue whose number of running jobs is limited to the number of
+ * threads they asked for (see CPLWorkerThreadPool::CreateJobQueue()), and
+ * use the minimum of that number and GetThreadCount() of the returned pool
+ * when splitting their work.
+ *
+ * The requested number is used as is: the GDAL_NUM_THREADS configuration
+ * option is only meant to be the default value of the NUM_THREADS options
+ * of the callers.
+ *
+ * @param nThreads Number of threads wished.
+ * @return the pool, or nullptr in case of error.
+ * @since GDAL 3.1
+ */
+CPLWorkerThreadPool* CPLGetGlobalWorkerThreadPool(int nThreads)
+{
+    nThreads = std::max(1, std::min(nThreads, knMaxThreads));
+
+    std::lock_guard<std::mutex> oLock(goGlobalPoolMutex);
+    if( gpoGlobalPool == nullptr )
+    {
+        gpoGlobalPool = new CPLWorkerThreadPool();
+        if( !gpoGlobalPool->Setup(nThreads, nullptr, nullptr, false) &&
+            gpoGlobalPool->GetThreadCount() == 0 )
+        {
+            delete gpoGlobalPool;
+            gpoGlobalPool = nullptr;
+        }
+    }
+    else if( gpoGlobalPool->GetThreadCount() < nThreads )
+    {
+        gpoGlobalPool->Setup(nThreads - gpoGlobalPool->GetThreadCount(),
+                             nullptr, nullptr, false);
+    }
+    return gpoGlobalPool;
+}
 
-        CPLCondWait( psWorkerThread->hCond, psWorkerThread->hMutex );
+/************************************************************************/
+/*                  CPLCleanupGlobalWorkerThreadPool()                  */
+/************************************************************************/
 
-        // TODO(rouault): Explain or delete.
-        // CPLWorkerThreadJob* psJob = psWorkerThread->psNextJob;
-        // psWorkerThread->psNextJob = nullptr;
+/** Destroy the process-wide pool of worker threads, if it has been created.
+ *
+ * All the job queues of the pool must have been destroyed before.
+ * @since GDAL 3.1
+ */
+void CPLCleanupGlobalWorkerThreadPool()
+{
+    std::lock_guard<std::mutex> oLock(goGlobalPoolMutex);
+    delete gpoGlobalPool;
+    gpoGlobalPool = nullptr;
+}
 
-        CPLReleaseMutex(psWorkerThread->hMutex);
+/************************************************************************/
+/*                          CPLGetNumThreads()                          */
+/************************************************************************/
 
-        // TODO(rouault): Explain or delete.
-        // if( psJob )
-        //    return psJob;
+/** Return the number of threads given by the value of a NUM_THREADS option.
+ *
+ * The value is either an integer or ALL_CPUS. When it is nullptr, the
+ * GDAL_NUM_THREADS configuration option is used instead, and 1 is returned
+ * if it is not set either. A warning is emitted for an invalid value.
+ *
+ * @param pszNumThreads Value of the NUM_THREADS option, or nullptr.
+ * @return a number of threads between 1 and 128.
+ * @since GDAL 3.1
+ */
+int CPLGetNumThreads(const char* pszNumThreads)
+{
+    const char* pszOptionName = "NUM_THREADS";
+    if( pszNumThreads == nullptr )
+    {
+        pszOptionName = "GDAL_NUM_THREADS";
+        pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+        if( pszNumThreads == nullptr )
+            return 1;
+    }
+    if( EQUAL(pszNumThreads, "ALL_CPUS") )
+        return std::max(1, std::min(CPLGetNumCPUs(), 128));
+    const int nThreads = atoi(pszNumThreads);
+    if( nThreads < 0 || (nThreads == 0 && !EQUAL(pszNumThreads, "0")) )
+    {
+        CPLError(CE_Warning, CPLE_AppDefined,
+                 "Invalid value for %s: %s", pszOptionName, pszNumThreads);
     }
+    return std::max(1, std::min(nThreads, 128));
 }
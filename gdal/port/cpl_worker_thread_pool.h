@@ -32,6 +32,12 @@
 
 #include "cpl_multiproc.h"
 #include "cpl_list.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 /**
@@ -43,53 +49,72 @@
 
 #ifndef DOXYGEN_SKIP
 class CPLWorkerThreadPool;
+class CPLJobQueue;
 
-typedef struct
+struct CPLWorkerThreadJob
 {
-    CPLThreadFunc  pfnFunc;
-    void          *pData;
-} CPLWorkerThreadJob;
+    CPLThreadFunc  pfnFunc = nullptr;
+    void          *pData = nullptr;
+    CPLJobQueue   *poQueue = nullptr;
+};
 
-typedef struct
+struct CPLWorkerThread
 {
-    CPLThreadFunc        pfnInitFunc;
-    void                *pInitData;
-    CPLWorkerThreadPool *poTP;
-    CPLJoinableThread   *hThread;
-    int                  bMarkedAsWaiting;
-    // CPLWorkerThreadJob  *psNextJob;
-
-    CPLMutex            *hMutex;
-    CPLCond             *hCond;
-} CPLWorkerThread;
-
-typedef enum
-{
-    CPLWTS_OK,
-    CPLWTS_STOP,
-    CPLWTS_ERROR
-} CPLWorkerThreadState;
+    CPLThreadFunc        pfnInitFunc = nullptr;
+    void                *pInitData = nullptr;
+    CPLWorkerThreadPool *poTP = nullptr;
+    CPLJoinableThread   *hThread = nullptr;
+    int                  nIndex = 0;
+
+    // Jobs submitted from this thread. The owner pops from the back,
+    // other workers steal from the front.
+    std::mutex                      mutex{};
+    std::deque<CPLWorkerThreadJob>  aoJobs{};
+};
 #endif  // ndef DOXYGEN_SKIP
 
-/** Pool of worker threads */
+/** Pool of worker threads.
+ *
+ * Each worker thread has its own queue of jobs. Jobs submitted from a
+ * worker thread are queued to its own queue, and jobs submitted from other
+ * threads to a queue common to the pool. Idle workers take jobs from their
+ * own queue first, then from the common queue, and finally steal them from
+ * the queues of the other workers.
+ *
+ * Independent groups of jobs can be submitted and waited for with the
+ * CPLJobQueue objects returned by CreateJobQueue(). Contrary to
+ * WaitCompletion(), waiting on a job queue from a job running in the pool
+ * is safe: the waiting worker runs pending jobs in the meantime.
+ *
+ * A process-wide pool is available with CPLGetGlobalWorkerThreadPool().
+ */
 class CPL_DLL CPLWorkerThreadPool
 {
         CPL_DISALLOW_COPY_ASSIGN(CPLWorkerThreadPool)
-
-        std::vector<CPLWorkerThread> aWT{};
-        CPLCond* hCond = nullptr;
-        CPLMutex* hMutex = nullptr;
-        volatile CPLWorkerThreadState eState = CPLWTS_OK;
-        CPLList* psJobQueue = nullptr;
-        volatile int nPendingJobs = 0;
-
-        CPLList* psWaitingWorkerThreadsList = nullptr;
-        int nWaitingWorkerThreads = 0;
+        friend class CPLJobQueue;
+
+        std::vector<std::unique_ptr<CPLWorkerThread>> aWT{};
+        std::atomic<int> m_nThreads{0};
+        std::atomic<int> m_nStartedThreads{0};
+
+        std::mutex m_mutex{};
+        std::condition_variable m_cvWorkers{};
+        std::condition_variable m_cvJobFinished{};
+        std::deque<CPLWorkerThreadJob> m_aoJobQueue{};
+        // Number of jobs queued but not yet taken by a thread.
+        std::atomic<int> m_nQueuedJobs{0};
+        // Number of jobs queued or running.
+        int nPendingJobs = 0;
+        bool m_bStop = false;
 
         static void WorkerThreadFunction(void* user_data);
 
-        void DeclareJobFinished();
-        CPLWorkerThreadJob* GetNextJob(CPLWorkerThread* psWorkerThread);
+        void PushJob(const CPLWorkerThreadJob& oJob);
+        bool PopJob(CPLWorkerThread* psWorkerThread, CPLWorkerThreadJob& oJob);
+        bool GetNextJob(CPLWorkerThread* psWorkerThread,
+                        CPLWorkerThreadJob& oJob);
+        void RunJob(const CPLWorkerThreadJob& oJob);
+        CPLWorkerThread* GetCurrentWorkerThread() const;
 
     public:
         CPLWorkerThreadPool();
@@ -107,8 +132,61 @@ class CPL_DLL CPLWorkerThreadPool
         void WaitCompletion(int nMaxRemainingJobs = 0);
         void WaitEvent();
 
+        std::unique_ptr<CPLJobQueue> CreateJobQueue(int nMaxRunningJobs = 0);
+
         /** Return the number of threads setup */
-        int GetThreadCount() const { return static_cast<int>(aWT.size()); }
+        int GetThreadCount() const { return m_nThreads; }
+
+        /** Return whether the current thread is a worker of this pool
+         * (that is whether the caller is running in a job of the pool).
+         * @since GDAL 3.1 */
+        bool IsCurrentThreadWorker() const
+            { return GetCurrentWorkerThread() != nullptr; }
+};
+
+/** Group of jobs submitted to a CPLWorkerThreadPool, that can be waited for
+ * independently of the other jobs of the pool.
+ *
+ * Instances are created with CPLWorkerThreadPool::CreateJobQueue(). The
+ * number of jobs of the queue running at the same time can be limited, so
+ * that a caller asking for N threads uses at most N threads of a larger
+ * pool. The destructor waits for the completion of the jobs of the queue.
+ * @since GDAL 3.1
+ */
+class CPL_DLL CPLJobQueue
+{
+        CPL_DISALLOW_COPY_ASSIGN(CPLJobQueue)
+        friend class CPLWorkerThreadPool;
+
+        CPLWorkerThreadPool* m_poPool = nullptr;
+        std::mutex m_mutex{};
+        std::condition_variable m_cv{};
+        // Number of jobs submitted and not finished.
+        int m_nPendingJobs = 0;
+        // Maximum number of jobs handed to the pool at the same time
+        // (0 for no limit), and jobs waiting for one of them to finish.
+        int m_nMaxRunningJobs = 0;
+        int m_nRunningJobs = 0;
+        std::deque<CPLWorkerThreadJob> m_aoWaitingJobs{};
+
+        CPLJobQueue(CPLWorkerThreadPool* poPool, int nMaxRunningJobs);
+        void DeclareJobFinished();
+        template<class Predicate> void Wait(Predicate pred);
+
+    public:
+        ~CPLJobQueue();
+
+        /** Return the pool to which jobs are submitted */
+        CPLWorkerThreadPool* GetPool() { return m_poPool; }
+
+        bool SubmitJob(CPLThreadFunc pfnFunc, void* pData);
+        bool SubmitJobs(CPLThreadFunc pfnFunc, const std::vector<void*>& apData);
+        void WaitCompletion(int nMaxRemainingJobs = 0);
+        void WaitEvent();
 };
 
+CPLWorkerThreadPool CPL_DLL *CPLGetGlobalWorkerThreadPool(int nThreads);
+void CPL_DLL CPLCleanupGlobalWorkerThreadPool();
+int CPL_DLL CPLGetNumThreads(const char* pszNumThreads);
+
 #endif // CPL_WORKER_THREAD_POOL_H_INCLUDED_
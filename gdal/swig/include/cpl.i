@@ -735,6 +735,10 @@ void VSIStdoutUnsetRedirection()
 void VSICurlClearCache();
 void VSICurlPartialClearCache( const char* utf8_path );
 
+%apply (char **CSL) {char **};
+char** VSICurlGetDiskCacheStatistics();
+%clear char **;
+
 #endif /* !defined(SWIGJAVA) */
 
 %apply (char **CSL) {char **};
@@ -1671,6 +1671,10 @@ def VSICurlPartialClearCache(*args):
     """VSICurlPartialClearCache(char const * utf8_path)"""
     return _gdal.VSICurlPartialClearCache(*args)
 
+def VSICurlGetDiskCacheStatistics(*args):
+    """VSICurlGetDiskCacheStatistics() -> char **"""
+    return _gdal.VSICurlGetDiskCacheStatistics(*args)
+
 def ParseCommandLine(*args):
     """ParseCommandLine(char const * utf8_path) -> char **"""
     return _gdal.ParseCommandLine(*args)